@@ -56,6 +56,23 @@ auto make_sigma_builder(const std::vector<std::vector<double>>& M)
     }};
 };
 
+// a utility function to create a block sigma builder from a matrix
+auto make_block_sigma_builder(const std::vector<std::vector<double>>& M)
+    -> std::function<void(std::span<double>, std::span<double>, size_t)> {
+    return {[M](std::span<double> b, std::span<double> sigma, size_t nvec) {
+        auto n = M.size();
+        for (size_t v = 0; v < nvec; ++v) {
+            for (size_t i = 0; i < n; ++i) {
+                auto res = 0.0;
+                for (size_t j = 0; j < n; ++j) {
+                    res += M[i][j] * b[v * n + j];
+                }
+                sigma[v * n + i] = res;
+            }
+        }
+    }};
+};
+
 void export_DavidsonLiuSolver(py::module& m) {
     py::class_<DavidsonLiuSolver, std::shared_ptr<DavidsonLiuSolver>>(
         m, "DavidsonLiuSolver", "A class to diagonalize hermitian matrices")
@@ -63,12 +80,21 @@ void export_DavidsonLiuSolver(py::module& m) {
              "nroots"_a, "collapse_per_root"_a = 1, "subspace_per_root"_a = 5)
         .def("add_sigma_builder", &DavidsonLiuSolver::add_sigma_builder,
              "Add a function to build the sigma vector", "sigma_builder"_a)
+        .def("add_block_sigma_builder", &DavidsonLiuSolver::add_block_sigma_builder,
+             "Add a function to build the sigma vectors of a block of vectors",
+             "block_sigma_builder"_a)
         .def(
             "add_test_sigma_builder",
             [](DavidsonLiuSolver& self, const std::vector<std::vector<double>>& M) {
                 self.add_sigma_builder(make_sigma_builder(M));
             },
             "Create a sigma builder from a matrix", "M"_a)
+        .def(
+            "add_test_block_sigma_builder",
+            [](DavidsonLiuSolver& self, const std::vector<std::vector<double>>& M) {
+                self.add_block_sigma_builder(make_block_sigma_builder(M));
+            },
+            "Create a block sigma builder from a matrix", "M"_a)
         .def("add_h_diag", &DavidsonLiuSolver::add_h_diag, "Add the diagonal of the Hamiltonian")
         .def("add_guesses", &DavidsonLiuSolver::add_guesses, "Add the initial guesses")
         .def("add_project_out_vectors", &DavidsonLiuSolver::add_project_out_vectors,
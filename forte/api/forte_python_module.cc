@@ -38,6 +38,8 @@
 #include "helpers/lbfgs/rosenbrock.h"
 #include "helpers/symmetry.h"
 #include "helpers/spinorbital_helpers.h"
+#include "helpers/tensor_pool.h"
+#include "helpers/tensor_rotation.h"
 
 #include "base_classes/active_space_solver.h"
 #include "base_classes/orbital_transform.h"
@@ -230,6 +232,12 @@ PYBIND11_MODULE(_forte, m) {
     m.def("make_casscf", &make_casscf, "Make a CASSCF object");
     m.def("make_mcscf_two_step", &make_mcscf_two_step, "Make a 2-step MCSCF object");
     m.def("test_lbfgs_rosenbrock", &test_lbfgs_rosenbrock, "Test L-BFGS on Rosenbrock function");
+    m.def("test_ah_rosenbrock", &test_ah_rosenbrock,
+          "Test the augmented Hessian method on Rosenbrock function");
+    m.def("test_tensor_pool", &test_tensor_pool,
+          "Test the reuse and zeroing of the DSRG temporaries in TensorPool");
+    m.def("test_tensor_rotation", &test_tensor_rotation,
+          "Test the rotation of dense tensors in TensorRotation against explicit loops");
 
     m.def(
         "spinorbital_oei",
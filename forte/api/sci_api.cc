@@ -317,6 +317,8 @@ void export_Determinant(py::module& m) {
         .def(py::init<std::shared_ptr<ActiveSpaceIntegrals>>())
         .def("compute", &SparseHamiltonian::compute)
         .def("compute_on_the_fly", &SparseHamiltonian::compute_on_the_fly)
+        .def("set_num_threads", &SparseHamiltonian::set_num_threads, "num_threads"_a,
+             "Set the number of threads used to apply H (0 = use all the available threads)")
         .def("timings", &SparseHamiltonian::timings);
 
     py::class_<SparseExp>(m, "SparseExp", "A class to compute the exponential of a sparse operator")
@@ -334,8 +336,10 @@ void export_Determinant(py::module& m) {
         .def("timings", &SparseFactExp::timings);
 
     m.def("apply_operator",
-          py::overload_cast<SparseOperator&, const StateVector&, double>(&apply_operator), "sop"_a,
-          "state0"_a, "screen_thresh"_a = 1.0e-12);
+          py::overload_cast<SparseOperator&, const StateVector&, double, int>(&apply_operator),
+          "sop"_a, "state0"_a, "screen_thresh"_a = 1.0e-12, "num_threads"_a = 0,
+          "Apply an operator to a state. The result does not depend on the number of threads "
+          "(num_threads = 0 uses all the available threads)");
 
     m.def("apply_operator_safe",
           py::overload_cast<SparseOperator&, const StateVector&>(&apply_operator_safe), "sop"_a,
@@ -366,6 +370,7 @@ void export_SigmaVector(py::module& m) {
         .value("Full", SigmaVectorType::Full)
         .value("Dynamic", SigmaVectorType::Dynamic)
         .value("SparseList", SigmaVectorType::SparseList)
+        .value("SparseListStreaming", SigmaVectorType::SparseListStreaming)
         .export_values();
 }
 
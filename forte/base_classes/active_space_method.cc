@@ -96,6 +96,19 @@ DeterminantHashVec ActiveSpaceMethod::get_PQ_space() { return final_wfn_; }
 
 std::shared_ptr<psi::Matrix> ActiveSpaceMethod::get_PQ_evecs() { return evecs_; }
 
+std::shared_ptr<RDMs> ActiveSpaceMethod::average_rdms(const std::vector<double>& weights,
+                                                     int max_rdm_level, RDMsType type) {
+    auto avg_rdms = RDMs::build(max_rdm_level, mo_space_info_->size("ACTIVE"), type);
+    for (size_t r = 0, nroot = weights.size(); r < nroot; r++) {
+        // Don't bother if the weight is zero
+        if (weights[r] <= 1e-15)
+            continue;
+        auto root_rdms = rdms({{r, r}}, max_rdm_level, type)[0];
+        avg_rdms->axpy(root_rdms, weights[r]);
+    }
+    return avg_rdms;
+}
+
 void ActiveSpaceMethod::save_transition_rdms(
     const std::vector<std::shared_ptr<RDMs>>& rdms,
     const std::vector<std::pair<size_t, size_t>>& root_list,
@@ -135,6 +135,19 @@ class ActiveSpaceMethod {
     rdms(const std::vector<std::pair<size_t, size_t>>& root_list, int max_rdm_level,
          RDMsType type) = 0;
 
+    /// @brief Compute the weighted average of the RDMs of the roots of this method
+    ///
+    ///        D = sum_r weights[r] <r, this| a+_p1 ... a_qn |r, this>
+    ///
+    ///        The default implementation computes the RDMs of each root with a nonzero weight and
+    ///        sums them. Methods that can compute several RDMs at once should override it
+    ///
+    /// @param weights       the weight of each root
+    /// @param max_rdm_level the maximum RDM rank
+    /// @return the averaged RDMs
+    virtual std::shared_ptr<RDMs> average_rdms(const std::vector<double>& weights,
+                                               int max_rdm_level, RDMsType type);
+
     /// @brief Compute the transition density matrices between two states of different symmetry
     ///        This function can be used to compute transition density matrices between
     ///        states of different symmetry,
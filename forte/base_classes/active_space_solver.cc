@@ -27,6 +27,7 @@
  */
 
 #include <algorithm>
+#include <exception>
 #include <numeric>
 #include <tuple>
 
@@ -44,6 +45,7 @@
 #include "helpers/helpers.h"
 #include "helpers/printing.h"
 #include "helpers/string_algorithms.h"
+#include "helpers/threading.h"
 #include "integrals/active_space_integrals.h"
 #include "integrals/one_body_integrals.h"
 #include "mrdsrg-helper/dsrg_transformed.h"
@@ -69,6 +71,7 @@ ActiveSpaceSolver::ActiveSpaceSolver(const std::string& method,
     r_convergence_ = options->get_double("R_CONVERGENCE");
     read_initial_guess_ = options->get_bool("READ_ACTIVE_WFN_GUESS");
     gas_diff_only_ = options->get_bool("PRINT_DIFFERENT_GAS_ONLY");
+    concurrent_states_ = options->get_bool("CONCURRENT_STATES");
 
     auto nactv = mo_space_info_->size("ACTIVE");
     Ua_actv_ = ambit::Tensor::build(ambit::CoreTensor, "Ua", {nactv, nactv});
@@ -120,43 +123,26 @@ const std::map<StateInfo, std::vector<double>>& ActiveSpaceSolver::compute_energ
     }
 
     state_energies_map_.clear();
-    for (const auto& state_nroot : state_nroots_map_) {
-        const auto& state = state_nroot.first;
-        size_t nroot = state_nroot.second;
-
-        // so far only FCI and DETCI supports restarting from a previous wavefunction
-        if ((method_ == "FCI") or (method_ == "DETCI")) {
-            auto [it, inserted] = state_method_map_.try_emplace(state);
-            if (inserted) {
-                it->second = make_active_space_method(method_, state, nroot, scf_info_,
-                                                      mo_space_info_, as_ints_, options_);
-            }
-            auto method = it->second;
-        } else {
-            state_method_map_[state] = make_active_space_method(method_, state, nroot, scf_info_,
-                                                                mo_space_info_, as_ints_, options_);
-        }
-        auto method = state_method_map_[state];
-        // set the convergence criteria
-        method->set_print(print_);
-        method->set_e_convergence(e_convergence_);
-        method->set_r_convergence(r_convergence_);
-        method->set_maxiter(maxiter_);
-
-        if (read_initial_guess_) {
-            state_filename_map_[state] = method->wfn_filename();
-            method->set_read_wfn_guess(read_initial_guess_);
+    // only the string-based CI solvers can run side by side
+    if (concurrent_states_ and (state_nroots_map_.size() > 1) and (omp_get_max_threads() > 1) and
+        ((method_ == "FCI") or (method_ == "GENCI"))) {
+        compute_state_energies_concurrently();
+    } else {
+        for (const auto& state_nroot : state_nroots_map_) {
+            const auto& state = state_nroot.first;
+            size_t nroot = state_nroot.second;
+            auto method = prepare_state_method(state, nroot);
+
+            // compute the energy of state and save it
+            method->compute_energy();
+            const auto& energies = method->energies();
+            state_energies_map_[state] = energies;
+            const auto& spin2 = method->spin2();
+
+            // check that the effective values of S are within a given tolerance
+            validate_spin(spin2, state);
+            state_spin2_map_[state] = spin2;
         }
-
-        // compute the energy of state and save it
-        method->compute_energy();
-        const auto& energies = method->energies();
-        state_energies_map_[state] = energies;
-        const auto& spin2 = method->spin2();
-
-        // check that the effective values of S are within a given tolerance
-        validate_spin(spin2, state);
-        state_spin2_map_[state] = spin2;
     }
     print_energies();
 
@@ -172,6 +158,114 @@ const std::map<StateInfo, std::vector<double>>& ActiveSpaceSolver::compute_energ
     return state_energies_map_;
 }
 
+std::shared_ptr<ActiveSpaceMethod> ActiveSpaceSolver::prepare_state_method(const StateInfo& state,
+                                                                           size_t nroot) {
+    // so far only FCI and DETCI supports restarting from a previous wavefunction
+    if ((method_ == "FCI") or (method_ == "DETCI")) {
+        auto [it, inserted] = state_method_map_.try_emplace(state);
+        if (inserted) {
+            it->second = make_active_space_method(method_, state, nroot, scf_info_, mo_space_info_,
+                                                  as_ints_, options_);
+        }
+    } else {
+        state_method_map_[state] = make_active_space_method(method_, state, nroot, scf_info_,
+                                                            mo_space_info_, as_ints_, options_);
+    }
+    auto method = state_method_map_[state];
+    // set the convergence criteria
+    method->set_print(print_);
+    method->set_e_convergence(e_convergence_);
+    method->set_r_convergence(r_convergence_);
+    method->set_maxiter(maxiter_);
+
+    if (read_initial_guess_) {
+        state_filename_map_[state] = method->wfn_filename();
+        method->set_read_wfn_guess(read_initial_guess_);
+    }
+    return method;
+}
+
+void ActiveSpaceSolver::compute_state_energies_concurrently() {
+    std::vector<StateInfo> states;
+    std::vector<std::shared_ptr<ActiveSpaceMethod>> methods;
+    for (const auto& [state, nroot] : state_nroots_map_) {
+        states.push_back(state);
+        methods.push_back(prepare_state_method(state, nroot));
+    }
+
+    // group the states so that the groups have a similar number of determinants and give each
+    // group a number of threads proportional to its size
+    const auto space_size = state_space_size_map();
+    std::vector<size_t> weights;
+    for (const auto& state : states) {
+        weights.push_back(space_size.at(state));
+    }
+    const size_t num_threads = omp_get_max_threads();
+    const auto groups = balanced_partition(weights, std::min(states.size(), num_threads));
+    std::vector<size_t> group_weights;
+    for (const auto& group : groups) {
+        size_t weight = 0;
+        for (size_t i : group) {
+            weight += weights[i];
+        }
+        group_weights.push_back(weight);
+    }
+    const auto group_threads = proportional_split(group_weights, num_threads);
+
+    if (print_ >= PrintLevel::Default) {
+        print_h2("Concurrent Solution of the States");
+        psi::outfile->Printf("\n    Group  Threads  Determinants  States");
+        psi::outfile->Printf("\n    %s", std::string(56, '-').c_str());
+        for (size_t g = 0; g < groups.size(); ++g) {
+            std::vector<std::string> labels;
+            for (size_t i : groups[g]) {
+                labels.push_back(states[i].str_minimum());
+            }
+            psi::outfile->Printf("\n    %5zu  %7zu  %12zu  %s", g, group_threads[g],
+                                 group_weights[g], join(labels, ", ").c_str());
+        }
+        psi::outfile->Printf("\n    %s", std::string(56, '-').c_str());
+    }
+
+    // the output of the solvers would be interleaved, so they run quietly
+    for (auto& method : methods) {
+        method->set_print(PrintLevel::Quiet);
+    }
+
+    std::vector<std::exception_ptr> errors(states.size());
+    const int max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(max_active_levels, 2));
+#pragma omp parallel num_threads(groups.size())
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nt = omp_get_num_threads();
+        // if we got fewer threads than requested, the remaining groups are shared
+        for (size_t g = tid; g < groups.size(); g += nt) {
+            omp_set_num_threads(group_threads[g]);
+            for (size_t i : groups[g]) {
+                try {
+                    methods[i]->compute_energy();
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        }
+    }
+    omp_set_max_active_levels(max_active_levels);
+
+    // collect the results in the same order as the sequential code
+    for (size_t i = 0; i < states.size(); ++i) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+        methods[i]->set_print(print_);
+        state_energies_map_[states[i]] = methods[i]->energies();
+        const auto& spin2 = methods[i]->spin2();
+        validate_spin(spin2, states[i]);
+        state_spin2_map_[states[i]] = spin2;
+    }
+}
+
 void ActiveSpaceSolver::validate_spin(const std::vector<double>& spin2, const StateInfo& state) {
     if (spin2.size() != 0) {
         double S_tolerance = options_->get_double("S_TOLERANCE");
@@ -606,20 +700,9 @@ std::shared_ptr<RDMs> ActiveSpaceSolver::compute_average_rdms(
         // Get the already-run method
         const auto& method = state_method_map_.at(state);
 
-        // Loop through roots in the method
-        for (size_t r = 0; r < nroot; r++) {
-            // Don't bother if the weight is zero
-            if (weights[r] <= 1e-15)
-                continue;
-
-            // Get the RDMs
-            std::vector<std::pair<size_t, size_t>> state_ids;
-            state_ids.emplace_back(r, r);
-            auto method_rdms = method->rdms(state_ids, max_rdm_level, rdm_type)[0];
-
-            // Add contributions
-            rdms->axpy(method_rdms, weights[r]);
-        }
+        // Add the weighted RDMs of the roots of this state
+        std::vector<double> root_weights(weights.begin(), weights.begin() + nroot);
+        rdms->axpy(method->average_rdms(root_weights, max_rdm_level, rdm_type), 1.0);
     }
 
     return rdms;
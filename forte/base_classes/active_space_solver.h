@@ -234,6 +234,14 @@ class ActiveSpaceSolver {
     /// A map of state symmetries to the associated ActiveSpaceMethod
     std::map<StateInfo, std::shared_ptr<ActiveSpaceMethod>> state_method_map_;
 
+    /// Create (or reuse) the method of a state and set its convergence criteria
+    std::shared_ptr<ActiveSpaceMethod> prepare_state_method(const StateInfo& state, size_t nroot);
+
+    /// Solve the states concurrently. The states are distributed among groups of threads with a
+    /// balanced total determinant space size, and the threads are split among the groups in
+    /// proportion to their space size
+    void compute_state_energies_concurrently();
+
     /// Make sure that the values of <S^2> are consistent with the multiplicity
     void validate_spin(const std::vector<double>& spin2, const StateInfo& state);
 
@@ -267,6 +275,9 @@ class ActiveSpaceSolver {
     /// Only print the transitions between states with different gas
     bool gas_diff_only_;
 
+    /// Solve the states concurrently
+    bool concurrent_states_ = false;
+
     /// Unitary matrices for orbital rotations used to compute dipole moments
     /// The issue is dipole integrals are transformed to semi-canonical orbital basis,
     /// while active-space integrals are in the original orbital basis
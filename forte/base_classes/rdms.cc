@@ -31,6 +31,7 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 
 #include "helpers/helpers.h"
+#include "helpers/tensor_rotation.h"
 #include "helpers/timer.h"
 #include "base_classes/rdms.h"
 #include "integrals/integrals.h"
@@ -660,15 +661,14 @@ void RDMsSpinDependent::rotate(const ambit::Tensor& Ua, const ambit::Tensor& Ub)
     psi::outfile->Printf("\n  Orbital rotations on spin-dependent RDMs ...");
     timer t("Rotate RDMs");
 
-    // Transform the 1-rdms
-    ambit::Tensor g1aT = ambit::Tensor::build(ambit::CoreTensor, "g1aT", g1a_.dims());
-    ambit::Tensor g1bT = ambit::Tensor::build(ambit::CoreTensor, "g1bT", g1b_.dims());
-
-    g1aT("pq") = Ua("ap") * g1a_("ab") * Ua("bq");
-    g1bT("PQ") = Ub("AP") * g1b_("AB") * Ub("BQ");
+    // Transform the RDMs one index at a time, reusing the same scratch buffer for all the blocks
+    TensorRotation rotation(Ua.dim(0));
+    const double* ua = Ua.data().data();
+    const double* ub = Ub.data().data();
 
-    g1a_("pq") = g1aT("pq");
-    g1b_("pq") = g1bT("pq");
+    // Transform the 1-rdms
+    rotation.rotate(g1a_.data().data(), {ua, ua}, true);
+    rotation.rotate(g1b_.data().data(), {ub, ub}, true);
 
     psi::outfile->Printf("\n    Transformed 1 RDMs.");
 
@@ -676,17 +676,9 @@ void RDMsSpinDependent::rotate(const ambit::Tensor& Ua, const ambit::Tensor& Ub)
         return;
 
     // Transform the 2-rdms
-    auto g2Taa = ambit::Tensor::build(ambit::CoreTensor, "g2aaT", g2aa_.dims());
-    auto g2Tab = ambit::Tensor::build(ambit::CoreTensor, "g2abT", g2ab_.dims());
-    auto g2Tbb = ambit::Tensor::build(ambit::CoreTensor, "g2bbT", g2bb_.dims());
-
-    g2Taa("pqrs") = Ua("ap") * Ua("bq") * g2aa_("abcd") * Ua("cr") * Ua("ds");
-    g2Tab("pQrS") = Ua("ap") * Ub("BQ") * g2ab_("aBcD") * Ua("cr") * Ub("DS");
-    g2Tbb("PQRS") = Ub("AP") * Ub("BQ") * g2bb_("ABCD") * Ub("CR") * Ub("DS");
-
-    g2aa_("pqrs") = g2Taa("pqrs");
-    g2ab_("pqrs") = g2Tab("pqrs");
-    g2bb_("pqrs") = g2Tbb("pqrs");
+    rotation.rotate(g2aa_.data().data(), {ua, ua, ua, ua}, true);
+    rotation.rotate(g2ab_.data().data(), {ua, ub, ua, ub}, true);
+    rotation.rotate(g2bb_.data().data(), {ub, ub, ub, ub}, true);
 
     psi::outfile->Printf("\n    Transformed 2 RDMs.");
 
@@ -694,22 +686,10 @@ void RDMsSpinDependent::rotate(const ambit::Tensor& Ua, const ambit::Tensor& Ub)
         return;
 
     // Transform the 3-rdms
-    auto g3T = ambit::Tensor::build(ambit::CoreTensor, "g3T", g3aaa_.dims());
-    g3T("pqrstu") =
-        Ua("ap") * Ua("bq") * Ua("cr") * g3aaa_("abcijk") * Ua("is") * Ua("jt") * Ua("ku");
-    g3aaa_("pqrstu") = g3T("pqrstu");
-
-    g3T("pqRstU") =
-        Ua("ap") * Ua("bq") * Ub("CR") * g3aab_("abCijK") * Ua("is") * Ua("jt") * Ub("KU");
-    g3aab_("pqrstu") = g3T("pqrstu");
-
-    g3T("pQRsTU") =
-        Ua("ap") * Ub("BQ") * Ub("CR") * g3abb_("aBCiJK") * Ua("is") * Ub("JT") * Ub("KU");
-    g3abb_("pqrstu") = g3T("pqrstu");
-
-    g3T("PQRSTU") =
-        Ub("AP") * Ub("BQ") * Ub("CR") * g3bbb_("ABCIJK") * Ub("IS") * Ub("JT") * Ub("KU");
-    g3bbb_("pqrstu") = g3T("pqrstu");
+    rotation.rotate(g3aaa_.data().data(), {ua, ua, ua, ua, ua, ua}, true);
+    rotation.rotate(g3aab_.data().data(), {ua, ua, ub, ua, ua, ub}, true);
+    rotation.rotate(g3abb_.data().data(), {ua, ub, ub, ua, ub, ub}, true);
+    rotation.rotate(g3bbb_.data().data(), {ub, ub, ub, ub, ub, ub}, true);
 
     psi::outfile->Printf("\n    Transformed 3 RDMs.");
 }
@@ -948,27 +928,24 @@ void RDMsSpinFree::rotate(const ambit::Tensor& Ua, const ambit::Tensor& Ub) {
 
     timer t("Rotate RDMs");
 
+    // Transform the RDMs one index at a time, reusing the same scratch buffer
+    TensorRotation rotation(Ua.dim(0));
+    const double* ua = Ua.data().data();
+
     // Transform the 1-rdms
-    ambit::Tensor g1T = ambit::Tensor::build(ambit::CoreTensor, "g1T", SF_G1_.dims());
-    g1T("pq") = Ua("ap") * SF_G1_("ab") * Ua("bq");
-    SF_G1_("pq") = g1T("pq");
+    rotation.rotate(SF_G1_.data().data(), {ua, ua}, true);
     psi::outfile->Printf("\n    Transformed 1 RDMs.");
     if (max_rdm_ == 1)
         return;
 
     // Transform the 2-rdms
-    auto g2T = ambit::Tensor::build(ambit::CoreTensor, "g2T", SF_G2_.dims());
-    g2T("pqrs") = Ua("ap") * Ua("bq") * SF_G2_("abcd") * Ua("cr") * Ua("ds");
-    SF_G2_("pqrs") = g2T("pqrs");
+    rotation.rotate(SF_G2_.data().data(), {ua, ua, ua, ua}, true);
     psi::outfile->Printf("\n    Transformed 2 RDMs.");
     if (max_rdm_ == 2)
         return;
 
     // Transform the 3-rdms
-    auto g3T = ambit::Tensor::build(ambit::CoreTensor, "g3T", SF_G3_.dims());
-    g3T("pqrstu") =
-        Ua("ap") * Ua("bq") * Ua("cr") * SF_G3_("abcijk") * Ua("is") * Ua("jt") * Ua("ku");
-    SF_G3_("pqrstu") = g3T("pqrstu");
+    rotation.rotate(SF_G3_.data().data(), {ua, ua, ua, ua, ua, ua}, true);
     psi::outfile->Printf("\n    Transformed 3 RDMs.");
 }
 
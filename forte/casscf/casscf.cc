@@ -439,6 +439,32 @@ ambit::Tensor CASSCF::transform_integrals(std::shared_ptr<psi::Matrix> Ca) {
         Cact_vec[x] = temp;
     }
 
+    auto corr_mos_abs = mo_space_info_->absolute_mo("CORRELATED");
+
+    std::vector<size_t> ints_dim{ncmo_, nactv_, nactv_, nactv_};
+    auto ints = ambit::Tensor::build(ambit::CoreTensor, "gaaa ints", ints_dim);
+    std::vector<double>& ints_data = ints.data();
+    size_t nactv2 = nactv_ * nactv_;
+    size_t nactv3 = nactv2 * nactv_;
+
+    // with DF or CD integrals (pu|xy) = sum_Q B(Q|pu) B(Q|xy) is built from three-index integrals
+    if (options_->get_str("CASSCF_TEI_BUILDER") == "AUTO" and ints_->has_three_index_ao_ints()) {
+        auto puxy = ints_->active_tei_from_three_index(Ca_nosym, Cact);
+        const auto& puxy_data = puxy.data();
+        for (size_t p = 0; p < ncmo_; ++p) {
+            const double* puxy_p = &puxy_data[corr_mos_abs[p] * nactv3];
+            double* ints_p = &ints_data[corr_mos_[p] * nactv3];
+            for (size_t u = 0; u < nactv_; ++u) {
+                for (size_t x = 0; x < nactv_; ++x) {
+                    for (size_t y = 0; y < nactv_; ++y) {
+                        ints_p[x * nactv2 + u * nactv_ + y] = puxy_p[u * nactv2 + x * nactv_ + y];
+                    }
+                }
+            }
+        }
+        return ints;
+    }
+
     // The following type of integrals are needed:
     // (pu|xy) = C_{Mp}^T C_{Nu} C_{Rx}^T C_{Sy} (MN|RS)
     //         = C_{Mp}^T C_{Nu} J_{MN}^{xy}
@@ -462,13 +488,6 @@ ambit::Tensor CASSCF::transform_integrals(std::shared_ptr<psi::Matrix> Ca) {
     JK_->compute();
 
     auto half_trans = std::make_shared<psi::Matrix>("Trans", nmo_, nactv_);
-    auto corr_mos_abs = mo_space_info_->absolute_mo("CORRELATED");
-
-    std::vector<size_t> ints_dim{ncmo_, nactv_, nactv_, nactv_};
-    auto ints = ambit::Tensor::build(ambit::CoreTensor, "gaaa ints", ints_dim);
-    std::vector<double>& ints_data = ints.data();
-    size_t nactv2 = nactv_ * nactv_;
-    size_t nactv3 = nactv2 * nactv_;
 
     for (size_t x = 0, shift = 0; x < nactv_; ++x) {
         shift += x;
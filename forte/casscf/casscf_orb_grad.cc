@@ -26,6 +26,7 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <ctype.h>
 #include <numeric>
 
@@ -168,6 +169,9 @@ void CASSCF_ORB_GRAD::read_options() {
 
     ortho_trans_algo_ = options_->get_str("CASSCF_ORB_ORTHO_TRANS");
 
+    tei_from_three_index_ =
+        options_->get_str("CASSCF_TEI_BUILDER") == "AUTO" and ints_->has_three_index_ao_ints();
+
     // zero rotations
     zero_rots_.resize(nirrep_);
     auto zero_rots = options_->get_gen_list("CASSCF_ZERO_ROT");
@@ -458,14 +462,7 @@ void CASSCF_ORB_GRAD::fill_tei_custom(ambit::BlockedTensor V) {
     }
 }
 
-void CASSCF_ORB_GRAD::build_tei_from_ao() {
-    if (nactv_ == 0)
-        return;
-
-    // This function will do an integral transformation using the JK builder,
-    // and return the integrals of type <px|uy> = (pu|xy).
-    timer_on("Build (pu|xy) integrals");
-
+std::shared_ptr<psi::Matrix> CASSCF_ORB_GRAD::C_ao_nosym() {
     // Transform C matrix to C1 symmetry
     // JK does not support mixed symmetry needed for 4-index integrals (York 09/09/2020)
     auto aotoso = ints_->wfn()->aotoso();
@@ -487,6 +484,19 @@ void CASSCF_ORB_GRAD::build_tei_from_ao() {
         }
     }
 
+    return C_nosym;
+}
+
+void CASSCF_ORB_GRAD::build_tei_from_ao() {
+    if (nactv_ == 0)
+        return;
+
+    // This function will do an integral transformation using the JK builder,
+    // and return the integrals of type <px|uy> = (pu|xy).
+    timer_on("Build (pu|xy) integrals");
+
+    auto C_nosym = C_ao_nosym();
+
     // set up the active part of the C matrix
     auto Cact = std::make_shared<psi::Matrix>("Cact", nso_, nactv_);
     std::vector<std::shared_ptr<psi::Matrix>> Cact_vec(nactv_);
@@ -501,6 +511,20 @@ void CASSCF_ORB_GRAD::build_tei_from_ao() {
         Cact_vec[x] = temp;
     }
 
+    // with DF or CD integrals (pu|xy) = sum_Q B(Q|pu) B(Q|xy) is built from three-index integrals
+    if (tei_from_three_index_) {
+        auto tei = ints_->active_tei_from_three_index(C_nosym, Cact);
+        const auto& tei_data = tei.data();
+        size_t nactv3 = nactv_ * nactv_ * nactv_;
+        for (size_t p = 0; p < nmo_; ++p) {
+            auto& data = V_.block(mos_rel_space_[p].first + "aaa").data();
+            std::copy_n(tei_data.begin() + p * nactv3, nactv3,
+                        data.begin() + mos_rel_space_[p].second * nactv3);
+        }
+        timer_off("Build (pu|xy) integrals");
+        return;
+    }
+
     // The following type of integrals are needed:
     // (pu|xy) = C_{Mp}^T C_{Nu} C_{Rx}^T C_{Sy} (MN|RS)
     //         = C_{Mp}^T C_{Nu} J_{MN}^{xy}
@@ -733,6 +757,7 @@ bool CASSCF_ORB_GRAD::update_orbitals(std::shared_ptr<psi::Vector> x) {
 
     // update orbitals
     C_->gemm(false, false, 1.0, C0_, U_, 0.0);
+    hess_2e_valid_ = false;
     if (ints_->integral_type() == Custom) {
         ints_->update_orbitals(C_, C_);
     } else {
@@ -1016,6 +1041,8 @@ void CASSCF_ORB_GRAD::set_rdms(std::shared_ptr<RDMs> rdms) {
     D2_.block("aaaa")("pqrs") = rdms->SF_G2()("prqs");
     D2_.block("aaaa")("pqrs") += rdms->SF_G2()("qrps");
     D2_.scale(0.5);
+
+    hess_2e_valid_ = false;
 }
 
 void CASSCF_ORB_GRAD::format_1rdm() {
@@ -69,6 +69,16 @@ class CASSCF_ORB_GRAD {
     /// Evaluate the diagonal orbital Hessian
     void hess_diag(std::shared_ptr<psi::Vector> x, const std::shared_ptr<psi::Vector>& h0);
 
+    /// Compute the product of the exact orbital Hessian (fixed RDMs) with a vector v
+    /// The Hessian is that of the last call to evaluate() with do_g = true, x is not used
+    void hess_vec(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::Vector> v,
+                  const std::shared_ptr<psi::Vector>& Hv);
+
+    /// Compare hess_vec(x, v) with the central difference of the orbital gradient along v
+    /// Return the largest absolute deviation. The orbitals are set back to x at the end
+    double test_hess_vec(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::Vector> v,
+                         double step = 1.0e-4);
+
     /// Set RDMs used for orbital optimization
     void set_rdms(std::shared_ptr<RDMs> rdms);
 
@@ -190,6 +200,9 @@ class CASSCF_ORB_GRAD {
     /// 3. Pade: Psi4 implementation of U = exp(R)
     std::string ortho_trans_algo_;
 
+    /// Build (pu|xy) from DF or CD three-index integrals instead of JK
+    bool tei_from_three_index_;
+
     /// Keep internal (GASn-GASn) rotations
     bool internal_rot_;
     /// If the active space is from GAS
@@ -248,6 +261,13 @@ class CASSCF_ORB_GRAD {
     /// Intermediate (2RDM) when forming internal diagonal Hessian
     ambit::BlockedTensor d2_internal_;
 
+    /// Two-electron part of the active columns of the exact Hessian
+    /// H_{pu,mt} = sum_{vw} [(pm|vw) D_{utvw} + 2 (pv|mw) D_{uvtw}] stored as [p][u][m][t],
+    /// where p, m are all MOs in Pitzer ordering and u, t are active
+    std::vector<double> hess_2e_;
+    /// If hess_2e_ is consistent with the current orbitals and RDMs
+    bool hess_2e_valid_ = false;
+
     // => functions used in micro iteration <=
 
     /// Build integrals for gradients and Hessian
@@ -256,6 +276,9 @@ class CASSCF_ORB_GRAD {
     /// Build two-electron integrals
     void build_tei_from_ao();
 
+    /// Build the two-electron intermediate of the exact Hessian using JK
+    void build_hess_2e();
+
     /// Fill two-electron integrals for custom integrals
     void fill_tei_custom(ambit::BlockedTensor V);
 
@@ -349,8 +372,8 @@ class CASSCF_ORB_GRAD {
     /// Format the 1RDM from BlockedTensor to SharedMatrix
     void format_1rdm();
 
-    /// Fill Am_ matrix from BlockedTensor A
-    void fill_A_matrix_data(ambit::BlockedTensor A);
+    /// Fill the matrix Am (same symmetry blocks as Am_) from BlockedTensor A
+    void fill_A_matrix_data(ambit::BlockedTensor A, psi::Matrix& Am);
 
     /// Reshape the orbital rotation related BlockedTensor to std::shared_ptr<psi::Vector>
     void reshape_rot_ambit(ambit::BlockedTensor bt, const std::shared_ptr<psi::Vector>& sv);
@@ -361,6 +384,9 @@ class CASSCF_ORB_GRAD {
     /// Compute Cayley transformation from skew-symmetric matrix
     std::shared_ptr<psi::Matrix> cayley_trans(const std::shared_ptr<psi::Matrix>& A);
 
+    /// Return the current orbital coefficients in the AO basis without symmetry (nso x nmo)
+    std::shared_ptr<psi::Matrix> C_ao_nosym();
+
     /// Grab part of the orbital coefficients
     std::shared_ptr<psi::Matrix> C_subset(const std::string& name, std::shared_ptr<psi::Matrix> C,
                                           psi::Dimension dim_start, psi::Dimension dim_end);
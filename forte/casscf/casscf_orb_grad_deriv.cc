@@ -48,7 +48,7 @@ void CASSCF_ORB_GRAD::compute_nuclear_gradient() {
 
     // format A to SharedMatrix
     Am_ = std::make_shared<psi::Matrix>("A (MCSCF)", nmopi_, nmopi_);
-    fill_A_matrix_data(A_);
+    fill_A_matrix_data(A_, *Am_);
 
     is_frozen_orbs_ = nfrzc_ or mo_space_info_->size("FROZEN_UOCC");
 
@@ -131,7 +131,7 @@ std::shared_ptr<psi::Matrix> CASSCF_ORB_GRAD::C_subset(const std::string& name,
     return Csub;
 }
 
-void CASSCF_ORB_GRAD::fill_A_matrix_data(ambit::BlockedTensor A) {
+void CASSCF_ORB_GRAD::fill_A_matrix_data(ambit::BlockedTensor A, psi::Matrix& Am) {
     A.citerate(
         [&](const std::vector<size_t>& i, const std::vector<SpinType>&, const double& value) {
             auto irrep_index_pair1 = mos_rel_[i[0]];
@@ -142,7 +142,7 @@ void CASSCF_ORB_GRAD::fill_A_matrix_data(ambit::BlockedTensor A) {
             if (h1 == irrep_index_pair2.first) {
                 auto p = irrep_index_pair1.second;
                 auto q = irrep_index_pair2.second;
-                Am_->set(h1, p, q, value);
+                Am.set(h1, p, q, value);
             }
         });
 }
@@ -222,7 +222,7 @@ void CASSCF_ORB_GRAD::build_Am_frozen() {
     At["Mu"] = Fc_["Mt"] * D1_["tu"];
     At["Mu"] += V_["Mtvw"] * D2_["tuvw"];
 
-    fill_A_matrix_data(At);
+    fill_A_matrix_data(At, *Am_);
 }
 
 void CASSCF_ORB_GRAD::solve_cpscf() {
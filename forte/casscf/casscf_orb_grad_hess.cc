@@ -0,0 +1,326 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+#include "psi4/libqt/qt.h"
+
+#include "casscf/casscf_orb_grad.h"
+
+using namespace psi;
+
+namespace forte {
+
+void CASSCF_ORB_GRAD::hess_vec(std::shared_ptr<psi::Vector>, std::shared_ptr<psi::Vector> v,
+                               const std::shared_ptr<psi::Vector>& Hv) {
+    /* Exact orbital Hessian (fixed RDMs) contracted with a rotation vector v
+     *
+     * For the rotation C -> C exp(Y), where Y_{ij} = v_n and Y_{ji} = -v_n, the change of the
+     * gradient g_{pq} = 2 (A_{pq} - A_{qp}) is
+     *   (H v)_n = 2 (X_{ij} - X_{ji}),  X = A' - 1/2 (A + A^T) Y,
+     * where A' is the change of A when all but its first index are rotated:
+     *   A'_{pi} = 2 (F Y)_{pi} + 2 (dFc + dFa)_{pi}
+     *   A'_{pu} = sum_{t} (dFc + Fc Y)_{pt} D_{tu} + sum_{mt} H_{pu,mt} Y_{mt}
+     *
+     * dFc and dFa are the first-order changes of the inactive and active Fock matrices, which
+     * are obtained from one JK build with the AO densities (CY)_{c} C_{c}^T and (CY)_{a} (C_a D)^T.
+     * H_{pu,mt} is built by build_hess_2e().
+     *
+     * i: restricted core; u,t: active; p,m: any MO; F: generalized Fock; Fc: inactive Fock
+     */
+    if (ints_->integral_type() == Custom)
+        throw std::runtime_error("Orbital Hessian-vector product is not available for CUSTOM "
+                                 "integrals");
+
+    if (not hess_2e_valid_)
+        build_hess_2e();
+
+    timer_on("Orbital Hessian-vector product");
+
+    // skew-symmetric rotation matrix
+    auto Y = std::make_shared<psi::Matrix>("Y", nmopi_, nmopi_);
+    for (size_t n = 0; n < nrot_; ++n) {
+        int h, i, j;
+        std::tie(h, i, j) = rot_mos_irrep_[n];
+        Y->set(h, i, j, v->get(n));
+        Y->set(h, j, i, -v->get(n));
+    }
+
+    // first-order changes of the inactive and active Fock matrices
+    auto CY = psi::linalg::doublet(C_, Y);
+    auto actv_end = ndoccpi_ + nactvpi_;
+
+    JK_->set_do_K(true);
+    std::vector<std::shared_ptr<psi::Matrix>>& Cl = JK_->C_left();
+    std::vector<std::shared_ptr<psi::Matrix>>& Cr = JK_->C_right();
+    Cl.clear();
+    Cr.clear();
+    if (not core_mos_.empty()) {
+        Cl.push_back(C_subset("CY_CORE", CY, nfrzcpi_, ndoccpi_));
+        Cr.push_back(C_subset("C_CORE", C_, nfrzcpi_, ndoccpi_));
+    }
+    if (nactv_) {
+        Cl.push_back(C_subset("CY_ACTV", CY, ndoccpi_, actv_end));
+        Cr.push_back(psi::linalg::doublet(C_subset("C_ACTV", C_, ndoccpi_, actv_end), rdm1_));
+    }
+    JK_->compute();
+
+    // C^T (a * J - b * (K + K^T)) C for the n-th density
+    auto fock_like = [&](size_t n, double a, double b) {
+        auto F = JK_->J()[n]->clone();
+        F->scale(a);
+        F->axpy(-b, JK_->K()[n]);
+        F->axpy(-b, JK_->K()[n]->transpose());
+        return psi::linalg::triplet(C_, F, C_, true, false, false);
+    };
+
+    auto dFc = std::make_shared<psi::Matrix>("dFc", nmopi_, nmopi_);
+    auto dFa = std::make_shared<psi::Matrix>("dFa", nmopi_, nmopi_);
+    if (not core_mos_.empty())
+        dFc = fock_like(0, 4.0, 1.0);
+    if (nactv_)
+        dFa = fock_like(Cl.size() - 1, 2.0, 0.5);
+
+    // X = -1/2 (A + A^T) Y
+    auto As = std::make_shared<psi::Matrix>("A + A^T", nmopi_, nmopi_);
+    fill_A_matrix_data(A_, *As);
+    As->add(As->transpose());
+    auto X = psi::linalg::doublet(As, Y);
+    X->scale(-0.5);
+
+    // core columns
+    auto FY = psi::linalg::doublet(Fock_, Y);
+    FY->add(dFc);
+    FY->add(dFa);
+    for (size_t i : core_mos_) {
+        auto [h, ni] = mos_rel_[i];
+        for (int p = 0; p < nmopi_[h]; ++p) {
+            X->add(h, p, ni, 2.0 * FY->get(h, p, ni));
+        }
+    }
+
+    // active columns
+    if (nactv_) {
+        // Y_{mt} for all MOs m and active t
+        size_t dim = nmo_ * nactv_;
+        std::vector<double> y_mt(dim, 0.0), q_pu(dim, 0.0);
+        for (size_t m = 0; m < nmo_; ++m) {
+            for (size_t t = 0; t < nactv_; ++t) {
+                auto [hm, nm] = mos_rel_[m];
+                auto [ht, nt] = mos_rel_[actv_mos_[t]];
+                if (hm == ht)
+                    y_mt[m * nactv_ + t] = Y->get(hm, nm, nt);
+            }
+        }
+        C_DGEMV('N', dim, dim, 1.0, hess_2e_.data(), dim, y_mt.data(), 1, 0.0, q_pu.data(), 1);
+
+        auto FcY = psi::linalg::doublet(F_closed_, Y);
+        FcY->add(dFc);
+
+        std::vector<size_t> offsets(nirrep_, 0);
+        for (int h = 1; h < nirrep_; ++h)
+            offsets[h] = offsets[h - 1] + nmopi_[h - 1];
+
+        for (size_t u = 0; u < nactv_; ++u) {
+            auto [h, nu] = mos_rel_[actv_mos_[u]];
+            int ndocc = ndoccpi_[h];
+            for (int p = 0; p < nmopi_[h]; ++p) {
+                double value = q_pu[(offsets[h] + p) * nactv_ + u];
+                for (int t = 0; t < nactvpi_[h]; ++t) {
+                    value += FcY->get(h, p, ndocc + t) * rdm1_->get(h, t, nu - ndocc);
+                }
+                X->add(h, p, nu, value);
+            }
+        }
+    }
+
+    for (size_t n = 0; n < nrot_; ++n) {
+        int h, i, j;
+        std::tie(h, i, j) = rot_mos_irrep_[n];
+        Hv->set(n, 2.0 * (X->get(h, i, j) - X->get(h, j, i)));
+    }
+
+    if (debug_print_) {
+        Hv->print();
+    }
+
+    timer_off("Orbital Hessian-vector product");
+}
+
+double CASSCF_ORB_GRAD::test_hess_vec(std::shared_ptr<psi::Vector> x,
+                                      std::shared_ptr<psi::Vector> v, double step) {
+    // (H v)_n ~ [g_n(x + step v) - g_n(x - step v)] / (2 step), where g is the gradient with
+    // respect to rotations of the displaced orbitals (the one returned by evaluate)
+    auto g = std::make_shared<psi::Vector>("g", nrot_);
+    auto Hv = std::make_shared<psi::Vector>("Hv", nrot_);
+    evaluate(x, g, true);
+    hess_vec(x, v, Hv);
+
+    auto x_disp = std::make_shared<psi::Vector>(*x);
+    auto g_plus = std::make_shared<psi::Vector>("g(x + step v)", nrot_);
+    x_disp->axpy(step, *v);
+    evaluate(x_disp, g_plus, true);
+
+    auto g_minus = std::make_shared<psi::Vector>("g(x - step v)", nrot_);
+    x_disp->axpy(-2.0 * step, *v);
+    evaluate(x_disp, g_minus, true);
+
+    // go back to the orbitals at x
+    evaluate(x, g, true);
+
+    double max_error = 0.0;
+    for (size_t n = 0; n < nrot_; ++n) {
+        double fd = (g_plus->get(n) - g_minus->get(n)) / (2.0 * step);
+        max_error = std::max(max_error, std::fabs(Hv->get(n) - fd));
+    }
+    return max_error;
+}
+
+void CASSCF_ORB_GRAD::build_hess_2e() {
+    // H_{pu,mt} = sum_{vw} [(pm|vw) D_{utvw} + 2 (pv|mw) D_{uvtw}]
+    //           = sum_{vw} [C^T J^{vw} C]_{pm} D_{utvw} + 2 [C^T K^{vw} C]_{pm} D_{uvtw}
+    // where J^{vw} and K^{vw} are built from the density C_v C_w^T. Only v <= w is computed
+    // because J^{wv} = J^{vw} and K^{wv} = (K^{vw})^T.
+    size_t dim = nmo_ * nactv_;
+    size_t mem_sys = psi::Process::environment.get_memory() * 0.85;
+    size_t mem_hess = dim * dim * sizeof(double);
+    if (mem_hess > mem_sys / 2) {
+        outfile->Printf("\n  Error: %.2f MB are needed to store the orbital Hessian intermediates.",
+                        mem_hess / 1048576.0);
+        outfile->Printf("\n  Please increase the memory or use ORB_ROTATION_ALGORITHM DIAGONAL.");
+        throw std::runtime_error("Not enough memory for the exact orbital Hessian");
+    }
+
+    hess_2e_.assign(dim * dim, 0.0);
+    hess_2e_valid_ = true;
+    if (nactv_ == 0)
+        return;
+
+    timer_on("Build orbital Hessian intermediates");
+
+    auto C_nosym = C_ao_nosym();
+    std::vector<std::shared_ptr<psi::Matrix>> Cact_vec(nactv_);
+    for (size_t x = 0; x < nactv_; ++x) {
+        Cact_vec[x] = std::make_shared<psi::Matrix>("Cact slice " + std::to_string(x), nso_, 1);
+        Cact_vec[x]->set_column(0, 0, C_nosym->get_column(0, actv_mos_[x]));
+    }
+
+    // J and K matrices of each pair of active orbitals are computed in buckets
+    size_t mem_jk = mem_sys - mem_hess;
+    size_t n_pairs = nactv_ * (nactv_ + 1) / 2;
+    size_t max_elements = n_pairs * 2 * nso_ * nso_ * sizeof(double);
+    size_t n_buckets = max_elements / mem_jk + (max_elements % mem_jk ? 1 : 0);
+    n_buckets = std::min(n_buckets, n_pairs);
+    size_t n_pairspb = n_pairs / n_buckets;
+    size_t n_mod = n_pairs - n_buckets * n_pairspb;
+
+    // throw for JK's strange "same" test in compute_D() of jk.cc (York 09/09/2020)
+    if (n_pairspb == 1 and nirrep_ != 1) {
+        outfile->Printf("\n  Error: Problem for JK in compute_D() in this case");
+        outfile->Printf("\n  Try to increase the memory or compute in C1 symmetry.");
+        throw std::runtime_error("JK does not work in this case. Try C1 symmetry.");
+    }
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    pairs.reserve(n_pairs);
+    for (size_t v = 0; v < nactv_; ++v) {
+        for (size_t w = v; w < nactv_; ++w) {
+            pairs.emplace_back(v, w);
+        }
+    }
+
+    JK_->set_do_K(true);
+    std::vector<std::shared_ptr<psi::Matrix>>& Cl = JK_->C_left();
+    std::vector<std::shared_ptr<psi::Matrix>>& Cr = JK_->C_right();
+
+    size_t nactv2 = nactv_ * nactv_;
+    size_t nactv3 = nactv2 * nactv_;
+    const auto& d2 = D2_.block("aaaa").data();
+
+    // 2-RDM slices for a given pair (v,w)
+    std::vector<double> dj(nactv2), dk1(nactv2), dk2(nactv2);
+
+    for (size_t N = 0, offset = 0; N < n_buckets; ++N) {
+        size_t n_pairs_N = N < n_mod ? n_pairspb + 1 : n_pairspb;
+
+        Cl.clear();
+        Cr.clear();
+        for (size_t i = 0; i < n_pairs_N; ++i) {
+            Cl.push_back(Cact_vec[pairs[i + offset].first]);
+            Cr.push_back(Cact_vec[pairs[i + offset].second]);
+        }
+        JK_->compute();
+
+        for (size_t i = 0; i < n_pairs_N; ++i) {
+            auto [v, w] = pairs[i + offset];
+            double f = v == w ? 0.0 : 1.0;
+            for (size_t u = 0; u < nactv_; ++u) {
+                for (size_t t = 0; t < nactv_; ++t) {
+                    size_t ut = u * nactv_ + t;
+                    dj[ut] = d2[u * nactv3 + t * nactv2 + v * nactv_ + w] +
+                             f * d2[u * nactv3 + t * nactv2 + w * nactv_ + v];
+                    dk1[ut] = 2.0 * d2[u * nactv3 + v * nactv2 + t * nactv_ + w];
+                    dk2[ut] = 2.0 * f * d2[u * nactv3 + w * nactv2 + t * nactv_ + v];
+                }
+            }
+
+            auto J = psi::linalg::triplet(C_nosym, JK_->J()[i], C_nosym, true, false, false);
+            auto K = psi::linalg::triplet(C_nosym, JK_->K()[i], C_nosym, true, false, false);
+            auto Jp = J->pointer();
+            auto Kp = K->pointer();
+
+#pragma omp parallel for
+            for (size_t p = 0; p < nmo_; ++p) {
+                for (size_t u = 0; u < nactv_; ++u) {
+                    double* row = hess_2e_.data() + (p * nactv_ + u) * dim;
+                    const double* dj_u = dj.data() + u * nactv_;
+                    const double* dk1_u = dk1.data() + u * nactv_;
+                    const double* dk2_u = dk2.data() + u * nactv_;
+                    for (size_t m = 0; m < nmo_; ++m) {
+                        double j = Jp[p][m], k1 = Kp[p][m], k2 = Kp[m][p];
+                        double* row_m = row + m * nactv_;
+                        for (size_t t = 0; t < nactv_; ++t) {
+                            row_m[t] += j * dj_u[t] + k1 * dk1_u[t] + k2 * dk2_u[t];
+                        }
+                    }
+                }
+            }
+        }
+
+        offset += n_pairs_N;
+    }
+
+    timer_off("Build orbital Hessian intermediates");
+}
+
+} // namespace forte
@@ -26,6 +26,10 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
 #include "ambit/tensor.h"
 
 #include "psi4/psi4-dec.h"
@@ -41,6 +45,8 @@
 #include "integrals/active_space_integrals.h"
 #include "integrals/make_integrals.h"
 #include "helpers/printing.h"
+#include "helpers/augmented_hessian/ah_param.h"
+#include "helpers/augmented_hessian/augmented_hessian.h"
 #include "helpers/lbfgs/lbfgs.h"
 #include "helpers/lbfgs/lbfgs_param.h"
 #include "orbital-helpers/semi_canonicalize.h"
@@ -106,6 +112,14 @@ void MCSCF_2STEP::read_options() {
     max_rot_ = options_->get_double("CASSCF_MAX_ROTATION");
     internal_rot_ = options_->get_bool("CASSCF_INTERNAL_ROT");
 
+    orb_rot_algo_ = options_->get_str("ORB_ROTATION_ALGORITHM");
+    test_hess_vec_ = options_->get_bool("CASSCF_TEST_HESS_VEC");
+    if (orb_rot_algo_ == "AUGMENTED_HESSIAN" and ints_->integral_type() == Custom) {
+        psi::outfile->Printf("\n  Warning: AUGMENTED_HESSIAN requires a JK object and is not "
+                             "available for CUSTOM integrals. Use DIAGONAL instead.");
+        orb_rot_algo_ = "DIAGONAL";
+    }
+
     // DIIS options
     diis_freq_ = options_->get_int("CASSCF_DIIS_FREQ");
     diis_start_ = options_->get_int("CASSCF_DIIS_START");
@@ -138,6 +152,7 @@ void MCSCF_2STEP::print_options() {
     printer.add_string_data({{"Print level", to_string(print_)},
                              {"Integral type", int_type_},
                              {"CI solver type", ci_type_},
+                             {"Orbital rotation algorithm", orb_rot_algo_},
                              {"Final orbital type", orb_type_redundant_},
                              {"Derivative type", der_type_}});
     printer.add_bool_data({{"Optimize orbitals", opt_orbs_},
@@ -200,6 +215,19 @@ double MCSCF_2STEP::compute_energy() {
     cas_grad.set_rdms(rdms);
     cas_grad.evaluate(R, dG);
 
+    // check the orbital Hessian-vector products against finite differences of the gradient
+    if (test_hess_vec_ and cas_grad.nrot() > 0) {
+        auto v = std::make_shared<psi::Vector>("v", cas_grad.nrot());
+        for (size_t n = 0, nrot = cas_grad.nrot(); n < nrot; ++n) {
+            v->set(n, std::cos(1.0 + n));
+        }
+        v->scale(1.0 / v->norm());
+        double error = cas_grad.test_hess_vec(R, v);
+        psi::outfile->Printf("\n  Largest error of the orbital Hessian-vector product: %.3e",
+                             error);
+        psi::Process::environment.globals["MCSCF HESSIAN-VECTOR ERROR"] = error;
+    }
+
     // Case 1: if there is no orbital optimization
     if (no_orb_opt) {
         energy_ = e_c;
@@ -218,6 +246,27 @@ double MCSCF_2STEP::compute_energy() {
     lbfgs_param->step_length_method = LBFGS_PARAM::STEP_LENGTH_METHOD::MAX_CORRECTION;
     LBFGS lbfgs(lbfgs_param);
 
+    // set up the trust-region augmented Hessian solver, it uses the same max micro iterations
+    auto ah_param = std::make_shared<AH_PARAM>();
+    ah_param->epsilon = g_conv_;
+    ah_param->print = lbfgs_param->print;
+    ah_param->trust_radius = max_rot_;
+    ah_param->max_trust_radius = max_rot_;
+    ah_param->min_trust_radius = std::min(1.0e-6, max_rot_);
+    AugmentedHessian ah(ah_param);
+
+    // optimize orbitals for the current RDMs
+    // return the energy, gradient, number of micro iterations, and if converged
+    auto optimize_orbitals = [&]() {
+        if (orb_rot_algo_ == "AUGMENTED_HESSIAN") {
+            ah_param->maxiter = lbfgs_param->maxiter;
+            double e = ah.minimize(cas_grad, R);
+            return std::make_tuple(e, ah.g(), ah.iter(), ah.converged());
+        }
+        double e = lbfgs.minimize(cas_grad, R);
+        return std::make_tuple(e, lbfgs.g(), lbfgs.iter(), lbfgs.converged());
+    };
+
     bool converged = false;
 
     // }
@@ -229,12 +278,12 @@ double MCSCF_2STEP::compute_energy() {
 
         print_h2("Single-Reference Orbital Optimization");
         cas_grad.set_rdms(rdms);
-        energy_ = lbfgs.minimize(cas_grad, R);
-        converged = lbfgs.converged();
+        int n_iter;
+        std::tie(energy_, std::ignore, n_iter, converged) = optimize_orbitals();
         pass_energy_to_psi4(converged);
 
         if (converged) {
-            psi::outfile->Printf("\n\n  SCF converged in %d iterations!", lbfgs.iter());
+            psi::outfile->Printf("\n\n  SCF converged in %d iterations!", n_iter);
             psi::outfile->Printf("\n  @ Final energy: %.15f", energy_);
         }
     } else { // Case 3: multi-determinant SCF
@@ -247,6 +296,19 @@ double MCSCF_2STEP::compute_energy() {
             diis_manager.set_vector_size(R.get());
         }
 
+        // The augmented Hessian steps do not include the CI-orbital coupling. Its CI-CI and
+        // orbital-CI blocks could be built with generalized_sigma and generalized_rdms of the
+        // active space method (only DETCI implements them), but the CI-orbital block needs the
+        // one-index transformed active-space Hamiltonian applied to the CI vectors. The orbital
+        // gradient code does not build these integrals, and only DETCI with the sparse-list sigma
+        // vector can apply explicit integrals (add_sigma_kbody).
+        if (orb_rot_algo_ == "AUGMENTED_HESSIAN") {
+            psi::outfile->Printf("\n  Warning: AUGMENTED_HESSIAN takes second-order orbital steps "
+                                 "at fixed CI coefficients.");
+            psi::outfile->Printf("\n           The CI-orbital coupling of the Hessian is not "
+                                 "included.");
+        }
+
         // CI solver set up
         bool restart = (ci_type_ == "FCI" or ci_type_ == "DETCI" or ci_type_ == "CAS");
         as_solver_->set_maxiter(restart ? 15 : as_maxiter);
@@ -283,16 +345,15 @@ double MCSCF_2STEP::compute_energy() {
             if (print_ >= PrintLevel::Verbose)
                 print_h2("Optimizing Orbitals for Current RDMs");
 
-            double e_o = lbfgs.minimize(cas_grad, R);
+            auto [e_o, g_o, n_micro, o_converged] = optimize_orbitals();
             energy_ = e_o;
 
             // info for orbital optimization
-            dG->subtract(*lbfgs.g());
+            dG->subtract(*g_o);
             double g_rms = dG->rms();
-            dG->copy(*lbfgs.g());
+            dG->copy(*g_o);
 
-            int n_micro = lbfgs.iter();
-            char o_conv = lbfgs.converged() ? 'Y' : 'N';
+            char o_conv = o_converged ? 'Y' : 'N';
 
             // save data for this macro iteration
             CASSCF_HISTORY hist(e_c, e_o, g_rms, n_micro);
@@ -320,7 +381,7 @@ double MCSCF_2STEP::compute_energy() {
             //                      e_c, de_c, e_o, de_o, de, g_rms, n_micro, o_conv);
 
             // test convergence
-            if (macro == 1 and lbfgs.converged() and std::fabs(de) < e_conv_) {
+            if (macro == 1 and o_converged and std::fabs(de) < e_conv_) {
                 psi::outfile->Printf("\n\n  Initial orbitals are already converged!");
                 converged = true;
                 break;
@@ -328,7 +389,7 @@ double MCSCF_2STEP::compute_energy() {
 
             bool is_de_conv = skip_de_conv or std::fabs(de) < e_conv_;
             bool is_e_conv = std::fabs(de_c) < e_conv_ and std::fabs(de_o) < e_conv_;
-            bool is_g_conv = g_rms < g_conv_ or lbfgs.converged();
+            bool is_g_conv = g_rms < g_conv_ or o_converged;
             bool is_diis_conv = !do_diis_ or macro < diis_start_ + diis_min_vec_ or
                                 diis_manager.subspace_size() > 1;
             if (is_de_conv and is_e_conv and is_g_conv and is_diis_conv) {
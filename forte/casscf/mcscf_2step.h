@@ -116,6 +116,11 @@ class MCSCF_2STEP {
     /// Max allowed value for orbital rotation
     double max_rot_;
 
+    /// Orbital optimizer: DIAGONAL (L-BFGS) or AUGMENTED_HESSIAN (exact Hessian, trust region)
+    std::string orb_rot_algo_;
+    /// Compare the orbital Hessian-vector products with finite differences of the gradient
+    bool test_hess_vec_ = false;
+
     /// Keep internal (active-active) rotations
     bool internal_rot_;
 
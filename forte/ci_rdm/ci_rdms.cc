@@ -26,14 +26,17 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include "helpers/threading.h"
 #include "helpers/timer.h"
 #include "sparse_ci/determinant_substitution_lists.h"
+#include "sparse_ci/substitution_list_kernels.h"
 
 #include "ci_rdms.h"
 
@@ -93,6 +96,13 @@ void CI_RDMS::startup() {
 
 void CI_RDMS::set_max_rdm(int rdm) { max_rdm_ = rdm; }
 
+size_t CI_RDMS::rdm_num_threads(size_t rdm_size) const {
+    // use at most a quarter of the memory for the private copies of the RDMs
+    const size_t memory = psi::Process::environment.get_memory() / 4;
+    const size_t max_copies = memory / (sizeof(double) * std::max<size_t>(rdm_size, 1));
+    return std::min<size_t>(omp_get_max_threads(), 1 + max_copies);
+}
+
 double CI_RDMS::get_energy(std::shared_ptr<ActiveSpaceIntegrals> as_ints,
                            std::vector<double>& oprdm_a, std::vector<double>& oprdm_b,
                            std::vector<double>& tprdm_aa, std::vector<double>& tprdm_bb,
@@ -192,54 +202,26 @@ void CI_RDMS::compute_1rdm_op(std::vector<double>& oprdm_a, std::vector<double>&
 
     // Build the diagonal part
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t J = 0; J < dim_space_; ++J) {
-        double cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
-        for (int pp : dets[J].get_alfa_occ(norb_)) {
-            oprdm_a[pp * norb_ + pp] += cJ_sq;
-        }
-        for (int pp : dets[J].get_beta_occ(norb_)) {
-            oprdm_b[pp * norb_ + pp] += cJ_sq;
-        }
-    }
-
-    for (const auto& coupled_dets : op->a_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [I, _p] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_p = _p < 0;
-
-            auto vI1 = evecs_->get(I, root1_);
-            auto vI2 = evecs_->get(I, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [J, _q] = coupled_dets[b];
-                auto q = std::abs(_q) - 1;
-                auto sign = ((_q < 0) == sign_p) ? 1 : -1;
-
-                oprdm_a[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
-                oprdm_a[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* rdm_a = out[0];
+        double* rdm_b = out[1];
+#pragma omp for schedule(dynamic)
+        for (size_t J = 0; J < dim_space_; ++J) {
+            double cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
+            for (int pp : dets[J].get_alfa_occ(norb_)) {
+                rdm_a[pp * norb_ + pp] += cJ_sq;
             }
-        }
-    }
-    for (const auto& coupled_dets : op->b_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [I, _p] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_p = _p < 0;
-
-            auto vI1 = evecs_->get(I, root1_);
-            auto vI2 = evecs_->get(I, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [J, _q] = coupled_dets[b];
-                auto q = std::abs(_q) - 1;
-                auto sign = ((_q < 0) == sign_p) ? 1 : -1;
-
-                oprdm_b[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
-                oprdm_b[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+            for (int pp : dets[J].get_beta_occ(norb_)) {
+                rdm_b[pp * norb_ + pp] += cJ_sq;
             }
         }
-    }
+
+        auto c1 = [&](size_t I) { return evecs_->get(I, root1_); };
+        auto c2 = [&](size_t I) { return evecs_->get(I, root2_); };
+        add_1rdm_single_list(op->a_list_, norb_, c1, c2, rdm_a);
+        add_1rdm_single_list(op->b_list_, norb_, c1, c2, rdm_b);
+    };
+    accumulate_in_parallel({&oprdm_a, &oprdm_b}, accumulate, rdm_num_threads(2 * norb2_));
 
     if (print_) {
         outfile->Printf("\n  Time spent building 1-rdm: %.3e seconds", build.get());
@@ -339,133 +321,150 @@ void CI_RDMS::compute_2rdm_op(std::vector<double>& tprdm_aa, std::vector<double>
 
     // Build the diagonal part
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t J = 0; J < dim_space_; ++J) {
-        auto cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
-        auto aocc = dets[J].get_alfa_occ(norb_);
-        auto bocc = dets[J].get_beta_occ(norb_);
-
-        auto naocc = aocc.size();
-        auto nbocc = bocc.size();
-
-        for (size_t p = 0; p < naocc; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = p + 1; q < naocc; ++q) {
-                auto qq = aocc[q];
-
-                tprdm_aa[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
-                tprdm_aa[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
-
-                tprdm_aa[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
-                tprdm_aa[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* aa = out[0];
+        double* ab = out[1];
+        double* bb = out[2];
+#pragma omp for schedule(dynamic)
+        for (size_t J = 0; J < dim_space_; ++J) {
+            auto cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
+            auto aocc = dets[J].get_alfa_occ(norb_);
+            auto bocc = dets[J].get_beta_occ(norb_);
+
+            auto naocc = aocc.size();
+            auto nbocc = bocc.size();
+
+            for (size_t p = 0; p < naocc; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = p + 1; q < naocc; ++q) {
+                    auto qq = aocc[q];
+
+                    aa[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    aa[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
+
+                    aa[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                    aa[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                }
             }
-        }
 
-        for (size_t p = 0; p < nbocc; ++p) {
-            auto pp = bocc[p];
-            for (size_t q = p + 1; q < nbocc; ++q) {
-                auto qq = bocc[q];
+            for (size_t p = 0; p < nbocc; ++p) {
+                auto pp = bocc[p];
+                for (size_t q = p + 1; q < nbocc; ++q) {
+                    auto qq = bocc[q];
 
-                tprdm_bb[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
-                tprdm_bb[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
+                    bb[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    bb[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
 
-                tprdm_bb[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
-                tprdm_bb[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                    bb[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                    bb[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                }
             }
-        }
 
-        for (size_t p = 0; p < naocc; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = 0; q < nbocc; ++q) {
-                auto qq = bocc[q];
+            for (size_t p = 0; p < naocc; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = 0; q < nbocc; ++q) {
+                    auto qq = bocc[q];
 
-                tprdm_ab[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    ab[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                }
             }
         }
-    }
-
-    // aaaa
-    for (const auto& coupled_dets : op->aa_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
 
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tprdm_aa[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-                tprdm_aa[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
-                tprdm_aa[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
-                tprdm_aa[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tprdm_aa[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
-                tprdm_aa[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tprdm_aa[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
-                tprdm_aa[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+        // aaaa
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aa_list_.size(); ++K) {
+            const auto coupled_dets = op->aa_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    aa[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+                    aa[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
+                    aa[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
+                    aa[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    aa[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                    aa[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    aa[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
+                    aa[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                }
             }
         }
-    }
-
-    // bbbb
-    for (const auto& coupled_dets : op->bb_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
 
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tprdm_bb[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-                tprdm_bb[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
-                tprdm_bb[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
-                tprdm_bb[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tprdm_bb[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
-                tprdm_bb[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tprdm_bb[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
-                tprdm_bb[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+        // bbbb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->bb_list_.size(); ++K) {
+            const auto coupled_dets = op->bb_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    bb[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+                    bb[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
+                    bb[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
+                    bb[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    bb[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                    bb[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    bb[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
+                    bb[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                }
             }
         }
-    }
 
-    // aabb
-    for (const auto& coupled_dets : op->ab_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
-
-                double value = vJ1 * evecs_->get(I, root2_) * sign;
-                tprdm_ab[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tprdm_ab[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+        // aabb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->ab_list_.size(); ++K) {
+            const auto coupled_dets = op->ab_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    double value = vJ1 * evecs_->get(I, root2_) * sign;
+                    ab[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    ab[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                }
             }
         }
-    }
+    };
+    accumulate_in_parallel({&tprdm_aa, &tprdm_ab, &tprdm_bb}, accumulate,
+                           rdm_num_threads(3 * norb4_));
 
     if (print_) {
         outfile->Printf("\n  Time spent building 2-rdm: %.3e seconds", build.get());
@@ -742,668 +741,685 @@ void CI_RDMS::compute_3rdm_op(std::vector<double>& tprdm_aaa, std::vector<double
 
     // Build the diagonal part
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t I = 0; I < dim_space_; ++I) {
-        double cI_sq = evecs_->get(I, root1_) * evecs_->get(I, root2_);
-
-        auto aocc = dets[I].get_alfa_occ(norb_);
-        auto bocc = dets[I].get_beta_occ(norb_);
-        auto na = aocc.size();
-        auto nb = bocc.size();
-
-        for (size_t _p = 0; _p < na; ++_p) {
-            auto p = aocc[_p];
-            for (size_t _q = _p + 1; _q < na; ++_q) {
-                auto q = aocc[_q];
-                for (size_t _r = _q + 1; _r < na; ++_r) {
-                    auto r = aocc[_r];
-
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
-
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
-
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* aaa = out[0];
+        double* aab = out[1];
+        double* abb = out[2];
+        double* bbb = out[3];
+#pragma omp for schedule(dynamic)
+        for (size_t I = 0; I < dim_space_; ++I) {
+            double cI_sq = evecs_->get(I, root1_) * evecs_->get(I, root2_);
+
+            auto aocc = dets[I].get_alfa_occ(norb_);
+            auto bocc = dets[I].get_beta_occ(norb_);
+            auto na = aocc.size();
+            auto nb = bocc.size();
+
+            for (size_t _p = 0; _p < na; ++_p) {
+                auto p = aocc[_p];
+                for (size_t _q = _p + 1; _q < na; ++_q) {
+                    auto q = aocc[_q];
+                    for (size_t _r = _q + 1; _r < na; ++_r) {
+                        auto r = aocc[_r];
+
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        aaa[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        aaa[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        aaa[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        aaa[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        aaa[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        aaa[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t _p = 0; _p < na; ++_p) {
-            auto p = aocc[_p];
-            for (size_t _q = _p + 1; _q < na; ++_q) {
-                auto q = aocc[_q];
-                for (size_t _r = 0; _r < nb; ++_r) {
-                    auto r = bocc[_r];
-
-                    tprdm_aab[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_aab[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-                    tprdm_aab[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_aab[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
+            for (size_t _p = 0; _p < na; ++_p) {
+                auto p = aocc[_p];
+                for (size_t _q = _p + 1; _q < na; ++_q) {
+                    auto q = aocc[_q];
+                    for (size_t _r = 0; _r < nb; ++_r) {
+                        auto r = bocc[_r];
+
+                        aab[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        aab[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+                        aab[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        aab[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t _p = 0; _p < na; ++_p) {
-            auto p = aocc[_p];
-            for (size_t _q = 0; _q < nb; ++_q) {
-                auto q = bocc[_q];
-                for (size_t _r = _q + 1; _r < nb; ++_r) {
-                    auto r = bocc[_r];
-
-                    tprdm_abb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_abb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_abb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_abb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
+            for (size_t _p = 0; _p < na; ++_p) {
+                auto p = aocc[_p];
+                for (size_t _q = 0; _q < nb; ++_q) {
+                    auto q = bocc[_q];
+                    for (size_t _r = _q + 1; _r < nb; ++_r) {
+                        auto r = bocc[_r];
+
+                        abb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        abb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        abb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        abb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t _p = 0; _p < nb; ++_p) {
-            auto p = bocc[_p];
-            for (size_t _q = _p + 1; _q < nb; ++_q) {
-                auto q = bocc[_q];
-                for (size_t _r = _q + 1; _r < nb; ++_r) {
-                    auto r = bocc[_r];
-
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
-
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
-
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] +=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] -=
-                        cI_sq;
-
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] +=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] -=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] +=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] -=
-                        cI_sq;
-                    tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
-                        cI_sq;
+            for (size_t _p = 0; _p < nb; ++_p) {
+                auto p = bocc[_p];
+                for (size_t _q = _p + 1; _q < nb; ++_q) {
+                    auto q = bocc[_q];
+                    for (size_t _r = _q + 1; _r < nb; ++_r) {
+                        auto r = bocc[_r];
+
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        bbb[p * norb5_ + q * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        bbb[p * norb5_ + r * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        bbb[r * norb5_ + p * norb4_ + q * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        bbb[r * norb5_ + q * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + q * norb_ + r] +=
+                            cI_sq;
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + p * norb2_ + r * norb_ + q] -=
+                            cI_sq;
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + p * norb_ + q] +=
+                            cI_sq;
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + r * norb2_ + q * norb_ + p] -=
+                            cI_sq;
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + r * norb_ + p] +=
+                            cI_sq;
+                        bbb[q * norb5_ + r * norb4_ + p * norb3_ + q * norb2_ + p * norb_ + r] -=
+                            cI_sq;
+
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + q * norb_ + r] -=
+                            cI_sq;
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + p * norb2_ + r * norb_ + q] +=
+                            cI_sq;
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + p * norb_ + q] -=
+                            cI_sq;
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + r * norb2_ + q * norb_ + p] +=
+                            cI_sq;
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + r * norb_ + p] -=
+                            cI_sq;
+                        bbb[q * norb5_ + p * norb4_ + r * norb3_ + q * norb2_ + p * norb_ + r] +=
+                            cI_sq;
+                    }
                 }
             }
         }
-    }
-
-    // aaa aaa
-    for (const auto& coupled_dets : op->aaa_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_aaa[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_aaa[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
-
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_aaa[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
-
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_aaa[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_aaa[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_aaa[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
 
-                tprdm_aaa[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
-                tprdm_aaa[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_aaa[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_aaa[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
-                tprdm_aaa[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_aaa[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
+        // aaa aaa
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aaa_list_.size(); ++K) {
+            const auto coupled_dets = op->aaa_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    aaa[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    aaa[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    aaa[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    aaa[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    aaa[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    aaa[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+
+                    aaa[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                    aaa[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    aaa[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    aaa[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                    aaa[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    aaa[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                }
             }
         }
-    }
 
-    // aab aab
-    for (const auto& coupled_dets : op->aab_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tprdm_aab[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_aab[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_aab[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_aab[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tprdm_aab[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_aab[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_aab[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-                tprdm_aab[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
+        // aab aab
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aab_list_.size(); ++K) {
+            const auto coupled_dets = op->aab_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    aab[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    aab[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    aab[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    aab[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    aab[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    aab[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    aab[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+                    aab[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                }
             }
         }
-    }
-
-    // abb abb
-    for (const auto& coupled_dets : op->abb_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tprdm_abb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_abb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_abb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_abb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tprdm_abb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_abb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_abb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-                tprdm_abb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
+        // abb abb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->abb_list_.size(); ++K) {
+            const auto coupled_dets = op->abb_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    abb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    abb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    abb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    abb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    abb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    abb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    abb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+                    abb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                }
             }
         }
-    }
-
-    // bbb bbb
-    for (const auto& coupled_dets : op->bbb_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_bbb[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_bbb[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
-
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_bbb[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
-
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_bbb[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] +=
-                    value;
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -=
-                    value;
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -=
-                    value;
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] +=
-                    value;
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -=
-                    value;
-                tprdm_bbb[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] +=
-                    value;
-
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -=
-                    value;
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] +=
-                    value;
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] +=
-                    value;
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -=
-                    value;
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] +=
-                    value;
-                tprdm_bbb[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -=
-                    value;
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] +=
-                    value;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] +=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -=
-                    value;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -=
-                    value;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] +=
-                    value;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] +=
-                    value;
-
-                tprdm_bbb[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
-                tprdm_bbb[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_bbb[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_bbb[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
-                tprdm_bbb[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] +=
-                    value;
-                tprdm_bbb[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -=
-                    value;
+        // bbb bbb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->bbb_list_.size(); ++K) {
+            const auto coupled_dets = op->bbb_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    bbb[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    bbb[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    bbb[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    bbb[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] +=
+                        value;
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -=
+                        value;
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -=
+                        value;
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] +=
+                        value;
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -=
+                        value;
+                    bbb[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] +=
+                        value;
+
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -=
+                        value;
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] +=
+                        value;
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] +=
+                        value;
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -=
+                        value;
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] +=
+                        value;
+                    bbb[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -=
+                        value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] +=
+                        value;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] +=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -=
+                        value;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] +=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -=
+                        value;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] +=
+                        value;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] +=
+                        value;
+
+                    bbb[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                    bbb[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    bbb[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    bbb[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                    bbb[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] +=
+                        value;
+                    bbb[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -=
+                        value;
+                }
             }
         }
-    }
+    };
+    accumulate_in_parallel({&tprdm_aaa, &tprdm_aab, &tprdm_abb, &tprdm_bbb}, accumulate,
+                           rdm_num_threads(4 * norb6_));
 
     if (print_) {
         outfile->Printf("\n  Time spent building 3-rdm: %.3e seconds", build.get());
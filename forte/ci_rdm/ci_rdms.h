@@ -231,6 +231,10 @@ class CI_RDMS {
     // Generate three-particle map
     void get_three_map();
 
+    // The number of threads used to build RDMs with rdm_size elements in total. Every thread but
+    // the first one holds a private copy of the RDMs, so the number of threads is limited by memory
+    size_t rdm_num_threads(size_t rdm_size) const;
+
     //*- Functions for Dynamic RDM builds -*//
 
     // Function to fill 3rdm with all (or half of all) permutations of the 6 indices
@@ -31,6 +31,7 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libpsi4util/process.h"
 
+#include "helpers/threading.h"
 #include "helpers/timer.h"
 #include "sparse_ci/determinant_substitution_lists.h"
 
@@ -91,54 +92,65 @@ void CI_RDMS::compute_1rdm_sf_op(std::vector<double>& opdm) {
     timer build("Build SF 1-RDM");
 
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t J = 0; J < dim_space_; ++J) {
-        double cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
-        for (int pp : dets[J].get_alfa_occ(norb_)) {
-            opdm[pp * norb_ + pp] += cJ_sq;
-        }
-        for (int pp : dets[J].get_beta_occ(norb_)) {
-            opdm[pp * norb_ + pp] += cJ_sq;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* rdm = out[0];
+#pragma omp for schedule(dynamic)
+        for (size_t J = 0; J < dim_space_; ++J) {
+            double cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
+            for (int pp : dets[J].get_alfa_occ(norb_)) {
+                rdm[pp * norb_ + pp] += cJ_sq;
+            }
+            for (int pp : dets[J].get_beta_occ(norb_)) {
+                rdm[pp * norb_ + pp] += cJ_sq;
+            }
         }
-    }
-
-    for (const auto& coupled_dets : op->a_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [I, _p] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_p = _p < 0;
 
-            auto vI1 = evecs_->get(I, root1_);
-            auto vI2 = evecs_->get(I, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [J, _q] = coupled_dets[b];
-                auto q = std::abs(_q) - 1;
-                auto sign = ((_q < 0) == sign_p) ? 1 : -1;
-
-                opdm[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
-                opdm[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->a_list_.size(); ++K) {
+            const auto coupled_dets = op->a_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [I, _p] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_p = _p < 0;
+
+                auto vI1 = evecs_->get(I, root1_);
+                auto vI2 = evecs_->get(I, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [J, _q] = coupled_dets[b];
+                    auto q = std::abs(_q) - 1;
+                    auto sign = ((_q < 0) == sign_p) ? 1 : -1;
+
+                    rdm[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
+                    rdm[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+                }
             }
         }
-    }
-    for (const auto& coupled_dets : op->b_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [I, _p] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_p = _p < 0;
-
-            auto vI1 = evecs_->get(I, root1_);
-            auto vI2 = evecs_->get(I, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [J, _q] = coupled_dets[b];
-                auto q = std::abs(_q) - 1;
-                auto sign = ((_q < 0) == sign_p) ? 1 : -1;
-
-                opdm[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
-                opdm[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->b_list_.size(); ++K) {
+            const auto coupled_dets = op->b_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [I, _p] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_p = _p < 0;
+
+                auto vI1 = evecs_->get(I, root1_);
+                auto vI2 = evecs_->get(I, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [J, _q] = coupled_dets[b];
+                    auto q = std::abs(_q) - 1;
+                    auto sign = ((_q < 0) == sign_p) ? 1 : -1;
+
+                    rdm[p * norb_ + q] += vI1 * evecs_->get(J, root2_) * sign;
+                    rdm[q * norb_ + p] += evecs_->get(J, root1_) * vI2 * sign;
+                }
             }
         }
-    }
+    };
+    accumulate_in_parallel({&opdm}, accumulate, rdm_num_threads(norb2_));
 
     auto t_build = build.stop();
     if (print_) {
@@ -234,136 +246,150 @@ void CI_RDMS::compute_2rdm_sf_op(std::vector<double>& tpdm) {
     timer build("Build SF 2-RDM");
 
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t J = 0; J < dim_space_; ++J) {
-        auto cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
-        auto aocc = dets[J].get_alfa_occ(norb_);
-        auto bocc = dets[J].get_beta_occ(norb_);
-
-        auto naocc = aocc.size();
-        auto nbocc = bocc.size();
-
-        for (size_t p = 0; p < naocc; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = p + 1; q < naocc; ++q) {
-                auto qq = aocc[q];
-
-                tpdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
-                tpdm[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
-
-                tpdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
-                tpdm[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* rdm = out[0];
+#pragma omp for schedule(dynamic)
+        for (size_t J = 0; J < dim_space_; ++J) {
+            auto cJ_sq = evecs_->get(J, root1_) * evecs_->get(J, root2_);
+            auto aocc = dets[J].get_alfa_occ(norb_);
+            auto bocc = dets[J].get_beta_occ(norb_);
+
+            auto naocc = aocc.size();
+            auto nbocc = bocc.size();
+
+            for (size_t p = 0; p < naocc; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = p + 1; q < naocc; ++q) {
+                    auto qq = aocc[q];
+
+                    rdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    rdm[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
+
+                    rdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                    rdm[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                }
             }
-        }
 
-        for (size_t p = 0; p < nbocc; ++p) {
-            auto pp = bocc[p];
-            for (size_t q = p + 1; q < nbocc; ++q) {
-                auto qq = bocc[q];
+            for (size_t p = 0; p < nbocc; ++p) {
+                auto pp = bocc[p];
+                for (size_t q = p + 1; q < nbocc; ++q) {
+                    auto qq = bocc[q];
 
-                tpdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
-                tpdm[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
+                    rdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    rdm[qq * norb3_ + pp * norb2_ + pp * norb_ + qq] -= cJ_sq;
 
-                tpdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
-                tpdm[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                    rdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                    rdm[pp * norb3_ + qq * norb2_ + qq * norb_ + pp] -= cJ_sq;
+                }
             }
-        }
 
-        for (size_t p = 0; p < naocc; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = 0; q < nbocc; ++q) {
-                auto qq = bocc[q];
+            for (size_t p = 0; p < naocc; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = 0; q < nbocc; ++q) {
+                    auto qq = bocc[q];
 
-                tpdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
-                tpdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                    rdm[pp * norb3_ + qq * norb2_ + pp * norb_ + qq] += cJ_sq;
+                    rdm[qq * norb3_ + pp * norb2_ + qq * norb_ + pp] += cJ_sq;
+                }
             }
         }
-    }
-
-    // aaaa
-    for (const auto& coupled_dets : op->aa_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tpdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-                tpdm[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
-                tpdm[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
-                tpdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tpdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
-                tpdm[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
-                tpdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+        // aaaa
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aa_list_.size(); ++K) {
+            const auto coupled_dets = op->aa_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    rdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+                    rdm[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
+                    rdm[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
+                    rdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    rdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                    rdm[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
+                    rdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                }
             }
         }
-    }
-
-    // bbbb
-    for (const auto& coupled_dets : op->bb_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
 
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tpdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-                tpdm[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
-                tpdm[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
-                tpdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tpdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
-                tpdm[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
-                tpdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+        // bbbb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->bb_list_.size(); ++K) {
+            const auto coupled_dets = op->bb_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    rdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+                    rdm[p * norb3_ + q * norb2_ + s * norb_ + r] -= value;
+                    rdm[q * norb3_ + p * norb2_ + r * norb_ + s] -= value;
+                    rdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    rdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                    rdm[s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[r * norb3_ + s * norb2_ + q * norb_ + p] -= value;
+                    rdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                }
             }
         }
-    }
-
-    // aabb
-    for (const auto& coupled_dets : op->ab_list_) {
-        for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size; ++a) {
-            const auto [J, _p, q] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pq = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _r, s] = coupled_dets[b];
-                auto r = std::abs(_r) - 1;
-                auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
-
-                double value = vJ1 * evecs_->get(I, root2_) * sign;
-                tpdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
-                tpdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tpdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
-                tpdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+        // aabb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->ab_list_.size(); ++K) {
+            const auto coupled_dets = op->ab_list_[K];
+            for (size_t a = 0, coupled_dets_size = coupled_dets.size(); a < coupled_dets_size;
+                 ++a) {
+                const auto [J, _p, q] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pq = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _r, s] = coupled_dets[b];
+                    auto r = std::abs(_r) - 1;
+                    auto sign = ((_r < 0) == sign_pq) ? 1 : -1;
+
+                    double value = vJ1 * evecs_->get(I, root2_) * sign;
+                    rdm[p * norb3_ + q * norb2_ + r * norb_ + s] += value;
+                    rdm[q * norb3_ + p * norb2_ + s * norb_ + r] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    rdm[r * norb3_ + s * norb2_ + p * norb_ + q] += value;
+                    rdm[s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                }
             }
         }
-    }
+    };
+    accumulate_in_parallel({&tpdm}, accumulate, rdm_num_threads(norb4_));
 
     auto t_build = build.stop();
     if (print_) {
@@ -576,586 +602,599 @@ void CI_RDMS::compute_3rdm_sf_op(std::vector<double>& tpdm3) {
 
     // Build the diagonal part
     const det_hashvec& dets = wfn_.wfn_hash();
-    for (size_t I = 0; I < dim_space_; ++I) {
-        double cI_sq = evecs_->get(I, root1_) * evecs_->get(I, root2_);
-
-        auto aocc = dets[I].get_alfa_occ(norb_);
-        auto bocc = dets[I].get_beta_occ(norb_);
-        auto na = aocc.size();
-        auto nb = bocc.size();
-
-        for (size_t p = 0; p < na; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = p + 1; q < na; ++q) {
-                auto qq = aocc[q];
-                for (size_t r = q + 1; r < na; ++r) {
-                    auto rr = aocc[r];
-
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
+    auto accumulate = [&](const std::vector<double*>& out) {
+        double* rdm = out[0];
+#pragma omp for schedule(dynamic)
+        for (size_t I = 0; I < dim_space_; ++I) {
+            double cI_sq = evecs_->get(I, root1_) * evecs_->get(I, root2_);
+
+            auto aocc = dets[I].get_alfa_occ(norb_);
+            auto bocc = dets[I].get_beta_occ(norb_);
+            auto na = aocc.size();
+            auto nb = bocc.size();
+
+            for (size_t p = 0; p < na; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = p + 1; q < na; ++q) {
+                    auto qq = aocc[q];
+                    for (size_t r = q + 1; r < na; ++r) {
+                        auto rr = aocc[r];
+
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t p = 0; p < na; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = p + 1; q < na; ++q) {
-                auto qq = aocc[q];
-                for (size_t r = 0; r < nb; ++r) {
-                    auto rr = bocc[r];
-
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
+            for (size_t p = 0; p < na; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = p + 1; q < na; ++q) {
+                    auto qq = aocc[q];
+                    for (size_t r = 0; r < nb; ++r) {
+                        auto rr = bocc[r];
+
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t p = 0; p < na; ++p) {
-            auto pp = aocc[p];
-            for (size_t q = 0; q < nb; ++q) {
-                auto qq = bocc[q];
-                for (size_t r = q + 1; r < nb; ++r) {
-                    auto rr = bocc[r];
-
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
+            for (size_t p = 0; p < na; ++p) {
+                auto pp = aocc[p];
+                for (size_t q = 0; q < nb; ++q) {
+                    auto qq = bocc[q];
+                    for (size_t r = q + 1; r < nb; ++r) {
+                        auto rr = bocc[r];
+
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                    }
                 }
             }
-        }
 
-        for (size_t p = 0; p < nb; ++p) {
-            auto pp = bocc[p];
-            for (size_t q = p + 1; q < nb; ++q) {
-                auto qq = bocc[q];
-                for (size_t r = q + 1; r < nb; ++r) {
-                    auto rr = bocc[r];
-
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
-
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] -= cI_sq;
-
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
-                          rr] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
-                          qq] += cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
-                          qq] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
-                          pp] += cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
-                          pp] -= cI_sq;
-                    tpdm3[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
-                          rr] += cI_sq;
+            for (size_t p = 0; p < nb; ++p) {
+                auto pp = bocc[p];
+                for (size_t q = p + 1; q < nb; ++q) {
+                    auto qq = bocc[q];
+                    for (size_t r = q + 1; r < nb; ++r) {
+                        auto rr = bocc[r];
+
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[pp * norb5_ + qq * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[pp * norb5_ + rr * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + pp * norb4_ + qq * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[rr * norb5_ + qq * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] += cI_sq;
+                        rdm[qq * norb5_ + rr * norb4_ + pp * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] -= cI_sq;
+
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + qq * norb_ +
+                              rr] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + pp * norb2_ + rr * norb_ +
+                              qq] += cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + pp * norb_ +
+                              qq] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + rr * norb2_ + qq * norb_ +
+                              pp] += cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + rr * norb_ +
+                              pp] -= cI_sq;
+                        rdm[qq * norb5_ + pp * norb4_ + rr * norb3_ + qq * norb2_ + pp * norb_ +
+                              rr] += cI_sq;
+                    }
                 }
             }
         }
-    }
-
-    // Build the off-diagonal part
-
-    // aaa aaa
-    for (const auto& coupled_dets : op->aaa_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] += value;
 
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+        // Build the off-diagonal part
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+        // aaa aaa
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aaa_list_.size(); ++K) {
+            const auto coupled_dets = op->aaa_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                }
             }
         }
-    }
-
-    // aab aab
-    for (const auto& coupled_dets : op->aab_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
-
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
-
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
 
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
-
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
-
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+        // aab aab
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->aab_list_.size(); ++K) {
+            const auto coupled_dets = op->aab_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
+
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
+
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
+
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
+
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                }
             }
         }
-    }
-
-    // abb abb
-    for (const auto& coupled_dets : op->abb_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
 
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
-
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
-
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
-
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
-
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+        // abb abb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->abb_list_.size(); ++K) {
+            const auto coupled_dets = op->abb_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
+
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
+
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
+
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
+
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                }
             }
         }
-    }
-
-    // bbb bbb
-    for (const auto& coupled_dets : op->bbb_list_) {
-        auto coupled_dets_size = coupled_dets.size();
-
-        for (size_t a = 0; a < coupled_dets_size; ++a) {
-            const auto [J, _p, q, r] = coupled_dets[a];
-            auto p = std::abs(_p) - 1;
-            auto sign_pqr = _p < 0;
-
-            auto vJ1 = evecs_->get(J, root1_);
-            auto vJ2 = evecs_->get(J, root2_);
-
-            for (size_t b = a + 1; b < coupled_dets_size; ++b) {
-                const auto [I, _s, t, u] = coupled_dets[b];
-                auto s = std::abs(_s) - 1;
-                auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
-
-                auto value = vJ1 * evecs_->get(I, root2_) * sign;
 
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] += value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
-                tpdm3[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] += value;
-
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -= value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] += value;
-                tpdm3[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
-
-                value = evecs_->get(I, root1_) * vJ2 * sign;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -= value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] += value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] += value;
-
-                tpdm3[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
-                tpdm3[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] += value;
-                tpdm3[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+        // bbb bbb
+#pragma omp for schedule(dynamic)
+        for (size_t K = 0; K < op->bbb_list_.size(); ++K) {
+            const auto coupled_dets = op->bbb_list_[K];
+            auto coupled_dets_size = coupled_dets.size();
+
+            for (size_t a = 0; a < coupled_dets_size; ++a) {
+                const auto [J, _p, q, r] = coupled_dets[a];
+                auto p = std::abs(_p) - 1;
+                auto sign_pqr = _p < 0;
+
+                auto vJ1 = evecs_->get(J, root1_);
+                auto vJ2 = evecs_->get(J, root2_);
+
+                for (size_t b = a + 1; b < coupled_dets_size; ++b) {
+                    const auto [I, _s, t, u] = coupled_dets[b];
+                    auto s = std::abs(_s) - 1;
+                    auto sign = ((_s < 0) == sign_pqr) ? 1 : -1;
+
+                    auto value = vJ1 * evecs_->get(I, root2_) * sign;
+
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[p * norb5_ + q * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[p * norb5_ + r * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[q * norb5_ + p * norb4_ + r * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[q * norb5_ + r * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + t * norb_ + u] += value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + s * norb2_ + u * norb_ + t] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + t * norb_ + s] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + u * norb2_ + s * norb_ + t] += value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + s * norb_ + u] -= value;
+                    rdm[r * norb5_ + p * norb4_ + q * norb3_ + t * norb2_ + u * norb_ + s] += value;
+
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + t * norb_ + u] -= value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + s * norb2_ + u * norb_ + t] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + t * norb_ + s] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + u * norb2_ + s * norb_ + t] -= value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + s * norb_ + u] += value;
+                    rdm[r * norb5_ + q * norb4_ + p * norb3_ + t * norb2_ + u * norb_ + s] -= value;
+
+                    value = evecs_->get(I, root1_) * vJ2 * sign;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + q * norb_ + r] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + q * norb_ + r] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + q * norb_ + r] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + p * norb2_ + r * norb_ + q] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + p * norb2_ + r * norb_ + q] -= value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + p * norb_ + r] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + p * norb_ + r] -= value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + q * norb2_ + r * norb_ + p] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + q * norb2_ + r * norb_ + p] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + q * norb2_ + r * norb_ + p] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] += value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + p * norb_ + q] += value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + p * norb_ + q] -= value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + p * norb_ + q] += value;
+
+                    rdm[s * norb5_ + t * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[s * norb5_ + u * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[u * norb5_ + t * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[u * norb5_ + s * norb4_ + t * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                    rdm[t * norb5_ + s * norb4_ + u * norb3_ + r * norb2_ + q * norb_ + p] += value;
+                    rdm[t * norb5_ + u * norb4_ + s * norb3_ + r * norb2_ + q * norb_ + p] -= value;
+                }
             }
         }
-    }
+    };
+    accumulate_in_parallel({&tpdm3}, accumulate, rdm_num_threads(norb6_));
 
     auto t_build = build.stop();
     if (print_) {
@@ -29,13 +29,17 @@
 #include <numeric>
 
 #include "psi4/libpsi4util/process.h"
+#include "psi4/libpsio/psio.hpp"
 
 #include "integrals/active_space_integrals.h"
 #include "sparse_ci/ci_spin_adaptation.h"
+#include "sparse_ci/complementary_overlap.h"
 #include "helpers/davidson_liu_solver.h"
 
+#include "genci/ci_occupation.h"
 #include "fci_string_lists.h"
 #include "helpers/printing.h"
+#include "helpers/timer.h"
 #include "fci_string_address.h"
 #include "fci_vector.h"
 
@@ -82,6 +86,10 @@ void FCISolver::set_test_rdms(bool value) { test_rdms_ = value; }
 
 void FCISolver::set_print_no(bool value) { print_no_ = value; }
 
+void FCISolver::set_string_lists_cache_directory(const std::string& directory) {
+    string_lists_cache_directory_ = directory;
+}
+
 void FCISolver::copy_state_into_fci_vector(int root, std::shared_ptr<FCIVector> C) {
     // grab a row of the eigenvector matrix and put it into the FCIVector
     std::shared_ptr<psi::Vector> psi_vector;
@@ -101,6 +109,19 @@ std::shared_ptr<FCIStringLists> FCISolver::lists() { return lists_; }
 
 int FCISolver::symmetry() { return symmetry_; }
 
+size_t FCISolver::space_size() {
+    std::vector<int> mo_sym;
+    for (int h = 0; h < nirrep_; ++h) {
+        mo_sym.insert(mo_sym.end(), active_dim_[h], h);
+    }
+    const auto counts = count_strings_by_symmetry(mo_sym, nirrep_);
+    size_t ndets = 0;
+    for (int h = 0; h < nirrep_; ++h) {
+        ndets += counts[na_][h] * counts[nb_][h ^ symmetry_];
+    }
+    return ndets;
+}
+
 void FCISolver::startup() {
     // Create the string lists
 
@@ -122,7 +143,8 @@ void FCISolver::startup() {
     lists_ = std::make_shared<FCIStringLists>(mo_space_info_, na_, nb_, print_, gas_size, gas_min,
                                               gas_max);
 #else
-    lists_ = std::make_shared<FCIStringLists>(active_dim_, core_mo_, active_mo_, na_, nb_, print_);
+    lists_ = std::make_shared<FCIStringLists>(active_dim_, core_mo_, active_mo_, na_, nb_, print_,
+                                              string_lists_cache_directory_);
 #endif
 
     nfci_dets_ = 0;
@@ -159,6 +181,13 @@ void FCISolver::set_options(std::shared_ptr<ForteOptions> options) {
     set_spin_adapt(options->get_bool("CI_SPIN_ADAPT"));
     set_spin_adapt_full_preconditioner(options->get_bool("CI_SPIN_ADAPT_FULL_PRECONDITIONER"));
     set_test_rdms(options->get_bool("FCI_TEST_RDMS"));
+    if (options->get_bool("CI_STRING_LISTS_CACHE")) {
+        auto directory = options->get_str("CI_STRING_LISTS_CACHE_DIR");
+        if (directory.empty()) {
+            directory = psi::PSIOManager::shared_object()->get_default_path();
+        }
+        set_string_lists_cache_directory(directory);
+    }
 
     set_root(options->get_int("ROOT"));
 
@@ -177,6 +206,7 @@ void FCISolver::set_options(std::shared_ptr<ForteOptions> options) {
 double FCISolver::compute_energy() {
     local_timer t;
     startup();
+    complementary_overlap_.reset();
 
     FCIVector::allocate_temp_space(lists_, print_);
 
@@ -236,34 +266,57 @@ double FCISolver::compute_energy() {
         }
     }
 
-    // Print the initial guess
-    auto sigma_builder = [this, &b_basis, &b, &sigma, &sigma_basis](std::span<double> b_span,
-                                                                    std::span<double> sigma_span) {
-        // copy the b vector
-        size_t basis_size = b_span.size();
-        for (size_t I = 0; I < basis_size; ++I) {
-            b_basis->set(I, b_span[I]);
+    // The vectors used to compute a block of sigma vectors. C_ and T_ are the first elements
+    std::vector<std::shared_ptr<FCIVector>> C_block{C_};
+    std::vector<std::shared_ptr<FCIVector>> T_block{T_};
+
+    // Compute a block of sigma vectors with a single pass over the string lists
+    auto block_sigma_builder = [this, &C_block, &T_block, &b_basis, &b, &sigma, &sigma_basis](
+                                   std::span<double> b_span, std::span<double> sigma_span,
+                                   size_t nvec) {
+        while (C_block.size() < nvec) {
+            C_block.push_back(std::make_shared<FCIVector>(lists_, symmetry_));
+            T_block.push_back(std::make_shared<FCIVector>(lists_, symmetry_));
         }
-        if (spin_adapt_) {
-            // Compute sigma in the CSF basis and convert it to the determinant basis
-            spin_adapter_->csf_C_to_det_C(b_basis, b);
-            C_->copy(b);
-            C_->Hamiltonian(*T_, as_ints_);
-            T_->copy_to(sigma);
-            spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
-        } else {
-            // Compute sigma in the determinant basis
-            C_->copy(b_basis);
-            C_->Hamiltonian(*T_, as_ints_);
-            T_->copy_to(sigma_basis);
+        size_t basis_size = b_span.size() / nvec;
+
+        // copy the b vectors
+        for (size_t n = 0; n < nvec; ++n) {
+            for (size_t I = 0; I < basis_size; ++I) {
+                b_basis->set(I, b_span[n * basis_size + I]);
+            }
+            if (spin_adapt_) {
+                spin_adapter_->csf_C_to_det_C(b_basis, b);
+                C_block[n]->copy(b);
+            } else {
+                C_block[n]->copy(b_basis);
+            }
         }
-        for (size_t I = 0; I < basis_size; ++I) {
-            sigma_span[I] = sigma_basis->get(I);
+
+        std::vector<FCIVector*> C_ptrs(nvec);
+        std::vector<FCIVector*> T_ptrs(nvec);
+        for (size_t n = 0; n < nvec; ++n) {
+            C_ptrs[n] = C_block[n].get();
+            T_ptrs[n] = T_block[n].get();
+        }
+        FCIVector::Hamiltonian_block(C_ptrs, T_ptrs, as_ints_);
+
+        // copy the sigma vectors, optionally converting them to the CSF basis
+        for (size_t n = 0; n < nvec; ++n) {
+            if (spin_adapt_) {
+                T_block[n]->copy_to(sigma);
+                spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
+            } else {
+                T_block[n]->copy_to(sigma_basis);
+            }
+            for (size_t I = 0; I < basis_size; ++I) {
+                sigma_span[n * basis_size + I] = sigma_basis->get(I);
+            }
         }
     };
 
     // Run the Davidson-Liu solver
-    dl_solver_->add_sigma_builder(sigma_builder);
+    dl_solver_->add_block_sigma_builder(block_sigma_builder);
 
     auto converged = dl_solver_->solve();
     if (not converged) {
@@ -304,8 +357,15 @@ double FCISolver::compute_energy() {
     }
 
     energy_ = dl_solver_->eigenvalues()->get(root_);
-    psi::Process::environment.globals["CURRENT ENERGY"] = energy_;
-    psi::Process::environment.globals["FCI ENERGY"] = energy_;
+    // solvers of different states may run concurrently (see ActiveSpaceSolver)
+#pragma omp critical(psi4_globals)
+    {
+        psi::Process::environment.globals["CURRENT ENERGY"] = energy_;
+        psi::Process::environment.globals["FCI ENERGY"] = energy_;
+    }
+
+    // free the scratch of the threads used by the sigma build
+    FCIVector::release_thread_temp_space();
 
     if (print_ >= PrintLevel::Default) {
         psi::outfile->Printf("\n    Time for FCI: %20.12f", t.get());
@@ -384,6 +444,28 @@ void FCISolver::test_rdms(std::shared_ptr<psi::Vector> b, std::shared_ptr<psi::V
     C_->test_rdms(*C_, *C_, max_rdm_level, RDMsType::spin_dependent, rdms);
 }
 
+std::vector<double> FCISolver::compute_complementary_H2caa_overlap(const std::vector<size_t>& roots,
+                                                                   ambit::Tensor Tbra,
+                                                                   ambit::Tensor Tket) {
+    timer t("FCI complementary overlap");
+    // the couplings are built once for the determinant space and reused by later calls
+    if (complementary_overlap_ == nullptr) {
+        complementary_overlap_ = std::make_shared<ComplementaryOverlap>(
+            lists_->ncmo(), lists_->make_determinants(symmetry_),
+            psi::Process::environment.get_memory() / 4);
+    }
+    auto C = std::make_shared<FCIVector>(lists_, symmetry_);
+    const size_t ndets = C->size();
+    auto vec = std::make_shared<psi::Vector>(ndets);
+    std::vector<std::vector<double>> evecs;
+    for (size_t root : roots) {
+        copy_state_into_fci_vector(root, C);
+        C->copy_to(vec);
+        evecs.emplace_back(vec->pointer(), vec->pointer() + ndets);
+    }
+    return complementary_overlap_->compute(evecs, Tbra.dim(0), Tbra.data(), Tket.data());
+}
+
 std::shared_ptr<psi::Matrix> FCISolver::ci_wave_functions() {
     if (eigen_vecs_ == nullptr)
         return std::make_shared<psi::Matrix>();
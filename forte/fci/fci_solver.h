@@ -34,6 +34,7 @@
 #include "fci_string_address.h"
 
 namespace forte {
+class ComplementaryOverlap;
 class FCIVector;
 class SpinAdapter;
 class DavidsonLiuSolver;
@@ -70,10 +71,18 @@ class FCISolver : public ActiveSpaceMethod {
     /// Compute the FCI energy
     double compute_energy() override;
 
+    /// Returns the number of determinants. This does not require the string lists
+    size_t space_size() override;
+
     /// Returns the reduced density matrices up to a given rank (max_rdm_level)
     std::vector<std::shared_ptr<RDMs>> rdms(const std::vector<std::pair<size_t, size_t>>& root_list,
                                             int max_rdm_level, RDMsType type) override;
 
+    /// Returns the weighted average of the RDMs of the roots. The contributions of all the roots
+    /// are accumulated in a single pass over the string lists
+    std::shared_ptr<RDMs> average_rdms(const std::vector<double>& weights, int max_rdm_level,
+                                       RDMsType type) override;
+
     /// Returns the transition reduced density matrices between roots of different symmetry up to a
     /// given level (max_rdm_level)
     std::vector<std::shared_ptr<RDMs>>
@@ -112,12 +121,21 @@ class FCISolver : public ActiveSpaceMethod {
     /// Print the Natural Orbitals
     void set_print_no(bool value);
 
+    /// Cache the string lists in a directory (an empty string disables the cache)
+    void set_string_lists_cache_directory(const std::string& directory);
+
     /// Return eigen vectors (n_DL_guesses x ndets)
     std::shared_ptr<psi::Matrix> evecs();
 
     /// Return the CI wave functions for current state symmetry (ndets x nroots)
     std::shared_ptr<psi::Matrix> ci_wave_functions() override;
 
+    /// Compute the overlap of two wave functions acted by complementary operators (see
+    /// ActiveSpaceMethod) without forming the 3-RDM
+    std::vector<double> compute_complementary_H2caa_overlap(const std::vector<size_t>& roots,
+                                                            ambit::Tensor Tbra,
+                                                            ambit::Tensor Tket) override;
+
     /// Return string lists
     std::shared_ptr<FCIStringLists> lists();
 
@@ -179,6 +197,10 @@ class FCISolver : public ActiveSpaceMethod {
     bool test_rdms_ = false;
     /// Print the NO from the 1-RDM
     bool print_no_ = false;
+    /// The directory where the string lists are cached (empty if caching is disabled)
+    std::string string_lists_cache_directory_;
+    /// The couplings used to compute the complementary overlaps (built on the first call)
+    std::shared_ptr<ComplementaryOverlap> complementary_overlap_;
     /// Spin adapt the FCI wave function?
     bool spin_adapt_ = false;
     /// Use the full preconditioner for spin adaptation?
@@ -232,17 +254,21 @@ class FCISolver : public ActiveSpaceMethod {
                          std::shared_ptr<psi::Vector> b_basis,
                          std::shared_ptr<DavidsonLiuSolver> dls);
 
-    /// @brief Compute the RDMs for a given root
-    /// @param root_left the left root
-    /// @param root_right the right root
-    /// @param max_rdm_level the maximum level of the RDMs to compute
-    std::shared_ptr<RDMs> compute_rdms_root(size_t root_left, size_t root_right, int max_rdm_level,
-                                            RDMsType type);
+    /// @brief Check that the roots of an RDM computation are valid (throws otherwise)
+    void check_rdms_roots(size_t root_left, size_t root_right) const;
+
+    /// @brief Copy the given roots into new FCIVector objects
+    std::vector<std::shared_ptr<FCIVector>> root_vectors(const std::vector<size_t>& roots);
 
     std::shared_ptr<RDMs> compute_transition_rdms_root(size_t root_left, size_t root_right,
                                                        std::shared_ptr<ActiveSpaceMethod> method2,
                                                        int max_rdm_level, RDMsType type);
 
+    /// @brief Test the batched state-averaged RDMs element by element against the weighted sum
+    /// of the RDMs computed one root at a time
+    void test_average_rdms(const std::vector<double>& weights, int max_rdm_level, RDMsType type,
+                           std::shared_ptr<RDMs> rdms);
+
     /// @brief Test the RDMs
     void test_rdms(std::shared_ptr<psi::Vector> b, std::shared_ptr<psi::Vector> b_basis,
                    std::shared_ptr<DavidsonLiuSolver> dls);
@@ -26,6 +26,12 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <cmath>
+
+#include "psi4/libpsi4util/PsiOutStream.h"
+#include "psi4/libpsi4util/process.h"
+
 #include "helpers/printing.h"
 
 #include "sparse_ci/determinant.h"
@@ -37,6 +43,19 @@
 
 namespace forte {
 
+namespace {
+/// @return the largest absolute difference between the elements of two tensors
+double max_abs_difference(const ambit::Tensor& a, const ambit::Tensor& b) {
+    const auto& a_data = a.data();
+    const auto& b_data = b.data();
+    double error = 0.0;
+    for (size_t i = 0, n = a_data.size(); i < n; ++i) {
+        error = std::max(error, std::fabs(a_data[i] - b_data[i]));
+    }
+    return error;
+}
+} // namespace
+
 std::vector<std::shared_ptr<RDMs>>
 FCISolver::rdms(const std::vector<std::pair<size_t, size_t>>& root_list, int max_rdm_level,
                 RDMsType rdm_type) {
@@ -55,52 +74,152 @@ FCISolver::rdms(const std::vector<std::pair<size_t, size_t>>& root_list, int max
         }
     }
 
-    std::vector<std::shared_ptr<RDMs>> refs;
-    // loop over all the pairs of states
-    for (const auto& [root1, root2] : root_list) {
-        refs.push_back(compute_rdms_root(root1, root2, max_rdm_level, rdm_type));
+    // store each root in a vector only once and compute all the RDMs in one pass
+    std::vector<size_t> roots;
+    std::vector<FCIRDMTerm> terms;
+    auto vector_index = [&](size_t root) {
+        auto it = std::find(roots.begin(), roots.end(), root);
+        if (it != roots.end())
+            return static_cast<size_t>(it - roots.begin());
+        roots.push_back(root);
+        return roots.size() - 1;
+    };
+    for (const auto& [root_left, root_right] : root_list) {
+        check_rdms_roots(root_left, root_right);
+        if (print_ >= PrintLevel::Verbose) {
+            std::string title_rdm = "Computing RDMs <" + std::to_string(root_left) + " " +
+                                    state().str_minimum() + "| ... |" +
+                                    std::to_string(root_right) + " " + state().str_minimum() + ">";
+            print_h2(title_rdm);
+        }
+        const size_t left = vector_index(root_left);
+        const size_t right = vector_index(root_right);
+        terms.push_back({left, right, 1.0, terms.size()});
     }
-    return refs;
-}
 
-std::shared_ptr<RDMs> FCISolver::compute_rdms_root(size_t root_left, size_t root_right,
-                                                   int max_rdm_level, RDMsType type) {
-    // make sure the root is valid
-    if (std::max(root_left, root_right) >= nroot_) {
-        std::string error = "Cannot compute RDMs <" + std::to_string(root_left) + "| ... |" +
-                            std::to_string(root_right) +
-                            "> (0-based) because nroot = " + std::to_string(nroot_);
-        throw std::runtime_error(error);
+    auto C = root_vectors(roots);
+    std::vector<FCIVector*> C_ptrs;
+    for (auto& c : C) {
+        C_ptrs.push_back(c.get());
     }
+    auto refs =
+        FCIVector::compute_rdms_block(C_ptrs, terms, root_list.size(), max_rdm_level, rdm_type);
 
-    // here we will use C_ for the left wave function and T_ for the right wave function
+    for (size_t n = 0; n < refs.size(); ++n) {
+        auto& C_left = *C[terms[n].left];
+        // Optionally, test the RDMs
+        if (test_rdms_) {
+            FCIVector::test_rdms(C_left, *C[terms[n].right], max_rdm_level, rdm_type, refs[n]);
+        }
 
-    copy_state_into_fci_vector(root_left, C_);
-    if (root_left != root_right) {
-        copy_state_into_fci_vector(root_right, T_);
-    } else {
-        T_->copy(*C_);
+        // Print the NO if energy converged
+        if (print_no_ || print_ >= PrintLevel::Default) {
+            C_left.print_natural_orbitals(mo_space_info_, refs[n]);
+        }
+    }
+    return refs;
+}
+
+std::shared_ptr<RDMs> FCISolver::average_rdms(const std::vector<double>& weights,
+                                              int max_rdm_level, RDMsType type) {
+    if (max_rdm_level <= 0) {
+        return ActiveSpaceMethod::average_rdms(weights, max_rdm_level, type);
+    }
+    if (not C_) {
+        throw std::runtime_error("FCIVector is not assigned. Cannot compute RDMs.");
     }
 
-    if (print_ >= PrintLevel::Verbose) {
-        std::string title_rdm = "Computing RDMs <" + std::to_string(root_left) + " " +
-                                state().str_minimum() + "| ... |" + std::to_string(root_right) +
-                                " " + state().str_minimum() + ">";
-        print_h2(title_rdm);
+    // the weighted RDMs of all the roots are accumulated directly in one RDMs object
+    std::vector<size_t> roots;
+    std::vector<FCIRDMTerm> terms;
+    for (size_t r = 0; r < weights.size(); ++r) {
+        // Don't bother if the weight is zero
+        if (weights[r] <= 1e-15)
+            continue;
+        check_rdms_roots(r, r);
+        terms.push_back({roots.size(), roots.size(), weights[r], 0});
+        roots.push_back(r);
+    }
+    if (roots.empty()) {
+        return RDMs::build(max_rdm_level, lists_->ncmo(), type);
     }
 
-    auto rdms = FCIVector::compute_rdms(*C_, *T_, max_rdm_level, type);
+    auto C = root_vectors(roots);
+    std::vector<FCIVector*> C_ptrs;
+    for (auto& c : C) {
+        C_ptrs.push_back(c.get());
+    }
+    auto rdms = FCIVector::compute_rdms_block(C_ptrs, terms, 1, max_rdm_level, type)[0];
 
-    // Optionally, test the RDMs
+    // Optionally, test the batched RDMs against the average of the RDMs of each root
     if (test_rdms_) {
-        C_->test_rdms(*C_, *T_, max_rdm_level, type, rdms);
+        test_average_rdms(weights, max_rdm_level, type, rdms);
     }
 
-    // Print the NO if energy converged
     if (print_no_ || print_ >= PrintLevel::Default) {
-        C_->print_natural_orbitals(mo_space_info_, rdms);
+        C[0]->print_natural_orbitals(mo_space_info_, rdms);
     }
     return rdms;
 }
 
+void FCISolver::test_average_rdms(const std::vector<double>& weights, int max_rdm_level,
+                                  RDMsType type, std::shared_ptr<RDMs> rdms) {
+    // the reference computes the RDMs one root at a time (and tests them against determinants)
+    auto ref = ActiveSpaceMethod::average_rdms(weights, max_rdm_level, type);
+
+    std::vector<std::pair<std::string, double>> errors;
+    if (type == RDMsType::spin_dependent) {
+        errors.emplace_back("AA 1-RDM", max_abs_difference(ref->g1a(), rdms->g1a()));
+        errors.emplace_back("BB 1-RDM", max_abs_difference(ref->g1b(), rdms->g1b()));
+        if (max_rdm_level >= 2) {
+            errors.emplace_back("AAAA 2-RDM", max_abs_difference(ref->g2aa(), rdms->g2aa()));
+            errors.emplace_back("ABAB 2-RDM", max_abs_difference(ref->g2ab(), rdms->g2ab()));
+            errors.emplace_back("BBBB 2-RDM", max_abs_difference(ref->g2bb(), rdms->g2bb()));
+        }
+        if (max_rdm_level >= 3) {
+            errors.emplace_back("AAAAAA 3-RDM", max_abs_difference(ref->g3aaa(), rdms->g3aaa()));
+            errors.emplace_back("AABAAB 3-RDM", max_abs_difference(ref->g3aab(), rdms->g3aab()));
+            errors.emplace_back("ABBABB 3-RDM", max_abs_difference(ref->g3abb(), rdms->g3abb()));
+            errors.emplace_back("BBBBBB 3-RDM", max_abs_difference(ref->g3bbb(), rdms->g3bbb()));
+        }
+    } else {
+        errors.emplace_back("SF 1-RDM", max_abs_difference(ref->SF_G1(), rdms->SF_G1()));
+        if (max_rdm_level >= 2) {
+            errors.emplace_back("SF 2-RDM", max_abs_difference(ref->SF_G2(), rdms->SF_G2()));
+        }
+        if (max_rdm_level >= 3) {
+            errors.emplace_back("SF 3-RDM", max_abs_difference(ref->SF_G3(), rdms->SF_G3()));
+        }
+    }
+
+    psi::outfile->Printf("\n\n==> Batched State-Averaged RDMs Test <==\n");
+    double max_error = 0.0;
+    for (const auto& [label, error] : errors) {
+        psi::outfile->Printf("\n    %-12s Max Error : %+e", label.c_str(), error);
+        max_error = std::max(max_error, error);
+    }
+    psi::outfile->Printf("\n");
+    psi::Process::environment.globals["AVERAGE RDMS MAX ERROR"] = max_error;
+}
+
+void FCISolver::check_rdms_roots(size_t root_left, size_t root_right) const {
+    // make sure the root is valid
+    if (std::max(root_left, root_right) >= nroot_) {
+        std::string error = "Cannot compute RDMs <" + std::to_string(root_left) + "| ... |" +
+                            std::to_string(root_right) +
+                            "> (0-based) because nroot = " + std::to_string(nroot_);
+        throw std::runtime_error(error);
+    }
+}
+
+std::vector<std::shared_ptr<FCIVector>> FCISolver::root_vectors(const std::vector<size_t>& roots) {
+    std::vector<std::shared_ptr<FCIVector>> C;
+    for (auto root : roots) {
+        C.push_back(std::make_shared<FCIVector>(lists_, symmetry_));
+        C.back()->set_print(print_);
+        copy_state_into_fci_vector(root, C.back());
+    }
+    return C;
+}
+
 } // namespace forte
@@ -44,16 +44,16 @@
 
 namespace forte {
 
-std::vector<H1StringSubstitution>& FCIStringLists::get_alfa_1h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H1StringSubstitution>& FCIStringLists::get_alfa_1h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return alfa_1h_list[I_tuple];
+    return find_string_list(alfa_1h_list, I_tuple);
 }
 
-std::vector<H1StringSubstitution>& FCIStringLists::get_beta_1h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H1StringSubstitution>& FCIStringLists::get_beta_1h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return beta_1h_list[I_tuple];
+    return find_string_list(beta_1h_list, I_tuple);
 }
 
 void FCIStringLists::make_1h_list(std::shared_ptr<FCIStringAddress> addresser,
@@ -91,16 +91,16 @@ void FCIStringLists::make_1h_list(std::shared_ptr<FCIStringAddress> addresser,
     } // End loop over h
 }
 
-std::vector<H2StringSubstitution>& FCIStringLists::get_alfa_2h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H2StringSubstitution>& FCIStringLists::get_alfa_2h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return alfa_2h_list[I_tuple];
+    return find_string_list(alfa_2h_list, I_tuple);
 }
 
-std::vector<H2StringSubstitution>& FCIStringLists::get_beta_2h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H2StringSubstitution>& FCIStringLists::get_beta_2h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return beta_2h_list[I_tuple];
+    return find_string_list(beta_2h_list, I_tuple);
 }
 
 void FCIStringLists::make_2h_list(std::shared_ptr<FCIStringAddress> addresser,
@@ -146,16 +146,16 @@ void FCIStringLists::make_2h_list(std::shared_ptr<FCIStringAddress> addresser,
     } // End loop over h
 }
 
-std::vector<H3StringSubstitution>& FCIStringLists::get_alfa_3h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H3StringSubstitution>& FCIStringLists::get_alfa_3h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return alfa_3h_list[I_tuple];
+    return find_string_list(alfa_3h_list, I_tuple);
 }
 
-std::vector<H3StringSubstitution>& FCIStringLists::get_beta_3h_list(int h_I, size_t add_I,
-                                                                    int h_J) {
+const std::vector<H3StringSubstitution>& FCIStringLists::get_beta_3h_list(int h_I, size_t add_I,
+                                                                          int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return beta_3h_list[I_tuple];
+    return find_string_list(beta_3h_list, I_tuple);
 }
 
 /**
@@ -28,6 +28,8 @@
 
 #include <algorithm>
 #include <numeric>
+#include <stdexcept>
+#include <string>
 
 #include "psi4/psi4-dec.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
@@ -35,6 +37,7 @@
 #include "helpers/printing.h"
 
 #include "fci_string_address.h"
+#include "string_lists_io.h"
 
 #include "fci_string_lists.h"
 
@@ -44,9 +47,9 @@ namespace forte {
 
 FCIStringLists::FCIStringLists(psi::Dimension cmopi, std::vector<size_t> core_mo,
                                std::vector<size_t> cmo_to_mo, size_t na, size_t nb,
-                               PrintLevel print)
+                               PrintLevel print, const std::string& cache_directory)
     : nirrep_(cmopi.n()), ncmo_(cmopi.sum()), cmopi_(cmopi), cmo_to_mo_(cmo_to_mo),
-      fomo_to_mo_(core_mo), na_(na), nb_(nb), print_(print) {
+      fomo_to_mo_(core_mo), na_(na), nb_(nb), print_(print), cache_directory_(cache_directory) {
     startup();
 }
 
@@ -142,45 +145,64 @@ void FCIStringLists::startup() {
         make_pair_list(pair_list_);
         nn_list_timer += t.get();
     }
-    {
-        local_timer t;
-        make_vo_list(alfa_address_, alfa_vo_list);
-        make_vo_list(beta_address_, beta_vo_list);
-        vo_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        make_oo_list(alfa_address_, alfa_oo_list);
-        make_oo_list(beta_address_, beta_oo_list);
-        oo_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        make_1h_list(alfa_address_, alfa_address_1h_, alfa_1h_list);
-        make_1h_list(beta_address_, beta_address_1h_, beta_1h_list);
-        h1_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        make_2h_list(alfa_address_, alfa_address_2h_, alfa_2h_list);
-        make_2h_list(beta_address_, beta_address_2h_, beta_2h_list);
-        h2_list_timer += t.get();
-    }
-    {
+
+    // read the lists from the cache if possible, otherwise build them
+    std::string cache_file;
+    bool lists_read = false;
+    double cache_timer = 0.0;
+    if (not cache_directory_.empty()) {
         local_timer t;
-        make_3h_list(alfa_address_, alfa_address_3h_, alfa_3h_list);
-        make_3h_list(beta_address_, beta_address_3h_, beta_3h_list);
-        h3_list_timer += t.get();
+        cache_file = string_lists_filename(cache_directory_, signature());
+        lists_read = read_lists(cache_file);
+        cache_timer += t.get();
     }
-    {
-        local_timer t;
-        make_vvoo_list(alfa_address_, alfa_vvoo_list);
-        make_vvoo_list(beta_address_, beta_vvoo_list);
-        vvoo_list_timer += t.get();
+
+    if (not lists_read) {
+        {
+            local_timer t;
+            make_vo_list(alfa_address_, alfa_vo_list);
+            make_vo_list(beta_address_, beta_vo_list);
+            vo_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            make_oo_list(alfa_address_, alfa_oo_list);
+            make_oo_list(beta_address_, beta_oo_list);
+            oo_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            make_1h_list(alfa_address_, alfa_address_1h_, alfa_1h_list);
+            make_1h_list(beta_address_, beta_address_1h_, beta_1h_list);
+            h1_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            make_2h_list(alfa_address_, alfa_address_2h_, alfa_2h_list);
+            make_2h_list(beta_address_, beta_address_2h_, beta_2h_list);
+            h2_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            make_3h_list(alfa_address_, alfa_address_3h_, alfa_3h_list);
+            make_3h_list(beta_address_, beta_address_3h_, beta_3h_list);
+            h3_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            make_vvoo_list(alfa_address_, alfa_vvoo_list);
+            make_vvoo_list(beta_address_, beta_vvoo_list);
+            vvoo_list_timer += t.get();
+        }
+        if (not cache_file.empty()) {
+            local_timer t;
+            write_lists(cache_file);
+            cache_timer += t.get();
+        }
     }
 
     double total_time = str_list_timer + nn_list_timer + vo_list_timer + oo_list_timer +
-                        vvoo_list_timer + vovo_list_timer;
+                        vvoo_list_timer + vovo_list_timer + cache_timer;
 
     if (print_ >= PrintLevel::Default) {
         table_printer printer;
@@ -205,6 +227,40 @@ void FCIStringLists::startup() {
     }
 }
 
+std::string FCIStringLists::signature() const {
+    std::string s = "FCIStringLists na=" + std::to_string(na_) + " nb=" + std::to_string(nb_) +
+                    " nbits=" + std::to_string(String::nbits) + " cmopi=";
+    for (size_t h = 0; h < nirrep_; ++h) {
+        s += std::to_string(cmopi_[h]) + ",";
+    }
+    return s;
+}
+
+bool FCIStringLists::read_lists(const std::string& filename) {
+    try {
+        return read_string_lists(filename, signature(), alfa_vo_list, beta_vo_list, alfa_oo_list,
+                                 beta_oo_list, alfa_vvoo_list, beta_vvoo_list, alfa_1h_list,
+                                 beta_1h_list, alfa_2h_list, beta_2h_list, alfa_3h_list,
+                                 beta_3h_list);
+    } catch (const std::runtime_error& e) {
+        // a damaged file is not fatal, the lists are rebuilt and the file is overwritten
+        outfile->Printf("\n  Warning: %s (%s). The string lists will be rebuilt.\n", e.what(),
+                        filename.c_str());
+        return false;
+    }
+}
+
+void FCIStringLists::write_lists(const std::string& filename) const {
+    try {
+        write_string_lists(filename, signature(), alfa_vo_list, beta_vo_list, alfa_oo_list,
+                           beta_oo_list, alfa_vvoo_list, beta_vvoo_list, alfa_1h_list,
+                           beta_1h_list, alfa_2h_list, beta_2h_list, alfa_3h_list, beta_3h_list);
+    } catch (const std::runtime_error& e) {
+        // the cache is only an optimization, so failing to write it is not fatal
+        outfile->Printf("\n  Warning: %s. The string lists will not be cached.\n", e.what());
+    }
+}
+
 /**
  * Generate all the pairs p > q with pq in pq_sym
  * these are stored as pair<int,int> in pair_list[pq_sym][pairpi]
@@ -32,6 +32,7 @@
 
 #include <map>
 #include <vector>
+#include <string>
 #include <utility>
 
 #include "helpers/timer.h"
@@ -60,8 +61,10 @@ class FCIStringLists {
     /// @param na number of alpha electrons
     /// @param nb number of beta electrons
     /// @param print print level
+    /// @param cache_directory if not empty, the string lists are read from a file in this directory
+    ///        when one was saved for the same active space, otherwise they are built and saved
     FCIStringLists(psi::Dimension cmopi, std::vector<size_t> core_mo, std::vector<size_t> cmo_to_mo,
-                   size_t na, size_t nb, PrintLevel print);
+                   size_t na, size_t nb, PrintLevel print, const std::string& cache_directory = "");
 
     ~FCIStringLists() {}
 
@@ -128,25 +131,31 @@ class FCIStringLists {
     /// @return the list of determinants with a given symmetry
     std::vector<Determinant> make_determinants(int symmetry) const;
 
-    std::vector<StringSubstitution>& get_alfa_vo_list(size_t p, size_t q, int h);
-    std::vector<StringSubstitution>& get_beta_vo_list(size_t p, size_t q, int h);
+    const std::vector<StringSubstitution>& get_alfa_vo_list(size_t p, size_t q, int h) const;
+    const std::vector<StringSubstitution>& get_beta_vo_list(size_t p, size_t q, int h) const;
 
-    std::vector<H1StringSubstitution>& get_alfa_1h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H1StringSubstitution>& get_beta_1h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H1StringSubstitution>& get_alfa_1h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
+    const std::vector<H1StringSubstitution>& get_beta_1h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
 
-    std::vector<H2StringSubstitution>& get_alfa_2h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H2StringSubstitution>& get_beta_2h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H2StringSubstitution>& get_alfa_2h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
+    const std::vector<H2StringSubstitution>& get_beta_2h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
 
-    std::vector<H3StringSubstitution>& get_alfa_3h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H3StringSubstitution>& get_beta_3h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H3StringSubstitution>& get_alfa_3h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
+    const std::vector<H3StringSubstitution>& get_beta_3h_list(int h_I, size_t add_I,
+                                                              int h_J) const;
 
-    std::vector<StringSubstitution>& get_alfa_oo_list(int pq_sym, size_t pq, int h);
-    std::vector<StringSubstitution>& get_beta_oo_list(int pq_sym, size_t pq, int h);
+    const std::vector<StringSubstitution>& get_alfa_oo_list(int pq_sym, size_t pq, int h) const;
+    const std::vector<StringSubstitution>& get_beta_oo_list(int pq_sym, size_t pq, int h) const;
 
-    std::vector<StringSubstitution>& get_alfa_vvoo_list(size_t p, size_t q, size_t r, size_t s,
-                                                        int h);
-    std::vector<StringSubstitution>& get_beta_vvoo_list(size_t p, size_t q, size_t r, size_t s,
-                                                        int h);
+    const std::vector<StringSubstitution>& get_alfa_vvoo_list(size_t p, size_t q, size_t r,
+                                                              size_t s, int h) const;
+    const std::vector<StringSubstitution>& get_beta_vvoo_list(size_t p, size_t q, size_t r,
+                                                              size_t s, int h) const;
 
     Pair get_pair_list(int h, int n) const { return pair_list_[h][n]; }
 
@@ -181,6 +190,8 @@ class FCIStringLists {
     std::vector<int> pair_offset_;
     /// The print level
     PrintLevel print_ = PrintLevel::Default;
+    /// The directory where the string lists are cached (empty if caching is disabled)
+    std::string cache_directory_;
 
     // String lists
     std::shared_ptr<FCIStringClass> string_class_;
@@ -232,6 +243,16 @@ class FCIStringLists {
     /// Startup the class
     void startup();
 
+    /// @return a string that identifies the active space for which the lists are built
+    std::string signature() const;
+
+    /// Read the lists from a file
+    /// @return true if the file exists and was written for the same active space
+    bool read_lists(const std::string& filename);
+
+    /// Write the lists to a file
+    void write_lists(const std::string& filename) const;
+
     /// Make strings of for norb bits with ne of these set to 1 and (norb - ne) set to 0
     /// @return strings sorted according to their irrep
     StringList make_fci_strings(const int norb, const int ne);
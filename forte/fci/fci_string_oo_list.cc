@@ -40,9 +40,10 @@ namespace forte {
  * @param pq     relative PAIRINDEX of the pq pair
  * @param h      symmetry of the I strings in the list
  */
-std::vector<StringSubstitution>& FCIStringLists::get_alfa_oo_list(int pq_sym, size_t pq, int h) {
+const std::vector<StringSubstitution>& FCIStringLists::get_alfa_oo_list(int pq_sym, size_t pq,
+                                                                        int h) const {
     std::tuple<int, size_t, int> pq_pair(pq_sym, pq, h);
-    return alfa_oo_list[pq_pair];
+    return find_string_list(alfa_oo_list, pq_pair);
 }
 
 /**
@@ -51,9 +52,10 @@ std::vector<StringSubstitution>& FCIStringLists::get_alfa_oo_list(int pq_sym, si
  * @param pq     relative PAIRINDEX of the pq pair
  * @param h      symmetry of the I strings in the list
  */
-std::vector<StringSubstitution>& FCIStringLists::get_beta_oo_list(int pq_sym, size_t pq, int h) {
+const std::vector<StringSubstitution>& FCIStringLists::get_beta_oo_list(int pq_sym, size_t pq,
+                                                                        int h) const {
     std::tuple<int, size_t, int> pq_pair(pq_sym, pq, h);
-    return beta_oo_list[pq_pair];
+    return find_string_list(beta_oo_list, pq_pair);
 }
 
 void FCIStringLists::make_oo_list(std::shared_ptr<FCIStringAddress> addresser, OOList& list) {
@@ -51,8 +51,9 @@ namespace forte {
  * that is: J = ± a^{+}_p a_q I. p and q are absolute indices and I belongs to
  * the irrep h.
  */
-std::vector<StringSubstitution>& FCIStringLists::get_alfa_vo_list(size_t p, size_t q, int h) {
-    return alfa_vo_list[std::make_tuple(p, q, h)];
+const std::vector<StringSubstitution>& FCIStringLists::get_alfa_vo_list(size_t p, size_t q,
+                                                                        int h) const {
+    return find_string_list(alfa_vo_list, std::make_tuple(p, q, h));
 }
 
 /**
@@ -61,8 +62,9 @@ std::vector<StringSubstitution>& FCIStringLists::get_alfa_vo_list(size_t p, size
  * that is: J = ± a^{+}_p a_q I. p and q are absolute indices and I belongs to
  * the irrep h.
  */
-std::vector<StringSubstitution>& FCIStringLists::get_beta_vo_list(size_t p, size_t q, int h) {
-    return beta_vo_list[std::make_tuple(p, q, h)];
+const std::vector<StringSubstitution>& FCIStringLists::get_beta_vo_list(size_t p, size_t q,
+                                                                        int h) const {
+    return find_string_list(beta_vo_list, std::make_tuple(p, q, h));
 }
 
 void FCIStringLists::make_vo_list(std::shared_ptr<FCIStringAddress> addresser, VOList& list) {
@@ -39,18 +39,20 @@ namespace forte {
 
 /**
  */
-std::vector<StringSubstitution>& FCIStringLists::get_alfa_vvoo_list(size_t p, size_t q, size_t r,
-                                                                    size_t s, int h) {
+const std::vector<StringSubstitution>& FCIStringLists::get_alfa_vvoo_list(size_t p, size_t q,
+                                                                          size_t r, size_t s,
+                                                                          int h) const {
     std::tuple<size_t, size_t, size_t, size_t, int> pqrs_pair(p, q, r, s, h);
-    return alfa_vvoo_list[pqrs_pair];
+    return find_string_list(alfa_vvoo_list, pqrs_pair);
 }
 
 /**
  */
-std::vector<StringSubstitution>& FCIStringLists::get_beta_vvoo_list(size_t p, size_t q, size_t r,
-                                                                    size_t s, int h) {
+const std::vector<StringSubstitution>& FCIStringLists::get_beta_vvoo_list(size_t p, size_t q,
+                                                                          size_t r, size_t s,
+                                                                          int h) const {
     std::tuple<size_t, size_t, size_t, size_t, int> pqrs_pair(p, q, r, s, h);
-    return beta_vvoo_list[pqrs_pair];
+    return find_string_list(beta_vvoo_list, pqrs_pair);
 }
 
 void FCIStringLists::make_vvoo_list(std::shared_ptr<FCIStringAddress> addresser, VVOOList& list) {
@@ -29,6 +29,8 @@
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/molecule.h"
+
+#include "forte-def.h"
 #include "helpers/helpers.h"
 #include "helpers/printing.h"
 
@@ -41,15 +43,17 @@ using namespace psi;
 
 namespace forte {
 
-std::shared_ptr<psi::Matrix> FCIVector::CR;
-std::shared_ptr<psi::Matrix> FCIVector::CL;
+thread_local std::shared_ptr<psi::Matrix> FCIVector::CR;
+thread_local std::shared_ptr<psi::Matrix> FCIVector::CL;
+thread_local std::vector<double> FCIVector::CR_thread;
+thread_local std::vector<double> FCIVector::CL_thread;
 
-double FCIVector::hdiag_timer = 0.0;
-double FCIVector::h1_aa_timer = 0.0;
-double FCIVector::h1_bb_timer = 0.0;
-double FCIVector::h2_aaaa_timer = 0.0;
-double FCIVector::h2_aabb_timer = 0.0;
-double FCIVector::h2_bbbb_timer = 0.0;
+thread_local double FCIVector::hdiag_timer = 0.0;
+thread_local double FCIVector::h1_aa_timer = 0.0;
+thread_local double FCIVector::h1_bb_timer = 0.0;
+thread_local double FCIVector::h2_aaaa_timer = 0.0;
+thread_local double FCIVector::h2_aabb_timer = 0.0;
+thread_local double FCIVector::h2_bbbb_timer = 0.0;
 
 void FCIVector::allocate_temp_space(std::shared_ptr<FCIStringLists> lists_, PrintLevel print_) {
     size_t nirreps = lists_->nirrep();
@@ -78,7 +82,35 @@ void FCIVector::allocate_temp_space(std::shared_ptr<FCIStringLists> lists_, Prin
     }
 }
 
-void FCIVector::release_temp_space() {}
+FCIVector::BlockTempSpace::BlockTempSpace(size_t nvec, bool widen_right) {
+    if (nvec < 2)
+        return;
+    CR_ = CR;
+    CL_ = CL;
+    size_t max_size = CR->rowdim();
+    if (widen_right)
+        CR = std::make_shared<psi::Matrix>("CR", max_size, nvec * max_size);
+    CL = std::make_shared<psi::Matrix>("CL", max_size, nvec * max_size);
+}
+
+FCIVector::BlockTempSpace::~BlockTempSpace() {
+    if (CR_) {
+        CR = CR_;
+        CL = CL_;
+    }
+}
+
+void FCIVector::release_temp_space() { release_thread_temp_space(); }
+
+void FCIVector::release_thread_temp_space() {
+    // the buffers of the threads are released by the threads that own them. The team has the same
+    // size as the one of the sigma build, so it runs on all the pooled threads that used them
+#pragma omp parallel num_threads(omp_get_max_threads())
+    {
+        std::vector<double>().swap(CR_thread);
+        std::vector<double>().swap(CL_thread);
+    }
+}
 
 std::shared_ptr<psi::Matrix> FCIVector::get_CR() { return CR; }
 std::shared_ptr<psi::Matrix> FCIVector::get_CL() { return CL; }
@@ -250,12 +282,14 @@ double** gather_C_block(FCIVector& C, std::shared_ptr<psi::Matrix> M, bool alfa,
     size_t maxIb = beta_address->strpcls(hb);
     auto m = M->pointer();
     if (zero) {
+#pragma omp parallel for
         for (size_t Ib = 0; Ib < maxIb; ++Ib)
             for (size_t Ia = 0; Ia < maxIa; ++Ia)
                 m[Ib][Ia] = 0.0;
     } else {
-        for (size_t Ia = 0; Ia < maxIa; ++Ia)
-            for (size_t Ib = 0; Ib < maxIb; ++Ib)
+#pragma omp parallel for
+        for (size_t Ib = 0; Ib < maxIb; ++Ib)
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
                 m[Ib][Ia] = c[Ia][Ib];
     }
     return m;
@@ -270,12 +304,77 @@ void scatter_C_block(FCIVector& C, double** m, bool alfa,
 
         double** c = C.C(ha)->pointer();
         // Add m transposed to C
+#pragma omp parallel for
         for (size_t Ia = 0; Ia < maxIa; ++Ia)
             for (size_t Ib = 0; Ib < maxIb; ++Ib)
                 c[Ia][Ib] += m[Ib][Ia];
     }
 }
 
+double** gather_C_block(const std::vector<FCIVector*>& C, std::shared_ptr<psi::Matrix> M,
+                        bool alfa, std::shared_ptr<FCIStringAddress> alfa_address,
+                        std::shared_ptr<FCIStringAddress> beta_address, int ha, int hb,
+                        bool zero) {
+    const size_t nvec = C.size();
+    if (nvec == 1)
+        return gather_C_block(*C[0], M, alfa, alfa_address, beta_address, ha, hb, zero);
+
+    // the rows of m are indexed by the strings we act on, the columns by the other strings
+    size_t maxIa = alfa_address->strpcls(ha);
+    size_t maxIb = beta_address->strpcls(hb);
+    size_t maxR = alfa ? maxIa : maxIb;
+    size_t maxL = alfa ? maxIb : maxIa;
+    auto m = M->pointer();
+    if (zero) {
+#pragma omp parallel for
+        for (size_t R = 0; R < maxR; ++R)
+            std::fill_n(m[R], nvec * maxL, 0.0);
+        return m;
+    }
+    for (size_t n = 0; n < nvec; ++n) {
+        auto c = C[n]->C(ha)->pointer();
+        if (alfa) {
+#pragma omp parallel for
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                std::copy_n(c[Ia], maxIb, m[Ia] + n * maxIb);
+        } else {
+#pragma omp parallel for
+            for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                    m[Ib][n * maxIa + Ia] = c[Ia][Ib];
+        }
+    }
+    return m;
+}
+
+void scatter_C_block(const std::vector<FCIVector*>& C, double** m, bool alfa,
+                     std::shared_ptr<FCIStringAddress> alfa_address,
+                     std::shared_ptr<FCIStringAddress> beta_address, int ha, int hb) {
+    const size_t nvec = C.size();
+    if (nvec == 1) {
+        scatter_C_block(*C[0], m, alfa, alfa_address, beta_address, ha, hb);
+        return;
+    }
+
+    size_t maxIa = alfa_address->strpcls(ha);
+    size_t maxIb = beta_address->strpcls(hb);
+    for (size_t n = 0; n < nvec; ++n) {
+        auto c = C[n]->C(ha)->pointer();
+        // Add m (transposed if alfa is false) to C
+#pragma omp parallel for
+        for (size_t Ia = 0; Ia < maxIa; ++Ia) {
+            if (alfa) {
+                const auto m_Ia = m[Ia] + n * maxIb;
+                for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                    c[Ia][Ib] += m_Ia[Ib];
+            } else {
+                for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                    c[Ia][Ib] += m[Ib][n * maxIa + Ia];
+            }
+        }
+    }
+}
+
 double FCIVector::norm(double power) {
     double norm = 0.0;
     for (int alfa_sym = 0; alfa_sym < nirrep_; ++alfa_sym) {
@@ -52,6 +52,15 @@ class MOSpaceInfo;
 class StringAddress;
 class RDMs;
 
+/// @brief A term of a batched RDM computation. The RDMs <C[left]| ... |C[right]> multiplied by
+/// weight are added to the RDMs number output
+struct FCIRDMTerm {
+    size_t left;
+    size_t right;
+    double weight;
+    size_t output;
+};
+
 class FCIVector {
   public:
     FCIVector(std::shared_ptr<FCIStringLists> lists, size_t symmetry);
@@ -111,6 +120,15 @@ class FCIVector {
     // Operations on the wave function
     void Hamiltonian(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
+    /// @brief Apply the Hamiltonian to a block of vectors, result[n] = H C[n]. The string lists are
+    /// traversed only once for all the vectors in the block
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The vectors that store the result
+    /// @param fci_ints The integrals object
+    static void Hamiltonian_block(const std::vector<FCIVector*>& C,
+                                  const std::vector<FCIVector*>& result,
+                                  std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+
     double energy_from_rdms(std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
     /// @brief Test the RDMs
@@ -138,12 +156,30 @@ class FCIVector {
     // Temporary memory allocation
     static void allocate_temp_space(std::shared_ptr<FCIStringLists> lists_, PrintLevel print_);
     static void release_temp_space();
+    /// Free the scratch buffers (CR_thread and CL_thread) of all the OpenMP threads. They outlive
+    /// the parallel regions because the runtime keeps its threads alive, so the solvers call this
+    /// at the end of the solve
+    static void release_thread_temp_space();
     void set_print(PrintLevel print) { print_ = print; }
 
     // ==> Class Static Functions <==
     static std::shared_ptr<RDMs> compute_rdms(FCIVector& C_left, FCIVector& C_right, int max_order,
                                               RDMsType type);
 
+    /// @brief Compute the RDMs of several pairs of vectors with a single traversal of the string
+    /// lists. The blocks of all the vectors are gathered once and shared by all the terms.
+    /// For example, the state-averaged RDMs of n roots are computed with the terms
+    /// {r, r, w_r, 0} for r = 0, ..., n - 1 and noutputs = 1, without forming the RDMs of each root
+    /// @param C The vectors
+    /// @param terms The terms to compute. Terms with the same output are summed
+    /// @param noutputs The number of RDMs returned
+    /// @param max_order The maximum order of the RDMs
+    /// @param type The type of RDMs (spin-dependent or spin-free)
+    /// @return A vector with noutputs RDMs
+    static std::vector<std::shared_ptr<RDMs>>
+    compute_rdms_block(const std::vector<FCIVector*>& C, const std::vector<FCIRDMTerm>& terms,
+                       size_t noutputs, int max_order, RDMsType type);
+
     /// Return the temporary matrix CR
     static std::shared_ptr<psi::Matrix> get_CR();
     /// Return the temporary matrix CL
@@ -180,20 +216,45 @@ class FCIVector {
 
     // ==> Class Static Data <==
 
+    // The scratch data is thread local, so independent solvers can run concurrently on different
+    // threads (see ActiveSpaceSolver). Inside parallel regions the master thread of a team is the
+    // thread that owns CR and CL
+
     // Temporary matrix of size as large as the largest block of C. Used to store the right
     // coefficient vector
-    static std::shared_ptr<psi::Matrix> CR;
+    static thread_local std::shared_ptr<psi::Matrix> CR;
     // Temporary matrix of size as large as the largest block of C. Used to store the left
     // coefficient vector
-    static std::shared_ptr<psi::Matrix> CL;
+    static thread_local std::shared_ptr<psi::Matrix> CL;
+
+    /// Widens CR and CL so that they hold the blocks of nvec vectors side by side while this
+    /// object is alive. The destructor restores the matrices allocated by allocate_temp_space, so
+    /// the wide matrices are freed at the end of each block operation. Does nothing if nvec = 1.
+    /// If widen_right is false only CL is widened (the RDMs gather all the vectors into CL)
+    class BlockTempSpace {
+      public:
+        explicit BlockTempSpace(size_t nvec, bool widen_right = true);
+        ~BlockTempSpace();
+        BlockTempSpace(const BlockTempSpace&) = delete;
+        BlockTempSpace& operator=(const BlockTempSpace&) = delete;
+
+      private:
+        std::shared_ptr<psi::Matrix> CR_;
+        std::shared_ptr<psi::Matrix> CL_;
+    };
+    // Scratch of each thread used by H2_aabb to store the gathered right coefficients. Each thread
+    // owns a batch of beta strings and stores only the columns of C that map onto it
+    static thread_local std::vector<double> CR_thread;
+    // Scratch of each thread used by H2_aabb to accumulate the left coefficients
+    static thread_local std::vector<double> CL_thread;
 
     // Timers
-    static double hdiag_timer;
-    static double h1_aa_timer;
-    static double h1_bb_timer;
-    static double h2_aaaa_timer;
-    static double h2_aabb_timer;
-    static double h2_bbbb_timer;
+    static thread_local double hdiag_timer;
+    static thread_local double h1_aa_timer;
+    static thread_local double h1_bb_timer;
+    static thread_local double h2_aaaa_timer;
+    static thread_local double h2_aabb_timer;
+    static thread_local double h2_bbbb_timer;
 
     // ==> Class Public Functions <==
 
@@ -212,58 +273,81 @@ class FCIVector {
                 ncmo * ncmo * ncmo * r + ncmo * ncmo * s + ncmo * t + u);
     }
 
-    /// @brief Apply the scalar part of the Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the scalar part of the Hamiltonian to a block of vectors and add it to the
+    /// result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
-    void H0(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+    static void H0(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
-    /// @brief Apply the one-particle Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the one-particle Hamiltonian to a block of vectors and add it to the result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
     /// @param alfa flag for alfa or beta component, true = alfa, false = beta
-    void H1(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
+    static void H1(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
 
-    /// @brief Apply the same-spin two-particle Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the same-spin two-particle Hamiltonian to a block of vectors and add it to the
+    /// result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
     /// @param alfa flag for alfa or beta component, true = alfa, false = beta
-    void H2_aaaa2(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
+    static void H2_aaaa2(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                         std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
 
-    /// @brief Apply the different-spin component of two-particle Hamiltonian to this vector and add
-    /// it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the different-spin component of two-particle Hamiltonian to a block of vectors
+    /// and add it to the result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object/
-    void H2_aabb(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+    static void H2_aabb(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                        std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+
+    // The functions below return one RDM for each output of a batched computation (see
+    // compute_rdms_block)
 
     // 1-RDM elements are stored in the format
     // <a^+_{pa} a^+_{qb} a_{sb} a_ra> -> rdm[oei_index(p,q)]
 
     /// Compute the matrix elements of the same 1-RDM <a^+_{p} a_{q}>
-    static ambit::Tensor compute_1rdm_same_irrep(FCIVector& C_left, FCIVector& C_right, bool alfa);
+    static std::vector<ambit::Tensor> compute_1rdm_same_irrep(const std::vector<FCIVector*>& C,
+                                                              const std::vector<FCIRDMTerm>& terms,
+                                                              size_t noutputs, bool alfa);
 
     // 2-RDM elements are stored in the format
     // <a^+_{p} a^+_{q} a_{s} a_r> -> rdm[tei_index(p,q,r,s)]
 
     /// Compute the matrix elements of the same spin 2-RDM <a^+_p a^+_q a_s a_r> (with all
     /// indices alpha or beta)
-    static ambit::Tensor compute_2rdm_aa_same_irrep(FCIVector& C_left, FCIVector& C_right,
-                                                    bool alfa);
+    static std::vector<ambit::Tensor>
+    compute_2rdm_aa_same_irrep(const std::vector<FCIVector*>& C,
+                               const std::vector<FCIRDMTerm>& terms, size_t noutputs, bool alfa);
     /// Compute the matrix elements of the alpha-beta 2-RDM <a^+_{pa} a^+_{qb} a_{sb} a_{ra}>
-    static ambit::Tensor compute_2rdm_ab_same_irrep(FCIVector& C_left, FCIVector& C_right);
+    static std::vector<ambit::Tensor>
+    compute_2rdm_ab_same_irrep(const std::vector<FCIVector*>& C,
+                               const std::vector<FCIRDMTerm>& terms, size_t noutputs);
 
     // 3-RDM elements are stored in the format
     // <a^+_p a^+_q a^+_r a_u a_t a_s> -> rdm[six_index(p,q,r,s,t,u)]
 
     /// Compute the matrix elements of the same spin 3-RDM <a^+_p a^+_q a_s a_r> (with all indices
     /// alpha or beta)
-    static ambit::Tensor compute_3rdm_aaa_same_irrep(FCIVector& C_left, FCIVector& C_right,
-                                                     bool alfa);
+    static std::vector<ambit::Tensor>
+    compute_3rdm_aaa_same_irrep(const std::vector<FCIVector*>& C,
+                                const std::vector<FCIRDMTerm>& terms, size_t noutputs, bool alfa);
     /// Compute the matrix elements of the alpha-alpha-beta 3-RDM <a^+_{pa} a^+_{qa} a^+_{rb} a_{ub}
     /// a_{ta} a_{sa}>
-    static ambit::Tensor compute_3rdm_aab_same_irrep(FCIVector& C_left, FCIVector& C_right);
+    static std::vector<ambit::Tensor>
+    compute_3rdm_aab_same_irrep(const std::vector<FCIVector*>& C,
+                                const std::vector<FCIRDMTerm>& terms, size_t noutputs);
     /// Compute the matrix elements of the alpha-beta-beta 3-RDM <a^+_{pa} a^+_{qb} a^+_{rb} a_{ub}
     /// a_{tb} a_{sa}>
-    static ambit::Tensor compute_3rdm_abb_same_irrep(FCIVector& C_left, FCIVector& C_right);
+    static std::vector<ambit::Tensor>
+    compute_3rdm_abb_same_irrep(const std::vector<FCIVector*>& C,
+                                const std::vector<FCIRDMTerm>& terms, size_t noutputs);
 };
 
 /// @brief Provide a pointer to the a block of the coefficient matrix in such a way that we can use
@@ -297,6 +381,34 @@ void scatter_C_block(FCIVector& C, double** m, bool alfa,
                      std::shared_ptr<FCIStringAddress> alfa_address,
                      std::shared_ptr<FCIStringAddress> beta_address, int ha, int hb);
 
+/// @brief Gather the same block of several vectors into a matrix. The blocks are stored side by
+/// side, so that each row of the matrix contains the strings of all the vectors. For a single
+/// vector this is equivalent to the function above
+/// @param C The fci vectors
+/// @param M The matrix that holds the data (unless there is a single vector and alfa is true)
+/// @param alfa flag for alfa or beta component, true = alfa, false = beta
+/// @param alfa_address The addressing object for the alfa component
+/// @param beta_address The addressing object for the beta component
+/// @param ha The string class of the alfa component (a generalization of the irrep)
+/// @param hb The string class of the beta component (a generalization of the irrep)
+/// @param zero If true, zero the matrix before returning it
+/// @return A pointer to the gathered block
+double** gather_C_block(const std::vector<FCIVector*>& C, std::shared_ptr<psi::Matrix> M,
+                        bool alfa, std::shared_ptr<FCIStringAddress> alfa_address,
+                        std::shared_ptr<FCIStringAddress> beta_address, int ha, int hb, bool zero);
+
+/// @brief Add the data gathered with the function above back to the coefficient matrices
+/// @param C The fci vectors
+/// @param m The matrix that holds the data
+/// @param alfa flag for alfa or beta component, true = alfa, false = beta
+/// @param alfa_address The addressing object for the alfa component
+/// @param beta_address The addressing object for the beta component
+/// @param ha The string class of the alfa component (a generalization of the irrep)
+/// @param hb The string class of the beta component (a generalization of the irrep)
+void scatter_C_block(const std::vector<FCIVector*>& C, double** m, bool alfa,
+                     std::shared_ptr<FCIStringAddress> alfa_address,
+                     std::shared_ptr<FCIStringAddress> beta_address, int ha, int hb);
+
 std::shared_ptr<RDMs> compute_transition_rdms(FCIVector& C_left, FCIVector& C_right,
                                               int max_rdm_level, RDMsType type);
 
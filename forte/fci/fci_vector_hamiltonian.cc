@@ -29,7 +29,9 @@
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/matrix.h"
 
+#include "forte-def.h"
 #include "integrals/active_space_integrals.h"
+#include "helpers/threading.h"
 #include "helpers/timer.h"
 #include "fci_vector.h"
 #include "fci_string_lists.h"
@@ -44,228 +46,348 @@ namespace forte {
  * @param result Wave function object which stores the resulting vector
  */
 void FCIVector::Hamiltonian(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
-    //    check_temp_space();
-    result.zero();
+    Hamiltonian_block({this}, {&result}, fci_ints);
+}
+
+/**
+ * Apply the Hamiltonian to a block of wave functions
+ * @param C The wave functions to which we apply the Hamiltonian
+ * @param result Wave function objects which store the resulting vectors
+ */
+void FCIVector::Hamiltonian_block(const std::vector<FCIVector*>& C,
+                                  const std::vector<FCIVector*>& result,
+                                  std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+    if (C.size() != result.size()) {
+        throw std::runtime_error("FCIVector::Hamiltonian_block: the number of input (" +
+                                 std::to_string(C.size()) + ") and output (" +
+                                 std::to_string(result.size()) + ") vectors is different");
+    }
+    if (C.empty())
+        return;
+
+    // The gathered blocks of all the vectors are stored side by side in CR and CL
+    BlockTempSpace block_temp_space(C.size());
+
+    for (auto r : result) {
+        r->zero();
+    }
 
     // H0
-    { H0(result, fci_ints); }
+    { H0(C, result, fci_ints); }
     // H1_aa
     {
         local_timer t;
-        H1(result, fci_ints, true);
+        H1(C, result, fci_ints, true);
         h1_aa_timer += t.get();
     }
     // H1_bb
     {
         local_timer t;
-        H1(result, fci_ints, false);
+        H1(C, result, fci_ints, false);
         h1_bb_timer += t.get();
     }
     // H2_aabb
     {
         local_timer t;
-        H2_aabb(result, fci_ints);
+        H2_aabb(C, result, fci_ints);
         h2_aabb_timer += t.get();
     }
     // H2_aaaa
     {
         local_timer t;
-        H2_aaaa2(result, fci_ints, true);
+        H2_aaaa2(C, result, fci_ints, true);
         h2_aaaa_timer += t.get();
     }
     // H2_bbbb
     {
         local_timer t;
-        H2_aaaa2(result, fci_ints, false);
+        H2_aaaa2(C, result, fci_ints, false);
         h2_bbbb_timer += t.get();
     }
 }
 
-void FCIVector::H0(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+void FCIVector::H0(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
     double core_energy = fci_ints->scalar_energy() + fci_ints->frozen_core_energy() +
                          fci_ints->nuclear_repulsion_energy();
-    for (int alfa_sym = 0; alfa_sym < nirrep_; ++alfa_sym) {
-        result.C_[alfa_sym]->copy(C_[alfa_sym]);
-        result.C_[alfa_sym]->scale(core_energy);
+    for (size_t n = 0; n < C.size(); ++n) {
+        for (int alfa_sym = 0; alfa_sym < C[n]->nirrep_; ++alfa_sym) {
+            result[n]->C_[alfa_sym]->copy(C[n]->C_[alfa_sym]);
+            result[n]->C_[alfa_sym]->scale(core_energy);
+        }
     }
 }
 
-void FCIVector::H1(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa) {
-    for (int h_Ia = 0; h_Ia < nirrep_; ++h_Ia) {
-        int h_Ib = h_Ia ^ symmetry_;
-        if (detpi_[h_Ia] > 0) {
-            auto Cr =
-                gather_C_block(*this, CR, alfa, alfa_address_, beta_address_, h_Ia, h_Ib, false);
+void FCIVector::H1(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa) {
+    const auto& C0 = *C[0];
+    const auto& lists = C0.lists_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const size_t nvec = C.size();
+    // when there is more than one vector the left block is always stored in CL
+    const bool zero_left = (not alfa) or (nvec > 1);
+
+    for (int h_Ia = 0; h_Ia < C0.nirrep_; ++h_Ia) {
+        int h_Ib = h_Ia ^ C0.symmetry_;
+        if (C0.detpi_[h_Ia] > 0) {
+            auto Cr = gather_C_block(C, CR, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
             auto Cl =
-                gather_C_block(result, CL, alfa, alfa_address_, beta_address_, h_Ia, h_Ib, !alfa);
-
-            size_t maxL = alfa ? beta_address_->strpcls(h_Ib) : alfa_address_->strpcls(h_Ia);
-
-            for (int p_sym = 0; p_sym < nirrep_; ++p_sym) {
-                int q_sym = p_sym; // Select the totat symmetric irrep
-                for (int p_rel = 0; p_rel < cmopi_[p_sym]; ++p_rel) {
-                    for (int q_rel = 0; q_rel < cmopi_[q_sym]; ++q_rel) {
-                        const int p_abs = p_rel + cmopi_offset_[p_sym];
-                        const int q_abs = q_rel + cmopi_offset_[q_sym];
-                        const double Hpq =
-                            alfa ? fci_ints->oei_a(p_abs, q_abs) : fci_ints->oei_b(p_abs, q_abs);
-                        const auto& vo_list = alfa ? lists_->get_alfa_vo_list(p_abs, q_abs, h_Ia)
-                                                   : lists_->get_beta_vo_list(p_abs, q_abs, h_Ib);
-                        for (const auto& [sign, I, J] : vo_list) {
-                            C_DAXPY(maxL, sign * Hpq, Cr[I], 1, Cl[J], 1);
+                gather_C_block(result, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, zero_left);
+
+            // the rows of Cr and Cl contain the strings of all the vectors
+            size_t maxL =
+                nvec * (alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia));
+
+            // Each thread updates a batch of columns of Cl, so threads never write to the same
+            // element and no synchronization is required
+#pragma omp parallel
+            {
+                const auto [col_start, col_end] =
+                    thread_range(maxL, omp_get_num_threads(), omp_get_thread_num());
+                const size_t ncol = col_end - col_start;
+                if (ncol > 0) {
+                    for (int p_sym = 0; p_sym < C0.nirrep_; ++p_sym) {
+                        int q_sym = p_sym; // Select the totat symmetric irrep
+                        for (int p_rel = 0; p_rel < C0.cmopi_[p_sym]; ++p_rel) {
+                            for (int q_rel = 0; q_rel < C0.cmopi_[q_sym]; ++q_rel) {
+                                const int p_abs = p_rel + C0.cmopi_offset_[p_sym];
+                                const int q_abs = q_rel + C0.cmopi_offset_[q_sym];
+                                const double Hpq = alfa ? fci_ints->oei_a(p_abs, q_abs)
+                                                        : fci_ints->oei_b(p_abs, q_abs);
+                                const auto& vo_list =
+                                    alfa ? lists->get_alfa_vo_list(p_abs, q_abs, h_Ia)
+                                         : lists->get_beta_vo_list(p_abs, q_abs, h_Ib);
+                                for (const auto& [sign, I, J] : vo_list) {
+                                    C_DAXPY(ncol, sign * Hpq, Cr[I] + col_start, 1,
+                                            Cl[J] + col_start, 1);
+                                }
+                            }
                         }
                     }
                 }
             }
-            scatter_C_block(result, Cl, alfa, alfa_address_, beta_address_, h_Ia, h_Ib);
+            scatter_C_block(result, Cl, alfa, alfa_address, beta_address, h_Ia, h_Ib);
         }
     } // End loop over h
 }
 
-void FCIVector::H2_aaaa2(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints,
-                         bool alfa) {
+void FCIVector::H2_aaaa2(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                         std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa) {
+    const auto& C0 = *C[0];
+    const auto& lists = C0.lists_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const size_t nvec = C.size();
+    // when there is more than one vector the left block is always stored in CL
+    const bool zero_left = (not alfa) or (nvec > 1);
+
     // Notation
     // h_Ia - symmetry of alpha strings
     // h_Ib - symmetry of beta strings
-    for (int h_Ia = 0; h_Ia < nirrep_; ++h_Ia) {
-        int h_Ib = h_Ia ^ symmetry_;
-        if (detpi_[h_Ia] > 0) {
-            auto Cr =
-                gather_C_block(*this, CR, alfa, alfa_address_, beta_address_, h_Ia, h_Ib, false);
+    for (int h_Ia = 0; h_Ia < C0.nirrep_; ++h_Ia) {
+        int h_Ib = h_Ia ^ C0.symmetry_;
+        if (C0.detpi_[h_Ia] > 0) {
+            auto Cr = gather_C_block(C, CR, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
             auto Cl =
-                gather_C_block(result, CL, alfa, alfa_address_, beta_address_, h_Ia, h_Ib, !alfa);
+                gather_C_block(result, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, zero_left);
 
-            size_t maxL = alfa ? beta_address_->strpcls(h_Ib) : alfa_address_->strpcls(h_Ia);
-            // Loop over (p>q) == (p>q)
-            for (int pq_sym = 0; pq_sym < nirrep_; ++pq_sym) {
-                size_t max_pq = lists_->pairpi(pq_sym);
-                for (size_t pq = 0; pq < max_pq; ++pq) {
-                    const auto& [p_abs, q_abs] = lists_->get_pair_list(pq_sym, pq);
+            // the rows of Cr and Cl contain the strings of all the vectors
+            size_t maxL =
+                nvec * (alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia));
 
-                    const double integral = alfa ? fci_ints->tei_aa(p_abs, q_abs, p_abs, q_abs)
-                                                 : fci_ints->tei_bb(p_abs, q_abs, p_abs, q_abs);
+            // Each thread updates a batch of columns of Cl (see H1)
+#pragma omp parallel
+            {
+                const auto [col_start, col_end] =
+                    thread_range(maxL, omp_get_num_threads(), omp_get_thread_num());
+                const size_t ncol = col_end - col_start;
+                if (ncol > 0) {
+                    // Loop over (p>q) == (p>q)
+                    for (int pq_sym = 0; pq_sym < C0.nirrep_; ++pq_sym) {
+                        size_t max_pq = lists->pairpi(pq_sym);
+                        for (size_t pq = 0; pq < max_pq; ++pq) {
+                            const auto& [p_abs, q_abs] = lists->get_pair_list(pq_sym, pq);
 
-                    const auto& OO_list = alfa ? lists_->get_alfa_oo_list(pq_sym, pq, h_Ia)
-                                               : lists_->get_beta_oo_list(pq_sym, pq, h_Ib);
+                            const double integral =
+                                alfa ? fci_ints->tei_aa(p_abs, q_abs, p_abs, q_abs)
+                                     : fci_ints->tei_bb(p_abs, q_abs, p_abs, q_abs);
 
-                    for (const auto& [sign, I, J] : OO_list) {
-                        C_DAXPY(maxL, sign * integral, Cr[I], 1, Cl[J], 1);
-                    }
-                }
-            }
-            // Loop over (p>q) > (r>s)
-            for (int pq_sym = 0; pq_sym < nirrep_; ++pq_sym) {
-                size_t max_pq = lists_->pairpi(pq_sym);
-                for (size_t pq = 0; pq < max_pq; ++pq) {
-                    const Pair& pq_pair = lists_->get_pair_list(pq_sym, pq);
-                    int p_abs = pq_pair.first;
-                    int q_abs = pq_pair.second;
-                    for (size_t rs = 0; rs < pq; ++rs) {
-                        const auto& [r_abs, s_abs] = lists_->get_pair_list(pq_sym, rs);
-                        const double integral = alfa ? fci_ints->tei_aa(p_abs, q_abs, r_abs, s_abs)
-                                                     : fci_ints->tei_bb(p_abs, q_abs, r_abs, s_abs);
-
-                        {
-                            const auto& VVOO_list =
-                                alfa ? lists_->get_alfa_vvoo_list(p_abs, q_abs, r_abs, s_abs, h_Ia)
-                                     : lists_->get_beta_vvoo_list(p_abs, q_abs, r_abs, s_abs, h_Ib);
-                            for (const auto& [sign, I, J] : VVOO_list) {
-                                C_DAXPY(maxL, sign * integral, Cr[I], 1, Cl[J], 1);
+                            const auto& OO_list = alfa ? lists->get_alfa_oo_list(pq_sym, pq, h_Ia)
+                                                       : lists->get_beta_oo_list(pq_sym, pq, h_Ib);
+
+                            for (const auto& [sign, I, J] : OO_list) {
+                                C_DAXPY(ncol, sign * integral, Cr[I] + col_start, 1,
+                                        Cl[J] + col_start, 1);
                             }
-                            {
-                                const auto& VVOO_list =
-                                    alfa ? lists_->get_alfa_vvoo_list(r_abs, s_abs, p_abs, q_abs,
-                                                                      h_Ia)
-                                         : lists_->get_beta_vvoo_list(r_abs, s_abs, p_abs, q_abs,
-                                                                      h_Ib);
-                                for (const auto& [sign, I, J] : VVOO_list) {
-                                    C_DAXPY(maxL, sign * integral, Cr[I], 1, Cl[J], 1);
+                        }
+                    }
+                    // Loop over (p>q) > (r>s)
+                    for (int pq_sym = 0; pq_sym < C0.nirrep_; ++pq_sym) {
+                        size_t max_pq = lists->pairpi(pq_sym);
+                        for (size_t pq = 0; pq < max_pq; ++pq) {
+                            const Pair& pq_pair = lists->get_pair_list(pq_sym, pq);
+                            int p_abs = pq_pair.first;
+                            int q_abs = pq_pair.second;
+                            for (size_t rs = 0; rs < pq; ++rs) {
+                                const auto& [r_abs, s_abs] = lists->get_pair_list(pq_sym, rs);
+                                const double integral =
+                                    alfa ? fci_ints->tei_aa(p_abs, q_abs, r_abs, s_abs)
+                                         : fci_ints->tei_bb(p_abs, q_abs, r_abs, s_abs);
+                                {
+                                    const auto& VVOO_list =
+                                        alfa ? lists->get_alfa_vvoo_list(p_abs, q_abs, r_abs,
+                                                                         s_abs, h_Ia)
+                                             : lists->get_beta_vvoo_list(p_abs, q_abs, r_abs,
+                                                                         s_abs, h_Ib);
+                                    for (const auto& [sign, I, J] : VVOO_list) {
+                                        C_DAXPY(ncol, sign * integral, Cr[I] + col_start, 1,
+                                                Cl[J] + col_start, 1);
+                                    }
+                                }
+                                {
+                                    const auto& VVOO_list =
+                                        alfa ? lists->get_alfa_vvoo_list(r_abs, s_abs, p_abs,
+                                                                         q_abs, h_Ia)
+                                             : lists->get_beta_vvoo_list(r_abs, s_abs, p_abs,
+                                                                         q_abs, h_Ib);
+                                    for (const auto& [sign, I, J] : VVOO_list) {
+                                        C_DAXPY(ncol, sign * integral, Cr[I] + col_start, 1,
+                                                Cl[J] + col_start, 1);
+                                    }
                                 }
                             }
                         }
                     }
                 }
             }
-            scatter_C_block(result, Cl, alfa, alfa_address_, beta_address_, h_Ia, h_Ib);
+            scatter_C_block(result, Cl, alfa, alfa_address, beta_address, h_Ia, h_Ib);
         }
     } // End loop over h
 }
 
-void FCIVector::H2_aabb(FCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
-    // Loop over blocks of matrix C
-    for (int h_Ia = 0; h_Ia < nirrep_; ++h_Ia) {
-        const size_t maxIa = alfa_address_->strpcls(h_Ia);
-        const int h_Ib = h_Ia ^ symmetry_;
-        const auto C = C_[h_Ia]->pointer();
-
-        // Loop over all r,s
-        for (int rs_sym = 0; rs_sym < nirrep_; ++rs_sym) {
-            const int h_Jb = h_Ib ^ rs_sym;
-            const int h_Ja = h_Jb ^ symmetry_;
-
-            const size_t maxJa = alfa_address_->strpcls(h_Ja);
-            auto HC = result.C_[h_Ja]->pointer();
-            for (int r_sym = 0; r_sym < nirrep_; ++r_sym) {
-                const int s_sym = rs_sym ^ r_sym;
-
-                for (int r_rel = 0; r_rel < cmopi_[r_sym]; ++r_rel) {
-                    for (int s_rel = 0; s_rel < cmopi_[s_sym]; ++s_rel) {
-                        const int r_abs = r_rel + cmopi_offset_[r_sym];
-                        const int s_abs = s_rel + cmopi_offset_[s_sym];
-
-                        // Grab list (r,s,h_Ib)
-                        const auto& vo_beta = lists_->get_beta_vo_list(r_abs, s_abs, h_Ib);
-                        const size_t maxSSb = vo_beta.size();
-
-                        if (maxSSb == 0)
-                            continue;
-
-                        CR->zero();
-                        CL->zero();
-                        auto Cr = CR->pointer();
-                        auto Cl = CL->pointer();
-
-                        // Gather cols of C into CR
-                        for (size_t Ia = 0; Ia < maxIa; ++Ia) {
-                            const auto c = C[Ia];
-                            auto cr = Cr[Ia];
-                            for (size_t SSb = 0; SSb < maxSSb; ++SSb) {
-                                cr[SSb] = c[vo_beta[SSb].I] * vo_beta[SSb].sign;
+void FCIVector::H2_aabb(const std::vector<FCIVector*>& C, const std::vector<FCIVector*>& result,
+                        std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+    const auto& C0 = *C[0];
+    const auto& lists = C0.lists_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const int nirrep = C0.nirrep_;
+    const size_t nvec = C.size();
+
+    const size_t max_threads = omp_get_max_threads();
+
+    // The beta strings of the result are split in batches, one per thread. A thread only processes
+    // the beta substitutions (r,s) that land in its own batch, so each element of the result is
+    // updated by exactly one thread and the columns gathered from C fit in a per-thread buffer
+#pragma omp parallel num_threads(max_threads)
+    {
+        const size_t num_thread = omp_get_num_threads();
+        const size_t tid = omp_get_thread_num();
+        // the buffers are thread local, so each thread gets its own
+        auto& cr_buffer = CR_thread;
+        auto& cl_buffer = CL_thread;
+        std::vector<StringSubstitution> vo_beta;
+
+        // Loop over blocks of matrix C
+        for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
+            const size_t maxIa = alfa_address->strpcls(h_Ia);
+            const int h_Ib = h_Ia ^ C0.symmetry_;
+
+            // Loop over all r,s
+            for (int rs_sym = 0; rs_sym < nirrep; ++rs_sym) {
+                const int h_Jb = h_Ib ^ rs_sym;
+                const int h_Ja = h_Jb ^ C0.symmetry_;
+
+                const size_t maxJa = alfa_address->strpcls(h_Ja);
+                const auto [Jb_start, Jb_end] =
+                    thread_range(beta_address->strpcls(h_Jb), num_thread, tid);
+                if (Jb_start == Jb_end)
+                    continue;
+
+                // The number of columns assigned to this thread bounds the size of the buffers
+                const size_t max_cols = nvec * (Jb_end - Jb_start);
+                if (cr_buffer.size() < maxIa * max_cols)
+                    cr_buffer.resize(maxIa * max_cols);
+                if (cl_buffer.size() < maxJa * max_cols)
+                    cl_buffer.resize(maxJa * max_cols);
+
+                for (int r_sym = 0; r_sym < nirrep; ++r_sym) {
+                    const int s_sym = rs_sym ^ r_sym;
+
+                    for (int r_rel = 0; r_rel < C0.cmopi_[r_sym]; ++r_rel) {
+                        for (int s_rel = 0; s_rel < C0.cmopi_[s_sym]; ++s_rel) {
+                            const int r_abs = r_rel + C0.cmopi_offset_[r_sym];
+                            const int s_abs = s_rel + C0.cmopi_offset_[s_sym];
+
+                            // Grab the elements of list (r,s,h_Ib) that belong to this thread.
+                            // For a given (r,s) each string J appears at most once, so this
+                            // selects at most max_cols elements
+                            vo_beta.clear();
+                            for (const auto& ss : lists->get_beta_vo_list(r_abs, s_abs, h_Ib)) {
+                                if ((ss.J >= Jb_start) and (ss.J < Jb_end))
+                                    vo_beta.push_back(ss);
                             }
-                        }
+                            const size_t maxSSb = vo_beta.size();
+
+                            if (maxSSb == 0)
+                                continue;
 
-                        // Loop over all p,q
-                        int pq_sym = rs_sym;
-                        for (int p_sym = 0; p_sym < nirrep_; ++p_sym) {
-                            int q_sym = pq_sym ^ p_sym;
-                            for (int p_rel = 0; p_rel < cmopi_[p_sym]; ++p_rel) {
-                                for (int q_rel = 0; q_rel < cmopi_[q_sym]; ++q_rel) {
-                                    int p_abs = p_rel + cmopi_offset_[p_sym];
-                                    int q_abs = q_rel + cmopi_offset_[q_sym];
-                                    // Grab the integral
-                                    const double integral =
-                                        fci_ints->tei_ab(p_abs, r_abs, q_abs, s_abs);
-
-                                    const auto& vo_alfa =
-                                        lists_->get_alfa_vo_list(p_abs, q_abs, h_Ia);
-
-                                    for (const auto& [sign, I, J] : vo_alfa) {
-                                        C_DAXPY(maxSSb, integral * sign, Cr[I], 1, Cl[J], 1);
+                            // The buffers store the columns of all the vectors side by side
+                            const size_t stride = nvec * maxSSb;
+                            double* cr = cr_buffer.data();
+                            double* cl = cl_buffer.data();
+
+                            // Gather cols of C into the right buffer
+                            for (size_t n = 0; n < nvec; ++n) {
+                                const auto Cn = C[n]->C_[h_Ia]->pointer();
+                                for (size_t Ia = 0; Ia < maxIa; ++Ia) {
+                                    const auto c = Cn[Ia];
+                                    auto cr_Ia = cr + Ia * stride + n * maxSSb;
+                                    for (size_t SSb = 0; SSb < maxSSb; ++SSb) {
+                                        cr_Ia[SSb] = c[vo_beta[SSb].I] * vo_beta[SSb].sign;
                                     }
                                 }
                             }
-                        } // End loop over p,q
-
-                        // Scatter cols of CL into HC
-                        for (size_t Ja = 0; Ja < maxJa; ++Ja) {
-                            const auto hc = HC[Ja];
-                            auto cl = Cl[Ja];
-                            for (size_t SSb = 0; SSb < maxSSb; ++SSb) {
-                                hc[vo_beta[SSb].J] += cl[SSb];
+                            std::fill_n(cl, maxJa * stride, 0.0);
+
+                            // Loop over all p,q
+                            int pq_sym = rs_sym;
+                            for (int p_sym = 0; p_sym < nirrep; ++p_sym) {
+                                int q_sym = pq_sym ^ p_sym;
+                                for (int p_rel = 0; p_rel < C0.cmopi_[p_sym]; ++p_rel) {
+                                    for (int q_rel = 0; q_rel < C0.cmopi_[q_sym]; ++q_rel) {
+                                        int p_abs = p_rel + C0.cmopi_offset_[p_sym];
+                                        int q_abs = q_rel + C0.cmopi_offset_[q_sym];
+                                        // Grab the integral
+                                        const double integral =
+                                            fci_ints->tei_ab(p_abs, r_abs, q_abs, s_abs);
+
+                                        const auto& vo_alfa =
+                                            lists->get_alfa_vo_list(p_abs, q_abs, h_Ia);
+
+                                        for (const auto& [sign, I, J] : vo_alfa) {
+                                            C_DAXPY(stride, integral * sign, cr + I * stride, 1,
+                                                    cl + J * stride, 1);
+                                        }
+                                    }
+                                }
+                            } // End loop over p,q
+
+                            // Scatter cols of the left buffer into HC
+                            for (size_t n = 0; n < nvec; ++n) {
+                                auto HC = result[n]->C_[h_Ja]->pointer();
+                                for (size_t Ja = 0; Ja < maxJa; ++Ja) {
+                                    const auto hc = HC[Ja];
+                                    auto cl_Ja = cl + Ja * stride + n * maxSSb;
+                                    for (size_t SSb = 0; SSb < maxSSb; ++SSb) {
+                                        hc[vo_beta[SSb].J] += cl_Ja[SSb];
+                                    }
+                                }
                             }
                         }
-                    }
-                } // End loop over r_rel,s_rel
+                    } // End loop over r_rel,s_rel
+                }
             }
         }
     }
@@ -36,146 +36,173 @@
 
 namespace forte {
 
-/**
- * Compute the one-particle density matrix for a given wave function
- * @param alfa flag for alfa or beta component, true = alfa, false = beta
- */
-std::shared_ptr<RDMs> FCIVector::compute_rdms(FCIVector& C_left, FCIVector& C_right,
-                                              int max_rdm_level, RDMsType type) {
-    std::vector<double> rdm_timing;
-
-    size_t na = C_left.alfa_address()->nones();
-    size_t nb = C_left.beta_address()->nones();
-    size_t nmo = C_left.ncmo_;
+namespace {
+/// Build n tensors with the same label and dimensions
+std::vector<ambit::Tensor> build_rdm_tensors(size_t n, const std::string& label,
+                                             const std::vector<size_t>& dims) {
+    std::vector<ambit::Tensor> tensors;
+    for (size_t i = 0; i < n; ++i) {
+        tensors.push_back(ambit::Tensor::build(ambit::CoreTensor, label, dims));
+    }
+    return tensors;
+}
 
-    ambit::Tensor g1a, g1b;
-    ambit::Tensor g2aa, g2ab, g2bb;
-    ambit::Tensor g3aaa, g3aab, g3abb, g3bbb;
+/// Add sign * <m[J] (left vector of term t)|m[I] (right vector of term t)> to elements[t].
+/// The rows of m store the blocks of the vectors side by side, maxL elements each
+inline void add_dots(double** m, size_t maxL, const std::vector<FCIRDMTerm>& terms, double sign,
+                     size_t I, size_t J, std::vector<double>& elements) {
+    for (size_t t = 0, nterms = terms.size(); t < nterms; ++t) {
+        double* Cl = m[J] + terms[t].left * maxL;
+        double* Cr = m[I] + terms[t].right * maxL;
+        elements[t] += sign * psi::C_DDOT(maxL, Cl, 1, Cr, 1);
+    }
+}
 
-    if (max_rdm_level >= 1) {
-        local_timer t;
-        g1a = compute_1rdm_same_irrep(C_left, C_right, true);
-        g1b = compute_1rdm_same_irrep(C_left, C_right, false);
-        rdm_timing.push_back(t.get());
+/// Add factor * weight * elements[t] to the element index of the RDM of each term
+inline void add_elements(std::vector<double*>& rdm_data, const std::vector<FCIRDMTerm>& terms,
+                         const std::vector<double>& elements, size_t index, double factor) {
+    for (size_t t = 0, nterms = terms.size(); t < nterms; ++t) {
+        rdm_data[t][index] += factor * terms[t].weight * elements[t];
     }
+}
 
-    if (max_rdm_level >= 2) {
-        local_timer t;
-        g2aa = compute_2rdm_aa_same_irrep(C_left, C_right, true);
-        g2bb = compute_2rdm_aa_same_irrep(C_left, C_right, false);
-        g2ab = compute_2rdm_ab_same_irrep(C_left, C_right);
-        rdm_timing.push_back(t.get());
+/// @return the pointers to the data of the RDM of each term
+std::vector<double*> term_data(std::vector<ambit::Tensor>& rdms,
+                               const std::vector<FCIRDMTerm>& terms) {
+    std::vector<double*> data;
+    for (const auto& term : terms) {
+        data.push_back(rdms[term.output].data().data());
     }
+    return data;
+}
+} // namespace
 
-    if (max_rdm_level >= 3) {
-        local_timer t;
-        if (na >= 3) {
-            g3aaa = compute_3rdm_aaa_same_irrep(C_left, C_right, true);
-        } else {
-            g3aaa =
-                ambit::Tensor::build(ambit::CoreTensor, "g3aaa", {nmo, nmo, nmo, nmo, nmo, nmo});
-            g3aaa.zero();
-        }
-        if (nb >= 3) {
-            g3bbb = compute_3rdm_aaa_same_irrep(C_left, C_right, false);
-        } else {
-            g3bbb =
-                ambit::Tensor::build(ambit::CoreTensor, "g3bbb", {nmo, nmo, nmo, nmo, nmo, nmo});
-            g3bbb.zero();
-        }
+std::shared_ptr<RDMs> FCIVector::compute_rdms(FCIVector& C_left, FCIVector& C_right,
+                                              int max_rdm_level, RDMsType type) {
+    if (&C_left == &C_right) {
+        return compute_rdms_block({&C_left}, {{0, 0, 1.0, 0}}, 1, max_rdm_level, type)[0];
+    }
+    return compute_rdms_block({&C_left, &C_right}, {{0, 1, 1.0, 0}}, 1, max_rdm_level, type)[0];
+}
 
-        if ((na >= 2) and (nb >= 1)) {
-            g3aab = compute_3rdm_aab_same_irrep(C_left, C_right);
-        } else {
-            g3aab =
-                ambit::Tensor::build(ambit::CoreTensor, "g3aab", {nmo, nmo, nmo, nmo, nmo, nmo});
-            g3aab.zero();
+std::vector<std::shared_ptr<RDMs>>
+FCIVector::compute_rdms_block(const std::vector<FCIVector*>& C,
+                              const std::vector<FCIRDMTerm>& terms, size_t noutputs,
+                              int max_rdm_level, RDMsType type) {
+    if (max_rdm_level >= 4) {
+        throw std::runtime_error("RDMs of order 4 or higher are not implemented in FCISolver (and "
+                                 "more generally in Forte).");
+    }
+    if (C.empty()) {
+        throw std::runtime_error("FCIVector::compute_rdms_block: no vectors were passed");
+    }
+    for (const auto& term : terms) {
+        if (std::max(term.left, term.right) >= C.size() or term.output >= noutputs) {
+            throw std::runtime_error("FCIVector::compute_rdms_block: invalid term");
         }
+    }
 
-        if ((na >= 1) and (nb >= 2)) {
-            g3abb = compute_3rdm_abb_same_irrep(C_left, C_right);
-        } else {
-            g3abb =
-                ambit::Tensor::build(ambit::CoreTensor, "g3abb", {nmo, nmo, nmo, nmo, nmo, nmo});
-            g3abb.zero();
+    std::vector<std::shared_ptr<RDMs>> rdms(noutputs);
+    if (max_rdm_level <= 0) {
+        for (auto& rdm : rdms) {
+            rdm = std::make_shared<RDMsSpinDependent>();
         }
-        rdm_timing.push_back(t.get());
+        return rdms;
     }
 
-    // for (size_t n = 0; n < rdm_timing.size(); ++n) {
-    //     psi::outfile->Printf("\n    Timing for %d-RDM: %.3f s", n + 1, rdm_timing[n]);
-    // }
+    // the blocks of all the vectors are gathered side by side in CL
+    allocate_temp_space(C[0]->lists_, C[0]->print_);
+    BlockTempSpace block_temp_space(C.size(), false);
 
-    if (type == RDMsType::spin_dependent) {
-        if (max_rdm_level == 1) {
-            return std::make_shared<RDMsSpinDependent>(g1a, g1b);
-        }
-        if (max_rdm_level == 2) {
-            return std::make_shared<RDMsSpinDependent>(g1a, g1b, g2aa, g2ab, g2bb);
-        }
-        if (max_rdm_level == 3) {
-            return std::make_shared<RDMsSpinDependent>(g1a, g1b, g2aa, g2ab, g2bb, g3aaa, g3aab,
-                                                       g3abb, g3bbb);
-        }
-    } else {
-        g1a("pq") += g1b("pq");
+    std::vector<ambit::Tensor> g1a, g1b;
+    std::vector<ambit::Tensor> g2aa, g2ab, g2bb;
+    std::vector<ambit::Tensor> g3aaa, g3aab, g3abb, g3bbb;
 
-        if (max_rdm_level > 1) {
-            g2aa("pqrs") += g2ab("pqrs") + g2ab("qpsr");
-            g2aa("pqrs") += g2bb("pqrs");
-        }
-        if (max_rdm_level > 2) {
-            g3aaa("pqrstu") += g3aab("pqrstu") + g3aab("prqsut") + g3aab("qrptus");
-            g3aaa("pqrstu") += g3abb("pqrstu") + g3abb("qprtsu") + g3abb("rpqust");
-            g3aaa("pqrstu") += g3bbb("pqrstu");
-        }
-        if (max_rdm_level == 1)
-            return std::make_shared<RDMsSpinFree>(g1a);
-        if (max_rdm_level == 2)
-            return std::make_shared<RDMsSpinFree>(g1a, g2aa);
-        if (max_rdm_level == 3)
-            return std::make_shared<RDMsSpinFree>(g1a, g2aa, g3aaa);
+    g1a = compute_1rdm_same_irrep(C, terms, noutputs, true);
+    g1b = compute_1rdm_same_irrep(C, terms, noutputs, false);
+
+    if (max_rdm_level >= 2) {
+        g2aa = compute_2rdm_aa_same_irrep(C, terms, noutputs, true);
+        g2bb = compute_2rdm_aa_same_irrep(C, terms, noutputs, false);
+        g2ab = compute_2rdm_ab_same_irrep(C, terms, noutputs);
     }
 
-    if (max_rdm_level >= 4) {
-        throw std::runtime_error("RDMs of order 4 or higher are not implemented in FCISolver (and "
-                                 "more generally in Forte).");
+    if (max_rdm_level >= 3) {
+        g3aaa = compute_3rdm_aaa_same_irrep(C, terms, noutputs, true);
+        g3bbb = compute_3rdm_aaa_same_irrep(C, terms, noutputs, false);
+        g3aab = compute_3rdm_aab_same_irrep(C, terms, noutputs);
+        g3abb = compute_3rdm_abb_same_irrep(C, terms, noutputs);
+    }
+
+    for (size_t n = 0; n < noutputs; ++n) {
+        if (type == RDMsType::spin_dependent) {
+            if (max_rdm_level == 1) {
+                rdms[n] = std::make_shared<RDMsSpinDependent>(g1a[n], g1b[n]);
+            } else if (max_rdm_level == 2) {
+                rdms[n] = std::make_shared<RDMsSpinDependent>(g1a[n], g1b[n], g2aa[n], g2ab[n],
+                                                              g2bb[n]);
+            } else {
+                rdms[n] = std::make_shared<RDMsSpinDependent>(g1a[n], g1b[n], g2aa[n], g2ab[n],
+                                                              g2bb[n], g3aaa[n], g3aab[n],
+                                                              g3abb[n], g3bbb[n]);
+            }
+        } else {
+            g1a[n]("pq") += g1b[n]("pq");
+
+            if (max_rdm_level > 1) {
+                g2aa[n]("pqrs") += g2ab[n]("pqrs") + g2ab[n]("qpsr");
+                g2aa[n]("pqrs") += g2bb[n]("pqrs");
+            }
+            if (max_rdm_level > 2) {
+                g3aaa[n]("pqrstu") += g3aab[n]("pqrstu") + g3aab[n]("prqsut") + g3aab[n]("qrptus");
+                g3aaa[n]("pqrstu") += g3abb[n]("pqrstu") + g3abb[n]("qprtsu") + g3abb[n]("rpqust");
+                g3aaa[n]("pqrstu") += g3bbb[n]("pqrstu");
+            }
+            if (max_rdm_level == 1) {
+                rdms[n] = std::make_shared<RDMsSpinFree>(g1a[n]);
+            } else if (max_rdm_level == 2) {
+                rdms[n] = std::make_shared<RDMsSpinFree>(g1a[n], g2aa[n]);
+            } else {
+                rdms[n] = std::make_shared<RDMsSpinFree>(g1a[n], g2aa[n], g3aaa[n]);
+            }
+        }
     }
-    return std::make_shared<RDMsSpinDependent>();
+    return rdms;
 }
 
 /**
  * Compute the one-particle density matrix for a given wave function
  * @param alfa flag for alfa or beta component, true = alfa, false = beta
  */
-ambit::Tensor FCIVector::compute_1rdm_same_irrep(FCIVector& C_left, FCIVector& C_right, bool alfa) {
-    size_t ncmo = C_left.ncmo_;
-    size_t nirrep = C_left.nirrep_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& detpi = C_left.detpi_;
-    const auto& alfa_address = C_left.alfa_address_;
-    const auto& beta_address = C_left.beta_address_;
-    const auto& cmopi = C_left.cmopi_;
-    const auto& cmopi_offset = C_left.cmopi_offset_;
-    const auto& lists = C_left.lists_;
-
-    auto rdm = ambit::Tensor::build(ambit::CoreTensor, alfa ? "1RDM_A" : "1RDM_B", {ncmo, ncmo});
+std::vector<ambit::Tensor> FCIVector::compute_1rdm_same_irrep(const std::vector<FCIVector*>& C,
+                                                              const std::vector<FCIRDMTerm>& terms,
+                                                              size_t noutputs, bool alfa) {
+    const auto& C0 = *C[0];
+    size_t ncmo = C0.ncmo_;
+    size_t nirrep = C0.nirrep_;
+    size_t symmetry = C0.symmetry_;
+    const auto& detpi = C0.detpi_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const auto& cmopi = C0.cmopi_;
+    const auto& cmopi_offset = C0.cmopi_offset_;
+    const auto& lists = C0.lists_;
+
+    auto rdms = build_rdm_tensors(noutputs, alfa ? "1RDM_A" : "1RDM_B", {ncmo, ncmo});
 
     auto na = alfa_address->nones();
     auto nb = beta_address->nones();
     if ((alfa and (na < 1)) or ((!alfa) and (nb < 1)))
-        return rdm;
+        return rdms;
 
-    auto& rdm_data = rdm.data();
+    auto rdm_data = term_data(rdms, terms);
+    std::vector<double> elements(terms.size());
 
     for (size_t h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
         int h_Ib = h_Ia ^ symmetry;
         if (detpi[h_Ia] > 0) {
-            // Get a pointer to the correct block of matrix C
-            auto Cl =
-                gather_C_block(C_left, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
-            auto Cr =
-                gather_C_block(C_right, CR, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
+            // Gather the blocks of all the vectors
+            auto m = gather_C_block(C, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
 
             const size_t maxL = alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia);
             for (size_t p_sym = 0; p_sym < nirrep; ++p_sym) {
@@ -186,42 +213,46 @@ ambit::Tensor FCIVector::compute_1rdm_same_irrep(FCIVector& C_left, FCIVector& C
                         int q_abs = q_rel + cmopi_offset[q_sym];
                         const auto& vo = alfa ? lists->get_alfa_vo_list(p_abs, q_abs, h_Ia)
                                               : lists->get_beta_vo_list(p_abs, q_abs, h_Ib);
-                        double rdm_element = 0.0;
+                        std::fill(elements.begin(), elements.end(), 0.0);
                         for (const auto& [sign, I, J] : vo) {
-                            rdm_element += sign * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
+                            add_dots(m, maxL, terms, sign, I, J, elements);
                         }
-                        rdm_data[p_abs * ncmo + q_abs] += rdm_element;
+                        add_elements(rdm_data, terms, elements, p_abs * ncmo + q_abs, 1.0);
                     }
                 }
             }
         }
     } // End loop over h
-    return rdm;
+    return rdms;
 }
 
 /**
  * Compute the aa/bb two-particle density matrix for a given wave function
  * @param alfa flag for alfa or beta component, true = aa, false = bb
  */
-ambit::Tensor FCIVector::compute_2rdm_aa_same_irrep(FCIVector& C_left, FCIVector& C_right,
-                                                    bool alfa) {
-    int nirrep = C_left.nirrep_;
-    size_t ncmo = C_left.ncmo_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& detpi = C_left.detpi_;
-    const auto& alfa_address = C_left.alfa_address_;
-    const auto& beta_address = C_left.beta_address_;
-    const auto& lists = C_left.lists_;
-
-    auto rdm = ambit::Tensor::build(ambit::CoreTensor, alfa ? "2RDM_AA" : "2RDM_BB",
-                                    {ncmo, ncmo, ncmo, ncmo});
+std::vector<ambit::Tensor>
+FCIVector::compute_2rdm_aa_same_irrep(const std::vector<FCIVector*>& C,
+                                      const std::vector<FCIRDMTerm>& terms, size_t noutputs,
+                                      bool alfa) {
+    const auto& C0 = *C[0];
+    int nirrep = C0.nirrep_;
+    size_t ncmo = C0.ncmo_;
+    size_t symmetry = C0.symmetry_;
+    const auto& detpi = C0.detpi_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const auto& lists = C0.lists_;
+
+    auto rdms =
+        build_rdm_tensors(noutputs, alfa ? "2RDM_AA" : "2RDM_BB", {ncmo, ncmo, ncmo, ncmo});
 
     auto na = alfa_address->nones();
     auto nb = beta_address->nones();
     if ((alfa and (na < 2)) or ((!alfa) and (nb < 2)))
-        return rdm;
+        return rdms;
 
-    auto& rdm_data = rdm.data();
+    auto rdm_data = term_data(rdms, terms);
+    std::vector<double> elements(terms.size());
 
     // Notation
     // h_Ia - symmetry of alpha strings
@@ -229,11 +260,8 @@ ambit::Tensor FCIVector::compute_2rdm_aa_same_irrep(FCIVector& C_left, FCIVector
     for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
         int h_Ib = h_Ia ^ symmetry;
         if (detpi[h_Ia] > 0) {
-            // Get a pointer to the correct block of matrix C
-            auto Cl =
-                gather_C_block(C_left, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
-            auto Cr =
-                gather_C_block(C_right, CR, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
+            // Gather the blocks of all the vectors
+            auto m = gather_C_block(C, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
 
             size_t maxL = alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia);
             // Loop over (p>q) == (p>q)
@@ -242,19 +270,23 @@ ambit::Tensor FCIVector::compute_2rdm_aa_same_irrep(FCIVector& C_left, FCIVector
                 for (size_t pq = 0; pq < max_pq; ++pq) {
                     const auto& [p_abs, q_abs] = lists->get_pair_list(pq_sym, pq);
 
-                    std::vector<StringSubstitution>& OO =
+                    const std::vector<StringSubstitution>& OO =
                         alfa ? lists->get_alfa_oo_list(pq_sym, pq, h_Ia)
                              : lists->get_beta_oo_list(pq_sym, pq, h_Ib);
 
-                    double rdm_element = 0.0;
+                    std::fill(elements.begin(), elements.end(), 0.0);
                     for (const auto& [sign, I, J] : OO) {
-                        rdm_element += sign * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
+                        add_dots(m, maxL, terms, sign, I, J, elements);
                     }
 
-                    rdm_data[tei_index(p_abs, q_abs, p_abs, q_abs, ncmo)] += rdm_element;
-                    rdm_data[tei_index(p_abs, q_abs, q_abs, p_abs, ncmo)] -= rdm_element;
-                    rdm_data[tei_index(q_abs, p_abs, p_abs, q_abs, ncmo)] -= rdm_element;
-                    rdm_data[tei_index(q_abs, p_abs, q_abs, p_abs, ncmo)] += rdm_element;
+                    add_elements(rdm_data, terms, elements,
+                                 tei_index(p_abs, q_abs, p_abs, q_abs, ncmo), 1.0);
+                    add_elements(rdm_data, terms, elements,
+                                 tei_index(p_abs, q_abs, q_abs, p_abs, ncmo), -1.0);
+                    add_elements(rdm_data, terms, elements,
+                                 tei_index(q_abs, p_abs, p_abs, q_abs, ncmo), -1.0);
+                    add_elements(rdm_data, terms, elements,
+                                 tei_index(q_abs, p_abs, q_abs, p_abs, ncmo), 1.0);
                 }
             }
             // Loop over (p>q) > (r>s)
@@ -269,71 +301,70 @@ ambit::Tensor FCIVector::compute_2rdm_aa_same_irrep(FCIVector& C_left, FCIVector
                             alfa ? lists->get_alfa_vvoo_list(p_abs, q_abs, r_abs, s_abs, h_Ia)
                                  : lists->get_beta_vvoo_list(p_abs, q_abs, r_abs, s_abs, h_Ib);
 
-                        double rdm_element = 0.0;
+                        std::fill(elements.begin(), elements.end(), 0.0);
                         for (const auto& [sign, I, J] : VVOO) {
-                            rdm_element += sign * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
+                            add_dots(m, maxL, terms, sign, I, J, elements);
                         }
 
-                        rdm_data[tei_index(p_abs, q_abs, r_abs, s_abs, ncmo)] += rdm_element;
-                        rdm_data[tei_index(q_abs, p_abs, r_abs, s_abs, ncmo)] -= rdm_element;
-                        rdm_data[tei_index(p_abs, q_abs, s_abs, r_abs, ncmo)] -= rdm_element;
-                        rdm_data[tei_index(q_abs, p_abs, s_abs, r_abs, ncmo)] += rdm_element;
-                        rdm_data[tei_index(r_abs, s_abs, p_abs, q_abs, ncmo)] += rdm_element;
-                        rdm_data[tei_index(r_abs, s_abs, q_abs, p_abs, ncmo)] -= rdm_element;
-                        rdm_data[tei_index(s_abs, r_abs, p_abs, q_abs, ncmo)] -= rdm_element;
-                        rdm_data[tei_index(s_abs, r_abs, q_abs, p_abs, ncmo)] += rdm_element;
+                        for (const auto& [index, factor] :
+                             {std::pair{tei_index(p_abs, q_abs, r_abs, s_abs, ncmo), 1.0},
+                              std::pair{tei_index(q_abs, p_abs, r_abs, s_abs, ncmo), -1.0},
+                              std::pair{tei_index(p_abs, q_abs, s_abs, r_abs, ncmo), -1.0},
+                              std::pair{tei_index(q_abs, p_abs, s_abs, r_abs, ncmo), 1.0},
+                              std::pair{tei_index(r_abs, s_abs, p_abs, q_abs, ncmo), 1.0},
+                              std::pair{tei_index(r_abs, s_abs, q_abs, p_abs, ncmo), -1.0},
+                              std::pair{tei_index(s_abs, r_abs, p_abs, q_abs, ncmo), -1.0},
+                              std::pair{tei_index(s_abs, r_abs, q_abs, p_abs, ncmo), 1.0}}) {
+                            add_elements(rdm_data, terms, elements, index, factor);
+                        }
                     }
                 }
             }
         }
     } // End loop over h
-#if 0
-    psi::outfile->Printf("\n TPDM:");
-    for (int p = 0; p < no_; ++p) {
-        for (int q = 0; q <= p; ++q) {
-            for (int r = 0; r < no_; ++r) {
-                for (int s = 0; s <= r; ++s) {
-                    if (std::fabs(rdm[tei_index(p,q,r,s)]) > 1.0e-12){
-                        psi::outfile->Printf("\n  Lambda [%3lu][%3lu][%3lu][%3lu] = %18.12lf", p,q,r,s, rdm[tei_index(p,q,r,s)]);
-
-                    }
-                }
-            }
-        }
-    }
-#endif
-    return rdm;
+    return rdms;
 }
 
-ambit::Tensor FCIVector::compute_2rdm_ab_same_irrep(FCIVector& C_left, FCIVector& C_right) {
-    int nirrep = C_left.nirrep_;
-    size_t ncmo = C_left.ncmo_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& alfa_address = C_left.alfa_address_;
-    const auto& beta_address = C_left.beta_address_;
-    const auto& cmopi = C_left.cmopi_;
-    const auto& cmopi_offset = C_left.cmopi_offset_;
-    const auto& lists = C_left.lists_;
-
-    auto rdm = ambit::Tensor::build(ambit::CoreTensor, "2RDM_AB", {ncmo, ncmo, ncmo, ncmo});
+std::vector<ambit::Tensor>
+FCIVector::compute_2rdm_ab_same_irrep(const std::vector<FCIVector*>& C,
+                                      const std::vector<FCIRDMTerm>& terms, size_t noutputs) {
+    const auto& C0 = *C[0];
+    int nirrep = C0.nirrep_;
+    size_t ncmo = C0.ncmo_;
+    size_t symmetry = C0.symmetry_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const auto& cmopi = C0.cmopi_;
+    const auto& cmopi_offset = C0.cmopi_offset_;
+    const auto& lists = C0.lists_;
+
+    auto rdms = build_rdm_tensors(noutputs, "2RDM_AB", {ncmo, ncmo, ncmo, ncmo});
 
     auto na = alfa_address->nones();
     auto nb = beta_address->nones();
     if ((na < 1) or (nb < 1))
-        return rdm;
+        return rdms;
 
-    auto& rdm_data = rdm.data();
+    auto rdm_data = term_data(rdms, terms);
+    const size_t nterms = terms.size();
+    std::vector<double> elements(nterms);
+    // the blocks of the left and right vector of each term
+    std::vector<double**> Cl(nterms), Cr(nterms);
 
     // Loop over blocks of matrix C
     for (int Ia_sym = 0; Ia_sym < nirrep; ++Ia_sym) {
         int Ib_sym = Ia_sym ^ symmetry;
-        const auto Cr = C_right.C(Ia_sym)->pointer();
+        for (size_t t = 0; t < nterms; ++t) {
+            Cr[t] = C[terms[t].right]->C(Ia_sym)->pointer();
+        }
 
         // Loop over all r,s
         for (int rs_sym = 0; rs_sym < nirrep; ++rs_sym) {
             int Jb_sym = Ib_sym ^ rs_sym;
             int Ja_sym = Jb_sym ^ symmetry;
-            const auto Cl = C_left.C(Ja_sym)->pointer();
+            for (size_t t = 0; t < nterms; ++t) {
+                Cl[t] = C[terms[t].left]->C(Ja_sym)->pointer();
+            }
             for (int r_sym = 0; r_sym < nirrep; ++r_sym) {
                 int s_sym = rs_sym ^ r_sym;
 
@@ -357,15 +388,17 @@ ambit::Tensor FCIVector::compute_2rdm_ab_same_irrep(FCIVector& C_left, FCIVector
                                     const auto& vo_alfa =
                                         lists->get_alfa_vo_list(p_abs, q_abs, Ia_sym);
 
-                                    double rdm_element = 0.0;
+                                    std::fill(elements.begin(), elements.end(), 0.0);
                                     for (const auto& [sign_a, Ia, Ja] : vo_alfa) {
                                         for (const auto& [sign_b, Ib, Jb] : vo_beta) {
-                                            rdm_element +=
-                                                Cl[Ja][Jb] * Cr[Ia][Ib] * sign_a * sign_b;
+                                            const double sign = sign_a * sign_b;
+                                            for (size_t t = 0; t < nterms; ++t) {
+                                                elements[t] += Cl[t][Ja][Jb] * Cr[t][Ia][Ib] * sign;
+                                            }
                                         }
                                     }
-                                    rdm_data[tei_index(p_abs, r_abs, q_abs, s_abs, ncmo)] +=
-                                        rdm_element;
+                                    add_elements(rdm_data, terms, elements,
+                                                 tei_index(p_abs, r_abs, q_abs, s_abs, ncmo), 1.0);
                                 }
                             }
                         } // End loop over p,q
@@ -374,82 +407,80 @@ ambit::Tensor FCIVector::compute_2rdm_ab_same_irrep(FCIVector& C_left, FCIVector
             }
         }
     }
-#if 0
-    psi::outfile->Printf("\n TPDM (ab):");
-    for (int p = 0; p < no_; ++p) {
-        for (int q = 0; q < no_; ++q) {
-            for (int r = 0; r < no_; ++r) {
-                for (int s = 0; s < no_; ++s) {
-                    if (std::fabs(rdm[tei_index(p,q,r,s)]) > 1.0e-12){
-                        psi::outfile->Printf("\n  Lambda [%3lu][%3lu][%3lu][%3lu] = %18.12lf", p,q,r,s, rdm[tei_index(p,q,r,s)]);
-
-                    }
-                }
-            }
-        }
-    }
-#endif
-    return rdm;
+    return rdms;
 }
 
-ambit::Tensor FCIVector::compute_3rdm_aaa_same_irrep(FCIVector& C_left, FCIVector& C_right,
-                                                     bool alfa) {
-    int nirrep = C_left.nirrep_;
-    size_t ncmo = C_left.ncmo_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& alfa_address = C_left.alfa_address_;
-    const auto& beta_address = C_left.beta_address_;
-    const auto& lists = C_left.lists_;
-
-    auto rdm = ambit::Tensor::build(ambit::CoreTensor, alfa ? "3RDM_AAA" : "3RDM_BBB",
-                                    {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
+std::vector<ambit::Tensor>
+FCIVector::compute_3rdm_aaa_same_irrep(const std::vector<FCIVector*>& C,
+                                       const std::vector<FCIRDMTerm>& terms, size_t noutputs,
+                                       bool alfa) {
+    const auto& C0 = *C[0];
+    int nirrep = C0.nirrep_;
+    size_t ncmo = C0.ncmo_;
+    size_t symmetry = C0.symmetry_;
+    const auto& detpi = C0.detpi_;
+    const auto& alfa_address = C0.alfa_address_;
+    const auto& beta_address = C0.beta_address_;
+    const auto& lists = C0.lists_;
+
+    auto rdms = build_rdm_tensors(noutputs, alfa ? "3RDM_AAA" : "3RDM_BBB",
+                                  {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
 
     auto na = alfa_address->nones();
     auto nb = beta_address->nones();
     if ((alfa and (na < 3)) or ((!alfa) and (nb < 3)))
-        return rdm;
-
-    auto& rdm_data = rdm.data();
+        return rdms;
 
-    for (int h_K = 0; h_K < nirrep; ++h_K) {
-        size_t maxK =
-            alfa ? lists->alfa_address_3h()->strpcls(h_K) : lists->beta_address_3h()->strpcls(h_K);
-        for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
-            int h_Ib = h_Ia ^ symmetry;
-            // Get a pointer to the correct block of matrix C
-            auto Cl =
-                gather_C_block(C_left, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
-            auto Cr =
-                gather_C_block(C_right, CR, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
+    auto rdm_data = term_data(rdms, terms);
+    std::vector<double> elements(terms.size());
 
-            size_t maxL = alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia);
-            if (maxL > 0) {
-                for (size_t K = 0; K < maxK; ++K) {
-                    std::vector<H3StringSubstitution>& Klist =
-                        alfa ? lists->get_alfa_3h_list(h_K, K, h_Ia)
-                             : lists->get_beta_3h_list(h_K, K, h_Ib);
-                    for (const auto& [sign_K, p, q, r, I] : Klist) {
-                        for (const auto& [sign_L, s, t, u, J] : Klist) {
-                            rdm_data[six_index(p, q, r, s, t, u, ncmo)] +=
-                                sign_K * sign_L * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
-                        }
+    for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
+        int h_Ib = h_Ia ^ symmetry;
+        if (detpi[h_Ia] == 0)
+            continue;
+        // Gather the blocks of all the vectors (once for all the 3-hole strings)
+        auto m = gather_C_block(C, CL, alfa, alfa_address, beta_address, h_Ia, h_Ib, false);
+
+        size_t maxL = alfa ? beta_address->strpcls(h_Ib) : alfa_address->strpcls(h_Ia);
+        for (int h_K = 0; h_K < nirrep; ++h_K) {
+            size_t maxK = alfa ? lists->alfa_address_3h()->strpcls(h_K)
+                               : lists->beta_address_3h()->strpcls(h_K);
+            for (size_t K = 0; K < maxK; ++K) {
+                const std::vector<H3StringSubstitution>& Klist =
+                    alfa ? lists->get_alfa_3h_list(h_K, K, h_Ia)
+                         : lists->get_beta_3h_list(h_K, K, h_Ib);
+                for (const auto& [sign_K, p, q, r, I] : Klist) {
+                    for (const auto& [sign_L, s, t, u, J] : Klist) {
+                        std::fill(elements.begin(), elements.end(), 0.0);
+                        add_dots(m, maxL, terms, sign_K * sign_L, I, J, elements);
+                        add_elements(rdm_data, terms, elements, six_index(p, q, r, s, t, u, ncmo),
+                                     1.0);
                     }
                 }
             }
         }
     }
-    return rdm;
+    return rdms;
 }
 
-ambit::Tensor FCIVector::compute_3rdm_aab_same_irrep(FCIVector& C_left, FCIVector& C_right) {
-    int nirrep = C_left.nirrep_;
-    size_t ncmo = C_left.ncmo_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& lists = C_left.lists_;
+std::vector<ambit::Tensor>
+FCIVector::compute_3rdm_aab_same_irrep(const std::vector<FCIVector*>& C,
+                                       const std::vector<FCIRDMTerm>& terms, size_t noutputs) {
+    const auto& C0 = *C[0];
+    int nirrep = C0.nirrep_;
+    size_t ncmo = C0.ncmo_;
+    size_t symmetry = C0.symmetry_;
+    const auto& lists = C0.lists_;
+
+    auto rdms = build_rdm_tensors(noutputs, "g2", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
 
-    auto g3 = ambit::Tensor::build(ambit::CoreTensor, "g2", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
-    g3.zero();
-    auto& rdm = g3.data();
+    if ((C0.alfa_address_->nones() < 2) or (C0.beta_address_->nones() < 1))
+        return rdms;
+
+    auto rdm_data = term_data(rdms, terms);
+    const size_t nterms = terms.size();
+    // the blocks of the left and right vector of each term
+    std::vector<double**> C_I_p(nterms), C_J_p(nterms);
 
     for (int h_K = 0; h_K < nirrep; ++h_K) {
         size_t maxK = lists->alfa_address_2h()->strpcls(h_K);
@@ -458,19 +489,23 @@ ambit::Tensor FCIVector::compute_3rdm_aab_same_irrep(FCIVector& C_left, FCIVecto
             // I and J refer to the 2h part of the operator
             for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
                 int h_Mb = h_Ia ^ symmetry;
-                double** C_I_p = C_right.C(h_Ia)->pointer();
+                for (size_t n = 0; n < nterms; ++n) {
+                    C_I_p[n] = C[terms[n].right]->C(h_Ia)->pointer();
+                }
                 for (int h_Ja = 0; h_Ja < nirrep; ++h_Ja) {
                     int h_Nb = h_Ja ^ symmetry;
-                    double** C_J_p = C_left.C(h_Ja)->pointer();
+                    for (size_t n = 0; n < nterms; ++n) {
+                        C_J_p[n] = C[terms[n].left]->C(h_Ja)->pointer();
+                    }
                     for (size_t K = 0; K < maxK; ++K) {
-                        std::vector<H2StringSubstitution>& Ilist =
+                        const std::vector<H2StringSubstitution>& Ilist =
                             lists->get_alfa_2h_list(h_K, K, h_Ia);
-                        std::vector<H2StringSubstitution>& Jlist =
+                        const std::vector<H2StringSubstitution>& Jlist =
                             lists->get_alfa_2h_list(h_K, K, h_Ja);
                         for (size_t L = 0; L < maxL; ++L) {
-                            std::vector<H1StringSubstitution>& Mlist =
+                            const std::vector<H1StringSubstitution>& Mlist =
                                 lists->get_beta_1h_list(h_L, L, h_Mb);
-                            std::vector<H1StringSubstitution>& Nlist =
+                            const std::vector<H1StringSubstitution>& Nlist =
                                 lists->get_beta_1h_list(h_L, L, h_Nb);
                             for (const auto& Iel : Ilist) {
                                 size_t q = Iel.p;
@@ -487,8 +522,12 @@ ambit::Tensor FCIVector::compute_3rdm_aab_same_irrep(FCIVector& C_left, FCIVecto
                                             size_t a = Nel.p;
                                             size_t N = Nel.J;
                                             short sign = Iel.sign * Jel.sign * Mel.sign * Nel.sign;
-                                            rdm[six_index(p, q, r, s, t, a, ncmo)] +=
-                                                sign * C_I_p[I][M] * C_J_p[J][N];
+                                            const size_t index = six_index(p, q, r, s, t, a, ncmo);
+                                            for (size_t n = 0; n < nterms; ++n) {
+                                                rdm_data[n][index] += sign * terms[n].weight *
+                                                                      C_I_p[n][I][M] *
+                                                                      C_J_p[n][J][N];
+                                            }
                                         }
                                     }
                                 }
@@ -499,18 +538,27 @@ ambit::Tensor FCIVector::compute_3rdm_aab_same_irrep(FCIVector& C_left, FCIVecto
             }
         }
     }
-    return g3;
+    return rdms;
 }
 
-ambit::Tensor FCIVector::compute_3rdm_abb_same_irrep(FCIVector& C_left, FCIVector& C_right) {
-    int nirrep = C_left.nirrep_;
-    size_t ncmo = C_left.ncmo_;
-    size_t symmetry = C_left.symmetry_;
-    const auto& lists = C_left.lists_;
+std::vector<ambit::Tensor>
+FCIVector::compute_3rdm_abb_same_irrep(const std::vector<FCIVector*>& C,
+                                       const std::vector<FCIRDMTerm>& terms, size_t noutputs) {
+    const auto& C0 = *C[0];
+    int nirrep = C0.nirrep_;
+    size_t ncmo = C0.ncmo_;
+    size_t symmetry = C0.symmetry_;
+    const auto& lists = C0.lists_;
+
+    auto rdms = build_rdm_tensors(noutputs, "g2", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
+
+    if ((C0.alfa_address_->nones() < 1) or (C0.beta_address_->nones() < 2))
+        return rdms;
 
-    auto g3 = ambit::Tensor::build(ambit::CoreTensor, "g2", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
-    g3.zero();
-    auto& rdm = g3.data();
+    auto rdm_data = term_data(rdms, terms);
+    const size_t nterms = terms.size();
+    // the blocks of the left and right vector of each term
+    std::vector<double**> C_I_p(nterms), C_J_p(nterms);
 
     for (int h_K = 0; h_K < nirrep; ++h_K) {
         size_t maxK = lists->alfa_address_1h()->strpcls(h_K);
@@ -519,19 +567,23 @@ ambit::Tensor FCIVector::compute_3rdm_abb_same_irrep(FCIVector& C_left, FCIVecto
             // I and J refer to the 1h part of the operator
             for (int h_Ia = 0; h_Ia < nirrep; ++h_Ia) {
                 int h_Mb = h_Ia ^ symmetry;
-                double** C_I_p = C_right.C(h_Ia)->pointer();
+                for (size_t n = 0; n < nterms; ++n) {
+                    C_I_p[n] = C[terms[n].right]->C(h_Ia)->pointer();
+                }
                 for (int h_Ja = 0; h_Ja < nirrep; ++h_Ja) {
                     int h_Nb = h_Ja ^ symmetry;
-                    double** C_J_p = C_left.C(h_Ja)->pointer();
+                    for (size_t n = 0; n < nterms; ++n) {
+                        C_J_p[n] = C[terms[n].left]->C(h_Ja)->pointer();
+                    }
                     for (size_t K = 0; K < maxK; ++K) {
-                        std::vector<H1StringSubstitution>& Ilist =
+                        const std::vector<H1StringSubstitution>& Ilist =
                             lists->get_alfa_1h_list(h_K, K, h_Ia);
-                        std::vector<H1StringSubstitution>& Jlist =
+                        const std::vector<H1StringSubstitution>& Jlist =
                             lists->get_alfa_1h_list(h_K, K, h_Ja);
                         for (size_t L = 0; L < maxL; ++L) {
-                            std::vector<H2StringSubstitution>& Mlist =
+                            const std::vector<H2StringSubstitution>& Mlist =
                                 lists->get_beta_2h_list(h_L, L, h_Mb);
-                            std::vector<H2StringSubstitution>& Nlist =
+                            const std::vector<H2StringSubstitution>& Nlist =
                                 lists->get_beta_2h_list(h_L, L, h_Nb);
                             for (size_t Iel = 0; Iel < Ilist.size(); Iel++) {
                                 size_t p = Ilist[Iel].p;
@@ -549,8 +601,12 @@ ambit::Tensor FCIVector::compute_3rdm_abb_same_irrep(FCIVector& C_left, FCIVecto
                                             size_t N = Nel.J;
                                             short sign =
                                                 Ilist[Iel].sign * Jel.sign * Mel.sign * Nel.sign;
-                                            rdm[six_index(p, q, r, s, t, a, ncmo)] +=
-                                                sign * C_I_p[I][M] * C_J_p[J][N];
+                                            const size_t index = six_index(p, q, r, s, t, a, ncmo);
+                                            for (size_t n = 0; n < nterms; ++n) {
+                                                rdm_data[n][index] += sign * terms[n].weight *
+                                                                      C_I_p[n][I][M] *
+                                                                      C_J_p[n][J][N];
+                                            }
                                         }
                                     }
                                 }
@@ -561,7 +617,7 @@ ambit::Tensor FCIVector::compute_3rdm_abb_same_irrep(FCIVector& C_left, FCIVecto
             }
         }
     }
-    return g3;
+    return rdms;
 }
 
 void FCIVector::test_rdms(FCIVector& Cl, FCIVector& Cr, int max_rdm_level, RDMsType type,
@@ -58,6 +58,10 @@ std::shared_ptr<RDMs> compute_transition_rdms(FCIVector& C_left, FCIVector& C_ri
             "two wave functions.");
     }
 
+    // the scratch is thread local, so it may not have been allocated on this thread
+    FCIVector::allocate_temp_space(C_left.lists(), PrintLevel::Quiet);
+    FCIVector::allocate_temp_space(C_right.lists(), PrintLevel::Quiet);
+
     ambit::Tensor g1a, g1b;
 
     if (max_rdm_level >= 1) {
@@ -111,6 +111,18 @@ using H2List = std::map<std::tuple<int, size_t, int>, std::vector<H2StringSubsti
 /// string I belongs to the irrep h_I and J belongs to the irrep h_J and add_J is the address of J
 using H3List = std::map<std::tuple<int, size_t, int>, std::vector<H3StringSubstitution>>;
 
+/// @brief Return the list stored in a map under a given key or an empty list if the key is absent.
+/// Unlike std::map::operator[] this function never inserts elements, so it can be called
+/// concurrently by multiple threads.
+template <typename ListMap>
+const typename ListMap::mapped_type& find_string_list(const ListMap& list_map,
+                                                      const typename ListMap::key_type& key) {
+    static const typename ListMap::mapped_type empty_list;
+    if (auto it = list_map.find(key); it != list_map.end())
+        return it->second;
+    return empty_list;
+}
+
 using Pair = std::pair<int, int>;
 using PairList = std::vector<std::vector<std::pair<int, int>>>;
 
@@ -0,0 +1,120 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+
+#include "fci/string_lists_io.h"
+
+namespace forte {
+
+namespace {
+/// The first bytes of a string lists file. Change the last character when the format changes
+constexpr char string_lists_magic[8] = {'F', 'O', 'R', 'T', 'E', 'S', 'L', '2'};
+} // namespace
+
+StringListsWriter::StringListsWriter(const std::string& signature) : signature_(signature) {}
+
+void StringListsWriter::put_sign(double sign) {
+    if (sign != 1.0 and sign != -1.0) {
+        throw std::runtime_error("StringListsWriter: found a substitution with a sign other than "
+                                 "+1 or -1");
+    }
+    put<int8_t>(sign > 0.0 ? 1 : -1);
+}
+
+void StringListsWriter::put_substitution(const StringSubstitution& s) {
+    put_sign(s.sign);
+    put(s.I);
+    put(s.J);
+}
+
+void StringListsWriter::put_substitution(const H1StringSubstitution& s) {
+    put_sign(s.sign);
+    put(s.p);
+    put<uint64_t>(s.J);
+}
+
+void StringListsWriter::put_substitution(const H2StringSubstitution& s) {
+    put_sign(s.sign);
+    put(s.p);
+    put(s.q);
+    put<uint64_t>(s.J);
+}
+
+void StringListsWriter::put_substitution(const H3StringSubstitution& s) {
+    put_sign(s.sign);
+    put(s.p);
+    put(s.q);
+    put(s.r);
+    put<uint64_t>(s.J);
+}
+
+void StringListsWriter::save(const std::string& filename) const {
+    CacheFileWriter file(filename, string_lists_magic, signature_);
+    file.write(data_.data(), data_.size());
+    file.commit();
+}
+
+StringListsReader::StringListsReader(const std::string& filename, const std::string& signature)
+    : file_(filename, string_lists_magic, signature) {}
+
+void StringListsReader::get_substitution(std::vector<StringSubstitution>& v) {
+    const double sign = get<int8_t>();
+    const auto I = get<uint32_t>();
+    const auto J = get<uint32_t>();
+    v.emplace_back(sign, I, J);
+}
+
+void StringListsReader::get_substitution(std::vector<H1StringSubstitution>& v) {
+    const auto sign = get<int8_t>();
+    const auto p = get<int16_t>();
+    const auto J = get<uint64_t>();
+    v.emplace_back(sign, p, J);
+}
+
+void StringListsReader::get_substitution(std::vector<H2StringSubstitution>& v) {
+    const auto sign = get<int8_t>();
+    const auto p = get<int16_t>();
+    const auto q = get<int16_t>();
+    const auto J = get<uint64_t>();
+    v.emplace_back(sign, p, q, J);
+}
+
+void StringListsReader::get_substitution(std::vector<H3StringSubstitution>& v) {
+    const auto sign = get<int8_t>();
+    const auto p = get<int16_t>();
+    const auto q = get<int16_t>();
+    const auto r = get<int16_t>();
+    const auto J = get<uint64_t>();
+    v.emplace_back(sign, p, q, r, J);
+}
+
+std::string string_lists_filename(const std::string& directory, const std::string& signature) {
+    return cache_filename(directory, "string_lists", signature);
+}
+
+} // namespace forte
@@ -0,0 +1,203 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "helpers/cache_file.h"
+#include "sparse_ci/determinant.h"
+#include "fci/string_list_defs.h"
+
+namespace forte {
+
+/// @brief Serialize string lists to a compact binary file
+///
+/// The lists are appended one after the other with write() and stored with save(). The file (see
+/// CacheFileWriter) starts with a header that contains a signature of the active space, which is
+/// checked when the file is read back with StringListsReader. Map keys are stored as 64-bit
+/// integers and the substitutions are stored field by field, with the signs packed in one byte.
+class StringListsWriter {
+  public:
+    /// @param signature a string that uniquely identifies the active space used to build the lists
+    explicit StringListsWriter(const std::string& signature);
+
+    /// Append a list (a map of vectors of substitutions or a map of such maps)
+    template <class ListMap> void write(const ListMap& list) {
+        put<uint64_t>(list.size());
+        for (const auto& [key, value] : list) {
+            put_key(key);
+            if constexpr (is_std_map<std::decay_t<decltype(value)>>::value) {
+                write(value);
+            } else {
+                put<uint64_t>(value.size());
+                for (const auto& s : value)
+                    put_substitution(s);
+            }
+        }
+    }
+
+    /// Save the lists to a file. The data is first written to a temporary file that is then
+    /// renamed, so that other processes never see a partially written file
+    void save(const std::string& filename) const;
+
+  private:
+    template <class T> struct is_std_map : std::false_type {};
+    template <class K, class V, class C, class A>
+    struct is_std_map<std::map<K, V, C, A>> : std::true_type {};
+
+    template <class T> void put(T x) {
+        const auto* bytes = reinterpret_cast<const char*>(&x);
+        data_.insert(data_.end(), bytes, bytes + sizeof(T));
+    }
+    template <class Key> void put_key(const Key& key) {
+        if constexpr (std::is_integral_v<Key>) {
+            put<int64_t>(key);
+        } else {
+            std::apply([this](const auto&... k) { (put<int64_t>(k), ...); }, key);
+        }
+    }
+    void put_sign(double sign);
+    void put_substitution(uint32_t I) { put(I); }
+    void put_substitution(const StringSubstitution& s);
+    void put_substitution(const H1StringSubstitution& s);
+    void put_substitution(const H2StringSubstitution& s);
+    void put_substitution(const H3StringSubstitution& s);
+
+    std::string signature_;
+    std::vector<char> data_;
+};
+
+/// @brief Read string lists from a file written by StringListsWriter
+///
+/// The file is memory-mapped and the lists are rebuilt with sequential reads in the same order in
+/// which they were written. Since the maps are stored in order, the elements are inserted with
+/// hints in constant time.
+class StringListsReader {
+  public:
+    /// Map a file. If the file does not exist or was written for a different signature (or with a
+    /// different format) valid() returns false
+    StringListsReader(const std::string& filename, const std::string& signature);
+
+    /// @return true if the file was mapped and its header matches the signature
+    bool valid() const { return file_.valid(); }
+
+    /// @return true if all the data in the file was read
+    bool at_end() const { return file_.at_end(); }
+
+    /// Read a list. Throws std::runtime_error if the file is truncated
+    template <class ListMap> void read(ListMap& list) {
+        list.clear();
+        const auto n = get<uint64_t>();
+        for (uint64_t i = 0; i < n; ++i) {
+            auto key = get_key<typename ListMap::key_type>();
+            auto it = list.emplace_hint(list.end(), std::move(key),
+                                        typename ListMap::mapped_type());
+            if constexpr (is_std_map<typename ListMap::mapped_type>::value) {
+                read(it->second);
+            } else {
+                auto& v = it->second;
+                const auto nsubs = get<uint64_t>();
+                file_.check(nsubs);
+                v.reserve(nsubs);
+                for (uint64_t k = 0; k < nsubs; ++k)
+                    get_substitution(v);
+            }
+        }
+    }
+
+  private:
+    template <class T> struct is_std_map : std::false_type {};
+    template <class K, class V, class C, class A>
+    struct is_std_map<std::map<K, V, C, A>> : std::true_type {};
+
+    template <class T> T get() { return file_.get<T>(); }
+    template <class Key> Key get_key() {
+        if constexpr (std::is_integral_v<Key>) {
+            return static_cast<Key>(get<int64_t>());
+        } else {
+            Key key;
+            std::apply(
+                [this](auto&... k) {
+                    ((k = static_cast<std::remove_reference_t<decltype(k)>>(get<int64_t>())),
+                     ...);
+                },
+                key);
+            return key;
+        }
+    }
+    void get_substitution(std::vector<uint32_t>& v) { v.push_back(get<uint32_t>()); }
+    void get_substitution(std::vector<StringSubstitution>& v);
+    void get_substitution(std::vector<H1StringSubstitution>& v);
+    void get_substitution(std::vector<H2StringSubstitution>& v);
+    void get_substitution(std::vector<H3StringSubstitution>& v);
+
+    CacheFileReader file_;
+};
+
+/// @brief Write a set of string lists to a file, in the order in which they are passed.
+///        Throws std::runtime_error if the file cannot be written
+/// @param filename the name of the file
+/// @param signature a string that uniquely identifies the active space used to build the lists
+template <class... Lists>
+void write_string_lists(const std::string& filename, const std::string& signature,
+                        const Lists&... lists) {
+    StringListsWriter writer(signature);
+    (writer.write(lists), ...);
+    writer.save(filename);
+}
+
+/// @brief Read a set of string lists written by write_string_lists, in the same order.
+///        Throws std::runtime_error if the file is truncated or contains more data than the lists
+/// @return false if the file does not exist or was written for a different signature
+template <class... Lists>
+bool read_string_lists(const std::string& filename, const std::string& signature,
+                       Lists&... lists) {
+    StringListsReader reader(filename, signature);
+    if (not reader.valid())
+        return false;
+    (reader.read(lists), ...);
+    if (not reader.at_end())
+        throw std::runtime_error("StringListsReader: unexpected data at the end of the file");
+    return true;
+}
+
+/// @brief Return the name of the file used to cache string lists
+/// @param directory the directory where the file is stored
+/// @param signature a string that uniquely identifies the active space used to build the lists
+std::string string_lists_filename(const std::string& directory, const std::string& signature);
+
+} // namespace forte
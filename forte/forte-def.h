@@ -35,4 +35,7 @@
 #define omp_get_max_threads() 1
 #define omp_get_thread_num() 0
 #define omp_get_num_threads() 1
+#define omp_set_num_threads(n)
+#define omp_get_max_active_levels() 1
+#define omp_set_max_active_levels(n)
 #endif
@@ -433,4 +433,54 @@ std::string occupation_table(size_t num_spaces,
     return s;
 }
 
+std::vector<std::vector<size_t>> count_strings_by_symmetry(const std::vector<int>& mo_sym,
+                                                           int nirrep) {
+    const size_t norb = mo_sym.size();
+    std::vector<std::vector<size_t>> counts(norb + 1, std::vector<size_t>(nirrep, 0));
+    counts[0][0] = 1;
+    // add one orbital at a time, going down in n so that each orbital is occupied at most once
+    for (size_t k = 0; k < norb; ++k) {
+        for (size_t n = k + 1; n > 0; --n) {
+            for (int h = 0; h < nirrep; ++h) {
+                counts[n][h ^ mo_sym[k]] += counts[n - 1][h];
+            }
+        }
+    }
+    return counts;
+}
+
+size_t count_determinants(const std::vector<std::vector<int>>& gas_mo_sym, int nirrep,
+                          int symmetry, const std::vector<std::array<int, 6>>& alfa_occupation,
+                          const std::vector<std::array<int, 6>>& beta_occupation,
+                          const std::vector<std::pair<size_t, size_t>>& occupation_pairs) {
+    std::vector<std::vector<std::vector<size_t>>> gas_counts;
+    for (const auto& mo_sym : gas_mo_sym) {
+        gas_counts.push_back(count_strings_by_symmetry(mo_sym, nirrep));
+    }
+    // the number of strings per irrep with a given occupation of the GAS spaces
+    auto strings_per_irrep = [&](const std::array<int, 6>& occ) {
+        std::vector<size_t> total(nirrep, 0);
+        total[0] = 1;
+        for (size_t g = 0; g < gas_counts.size(); ++g) {
+            std::vector<size_t> next(nirrep, 0);
+            for (int h = 0; h < nirrep; ++h) {
+                for (int hg = 0; hg < nirrep; ++hg) {
+                    next[h ^ hg] += total[h] * gas_counts[g][occ[g]][hg];
+                }
+            }
+            total = std::move(next);
+        }
+        return total;
+    };
+    size_t ndets = 0;
+    for (const auto& [aocc_idx, bocc_idx] : occupation_pairs) {
+        const auto alfa = strings_per_irrep(alfa_occupation[aocc_idx]);
+        const auto beta = strings_per_irrep(beta_occupation[bocc_idx]);
+        for (int h = 0; h < nirrep; ++h) {
+            ndets += alfa[h] * beta[h ^ symmetry];
+        }
+    }
+    return ndets;
+}
+
 } // namespace forte
@@ -61,4 +61,24 @@ std::string occupation_table(size_t num_spaces,
                              const std::vector<std::array<int, 6>>& beta_occupation,
                              const std::vector<std::pair<size_t, size_t>>& occupation_pairs);
 
+/// @brief Count the strings that can be formed with a set of orbitals
+/// @param mo_sym the irrep of each orbital
+/// @param nirrep the number of irreps
+/// @return a matrix c such that c[n][h] is the number of strings with n electrons and symmetry h
+std::vector<std::vector<size_t>> count_strings_by_symmetry(const std::vector<int>& mo_sym,
+                                                           int nirrep);
+
+/// @brief Count the determinants with a given symmetry and GAS occupations without forming the
+/// strings
+/// @param gas_mo_sym the irrep of each orbital of each GAS space
+/// @param nirrep the number of irreps
+/// @param symmetry the symmetry of the determinants
+/// @param alfa_occupation the alpha occupations of the GAS spaces
+/// @param beta_occupation the beta occupations of the GAS spaces
+/// @param occupation_pairs the pairs of alpha and beta occupations allowed
+size_t count_determinants(const std::vector<std::vector<int>>& gas_mo_sym, int nirrep,
+                          int symmetry, const std::vector<std::array<int, 6>>& alfa_occupation,
+                          const std::vector<std::array<int, 6>>& beta_occupation,
+                          const std::vector<std::pair<size_t, size_t>>& occupation_pairs);
+
 } // namespace forte
\ No newline at end of file
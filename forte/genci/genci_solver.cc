@@ -29,11 +29,13 @@
 #include <numeric>
 
 #include "psi4/libpsi4util/process.h"
+#include "psi4/libpsio/psio.hpp"
 
 #include "integrals/active_space_integrals.h"
 #include "sparse_ci/ci_spin_adaptation.h"
 #include "helpers/davidson_liu_solver.h"
 
+#include "ci_occupation.h"
 #include "genci_solver.h"
 #include "genci_string_lists.h"
 #include "helpers/printing.h"
@@ -82,6 +84,10 @@ void GenCISolver::set_test_rdms(bool value) { test_rdms_ = value; }
 
 void GenCISolver::set_print_no(bool value) { print_no_ = value; }
 
+void GenCISolver::set_string_lists_cache_directory(const std::string& directory) {
+    string_lists_cache_directory_ = directory;
+}
+
 void GenCISolver::copy_state_into_fci_vector(int root, std::shared_ptr<GenCIVector> C) {
     // grab a row of the eigenvector matrix and put it into the GenCIVector
     std::shared_ptr<psi::Vector> psi_vector;
@@ -101,6 +107,21 @@ std::shared_ptr<GenCIStringLists> GenCISolver::lists() { return lists_; }
 
 int GenCISolver::symmetry() { return symmetry_; }
 
+size_t GenCISolver::space_size() {
+    std::vector<int> gas_size;
+    std::vector<std::vector<int>> gas_mo_sym;
+    for (const auto& space : mo_space_info_->composite_space_names()["ACTIVE"]) {
+        gas_size.push_back(mo_space_info_->size(space));
+        gas_mo_sym.push_back(mo_space_info_->symmetry(space));
+    }
+    std::vector<int> gas_min(state_.gas_min().begin(), state_.gas_min().end());
+    std::vector<int> gas_max(state_.gas_max().begin(), state_.gas_max().end());
+    const auto [ngas, alfa_occupation, beta_occupation, occupation_pairs] =
+        get_ci_occupation_patterns(na_, nb_, gas_min, gas_max, gas_size);
+    return count_determinants(gas_mo_sym, nirrep_, symmetry_, alfa_occupation, beta_occupation,
+                              occupation_pairs);
+}
+
 void GenCISolver::startup() {
     // Create the string lists
 
@@ -119,7 +140,7 @@ void GenCISolver::startup() {
         gas_max.push_back(n);
     }
     lists_ = std::make_shared<GenCIStringLists>(mo_space_info_, na_, nb_, symmetry_, print_,
-                                                gas_min, gas_max);
+                                                gas_min, gas_max, string_lists_cache_directory_);
 
     nfci_dets_ = 0;
     for (const auto& [_, class_Ia, class_Ib] : lists_->determinant_classes()) {
@@ -157,6 +178,13 @@ void GenCISolver::set_options(std::shared_ptr<ForteOptions> options) {
     set_spin_adapt(options->get_bool("CI_SPIN_ADAPT"));
     set_spin_adapt_full_preconditioner(options->get_bool("CI_SPIN_ADAPT_FULL_PRECONDITIONER"));
     set_test_rdms(options->get_bool("FCI_TEST_RDMS"));
+    if (options->get_bool("CI_STRING_LISTS_CACHE")) {
+        auto directory = options->get_str("CI_STRING_LISTS_CACHE_DIR");
+        if (directory.empty()) {
+            directory = psi::PSIOManager::shared_object()->get_default_path();
+        }
+        set_string_lists_cache_directory(directory);
+    }
 
     set_root(options->get_int("ROOT"));
 
@@ -234,34 +262,57 @@ double GenCISolver::compute_energy() {
         }
     }
 
-    // Print the initial guess
-    auto sigma_builder = [this, &b_basis, &b, &sigma, &sigma_basis](std::span<double> b_span,
-                                                                    std::span<double> sigma_span) {
-        // copy the b vector
-        size_t basis_size = b_span.size();
-        for (size_t I = 0; I < basis_size; ++I) {
-            b_basis->set(I, b_span[I]);
+    // The vectors used to compute a block of sigma vectors. C_ and T_ are the first elements
+    std::vector<std::shared_ptr<GenCIVector>> C_block{C_};
+    std::vector<std::shared_ptr<GenCIVector>> T_block{T_};
+
+    // Compute a block of sigma vectors with a single pass over the string lists
+    auto block_sigma_builder = [this, &C_block, &T_block, &b_basis, &b, &sigma, &sigma_basis](
+                                   std::span<double> b_span, std::span<double> sigma_span,
+                                   size_t nvec) {
+        while (C_block.size() < nvec) {
+            C_block.push_back(std::make_shared<GenCIVector>(lists_));
+            T_block.push_back(std::make_shared<GenCIVector>(lists_));
         }
-        if (spin_adapt_) {
-            // Compute sigma in the CSF basis and convert it to the determinant basis
-            spin_adapter_->csf_C_to_det_C(b_basis, b);
-            C_->copy(b);
-            C_->Hamiltonian(*T_, as_ints_);
-            T_->copy_to(sigma);
-            spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
-        } else {
-            // Compute sigma in the determinant basis
-            C_->copy(b_basis);
-            C_->Hamiltonian(*T_, as_ints_);
-            T_->copy_to(sigma_basis);
+        size_t basis_size = b_span.size() / nvec;
+
+        // copy the b vectors
+        for (size_t n = 0; n < nvec; ++n) {
+            for (size_t I = 0; I < basis_size; ++I) {
+                b_basis->set(I, b_span[n * basis_size + I]);
+            }
+            if (spin_adapt_) {
+                spin_adapter_->csf_C_to_det_C(b_basis, b);
+                C_block[n]->copy(b);
+            } else {
+                C_block[n]->copy(b_basis);
+            }
         }
-        for (size_t I = 0; I < basis_size; ++I) {
-            sigma_span[I] = sigma_basis->get(I);
+
+        std::vector<GenCIVector*> C_ptrs(nvec);
+        std::vector<GenCIVector*> T_ptrs(nvec);
+        for (size_t n = 0; n < nvec; ++n) {
+            C_ptrs[n] = C_block[n].get();
+            T_ptrs[n] = T_block[n].get();
+        }
+        GenCIVector::Hamiltonian_block(C_ptrs, T_ptrs, as_ints_);
+
+        // copy the sigma vectors, optionally converting them to the CSF basis
+        for (size_t n = 0; n < nvec; ++n) {
+            if (spin_adapt_) {
+                T_block[n]->copy_to(sigma);
+                spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
+            } else {
+                T_block[n]->copy_to(sigma_basis);
+            }
+            for (size_t I = 0; I < basis_size; ++I) {
+                sigma_span[n * basis_size + I] = sigma_basis->get(I);
+            }
         }
     };
 
     // Run the Davidson-Liu solver
-    dl_solver_->add_sigma_builder(sigma_builder);
+    dl_solver_->add_block_sigma_builder(block_sigma_builder);
 
     auto converged = dl_solver_->solve();
     if (not converged) {
@@ -306,10 +357,15 @@ double GenCISolver::compute_energy() {
     }
 
     energy_ = dl_solver_->eigenvalues()->get(root_);
-    psi::Process::environment.globals["CURRENT ENERGY"] = energy_;
-    psi::Process::environment.globals["CI ENERGY"] = energy_;
+    // solvers of different states may run concurrently (see ActiveSpaceSolver)
+#pragma omp critical(psi4_globals)
+    {
+        psi::Process::environment.globals["CURRENT ENERGY"] = energy_;
+        psi::Process::environment.globals["CI ENERGY"] = energy_;
+    }
 
-    // GenCIVector::release_temp_space();
+    // free the scratch of the threads used by the sigma build
+    GenCIVector::release_thread_temp_space();
     return energy_;
 }
 
@@ -69,6 +69,9 @@ class GenCISolver : public ActiveSpaceMethod {
     /// Compute the FCI energy
     double compute_energy() override;
 
+    /// Returns the number of determinants. This does not require the string lists
+    size_t space_size() override;
+
     /// Returns the reduced density matrices up to a given rank (max_rdm_level)
     std::vector<std::shared_ptr<RDMs>> rdms(const std::vector<std::pair<size_t, size_t>>& root_list,
                                             int max_rdm_level, RDMsType type) override;
@@ -111,6 +114,9 @@ class GenCISolver : public ActiveSpaceMethod {
     /// Print the Natural Orbitals
     void set_print_no(bool value);
 
+    /// Cache the string lists in a directory (an empty string disables the cache)
+    void set_string_lists_cache_directory(const std::string& directory);
+
     /// Return eigen vectors (n_DL_guesses x ndets)
     std::shared_ptr<psi::Matrix> evecs();
 
@@ -178,6 +184,8 @@ class GenCISolver : public ActiveSpaceMethod {
     bool test_rdms_ = false;
     /// Print the NO from the 1-RDM
     bool print_no_ = false;
+    /// The directory where the string lists are cached (empty if caching is disabled)
+    std::string string_lists_cache_directory_;
     /// Spin adapt the FCI wave function?
     bool spin_adapt_ = false;
     /// Use the full preconditioner for spin adaptation?
@@ -26,6 +26,8 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+
 #include "genci_string_address.h"
 
 #include "base_classes/mo_space_info.h"
@@ -78,6 +80,10 @@ int StringAddress::nclasses() const { return nclasses_; }
 
 size_t StringAddress::strpcls(int h) const { return strpcls_[h]; }
 
+size_t StringAddress::max_strpcls() const {
+    return strpcls_.empty() ? 0 : *std::max_element(strpcls_.begin(), strpcls_.end());
+}
+
 StringClass::StringClass(size_t symmetry, const std::vector<int>& mopi,
                          const std::vector<std::vector<size_t>>& gas_mos,
                          const std::vector<std::array<int, 6>>& alfa_occupation,
@@ -70,6 +70,8 @@ class StringAddress {
     int nclasses() const;
     /// @brief Return the number of strings in a given class
     size_t strpcls(int h) const;
+    /// @brief Return the largest number of strings in a class
+    size_t max_strpcls() const;
     /// @brief Return the number of bits in the string
     int nbits() const;
     /// @brief Return the number of 1s in the string
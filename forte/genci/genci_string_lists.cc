@@ -40,6 +40,7 @@
 #include "genci_string_address.h"
 #include "ci_occupation.h"
 #include "string_lists_makers.h"
+#include "fci/string_lists_io.h"
 
 #include "genci_string_lists.h"
 
@@ -59,9 +60,11 @@ template <typename Func> void debug(Func func) {
 
 GenCIStringLists::GenCIStringLists(std::shared_ptr<MOSpaceInfo> mo_space_info, size_t na, size_t nb,
                                    int symmetry, PrintLevel print, const std::vector<int> gas_min,
-                                   const std::vector<int> gas_max)
+                                   const std::vector<int> gas_max,
+                                   const std::string& cache_directory)
     : symmetry_(symmetry), nirrep_(mo_space_info->nirrep()), ncmo_(mo_space_info->size("ACTIVE")),
-      na_(na), nb_(nb), print_(print), gas_min_(gas_min), gas_max_(gas_max) {
+      na_(na), nb_(nb), print_(print), cache_directory_(cache_directory), gas_min_(gas_min),
+      gas_max_(gas_max) {
     startup(mo_space_info);
 }
 
@@ -212,47 +215,65 @@ void GenCIStringLists::startup(std::shared_ptr<MOSpaceInfo> mo_space_info) {
         pair_list_ = make_pair_list(nirrep_, cmopi_, cmopi_offset_);
         nn_list_timer += t.get();
     }
-    {
-        local_timer t;
-        alfa_vo_list = make_vo_list(alfa_strings_, alfa_address_, alfa_address_);
-        beta_vo_list = make_vo_list(beta_strings_, beta_address_, beta_address_);
-        vo_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        alfa_oo_list = make_oo_list(alfa_strings_, alfa_address_);
-        beta_oo_list = make_oo_list(beta_strings_, beta_address_);
-        oo_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        alfa_vvoo_list =
-            make_vvoo_list(alfa_strings_, alfa_address_, nirrep_, cmopi_, cmopi_offset_);
-        beta_vvoo_list =
-            make_vvoo_list(beta_strings_, beta_address_, nirrep_, cmopi_, cmopi_offset_);
-        vvoo_list_timer += t.get();
-    }
-    {
+    // read the lists from the cache if possible, otherwise build them
+    std::string cache_file;
+    bool lists_read = false;
+    double cache_timer = 0.0;
+    if (not cache_directory_.empty()) {
         local_timer t;
-        alfa_1h_list = make_1h_list(alfa_strings_, alfa_address_, alfa_address_1h_);
-        beta_1h_list = make_1h_list(beta_strings_, beta_address_, beta_address_1h_);
-        h1_list_timer += t.get();
+        cache_file = string_lists_filename(cache_directory_, signature());
+        lists_read = read_lists(cache_file);
+        cache_timer += t.get();
     }
-    {
-        local_timer t;
-        alfa_2h_list = make_2h_list(alfa_strings_, alfa_address_, alfa_address_2h_);
-        beta_2h_list = make_2h_list(beta_strings_, beta_address_, beta_address_2h_);
-        h2_list_timer += t.get();
-    }
-    {
-        local_timer t;
-        alfa_3h_list = make_3h_list(alfa_strings_, alfa_address_, alfa_address_3h_);
-        beta_3h_list = make_3h_list(beta_strings_, beta_address_, beta_address_3h_);
-        h3_list_timer += t.get();
+
+    if (not lists_read) {
+        {
+            local_timer t;
+            alfa_vo_list = make_vo_list(alfa_strings_, alfa_address_, alfa_address_);
+            beta_vo_list = make_vo_list(beta_strings_, beta_address_, beta_address_);
+            vo_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            alfa_oo_list = make_oo_list(alfa_strings_, alfa_address_);
+            beta_oo_list = make_oo_list(beta_strings_, beta_address_);
+            oo_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            alfa_vvoo_list =
+                make_vvoo_list(alfa_strings_, alfa_address_, nirrep_, cmopi_, cmopi_offset_);
+            beta_vvoo_list =
+                make_vvoo_list(beta_strings_, beta_address_, nirrep_, cmopi_, cmopi_offset_);
+            vvoo_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            alfa_1h_list = make_1h_list(alfa_strings_, alfa_address_, alfa_address_1h_);
+            beta_1h_list = make_1h_list(beta_strings_, beta_address_, beta_address_1h_);
+            h1_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            alfa_2h_list = make_2h_list(alfa_strings_, alfa_address_, alfa_address_2h_);
+            beta_2h_list = make_2h_list(beta_strings_, beta_address_, beta_address_2h_);
+            h2_list_timer += t.get();
+        }
+        {
+            local_timer t;
+            alfa_3h_list = make_3h_list(alfa_strings_, alfa_address_, alfa_address_3h_);
+            beta_3h_list = make_3h_list(beta_strings_, beta_address_, beta_address_3h_);
+            h3_list_timer += t.get();
+        }
+        if (not cache_file.empty()) {
+            local_timer t;
+            write_lists(cache_file);
+            cache_timer += t.get();
+        }
     }
 
     double total_time = str_list_timer + nn_list_timer + vo_list_timer + oo_list_timer +
-                        vvoo_list_timer + vovo_list_timer;
+                        vvoo_list_timer + vovo_list_timer + cache_timer;
 
     if (print_ >= PrintLevel::Default) {
         table_printer printer;
@@ -269,10 +290,60 @@ void GenCIStringLists::startup(std::shared_ptr<MOSpaceInfo> mo_space_info) {
                                      {"timing for 1-hole strings", h1_list_timer},
                                      {"timing for 2-hole strings", h2_list_timer},
                                      {"timing for 3-hole strings", h3_list_timer},
+                                     {"timing for the cache", cache_timer},
                                      {"total timing", total_time}});
         }
         std::string table = printer.get_table("String Lists");
         outfile->Printf("%s", table.c_str());
+        if (lists_read) {
+            outfile->Printf("\n  String lists read from %s\n", cache_file.c_str());
+        }
+    }
+}
+
+std::string GenCIStringLists::signature() const {
+    auto to_string = [](const auto& v) {
+        std::string s;
+        for (const auto& x : v)
+            s += std::to_string(x) + ",";
+        return s;
+    };
+    std::string s = "GenCIStringLists na=" + std::to_string(na_) + " nb=" + std::to_string(nb_) +
+                    " symmetry=" + std::to_string(symmetry_) +
+                    " nbits=" + std::to_string(String::nbits) + " cmopi=";
+    for (size_t h = 0; h < nirrep_; ++h) {
+        s += std::to_string(cmopi_[h]) + ",";
+    }
+    s += " gas_size=" + to_string(gas_size_) + " gas_min=" + to_string(gas_min_) +
+         " gas_max=" + to_string(gas_max_) + " gas_mos=";
+    for (const auto& mos : gas_mos_) {
+        s += to_string(mos) + ";";
+    }
+    return s;
+}
+
+bool GenCIStringLists::read_lists(const std::string& filename) {
+    try {
+        return read_string_lists(filename, signature(), alfa_vo_list, beta_vo_list, alfa_oo_list,
+                                 beta_oo_list, alfa_vvoo_list, beta_vvoo_list, alfa_1h_list,
+                                 beta_1h_list, alfa_2h_list, beta_2h_list, alfa_3h_list,
+                                 beta_3h_list);
+    } catch (const std::runtime_error& e) {
+        // a damaged file is not fatal, the lists are rebuilt and the file is overwritten
+        outfile->Printf("\n  Warning: %s (%s). The string lists will be rebuilt.\n", e.what(),
+                        filename.c_str());
+        return false;
+    }
+}
+
+void GenCIStringLists::write_lists(const std::string& filename) const {
+    try {
+        write_string_lists(filename, signature(), alfa_vo_list, beta_vo_list, alfa_oo_list,
+                           beta_oo_list, alfa_vvoo_list, beta_vvoo_list, alfa_1h_list,
+                           beta_1h_list, alfa_2h_list, beta_2h_list, alfa_3h_list, beta_3h_list);
+    } catch (const std::runtime_error& e) {
+        // the cache is only an optimization, so failing to write it is not fatal
+        outfile->Printf("\n  Warning: %s. The string lists will not be cached.\n", e.what());
     }
 }
 
@@ -387,40 +458,40 @@ const VVOOListElement& GenCIStringLists::get_beta_vvoo_list(int class_I, int cla
     return empty_vvoo_list;
 }
 
-std::vector<H1StringSubstitution>& GenCIStringLists::get_alfa_1h_list(int class_I, size_t add_I,
-                                                                      int class_J) {
+const std::vector<H1StringSubstitution>&
+GenCIStringLists::get_alfa_1h_list(int class_I, size_t add_I, int class_J) const {
     std::tuple<int, size_t, int> I_tuple(class_I, add_I, class_J);
-    return alfa_1h_list[I_tuple];
+    return find_string_list(alfa_1h_list, I_tuple);
 }
 
-std::vector<H1StringSubstitution>& GenCIStringLists::get_beta_1h_list(int class_I, size_t add_I,
-                                                                      int class_J) {
+const std::vector<H1StringSubstitution>&
+GenCIStringLists::get_beta_1h_list(int class_I, size_t add_I, int class_J) const {
     std::tuple<int, size_t, int> I_tuple(class_I, add_I, class_J);
-    return beta_1h_list[I_tuple];
+    return find_string_list(beta_1h_list, I_tuple);
 }
 
-std::vector<H2StringSubstitution>& GenCIStringLists::get_alfa_2h_list(int h_I, size_t add_I,
-                                                                      int h_J) {
+const std::vector<H2StringSubstitution>&
+GenCIStringLists::get_alfa_2h_list(int h_I, size_t add_I, int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return alfa_2h_list[I_tuple];
+    return find_string_list(alfa_2h_list, I_tuple);
 }
 
-std::vector<H2StringSubstitution>& GenCIStringLists::get_beta_2h_list(int h_I, size_t add_I,
-                                                                      int h_J) {
+const std::vector<H2StringSubstitution>&
+GenCIStringLists::get_beta_2h_list(int h_I, size_t add_I, int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return beta_2h_list[I_tuple];
+    return find_string_list(beta_2h_list, I_tuple);
 }
 
-std::vector<H3StringSubstitution>& GenCIStringLists::get_alfa_3h_list(int h_I, size_t add_I,
-                                                                      int h_J) {
+const std::vector<H3StringSubstitution>&
+GenCIStringLists::get_alfa_3h_list(int h_I, size_t add_I, int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return alfa_3h_list[I_tuple];
+    return find_string_list(alfa_3h_list, I_tuple);
 }
 
-std::vector<H3StringSubstitution>& GenCIStringLists::get_beta_3h_list(int h_I, size_t add_I,
-                                                                      int h_J) {
+const std::vector<H3StringSubstitution>&
+GenCIStringLists::get_beta_3h_list(int h_I, size_t add_I, int h_J) const {
     std::tuple<int, size_t, int> I_tuple(h_I, add_I, h_J);
-    return beta_3h_list[I_tuple];
+    return find_string_list(beta_3h_list, I_tuple);
 }
 
 } // namespace forte
\ No newline at end of file
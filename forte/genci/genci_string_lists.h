@@ -31,6 +31,7 @@
 #include "psi4/libmints/dimension.h"
 
 #include <map>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -55,9 +56,11 @@ class GenCIStringLists {
   public:
     // ==> Constructor and Destructor <==
     /// @brief The GenCIStringLists constructor
+    /// @param cache_directory if not empty, the string lists are read from a file in this directory
+    ///        when one was saved for the same active space, otherwise they are built and saved
     GenCIStringLists(std::shared_ptr<MOSpaceInfo> mo_space_info, size_t na, size_t nb, int symmetry,
                      PrintLevel print, const std::vector<int> gas_min,
-                     const std::vector<int> gas_max);
+                     const std::vector<int> gas_max, const std::string& cache_directory = "");
 
     ~GenCIStringLists() {}
 
@@ -142,14 +145,20 @@ class GenCIStringLists {
     const VVOOListElement& get_alfa_vvoo_list(int class_I, int class_J) const;
     const VVOOListElement& get_beta_vvoo_list(int class_I, int class_J) const;
 
-    std::vector<H1StringSubstitution>& get_alfa_1h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H1StringSubstitution>& get_beta_1h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H1StringSubstitution>& get_alfa_1h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
+    const std::vector<H1StringSubstitution>& get_beta_1h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
 
-    std::vector<H2StringSubstitution>& get_alfa_2h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H2StringSubstitution>& get_beta_2h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H2StringSubstitution>& get_alfa_2h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
+    const std::vector<H2StringSubstitution>& get_beta_2h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
 
-    std::vector<H3StringSubstitution>& get_alfa_3h_list(int h_I, size_t add_I, int h_J);
-    std::vector<H3StringSubstitution>& get_beta_3h_list(int h_I, size_t add_I, int h_J);
+    const std::vector<H3StringSubstitution>& get_alfa_3h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
+    const std::vector<H3StringSubstitution>& get_beta_3h_list(int h_I, size_t add_I,
+                                                           int h_J) const;
 
     Pair get_pair_list(int h, int n) const { return pair_list_[h][n]; }
 
@@ -184,6 +193,8 @@ class GenCIStringLists {
     std::vector<int> pair_offset_;
     /// The print level
     PrintLevel print_ = PrintLevel::Default;
+    /// The directory where the string lists are cached (empty if caching is disabled)
+    std::string cache_directory_;
 
     // GAS specific data
 
@@ -271,6 +282,16 @@ class GenCIStringLists {
 
     /// Startup the class
     void startup(std::shared_ptr<MOSpaceInfo> mo_space_info);
+
+    /// @return a string that identifies the active space for which the lists are built
+    std::string signature() const;
+
+    /// Read the lists from a file
+    /// @return true if the file exists and was written for the same active space
+    bool read_lists(const std::string& filename);
+
+    /// Write the lists to a file
+    void write_lists(const std::string& filename) const;
 };
 
 std::map<std::pair<int, int>, std::vector<std::pair<int, int>>>
@@ -26,12 +26,16 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/molecule.h"
 
+#include "forte-def.h"
 #include "helpers/helpers.h"
 #include "helpers/printing.h"
+#include "helpers/threading.h"
 #include "base_classes/mo_space_info.h"
 
 #include "genci_vector.h"
@@ -50,15 +54,17 @@ template <typename Func> void debug(Func func) {
     }
 }
 
-std::shared_ptr<psi::Matrix> GenCIVector::CR;
-std::shared_ptr<psi::Matrix> GenCIVector::CL;
+thread_local std::shared_ptr<psi::Matrix> GenCIVector::CR;
+thread_local std::shared_ptr<psi::Matrix> GenCIVector::CL;
+thread_local std::shared_ptr<psi::Matrix> GenCIVector::CR_thread;
+thread_local std::shared_ptr<psi::Matrix> GenCIVector::CL_thread;
 
-double GenCIVector::hdiag_timer = 0.0;
-double GenCIVector::h1_aa_timer = 0.0;
-double GenCIVector::h1_bb_timer = 0.0;
-double GenCIVector::h2_aaaa_timer = 0.0;
-double GenCIVector::h2_aabb_timer = 0.0;
-double GenCIVector::h2_bbbb_timer = 0.0;
+thread_local double GenCIVector::hdiag_timer = 0.0;
+thread_local double GenCIVector::h1_aa_timer = 0.0;
+thread_local double GenCIVector::h1_bb_timer = 0.0;
+thread_local double GenCIVector::h2_aaaa_timer = 0.0;
+thread_local double GenCIVector::h2_aabb_timer = 0.0;
+thread_local double GenCIVector::h2_bbbb_timer = 0.0;
 
 void GenCIVector::allocate_temp_space(std::shared_ptr<GenCIStringLists> lists_, PrintLevel print_) {
     // if CR is already allocated (e.g., because we computed several roots) make sure
@@ -86,6 +92,23 @@ void GenCIVector::allocate_temp_space(std::shared_ptr<GenCIStringLists> lists_,
     }
 }
 
+GenCIVector::BlockTempSpace::BlockTempSpace(size_t nvec) {
+    if (nvec < 2)
+        return;
+    CR_ = CR;
+    CL_ = CL;
+    size_t max_size = CR->rowdim();
+    CR = std::make_shared<psi::Matrix>("CR", max_size, nvec * max_size);
+    CL = std::make_shared<psi::Matrix>("CL", max_size, nvec * max_size);
+}
+
+GenCIVector::BlockTempSpace::~BlockTempSpace() {
+    if (CR_) {
+        CR = CR_;
+        CL = CL_;
+    }
+}
+
 void GenCIVector::release_temp_space() {
     if (CR) {
         CR.reset();
@@ -93,6 +116,43 @@ void GenCIVector::release_temp_space() {
     if (CL) {
         CL.reset();
     }
+    release_thread_temp_space();
+}
+
+void GenCIVector::release_thread_temp_space() {
+    // the matrices of the threads are released by the threads that own them. The team has the same
+    // size as the one of the sigma build, so it runs on all the pooled threads that used them
+#pragma omp parallel num_threads(omp_get_max_threads())
+    {
+        CR_thread.reset();
+        CL_thread.reset();
+    }
+}
+
+std::vector<std::vector<size_t>>
+GenCIVector::thread_blocks(const std::shared_ptr<GenCIStringLists>& lists, size_t num_threads) {
+    std::vector<size_t> weights;
+    for (const auto& [n, _1, _2] : lists->determinant_classes()) {
+        weights.push_back(lists->detpblk(n));
+    }
+    return balanced_partition(weights, num_threads);
+}
+
+std::pair<std::shared_ptr<psi::Matrix>, std::shared_ptr<psi::Matrix>>
+GenCIVector::thread_temp_space(size_t tid, size_t nrow, size_t ncol) {
+    // thread 0 uses CR and CL, which can hold any block
+    if (tid == 0)
+        return {CR, CL};
+    auto& cr = CR_thread;
+    auto& cl = CL_thread;
+    if ((not cr) or (static_cast<size_t>(cr->rowdim()) < nrow) or
+        (static_cast<size_t>(cr->coldim()) < ncol)) {
+        nrow = std::max(nrow, cr ? static_cast<size_t>(cr->rowdim()) : 0);
+        ncol = std::max(ncol, cr ? static_cast<size_t>(cr->coldim()) : 0);
+        cr = std::make_shared<psi::Matrix>("CR", nrow, ncol);
+        cl = std::make_shared<psi::Matrix>("CL", nrow, ncol);
+    }
+    return {cr, cl};
 }
 
 std::shared_ptr<psi::Matrix> GenCIVector::get_CR() { return CR; }
@@ -311,4 +371,70 @@ void GenCIVector::scatter_C_block(double** m, bool alfa,
     }
 }
 
+double** GenCIVector::gather_C_blocks(const std::vector<GenCIVector*>& C,
+                                      std::shared_ptr<psi::Matrix> M, bool alfa,
+                                      std::shared_ptr<StringAddress> alfa_address,
+                                      std::shared_ptr<StringAddress> beta_address, int class_Ia,
+                                      int class_Ib, bool zero) {
+    const size_t nvec = C.size();
+    if (nvec == 1)
+        return C[0]->gather_C_block(M, alfa, alfa_address, beta_address, class_Ia, class_Ib, zero);
+
+    int block_idx = C[0]->lists_->string_class()->block_index(class_Ia, class_Ib);
+    size_t maxIa = alfa_address->strpcls(class_Ia);
+    size_t maxIb = beta_address->strpcls(class_Ib);
+    // the number of rows and columns of the block of a single vector
+    const size_t nrow = alfa ? maxIa : maxIb;
+    const size_t ncol = alfa ? maxIb : maxIa;
+    auto m = M->pointer();
+    if (zero) {
+        for (size_t r = 0; r < nrow; ++r)
+            std::fill_n(m[r], nvec * ncol, 0.0);
+        return m;
+    }
+    for (size_t n = 0; n < nvec; ++n) {
+        auto c = C[n]->C(block_idx)->pointer();
+        const size_t offset = n * ncol;
+        if (alfa) {
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                std::copy_n(c[Ia], maxIb, m[Ia] + offset);
+        } else {
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                    m[Ib][offset + Ia] = c[Ia][Ib];
+        }
+    }
+    return m;
+}
+
+void GenCIVector::scatter_C_blocks(const std::vector<GenCIVector*>& C, double** m, bool alfa,
+                                   std::shared_ptr<StringAddress> alfa_address,
+                                   std::shared_ptr<StringAddress> beta_address, int class_Ia,
+                                   int class_Ib) {
+    const size_t nvec = C.size();
+    if (nvec == 1) {
+        C[0]->scatter_C_block(m, alfa, alfa_address, beta_address, class_Ia, class_Ib);
+        return;
+    }
+
+    int block_idx = C[0]->lists_->string_class()->block_index(class_Ia, class_Ib);
+    size_t maxIa = alfa_address->strpcls(class_Ia);
+    size_t maxIb = beta_address->strpcls(class_Ib);
+    // with more than one vector the data is never in place, so we always add it back
+    for (size_t n = 0; n < nvec; ++n) {
+        auto c = C[n]->C(block_idx)->pointer();
+        if (alfa) {
+            const size_t offset = n * maxIb;
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                    c[Ia][Ib] += m[Ia][offset + Ib];
+        } else {
+            const size_t offset = n * maxIa;
+            for (size_t Ia = 0; Ia < maxIa; ++Ia)
+                for (size_t Ib = 0; Ib < maxIb; ++Ib)
+                    c[Ia][Ib] += m[Ib][offset + Ia];
+        }
+    }
+}
+
 } // namespace forte
@@ -114,6 +114,15 @@ class GenCIVector {
     // Operations on the wave function
     void Hamiltonian(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
+    /// @brief Apply the Hamiltonian to a block of vectors, result[n] = H C[n]. The string lists are
+    /// traversed only once for all the vectors in the block
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The vectors that store the result
+    /// @param fci_ints The integrals object
+    static void Hamiltonian_block(const std::vector<GenCIVector*>& C,
+                                  const std::vector<GenCIVector*>& result,
+                                  std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+
     double energy_from_rdms(std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
     /// @brief Test the RDMs
@@ -141,6 +150,10 @@ class GenCIVector {
     // Temporary memory allocation
     static void allocate_temp_space(std::shared_ptr<GenCIStringLists> lists_, PrintLevel print_);
     static void release_temp_space();
+    /// Free the scratch matrices (CR_thread and CL_thread) of all the OpenMP threads. They outlive
+    /// the parallel regions because the runtime keeps its threads alive, so the solver calls this
+    /// at the end of the solve
+    static void release_thread_temp_space();
 
     /// Return the print level
     void set_print(PrintLevel print) { print_ = print; }
@@ -254,20 +267,43 @@ class GenCIVector {
 
     // ==> Class Static Data <==
 
+    // The scratch data is thread local, so independent solvers can run concurrently on different
+    // threads (see ActiveSpaceSolver)
+
     // Temporary matrix of size as large as the largest block of C. Used to store the right
     // coefficient vector
-    static std::shared_ptr<psi::Matrix> CR;
+    static thread_local std::shared_ptr<psi::Matrix> CR;
     // Temporary matrix of size as large as the largest block of C. Used to store the left
     // coefficient vector
-    static std::shared_ptr<psi::Matrix> CL;
+    static thread_local std::shared_ptr<psi::Matrix> CL;
+
+    /// Widens CR and CL so that they hold the blocks of nvec vectors side by side while this
+    /// object is alive. The destructor restores the matrices allocated by allocate_temp_space, so
+    /// the wide matrices are freed at the end of each block operation. Does nothing if nvec = 1
+    class BlockTempSpace {
+      public:
+        explicit BlockTempSpace(size_t nvec);
+        ~BlockTempSpace();
+        BlockTempSpace(const BlockTempSpace&) = delete;
+        BlockTempSpace& operator=(const BlockTempSpace&) = delete;
+
+      private:
+        std::shared_ptr<psi::Matrix> CR_;
+        std::shared_ptr<psi::Matrix> CL_;
+    };
+    // Scratch used when the blocks of C are processed in parallel. The master thread of a team
+    // uses CR and CL, the other threads allocate these matrices on first use with the size of their
+    // blocks
+    static thread_local std::shared_ptr<psi::Matrix> CR_thread;
+    static thread_local std::shared_ptr<psi::Matrix> CL_thread;
 
     // Timers
-    static double hdiag_timer;
-    static double h1_aa_timer;
-    static double h1_bb_timer;
-    static double h2_aaaa_timer;
-    static double h2_aabb_timer;
-    static double h2_bbbb_timer;
+    static thread_local double hdiag_timer;
+    static thread_local double h1_aa_timer;
+    static thread_local double h1_bb_timer;
+    static thread_local double h2_aaaa_timer;
+    static thread_local double h2_aabb_timer;
+    static thread_local double h2_bbbb_timer;
 
     // ==> Class Public Functions <==
 
@@ -286,28 +322,85 @@ class GenCIVector {
                 ncmo * ncmo * ncmo * r + ncmo * ncmo * s + ncmo * t + u);
     }
 
-    /// @brief Apply the scalar part of the Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Distribute the determinant blocks among threads. Each block is weighted by its
+    /// number of determinants
+    /// @param lists The string lists
+    /// @param num_threads The number of threads
+    /// @return The indices of the blocks assigned to each thread
+    static std::vector<std::vector<size_t>>
+    thread_blocks(const std::shared_ptr<GenCIStringLists>& lists, size_t num_threads);
+
+    /// @brief Return the scratch matrices (CR, CL) of the calling thread, making sure that they
+    /// have at least nrow rows and ncol columns. Must be called by the thread that uses them
+    /// @param tid The thread id within the team (thread 0 uses CR and CL)
+    /// @param nrow The minimum number of rows
+    /// @param ncol The minimum number of columns
+    static std::pair<std::shared_ptr<psi::Matrix>, std::shared_ptr<psi::Matrix>>
+    thread_temp_space(size_t tid, size_t nrow, size_t ncol);
+
+    /// @brief Apply the scalar part of the Hamiltonian to a block of vectors and add it to the
+    /// result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
-    void H0(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+    static void H0(const std::vector<GenCIVector*>& C, const std::vector<GenCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
 
-    /// @brief Apply the one-particle Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the one-particle Hamiltonian to a block of vectors and add it to the result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
     /// @param alfa flag for alfa or beta component, true = alfa, false = beta
-    void H1(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
+    static void H1(const std::vector<GenCIVector*>& C, const std::vector<GenCIVector*>& result,
+                   std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
 
-    /// @brief Apply the same-spin two-particle Hamiltonian to this vector and add it to the result
-    /// @param result The wave function to add the result to
+    /// @brief Apply the same-spin two-particle Hamiltonian to a block of vectors and add it to the
+    /// result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object
     /// @param alfa flag for alfa or beta component, true = alfa, false = beta
-    void H2_aaaa2(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
-
-    /// @brief Apply the different-spin component of two-particle Hamiltonian to this vector and add
-    /// it to the result
-    /// @param result The wave function to add the result to
+    static void H2_aaaa2(const std::vector<GenCIVector*>& C,
+                         const std::vector<GenCIVector*>& result,
+                         std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa);
+
+    /// @brief Apply the different-spin component of two-particle Hamiltonian to a block of vectors
+    /// and add it to the result
+    /// @param C The vectors to which we apply the Hamiltonian
+    /// @param result The wave functions to add the result to
     /// @param fci_ints The integrals object/
-    void H2_aabb(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+    static void H2_aabb(const std::vector<GenCIVector*>& C, const std::vector<GenCIVector*>& result,
+                        std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+
+    /// @brief Gather the same block of several vectors into a matrix. The blocks are stored side by
+    /// side, so that each row of the matrix contains the strings of all the vectors. For a single
+    /// vector this is equivalent to gather_C_block
+    /// @param C The vectors
+    /// @param M The matrix that holds the data (unless there is a single vector and alfa is true)
+    /// @param alfa flag for alfa or beta component, true = alfa, false = beta
+    /// @param alfa_address The addressing object for the alfa component
+    /// @param beta_address The addressing object for the beta component
+    /// @param ha The string class of the alfa component
+    /// @param hb The string class of the beta component
+    /// @param zero If true, zero the matrix before returning it
+    /// @return A pointer to the gathered block
+    static double** gather_C_blocks(const std::vector<GenCIVector*>& C,
+                                    std::shared_ptr<psi::Matrix> M, bool alfa,
+                                    std::shared_ptr<StringAddress> alfa_address,
+                                    std::shared_ptr<StringAddress> beta_address, int ha, int hb,
+                                    bool zero);
+
+    /// @brief Add the data gathered with gather_C_blocks back to the coefficient matrices
+    /// @param C The vectors
+    /// @param m The matrix that holds the data
+    /// @param alfa flag for alfa or beta component, true = alfa, false = beta
+    /// @param alfa_address The addressing object for the alfa component
+    /// @param beta_address The addressing object for the beta component
+    /// @param ha The string class of the alfa component
+    /// @param hb The string class of the beta component
+    static void scatter_C_blocks(const std::vector<GenCIVector*>& C, double** m, bool alfa,
+                                 std::shared_ptr<StringAddress> alfa_address,
+                                 std::shared_ptr<StringAddress> beta_address, int ha, int hb);
 
     // 1-RDM elements are stored in the format
     // <a^+_{pa} a^+_{qb} a_{sb} a_ra> -> rdm[oei_index(p,q)]
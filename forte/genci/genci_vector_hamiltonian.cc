@@ -26,10 +26,13 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 
+#include "forte-def.h"
 #include "integrals/active_space_integrals.h"
 #include "helpers/timer.h"
 #include "genci_vector.h"
@@ -45,234 +48,348 @@ namespace forte {
  * @param result Wave function object which stores the resulting vector
  */
 void GenCIVector::Hamiltonian(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
-    //    check_temp_space();
-    result.zero();
+    Hamiltonian_block({this}, {&result}, fci_ints);
+}
+
+/**
+ * Apply the Hamiltonian to a block of wave functions
+ * @param C The wave functions to which we apply the Hamiltonian
+ * @param result The wave functions which store the resulting vectors
+ */
+void GenCIVector::Hamiltonian_block(const std::vector<GenCIVector*>& C,
+                                    const std::vector<GenCIVector*>& result,
+                                    std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+    if (C.size() != result.size()) {
+        throw std::runtime_error("GenCIVector::Hamiltonian_block: the number of input (" +
+                                 std::to_string(C.size()) + ") and output (" +
+                                 std::to_string(result.size()) + ") vectors is different");
+    }
+    if (C.empty())
+        return;
+
+    // The gathered blocks of all the vectors are stored side by side in CR and CL
+    BlockTempSpace block_temp_space(C.size());
+
+    for (auto r : result) {
+        r->zero();
+    }
 
     // H0
-    { H0(result, fci_ints); }
+    { H0(C, result, fci_ints); }
     // H1_aa
     {
         local_timer t;
-        H1(result, fci_ints, true);
+        H1(C, result, fci_ints, true);
         h1_aa_timer += t.get();
     }
     // H1_bb
     {
         local_timer t;
-        H1(result, fci_ints, false);
+        H1(C, result, fci_ints, false);
         h1_bb_timer += t.get();
     }
     // H2_aabb
     {
         local_timer t;
-        H2_aabb(result, fci_ints);
+        H2_aabb(C, result, fci_ints);
         h2_aabb_timer += t.get();
     }
     // H2_aaaa
     {
         local_timer t;
-        H2_aaaa2(result, fci_ints, true);
+        H2_aaaa2(C, result, fci_ints, true);
         h2_aaaa_timer += t.get();
     }
     // H2_bbbb
     {
         local_timer t;
-        H2_aaaa2(result, fci_ints, false);
+        H2_aaaa2(C, result, fci_ints, false);
         h2_bbbb_timer += t.get();
     }
 }
 
-void GenCIVector::H0(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+void GenCIVector::H0(const std::vector<GenCIVector*>& C, const std::vector<GenCIVector*>& result,
+                     std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
     double core_energy = fci_ints->scalar_energy() + fci_ints->frozen_core_energy() +
                          fci_ints->nuclear_repulsion_energy();
-    for (const auto& [n, _1, _2] : lists_->determinant_classes()) {
-        result.C_[n]->copy(C_[n]);
-        result.C_[n]->scale(core_energy);
+    const auto nblocks = static_cast<std::int64_t>(C[0]->lists_->determinant_classes().size());
+#pragma omp parallel for schedule(dynamic)
+    for (std::int64_t n = 0; n < nblocks; ++n) {
+        for (size_t v = 0; v < C.size(); ++v) {
+            result[v]->C_[n]->copy(C[v]->C_[n]);
+            result[v]->C_[n]->scale(core_energy);
+        }
     }
 }
 
-void GenCIVector::H1(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints,
-                     bool alfa) {
-    // loop over blocks of matrix C
-    for (const auto& [nI, class_Ia, class_Ib] : lists_->determinant_classes()) {
-        if (lists_->detpblk(nI) == 0)
-            continue;
-        auto Cr =
-            this->gather_C_block(CR, alfa, alfa_address_, beta_address_, class_Ia, class_Ib, false);
-
-        for (const auto& [nJ, class_Ja, class_Jb] : lists_->determinant_classes()) {
-
-            // If we act on the alpha string, the beta string classes of the result must be the same
-            if (alfa and (class_Ib != class_Jb))
-                continue;
-            // If we act on the beta string, the alpha string classes of the result must be the same
-            if (not alfa and (class_Ia != class_Ja))
-                continue;
-
-            if (lists_->detpblk(nJ) == 0)
-                continue;
-
-            auto Cl = result.gather_C_block(CL, alfa, alfa_address_, beta_address_, class_Ja,
-                                            class_Jb, !alfa);
-
-            size_t maxL =
-                alfa ? beta_address_->strpcls(class_Ib) : alfa_address_->strpcls(class_Ia);
-
-            const auto& pq_vo_list = alfa ? lists_->get_alfa_vo_list(class_Ia, class_Ja)
-                                          : lists_->get_beta_vo_list(class_Ib, class_Jb);
-
-            for (const auto& [pq, vo_list] : pq_vo_list) {
-                const auto& [p, q] = pq;
-                const double Hpq = alfa ? fci_ints->oei_a(p, q) : fci_ints->oei_b(p, q);
-                for (const auto& [sign, I, J] : vo_list) {
-                    C_DAXPY(maxL, sign * Hpq, Cr[I], 1, Cl[J], 1);
+void GenCIVector::H1(const std::vector<GenCIVector*>& C, const std::vector<GenCIVector*>& result,
+                     std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa) {
+    const auto& lists = C[0]->lists_;
+    const auto& alfa_address = C[0]->alfa_address_;
+    const auto& beta_address = C[0]->beta_address_;
+    const size_t nvec = C.size();
+    // when there is more than one vector the left block is always stored in CL
+    const bool zero_left = (not alfa) or (nvec > 1);
+    // the number of rows of the gathered blocks
+    const size_t max_rows = alfa ? alfa_address->max_strpcls() : beta_address->max_strpcls();
+
+    // each thread owns a set of blocks of the result, so every block is written by one thread
+    const size_t num_threads = omp_get_max_threads();
+    const auto blocks = thread_blocks(lists, num_threads);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nt = omp_get_num_threads();
+        // if we got fewer threads than requested, the remaining sets of blocks are shared
+        for (size_t t = tid; t < num_threads; t += nt) {
+            for (const size_t b : blocks[t]) {
+                const auto& [nJ, class_Ja, class_Jb] = lists->determinant_classes()[b];
+                if (lists->detpblk(nJ) == 0)
+                    continue;
+
+                // the rows of Cr and Cl contain the strings of all the vectors
+                const size_t maxL = nvec * (alfa ? beta_address->strpcls(class_Jb)
+                                                 : alfa_address->strpcls(class_Ja));
+                const auto [CR_t, CL_t] = thread_temp_space(tid, max_rows, maxL);
+
+                auto Cl = gather_C_blocks(result, CL_t, alfa, alfa_address, beta_address,
+                                          class_Ja, class_Jb, zero_left);
+
+                // loop over the blocks of C coupled to this block of the result
+                for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+                    // If we act on the alpha string, the beta string classes must be the same
+                    if (alfa and (class_Ib != class_Jb))
+                        continue;
+                    // If we act on the beta string, the alpha string classes must be the same
+                    if (not alfa and (class_Ia != class_Ja))
+                        continue;
+                    if (lists->detpblk(nI) == 0)
+                        continue;
+
+                    const auto& pq_vo_list = alfa ? lists->get_alfa_vo_list(class_Ia, class_Ja)
+                                                  : lists->get_beta_vo_list(class_Ib, class_Jb);
+                    if (pq_vo_list.empty())
+                        continue;
+
+                    auto Cr = gather_C_blocks(C, CR_t, alfa, alfa_address, beta_address, class_Ia,
+                                              class_Ib, false);
+
+                    for (const auto& [pq, vo_list] : pq_vo_list) {
+                        const auto& [p, q] = pq;
+                        const double Hpq = alfa ? fci_ints->oei_a(p, q) : fci_ints->oei_b(p, q);
+                        for (const auto& [sign, I, J] : vo_list) {
+                            C_DAXPY(maxL, sign * Hpq, Cr[I], 1, Cl[J], 1);
+                        }
+                    }
                 }
+                scatter_C_blocks(result, Cl, alfa, alfa_address, beta_address, class_Ja, class_Jb);
             }
-            result.scatter_C_block(Cl, alfa, alfa_address_, beta_address_, class_Ja, class_Jb);
         }
     }
-} // End loop over h
-
-void GenCIVector::H2_aaaa2(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints,
-                           bool alfa) {
-    for (const auto& [nI, class_Ia, class_Ib] : lists_->determinant_classes()) {
-        if (lists_->detpblk(nI) == 0)
-            continue;
-
-        const auto Cr =
-            this->gather_C_block(CR, alfa, alfa_address_, beta_address_, class_Ia, class_Ib, false);
-
-        for (const auto& [nJ, class_Ja, class_Jb] : lists_->determinant_classes()) {
-            // The string class on which we don't act must be the same for I and J
-            if ((alfa and (class_Ib != class_Jb)) or (not alfa and (class_Ia != class_Ja)))
-                continue;
-            if (lists_->detpblk(nJ) == 0)
-                continue;
-
-            auto Cl = result.gather_C_block(CL, alfa, alfa_address_, beta_address_, class_Ja,
-                                            class_Jb, !alfa);
-
-            // get the size of the string of spin opposite to the one we are acting on
-            size_t maxL =
-                alfa ? beta_address_->strpcls(class_Ib) : alfa_address_->strpcls(class_Ia);
-
-            if ((class_Ia == class_Ja) and (class_Ib == class_Jb)) {
-                // OO terms
-                // Loop over (p>q) == (p>q)
-                const auto& pq_oo_list =
-                    alfa ? lists_->get_alfa_oo_list(class_Ia) : lists_->get_beta_oo_list(class_Ib);
-                for (const auto& [pq, oo_list] : pq_oo_list) {
-                    const auto& [p, q] = pq;
-                    const double integral =
-                        alfa ? fci_ints->tei_aa(p, q, p, q) : fci_ints->tei_bb(p, q, p, q);
-                    for (const auto& I : oo_list) {
-                        C_DAXPY(maxL, integral, Cr[I], 1, Cl[I], 1);
+}
+
+void GenCIVector::H2_aaaa2(const std::vector<GenCIVector*>& C,
+                           const std::vector<GenCIVector*>& result,
+                           std::shared_ptr<ActiveSpaceIntegrals> fci_ints, bool alfa) {
+    const auto& lists = C[0]->lists_;
+    const auto& alfa_address = C[0]->alfa_address_;
+    const auto& beta_address = C[0]->beta_address_;
+    const size_t nvec = C.size();
+    // when there is more than one vector the left block is always stored in CL
+    const bool zero_left = (not alfa) or (nvec > 1);
+    // the number of rows of the gathered blocks
+    const size_t max_rows = alfa ? alfa_address->max_strpcls() : beta_address->max_strpcls();
+
+    // each thread owns a set of blocks of the result, so every block is written by one thread
+    const size_t num_threads = omp_get_max_threads();
+    const auto blocks = thread_blocks(lists, num_threads);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nt = omp_get_num_threads();
+        // if we got fewer threads than requested, the remaining sets of blocks are shared
+        for (size_t t = tid; t < num_threads; t += nt) {
+            for (const size_t b : blocks[t]) {
+                const auto& [nJ, class_Ja, class_Jb] = lists->determinant_classes()[b];
+                if (lists->detpblk(nJ) == 0)
+                    continue;
+
+                // get the size of the string of spin opposite to the one we are acting on (times
+                // the number of vectors)
+                const size_t maxL = nvec * (alfa ? beta_address->strpcls(class_Jb)
+                                                 : alfa_address->strpcls(class_Ja));
+                const auto [CR_t, CL_t] = thread_temp_space(tid, max_rows, maxL);
+
+                auto Cl = gather_C_blocks(result, CL_t, alfa, alfa_address, beta_address,
+                                          class_Ja, class_Jb, zero_left);
+
+                // loop over the blocks of C coupled to this block of the result
+                for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+                    // The string class on which we don't act must be the same for I and J
+                    if ((alfa and (class_Ib != class_Jb)) or (not alfa and (class_Ia != class_Ja)))
+                        continue;
+                    if (lists->detpblk(nI) == 0)
+                        continue;
+
+                    const auto& pqrs_vvoo_list =
+                        alfa ? lists->get_alfa_vvoo_list(class_Ia, class_Ja)
+                             : lists->get_beta_vvoo_list(class_Ib, class_Jb);
+                    const bool diagonal = (class_Ia == class_Ja) and (class_Ib == class_Jb);
+                    if (pqrs_vvoo_list.empty() and not diagonal)
+                        continue;
+
+                    const auto Cr = gather_C_blocks(C, CR_t, alfa, alfa_address, beta_address,
+                                                    class_Ia, class_Ib, false);
+
+                    if (diagonal) {
+                        // OO terms
+                        // Loop over (p>q) == (p>q)
+                        const auto& pq_oo_list = alfa ? lists->get_alfa_oo_list(class_Ia)
+                                                      : lists->get_beta_oo_list(class_Ib);
+                        for (const auto& [pq, oo_list] : pq_oo_list) {
+                            const auto& [p, q] = pq;
+                            const double integral =
+                                alfa ? fci_ints->tei_aa(p, q, p, q) : fci_ints->tei_bb(p, q, p, q);
+                            for (const auto& I : oo_list) {
+                                C_DAXPY(maxL, integral, Cr[I], 1, Cl[I], 1);
+                            }
+                        }
                     }
-                }
-            }
 
-            // VVOO terms
-            const auto& pqrs_vvoo_list = alfa ? lists_->get_alfa_vvoo_list(class_Ia, class_Ja)
-                                              : lists_->get_beta_vvoo_list(class_Ib, class_Jb);
-            for (const auto& [pqrs, vvoo_list] : pqrs_vvoo_list) {
-                const auto& [p, q, r, s] = pqrs;
-                const double integral1 =
-                    alfa ? fci_ints->tei_aa(p, q, r, s) : fci_ints->tei_bb(p, q, r, s);
-                for (const auto& [sign, I, J] : vvoo_list) {
-                    C_DAXPY(maxL, sign * integral1, Cr[I], 1, Cl[J], 1);
+                    // VVOO terms
+                    for (const auto& [pqrs, vvoo_list] : pqrs_vvoo_list) {
+                        const auto& [p, q, r, s] = pqrs;
+                        const double integral1 =
+                            alfa ? fci_ints->tei_aa(p, q, r, s) : fci_ints->tei_bb(p, q, r, s);
+                        for (const auto& [sign, I, J] : vvoo_list) {
+                            C_DAXPY(maxL, sign * integral1, Cr[I], 1, Cl[J], 1);
+                        }
+                    }
                 }
+                scatter_C_blocks(result, Cl, alfa, alfa_address, beta_address, class_Ja, class_Jb);
             }
-            result.scatter_C_block(Cl, alfa, alfa_address_, beta_address_, class_Ja, class_Jb);
         }
     }
 }
 
-void GenCIVector::H2_aabb(GenCIVector& result, std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
-    const auto& mo_sym = lists_->string_class()->mo_sym();
-    const auto Cr = CR->pointer();
-    auto Cl = CL->pointer();
-    // Loop over blocks of matrix C
-    for (const auto& [nI, class_Ia, class_Ib] : lists_->determinant_classes()) {
-        if (lists_->detpblk(nI) == 0)
-            continue;
-
-        auto h_Ib = lists_->string_class()->beta_string_classes()[class_Ib].second;
-        const size_t maxIa = alfa_address_->strpcls(class_Ia);
-        const auto C = C_[nI]->pointer();
-
-        for (const auto& [nJ, class_Ja, class_Jb] : lists_->determinant_classes()) {
-            if (lists_->detpblk(nJ) == 0)
-                continue;
-
-            auto h_Jb = lists_->string_class()->beta_string_classes()[class_Jb].second;
-            const size_t maxJa = alfa_address_->strpcls(class_Ja);
-            auto HC = result.C_[nJ]->pointer();
-
-            const auto& pq_vo_alfa = lists_->get_alfa_vo_list(class_Ia, class_Ja);
-            const auto& rs_vo_beta = lists_->get_beta_vo_list(class_Ib, class_Jb);
-
-            for (const auto& [rs, vo_beta_list] : rs_vo_beta) {
-                const size_t beta_list_size = vo_beta_list.size();
-                if (beta_list_size == 0)
-                    continue;
-
-                const auto& [r, s] = rs;
-                const auto rs_sym = mo_sym[r] ^ mo_sym[s];
-
-                // Make sure that the symmetry of the J beta string is the same as the symmetry of
-                // the I beta string times the symmetry of the rs product
-                if (h_Jb != (h_Ib ^ rs_sym))
+void GenCIVector::H2_aabb(const std::vector<GenCIVector*>& C,
+                          const std::vector<GenCIVector*>& result,
+                          std::shared_ptr<ActiveSpaceIntegrals> fci_ints) {
+    const auto& lists = C[0]->lists_;
+    const auto& alfa_address = C[0]->alfa_address_;
+    const auto& beta_address = C[0]->beta_address_;
+    const size_t nvec = C.size();
+    const auto& mo_sym = lists->string_class()->mo_sym();
+    const size_t max_rows = alfa_address->max_strpcls();
+
+    // each thread owns a set of blocks of the result, so every block is written by one thread
+    const size_t num_threads = omp_get_max_threads();
+    const auto blocks = thread_blocks(lists, num_threads);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nt = omp_get_num_threads();
+        // if we got fewer threads than requested, the remaining sets of blocks are shared
+        for (size_t t = tid; t < num_threads; t += nt) {
+            for (const size_t b : blocks[t]) {
+                const auto& [nJ, class_Ja, class_Jb] = lists->determinant_classes()[b];
+                if (lists->detpblk(nJ) == 0)
                     continue;
 
-                // Zero the block of CL used to store the result
-                // this should be faster than CL->zero(); when beta_list_size is smaller than
-                // the number of columns of CL
-                for (size_t Ja = 0; Ja < maxJa; ++Ja) {
-                    const auto cl = Cl[Ja];
-                    std::fill(cl, cl + beta_list_size, 0.0);
-                }
+                auto h_Jb = lists->string_class()->beta_string_classes()[class_Jb].second;
+                const size_t maxJa = alfa_address->strpcls(class_Ja);
 
-                // Gather cols of C into CR with the correct sign
-                for (size_t Ia = 0; Ia < maxIa; ++Ia) {
-                    const auto c = C[Ia];
-                    auto cr = Cr[Ia];
-                    for (size_t idx{0}; const auto& [sign, I, _] : vo_beta_list) {
-                        cr[idx] = c[I] * sign;
-                        idx++;
-                    }
-                }
+                // a beta list has at most one entry per string of the class Jb
+                const auto [CR_t, CL_t] =
+                    thread_temp_space(tid, max_rows, nvec * beta_address->strpcls(class_Jb));
+                const auto Cr = CR_t->pointer();
+                auto Cl = CL_t->pointer();
 
-                for (const auto& [pq, vo_alfa_list] : pq_vo_alfa) {
-                    const auto& [p, q] = pq;
-                    const auto pq_sym = mo_sym[p] ^ mo_sym[q];
-                    // ensure that the product pqrs is totally symmetric
-                    if (pq_sym != rs_sym)
+                // Loop over the blocks of C coupled to this block of the result
+                for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+                    if (lists->detpblk(nI) == 0)
                         continue;
 
-                    // Grab the integral
-                    const double integral = fci_ints->tei_ab(p, r, q, s);
-
-                    for (const auto& [sign, I, J] : vo_alfa_list) {
-                        const auto factor = integral * sign;
-                        std::transform(Cr[I], Cr[I] + beta_list_size, Cl[J], Cl[J],
-                                       [factor](double xi, double yi) { return factor * xi + yi; });
-                        // C_DAXPY(beta_list_size, integral * sign, Cr[I], 1, Cl[J], 1);
-                        // the urolled version of the loop above is faster
-                        // const auto& ClJ = Cl[J];
-                        // const auto& CrI = Cr[I];
-                        // const auto factor = integral * sign;
-                        // for (size_t idx{0}; idx != beta_list_size; ++idx)
-                        //     ClJ[idx] += factor * CrI[idx];
-                    }
-                } // End loop over p,q
-
-                // Scatter cols of CL into HC (the sign was included before in the gathering)
-                for (size_t Ja = 0; Ja < maxJa; ++Ja) {
-                    auto hc = HC[Ja];
-                    const auto cl = Cl[Ja];
-                    for (size_t idx{0}; const auto& [_1, _2, J] : vo_beta_list) {
-                        hc[J] += cl[idx];
-                        idx++;
+                    auto h_Ib = lists->string_class()->beta_string_classes()[class_Ib].second;
+                    const size_t maxIa = alfa_address->strpcls(class_Ia);
+
+                    const auto& pq_vo_alfa = lists->get_alfa_vo_list(class_Ia, class_Ja);
+                    const auto& rs_vo_beta = lists->get_beta_vo_list(class_Ib, class_Jb);
+
+                    for (const auto& [rs, vo_beta_list] : rs_vo_beta) {
+                        const size_t beta_list_size = vo_beta_list.size();
+                        if (beta_list_size == 0)
+                            continue;
+
+                        const auto& [r, s] = rs;
+                        const auto rs_sym = mo_sym[r] ^ mo_sym[s];
+
+                        // Make sure that the symmetry of the J beta string is the same as the
+                        // symmetry of the I beta string times the symmetry of the rs product
+                        if (h_Jb != (h_Ib ^ rs_sym))
+                            continue;
+
+                        // The columns gathered from each vector are stored side by side in Cr and
+                        // Cl
+                        const size_t block_size = nvec * beta_list_size;
+
+                        // Zero the block of Cl used to store the result
+                        // this should be faster than CL->zero(); when beta_list_size is smaller
+                        // than the number of columns of CL
+                        for (size_t Ja = 0; Ja < maxJa; ++Ja) {
+                            const auto cl = Cl[Ja];
+                            std::fill(cl, cl + block_size, 0.0);
+                        }
+
+                        // Gather cols of C into Cr with the correct sign
+                        for (size_t n = 0; n < nvec; ++n) {
+                            const auto Cn = C[n]->C_[nI]->pointer();
+                            const size_t offset = n * beta_list_size;
+                            for (size_t Ia = 0; Ia < maxIa; ++Ia) {
+                                const auto c = Cn[Ia];
+                                auto cr = Cr[Ia] + offset;
+                                for (size_t idx{0}; const auto& [sign, I, _] : vo_beta_list) {
+                                    cr[idx] = c[I] * sign;
+                                    idx++;
+                                }
+                            }
+                        }
+
+                        for (const auto& [pq, vo_alfa_list] : pq_vo_alfa) {
+                            const auto& [p, q] = pq;
+                            const auto pq_sym = mo_sym[p] ^ mo_sym[q];
+                            // ensure that the product pqrs is totally symmetric
+                            if (pq_sym != rs_sym)
+                                continue;
+
+                            // Grab the integral
+                            const double integral = fci_ints->tei_ab(p, r, q, s);
+
+                            for (const auto& [sign, I, J] : vo_alfa_list) {
+                                const auto factor = integral * sign;
+                                std::transform(
+                                    Cr[I], Cr[I] + block_size, Cl[J], Cl[J],
+                                    [factor](double xi, double yi) { return factor * xi + yi; });
+                            }
+                        } // End loop over p,q
+
+                        // Scatter cols of Cl into HC (the sign was included before in the
+                        // gathering)
+                        for (size_t n = 0; n < nvec; ++n) {
+                            auto HC = result[n]->C_[nJ]->pointer();
+                            const size_t offset = n * beta_list_size;
+                            for (size_t Ja = 0; Ja < maxJa; ++Ja) {
+                                auto hc = HC[Ja];
+                                const auto cl = Cl[Ja] + offset;
+                                for (size_t idx{0}; const auto& [_1, _2, J] : vo_beta_list) {
+                                    hc[J] += cl[idx];
+                                    idx++;
+                                }
+                            }
+                        }
                     }
                 }
             }
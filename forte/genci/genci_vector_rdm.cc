@@ -29,6 +29,9 @@
 #include "psi4/libpsi4util/process.h"
 #include "psi4/libmints/matrix.h"
 
+#include "forte-def.h"
+#include "helpers/threading.h"
+
 #include "genci_string_lists.h"
 #include "genci_string_address.h"
 
@@ -36,12 +39,55 @@
 
 namespace forte {
 
+namespace {
+/// @brief Call f(tid, b, rdm) for the determinant blocks b assigned to each thread and add up the
+/// contributions to an RDM. Each thread accumulates in a private buffer (thread 0 uses the RDM
+/// itself) and the buffers are summed in parallel at the end
+/// @param rdm_data the RDM
+/// @param blocks the blocks assigned to each thread (see GenCIVector::thread_blocks)
+/// @param f the function that adds the contribution of a block to an RDM buffer
+template <typename F>
+void accumulate_over_blocks(std::vector<double>& rdm_data,
+                            const std::vector<std::vector<size_t>>& blocks, F f) {
+    const size_t num_threads = blocks.size();
+    const size_t size = rdm_data.size();
+    std::vector<std::vector<double>> buffers(num_threads);
+#pragma omp parallel num_threads(num_threads)
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nt = omp_get_num_threads();
+        double* rdm = rdm_data.data();
+        if (tid > 0) {
+            buffers[tid].assign(size, 0.0);
+            rdm = buffers[tid].data();
+        }
+        // if we got fewer threads than requested, the remaining sets of blocks are shared
+        for (size_t t = tid; t < num_threads; t += nt) {
+            for (const size_t b : blocks[t]) {
+                f(tid, b, rdm);
+            }
+        }
+#pragma omp barrier
+        const auto [begin, end] = thread_range(size, nt, tid);
+        for (size_t t = 1; t < nt; ++t) {
+            const double* buffer = buffers[t].data();
+            for (size_t i = begin; i < end; ++i) {
+                rdm_data[i] += buffer[i];
+            }
+        }
+    }
+}
+} // namespace
+
 /**
  * Compute the one-particle density matrix for a given wave function
  * @param alfa flag for alfa or beta component, true = alfa, false = beta
  */
 std::shared_ptr<RDMs> GenCIVector::compute_rdms(GenCIVector& C_left, GenCIVector& C_right,
                                                 int max_rdm_level, RDMsType type) {
+    // the scratch is thread local, so it may not have been allocated on this thread
+    allocate_temp_space(C_left.lists_, PrintLevel::Quiet);
+
     std::vector<double> rdm_timing;
 
     size_t na = C_left.alfa_address()->nones();
@@ -171,15 +217,20 @@ ambit::Tensor GenCIVector::compute_1rdm_same_irrep(GenCIVector& C_left, GenCIVec
     if ((alfa and (na < 1)) or ((!alfa) and (nb < 1)))
         return rdm;
 
-    auto& rdm_data = rdm.data();
+    const size_t max_rows = alfa ? alfa_address->max_strpcls() : beta_address->max_strpcls();
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
 
     // loop over blocks of matrix C
-    for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t tid, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
         if (lists->detpblk(nI) == 0)
-            continue;
+            return;
 
-        auto Cr =
-            C_right.gather_C_block(CR, alfa, alfa_address, beta_address, class_Ia, class_Ib, false);
+        size_t maxL = alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
+        const auto [CR_t, CL_t] = thread_temp_space(tid, max_rows, maxL);
+
+        auto Cr = C_right.gather_C_block(CR_t, alfa, alfa_address, beta_address, class_Ia,
+                                         class_Ib, false);
 
         for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
             // The string class on which we don't act must be the same for I and J
@@ -188,11 +239,9 @@ ambit::Tensor GenCIVector::compute_1rdm_same_irrep(GenCIVector& C_left, GenCIVec
             if (lists->detpblk(nJ) == 0)
                 continue;
 
-            auto Cl = C_left.gather_C_block(CL, alfa, alfa_address, beta_address, class_Ja,
+            auto Cl = C_left.gather_C_block(CL_t, alfa, alfa_address, beta_address, class_Ja,
                                             class_Jb, false);
 
-            size_t maxL = alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
-
             const auto& pq_vo_list = alfa ? lists->get_alfa_vo_list(class_Ia, class_Ja)
                                           : lists->get_beta_vo_list(class_Ib, class_Jb);
 
@@ -205,7 +254,7 @@ ambit::Tensor GenCIVector::compute_1rdm_same_irrep(GenCIVector& C_left, GenCIVec
                 rdm_data[p * ncmo + q] += rdm_element;
             }
         }
-    }
+    });
 
     return rdm;
 }
@@ -229,14 +278,20 @@ ambit::Tensor GenCIVector::compute_2rdm_aa_same_irrep(GenCIVector& C_left, GenCI
     if ((alfa and (na < 2)) or ((!alfa) and (nb < 2)))
         return rdm;
 
-    auto& rdm_data = rdm.data();
+    const size_t max_rows = alfa ? alfa_address->max_strpcls() : beta_address->max_strpcls();
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
 
-    for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t tid, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
         if (lists->detpblk(nI) == 0)
-            continue;
+            return;
 
-        const auto Cr =
-            C_right.gather_C_block(CR, alfa, alfa_address, beta_address, class_Ia, class_Ib, false);
+        // get the size of the string of spin opposite to the one we are acting on
+        size_t maxL = alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
+        const auto [CR_t, CL_t] = thread_temp_space(tid, max_rows, maxL);
+
+        const auto Cr = C_right.gather_C_block(CR_t, alfa, alfa_address, beta_address, class_Ia,
+                                               class_Ib, false);
 
         for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
             // The string class on which we don't act must be the same for I and J
@@ -245,11 +300,8 @@ ambit::Tensor GenCIVector::compute_2rdm_aa_same_irrep(GenCIVector& C_left, GenCI
             if (lists->detpblk(nJ) == 0)
                 continue;
 
-            const auto Cl = C_left.gather_C_block(CL, alfa, alfa_address, beta_address, class_Ja,
-                                                  class_Jb, false);
-
-            // get the size of the string of spin opposite to the one we are acting on
-            size_t maxL = alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
+            const auto Cl = C_left.gather_C_block(CL_t, alfa, alfa_address, beta_address,
+                                                  class_Ja, class_Jb, false);
 
             if ((class_Ia == class_Ja) and (class_Ib == class_Jb)) {
                 // OO terms
@@ -285,7 +337,7 @@ ambit::Tensor GenCIVector::compute_2rdm_aa_same_irrep(GenCIVector& C_left, GenCI
                 rdm_data[tei_index(q, p, s, r, ncmo)] += rdm_element;
             }
         }
-    }
+    });
 #if 0
     psi::outfile->Printf("\n TPDM:");
     for (int p = 0; p < no_; ++p) {
@@ -317,13 +369,14 @@ ambit::Tensor GenCIVector::compute_2rdm_ab_same_irrep(GenCIVector& C_left, GenCI
     if ((na < 1) or (nb < 1))
         return rdm;
 
-    auto& rdm_data = rdm.data();
-
     const auto& mo_sym = lists->string_class()->mo_sym();
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
+
     // Loop over blocks of matrix C
-    for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t /*tid*/, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
         if (lists->detpblk(nI) == 0)
-            continue;
+            return;
 
         auto h_Ib = lists->string_class()->beta_string_classes()[class_Ib].second;
         const auto Cr = C_right.C_[nI]->pointer();
@@ -368,7 +421,7 @@ ambit::Tensor GenCIVector::compute_2rdm_ab_same_irrep(GenCIVector& C_left, GenCI
                 } // End loop over p,q
             }
         }
-    }
+    });
 #if 0
     psi::outfile->Printf("\n TPDM (ab):");
     for (int p = 0; p < no_; ++p) {
@@ -402,55 +455,55 @@ ambit::Tensor GenCIVector::compute_3rdm_aaa_same_irrep(GenCIVector& C_left, GenC
     if ((alfa and (na < 3)) or ((!alfa) and (nb < 3)))
         return rdm;
 
-    auto& rdm_data = rdm.data();
-
     int num_3h_classes =
         alfa ? lists->alfa_address_3h()->nclasses() : lists->beta_address_3h()->nclasses();
 
-    for (int class_K = 0; class_K < num_3h_classes; ++class_K) {
-        size_t maxK = alfa ? lists->alfa_address_3h()->strpcls(class_K)
-                           : lists->beta_address_3h()->strpcls(class_K);
+    const size_t max_rows = alfa ? alfa_address->max_strpcls() : beta_address->max_strpcls();
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
 
-        // loop over blocks of matrix C
-        for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
-            if (lists->detpblk(nI) == 0)
-                continue;
+    // loop over blocks of matrix C
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t tid, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
+        if (lists->detpblk(nI) == 0)
+            return;
 
-            auto Cr = C_right.gather_C_block(CR, alfa, alfa_address, beta_address, class_Ia,
-                                             class_Ib, false);
+        size_t maxL = alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
+        if (maxL == 0)
+            return;
+        const auto [CR_t, CL_t] = thread_temp_space(tid, max_rows, maxL);
 
-            for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
-                // The string class on which we don't act must be the same for I and J
-                if ((alfa and (class_Ib != class_Jb)) or (not alfa and (class_Ia != class_Ja)))
-                    continue;
-                if (lists->detpblk(nJ) == 0)
-                    continue;
+        auto Cr = C_right.gather_C_block(CR_t, alfa, alfa_address, beta_address, class_Ia,
+                                         class_Ib, false);
 
-                // Get a pointer to the correct block of matrix C
-                auto Cl = C_left.gather_C_block(CL, alfa, alfa_address, beta_address, class_Ja,
-                                                class_Jb, false);
-
-                size_t maxL =
-                    alfa ? beta_address->strpcls(class_Ib) : alfa_address->strpcls(class_Ia);
-                if (maxL > 0) {
-                    for (size_t K = 0; K < maxK; ++K) {
-                        std::vector<H3StringSubstitution>& Krlist =
-                            alfa ? lists->get_alfa_3h_list(class_K, K, class_Ia)
-                                 : lists->get_beta_3h_list(class_K, K, class_Ib);
-                        std::vector<H3StringSubstitution>& Kllist =
-                            alfa ? lists->get_alfa_3h_list(class_K, K, class_Ja)
-                                 : lists->get_beta_3h_list(class_K, K, class_Jb);
-                        for (const auto& [sign_K, p, q, r, I] : Krlist) {
-                            for (const auto& [sign_L, s, t, u, J] : Kllist) {
-                                rdm_data[six_index(p, q, r, s, t, u, ncmo)] +=
-                                    sign_K * sign_L * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
-                            }
+        for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
+            // The string class on which we don't act must be the same for I and J
+            if ((alfa and (class_Ib != class_Jb)) or (not alfa and (class_Ia != class_Ja)))
+                continue;
+            if (lists->detpblk(nJ) == 0)
+                continue;
+
+            // Get a pointer to the correct block of matrix C
+            auto Cl = C_left.gather_C_block(CL_t, alfa, alfa_address, beta_address, class_Ja,
+                                            class_Jb, false);
+
+            for (int class_K = 0; class_K < num_3h_classes; ++class_K) {
+                size_t maxK = alfa ? lists->alfa_address_3h()->strpcls(class_K)
+                                   : lists->beta_address_3h()->strpcls(class_K);
+                for (size_t K = 0; K < maxK; ++K) {
+                    const auto& Krlist = alfa ? lists->get_alfa_3h_list(class_K, K, class_Ia)
+                                              : lists->get_beta_3h_list(class_K, K, class_Ib);
+                    const auto& Kllist = alfa ? lists->get_alfa_3h_list(class_K, K, class_Ja)
+                                              : lists->get_beta_3h_list(class_K, K, class_Jb);
+                    for (const auto& [sign_K, p, q, r, I] : Krlist) {
+                        for (const auto& [sign_L, s, t, u, J] : Kllist) {
+                            rdm_data[six_index(p, q, r, s, t, u, ncmo)] +=
+                                sign_K * sign_L * psi::C_DDOT(maxL, Cl[J], 1, Cr[I], 1);
                         }
                     }
                 }
             }
         }
-    }
+    });
     return rdm;
 }
 
@@ -467,30 +520,32 @@ ambit::Tensor GenCIVector::compute_3rdm_aab_same_irrep(GenCIVector& C_left, GenC
     auto rdm =
         ambit::Tensor::build(ambit::CoreTensor, "3RDM_AAB", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
     rdm.zero();
-    auto& rdm_data = rdm.data();
 
     int num_2h_class_Ka = lists->alfa_address_2h()->nclasses();
     int num_1h_class_Kb = lists->beta_address_1h()->nclasses();
 
-    for (int class_Ka = 0; class_Ka < num_2h_class_Ka; ++class_Ka) {
-        size_t maxKa = lists->alfa_address_2h()->strpcls(class_Ka);
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
 
-        for (int class_Kb = 0; class_Kb < num_1h_class_Kb; ++class_Kb) {
-            size_t maxKb = lists->beta_address_1h()->strpcls(class_Kb);
+    // loop over blocks of matrix C
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t /*tid*/, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
+        if (lists->detpblk(nI) == 0)
+            return;
 
-            // loop over blocks of matrix C
-            for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
-                if (lists->detpblk(nI) == 0)
-                    continue;
+        const auto Cr = C_right.C_[nI]->pointer();
 
-                const auto Cr = C_right.C_[nI]->pointer();
+        for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
+            if (lists->detpblk(nJ) == 0)
+                continue;
 
-                for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
-                    if (lists->detpblk(nJ) == 0)
-                        continue;
+            // Get a pointer to the correct block of matrix C
+            const auto Cl = C_left.C_[nJ]->pointer();
 
-                    // Get a pointer to the correct block of matrix C
-                    const auto Cl = C_left.C_[nJ]->pointer();
+            for (int class_Ka = 0; class_Ka < num_2h_class_Ka; ++class_Ka) {
+                size_t maxKa = lists->alfa_address_2h()->strpcls(class_Ka);
+
+                for (int class_Kb = 0; class_Kb < num_1h_class_Kb; ++class_Kb) {
+                    size_t maxKb = lists->beta_address_1h()->strpcls(class_Kb);
 
                     for (size_t Ka = 0; Ka < maxKa; ++Ka) {
                         auto& Ka_right_list = lists->get_alfa_2h_list(class_Ka, Ka, class_Ia);
@@ -517,7 +572,10 @@ ambit::Tensor GenCIVector::compute_3rdm_aab_same_irrep(GenCIVector& C_left, GenC
                 }
             }
         }
-    }
+    });
+    auto& rdm_data = rdm.data();
+    // each value of u writes to a different set of elements
+#pragma omp parallel for schedule(dynamic)
     for (size_t u = 0; u < ncmo; ++u) {
         for (size_t v = 0; v < u; ++v) {
             for (size_t w = 0; w < ncmo; ++w) {
@@ -550,30 +608,32 @@ ambit::Tensor GenCIVector::compute_3rdm_abb_same_irrep(GenCIVector& C_left, GenC
     auto rdm =
         ambit::Tensor::build(ambit::CoreTensor, "3RDM_ABB", {ncmo, ncmo, ncmo, ncmo, ncmo, ncmo});
     rdm.zero();
-    auto& rdm_data = rdm.data();
 
     int num_1h_class_Ka = lists->alfa_address_1h()->nclasses();
     int num_2h_class_Kb = lists->beta_address_2h()->nclasses();
 
-    for (int class_Ka = 0; class_Ka < num_1h_class_Ka; ++class_Ka) {
-        size_t maxKa = lists->alfa_address_1h()->strpcls(class_Ka);
+    const auto blocks = thread_blocks(lists, omp_get_max_threads());
 
-        for (int class_Kb = 0; class_Kb < num_2h_class_Kb; ++class_Kb) {
-            size_t maxKb = lists->beta_address_2h()->strpcls(class_Kb);
+    // loop over blocks of matrix C
+    accumulate_over_blocks(rdm.data(), blocks, [&](size_t /*tid*/, size_t b, double* rdm_data) {
+        const auto& [nI, class_Ia, class_Ib] = lists->determinant_classes()[b];
+        if (lists->detpblk(nI) == 0)
+            return;
 
-            // loop over blocks of matrix C
-            for (const auto& [nI, class_Ia, class_Ib] : lists->determinant_classes()) {
-                if (lists->detpblk(nI) == 0)
-                    continue;
+        const auto Cr = C_right.C_[nI]->pointer();
 
-                const auto Cr = C_right.C_[nI]->pointer();
+        for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
+            if (lists->detpblk(nJ) == 0)
+                continue;
 
-                for (const auto& [nJ, class_Ja, class_Jb] : lists->determinant_classes()) {
-                    if (lists->detpblk(nJ) == 0)
-                        continue;
+            // Get a pointer to the correct block of matrix C
+            const auto Cl = C_left.C_[nJ]->pointer();
+
+            for (int class_Ka = 0; class_Ka < num_1h_class_Ka; ++class_Ka) {
+                size_t maxKa = lists->alfa_address_1h()->strpcls(class_Ka);
 
-                    // Get a pointer to the correct block of matrix C
-                    const auto Cl = C_left.C_[nJ]->pointer();
+                for (int class_Kb = 0; class_Kb < num_2h_class_Kb; ++class_Kb) {
+                    size_t maxKb = lists->beta_address_2h()->strpcls(class_Kb);
 
                     for (size_t Ka = 0; Ka < maxKa; ++Ka) {
                         auto& Ka_right_list = lists->get_alfa_1h_list(class_Ka, Ka, class_Ia);
@@ -600,7 +660,10 @@ ambit::Tensor GenCIVector::compute_3rdm_abb_same_irrep(GenCIVector& C_left, GenC
                 }
             }
         }
-    }
+    });
+    auto& rdm_data = rdm.data();
+    // each value of u writes to a different set of elements
+#pragma omp parallel for
     for (size_t u = 0; u < ncmo; ++u) {
         for (size_t v = 0; v < ncmo; ++v) {
             for (size_t w = 0; w < v; ++w) {
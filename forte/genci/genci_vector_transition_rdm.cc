@@ -58,6 +58,10 @@ std::shared_ptr<RDMs> compute_transition_rdms(GenCIVector& C_left, GenCIVector&
             "two wave functions.");
     }
 
+    // the scratch is thread local, so it may not have been allocated on this thread
+    GenCIVector::allocate_temp_space(C_left.lists(), PrintLevel::Quiet);
+    GenCIVector::allocate_temp_space(C_right.lists(), PrintLevel::Quiet);
+
     ambit::Tensor g1a, g1b;
 
     if (max_rdm_level >= 1) {
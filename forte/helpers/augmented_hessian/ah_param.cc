@@ -0,0 +1,65 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <stdexcept>
+
+#include "helpers/augmented_hessian/ah_param.h"
+
+namespace forte {
+
+AH_PARAM::AH_PARAM() {
+    // set default values
+    print = 1;
+    epsilon = 1.0e-5;
+    maxiter = 20;
+    trust_radius = 0.4;
+    max_trust_radius = 1.0;
+    min_trust_radius = 1.0e-6;
+    maxiter_davidson = 20;
+}
+
+void AH_PARAM::check_param() {
+    if (epsilon <= 0)
+        throw std::runtime_error("Convergence threshold (epsilon) must > 0");
+
+    if (maxiter <= 0)
+        throw std::runtime_error("Max number of iterations (maxiter) must > 0");
+
+    if (min_trust_radius <= 0)
+        throw std::runtime_error("Min trust radius (min_trust_radius) must > 0");
+
+    if (max_trust_radius < min_trust_radius)
+        throw std::runtime_error("Max trust radius (max_trust_radius) must >= min_trust_radius");
+
+    if (trust_radius < min_trust_radius or trust_radius > max_trust_radius)
+        throw std::runtime_error("Trust radius must lie in [min_trust_radius, max_trust_radius]");
+
+    if (maxiter_davidson <= 0)
+        throw std::runtime_error("Max number of Davidson iterations (maxiter_davidson) must > 0");
+}
+} // namespace forte
@@ -0,0 +1,61 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+namespace forte {
+class AH_PARAM {
+  public:
+    /// Default constructor of the augmented Hessian parameter class set default values
+    AH_PARAM();
+
+    /// Check if the parameters make sense
+    void check_param();
+
+    /// Printing level
+    int print;
+
+    /// Convergence threshold to terminate the minimization: |g| < ε * max(1, |x|)
+    double epsilon;
+
+    /// Max number of iterations
+    int maxiter;
+
+    /// Initial trust radius (max absolute value allowed in the step vector)
+    double trust_radius;
+
+    /// Max trust radius
+    double max_trust_radius;
+
+    /// Min trust radius, the minimization stops if the trust radius becomes smaller
+    double min_trust_radius;
+
+    /// Max number of Davidson iterations to find the lowest eigenvector of the augmented Hessian
+    int maxiter_davidson;
+};
+} // namespace forte
@@ -0,0 +1,251 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "psi4/psi4-dec.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+#include "helpers/printing.h"
+#include "helpers/lbfgs/rosenbrock.h"
+#include "casscf/casscf_orb_grad.h"
+#include "augmented_hessian.h"
+
+using namespace psi;
+
+namespace forte {
+
+namespace {
+/// Return the largest absolute value of a vector
+double max_abs(const psi::Vector& v) {
+    double value = 0.0;
+    for (int h = 0; h < v.nirrep(); ++h) {
+        for (int i = 0; i < v.dimpi()[h]; ++i) {
+            value = std::max(value, std::fabs(v.get(h, i)));
+        }
+    }
+    return value;
+}
+} // namespace
+
+AugmentedHessian::AugmentedHessian(std::shared_ptr<AH_PARAM> param) : param_(param) {
+    param_->check_param();
+}
+
+template <class Foo> double AugmentedHessian::minimize(Foo& foo, std::shared_ptr<psi::Vector> x) {
+    dimpi_ = x->dimpi();
+
+    g_ = std::make_shared<psi::Vector>("g", dimpi_);
+    h0_ = std::make_shared<psi::Vector>("h0", dimpi_);
+    auto g_new = std::make_shared<psi::Vector>("g new", dimpi_);
+    auto x_new = std::make_shared<psi::Vector>("x new", dimpi_);
+    psi::Vector s("s", dimpi_);
+
+    trust_radius_ = param_->trust_radius;
+    iter_ = 0;
+    converged_ = false;
+
+    // compute the initial value and gradient
+    double fx = foo.evaluate(x, g_);
+
+    while (true) {
+        // test convergence
+        double g_norm = g_->norm();
+        if (g_norm <= param_->epsilon * std::max(1.0, x->norm())) {
+            converged_ = true;
+            break;
+        }
+        if (iter_ == param_->maxiter or trust_radius_ < param_->min_trust_radius)
+            break;
+
+        // step and predicted change from the augmented Hessian
+        foo.hess_diag(x, h0_);
+        double de_pred = compute_step(foo, x, s);
+        double step = max_abs(s);
+
+        // actual change
+        x_new->copy(*x);
+        x_new->axpy(1.0, s);
+        double fx_new = foo.evaluate(x_new, g_new);
+        double de = fx_new - fx;
+        double ratio = de_pred < 0.0 ? de / de_pred : 0.0;
+        ++iter_;
+
+        // update the trust radius
+        if (ratio < 0.25) {
+            trust_radius_ = 0.5 * step;
+        } else if (ratio > 0.75 and step > 0.8 * trust_radius_) {
+            trust_radius_ = std::min(2.0 * trust_radius_, param_->max_trust_radius);
+        }
+
+        bool accept = de <= 0.0;
+        if (param_->print > 2)
+            outfile->Printf("\n    AH Iter:%3d; fx = %20.15f; g_norm = %12.6e; step = %9.3e; "
+                            "ratio = %7.3f; trust = %9.3e%s",
+                            iter_, accept ? fx_new : fx, accept ? g_new->norm() : g_norm, step,
+                            ratio, trust_radius_,
+                            accept ? "" : "; rejected");
+
+        if (accept) {
+            x->copy(*x_new);
+            g_->copy(*g_new);
+            fx = fx_new;
+        } else {
+            // go back to the previous point
+            fx = foo.evaluate(x, g_);
+        }
+    }
+
+    if ((not converged_) and param_->print > 2) {
+        outfile->Printf("\n  AH Warning: No convergence in %d iterations", iter_);
+    }
+
+    return fx;
+}
+
+template <class Foo>
+double AugmentedHessian::compute_step(Foo& foo, std::shared_ptr<psi::Vector> x, psi::Vector& s) {
+    b_.clear();
+    sigma_.clear();
+
+    // the eigenvector is converged tighter as the gradient gets smaller
+    double g_norm = g_->norm();
+    double r_conv = std::max(std::min(0.1, g_norm) * g_norm, 0.1 * param_->epsilon);
+
+    // initial guess from the preconditioned gradient
+    psi::Vector r(*g_);
+    precondition(r, 0.0);
+    add_basis_vector(r);
+
+    // lowest eigenpair of the augmented Hessian in the basis {(1,0), (0,b_1), (0,b_2), ...}
+    double lambda = 0.0;
+    std::vector<double> c;
+    for (int k = 0;; ++k) {
+        auto sigma = std::make_shared<psi::Vector>("sigma", dimpi_);
+        foo.hess_vec(x, b_.back(), sigma);
+        sigma_.push_back(sigma);
+
+        int n = static_cast<int>(b_.size()) + 1;
+        auto M = std::make_shared<psi::Matrix>("Augmented Hessian", n, n);
+        for (int i = 1; i < n; ++i) {
+            double gi = g_->vector_dot(*b_[i - 1]);
+            M->set(0, i, gi);
+            M->set(i, 0, gi);
+            for (int j = 1; j <= i; ++j) {
+                double hij = 0.5 * (b_[i - 1]->vector_dot(*sigma_[j - 1]) +
+                                    b_[j - 1]->vector_dot(*sigma_[i - 1]));
+                M->set(i, j, hij);
+                M->set(j, i, hij);
+            }
+        }
+        auto evecs = std::make_shared<psi::Matrix>("evecs", n, n);
+        auto evals = std::make_shared<psi::Vector>("evals", n);
+        M->diagonalize(evecs, evals, ascending);
+
+        lambda = evals->get(0);
+        c.resize(n);
+        for (int i = 0; i < n; ++i)
+            c[i] = evecs->get(i, 0);
+
+        // residual
+        r.copy(*g_);
+        r.scale(c[0]);
+        for (int i = 1; i < n; ++i) {
+            r.axpy(c[i], *sigma_[i - 1]);
+            r.axpy(-lambda * c[i], *b_[i - 1]);
+        }
+        double r_norm = r.norm();
+
+        if (param_->print > 3)
+            outfile->Printf("\n      Davidson Iter:%3d; lambda = %15.10f; v0 = %12.6e; |r| = %9.3e",
+                            k + 1, lambda, c[0], r_norm);
+
+        if (r_norm < r_conv or k + 1 == param_->maxiter_davidson)
+            break;
+
+        precondition(r, lambda);
+        if (not add_basis_vector(r))
+            break;
+    }
+
+    // step s = v / v0 and its Hessian-vector product
+    psi::Vector Hs("Hs", dimpi_);
+    s.zero();
+    for (size_t i = 0; i < sigma_.size(); ++i) {
+        s.axpy(c[i + 1], *b_[i]);
+        Hs.axpy(c[i + 1], *sigma_[i]);
+    }
+    double v0 = std::fabs(c[0]) < 1.0e-8 ? 1.0e-8 : c[0];
+    double scale = 1.0 / v0;
+
+    // make sure it is a descent direction and limit it to the trust radius
+    if (s.vector_dot(*g_) * scale > 0.0)
+        scale = -scale;
+    double step = max_abs(s) * std::fabs(scale);
+    if (step > trust_radius_)
+        scale *= trust_radius_ / step;
+    s.scale(scale);
+    Hs.scale(scale);
+
+    return g_->vector_dot(s) + 0.5 * s.vector_dot(Hs);
+}
+
+void AugmentedHessian::precondition(psi::Vector& r, double shift) {
+    for (int h = 0; h < r.nirrep(); ++h) {
+        for (int i = 0; i < dimpi_[h]; ++i) {
+            double d = h0_->get(h, i) - shift;
+            if (std::fabs(d) < 1.0e-4)
+                d = d < 0.0 ? -1.0e-4 : 1.0e-4;
+            r.set(h, i, r.get(h, i) / d);
+        }
+    }
+}
+
+bool AugmentedHessian::add_basis_vector(psi::Vector& r) {
+    // Gram-Schmidt twice for numerical stability
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const auto& b : b_) {
+            r.axpy(-b->vector_dot(r), *b);
+        }
+    }
+
+    double norm = r.norm();
+    if (norm < 1.0e-10)
+        return false;
+
+    r.scale(1.0 / norm);
+    b_.push_back(std::make_shared<psi::Vector>(r));
+    return true;
+}
+
+template double AugmentedHessian::minimize(ROSENBROCK& func, std::shared_ptr<psi::Vector> x);
+template double AugmentedHessian::minimize(CASSCF_ORB_GRAD& func, std::shared_ptr<psi::Vector> x);
+} // namespace forte
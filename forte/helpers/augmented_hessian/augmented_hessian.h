@@ -0,0 +1,122 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "psi4/libmints/vector.h"
+
+#include "helpers/augmented_hessian/ah_param.h"
+
+namespace forte {
+
+class AugmentedHessian {
+  public:
+    /**
+     * @brief Constructor of the trust-region augmented Hessian minimizer
+     * @param param: The AH_PARAM object for augmented Hessian parameters
+     *
+     * Implementation notes:
+     *   In each iteration the step s = v / v0 is obtained from the lowest eigenvector of the
+     *   augmented Hessian
+     *     | 0  g^T | | v0 |     | v0 |
+     *     | g   H  | | v  | = λ | v  |
+     *   which is found by the Davidson method using Hessian-vector products. The largest element
+     *   of the step is limited by a trust radius that is updated by comparing the actual and the
+     *   predicted change of the function value. Steps that increase the function are rejected.
+     *   See Chem. Phys. Lett. 121, 7-12 (1985) and J. Chem. Phys. 82, 5053-5063 (1985)
+     */
+    AugmentedHessian(std::shared_ptr<AH_PARAM> param);
+
+    /**
+     * @brief The minimization for the target function
+     * @param foo: Target class that should have the following methods:
+     *             fx = foo.evaluate(x, g, do_g=true) where gradient g is modified by the function,
+     *             foo.hess_vec(x, v, Hv) that computes the product of the Hessian at x (the last
+     *             point evaluated) with v, and foo.hess_diag(x, h0) for preconditioning.
+     * @param x: The initial value of x as input, the final value of x as output.
+     *
+     * @return the function value of at optimized x
+     */
+    template <class Foo> double minimize(Foo& foo, std::shared_ptr<psi::Vector> x);
+
+    /// Return the current / final gradient vector
+    std::shared_ptr<psi::Vector> g() { return g_; }
+
+    /// Return the final number of iterations
+    int iter() const { return iter_; }
+
+    /// Return true if minimization converged
+    bool converged() const { return converged_; }
+
+  private:
+    /// The dimension of x
+    psi::Dimension dimpi_;
+
+    /// The current iteration number
+    int iter_;
+
+    /// Parameters of the augmented Hessian method
+    std::shared_ptr<AH_PARAM> param_;
+
+    /// Minimization procedure converged or not
+    bool converged_;
+
+    /// The current trust radius
+    double trust_radius_;
+
+    /// Diagonal elements of Hessian
+    std::shared_ptr<psi::Vector> h0_;
+
+    /// The current gradient vector
+    std::shared_ptr<psi::Vector> g_;
+
+    /// Davidson basis vectors of the augmented Hessian (without the first unit vector)
+    std::vector<std::shared_ptr<psi::Vector>> b_;
+
+    /// Hessian-vector products of the Davidson basis vectors
+    std::vector<std::shared_ptr<psi::Vector>> sigma_;
+
+    /**
+     * @brief Compute the step from the lowest eigenvector of the augmented Hessian
+     * @param s: the step vector (modified)
+     * @return the predicted change of the function value
+     */
+    template <class Foo>
+    double compute_step(Foo& foo, std::shared_ptr<psi::Vector> x, psi::Vector& s);
+
+    /// Divide r by (h0 - shift), small denominators are limited in magnitude
+    void precondition(psi::Vector& r, double shift);
+
+    /// Orthonormalize r against the basis vectors and add it to the basis
+    /// Return false if r is linearly dependent on the basis
+    bool add_basis_vector(psi::Vector& r);
+};
+} // namespace forte
@@ -0,0 +1,149 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "helpers/cache_file.h"
+
+namespace forte {
+
+namespace {
+/// the number of bytes needed to align the end of the signature to eight bytes
+size_t signature_padding(size_t signature_size) { return (8 - signature_size % 8) % 8; }
+} // namespace
+
+uint64_t fnv1a_hash(const void* data, size_t size, uint64_t hash) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string cache_filename(const std::string& directory, const std::string& kind,
+                           const std::string& signature) {
+    std::ostringstream name;
+    name << "forte." << kind << "." << std::hex << std::setw(16) << std::setfill('0')
+         << fnv1a_hash(signature.data(), signature.size()) << ".bin";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+CacheFileWriter::CacheFileWriter(const std::string& filename, const char (&magic)[8],
+                                 const std::string& signature)
+    : filename_(filename) {
+    // the temporary file name is unique to this process and thread (e.g., solvers of different
+    // states may write the same file concurrently)
+    std::ostringstream tmp_name;
+    tmp_name << filename << "." << getpid() << "." << std::this_thread::get_id() << ".tmp";
+    tmp_filename_ = tmp_name.str();
+    file_ = std::fopen(tmp_filename_.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("CacheFileWriter: cannot open the file " + tmp_filename_ + " (" +
+                                 std::strerror(errno) + ")");
+    }
+    write(magic, sizeof(magic));
+    const uint64_t signature_size = signature.size();
+    write(&signature_size, sizeof(signature_size));
+    write(signature.data(), signature.size());
+    const char zeros[8] = {};
+    write(zeros, signature_padding(signature.size()));
+}
+
+CacheFileWriter::~CacheFileWriter() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+        std::remove(tmp_filename_.c_str());
+    }
+}
+
+void CacheFileWriter::write(const void* data, size_t size) {
+    if (size > 0 and std::fwrite(data, 1, size, file_) != size)
+        ok_ = false;
+}
+
+void CacheFileWriter::commit() {
+    const bool closed = std::fclose(file_) == 0;
+    file_ = nullptr;
+    if (not(ok_ and closed) or std::rename(tmp_filename_.c_str(), filename_.c_str()) != 0) {
+        std::remove(tmp_filename_.c_str());
+        throw std::runtime_error("CacheFileWriter: cannot write the file " + filename_);
+    }
+}
+
+CacheFileReader::CacheFileReader(const std::string& filename, const char (&magic)[8],
+                                 const std::string& signature) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) != 0 or st.st_size == 0) {
+        close(fd);
+        return;
+    }
+    void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return;
+    data_ = static_cast<const char*>(ptr);
+    size_ = st.st_size;
+    // cache files are read sequentially
+    madvise(ptr, size_, MADV_SEQUENTIAL);
+
+    // check the header
+    if (size_ < sizeof(magic) + sizeof(uint64_t) or
+        std::memcmp(data_, magic, sizeof(magic)) != 0) {
+        return;
+    }
+    pos_ = sizeof(magic);
+    const auto signature_size = get<uint64_t>();
+    const auto header_size = signature_size + signature_padding(signature_size);
+    if (signature_size != signature.size() or header_size > size_ - pos_ or
+        signature.compare(0, signature.size(), data_ + pos_, signature_size) != 0) {
+        return;
+    }
+    pos_ += header_size;
+    valid_ = true;
+}
+
+CacheFileReader::~CacheFileReader() {
+    if (data_)
+        munmap(const_cast<char*>(data_), size_);
+}
+
+} // namespace forte
@@ -0,0 +1,135 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace forte {
+
+/// @brief Compute the 64-bit FNV-1a hash of a block of memory. The hash is stable across runs and
+///        platforms (unlike std::hash) and can be chained by passing the hash of the previous block
+uint64_t fnv1a_hash(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL);
+
+/// @brief Return the name of a cache file, "forte.<kind>.<hash of the signature>.bin"
+/// @param directory the directory where the file is stored
+/// @param kind the kind of data stored in the file
+/// @param signature a string that uniquely identifies the data stored in the file
+std::string cache_filename(const std::string& directory, const std::string& kind,
+                           const std::string& signature);
+
+/// @brief Write a binary cache file
+///
+/// The file starts with a header made of an 8-character magic string that identifies the format,
+/// the size of the signature, the signature, and zero padding to eight bytes. The header is
+/// checked when the file is read back with CacheFileReader. The data is streamed to a temporary
+/// file that is renamed by commit(), so other processes never see a partially written file. If
+/// commit() is not called the temporary file is removed.
+class CacheFileWriter {
+  public:
+    /// Open the temporary file and write the header. Throws std::runtime_error if the file cannot
+    /// be created
+    /// @param filename the name of the cache file
+    /// @param magic an 8-character string that identifies the format of the file
+    /// @param signature a string that uniquely identifies the data stored in the file
+    CacheFileWriter(const std::string& filename, const char (&magic)[8],
+                    const std::string& signature);
+    ~CacheFileWriter();
+
+    CacheFileWriter(const CacheFileWriter&) = delete;
+    CacheFileWriter& operator=(const CacheFileWriter&) = delete;
+
+    /// Append size bytes
+    void write(const void* data, size_t size);
+
+    /// Close the temporary file and rename it. Throws std::runtime_error if any write failed
+    void commit();
+
+  private:
+    std::string filename_;
+    std::string tmp_filename_;
+    std::FILE* file_ = nullptr;
+    bool ok_ = true;
+};
+
+/// @brief Read a file written by CacheFileWriter
+///
+/// The file is memory-mapped and read sequentially. The data that follows the header starts at an
+/// offset that is a multiple of eight bytes.
+class CacheFileReader {
+  public:
+    /// Map a file. If the file does not exist or its header does not match the magic string and
+    /// the signature valid() returns false
+    CacheFileReader(const std::string& filename, const char (&magic)[8],
+                    const std::string& signature);
+    ~CacheFileReader();
+
+    CacheFileReader(const CacheFileReader&) = delete;
+    CacheFileReader& operator=(const CacheFileReader&) = delete;
+
+    /// @return true if the file was mapped and its header matches the magic string and signature
+    bool valid() const { return valid_; }
+
+    /// @return true if all the data in the file was read
+    bool at_end() const { return pos_ == size_; }
+
+    /// Throw std::runtime_error if less than n bytes are left in the file
+    void check(size_t n) const {
+        if (n > size_ - pos_)
+            throw std::runtime_error("CacheFileReader: the file is truncated or corrupt");
+    }
+
+    /// Return a pointer to the next n bytes of the mapped file and skip them. The pointer is valid
+    /// for the lifetime of the reader. Throws std::runtime_error if the file is truncated
+    const char* read(size_t n) {
+        check(n);
+        const char* ptr = data_ + pos_;
+        pos_ += n;
+        return ptr;
+    }
+
+    /// Read a value of a trivially copyable type. Throws std::runtime_error if the file is
+    /// truncated
+    template <class T> T get() {
+        T x;
+        std::memcpy(&x, read(sizeof(T)), sizeof(T));
+        return x;
+    }
+
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    bool valid_ = false;
+};
+
+} // namespace forte
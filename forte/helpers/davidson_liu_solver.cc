@@ -149,6 +149,11 @@ void DavidsonLiuSolver::add_sigma_builder(
     sigma_builder_ = sigma_builder;
 }
 
+void DavidsonLiuSolver::add_block_sigma_builder(
+    std::function<void(std::span<double>, std::span<double>, size_t)> block_sigma_builder) {
+    block_sigma_builder_ = block_sigma_builder;
+}
+
 void DavidsonLiuSolver::reset() {
     basis_size_ = 0;
     sigma_size_ = 0;
@@ -321,7 +326,7 @@ void DavidsonLiuSolver::setup_guesses() {
 
 void DavidsonLiuSolver::preiteration_sanity_checks() {
     // check that the sigma builder has been set
-    if (sigma_builder_ == nullptr) {
+    if ((sigma_builder_ == nullptr) and (block_sigma_builder_ == nullptr)) {
         std::string msg = "DavidsonLiuSolver: sigma builder has not been set";
         throw std::runtime_error(msg);
     }
@@ -369,10 +374,22 @@ void DavidsonLiuSolver::print_iteration(size_t iter) {
 }
 
 void DavidsonLiuSolver::compute_sigma() {
-    for (size_t j = sigma_size_; j < basis_size_; j++) {
-        auto bj = b_->pointer()[j];
-        auto sigmaj = sigma_->pointer()[j];
-        sigma_builder_(std::span(bj, size_), std::span(sigmaj, size_));
+    if (block_sigma_builder_) {
+        // The rows of b_ and sigma_ are stored contiguously, so we can pass several of them at
+        // once. Blocks are limited to nroot_ vectors, the number of vectors added per iteration
+        for (size_t j = sigma_size_; j < basis_size_; j += nroot_) {
+            const size_t nvec = std::min(nroot_, basis_size_ - j);
+            auto bj = b_->pointer()[j];
+            auto sigmaj = sigma_->pointer()[j];
+            block_sigma_builder_(std::span(bj, nvec * size_), std::span(sigmaj, nvec * size_),
+                                 nvec);
+        }
+    } else {
+        for (size_t j = sigma_size_; j < basis_size_; j++) {
+            auto bj = b_->pointer()[j];
+            auto sigmaj = sigma_->pointer()[j];
+            sigma_builder_(std::span(bj, size_), std::span(sigmaj, size_));
+        }
     }
     // update the number of sigma vectors
     sigma_size_ = basis_size_;
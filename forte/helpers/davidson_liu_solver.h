@@ -58,6 +58,13 @@ class DavidsonLiuSolver {
 
     /// Setup the solver
     void add_sigma_builder(std::function<void(std::span<double>, std::span<double>)> sigma_builder);
+    /// @brief Add a function that builds the sigma vectors of a block of basis vectors in one call
+    /// @details The function takes the basis vectors (b), the sigma vectors (sigma), and the number
+    /// of vectors in the block (nvec). Vector n is stored in the elements
+    /// [n * size, (n + 1) * size) of b and sigma. If set, this function is used instead of the
+    /// one-vector sigma builder.
+    void add_block_sigma_builder(
+        std::function<void(std::span<double>, std::span<double>, size_t)> block_sigma_builder);
     void add_h_diag(std::shared_ptr<psi::Vector> h_diag);
     void add_guesses(const std::vector<sparse_vec>& guesses);
     void add_project_out_vectors(const std::vector<sparse_vec>& project_out_vectors);
@@ -104,6 +111,8 @@ class DavidsonLiuSolver {
     // Passed in by the user at setup
     /// The sigma builder function
     std::function<void(std::span<double>, std::span<double>)> sigma_builder_;
+    /// The block sigma builder function
+    std::function<void(std::span<double>, std::span<double>, size_t)> block_sigma_builder_;
     /// Diagonal elements of the Hamiltonian
     std::shared_ptr<psi::Vector> h_diag_;
     /// The initial guess
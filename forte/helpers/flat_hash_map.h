@@ -0,0 +1,331 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace forte {
+
+/// @brief An open-addressing hash map with contiguous storage
+///
+/// The key/value pairs are stored in insertion order in a dense vector, so iterating over the map
+/// is a linear scan of memory. Lookups go through a separate power-of-two table of 64-bit slots
+/// probed linearly. Each slot packs the upper 32 bits of the hash (a tag) and the index of the
+/// entry plus one (zero marks an empty slot), so most probes that do not match are rejected
+/// without touching the entries.
+///
+/// The hash function must return well-mixed 64-bit values since the low bits select the home slot
+/// and the high bits are used as the tag (see BitArray::MixHash).
+///
+/// Differences with std::unordered_map:
+/// - inserting may invalidate iterators and references to the entries
+/// - erasing moves the last entry into the position of the erased one
+/// - the key of an entry must not be modified through an iterator
+template <class Key, class T, class Hash = std::hash<Key>> class FlatHashMap {
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using hasher = Hash;
+    using size_type = std::size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    FlatHashMap() = default;
+
+    /// Construct from a range of key/value pairs (e.g. a std::unordered_map)
+    template <class InputIt> FlatHashMap(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            try_emplace(first->first, first->second);
+        }
+    }
+
+    /*- Iterators -*/
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    const_iterator cbegin() const { return entries_.cbegin(); }
+    const_iterator cend() const { return entries_.cend(); }
+
+    /*- Capacity -*/
+    size_type size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    /// @return the number of slots in the lookup table
+    size_type bucket_count() const { return slots_.size(); }
+    float load_factor() const {
+        return slots_.empty() ? 0.0f : static_cast<float>(size()) / slots_.size();
+    }
+
+    /*- Hash policy -*/
+    hasher hash_function() const { return hash_; }
+
+    /// @return the hash of a key. This value can be passed to the *_hashed functions to avoid
+    /// computing the hash of the same key more than once
+    std::uint64_t hash_key(const Key& key) const { return hash_(key); }
+
+    /// Reserve space for at least n entries without rehashing
+    void reserve(size_type n) {
+        entries_.reserve(n);
+        hashes_.reserve(n);
+        if (n > max_load(slots_.size())) {
+            rehash(table_size_for(n));
+        }
+    }
+
+    /*- Lookup -*/
+    iterator find(const Key& key) { return find_hashed(key, hash_(key)); }
+    const_iterator find(const Key& key) const { return find_hashed(key, hash_(key)); }
+
+    iterator find_hashed(const Key& key, std::uint64_t hash) {
+        size_type idx = find_index(key, hash);
+        return idx == npos ? entries_.end() : entries_.begin() + idx;
+    }
+    const_iterator find_hashed(const Key& key, std::uint64_t hash) const {
+        size_type idx = find_index(key, hash);
+        return idx == npos ? entries_.end() : entries_.begin() + idx;
+    }
+
+    size_type count(const Key& key) const { return find_index(key, hash_(key)) != npos; }
+    bool contains(const Key& key) const { return count(key) != 0; }
+
+    /// @return a reference to the value of key. Throws std::out_of_range if key is not found
+    T& at(const Key& key) {
+        size_type idx = find_index(key, hash_(key));
+        if (idx == npos) {
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        }
+        return entries_[idx].second;
+    }
+    const T& at(const Key& key) const {
+        size_type idx = find_index(key, hash_(key));
+        if (idx == npos) {
+            throw std::out_of_range("FlatHashMap::at: key not found");
+        }
+        return entries_[idx].second;
+    }
+
+    /*- Modifiers -*/
+    T& operator[](const Key& key) { return try_emplace_hashed(key, hash_(key)).first->second; }
+
+    template <class... Args> std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return try_emplace_hashed(key, hash_(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace_hashed(value.first, hash_(value.first), value.second);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    /// Insert the entry (key, T(args...)) if key is not in the map.
+    /// @param hash the value of hash_key(key)
+    /// @return an iterator to the entry of key and true if the entry was inserted
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace_hashed(const Key& key, std::uint64_t hash,
+                                                 Args&&... args) {
+        if (size() + 1 > max_load(slots_.size())) {
+            rehash(slots_.empty() ? min_table_size : 2 * slots_.size());
+        }
+        const std::uint64_t tag = hash & tag_mask;
+        size_type pos = hash & mask_;
+        while (slots_[pos] != 0) {
+            const std::uint64_t slot = slots_[pos];
+            if ((slot & tag_mask) == tag) {
+                const size_type idx = (slot & index_mask) - 1;
+                if (entries_[idx].first == key) {
+                    return {entries_.begin() + idx, false};
+                }
+            }
+            pos = (pos + 1) & mask_;
+        }
+        if (size() >= max_entries) {
+            throw std::runtime_error("FlatHashMap: the number of entries exceeds 2^32 - 2");
+        }
+        entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        hashes_.push_back(hash);
+        slots_[pos] = tag | entries_.size();
+        return {entries_.end() - 1, true};
+    }
+
+    /// Erase the entry with a given key. The last entry is moved in its place
+    /// @return the number of entries erased (0 or 1)
+    size_type erase(const Key& key) {
+        size_type idx = find_index(key, hash_(key));
+        if (idx == npos) {
+            return 0;
+        }
+        erase_index(idx);
+        return 1;
+    }
+
+    /// Erase the entry pointed to by it. The last entry is moved in its place
+    /// @return an iterator to the entry that took the place of the erased one
+    iterator erase(const_iterator it) {
+        const size_type idx = it - entries_.cbegin();
+        erase_index(idx);
+        return entries_.begin() + idx;
+    }
+
+    /// Remove all the entries but keep the memory allocated
+    void clear() {
+        if (entries_.size() * 8 < slots_.size()) {
+            // sparse table: zero only the slots that are in use
+            for (size_type idx = 0; idx < entries_.size(); ++idx) {
+                slots_[slot_of_index(idx)] = 0;
+            }
+        } else {
+            std::fill(slots_.begin(), slots_.end(), 0);
+        }
+        entries_.clear();
+        hashes_.clear();
+    }
+
+    void swap(FlatHashMap& other) {
+        entries_.swap(other.entries_);
+        hashes_.swap(other.hashes_);
+        slots_.swap(other.slots_);
+        std::swap(mask_, other.mask_);
+        std::swap(hash_, other.hash_);
+    }
+
+  private:
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type min_table_size = 16;
+    static constexpr std::uint64_t index_mask = 0xFFFFFFFFULL;
+    static constexpr std::uint64_t tag_mask = ~index_mask;
+    static constexpr size_type max_entries = index_mask - 1;
+
+    /// The key/value pairs in insertion order
+    std::vector<value_type> entries_;
+    /// The hash of each entry (used to rehash and erase without calling the hash function)
+    std::vector<std::uint64_t> hashes_;
+    /// The lookup table. Each slot stores (tag | (index + 1)), zero for an empty slot
+    std::vector<std::uint64_t> slots_;
+    /// The number of slots minus one
+    size_type mask_ = 0;
+    Hash hash_;
+
+    /// The maximum number of entries for a table of n slots (load factor 3/4)
+    static size_type max_load(size_type n) { return n - n / 4; }
+
+    static size_type table_size_for(size_type n) {
+        size_type size = min_table_size;
+        while (max_load(size) < n) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    size_type find_index(const Key& key, std::uint64_t hash) const {
+        if (entries_.empty()) {
+            return npos;
+        }
+        const std::uint64_t tag = hash & tag_mask;
+        size_type pos = hash & mask_;
+        while (slots_[pos] != 0) {
+            const std::uint64_t slot = slots_[pos];
+            if ((slot & tag_mask) == tag) {
+                const size_type idx = (slot & index_mask) - 1;
+                if (entries_[idx].first == key) {
+                    return idx;
+                }
+            }
+            pos = (pos + 1) & mask_;
+        }
+        return npos;
+    }
+
+    /// @return the position of the slot that points to the entry with index idx
+    size_type slot_of_index(size_type idx) const {
+        const std::uint64_t target = idx + 1;
+        size_type pos = hashes_[idx] & mask_;
+        while ((slots_[pos] & index_mask) != target) {
+            pos = (pos + 1) & mask_;
+        }
+        return pos;
+    }
+
+    void rehash(size_type new_size) {
+        slots_.assign(new_size, 0);
+        mask_ = new_size - 1;
+        for (size_type idx = 0; idx < entries_.size(); ++idx) {
+            size_type pos = hashes_[idx] & mask_;
+            while (slots_[pos] != 0) {
+                pos = (pos + 1) & mask_;
+            }
+            slots_[pos] = (hashes_[idx] & tag_mask) | (idx + 1);
+        }
+    }
+
+    void erase_index(size_type idx) {
+        // remove the slot with backward-shift deletion, so that no tombstones are needed
+        size_type hole = slot_of_index(idx);
+        size_type pos = hole;
+        while (true) {
+            pos = (pos + 1) & mask_;
+            const std::uint64_t slot = slots_[pos];
+            if (slot == 0) {
+                break;
+            }
+            const size_type home = hashes_[(slot & index_mask) - 1] & mask_;
+            // the entry at pos can fill the hole only if its home is not in the range (hole, pos]
+            const bool in_range =
+                (hole <= pos) ? (hole < home and home <= pos) : (hole < home or home <= pos);
+            if (not in_range) {
+                slots_[hole] = slot;
+                hole = pos;
+            }
+        }
+        slots_[hole] = 0;
+
+        // move the last entry in place of the erased one
+        const size_type last = entries_.size() - 1;
+        if (idx != last) {
+            const size_type last_slot = slot_of_index(last);
+            slots_[last_slot] = (slots_[last_slot] & tag_mask) | (idx + 1);
+            entries_[idx] = std::move(entries_[last]);
+            hashes_[idx] = hashes_[last];
+        }
+        entries_.pop_back();
+        hashes_.pop_back();
+    }
+};
+
+} // namespace forte
@@ -218,9 +218,10 @@ std::vector<std::tuple<int, size_t, size_t>> find_integer_groups(const std::vect
 #include <limits>
 
 // Function to compare two hash maps
-template <typename T, typename S, typename Q>
-bool compare_hashes(const std::unordered_map<T, S, Q>& hash1,
-                    const std::unordered_map<T, S, Q>& hash2, S tolerance = S(1e-12)) {
+template <typename Map>
+bool compare_hashes(const Map& hash1, const Map& hash2,
+                    typename Map::mapped_type tolerance = typename Map::mapped_type(1e-12)) {
+    using S = typename Map::mapped_type;
     // Go through the first hash
     for (const auto& [key, value] : hash1) {
         auto it = hash2.find(key);
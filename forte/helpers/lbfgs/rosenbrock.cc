@@ -31,6 +31,8 @@
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "helpers/lbfgs/lbfgs_param.h"
 #include "helpers/lbfgs/lbfgs.h"
+#include "helpers/augmented_hessian/ah_param.h"
+#include "helpers/augmented_hessian/augmented_hessian.h"
 
 #include "rosenbrock.h"
 
@@ -73,6 +75,21 @@ void ROSENBROCK::hess_diag(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::
     }
 }
 
+void ROSENBROCK::hess_vec(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::Vector> v,
+                          std::shared_ptr<psi::Vector> Hv) {
+    check_dim(x);
+    check_dim(v);
+    check_dim(Hv);
+
+    for (int i = 0; i < n_; i += 2) {
+        double xi = x->get(i);
+        double t2 = 10 * (xi * xi - x->get(i + 1));
+        double h_xy = -400 * xi;
+        Hv->set(i, 2.0 * (1 + 400 * xi * xi + 20 * t2) * v->get(i) + h_xy * v->get(i + 1));
+        Hv->set(i + 1, h_xy * v->get(i) + 200 * v->get(i + 1));
+    }
+}
+
 void ROSENBROCK::check_dim(std::shared_ptr<psi::Vector> x) {
     if (x->dimpi().sum() != x->dim(0)) {
         std::runtime_error("Irrep not supported for Rosenbrock tests");
@@ -112,4 +129,32 @@ double test_lbfgs_rosenbrock(int n, int h0_freq) {
 
     return fx;
 }
+
+double test_ah_rosenbrock(int n) {
+    // augmented Hessian parameters
+    auto param = std::make_shared<AH_PARAM>();
+    param->epsilon = 1.0e-6;
+    param->maxiter = 100;
+    param->print = 3;
+
+    // augmented Hessian solver
+    AugmentedHessian ah_solver(param);
+
+    // Rosenbrock function
+    ROSENBROCK rosenbrock(n);
+
+    // initial guess
+    auto x = std::make_shared<psi::Vector>("x", n);
+
+    double fx = ah_solver.minimize(rosenbrock, x);
+
+    // print final results
+    psi::outfile->Printf("\n");
+    psi::outfile->Printf("\n  Augmented Hessian converged in %d iterations.", ah_solver.iter());
+    psi::outfile->Printf("\n  Final function value f(x) = %.15f", fx);
+    psi::outfile->Printf("\n  Optimized vector x:\n");
+    x->print();
+
+    return fx;
+}
 } // namespace forte
@@ -51,6 +51,10 @@ class ROSENBROCK {
     /// Compute the diagonal Hessian
     void hess_diag(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::Vector> h0);
 
+    /// Compute the product of the Hessian with a vector v
+    void hess_vec(std::shared_ptr<psi::Vector> x, std::shared_ptr<psi::Vector> v,
+                  std::shared_ptr<psi::Vector> Hv);
+
   private:
     /// Size of the problem
     int n_;
@@ -60,4 +64,6 @@ class ROSENBROCK {
 };
 /// Test L-BFGS on Rosenbrock function
 double test_lbfgs_rosenbrock(int n, int h0_freq = 0);
+/// Test the augmented Hessian method on Rosenbrock function
+double test_ah_rosenbrock(int n);
 } // namespace forte
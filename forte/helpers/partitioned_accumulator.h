@@ -0,0 +1,189 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER,
+ * AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "helpers/flat_hash_map.h"
+
+namespace forte {
+
+/// Combine two values with +=
+struct AddAssign {
+    template <class T> void operator()(T& accumulated, const T& value) const {
+        accumulated += value;
+    }
+};
+
+/// Combine two vectors of the same size element by element with +=
+struct ElementwiseAddAssign {
+    template <class T>
+    void operator()(std::vector<T>& accumulated, const std::vector<T>& value) const {
+        for (size_t n = 0, maxn = value.size(); n < maxn; ++n)
+            accumulated[n] += value[n];
+    }
+};
+
+/// @brief Accumulate (key, value) pairs produced by several threads without locks
+///
+/// Each thread combines its pairs in private hash maps, one per partition, so a thread stores each
+/// key at most once per partition no matter how many times it adds it. The partition of a key is
+/// given by the top bits of its hash. In merge() each partition is reduced by a single thread into
+/// its own FlatHashMap, so no synchronization is needed and the partitions are merged in parallel.
+/// The maps of a partition are merged in thread order, so the result does not depend on the
+/// scheduling of the threads. Values with the same key are combined with
+/// Reduce()(T& accumulated, const T& value).
+///
+/// Typical use:
+///   PartitionedAccumulator<Determinant, double, Determinant::MixHash> acc(num_threads);
+///   #pragma omp parallel num_threads(num_threads)
+///   { ... acc.add(omp_get_thread_num(), det, value); ... }
+///   acc.merge();
+///   acc.for_each([](size_t n, const Determinant& d, double v) { ... });
+template <class Key, class T, class Hash = std::hash<Key>, class Reduce = AddAssign>
+class PartitionedAccumulator {
+  public:
+    using map_type = FlatHashMap<Key, T, Hash>;
+
+    /// @param num_threads the number of threads that add pairs and merge the partitions
+    /// @param num_partitions the number of partitions (rounded up to a power of two). If zero,
+    ///        eight partitions per thread are used
+    PartitionedAccumulator(size_t num_threads, size_t num_partitions = 0)
+        : num_threads_(std::max<size_t>(num_threads, 1)) {
+        if (num_partitions == 0)
+            num_partitions = 8 * num_threads_;
+        num_partitions_ = std::bit_ceil(num_partitions);
+        partition_bits_ = std::countr_zero(num_partitions_);
+        buffers_.resize(num_threads_ * num_partitions_);
+        partitions_.resize(num_partitions_);
+    }
+
+    size_t num_threads() const { return num_threads_; }
+    size_t num_partitions() const { return num_partitions_; }
+
+    /// Add a pair to the maps of thread tid. Different threads can call this concurrently
+    void add(size_t tid, const Key& key, T value) {
+        const std::uint64_t hash = hash_(key);
+        auto& buffer = buffers_[tid * num_partitions_ + partition_of(hash)];
+        auto [it, inserted] = buffer.try_emplace_hashed(key, hash, std::move(value));
+        if (not inserted)
+            reduce_(it->second, value);
+    }
+
+    /// @return the number of entries stored in the maps of the threads (not merged yet)
+    size_t num_buffered() const {
+        size_t n = 0;
+        for (const auto& buffer : buffers_)
+            n += buffer.size();
+        return n;
+    }
+
+    /// Merge the maps of the threads into the partitions and release them
+    void merge() {
+        const auto nparts = static_cast<std::int64_t>(num_partitions_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+        for (std::int64_t p = 0; p < nparts; ++p) {
+            auto& map = partitions_[p];
+            for (size_t t = 0; t < num_threads_; ++t) {
+                auto& buffer = buffers_[t * num_partitions_ + p];
+                if (map.empty()) {
+                    map.swap(buffer);
+                    continue;
+                }
+                for (auto& [key, value] : buffer) {
+                    auto [it, inserted] = map.try_emplace(key, std::move(value));
+                    if (not inserted)
+                        reduce_(it->second, value);
+                }
+                map_type().swap(buffer);
+            }
+        }
+    }
+
+    /// Remove a key from the merged partitions
+    /// @return the number of entries erased (0 or 1)
+    size_t erase(const Key& key) { return partitions_[partition_of(hash_(key))].erase(key); }
+
+    /// Remove all the entries and release the memory
+    void clear() {
+        for (auto& buffer : buffers_)
+            map_type().swap(buffer);
+        for (auto& map : partitions_)
+            map_type().swap(map);
+    }
+
+    /// @return the number of merged entries
+    size_t size() const {
+        size_t n = 0;
+        for (const auto& map : partitions_)
+            n += map.size();
+        return n;
+    }
+
+    const map_type& partition(size_t p) const { return partitions_[p]; }
+
+    /// Call f(n, key, value) for every merged entry in parallel, where n is the index of the entry
+    /// in [0, size()) when the partitions are laid out one after the other
+    template <class F> void for_each(F f) const {
+        std::vector<size_t> offsets(num_partitions_ + 1, 0);
+        for (size_t p = 0; p < num_partitions_; ++p)
+            offsets[p + 1] = offsets[p] + partitions_[p].size();
+        const auto nparts = static_cast<std::int64_t>(num_partitions_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+        for (std::int64_t p = 0; p < nparts; ++p) {
+            size_t n = offsets[p];
+            for (const auto& [key, value] : partitions_[p]) {
+                f(n, key, value);
+                ++n;
+            }
+        }
+    }
+
+  private:
+    /// the top bits of the hash select the partition. The low bits are left to FlatHashMap to
+    /// select the slots within a partition
+    size_t partition_of(std::uint64_t hash) const {
+        return partition_bits_ == 0 ? 0 : hash >> (64 - partition_bits_);
+    }
+
+    size_t num_threads_;
+    size_t num_partitions_;
+    int partition_bits_;
+    Hash hash_;
+    Reduce reduce_;
+    /// the map of thread t for partition p is stored in buffers_[t * num_partitions_ + p]
+    std::vector<map_type> buffers_;
+    std::vector<map_type> partitions_;
+};
+
+} // namespace forte
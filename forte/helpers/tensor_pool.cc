@@ -0,0 +1,234 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "psi4/libpsi4util/PsiOutStream.h"
+
+#include "helpers/helpers.h"
+#include "helpers/printing.h"
+#include "helpers/tensor_pool.h"
+
+namespace forte {
+
+PooledTensor::PooledTensor(TensorPool* pool, std::string key, ambit::BlockedTensor tensor,
+                           size_t numel)
+    : ambit::BlockedTensor(tensor), pool_(pool), key_(std::move(key)), numel_(numel) {}
+
+PooledTensor::~PooledTensor() { release(); }
+
+PooledTensor::PooledTensor(PooledTensor&& other) noexcept
+    : ambit::BlockedTensor(other), pool_(other.pool_), key_(std::move(other.key_)),
+      numel_(other.numel_) {
+    other.pool_ = nullptr;
+    static_cast<ambit::BlockedTensor&>(other) = ambit::BlockedTensor();
+}
+
+PooledTensor& PooledTensor::operator=(PooledTensor&& other) noexcept {
+    if (this != &other) {
+        release();
+        static_cast<ambit::BlockedTensor&>(*this) = other;
+        pool_ = other.pool_;
+        key_ = std::move(other.key_);
+        numel_ = other.numel_;
+        other.pool_ = nullptr;
+        static_cast<ambit::BlockedTensor&>(other) = ambit::BlockedTensor();
+    }
+    return *this;
+}
+
+void PooledTensor::release() {
+    if (pool_ != nullptr) {
+        pool_->release(key_, *this, numel_);
+        pool_ = nullptr;
+    }
+    static_cast<ambit::BlockedTensor&>(*this) = ambit::BlockedTensor();
+}
+
+TensorPool::TensorPool(ambit::TensorType type) : type_(type) {}
+
+PooledTensor TensorPool::get(const std::string& name, const std::vector<std::string>& blocks) {
+    std::string key;
+    for (const auto& block : blocks)
+        key += block + ",";
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(idle_.begin(), idle_.end(),
+                               [&](const IdleTensor& t) { return t.key == key; });
+        if (it != idle_.end()) {
+            auto tensor = std::move(it->tensor);
+            const size_t numel = it->numel;
+            idle_.erase(it);
+            numel_idle_ -= numel;
+            numel_in_use_ += numel;
+            num_reuses_ += 1;
+            // the previous user left its data in the tensor
+            tensor.zero();
+            return PooledTensor(this, key, tensor, numel);
+        }
+    }
+
+    auto tensor = ambit::BlockedTensor::build(type_, name, blocks);
+    size_t numel = 0;
+    for (const auto& block : tensor.block_labels())
+        numel += tensor.block(block).numel();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    numel_in_use_ += numel;
+    peak_numel_ = std::max(peak_numel_, numel_in_use_);
+    num_allocations_ += 1;
+    return PooledTensor(this, key, tensor, numel);
+}
+
+void TensorPool::release(const std::string& key, ambit::BlockedTensor tensor, size_t numel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    numel_in_use_ -= numel;
+    idle_.push_back({key, tensor, numel, clock_++});
+    numel_idle_ += numel;
+    trim();
+}
+
+void TensorPool::trim() {
+    const size_t limit = std::max(limit_, peak_numel_);
+    while (not idle_.empty() and numel_in_use_ + numel_idle_ > limit) {
+        auto oldest = std::min_element(
+            idle_.begin(), idle_.end(),
+            [](const IdleTensor& a, const IdleTensor& b) { return a.last_use < b.last_use; });
+        numel_idle_ -= oldest->numel;
+        idle_.erase(oldest);
+    }
+}
+
+void TensorPool::set_memory_limit(size_t numel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limit_ = numel;
+    trim();
+}
+
+void TensorPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.clear();
+    numel_idle_ = 0;
+}
+
+size_t TensorPool::numel_in_use() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numel_in_use_;
+}
+
+size_t TensorPool::peak_numel() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_numel_;
+}
+
+size_t TensorPool::numel_idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numel_idle_;
+}
+
+void TensorPool::print_summary(const std::string& title) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (num_allocations_ == 0)
+        return;
+    print_h2(title);
+    auto peak = to_xb(peak_numel_, sizeof(double));
+    auto idle = to_xb(numel_idle_, sizeof(double));
+    psi::outfile->Printf("\n    Peak memory of temporaries   %10.3f %2s", peak.first,
+                         peak.second.c_str());
+    psi::outfile->Printf("\n    Memory of idle temporaries   %10.3f %2s", idle.first,
+                         idle.second.c_str());
+    psi::outfile->Printf("\n    Temporaries allocated        %10zu", num_allocations_);
+    psi::outfile->Printf("\n    Temporaries reused           %10zu", num_reuses_);
+}
+
+void test_tensor_pool() {
+    auto check = [](bool condition, const std::string& what) {
+        if (not condition)
+            throw std::runtime_error("test_tensor_pool: " + what);
+    };
+    auto is_zero = [](ambit::BlockedTensor& T) {
+        bool zero = true;
+        T.iterate([&](const std::vector<size_t>&, const std::vector<ambit::SpinType>&,
+                      double& value) { zero = zero and value == 0.0; });
+        return zero;
+    };
+
+    ambit::BlockedTensor::reset_mo_spaces();
+    ambit::BlockedTensor::add_mo_space("o", "i,j", {0, 1}, ambit::NoSpin);
+    ambit::BlockedTensor::add_mo_space("v", "a,b", {2, 3, 4}, ambit::NoSpin);
+
+    TensorPool pool;
+
+    // a new tensor has the requested blocks and is zero
+    auto T = pool.get("T", {"ov", "vv"});
+    check(T.name() == "T", "wrong name");
+    check(T.block_labels() == std::vector<std::string>{"ov", "vv"}, "wrong blocks");
+    check(T.block("ov").dims() == std::vector<size_t>{2, 3}, "wrong shape of block ov");
+    check(T.block("vv").dims() == std::vector<size_t>{3, 3}, "wrong shape of block vv");
+    check(is_zero(T), "new tensor is not zero");
+    check(pool.numel_in_use() == 15, "wrong memory in use");
+
+    // a returned tensor is reused for the same blocks and is zeroed again
+    T.iterate([](const std::vector<size_t>&, const std::vector<ambit::SpinType>&,
+                 double& value) { value = 1.0; });
+    const double* data = T.block("ov").data().data();
+    T.release();
+    check(pool.numel_in_use() == 0 and pool.numel_idle() == 15, "tensor not returned");
+    auto U = pool.get("U", {"ov", "vv"});
+    check(U.block("ov").data().data() == data, "tensor not reused");
+    check(U.block_labels() == std::vector<std::string>{"ov", "vv"}, "wrong blocks on reuse");
+    check(is_zero(U), "reused tensor is not zero");
+    check(pool.numel_idle() == 0, "reused tensor still idle");
+
+    // different blocks give a new tensor
+    auto V = pool.get("V", {"vv"});
+    check(V.block_labels() == std::vector<std::string>{"vv"}, "wrong blocks");
+    check(V.block("vv").data().data() != U.block("vv").data().data(), "tensor in use handed out");
+    check(pool.peak_numel() == 24, "wrong peak memory");
+
+    // assigning to a pooled tensor returns the previous one to the pool
+    V = pool.get("W", {"oo"});
+    check(V.block_labels() == std::vector<std::string>{"oo"}, "wrong blocks after assignment");
+    check(pool.numel_idle() == 9 and pool.numel_in_use() == 19,
+          "tensor not returned on assignment");
+
+    // the idle tensors are kept up to the peak memory and freed by clear()
+    U.release();
+    V.release();
+    check(pool.numel_in_use() == 0, "tensors still in use");
+    check(pool.numel_idle() <= pool.peak_numel(), "idle memory exceeds the peak");
+    pool.clear();
+    check(pool.numel_idle() == 0, "idle tensors not freed");
+
+    ambit::BlockedTensor::reset_mo_spaces();
+}
+
+} // namespace forte
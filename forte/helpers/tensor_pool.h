@@ -0,0 +1,142 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ambit/blocked_tensor.h"
+
+namespace forte {
+
+class TensorPool;
+
+/// @brief A BlockedTensor borrowed from a TensorPool
+///
+/// It can be used wherever a BlockedTensor is expected and it is returned to the pool when it
+/// goes out of scope or when another tensor is assigned to it. It cannot be copied, and it should
+/// not be copied into a BlockedTensor that outlives it, since the pool will hand out its data
+/// again.
+class PooledTensor : public ambit::BlockedTensor {
+  public:
+    PooledTensor() = default;
+    ~PooledTensor();
+
+    PooledTensor(const PooledTensor&) = delete;
+    PooledTensor& operator=(const PooledTensor&) = delete;
+    PooledTensor(PooledTensor&& other) noexcept;
+    PooledTensor& operator=(PooledTensor&& other) noexcept;
+
+    /// Return the tensor to its pool (if any) and leave this object empty
+    void release();
+
+  private:
+    friend class TensorPool;
+    PooledTensor(TensorPool* pool, std::string key, ambit::BlockedTensor tensor, size_t numel);
+
+    TensorPool* pool_ = nullptr;
+    std::string key_;
+    size_t numel_ = 0;
+};
+
+/// @brief A pool of BlockedTensor temporaries
+///
+/// The DSRG commutators build the same temporaries in every iteration. Instead of allocating
+/// (and zeroing) a new tensor for every call, get() returns an idle tensor with the same blocks
+/// if the pool has one, zeroed, and allocates a new one otherwise. The idle tensors are kept up to
+/// a memory limit, which is the largest of the limit set by the user and the peak memory of the
+/// tensors in use at the same time, so the pool never holds more memory than the code would
+/// allocate without it. When the limit is exceeded the least recently used idle tensors are freed.
+class TensorPool {
+  public:
+    /// @param type the type of the tensors built by the pool
+    explicit TensorPool(ambit::TensorType type = ambit::CoreTensor);
+    ~TensorPool() = default;
+
+    TensorPool(const TensorPool&) = delete;
+    TensorPool& operator=(const TensorPool&) = delete;
+
+    /// Borrow a tensor with the given blocks. The tensor is always zeroed: a new tensor is zeroed
+    /// by ambit::BlockedTensor::build and a reused one is zeroed by get(), so callers can
+    /// accumulate into it (temp["pq"] += ...) exactly as into a freshly built tensor
+    /// @param name the name of the tensor, used when a new tensor is built. A reused tensor keeps
+    ///        the name it was built with
+    /// @param blocks the blocks of the tensor, as passed to ambit::BlockedTensor::build
+    PooledTensor get(const std::string& name, const std::vector<std::string>& blocks);
+
+    /// Set the memory (in number of doubles) that the pool can keep, including tensors in use
+    void set_memory_limit(size_t numel);
+
+    /// Free all the idle tensors
+    void clear();
+
+    /// @return the number of doubles in the tensors currently in use
+    size_t numel_in_use() const;
+    /// @return the largest number of doubles in use at the same time
+    size_t peak_numel() const;
+    /// @return the number of doubles in the idle tensors
+    size_t numel_idle() const;
+
+    /// Print the high-water mark and the number of tensors allocated and reused
+    void print_summary(const std::string& title) const;
+
+  private:
+    friend class PooledTensor;
+    /// Take back a tensor returned by a PooledTensor
+    void release(const std::string& key, ambit::BlockedTensor tensor, size_t numel);
+    /// Free the least recently used idle tensors until the memory limit is met
+    void trim();
+
+    struct IdleTensor {
+        std::string key;
+        ambit::BlockedTensor tensor;
+        size_t numel;
+        uint64_t last_use;
+    };
+
+    ambit::TensorType type_;
+    std::vector<IdleTensor> idle_;
+    size_t limit_ = 0;
+    size_t numel_in_use_ = 0;
+    size_t numel_idle_ = 0;
+    size_t peak_numel_ = 0;
+    size_t num_allocations_ = 0;
+    size_t num_reuses_ = 0;
+    /// a counter used to find the least recently used idle tensor
+    uint64_t clock_ = 0;
+    mutable std::mutex mutex_;
+};
+
+/// Test the reuse, the zeroing, the blocks and the memory accounting of TensorPool. Throws a
+/// std::runtime_error if a check fails
+void test_tensor_pool();
+
+} // namespace forte
@@ -0,0 +1,144 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "psi4/libqt/qt.h"
+
+#include "helpers/tensor_rotation.h"
+
+namespace forte {
+
+TensorRotation::TensorRotation(size_t n) : n_(n) {}
+
+void TensorRotation::rotate(double* T, const std::vector<const double*>& U, bool transpose) {
+    const size_t rank = U.size();
+    if (rank == 0 or n_ == 0)
+        return;
+
+    size_t size = 1;
+    for (size_t k = 0; k < rank; ++k)
+        size *= n_;
+    // the number of combinations of the indices that are not transformed in one step
+    const size_t R = size / n_;
+    for (size_t k = 0; k < rank; ++k) {
+        if (U[k] == nullptr)
+            throw std::runtime_error("TensorRotation: null transformation matrix");
+    }
+    if (scratch_.size() < size)
+        scratch_.resize(size);
+
+    const int n = static_cast<int>(n_);
+    const int nR = static_cast<int>(R);
+    // M[p,a] = U[p,a] enters the product as M^T ('T'), while M[p,a] = U[a,p] is U itself ('N')
+    const char transM = transpose ? 'N' : 'T';
+    double* src = T;
+    double* dst = scratch_.data();
+    for (size_t k = 0; k < rank; ++k) {
+        // dst[r,p] = sum_a src[a,r] M[p,a], where r runs over the remaining indices
+        psi::C_DGEMM('T', transM, nR, n, n, 1.0, src, nR, const_cast<double*>(U[k]), n, 0.0, dst,
+                     n);
+        std::swap(src, dst);
+    }
+    if (src != T)
+        std::memcpy(T, src, size * sizeof(double));
+}
+
+namespace {
+/// Contract index k of a tensor of rank k with M[p,a] (mode-k product), using explicit loops
+std::vector<double> mode_product(const std::vector<double>& T, size_t n, size_t rank, size_t k,
+                                 const std::vector<double>& U, bool transpose) {
+    size_t left = 1, right = 1;
+    for (size_t i = 0; i < k; ++i)
+        left *= n;
+    for (size_t i = k + 1; i < rank; ++i)
+        right *= n;
+    std::vector<double> result(T.size(), 0.0);
+    for (size_t l = 0; l < left; ++l) {
+        for (size_t p = 0; p < n; ++p) {
+            for (size_t a = 0; a < n; ++a) {
+                const double m = transpose ? U[a * n + p] : U[p * n + a];
+                for (size_t r = 0; r < right; ++r)
+                    result[(l * n + p) * right + r] += m * T[(l * n + a) * right + r];
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<double> test_matrix(size_t n, double shift) {
+    std::vector<double> U(n * n);
+    for (size_t i = 0; i < U.size(); ++i)
+        U[i] = std::sin(1.0 + shift + 0.7 * i);
+    return U;
+}
+} // namespace
+
+void test_tensor_rotation() {
+    const size_t n = 5;
+    const auto Ua = test_matrix(n, 0.0);
+    const auto Ub = test_matrix(n, 0.3);
+
+    // one object rotates all the tensors, so the scratch buffer is reused with different sizes
+    TensorRotation rotation(n);
+    for (size_t rank : {2, 1, 4, 3, 6}) {
+        for (bool transpose : {true, false}) {
+            size_t size = 1;
+            for (size_t k = 0; k < rank; ++k)
+                size *= n;
+            std::vector<double> T(size);
+            for (size_t i = 0; i < size; ++i)
+                T[i] = std::cos(0.1 * i);
+
+            // alternate the two matrices as in the mixed-spin blocks of the RDMs
+            std::vector<const double*> U;
+            auto ref = T;
+            for (size_t k = 0; k < rank; ++k) {
+                const auto& Uk = k % 2 == 0 ? Ua : Ub;
+                U.push_back(Uk.data());
+                ref = mode_product(ref, n, rank, k, Uk, transpose);
+            }
+
+            rotation.rotate(T.data(), U, transpose);
+            double max_error = 0.0;
+            for (size_t i = 0; i < size; ++i)
+                max_error = std::max(max_error, std::fabs(T[i] - ref[i]));
+            if (max_error > 1.0e-10) {
+                throw std::runtime_error(
+                    "test_tensor_rotation: wrong rotation of a tensor of rank " +
+                    std::to_string(rank));
+            }
+        }
+    }
+}
+
+} // namespace forte
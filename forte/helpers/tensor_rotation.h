@@ -0,0 +1,74 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace forte {
+
+/// @brief Rotate all the indices of dense tensors with orbital transformation matrices
+///
+/// A tensor of rank k with all dimensions equal to n, stored in row-major order, is transformed as
+///   T'[p1,...,pk] = sum_{a1,...,ak} U1[p1,a1] ... Uk[pk,ak] T[a1,...,ak]
+/// one index at a time, at a cost of 2 k n^(k+1) floating point operations. Each step contracts
+/// the first index and moves it to the end, so after k steps the indices are back in their
+/// original order. Each step is a single matrix multiplication (DGEMM) of the n x n^(k-1) tensor
+/// with the transformation matrix.
+///
+/// The scratch buffer is kept between calls, so one object can be used to rotate several tensors
+/// (e.g. all the spin blocks of an RDM) without allocating new temporaries.
+///
+/// Typical use:
+///   TensorRotation rotation(nactv);
+///   rotation.rotate(g2aa.data().data(), {ua, ua, ua, ua}, true);
+///   rotation.rotate(g2ab.data().data(), {ua, ub, ua, ub}, true);
+class TensorRotation {
+  public:
+    /// @param n the dimension of each index
+    explicit TensorRotation(size_t n);
+
+    /// Rotate a tensor in place
+    /// @param T the tensor, with n^k elements where k = U.size()
+    /// @param U the n x n row-major matrix that rotates each index
+    /// @param transpose if true use U[a,p] instead of U[p,a], i.e. T' = U^T ... T ... U
+    void rotate(double* T, const std::vector<const double*>& U, bool transpose);
+
+  private:
+    /// the dimension of each index
+    size_t n_;
+    /// the buffer that holds the intermediate tensors
+    std::vector<double> scratch_;
+};
+
+/// Test the rotation of tensors of rank one to six against a sequence of mode products computed
+/// with explicit loops. Throws if the results do not agree
+void test_tensor_rotation();
+
+} // namespace forte
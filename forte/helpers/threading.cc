@@ -27,8 +27,12 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace forte {
 
@@ -51,4 +55,61 @@ std::pair<size_t, size_t> thread_range(size_t n, size_t num_thread, size_t tid)
 
     return {start_idx, end_idx};
 }
+
+std::vector<std::vector<size_t>> balanced_partition(const std::vector<size_t>& weights,
+                                                    size_t num_thread) {
+    if (num_thread == 0) {
+        throw std::invalid_argument("balanced_partition: the number of threads must be positive.");
+    }
+    std::vector<size_t> order(weights.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t i, size_t j) { return weights[i] > weights[j]; });
+
+    // a min-heap of (total weight, thread id)
+    using load_t = std::pair<size_t, size_t>;
+    std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t>> loads;
+    for (size_t t = 0; t < num_thread; ++t)
+        loads.emplace(0, t);
+
+    std::vector<std::vector<size_t>> partition(num_thread);
+    for (size_t i : order) {
+        auto [load, t] = loads.top();
+        loads.pop();
+        partition[t].push_back(i);
+        loads.emplace(load + weights[i], t);
+    }
+    return partition;
+}
+
+std::vector<size_t> proportional_split(const std::vector<size_t>& weights, size_t total) {
+    const size_t n = weights.size();
+    if (n > total) {
+        throw std::invalid_argument(
+            "proportional_split: the number of units must be at least the number of items.");
+    }
+    std::vector<size_t> split(n, 1);
+    if (n == 0)
+        return split;
+    const size_t extra = total - n;
+    const double weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    std::vector<double> remainder(n);
+    size_t assigned = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const double share = weight_sum > 0.0 ? extra * (weights[i] / weight_sum)
+                                              : static_cast<double>(extra) / n;
+        const auto whole = std::min(static_cast<size_t>(share), extra - assigned);
+        split[i] += whole;
+        assigned += whole;
+        remainder[i] = share - whole;
+    }
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t i, size_t j) { return remainder[i] > remainder[j]; });
+    for (size_t k = 0; assigned < extra; ++assigned, k = (k + 1) % n) {
+        split[order[k]] += 1;
+    }
+    return split;
+}
 } // namespace forte
\ No newline at end of file
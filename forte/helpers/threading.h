@@ -28,6 +28,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "forte-def.h"
+
 namespace forte {
 
 /// @brief Compute the start and end indices for a workload distributed among multiple threads
@@ -37,4 +47,167 @@ namespace forte {
 /// @return a pair of start and end indices
 std::pair<size_t, size_t> thread_range(size_t n, size_t num_thread, size_t tid);
 
+/// @brief Distribute work items of different cost among threads. The items are assigned from the
+///        heaviest to the lightest to the thread with the smallest total weight (greedy longest
+///        processing time schedule)
+/// @param weights the estimated cost of each item
+/// @param num_thread the number of threads
+/// @return a vector with the indices of the items assigned to each thread
+std::vector<std::vector<size_t>> balanced_partition(const std::vector<size_t>& weights,
+                                                    size_t num_thread);
+
+/// @brief Split a number of units (e.g. threads) among items in proportion to their weights. Each
+///        item gets at least one unit and the units left are assigned to the largest remainders
+/// @param weights the weight of each item
+/// @param total the number of units to split (at least the number of items)
+/// @return the number of units assigned to each item
+std::vector<size_t> proportional_split(const std::vector<size_t>& weights, size_t total);
+
+/// @brief Sort a range in parallel. The range is split into one chunk per thread, the chunks are
+///        sorted concurrently and then merged pairwise
+/// @param first the beginning of the range
+/// @param last the end of the range
+/// @param comp the comparison function
+/// @param num_threads the number of threads (if zero, use omp_get_max_threads())
+template <class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp, size_t num_threads = 0) {
+    const size_t n = last - first;
+    if (num_threads == 0)
+        num_threads = omp_get_max_threads();
+    // small chunks are not worth the overhead
+    const size_t nchunks = std::min(num_threads, n / 4096 + 1);
+    if (nchunks < 2) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::vector<size_t> bounds(nchunks + 1, n);
+    for (size_t k = 0; k < nchunks; ++k)
+        bounds[k] = thread_range(n, nchunks, k).first;
+
+    const auto nk = static_cast<std::int64_t>(nchunks);
+#pragma omp parallel for num_threads(nchunks)
+    for (std::int64_t k = 0; k < nk; ++k) {
+        std::sort(first + bounds[k], first + bounds[k + 1], comp);
+    }
+    for (size_t width = 1; width < nchunks; width *= 2) {
+        const auto npairs = static_cast<std::int64_t>((nchunks + 2 * width - 1) / (2 * width));
+#pragma omp parallel for num_threads(nchunks)
+        for (std::int64_t k = 0; k < npairs; ++k) {
+            const size_t lo = 2 * width * k;
+            const size_t mid = std::min(lo + width, nchunks);
+            const size_t hi = std::min(lo + 2 * width, nchunks);
+            if (mid < hi) {
+                std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi],
+                                   comp);
+            }
+        }
+    }
+}
+
+/// @brief Accumulate into a set of arrays (e.g. reduced density matrices) from several threads
+///        without atomics. The first thread adds directly to the arrays and every other thread to
+///        private zero-initialized copies, which are then added to the arrays in thread order.
+///        f(out) is called by every thread of the parallel region with pointers to the arrays of
+///        that thread (out[n] corresponds to arrays[n]) and should distribute its work with
+///        orphaned "#pragma omp for" loops
+///
+/// Typical use:
+///   accumulate_in_parallel({&rdm_a, &rdm_b}, [&](const std::vector<double*>& out) {
+///   #pragma omp for schedule(dynamic)
+///       for (size_t K = 0; K < nlists; ++K) { ... out[0][pq] += ...; }
+///   });
+/// @param arrays the arrays to accumulate into
+/// @param f the function that accumulates into the arrays
+/// @param num_threads the number of threads (if zero, use omp_get_max_threads())
+template <class F>
+void accumulate_in_parallel(const std::vector<std::vector<double>*>& arrays, F&& f,
+                            size_t num_threads = 0) {
+    if (num_threads == 0)
+        num_threads = omp_get_max_threads();
+    const size_t narrays = arrays.size();
+    // the private copies of threads 1, 2, ...
+    std::vector<std::vector<double>> copies((num_threads - 1) * narrays);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const size_t tid = omp_get_thread_num();
+        const size_t nthreads = omp_get_num_threads();
+        std::vector<double*> out(narrays);
+        for (size_t n = 0; n < narrays; ++n) {
+            if (tid == 0) {
+                out[n] = arrays[n]->data();
+            } else {
+                auto& copy = copies[(tid - 1) * narrays + n];
+                copy.assign(arrays[n]->size(), 0.0);
+                out[n] = copy.data();
+            }
+        }
+        f(out);
+
+        // wait until all the threads have finished adding to their copies
+#pragma omp barrier
+        for (size_t n = 0; n < narrays; ++n) {
+            double* array = arrays[n]->data();
+            const auto size = static_cast<std::int64_t>(arrays[n]->size());
+#pragma omp for schedule(static)
+            for (std::int64_t i = 0; i < size; ++i) {
+                double sum = 0.0;
+                for (size_t t = 1; t < nthreads; ++t)
+                    sum += copies[(t - 1) * narrays + n][i];
+                array[i] += sum;
+            }
+        }
+    }
+}
+
+/// @brief Produce a sequence of items (e.g. blocks of integrals read from disk) one step ahead of
+///        their use. When next() returns item i, item i + 1 is already being produced by a
+///        background thread, so reading the next item overlaps with the work done on the current
+///        one (double buffering). Exceptions thrown while producing an item are rethrown by next()
+///
+/// Typical use:
+///   AsyncPrefetcher<ambit::Tensor> blocks(nblocks, [&](size_t i) { return read_block(i); });
+///   while (not blocks.done()) {
+///       auto B = blocks.next();
+///       ... contract B ...
+///   }
+template <class T> class AsyncPrefetcher {
+  public:
+    /// @param n the number of items
+    /// @param fetch a function that returns item i. It is called for i = 0, 1, ..., n - 1 in
+    ///        order and never concurrently with itself
+    /// @param async if false, the items are produced by next() in the calling thread
+    AsyncPrefetcher(size_t n, std::function<T(size_t)> fetch, bool async = true)
+        : n_(n), fetch_(std::move(fetch)), async_(async) {
+        launch();
+    }
+
+    /// @return true if all the items were returned
+    bool done() const { return next_ == n_; }
+
+    /// @return the next item. Waits until it is available and starts producing the one after it
+    T next() {
+        if (done())
+            throw std::out_of_range("AsyncPrefetcher::next: all the items were returned");
+        T item = async_ ? pending_.get() : fetch_(next_);
+        ++next_;
+        launch();
+        return item;
+    }
+
+  private:
+    void launch() {
+        if (async_ and next_ < n_)
+            pending_ = std::async(std::launch::async, fetch_, next_);
+    }
+
+    size_t n_;
+    size_t next_ = 0;
+    std::function<T(size_t)> fetch_;
+    bool async_;
+    /// the item being produced. Declared last, so it is waited for before the other members are
+    /// destroyed
+    std::future<T> pending_;
+};
+
 } // namespace forte
@@ -26,6 +26,7 @@
  * @END LICENSE
  */
 
+#include <array>
 #include <cmath>
 
 #include "psi4/psi4-dec.h"
@@ -170,23 +171,92 @@ void ActiveSpaceIntegrals::startup() {
     nmo3_ = nmo_ * nmo_ * nmo_;
     nmo4_ = nmo_ * nmo_ * nmo_ * nmo_;
 
+    packed_layout_ = PackedTEILayout(nmo_);
+
     oei_a_.resize(nmo2_);
     oei_b_.resize(nmo2_);
-    tei_aa_.resize(nmo4_);
-    tei_ab_.resize(nmo4_);
-    tei_bb_.resize(nmo4_);
-    diag_tei_aa_.resize(nmo2_);
-    diag_tei_ab_.resize(nmo2_);
-    diag_tei_bb_.resize(nmo2_);
+    // until the integrals are set, they are zero and stored in the packed layout
+    packed_ = true;
+    tei_aa_.assign(packed_layout_.aa_size(), 0.0);
+    tei_ab_.assign(packed_layout_.ab_size(), 0.0);
+    tei_bb_.clear();
+    diag_tei_aa_.assign(nmo2_, 0.0);
+    diag_tei_ab_.assign(nmo2_, 0.0);
+    diag_tei_bb_.assign(nmo2_, 0.0);
     frozen_core_energy_ = ints_->frozen_core_energy();
 }
 
+void ActiveSpaceIntegrals::set_tei(const std::vector<double>& tei_aa,
+                                   const std::vector<double>& tei_ab,
+                                   const std::vector<double>& tei_bb) {
+    // the packed layout requires restricted integrals with the full permutational symmetry. Other
+    // integrals (e.g., unrestricted or non-Hermitian dressed integrals) are stored as they are
+    packed_ = (tei_aa == tei_bb) and is_antisymmetrized_hermitian(tei_aa, nmo_) and
+              has_real_orbital_symmetry(tei_ab, nmo_);
+    if (not packed_) {
+        tei_aa_ = tei_aa;
+        tei_ab_ = tei_ab;
+        tei_bb_ = tei_bb;
+        compute_diag_tei();
+        return;
+    }
+
+    tei_aa_ = packed_layout_.pack_aa(tei_aa);
+    tei_ab_ = packed_layout_.pack_ab(tei_ab);
+    std::vector<double>().swap(tei_bb_);
+    compute_diag_tei();
+}
+
+void ActiveSpaceIntegrals::compute_diag_tei() {
+    for (size_t p = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < nmo_; ++q) {
+            diag_tei_aa_[p * nmo_ + q] = tei_aa(p, q, p, q);
+            diag_tei_ab_[p * nmo_ + q] = tei_ab(p, q, p, q);
+            diag_tei_bb_[p * nmo_ + q] = tei_bb(p, q, p, q);
+        }
+    }
+}
+
+std::vector<double> ActiveSpaceIntegrals::tei_aa_vector() const {
+    if (not packed_)
+        return tei_aa_;
+    std::vector<double> v(nmo4_);
+    for (size_t p = 0, pqrs = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < nmo_; ++q) {
+            for (size_t r = 0; r < nmo_; ++r) {
+                for (size_t s = 0; s < nmo_; ++s, ++pqrs) {
+                    v[pqrs] = tei_aa(p, q, r, s);
+                }
+            }
+        }
+    }
+    return v;
+}
+
+std::vector<double> ActiveSpaceIntegrals::tei_ab_vector() const {
+    if (not packed_)
+        return tei_ab_;
+    std::vector<double> v(nmo4_);
+    for (size_t p = 0, pqrs = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < nmo_; ++q) {
+            for (size_t r = 0; r < nmo_; ++r) {
+                for (size_t s = 0; s < nmo_; ++s, ++pqrs) {
+                    v[pqrs] = tei_ab(p, q, r, s);
+                }
+            }
+        }
+    }
+    return v;
+}
+
+std::vector<double> ActiveSpaceIntegrals::tei_bb_vector() const {
+    return packed_ ? tei_aa_vector() : tei_bb_;
+}
+
 void ActiveSpaceIntegrals::set_active_integrals(const ambit::Tensor& act_aa,
                                                 const ambit::Tensor& act_ab,
                                                 const ambit::Tensor& act_bb) {
-    tei_aa_ = act_aa.data();
-    tei_ab_ = act_ab.data();
-    tei_bb_ = act_bb.data();
+    set_tei(act_aa.data(), act_ab.data(), act_bb.data());
 }
 
 void ActiveSpaceIntegrals::set_active_integrals_and_restricted_docc() {
@@ -194,9 +264,7 @@ void ActiveSpaceIntegrals::set_active_integrals_and_restricted_docc() {
     ambit::Tensor act_ab = ints_->aptei_ab_block(active_mo_, active_mo_, active_mo_, active_mo_);
     ambit::Tensor act_bb = ints_->aptei_bb_block(active_mo_, active_mo_, active_mo_, active_mo_);
 
-    tei_aa_ = act_aa.data();
-    tei_ab_ = act_ab.data();
-    tei_bb_ = act_bb.data();
+    set_tei(act_aa.data(), act_ab.data(), act_bb.data());
     compute_restricted_one_body_operator();
 }
 
@@ -207,40 +275,40 @@ std::vector<int> ActiveSpaceIntegrals::active_mo_symmetry() const { return activ
 std::vector<size_t> ActiveSpaceIntegrals::restricted_docc_mo() const { return restricted_docc_mo_; }
 
 double ActiveSpaceIntegrals::energy(const Determinant& det) const {
-    double energy = frozen_core_energy_;
-
+    // list the occupied orbitals once and then add up the rows of the diagonal integrals
+    std::array<int, Determinant::norb()> aocc;
+    std::array<int, Determinant::norb()> bocc;
     String Ia = det.get_alfa_bits();
     String Ib = det.get_beta_bits();
-    String Iac;
-    String Ibc;
-
-    int naocc = Ia.count();
-    int nbocc = Ib.count();
+    const int naocc = Ia.count();
+    const int nbocc = Ib.count();
+    for (int A = 0; A < naocc; ++A) {
+        aocc[A] = Ia.find_and_clear_first_one();
+    }
+    for (int B = 0; B < nbocc; ++B) {
+        bocc[B] = Ib.find_and_clear_first_one();
+    }
 
+    double energy = frozen_core_energy_;
     for (int A = 0; A < naocc; ++A) {
-        int p = Ia.find_and_clear_first_one();
+        const size_t p = aocc[A];
         energy += oei_a_[p * nmo_ + p];
-
-        Iac = Ia;
+        const double* aa_row = &diag_tei_aa_[p * nmo_];
         for (int AA = A + 1; AA < naocc; ++AA) {
-            int q = Iac.find_and_clear_first_one();
-            energy += tei_aa_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
+            energy += aa_row[aocc[AA]];
         }
-
-        Ibc = Ib;
+        const double* ab_row = &diag_tei_ab_[p * nmo_];
         for (int B = 0; B < nbocc; ++B) {
-            int q = Ibc.find_and_clear_first_one();
-            energy += tei_ab_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
+            energy += ab_row[bocc[B]];
         }
     }
 
     for (int B = 0; B < nbocc; ++B) {
-        int p = Ib.find_and_clear_first_one();
+        const size_t p = bocc[B];
         energy += oei_b_[p * nmo_ + p];
-        Ibc = Ib;
+        const double* bb_row = &diag_tei_bb_[p * nmo_];
         for (int BB = B + 1; BB < nbocc; ++BB) {
-            int q = Ibc.find_and_clear_first_one();
-            energy += tei_bb_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
+            energy += bb_row[bocc[BB]];
         }
     }
 
@@ -271,22 +339,7 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
     double matrix_element = 0.0;
     // Slater rule 1 PhiI = PhiJ
     if ((nadiff == 0) and (nbdiff == 0)) {
-        // matrix_element += frozen_core_energy_ + this->energy(rhs);
-        matrix_element = frozen_core_energy_;
-        for (size_t p = 0; p < nmo_; ++p) {
-            if (lhs.get_alfa_bit(p))
-                matrix_element += oei_a_[p * nmo_ + p];
-            if (lhs.get_beta_bit(p))
-                matrix_element += oei_b_[p * nmo_ + p];
-            for (size_t q = 0; q < nmo_; ++q) {
-                if (lhs.get_alfa_bit(p) and lhs.get_alfa_bit(q))
-                    matrix_element += 0.5 * tei_aa_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-                if (lhs.get_beta_bit(p) and lhs.get_beta_bit(q))
-                    matrix_element += 0.5 * tei_bb_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-                if (lhs.get_alfa_bit(p) and lhs.get_beta_bit(q))
-                    matrix_element += tei_ab_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-            }
-        }
+        matrix_element = energy(lhs);
     }
 
     // Slater rule 2 PhiI = j_a^+ i_a PhiJ
@@ -305,10 +358,10 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
         matrix_element = sign * oei_a_[i * nmo_ + j];
         for (size_t p = 0; p < nmo_; ++p) {
             if (lhs.get_alfa_bit(p) and rhs.get_alfa_bit(p)) {
-                matrix_element += sign * tei_aa_[i * nmo3_ + p * nmo2_ + j * nmo_ + p];
+                matrix_element += sign * tei_aa(i, p, j, p);
             }
             if (lhs.get_beta_bit(p) and rhs.get_beta_bit(p)) {
-                matrix_element += sign * tei_ab_[i * nmo3_ + p * nmo2_ + j * nmo_ + p];
+                matrix_element += sign * tei_ab(i, p, j, p);
             }
         }
     }
@@ -328,10 +381,10 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
         matrix_element = sign * oei_b_[i * nmo_ + j];
         for (size_t p = 0; p < nmo_; ++p) {
             if (lhs.get_alfa_bit(p) and rhs.get_alfa_bit(p)) {
-                matrix_element += sign * tei_ab_[p * nmo3_ + i * nmo2_ + p * nmo_ + j];
+                matrix_element += sign * tei_ab(p, i, p, j);
             }
             if (lhs.get_beta_bit(p) and rhs.get_beta_bit(p)) {
-                matrix_element += sign * tei_bb_[i * nmo3_ + p * nmo2_ + j * nmo_ + p];
+                matrix_element += sign * tei_bb(i, p, j, p);
             }
         }
     }
@@ -360,7 +413,7 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
             }
         }
         double sign = lhs.slater_sign_aaaa(i, j, k, l);
-        matrix_element = sign * tei_aa_[i * nmo3_ + j * nmo2_ + k * nmo_ + l];
+        matrix_element = sign * tei_aa(i, j, k, l);
     }
 
     // Slater rule 3 PhiI = k_a^+ l_a^+ j_a i_a PhiJ
@@ -388,7 +441,7 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
             }
         }
         double sign = lhs.slater_sign_bbbb(i, j, k, l);
-        matrix_element = sign * tei_bb_[i * nmo3_ + j * nmo2_ + k * nmo_ + l];
+        matrix_element = sign * tei_bb(i, j, k, l);
     }
 
     // Slater rule 3 PhiI = j_a^+ i_a PhiJ
@@ -407,7 +460,7 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
                 l = p;
         }
         double sign = lhs.slater_sign_aa(i, k) * lhs.slater_sign_bb(j, l);
-        matrix_element = sign * tei_ab_[i * nmo3_ + j * nmo2_ + k * nmo_ + l];
+        matrix_element = sign * tei_ab(i, j, k, l);
     }
 #endif
     return (matrix_element);
@@ -415,60 +468,46 @@ double ActiveSpaceIntegrals::slater_rules(const Determinant& lhs, const Determin
 
 double ActiveSpaceIntegrals::slater_rules_single_alpha(const Determinant& det, int i, int a) const {
     // Slater rule 2 PhiI = j_a^+ i_a PhiJ
-    double sign = det.slater_sign_aa(i, a);
-    double matrix_element = oei_a_[i * nmo_ + a];
-    for (size_t p = 0; p < nmo_; ++p) {
-        if (det.get_alfa_bit(p)) {
-            matrix_element += tei_aa_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
-        if (det.get_beta_bit(p)) {
-            matrix_element += tei_ab_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
-    }
-    return sign * matrix_element;
+    return det.slater_sign_aa(i, a) * slater_rules_single_alpha_abs(det, i, a);
 }
 
 double ActiveSpaceIntegrals::slater_rules_single_alpha_abs(const Determinant& det, int i,
                                                            int a) const {
     // Slater rule 2 PhiI = j_a^+ i_a PhiJ
     double matrix_element = oei_a_[i * nmo_ + a];
-    for (size_t p = 0; p < nmo_; ++p) {
-        if (det.get_alfa_bit(p)) {
-            matrix_element += tei_aa_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
-        if (det.get_beta_bit(p)) {
-            matrix_element += tei_ab_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
+    // loop only over the occupied orbitals
+    String Ia = det.get_alfa_bits();
+    for (int n = Ia.count(); n > 0; --n) {
+        const int p = Ia.find_and_clear_first_one();
+        matrix_element += tei_aa(i, p, a, p);
+    }
+    String Ib = det.get_beta_bits();
+    for (int n = Ib.count(); n > 0; --n) {
+        const int p = Ib.find_and_clear_first_one();
+        matrix_element += tei_ab(i, p, a, p);
     }
     return matrix_element;
 }
 
 double ActiveSpaceIntegrals::slater_rules_single_beta(const Determinant& det, int i, int a) const {
     // Slater rule 2 PhiI = j_a^+ i_a PhiJ
-    double sign = det.slater_sign_bb(i, a);
-    double matrix_element = oei_b_[i * nmo_ + a];
-    for (size_t p = 0; p < nmo_; ++p) {
-        if (det.get_alfa_bit(p)) {
-            matrix_element += tei_ab_[p * nmo3_ + i * nmo2_ + p * nmo_ + a];
-        }
-        if (det.get_beta_bit(p)) {
-            matrix_element += tei_bb_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
-    }
-    return sign * matrix_element;
+    return det.slater_sign_bb(i, a) * slater_rules_single_beta_abs(det, i, a);
 }
 
 double ActiveSpaceIntegrals::slater_rules_single_beta_abs(const Determinant& det, int i,
                                                           int a) const {
     // Slater rule 2 PhiI = j_a^+ i_a PhiJ
     double matrix_element = oei_b_[i * nmo_ + a];
-    for (size_t p = 0; p < nmo_; ++p) {
-        if (det.get_alfa_bit(p)) {
-            matrix_element += tei_ab_[p * nmo3_ + i * nmo2_ + p * nmo_ + a];
-        }
-        if (det.get_beta_bit(p)) {
-            matrix_element += tei_bb_[i * nmo3_ + p * nmo2_ + a * nmo_ + p];
-        }
+    // loop only over the occupied orbitals
+    String Ia = det.get_alfa_bits();
+    for (int n = Ia.count(); n > 0; --n) {
+        const int p = Ia.find_and_clear_first_one();
+        matrix_element += tei_ab(p, i, p, a);
+    }
+    String Ib = det.get_beta_bits();
+    for (int n = Ib.count(); n > 0; --n) {
+        const int p = Ib.find_and_clear_first_one();
+        matrix_element += tei_bb(i, p, a, p);
     }
     return matrix_element;
 }
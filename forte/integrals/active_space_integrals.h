@@ -29,6 +29,7 @@
 #pragma once
 
 #include "integrals/integrals.h"
+#include "integrals/packed_tei.h"
 #include "sparse_ci/determinant.h"
 
 class Dimension;
@@ -108,36 +109,42 @@ class ActiveSpaceIntegrals {
 
     /// Return the alpha-alpha antisymmetrized two-electron integral <pq||rs>
     double tei_aa(size_t p, size_t q, size_t r, size_t s) const {
-        return tei_aa_[nmo3_ * p + nmo2_ * q + nmo_ * r + s];
+        if (packed_) {
+            return packed_layout_.aa(tei_aa_, p, q, r, s);
+        }
+        return tei_aa_[tei_index(p, q, r, s)];
     }
     /// Return the alpha-beta two-electron integral <pq|rs>
     double tei_ab(size_t p, size_t q, size_t r, size_t s) const {
-        return tei_ab_[nmo3_ * p + nmo2_ * q + nmo_ * r + s];
+        if (packed_) {
+            return packed_layout_.ab(tei_ab_, p, q, r, s);
+        }
+        return tei_ab_[tei_index(p, q, r, s)];
     }
     /// Return the beta-beta antisymmetrized two-electron integral <pq||rs>
     double tei_bb(size_t p, size_t q, size_t r, size_t s) const {
-        return tei_bb_[nmo3_ * p + nmo2_ * q + nmo_ * r + s];
+        if (packed_) {
+            return tei_aa(p, q, r, s);
+        }
+        return tei_bb_[tei_index(p, q, r, s)];
     }
 
-    /// Return a vector of alpha-alpha antisymmetrized two-electron integrals
-    const std::vector<double>& tei_aa_vector() const { return tei_aa_; }
-    /// Return a vector of alpha-beta antisymmetrized two-electron integrals
-    const std::vector<double>& tei_ab_vector() const { return tei_ab_; }
-    /// Return a vector of beta-beta antisymmetrized two-electron integrals
-    const std::vector<double>& tei_bb_vector() const { return tei_bb_; }
+    /// Return a vector of alpha-alpha antisymmetrized two-electron integrals (nmo^4 elements)
+    std::vector<double> tei_aa_vector() const;
+    /// Return a vector of alpha-beta two-electron integrals (nmo^4 elements)
+    std::vector<double> tei_ab_vector() const;
+    /// Return a vector of beta-beta antisymmetrized two-electron integrals (nmo^4 elements)
+    std::vector<double> tei_bb_vector() const;
+
+    /// Return true if the two-electron integrals are stored in the packed restricted layout
+    bool packed() const { return packed_; }
 
     /// Return the alpha-alpha antisymmetrized two-electron integral <pq||pq>
-    double diag_tei_aa(size_t p, size_t q) const {
-        return tei_aa_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-    }
-    /// Return the alpha-beta two-electron integral <pq|rs>
-    double diag_tei_ab(size_t p, size_t q) const {
-        return tei_ab_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-    }
-    /// Return the beta-beta antisymmetrized two-electron integral <pq||rs>
-    double diag_tei_bb(size_t p, size_t q) const {
-        return tei_bb_[p * nmo3_ + q * nmo2_ + p * nmo_ + q];
-    }
+    double diag_tei_aa(size_t p, size_t q) const { return diag_tei_aa_[p * nmo_ + q]; }
+    /// Return the alpha-beta two-electron integral <pq|pq>
+    double diag_tei_ab(size_t p, size_t q) const { return diag_tei_ab_[p * nmo_ + q]; }
+    /// Return the beta-beta antisymmetrized two-electron integral <pq||pq>
+    double diag_tei_bb(size_t p, size_t q) const { return diag_tei_bb_[p * nmo_ + q]; }
     IntegralType get_integral_type() { return integral_type_; }
     /// Set the active integrals
     void set_active_integrals(const ambit::Tensor& tei_aa, const ambit::Tensor& tei_ab,
@@ -184,6 +191,13 @@ class ActiveSpaceIntegrals {
     std::vector<double> oei_a_;
     /// The beta one-electron integrals
     std::vector<double> oei_b_;
+    /// If true, the two-electron integrals are restricted (alpha-alpha = beta-beta) and stored in
+    /// packed form:
+    ///   tei_aa_ holds <pq||rs> for p > q, r > s, and pq >= rs (the beta-beta integrals are the
+    ///           same and tei_bb_ is empty)
+    ///   tei_ab_ holds (pr|qs) = <pq|rs> for p >= r, q >= s, and pr >= qs
+    /// Otherwise, the integrals are stored as dense nmo^4 arrays
+    bool packed_ = false;
     /// The alpha-alpha antisymmetrized two-electron integrals in physicist
     /// notation
     std::vector<double> tei_aa_;
@@ -193,6 +207,8 @@ class ActiveSpaceIntegrals {
     /// The beta-beta antisymmetrized two-electron integrals in physicist
     /// notation
     std::vector<double> tei_bb_;
+    /// The index tables of the packed integrals
+    PackedTEILayout packed_layout_;
     /// The diagonal alpha-alpha antisymmetrized two-electron integrals in
     /// physicist notation
     std::vector<double> diag_tei_aa_;
@@ -215,6 +231,13 @@ class ActiveSpaceIntegrals {
         return nmo3_ * p + nmo2_ * q + nmo_ * r + s;
     }
 
+    /// Store the two-electron integrals, using the packed layout if possible
+    void set_tei(const std::vector<double>& tei_aa, const std::vector<double>& tei_ab,
+                 const std::vector<double>& tei_bb);
+
+    /// Compute the diagonal integrals <pq||pq> and <pq|pq>
+    void compute_diag_tei();
+
     void startup();
 };
 
@@ -42,11 +42,19 @@
 #include "helpers/timer.h"
 #include "helpers/printing.h"
 #include "helpers/memory.h"
+#include "integrals/integral_cache.h"
 
 #include "base_classes/forte_options.h"
 
 #include "cholesky_integrals.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#define omp_get_thread_num() 0
+#endif
+
 using namespace ambit;
 using namespace psi;
 
@@ -65,7 +73,10 @@ void CholeskyIntegrals::initialize() {
 
     if (not skip_build_) {
         local_timer int_timer;
-        gather_integrals();
+        if (not read_integral_cache()) {
+            gather_integrals();
+            write_integral_cache();
+        }
         freeze_core_orbitals();
         print_timing("computing Cholesky integrals", int_timer.get());
     }
@@ -282,6 +293,76 @@ void CholeskyIntegrals::transform_integrals() {
     });
 }
 
+void CholeskyIntegrals::compute_ao_cholesky_vectors() {
+    std::shared_ptr<psi::BasisSet> primary = wfn_->basisset();
+    auto integral = std::make_shared<IntegralFactory>(primary, primary, primary, primary);
+    auto twobodyaoints = std::shared_ptr<TwoBodyAOInt>(integral->eri());
+    auto Ch = std::make_shared<CholeskyERI>(twobodyaoints, options_->get_double("INTS_TOLERANCE"),
+                                            options_->get_double("CHOLESKY_TOLERANCE"),
+                                            psi::Process::environment.get_memory());
+    Ch->choleskify();
+    nthree_ = Ch->Q();
+    L_ao_ = Ch->L();
+}
+
+ambit::Tensor CholeskyIntegrals::active_tei_from_three_index(std::shared_ptr<psi::Matrix> C,
+                                                             std::shared_ptr<psi::Matrix> Cact) {
+    size_t nao = C->rowspi()[0];
+    size_t nmo = C->colspi()[0];
+    size_t nactv = Cact->colspi()[0];
+    size_t nactv2 = nactv * nactv;
+
+    auto tei = ambit::Tensor::build(ambit::CoreTensor, "(pu|xy)", {nmo, nactv, nactv, nactv});
+    if (nactv == 0)
+        return tei;
+
+    if (not L_ao_)
+        compute_ao_cholesky_vectors();
+
+    // (pu|xy) = sum_Q B(Q|pu) B(Q|xy), accumulated in batches of Q. Within a batch each thread
+    // transforms its own Cholesky vectors: B(Q|pu) = C^T (L_Q Cact)
+    size_t npa = nmo * nactv;
+    size_t batch = active_tei_batch_size(nthree_, npa + nactv2);
+    std::vector<double> Bpa(batch * npa);
+    std::vector<double> Baa(batch * nactv2);
+    int nthreads = omp_get_max_threads();
+    std::vector<std::vector<double>> half(nthreads, std::vector<double>(nao * nactv));
+    double** Lp = L_ao_->pointer();
+    double** Cp = C->pointer();
+    double** Cactp = Cact->pointer();
+    auto& tei_data = tei.data();
+
+    for (size_t Q = 0; Q < nthree_; Q += batch) {
+        size_t nQ = std::min(batch, nthree_ - Q);
+#pragma omp parallel for num_threads(nthreads)
+        for (size_t q = 0; q < nQ; ++q) {
+            double* Lm = half[omp_get_thread_num()].data();
+            C_DGEMM('N', 'N', nao, nactv, nao, 1.0, Lp[Q + q], nao, Cactp[0], nactv, 0.0, Lm,
+                    nactv);
+            C_DGEMM('T', 'N', nmo, nactv, nao, 1.0, Cp[0], nmo, Lm, nactv, 0.0, &Bpa[q * npa],
+                    nactv);
+            C_DGEMM('T', 'N', nactv, nactv, nao, 1.0, Cactp[0], nactv, Lm, nactv, 0.0,
+                    &Baa[q * nactv2], nactv);
+        }
+        C_DGEMM('T', 'N', npa, nactv2, nQ, 1.0, Bpa.data(), npa, Baa.data(), nactv2, 1.0,
+                tei_data.data(), nactv2);
+    }
+
+    return tei;
+}
+
+void CholeskyIntegrals::write_cached_integrals(IntegralCacheWriter& writer) {
+    writer.write_size(nthree_);
+    writer.write_array(ThreeIntegral_->pointer()[0], nmo_ * nmo_ * nthree_);
+}
+
+void CholeskyIntegrals::read_cached_integrals(IntegralCacheReader& reader) {
+    nthree_ = reader.read_size();
+    int_mem_ = (nthree_ * nso_ * nso_ * sizeof(double) / 1073741824.0);
+    ThreeIntegral_ = std::make_shared<psi::Matrix>("Lmo", nmo_ * nmo_, nthree_);
+    reader.read_array(ThreeIntegral_->pointer()[0], nmo_ * nmo_ * nthree_);
+}
+
 void CholeskyIntegrals::resort_integrals_after_freezing() {
     if (print_ > 1) {
         outfile->Printf("\n  Resorting integrals after freezing core.");
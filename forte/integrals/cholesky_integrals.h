@@ -83,6 +83,13 @@ class CholeskyIntegrals : public Psi4Integrals {
     size_t nthree() const override;
     std::shared_ptr<psi::Matrix> L_ao_;
 
+    /// The AO Cholesky vectors are used to compute (pu|xy)
+    bool has_three_index_ao_ints() const override { return true; }
+
+    /// Compute (pu|xy) from the AO Cholesky vectors
+    ambit::Tensor active_tei_from_three_index(std::shared_ptr<psi::Matrix> C,
+                                              std::shared_ptr<psi::Matrix> Cact) override;
+
   private:
     // ==> Class data <==
 
@@ -93,11 +100,15 @@ class CholeskyIntegrals : public Psi4Integrals {
 
     void resort_three(std::shared_ptr<psi::Matrix>& threeint, std::vector<size_t>& map);
     void transform_integrals();
+    /// Compute the AO Cholesky vectors (L_ao_), which are not stored in the integral cache
+    void compute_ao_cholesky_vectors();
 
     // ==> Class private virtual functions <==
 
     void gather_integrals() override;
     void resort_integrals_after_freezing() override;
+    void read_cached_integrals(IntegralCacheReader& reader) override;
+    void write_cached_integrals(IntegralCacheWriter& writer) override;
 };
 
 } // namespace forte
@@ -41,6 +41,7 @@
 #include "helpers/blockedtensorfactory.h"
 #include "helpers/timer.h"
 #include "helpers/printing.h"
+#include "integrals/integral_cache.h"
 
 #include "conventional_integrals.h"
 
@@ -63,7 +64,10 @@ void ConventionalIntegrals::initialize() {
 
     if (not skip_build_) {
         local_timer ConvTime;
-        gather_integrals();
+        if (not read_integral_cache()) {
+            gather_integrals();
+            write_integral_cache();
+        }
         freeze_core_orbitals();
         print_timing("computing conventional integrals", ConvTime.get());
     }
@@ -239,6 +243,29 @@ void ConventionalIntegrals::gather_integrals() {
     }
 }
 
+void ConventionalIntegrals::write_cached_integrals(IntegralCacheWriter& writer) {
+    // the integrals are restricted, so only <pq|rs> is stored and the antisymmetrized integrals
+    // are rebuilt when the file is read
+    writer.write_array(aphys_tei_ab_.data(), num_aptei_);
+}
+
+void ConventionalIntegrals::read_cached_integrals(IntegralCacheReader& reader) {
+    reader.read_array(aphys_tei_ab_.data(), num_aptei_);
+    for (size_t p = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < nmo_; ++q) {
+            for (size_t r = 0; r < nmo_; ++r) {
+                for (size_t s = 0; s < nmo_; ++s) {
+                    // <pq||rs> = <pq|rs> - <pq|sr>
+                    size_t index = aptei_index(p, q, r, s);
+                    double value = aphys_tei_ab_[index] - aphys_tei_ab_[aptei_index(p, q, s, r)];
+                    aphys_tei_aa_[index] = value;
+                    aphys_tei_bb_[index] = value;
+                }
+            }
+        }
+    }
+}
+
 void ConventionalIntegrals::resort_integrals_after_freezing() {
     if (print_ > 1) {
         outfile->Printf("\n  Resorting integrals after freezing core.");
@@ -84,6 +84,8 @@ class ConventionalIntegrals : public Psi4Integrals {
     // ==> Class private virtual functions <==
     void gather_integrals() override;
     void resort_integrals_after_freezing() override;
+    void read_cached_integrals(IntegralCacheReader& reader) override;
+    void write_cached_integrals(IntegralCacheWriter& writer) override;
 };
 
 } // namespace forte
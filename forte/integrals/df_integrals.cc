@@ -50,6 +50,7 @@
 #include "helpers/printing.h"
 #include "helpers/timer.h"
 #include "helpers/memory.h"
+#include "integrals/integral_cache.h"
 
 #include "df_integrals.h"
 
@@ -77,7 +78,10 @@ void DFIntegrals::initialize() {
 #endif
     if (my_proc == 0 and (not skip_build_)) {
         local_timer int_timer;
-        gather_integrals();
+        if (not read_integral_cache()) {
+            gather_integrals();
+            write_integral_cache();
+        }
         freeze_core_orbitals();
         print_timing("computing density-fitted integrals", int_timer.get());
     }
@@ -281,6 +285,17 @@ void DFIntegrals::resort_three(std::shared_ptr<psi::Matrix>& threeint, std::vect
     threeint->copy(temp_threeint);
 }
 
+void DFIntegrals::write_cached_integrals(IntegralCacheWriter& writer) {
+    writer.write_size(nthree_);
+    writer.write_array(ThreeIntegral_->pointer()[0], nmo_ * nmo_ * nthree_);
+}
+
+void DFIntegrals::read_cached_integrals(IntegralCacheReader& reader) {
+    nthree_ = reader.read_size();
+    ThreeIntegral_ = std::make_shared<psi::Matrix>("Bpq", nmo_ * nmo_, nthree_);
+    reader.read_array(ThreeIntegral_->pointer()[0], nmo_ * nmo_ * nthree_);
+}
+
 void DFIntegrals::resort_integrals_after_freezing() {
     local_timer timer_resort;
     if (print_ > 1) {
@@ -90,6 +90,8 @@ class DFIntegrals : public Psi4Integrals {
 
     void gather_integrals() override;
     void resort_integrals_after_freezing() override;
+    void read_cached_integrals(IntegralCacheReader& reader) override;
+    void write_cached_integrals(IntegralCacheWriter& writer) override;
 };
 
 } // namespace forte
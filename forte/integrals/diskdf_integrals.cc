@@ -26,6 +26,7 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -55,6 +56,24 @@ using namespace psi;
 
 namespace forte {
 
+namespace {
+/// Split a list of orbitals into runs of consecutive orbitals with at most max_size elements
+/// @return the positions in mos of the orbitals of each run, sorted by orbital index
+std::vector<std::vector<size_t>> contiguous_runs(const std::vector<size_t>& mos,
+                                                 size_t max_size) {
+    std::vector<size_t> order(mos.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return mos[i] < mos[j]; });
+    std::vector<std::vector<size_t>> runs;
+    for (size_t k = 0; k < order.size(); ++k) {
+        if (k == 0 or mos[order[k]] != mos[order[k - 1]] + 1 or runs.back().size() == max_size)
+            runs.emplace_back();
+        runs.back().push_back(order[k]);
+    }
+    return runs;
+}
+} // namespace
+
 DISKDFIntegrals::DISKDFIntegrals(std::shared_ptr<ForteOptions> options,
                                  std::shared_ptr<psi::Wavefunction> ref_wfn,
                                  std::shared_ptr<MOSpaceInfo> mo_space_info,
@@ -298,7 +317,6 @@ ambit::Tensor DISKDFIntegrals::three_integral_block(const std::vector<size_t>& Q
     auto psize = p_vec.size();
     auto qsize = q_vec.size();
     auto pqsize = psize * qsize;
-    auto Qqsize = Qsize * qsize;
 
     ambit::Tensor out;
     if (order == pqQ) {
@@ -365,146 +383,59 @@ ambit::Tensor DISKDFIntegrals::three_integral_block(const std::vector<size_t>& Q
         df_->fill_tensor("B", out_data.data(), Q_range, p_range, q_range);
         if (order == pqQ)
             matrix_transpose_in_place(out_data, Qsize, pqsize);
-    } else if ((not p_contiguous) and q_contiguous) {
-        std::vector<size_t> q_range{cmotomo[q_vec[0]], cmotomo[q_vec[0]] + qsize};
-
-        if (order == pqQ) {
-            for (size_t p = 0; p < psize; ++p) {
-                auto np = cmotomo[p_vec[p]];
-                auto Aq = std::make_shared<psi::Matrix>("Aq", Qsize, qsize);
-                df_->fill_tensor("B", Aq, Q_range, {np, np + 1}, q_range);
-
-                for (size_t a = 0; a < Qsize; ++a) {
-                    for (size_t q = 0; q < qsize; ++q) {
-                        out_data[p * Qqsize + q * Qsize + a] = Aq->get(a, q);
-                    }
-                }
-            }
-        } else {
-            for (size_t p = 0; p < psize; ++p) {
-                auto np = cmotomo[p_vec[p]];
-                auto Aq = std::make_shared<psi::Matrix>("Aq", Qsize, qsize);
-                df_->fill_tensor("B", Aq, Q_range, {np, np + 1}, q_range);
-
-                for (size_t a = 0; a < Qsize; ++a) {
-                    for (size_t q = 0; q < qsize; ++q) {
-                        out_data[a * pqsize + p * qsize + q] = Aq->get(a, q);
-                    }
-                }
-            }
-        }
-    } else if (p_contiguous and (not q_contiguous)) {
-        std::vector<size_t> p_range{cmotomo[p_vec[0]], cmotomo[p_vec[0]] + psize};
-
-        if (order == pqQ) {
-            for (size_t q = 0; q < qsize; ++q) {
-                auto nq = cmotomo[q_vec[q]];
-                auto Ap = std::make_shared<psi::Matrix>("Ap", Qsize, psize);
-                df_->fill_tensor("B", Ap, Q_range, {nq, nq + 1}, p_range);
-
-                for (size_t a = 0; a < Qsize; ++a) {
-                    for (size_t p = 0; p < psize; ++p) {
-                        out_data[p * Qqsize + q * Qsize + a] = Ap->get(a, p);
-                    }
-                }
-            }
-        } else {
-            for (size_t q = 0; q < qsize; ++q) {
-                auto nq = cmotomo[q_vec[q]];
-                auto Ap = std::make_shared<psi::Matrix>("Ap", Qsize, psize);
-                df_->fill_tensor("B", Ap, Q_range, {nq, nq + 1}, p_range);
-
-                for (size_t a = 0; a < Qsize; ++a) {
-                    for (size_t p = 0; p < psize; ++p) {
-                        out_data[a * pqsize + p * qsize + q] = Ap->get(a, p);
-                    }
-                }
-            }
-        }
     } else {
-        size_t memory = df_->get_memory() - Qsize * pqsize;
-        std::vector<size_t> vec_small = psize < qsize ? p_vec : q_vec;
-
-        size_t max_nslice = memory / (Qsize * nmo_);
-        std::vector<size_t> batches(vec_small.size() / max_nslice, max_nslice);
-        if (vec_small.size() % max_nslice)
-            batches.push_back(vec_small.size() % max_nslice);
-
-        for (size_t n = 0, offset = 0, nbatch = batches.size(); n < nbatch; ++n) {
-            std::vector<std::shared_ptr<psi::Matrix>> Am_vec;
-
-            for (size_t i = 0; i < batches[n]; ++i) {
-                auto ni = cmotomo[vec_small[i + offset]];
-                auto Am = std::make_shared<psi::Matrix>("Am", Qsize, nmo_);
-                df_->fill_tensor("B", Am, Q_range, {ni, ni + 1}, {0, nmo_});
-                Am_vec.push_back(Am);
-            }
-
-            if (psize < qsize) {
-                if (order == pqQ) {
-                    for (size_t i = 0; i < batches[n]; ++i) {
-                        for (size_t a = 0; a < Qsize; ++a) {
-                            for (size_t q = 0; q < qsize; ++q) {
-                                auto idx = (i + offset) * Qqsize + q * Qsize + a;
-                                out_data[idx] = Am_vec[i]->get(a, cmotomo[q_vec[q]]);
-                            }
-                        }
-                    }
-                } else {
-                    for (size_t i = 0; i < batches[n]; ++i) {
-                        for (size_t a = 0; a < Qsize; ++a) {
-                            for (size_t q = 0; q < qsize; ++q) {
-                                auto idx = a * pqsize + (i + offset) * qsize + q;
-                                out_data[idx] = Am_vec[i]->get(a, cmotomo[q_vec[q]]);
-                            }
-                        }
-                    }
-                }
-            } else {
-                if (order == pqQ) {
-                    for (size_t i = 0; i < batches[n]; ++i) {
-                        for (size_t a = 0; a < Qsize; ++a) {
-                            for (size_t p = 0; p < psize; ++p) {
-                                auto idx = p * Qqsize + (i + offset) * Qsize + a;
-                                out_data[idx] = Am_vec[i]->get(a, cmotomo[p_vec[p]]);
-                            }
-                        }
-                    }
-                } else {
-                    for (size_t i = 0; i < batches[n]; ++i) {
-                        for (size_t a = 0; a < Qsize; ++a) {
-                            for (size_t p = 0; p < psize; ++p) {
-                                auto idx = a * pqsize + p * qsize + (i + offset);
-                                out_data[idx] = Am_vec[i]->get(a, cmotomo[p_vec[p]]);
-                            }
+        // Read blocks B(Q|ij) where the i orbitals are consecutive and the j orbitals span the
+        // range [j_min, j_max]. Since B(Q|pq) = B(Q|qp), the index with more gaps is used as i.
+        // The rows of the blocks are then gathered into out
+        std::vector<size_t> p_mo(psize), q_mo(qsize);
+        for (size_t p = 0; p < psize; ++p)
+            p_mo[p] = cmotomo[p_vec[p]];
+        for (size_t q = 0; q < qsize; ++q)
+            q_mo[q] = cmotomo[q_vec[q]];
+
+        const size_t max_block = df_->get_memory() > Qsize * pqsize
+                                     ? df_->get_memory() - Qsize * pqsize
+                                     : Qsize * std::max(psize, qsize);
+        auto p_runs = contiguous_runs(p_mo, std::max(psize, qsize));
+        auto q_runs = contiguous_runs(q_mo, std::max(psize, qsize));
+        const bool outer_p = p_runs.size() >= q_runs.size();
+        const auto& i_mo = outer_p ? p_mo : q_mo;
+        const auto& j_mo = outer_p ? q_mo : p_mo;
+        const bool j_contiguous = outer_p ? q_contiguous : p_contiguous;
+        const auto [j_min, j_max] = std::minmax_element(j_mo.begin(), j_mo.end());
+        const size_t j_first = *j_min;
+        const size_t nj = *j_max - j_first + 1;
+        const size_t max_ni = std::max<size_t>(1, max_block / (Qsize * nj));
+
+        std::vector<double> buffer;
+        for (const auto& run : contiguous_runs(i_mo, max_ni)) {
+            const size_t i_first = i_mo[run[0]];
+            const size_t ni = run.size();
+            buffer.resize(Qsize * ni * nj);
+            df_->fill_tensor("B", buffer.data(), Q_range, {i_first, i_first + ni},
+                             {j_first, j_first + nj});
+            for (size_t a = 0; a < Qsize; ++a) {
+                for (size_t k = 0; k < ni; ++k) {
+                    const double* row = buffer.data() + (a * ni + k) * nj;
+                    if (outer_p) {
+                        double* dst = out_data.data() + a * pqsize + run[k] * qsize;
+                        if (j_contiguous) {
+                            std::copy(row + q_mo[0] - j_first, row + q_mo[0] - j_first + qsize,
+                                      dst);
+                        } else {
+                            for (size_t q = 0; q < qsize; ++q)
+                                dst[q] = row[q_mo[q] - j_first];
                         }
+                    } else {
+                        double* dst = out_data.data() + a * pqsize + run[k];
+                        for (size_t p = 0; p < psize; ++p)
+                            dst[p * qsize] = row[p_mo[p] - j_first];
                     }
                 }
             }
-
-            offset += batches[n];
         }
-
-        //        // The following loops every index for debugging
-        //        for (size_t ip = 0; ip < psize; ++ip) {
-        //            auto pn = cmotomo[p_vec[ip]];
-        //            std::vector<size_t> p_range = {pn, pn + 1};
-
-        //            for (size_t iq = 0; iq < qsize; ++iq) {
-        //                auto qn = cmotomo[q_vec[iq]];
-        //                std::vector<size_t> q_range = {qn, qn + 1};
-
-        //                double* A_chunk = new double[Asize];
-
-        //                df_->fill_tensor("B", A_chunk, A_range, p_range, q_range);
-
-        //                for (size_t a = 0; a < A_vec.size(); a++) {
-        //                    out_data[a * pqsize + ip * qsize + iq] = A_chunk[a];
-        //                }
-
-        //                delete[] A_chunk;
-        //            }
-        //        }
+        if (order == pqQ)
+            matrix_transpose_in_place(out_data, Qsize, pqsize);
     }
 
     return out;
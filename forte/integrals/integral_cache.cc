@@ -0,0 +1,77 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "integrals/integral_cache.h"
+
+namespace forte {
+
+namespace {
+/// The first bytes of an integral cache file. Change the last character when the format changes
+constexpr char integral_cache_magic[8] = {'F', 'O', 'R', 'T', 'E', 'I', 'C', '1'};
+} // namespace
+
+IntegralCacheWriter::IntegralCacheWriter(const std::string& filename, const std::string& signature)
+    : file_(filename, integral_cache_magic, signature) {}
+
+void IntegralCacheWriter::write_size(uint64_t n) { file_.write(&n, sizeof(n)); }
+
+void IntegralCacheWriter::write_array(const double* data, size_t n) {
+    write_size(n);
+    file_.write(data, n * sizeof(double));
+}
+
+void IntegralCacheWriter::commit() { file_.commit(); }
+
+IntegralCacheReader::IntegralCacheReader(const std::string& filename,
+                                         const std::string& signature)
+    : file_(filename, integral_cache_magic, signature) {}
+
+uint64_t IntegralCacheReader::read_size() { return file_.get<uint64_t>(); }
+
+const double* IntegralCacheReader::map_array(size_t n) {
+    if (read_size() != n) {
+        throw std::runtime_error("IntegralCacheReader: the size of an array does not match the "
+                                 "expected size");
+    }
+    // the arrays start at multiples of eight bytes
+    return reinterpret_cast<const double*>(file_.read(n * sizeof(double)));
+}
+
+void IntegralCacheReader::read_array(double* data, size_t n) {
+    const double* ptr = map_array(n);
+    std::memcpy(data, ptr, n * sizeof(double));
+}
+
+std::string integral_cache_filename(const std::string& directory, const std::string& signature) {
+    return cache_filename(directory, "integrals", signature);
+}
+
+} // namespace forte
@@ -0,0 +1,100 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "helpers/cache_file.h"
+
+namespace forte {
+
+/// @brief Write integrals to a binary cache file
+///
+/// The file (see CacheFileWriter) starts with a header that contains a signature of the integrals,
+/// which is checked when the file is read back with IntegralCacheReader. It is followed by sizes
+/// and arrays of doubles. The arrays are aligned to eight bytes, so they can be used directly from
+/// a memory map.
+class IntegralCacheWriter {
+  public:
+    /// Open the temporary file. Throws std::runtime_error if it cannot be created
+    /// @param filename the name of the cache file
+    /// @param signature a string that uniquely identifies the integrals
+    IntegralCacheWriter(const std::string& filename, const std::string& signature);
+
+    /// Append a size
+    void write_size(uint64_t n);
+
+    /// Append an array of n doubles
+    void write_array(const double* data, size_t n);
+
+    /// Close the temporary file and rename it. Throws std::runtime_error if any write failed
+    void commit();
+
+  private:
+    CacheFileWriter file_;
+};
+
+/// @brief Read integrals from a file written by IntegralCacheWriter
+///
+/// The file is memory-mapped and the data is read sequentially in the same order in which it was
+/// written.
+class IntegralCacheReader {
+  public:
+    /// Map a file. If the file does not exist or was written for a different signature (or with a
+    /// different format) valid() returns false
+    IntegralCacheReader(const std::string& filename, const std::string& signature);
+
+    /// @return true if the file was mapped and its header matches the signature
+    bool valid() const { return file_.valid(); }
+
+    /// @return true if all the data in the file was read
+    bool at_end() const { return file_.at_end(); }
+
+    /// Read a size. Throws std::runtime_error if the file is truncated
+    uint64_t read_size();
+
+    /// Return a pointer to the next array in the mapped file. The pointer is valid for the
+    /// lifetime of the reader. Throws std::runtime_error if the array does not have n elements
+    const double* map_array(size_t n);
+
+    /// Copy the next array to data. Throws std::runtime_error if the array does not have n
+    /// elements
+    void read_array(double* data, size_t n);
+
+  private:
+    CacheFileReader file_;
+};
+
+/// @brief Return the name of the file used to cache integrals
+/// @param directory the directory where the file is stored
+/// @param signature a string that uniquely identifies the integrals
+std::string integral_cache_filename(const std::string& directory, const std::string& signature);
+
+} // namespace forte
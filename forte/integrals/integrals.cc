@@ -546,6 +546,12 @@ std::vector<std::shared_ptr<psi::Matrix>> ForteIntegrals::mo_quadrupole_ints() c
     return std::vector<std::shared_ptr<psi::Matrix>>();
 }
 
+ambit::Tensor ForteIntegrals::active_tei_from_three_index(std::shared_ptr<psi::Matrix>,
+                                                          std::shared_ptr<psi::Matrix>) {
+    _undefined_function("active_tei_from_three_index");
+    return ambit::Tensor();
+}
+
 void ForteIntegrals::_undefined_function(const std::string& method) const {
     outfile->Printf("\n  ForteIntegrals::" + method + "not supported for integral type " +
                     std::to_string(integral_type()));
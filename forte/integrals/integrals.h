@@ -44,12 +44,15 @@ class Vector;
 class Wavefunction;
 class Dimension;
 class BasisSet;
+class DFHelper;
 } // namespace psi
 
 namespace forte {
 
 class ForteOptions;
 class MOSpaceInfo;
+class IntegralCacheReader;
+class IntegralCacheWriter;
 
 /**
  * @brief The IntegralSpinRestriction enum
@@ -409,6 +412,18 @@ class ForteIntegrals {
     ///         each of which is a nmo x nmo std::shared_ptr<psi::Matrix> in Pitzer order
     virtual std::vector<std::shared_ptr<psi::Matrix>> mo_quadrupole_ints() const;
 
+    /// @return true if active_tei_from_three_index() is available for this integral type
+    virtual bool has_three_index_ao_ints() const { return false; }
+
+    /// Compute the integrals (pu|xy) = sum_Q B(Q|pu) B(Q|xy) from the three-index AO integrals
+    /// (DF or CD) for the given orbitals, without building one Coulomb matrix per active pair
+    /// @param C the MO coefficients in the AO basis (nao x nmo, no symmetry)
+    /// @param Cact the active MO coefficients in the AO basis (nao x nactv, no symmetry)
+    /// @return a nmo x nactv x nactv x nactv tensor with (pu|xy), where p runs over the columns
+    ///         of C and u, x, y over the columns of Cact
+    virtual ambit::Tensor active_tei_from_three_index(std::shared_ptr<psi::Matrix> C,
+                                                      std::shared_ptr<psi::Matrix> Cact);
+
   protected:
     // ==> Class data <==
 
@@ -618,6 +633,13 @@ class Psi4Integrals : public ForteIntegrals {
     /// Build and return MO quadrupole integrals (XX, XY, XZ, YY, YZ, ZZ) in Pitzer order
     std::vector<std::shared_ptr<psi::Matrix>> mo_quadrupole_ints() const override;
 
+    /// DF and DiskDF integrals compute (pu|xy) with a DFHelper object
+    bool has_three_index_ao_ints() const override;
+
+    /// Compute (pu|xy) with the DFHelper object (DF and DiskDF integrals)
+    ambit::Tensor active_tei_from_three_index(std::shared_ptr<psi::Matrix> C,
+                                              std::shared_ptr<psi::Matrix> Cact) override;
+
   private:
     void base_initialize_psi4();
     void setup_psi4_ints();
@@ -630,18 +652,44 @@ class Psi4Integrals : public ForteIntegrals {
     /// Build AO dipole and quadrupole integrals
     void build_multipole_ints_ao() override;
 
+    /// @return the directory where the integrals are cached
+    std::string integral_cache_directory() const;
+
     /// Make a shared pointer to a Psi4 JK object
     void make_psi4_JK();
     /// Call JK intialize
     void jk_initialize(double mem_percentage = 0.8, int print_level = 1);
 
+    /// DFHelper used by active_tei_from_three_index(). It is kept so that the AO integrals are
+    /// computed only once when the orbitals change
+    std::shared_ptr<psi::DFHelper> active_dfh_;
+
     /// AO Fock control
     enum class FockAOStatus { none, inactive, generalized };
     FockAOStatus fock_ao_level_ = FockAOStatus::none;
 
+    /// @return a string that identifies the two-electron integrals before freezing orbitals
+    std::string integral_cache_signature() const;
+
   protected:
     void freeze_core_orbitals() override;
 
+    /// Read the two-electron integrals from the cache file (if INT_CACHE is true)
+    /// @return true if the integrals were read
+    bool read_integral_cache();
+    /// Write the two-electron integrals to the cache file (if INT_CACHE is true)
+    void write_integral_cache();
+    /// Read the two-electron integrals stored by write_cached_integrals()
+    virtual void read_cached_integrals(IntegralCacheReader& reader);
+    /// Write the two-electron integrals to a cache file
+    virtual void write_cached_integrals(IntegralCacheWriter& writer);
+
+    /// @return the number of auxiliary indices processed at once by active_tei_from_three_index(),
+    ///         so that the batches use at most 10% of the memory
+    /// @param nthree the number of auxiliary indices
+    /// @param nelements the number of elements stored for each auxiliary index
+    size_t active_tei_batch_size(size_t nthree, size_t nelements) const;
+
     // threshold for DF fitting condition (Psi4)
     double df_fitting_cutoff_;
     // threshold for Schwarz cutoff (Psi4)
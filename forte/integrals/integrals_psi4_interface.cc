@@ -26,12 +26,15 @@
  * @END LICENSE
  */
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 #include "psi4/psi4-dec.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libmints/vector.h"
 
 #include "psi4/libfock/jk.h"
+#include "psi4/lib3index/dfhelper.h"
 
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/integral.h"
@@ -39,10 +42,14 @@
 #include "psi4/libmints/molecule.h"
 #include "psi4/libmints/wavefunction.h"
 #include "psi4/libpsi4util/process.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libqt/qt.h"
 
+#include "base_classes/forte_options.h"
 #include "base_classes/mo_space_info.h"
 #include "helpers/printing.h"
 #include "helpers/timer.h"
+#include "integrals/integral_cache.h"
 #include "integrals/integrals.h"
 
 #ifdef HAVE_GA
@@ -319,6 +326,123 @@ void Psi4Integrals::freeze_core_orbitals() {
     }
 }
 
+namespace {
+/// Hash the shells of a basis set (centers, angular momenta, exponents, and contraction
+/// coefficients), so that two basis sets with the same name and size but different parameters
+/// (e.g., a basis modified in the input) give different integral cache signatures
+uint64_t basis_set_hash(const psi::BasisSet& basis) {
+    uint64_t hash = fnv1a_hash(nullptr, 0);
+    for (int i = 0; i < basis.nshell(); ++i) {
+        const auto& shell = basis.shell(i);
+        const int labels[3] = {shell.ncenter(), shell.am(), shell.is_pure()};
+        hash = fnv1a_hash(labels, sizeof(labels), hash);
+        for (int p = 0; p < shell.nprimitive(); ++p) {
+            const double primitive[2] = {shell.exp(p), shell.original_coef(p)};
+            hash = fnv1a_hash(primitive, sizeof(primitive), hash);
+        }
+    }
+    return hash;
+}
+} // namespace
+
+std::string Psi4Integrals::integral_cache_signature() const {
+    // the geometry, the basis sets, and the orbitals are hashed, everything else is stored as text
+    auto molecule = wfn_->molecule();
+    uint64_t geometry_hash = fnv1a_hash(nullptr, 0);
+    for (int A = 0; A < molecule->natom(); ++A) {
+        const double atom[4] = {molecule->Z(A), molecule->x(A), molecule->y(A), molecule->z(A)};
+        geometry_hash = fnv1a_hash(atom, sizeof(atom), geometry_hash);
+    }
+    uint64_t orbitals_hash = fnv1a_hash(nullptr, 0);
+    for (int h = 0; h < nirrep_; ++h) {
+        const size_t size = static_cast<size_t>(Ca_->rowspi(h)) * Ca_->colspi(h);
+        if (size > 0)
+            orbitals_hash = fnv1a_hash(Ca_->pointer(h)[0], size * sizeof(double), orbitals_hash);
+    }
+
+    auto basis = wfn_->basisset();
+    std::ostringstream s;
+    s << std::setprecision(17) << "int_type=" << integral_type_ << " restricted="
+      << (spin_restriction_ == IntegralSpinRestriction::Restricted) << " nmopi=";
+    for (int h = 0; h < nirrep_; ++h)
+        s << nmopi_[h] << ",";
+    s << " charge=" << molecule->molecular_charge() << " basis=" << basis->name()
+      << " nbf=" << basis->nbf() << " nshell=" << basis->nshell()
+      << " nprimitive=" << basis->nprimitive() << " ints_tolerance=" << schwarz_cutoff_;
+    std::shared_ptr<psi::BasisSet> auxiliary;
+    if (integral_type_ == DF) {
+        auxiliary = wfn_->get_basisset("DF_BASIS_MP2");
+        s << " df_basis=" << auxiliary->name() << " df_nbf=" << auxiliary->nbf()
+          << " df_fitting_condition=" << df_fitting_cutoff_;
+    }
+    if (integral_type_ == Cholesky) {
+        s << " cholesky_tolerance=" << options_->get_double("CHOLESKY_TOLERANCE");
+    }
+    s << std::hex << " geometry=" << geometry_hash << " basis_hash=" << basis_set_hash(*basis);
+    if (auxiliary) {
+        s << " df_basis_hash=" << basis_set_hash(*auxiliary);
+    }
+    s << " Ca=" << orbitals_hash;
+    return s.str();
+}
+
+bool Psi4Integrals::read_integral_cache() {
+    if (not options_->get_bool("INT_CACHE"))
+        return false;
+    const auto signature = integral_cache_signature();
+    const auto filename = integral_cache_filename(integral_cache_directory(), signature);
+    IntegralCacheReader reader(filename, signature);
+    if (not reader.valid())
+        return false;
+    try {
+        read_cached_integrals(reader);
+        if (not reader.at_end()) {
+            throw std::runtime_error("IntegralCacheReader: unexpected data at the end of the file");
+        }
+    } catch (const std::runtime_error& e) {
+        // a damaged file is not fatal, the integrals are recomputed and the file is overwritten
+        outfile->Printf("\n  Warning: %s (%s). The integrals will be recomputed.\n", e.what(),
+                        filename.c_str());
+        return false;
+    }
+    if (print_) {
+        outfile->Printf("\n  Read the two-electron integrals from the cache file %s",
+                        filename.c_str());
+    }
+    return true;
+}
+
+void Psi4Integrals::write_integral_cache() {
+    if (not options_->get_bool("INT_CACHE"))
+        return;
+    const auto signature = integral_cache_signature();
+    const auto filename = integral_cache_filename(integral_cache_directory(), signature);
+    try {
+        IntegralCacheWriter writer(filename, signature);
+        write_cached_integrals(writer);
+        writer.commit();
+    } catch (const std::runtime_error& e) {
+        // the cache is only an optimization, so failing to write it is not fatal
+        outfile->Printf("\n  Warning: %s. The integrals will not be cached.\n", e.what());
+    }
+}
+
+std::string Psi4Integrals::integral_cache_directory() const {
+    auto directory = options_->get_str("INT_CACHE_DIR");
+    if (directory.empty()) {
+        directory = psi::PSIOManager::shared_object()->get_default_path();
+    }
+    return directory;
+}
+
+void Psi4Integrals::read_cached_integrals(IntegralCacheReader&) {
+    _undefined_function("read_cached_integrals");
+}
+
+void Psi4Integrals::write_cached_integrals(IntegralCacheWriter&) {
+    _undefined_function("write_cached_integrals");
+}
+
 void Psi4Integrals::rotate_mos() {
     auto rotate_mos_list = options_->get_int_list("ROTATE_MOS");
     int size_mo_rotate = rotate_mos_list.size();
@@ -786,4 +910,79 @@ Psi4Integrals::make_fock_active_unrestricted(std::shared_ptr<psi::Matrix> g1a,
 
     return {Fa_active, Fb_active};
 }
+
+bool Psi4Integrals::has_three_index_ao_ints() const {
+    return integral_type_ == DF or integral_type_ == DiskDF;
+}
+
+size_t Psi4Integrals::active_tei_batch_size(size_t nthree, size_t nelements) const {
+    size_t mem = psi::Process::environment.get_memory() * 0.1 / sizeof(double);
+    return std::max<size_t>(1, std::min(nthree, mem / std::max<size_t>(1, nelements)));
+}
+
+ambit::Tensor Psi4Integrals::active_tei_from_three_index(std::shared_ptr<psi::Matrix> C,
+                                                         std::shared_ptr<psi::Matrix> Cact) {
+    if (not has_three_index_ao_ints()) {
+        _undefined_function("active_tei_from_three_index");
+    }
+    size_t nmo = C->colspi()[0];
+    size_t nactv = Cact->colspi()[0];
+    size_t nactv2 = nactv * nactv;
+
+    auto tei = ambit::Tensor::build(ambit::CoreTensor, "(pu|xy)", {nmo, nactv, nactv, nactv});
+    if (nactv == 0)
+        return tei;
+
+    if (not active_dfh_) {
+        // use the same auxiliary basis as JK, so that the two algorithms give the same integrals
+        auto primary = wfn_->basisset();
+        auto auxiliary = wfn_->get_basisset("DF_BASIS_MP2");
+        auto job_type = options_->get_str("JOB_TYPE");
+        if (job_type == "CASSCF" or job_type == "MCSCF_TWO_STEP")
+            auxiliary = wfn_->get_basisset("DF_BASIS_SCF");
+
+        int64_t mem = psi::Process::environment.get_memory() * 0.8 / sizeof(double);
+        if (JK_status_ == JKStatus::initialized)
+            mem -= JK_->memory_estimate();
+        if (mem <= 0) {
+            throw std::runtime_error("Not enough memory to build (pu|xy) from DF integrals. "
+                                     "Try CASSCF_TEI_BUILDER JK.");
+        }
+
+        active_dfh_ = std::make_shared<psi::DFHelper>(primary, auxiliary);
+        active_dfh_->set_schwarz_cutoff(schwarz_cutoff_);
+        active_dfh_->set_fitting_condition(df_fitting_cutoff_);
+        active_dfh_->set_memory(static_cast<size_t>(mem));
+        // keep B(Q|pu) in core if it takes less than half of the memory
+        size_t naux = auxiliary->nbf();
+        active_dfh_->set_MO_core(naux * (nmo * nactv + nactv2) < static_cast<size_t>(mem) / 2);
+        active_dfh_->set_nthreads(omp_get_max_threads());
+        active_dfh_->set_print_lvl(0);
+        active_dfh_->initialize();
+    }
+
+    active_dfh_->clear_spaces();
+    active_dfh_->add_space("p", C);
+    active_dfh_->add_space("a", Cact);
+    active_dfh_->add_transformation("Bpa", "p", "a", "Qpq");
+    active_dfh_->add_transformation("Baa", "a", "a", "Qpq");
+    active_dfh_->transform();
+
+    // (pu|xy) = sum_Q B(Q|pu) B(Q|xy), accumulated in batches of Q
+    size_t naux = active_dfh_->get_naux();
+    size_t npa = nmo * nactv;
+    size_t batch = active_tei_batch_size(naux, npa + nactv2);
+    std::vector<double> Bpa(batch * npa);
+    std::vector<double> Baa(batch * nactv2);
+    auto& tei_data = tei.data();
+    for (size_t Q = 0; Q < naux; Q += batch) {
+        size_t nQ = std::min(batch, naux - Q);
+        active_dfh_->fill_tensor("Bpa", Bpa.data(), {Q, Q + nQ});
+        active_dfh_->fill_tensor("Baa", Baa.data(), {Q, Q + nQ});
+        C_DGEMM('T', 'N', npa, nactv2, nQ, 1.0, Bpa.data(), npa, Baa.data(), nactv2, 1.0,
+                tei_data.data(), nactv2);
+    }
+
+    return tei;
+}
 } // namespace forte
@@ -0,0 +1,141 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <cmath>
+
+#include "integrals/packed_tei.h"
+
+namespace forte {
+
+namespace {
+/// The largest deviation from the permutational symmetry allowed when packing the integrals
+constexpr double packing_tolerance = 1.0e-12;
+} // namespace
+
+PackedTEILayout::PackedTEILayout(size_t nmo)
+    : nmo_(nmo), aa_pair_(nmo * nmo, 0), aa_pair_sign_(nmo * nmo, 0.0), ab_pair_(nmo * nmo, 0) {
+    for (size_t p = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < p; ++q) {
+            aa_pair_[p * nmo_ + q] = aa_pair_[q * nmo_ + p] = p * (p - 1) / 2 + q;
+            aa_pair_sign_[p * nmo_ + q] = 1.0;
+            aa_pair_sign_[q * nmo_ + p] = -1.0;
+        }
+        for (size_t r = 0; r <= p; ++r) {
+            ab_pair_[p * nmo_ + r] = ab_pair_[r * nmo_ + p] = p * (p + 1) / 2 + r;
+        }
+    }
+}
+
+size_t PackedTEILayout::aa_size() const {
+    const size_t npairs = nmo_ * (nmo_ - 1) / 2;
+    return npairs * (npairs + 1) / 2;
+}
+
+size_t PackedTEILayout::ab_size() const {
+    const size_t npairs = nmo_ * (nmo_ + 1) / 2;
+    return npairs * (npairs + 1) / 2;
+}
+
+std::vector<double> PackedTEILayout::pack_aa(const std::vector<double>& v) const {
+    std::vector<double> packed(aa_size());
+    for (size_t p = 0; p < nmo_; ++p) {
+        for (size_t q = 0; q < p; ++q) {
+            const size_t pq = aa_pair_[p * nmo_ + q];
+            for (size_t r = 0; r < nmo_; ++r) {
+                for (size_t s = 0; s < r; ++s) {
+                    const size_t rs = aa_pair_[r * nmo_ + s];
+                    if (rs <= pq)
+                        packed[pair_pair_index(pq, rs)] = v[((p * nmo_ + q) * nmo_ + r) * nmo_ + s];
+                }
+            }
+        }
+    }
+    return packed;
+}
+
+std::vector<double> PackedTEILayout::pack_ab(const std::vector<double>& v) const {
+    std::vector<double> packed(ab_size());
+    for (size_t p = 0; p < nmo_; ++p) {
+        for (size_t r = 0; r <= p; ++r) {
+            const size_t pr = ab_pair_[p * nmo_ + r];
+            for (size_t q = 0; q < nmo_; ++q) {
+                for (size_t s = 0; s <= q; ++s) {
+                    const size_t qs = ab_pair_[q * nmo_ + s];
+                    if (qs <= pr)
+                        packed[pair_pair_index(pr, qs)] = v[((p * nmo_ + q) * nmo_ + r) * nmo_ + s];
+                }
+            }
+        }
+    }
+    return packed;
+}
+
+bool is_antisymmetrized_hermitian(const std::vector<double>& v, size_t n) {
+    auto index = [n](size_t p, size_t q, size_t r, size_t s) {
+        return ((p * n + q) * n + r) * n + s;
+    };
+    for (size_t p = 0; p < n; ++p) {
+        for (size_t q = 0; q < n; ++q) {
+            for (size_t r = 0; r < n; ++r) {
+                for (size_t s = 0; s < n; ++s) {
+                    const double v_pqrs = v[index(p, q, r, s)];
+                    if ((std::fabs(v_pqrs + v[index(q, p, r, s)]) > packing_tolerance) or
+                        (std::fabs(v_pqrs + v[index(p, q, s, r)]) > packing_tolerance) or
+                        (std::fabs(v_pqrs - v[index(r, s, p, q)]) > packing_tolerance))
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool has_real_orbital_symmetry(const std::vector<double>& v, size_t n) {
+    auto index = [n](size_t p, size_t q, size_t r, size_t s) {
+        return ((p * n + q) * n + r) * n + s;
+    };
+    // the packed layout stores (pr|qs) for p >= r, q >= s, and pr >= qs, so it needs the symmetry
+    // under p <-> r, under the exchange of the two electrons, and under q <-> s (which follows
+    // from the first and the last check)
+    for (size_t p = 0; p < n; ++p) {
+        for (size_t q = 0; q < n; ++q) {
+            for (size_t r = 0; r < n; ++r) {
+                for (size_t s = 0; s < n; ++s) {
+                    const double v_pqrs = v[index(p, q, r, s)];
+                    if ((std::fabs(v_pqrs - v[index(r, q, p, s)]) > packing_tolerance) or
+                        (std::fabs(v_pqrs - v[index(q, p, s, r)]) > packing_tolerance) or
+                        (std::fabs(v_pqrs - v[index(r, s, p, q)]) > packing_tolerance))
+                        return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace forte
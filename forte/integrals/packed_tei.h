@@ -0,0 +1,98 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace forte {
+
+/// @brief The layout of the two-electron integrals of restricted real orbitals in packed form
+///
+/// The integrals are passed as dense nmo^4 arrays in physicist notation and stored as:
+/// - the same-spin antisymmetrized integrals <pq||rs> for p > q, r > s, and pq >= rs;
+/// - the opposite-spin integrals (pr|qs) = <pq|rs> for p >= r, q >= s, and pr >= qs.
+/// Each packed array has about nmo^4/8 elements. The element of a packed array that corresponds to
+/// a set of indices is found with two lookups in precomputed pair tables.
+class PackedTEILayout {
+  public:
+    /// Build the pair tables for nmo orbitals
+    explicit PackedTEILayout(size_t nmo = 0);
+
+    /// Return the number of elements of the packed same-spin integrals
+    size_t aa_size() const;
+    /// Return the number of elements of the packed opposite-spin integrals
+    size_t ab_size() const;
+
+    /// Return <pq||rs> from the packed same-spin integrals
+    double aa(const std::vector<double>& packed, size_t p, size_t q, size_t r, size_t s) const {
+        const size_t pq = p * nmo_ + q;
+        const size_t rs = r * nmo_ + s;
+        return aa_pair_sign_[pq] * aa_pair_sign_[rs] *
+               packed[pair_pair_index(aa_pair_[pq], aa_pair_[rs])];
+    }
+    /// Return <pq|rs> from the packed opposite-spin integrals
+    double ab(const std::vector<double>& packed, size_t p, size_t q, size_t r, size_t s) const {
+        // <pq|rs> = (pr|qs)
+        return packed[pair_pair_index(ab_pair_[p * nmo_ + r], ab_pair_[q * nmo_ + s])];
+    }
+
+    /// Pack the dense same-spin integrals <pq||rs>
+    std::vector<double> pack_aa(const std::vector<double>& v) const;
+    /// Pack the dense opposite-spin integrals <pq|rs>
+    std::vector<double> pack_ab(const std::vector<double>& v) const;
+
+  private:
+    /// The index of the pair of pairs (pq,rs) in the packed arrays
+    static size_t pair_pair_index(size_t pq, size_t rs) {
+        return pq >= rs ? pq * (pq + 1) / 2 + rs : rs * (rs + 1) / 2 + pq;
+    }
+
+    /// The number of MOs
+    size_t nmo_;
+    /// The index of the pair (p,q) with p > q in the packed same-spin integrals, stored at
+    /// p * nmo + q and q * nmo + p
+    std::vector<size_t> aa_pair_;
+    /// The sign of the pair (p,q) in the packed same-spin integrals (+1 if p > q, -1 if p < q,
+    /// and 0 if p = q)
+    std::vector<double> aa_pair_sign_;
+    /// The index of the pair (p,r) with p >= r in the packed opposite-spin integrals, stored at
+    /// p * nmo + r and r * nmo + p
+    std::vector<size_t> ab_pair_;
+};
+
+/// Return true if the dense antisymmetrized integrals (nmo = n) satisfy
+/// <pq||rs> = -<qp||rs> = -<pq||sr> = <rs||pq>, so they can be packed with PackedTEILayout
+bool is_antisymmetrized_hermitian(const std::vector<double>& v, size_t n);
+
+/// Return true if the dense integrals (nmo = n) have the symmetries of real orbitals assumed by the
+/// packed opposite-spin layout, <pq|rs> = <rq|ps> = <qp|sr> = <rs|pq>
+bool has_real_orbital_symmetry(const std::vector<double>& v, size_t n);
+
+} // namespace forte
@@ -26,6 +26,10 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+
+#include <unistd.h>
+
 #include "dsrg_source.h"
 
 namespace forte {
@@ -40,4 +44,61 @@ LABS_SOURCE::LABS_SOURCE(double s, double taylor_threshold) : DSRG_SOURCE(s, tay
 DYSON_SOURCE::DYSON_SOURCE(double s, double taylor_threshold) : DSRG_SOURCE(s, taylor_threshold) {}
 
 MP2_SOURCE::MP2_SOURCE(double s, double taylor_threshold) : DSRG_SOURCE(s, taylor_threshold) {}
+
+double ccvv_pair_energy(const double* Jab, size_t nv, double e_ij, const double* e_v,
+                        DSRG_SOURCE* source) {
+    double energy = 0.0;
+    for (size_t a = 0; a < nv; ++a) {
+        for (size_t b = 0; b < nv; ++b) {
+            const double J = Jab[a * nv + b];
+            const double D = e_ij - e_v[a] - e_v[b];
+            const double T = source ? (1.0 + source->compute_renormalized(D)) *
+                                          source->compute_renormalized_denominator(D)
+                                    : 1.0 / D;
+            energy += J * (2.0 * J - Jab[b * nv + a]) * T;
+        }
+    }
+    return energy;
+}
+
+size_t ccvv_tile_size(size_t nvirtual) {
+    long l2_size = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    l2_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (l2_size <= 0)
+        l2_size = 256 * 1024;
+    size_t tile = std::sqrt(static_cast<double>(l2_size) / (4 * sizeof(double)));
+    tile = std::max<size_t>(8, tile / 8 * 8);
+    return std::min(tile, nvirtual);
+}
+
+double ccvv_tile_energy(const double* X, const double* Y, size_t e0, size_t ne, size_t f0,
+                        size_t nf, double Fm_a, double Fm_b, double Fn_a, double Fn_b,
+                        const double* Fv_a, const double* Fv_b, DSRG_SOURCE* source) {
+    auto R = [source](double D) {
+        return source ? source->compute_renormalized_denominator(D) *
+                            (1.0 + source->compute_renormalized(D))
+                      : 1.0 / D;
+    };
+    double energy = 0.0;
+    for (size_t e = 0; e < ne; ++e) {
+        for (size_t f = 0; f < nf; ++f) {
+            const double x = X[e * nf + f];
+            const double y = Y[f * ne + e];
+            const double Fe_a = Fv_a[e0 + e], Ff_a = Fv_a[f0 + f];
+            if (Fv_b == nullptr) {
+                const double D = Fm_a + Fn_a - Fe_a - Ff_a;
+                energy += 2.0 * R(D) * ((x - y) * (x - y) + x * x + y * y);
+            } else {
+                const double Fe_b = Fv_b[e0 + e], Ff_b = Fv_b[f0 + f];
+                energy += (x - y) * (x - y) *
+                          (R(Fm_a + Fn_a - Fe_a - Ff_a) + R(Fm_b + Fn_b - Fe_b - Ff_b));
+                energy += x * x * (R(Fm_a + Fn_b - Fe_a - Ff_b) + R(Fn_a + Fm_b - Ff_a - Fe_b));
+                energy += y * y * (R(Fm_a + Fn_b - Ff_a - Fe_b) + R(Fn_a + Fm_b - Fe_a - Ff_b));
+            }
+        }
+    }
+    return energy;
+}
 } // namespace forte
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <stdexcept>
 
 namespace forte {
@@ -197,4 +198,53 @@ class MP2_SOURCE : public DSRG_SOURCE {
 
     virtual double compute_renormalized_denominator(const double& D) { return 1.0 / D; }
 };
+
+/**
+ * @brief The contribution of a pair of core orbitals (i,j) to the DF-DSRG-MRPT2 CCVV energy
+ *
+ *     sum_ab (ia|jb) [2 (ia|jb) - (ib|ja)] [1 + R(D)] T(D),   D = e_i + e_j - e_a - e_b
+ *
+ * where R and T are the renormalized term and denominator of the source. If source is null the
+ * unregularized MP2 expression (ia|jb) [2 (ia|jb) - (ib|ja)] / D is used.
+ * @param Jab the integrals (ia|jb) stored as a row-major nv x nv matrix
+ * @param nv the number of virtual orbitals
+ * @param e_ij the sum of the core orbital energies e_i + e_j
+ * @param e_v the virtual orbital energies
+ * @param source the DSRG source
+ */
+double ccvv_pair_energy(const double* Jab, size_t nv, double e_ij, const double* e_v,
+                        DSRG_SOURCE* source);
+
+/**
+ * @brief The size of the square tiles of (me|nf) formed by the fused CCVV algorithm of
+ * THREE_DSRG_MRPT2. The two tiles formed at once should take at most half of the L2 cache, leaving
+ * room for the slices of B they are built from. The size is a multiple of eight (at least eight)
+ * and at most nvirtual
+ */
+size_t ccvv_tile_size(size_t nvirtual);
+
+/**
+ * @brief The contribution of the core pair (m,n) and the virtual tiles (E,F) to the fused CCVV
+ * energy of THREE_DSRG_MRPT2, summed over the (m,n)/(n,m) and (e,f)/(f,e) terms
+ *
+ *     (X - Y)^2 [R(Daa) + R(Dbb)] + X^2 [R(Dab(mn,ef)) + R(Dab(nm,fe))]
+ *                                 + Y^2 [R(Dab(mn,fe)) + R(Dab(nm,ef))]
+ *
+ * where R(D) = [1 + r(D)] t(D), with r and t the renormalized term and denominator of the source,
+ * or R(D) = 1 / D if source is null. The caller weights the pairs with m = n or E = F by 1/2.
+ * @param X the integrals (me|nf) stored as a row-major ne x nf matrix
+ * @param Y the integrals (mf|ne) stored as a row-major nf x ne matrix
+ * @param e0 the first virtual orbital of tile E
+ * @param ne the number of virtual orbitals in tile E
+ * @param f0 the first virtual orbital of tile F
+ * @param nf the number of virtual orbitals in tile F
+ * @param Fm_a, Fm_b, Fn_a, Fn_b the alpha and beta energies of the core orbitals m and n
+ * @param Fv_a the alpha virtual orbital energies
+ * @param Fv_b the beta virtual orbital energies. If null, the alpha and beta energies of all the
+ *        orbitals are assumed to be equal
+ * @param source the DSRG source
+ */
+double ccvv_tile_energy(const double* X, const double* Y, size_t e0, size_t ne, size_t f0,
+                        size_t nf, double Fm_a, double Fm_b, double Fn_a, double Fn_b,
+                        const double* Fv_a, const double* Fv_b, DSRG_SOURCE* source);
 } // namespace forte
@@ -184,6 +184,8 @@ void SA_MRDSRG::check_memory() {
         mem_comm = std::max(mem_comm, dsrg_mem_.compute_memory({"ppph"}));
     }
     dsrg_mem_.add_entry("Local intermediates for commutators", mem_comm, false);
+    // keep the temporaries of the commutators between iterations within the same budget
+    temp_pool_.set_memory_limit(mem_comm / sizeof(double));
 
     dsrg_mem_.print("MR-DSRG (" + corrlv_string_ + ")");
 }
@@ -445,7 +445,7 @@ double SA_MRPT2::E_V_T2_CCVV() {
     // test memory
     int nthreads = std::min(n_threads_, int(nc * (nc + 1) / 2));
     size_t memory_avai = dsrg_mem_.available();
-    size_t memory_min = 2 * nthreads * nv * nv;
+    size_t memory_min = nthreads * nv * nv;
     size_t batch_min_size = 2 * nQv;
     if ((memory_min + batch_min_size) * sizeof(double) > memory_avai) {
         outfile->Printf("\n  Error: Not enough memory for DF-DSRG-PT2(CCVV) energy.");
@@ -471,14 +471,18 @@ double SA_MRPT2::E_V_T2_CCVV() {
     bool complete_ccvv = (ccvv_source_ == "ZERO");
 
     // temp tensors for each thread
-    std::vector<ambit::Tensor> Jab(nthreads), JKab(nthreads);
+    std::vector<ambit::Tensor> Jab(nthreads);
 
     for (int i = 0; i < nthreads; ++i) {
         std::string t = std::to_string(i);
         Jab[i] = ambit::Tensor::build(CoreTensor, "Jab_thread" + t, {nv, nv});
-        JKab[i] = ambit::Tensor::build(CoreTensor, "JKab_thread" + t, {nv, nv});
     }
 
+    std::vector<double> Fv(nv);
+    for (size_t a = 0; a < nv; ++a)
+        Fv[a] = Fdiag_[virt_mos_[a]];
+    DSRG_SOURCE* source = complete_ccvv ? nullptr : dsrg_source_.get();
+
     bool Bcv_file_exist =
         !semi_checked_results_["RESTRICTED_DOCC"] or !semi_checked_results_["RESTRICTED_UOCC"];
 
@@ -540,24 +544,9 @@ double SA_MRPT2::E_V_T2_CCVV() {
                 psi::C_DGEMM('N', 'T', nv, nv, nQ, 1.0, Bia_ptr, nQ, Bjb_ptr, nQ, 0.0,
                              Jab[thread].data().data(), nv);
 
-                JKab[thread]("pq") = 2.0 * Jab[thread]("pq") - Jab[thread]("qp");
-
-                if (complete_ccvv) {
-                    Jab[thread].iterate([&](const std::vector<size_t>& i, double& value) {
-                        value /=
-                            fock_i + fock_j - Fdiag_[virt_mos_[i[0]]] - Fdiag_[virt_mos_[i[1]]];
-                    });
-                } else {
-                    Jab[thread].iterate([&](const std::vector<size_t>& i, double& value) {
-                        auto D =
-                            fock_i + fock_j - Fdiag_[virt_mos_[i[0]]] - Fdiag_[virt_mos_[i[1]]];
-                        value *= (1.0 + dsrg_source_->compute_renormalized(D)) *
-                                 dsrg_source_->compute_renormalized_denominator(D);
-                    });
-                }
-
                 auto factor = (i_batch_occ_mos[i] == j_batch_occ_mos[j]) ? 1.0 : 2.0;
-                Eout += factor * Jab[thread]("ef") * JKab[thread]("ef");
+                Eout += factor * ccvv_pair_energy(Jab[thread].data().data(), nv, fock_i + fock_j,
+                                                  Fv.data(), source);
             }
             j_shift += j_nocc;
         }
@@ -40,6 +40,7 @@
 #include "forte-def.h"
 #include "helpers/helpers.h"
 #include "helpers/printing.h"
+#include "helpers/tensor_rotation.h"
 #include "helpers/timer.h"
 
 #include "sadsrg.h"
@@ -52,7 +53,8 @@ SADSRG::SADSRG(std::shared_ptr<RDMs> rdms, std::shared_ptr<SCFInfo> scf_info,
                std::shared_ptr<ForteOptions> options, std::shared_ptr<ForteIntegrals> ints,
                std::shared_ptr<MOSpaceInfo> mo_space_info)
     : DynamicCorrelationSolver(rdms, scf_info, options, ints, mo_space_info),
-      BTF_(new BlockedTensorFactory()), tensor_type_(ambit::CoreTensor) {
+      BTF_(new BlockedTensorFactory()), tensor_type_(ambit::CoreTensor),
+      temp_pool_(tensor_type_) {
     n_threads_ = omp_get_max_threads();
     std::string thread_title =
         std::to_string(n_threads_) + (n_threads_ > 1 ? " OMP threads" : " OMP thread");
@@ -68,6 +70,7 @@ SADSRG::SADSRG(std::shared_ptr<RDMs> rdms, std::shared_ptr<SCFInfo> scf_info,
 
 SADSRG::~SADSRG() {
     dsrg_time_.print_comm_time();
+    temp_pool_.print_summary("DSRG Temporary Tensors");
 
     if (warnings_.size() != 0) {
         print_h2("DSRG Warnings");
@@ -721,21 +724,21 @@ void SADSRG::set_Uactv(ambit::Tensor& U) {
 
 void SADSRG::rotate_one_ints_to_original(BlockedTensor& H1) {
     auto Ua = Uactv_.block("aa");
-    auto temp = H1.block("aa").clone(tensor_type_);
-    H1.block("aa")("pq") = Ua("pu") * temp("uv") * Ua("qv");
+    const double* ua = Ua.data().data();
+    TensorRotation(Ua.dim(0)).rotate(H1.block("aa").data().data(), {ua, ua}, false);
 }
 
 void SADSRG::rotate_two_ints_to_original(BlockedTensor& H2) {
     auto Ua = Uactv_.block("aa");
-    auto temp = H2.block("aaaa").clone(tensor_type_);
-    H2.block("aaaa")("pqrs") = Ua("pa") * Ua("qb") * temp("abcd") * Ua("rc") * Ua("sd");
+    const double* ua = Ua.data().data();
+    TensorRotation(Ua.dim(0)).rotate(H2.block("aaaa").data().data(), {ua, ua, ua, ua}, false);
 }
 
 void SADSRG::rotate_three_ints_to_original(BlockedTensor& H3) {
     auto Ua = Uactv_.block("aa");
-    auto temp = H3.block("aaaaaa").clone(tensor_type_);
-    H3.block("aaaaaa")("pqrstu") =
-        Ua("pa") * Ua("qb") * Ua("rc") * temp("abcijk") * Ua("si") * Ua("tj") * Ua("uk");
+    const double* ua = Ua.data().data();
+    TensorRotation(Ua.dim(0)).rotate(H3.block("aaaaaa").data().data(), {ua, ua, ua, ua, ua, ua},
+                                     false);
 }
 
 bool SADSRG::check_semi_orbs() {
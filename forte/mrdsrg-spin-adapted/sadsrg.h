@@ -34,6 +34,7 @@
 #include "base_classes/dynamic_correlation_solver.h"
 
 #include "helpers/blockedtensorfactory.h"
+#include "helpers/tensor_pool.h"
 #include "mrdsrg-helper/dsrg_mem.h"
 #include "mrdsrg-helper/dsrg_source.h"
 #include "mrdsrg-helper/dsrg_time.h"
@@ -195,6 +196,8 @@ class SADSRG : public DynamicCorrelationSolver {
     std::shared_ptr<BlockedTensorFactory> BTF_;
     /// Tensor type for Ambit
     ambit::TensorType tensor_type_;
+    /// Pool of the temporary tensors used in the commutators
+    TensorPool temp_pool_;
 
     /// Core MO label
     std::string core_label_;
@@ -42,7 +42,7 @@ double SADSRG::H1_T1_C0(BlockedTensor& H1, BlockedTensor& T1, const double& alph
     double E = 0.0;
     E += 2.0 * H1["am"] * T1["ma"];
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "Temp110", {"aa"});
+    auto temp = temp_pool_.get("Temp110", {"aa"});
     temp["uv"] += H1["ev"] * T1["ue"];
     temp["uv"] -= H1["um"] * T1["mv"];
 
@@ -62,7 +62,7 @@ double SADSRG::H1_T2_C0(BlockedTensor& H1, BlockedTensor& T2, const double& alph
     local_timer timer;
 
     double E = 0.0;
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "Temp120", {"aaaa"});
+    auto temp = temp_pool_.get("Temp120", {"aaaa"});
     temp["uvxy"] += H1["ex"] * T2["uvey"];
     temp["uvxy"] -= H1["vm"] * T2["muyx"];
 
@@ -83,7 +83,7 @@ double SADSRG::H2_T1_C0(BlockedTensor& H2, BlockedTensor& T1, const double& alph
 
     double E = 0.0;
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "Temp120", {"aaaa"});
+    auto temp = temp_pool_.get("Temp120", {"aaaa"});
     temp["uvxy"] += H2["evxy"] * T1["ue"];
     temp["uvxy"] -= H2["uvmy"] * T1["mx"];
 
@@ -155,7 +155,7 @@ std::vector<double> SADSRG::H2_T2_C0_T2small(BlockedTensor& H2, BlockedTensor& T
     E1 += 0.25 * H2["vymn"] * S2["mnux"] * Eta1_["uv"] * Eta1_["xy"];
 
     // [H2, T2] L1 from caav
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "temp_caav", {"aaaa"});
+    auto temp = temp_pool_.get("temp_caav", {"aaaa"});
     temp["uxyv"] += 0.5 * H2["vemx"] * S2["myue"];
     temp["uxyv"] += 0.5 * H2["vexm"] * S2["ymue"];
     E1 += temp["uxyv"] * Eta1_["uv"] * L1_["xy"];
@@ -250,7 +250,7 @@ std::vector<double> SADSRG::H2_T2_C0_T2small(BlockedTensor& H2, BlockedTensor& T
             // => spin-free 1- and 2-cumulant contributions <=
 
             // - virtual contraction
-            temp = ambit::BlockedTensor::build(tensor_type_, "temp_va", {"va"});
+            temp = temp_pool_.get("temp_va", {"va"});
             temp["ex"] = H2["ewxy"] * L1_["yw"];
             temp["ex"] -= 0.5 * H2["ewyx"] * L1_["yw"];
             E3v -= temp["ex"] * T2["uvez"] * G2["xzuv"];
@@ -258,7 +258,7 @@ std::vector<double> SADSRG::H2_T2_C0_T2small(BlockedTensor& H2, BlockedTensor& T
             temp["eu"] = 0.5 * S2["uvez"] * L1_["zv"];
             E3v -= H2["ewxy"] * temp["eu"] * L2_["xyuw"];
 
-            temp = ambit::BlockedTensor::build(tensor_type_, "temp_vaaa", {"vaaa"});
+            temp = temp_pool_.get("temp_vaaa", {"vaaa"});
             temp["ewuy"] = H2["ewxy"] * L1_["xu"];
             E3v -= 0.5 * temp["ewuy"] * S2["uvez"] * L2_["yzwv"];
 
@@ -270,7 +270,7 @@ std::vector<double> SADSRG::H2_T2_C0_T2small(BlockedTensor& H2, BlockedTensor& T
             E3v += 0.5 * temp["ezxy"] * T2["uvez"] * G2["xyuv"];
 
             // - core contraction
-            temp = ambit::BlockedTensor::build(tensor_type_, "temp_ac", {"ac"});
+            temp = temp_pool_.get("temp_ac", {"ac"});
             temp["um"] = H2["uvmz"] * L1_["zv"];
             temp["um"] -= 0.5 * H2["vumz"] * L1_["zv"];
             E3c += temp["um"] * T2["mwxy"] * L2_["xyuw"];
@@ -278,7 +278,7 @@ std::vector<double> SADSRG::H2_T2_C0_T2small(BlockedTensor& H2, BlockedTensor& T
             temp["xm"] = S2["mwxy"] * L1_["yw"];
             E3c += 0.5 * H2["uvmz"] * temp["xm"] * G2["xzuv"];
 
-            temp = ambit::BlockedTensor::build(tensor_type_, "temp_caaa", {"caaa"});
+            temp = temp_pool_.get("temp_caaa", {"caaa"});
             temp["mzxv"] = H2["uvmz"] * L1_["xu"];
             E3c += 0.5 * temp["mzxv"] * S2["mwxy"] * L2_["yzwv"];
 
@@ -465,7 +465,7 @@ void SADSRG::H2_T2_C2(BlockedTensor& H2, BlockedTensor& T2, BlockedTensor& S2, c
             blocks.push_back(block);
     }
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "temp", blocks);
+    auto temp = temp_pool_.get("temp", blocks);
     temp["qjsb"] += alpha * H2["aqms"] * S2["mjab"];
     temp["qjsb"] -= alpha * H2["aqsm"] * T2["mjab"];
     temp["qjsb"] += 0.5 * alpha * L1_["xy"] * S2["yjab"] * H2["aqxs"];
@@ -484,7 +484,7 @@ void SADSRG::H2_T2_C2(BlockedTensor& H2, BlockedTensor& T2, BlockedTensor& S2, c
             blocks.push_back(block);
     }
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", blocks);
+    temp = temp_pool_.get("temp", blocks);
     temp["jqsb"] -= alpha * H2["aqsm"] * T2["mjba"];
     temp["jqsb"] -= 0.5 * alpha * L1_["xy"] * T2["yjba"] * H2["aqsx"];
     temp["jqsb"] += 0.5 * alpha * L1_["xy"] * T2["ijbx"] * H2["yqsi"];
@@ -503,7 +503,7 @@ void SADSRG::V_T1_C0_DF(BlockedTensor& B, BlockedTensor& T1, const double& alpha
 
     double E = 0.0;
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp120", {"Laa"});
+    auto temp = temp_pool_.get("DFtemp120", {"Laa"});
     temp["gux"] += B["gex"] * T1["ue"];
     temp["gux"] -= B["gum"] * T1["mx"];
 
@@ -526,7 +526,7 @@ std::vector<double> SADSRG::V_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, Bloc
     double E = 0.0;
 
     // [H2, T2] (C_2)^4 from ccvv, cavv, and ccav
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "temp_220", {"Lvc"});
+    auto temp = temp_pool_.get("temp_220", {"Lvc"});
     temp["gem"] += B["gfn"] * S2["mnef"];
     temp["gem"] += B["gfu"] * S2["mvef"] * L1_["uv"];
     temp["gem"] += B["gvn"] * S2["nmue"] * Eta1_["uv"];
@@ -535,7 +535,7 @@ std::vector<double> SADSRG::V_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, Bloc
 
     // form H2 for other blocks that fits memory
     std::vector<std::string> blocks{"aacc", "aaca", "vvaa", "vaaa", "avac", "avca"};
-    auto H2 = ambit::BlockedTensor::build(tensor_type_, "temp_H2", blocks);
+    auto H2 = temp_pool_.get("temp_H2", blocks);
     H2["abij"] = B["gai"] * B["gbj"];
 
     auto Esmall = H2_T2_C0_T2small(H2, T2, S2);
@@ -560,13 +560,13 @@ void SADSRG::V_T1_C1_DF(BlockedTensor& B, BlockedTensor& T1, const double& alpha
                         BlockedTensor& C1) {
     local_timer timer;
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp211", {"L"});
+    auto temp = temp_pool_.get("DFtemp211", {"L"});
     temp["g"] += 2.0 * alpha * T1["ma"] * B["gam"];
     temp["g"] += alpha * T1["xe"] * L1_["yx"] * B["gey"];
     temp["g"] -= alpha * T1["mu"] * L1_["uv"] * B["gvm"];
     C1["qp"] += temp["g"] * B["gqp"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp211", {"Lgc"});
+    temp = temp_pool_.get("DFtemp211", {"Lgc"});
     temp["gpm"] -= alpha * T1["ma"] * B["gap"];
     temp["gpm"] += 0.5 * alpha * T1["mu"] * L1_["uv"] * B["gvp"];
     C1["qp"] += temp["gpm"] * B["gqm"];
@@ -584,7 +584,7 @@ void SADSRG::V_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, BlockedTensor& S2,
     local_timer timer;
 
     // [Hbar2, T2] (C_2)^3 -> C1 particle contractions
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp221", {"Lhp"});
+    auto temp = temp_pool_.get("DFtemp221", {"Lhp"});
 
     temp["gia"] += alpha * B["gbm"] * S2["imab"];
 
@@ -632,12 +632,12 @@ void SADSRG::V_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, BlockedTensor& S2,
     C1["pa"] += temp["gia"] * B["gpi"];
 
     // [Hbar2, T2] C_4 C_2 1:3 -> C1
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp221", {"Laa"});
+    temp = temp_pool_.get("DFtemp221", {"Laa"});
     temp["gxu"] = B["gvy"] * L2_["xyuv"];
     C1["jb"] += 0.5 * alpha * B["gax"] * S2["ujab"] * temp["gxu"];
     C1["jb"] -= 0.5 * alpha * B["gui"] * S2["ijxb"] * temp["gxu"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp221", {"L"});
+    temp = temp_pool_.get("DFtemp221", {"L"});
     temp["g"] += alpha * B["gex"] * T2["uvey"] * L2_["xyuv"];
     temp["g"] -= alpha * B["gum"] * T2["mvxy"] * L2_["xyuv"];
     C1["qs"] += temp["g"] * B["gqs"];
@@ -683,7 +683,7 @@ void SADSRG::V_T2_C2_DF(BlockedTensor& B, BlockedTensor& T2, BlockedTensor& S2,
         C2blocks.push_back(block);
     }
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222", C2blocks);
+    auto temp = temp_pool_.get("DFtemp222", C2blocks);
     temp["ijes"] += batched("e", L1_["xy"] * T2["ijxb"] * B["gye"] * B["gbs"]);
     temp["ijks"] += L1_["xy"] * T2["ijxb"] * B["gyk"] * B["gbs"];
 
@@ -700,7 +700,7 @@ void SADSRG::V_T2_C2_DF(BlockedTensor& B, BlockedTensor& T2, BlockedTensor& S2,
             Vblocks.push_back(s);
     }
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222", Vblocks);
+    temp = temp_pool_.get("DFtemp222", Vblocks);
     temp["pqij"] = B["gpi"] * B["gqj"];
 
     C2["pqab"] += alpha * temp["pqij"] * T2["ijab"];
@@ -709,7 +709,7 @@ void SADSRG::V_T2_C2_DF(BlockedTensor& B, BlockedTensor& T2, BlockedTensor& S2,
     C2["qpba"] -= 0.5 * alpha * Eta1_["xy"] * T2["yjab"] * temp["pqxj"];
 
     // hole-particle contractions
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222", {"Lhp"});
+    temp = temp_pool_.get("DFtemp222", {"Lhp"});
     temp["gjb"] += alpha * B["gam"] * S2["mjab"];
     temp["gjb"] += 0.5 * alpha * L1_["xy"] * S2["yjab"] * B["gax"];
     temp["gjb"] -= 0.5 * alpha * L1_["xy"] * S2["ijxb"] * B["gyi"];
@@ -753,7 +753,7 @@ void SADSRG::V_T2_C2_DF_PH_X(BlockedTensor& B, BlockedTensor& T2, const double&
         }
     }
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", qjsb_small);
+    auto temp = temp_pool_.get("DFtemp222PHX", qjsb_small);
     temp["qjsb"] -= alpha * B["gas"] * B["gqm"] * T2["mjab"];
     temp["qjsb"] -= 0.5 * alpha * L1_["xy"] * T2["yjab"] * B["gas"] * B["gqx"];
     temp["qjsb"] += 0.5 * alpha * L1_["xy"] * T2["ijxb"] * B["gys"] * B["gqi"];
@@ -761,7 +761,7 @@ void SADSRG::V_T2_C2_DF_PH_X(BlockedTensor& B, BlockedTensor& T2, const double&
     C2["qjsb"] += temp["qjsb"];
     C2["jqbs"] += temp["qjsb"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", jqsb_small);
+    temp = temp_pool_.get("DFtemp222PHX", jqsb_small);
     temp["jqsb"] -= alpha * B["gas"] * B["gqm"] * T2["mjba"];
     temp["jqsb"] -= 0.5 * alpha * L1_["xy"] * T2["yjba"] * B["gas"] * B["gqx"];
     temp["jqsb"] += 0.5 * alpha * L1_["xy"] * T2["ijbx"] * B["gys"] * B["gqi"];
@@ -773,12 +773,12 @@ void SADSRG::V_T2_C2_DF_PH_X(BlockedTensor& B, BlockedTensor& T2, const double&
         C2["e,j,f,v0"] -= batched("e", alpha * B["g,a,f"] * B["g,e,m"] * T2["m,j,a,v0"]);
         C2["j,e,v0,f"] -= batched("e", alpha * B["g,a,f"] * B["g,e,m"] * T2["m,j,a,v0"]);
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", {"ahpv"});
+        temp = temp_pool_.get("DFtemp222PHX", {"ahpv"});
         temp["xjae"] = L1_["xy"] * T2["yjae"];
         C2["e,j,f,v0"] -= batched("e", 0.5 * alpha * temp["x,j,a,v0"] * B["g,a,f"] * B["g,e,x"]);
         C2["j,e,v0,f"] -= batched("e", 0.5 * alpha * temp["x,j,a,v0"] * B["g,a,f"] * B["g,e,x"]);
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", {"hhav"});
+        temp = temp_pool_.get("DFtemp222PHX", {"hhav"});
         temp["ijye"] = L1_["xy"] * T2["ijxe"];
         C2["e,j,f,v0"] += batched("e", 0.5 * alpha * temp["i,j,y,v0"] * B["g,y,f"] * B["g,e,i"]);
         C2["j,e,v0,f"] += batched("e", 0.5 * alpha * temp["i,j,y,v0"] * B["g,y,f"] * B["g,e,i"]);
@@ -788,12 +788,12 @@ void SADSRG::V_T2_C2_DF_PH_X(BlockedTensor& B, BlockedTensor& T2, const double&
         C2["j,e,f,v0"] -= batched("e", alpha * B["g,a,f"] * B["g,e,m"] * T2["m,j,v0,a"]);
         C2["e,j,v0,f"] -= batched("e", alpha * B["g,a,f"] * B["g,e,m"] * T2["m,j,v0,a"]);
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", {"ahvp"});
+        temp = temp_pool_.get("DFtemp222PHX", {"ahvp"});
         temp["xjea"] = L1_["xy"] * T2["yjea"];
         C2["j,e,f,v0"] -= batched("e", 0.5 * alpha * temp["x,j,v0,a"] * B["g,a,f"] * B["g,e,x"]);
         C2["e,j,v0,f"] -= batched("e", 0.5 * alpha * temp["x,j,v0,a"] * B["g,a,f"] * B["g,e,x"]);
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "DFtemp222PHX", {"hhva"});
+        temp = temp_pool_.get("DFtemp222PHX", {"hhva"});
         temp["ijey"] = L1_["xy"] * T2["ijex"];
         C2["j,e,f,v0"] += batched("e", 0.5 * alpha * temp["i,j,v0,y"] * B["g,y,f"] * B["g,e,i"]);
         C2["e,j,v0,f"] += batched("e", 0.5 * alpha * temp["i,j,v0,y"] * B["g,y,f"] * B["g,e,i"]);
@@ -803,7 +803,7 @@ void SADSRG::V_T2_C2_DF_PH_X(BlockedTensor& B, BlockedTensor& T2, const double&
 void SADSRG::H_A_Ca(BlockedTensor& H1, BlockedTensor& H2, BlockedTensor& T1, BlockedTensor& T2,
                     BlockedTensor& S2, const double& alpha, BlockedTensor& C1, BlockedTensor& C2) {
     // set up G2["pqrs"] = 2 * H2["pqrs"] - H2["pqsr"]
-    auto G2 = ambit::BlockedTensor::build(tensor_type_, "G2H", {"avac", "aaac", "avaa"});
+    auto G2 = temp_pool_.get("G2H", {"avac", "aaac", "avaa"});
     G2["pqrs"] = 2.0 * H2["pqrs"] - H2["pqsr"];
 
     H_A_Ca_small(H1, H2, G2, T1, T2, S2, alpha, C1, C2);
@@ -1115,7 +1115,7 @@ void SADSRG::H1d_A2_C2pphh(BlockedTensor& H1, BlockedTensor& T2, const double& a
         if (C2.is_block(block) or C2.is_block(sblock))
             small_blocks.push_back(block);
     }
-    auto temp2 = ambit::BlockedTensor::build(tensor_type_, "temp_H1dA2C2pphh", small_blocks);
+    auto temp2 = temp_pool_.get("temp_H1dA2C2pphh", small_blocks);
     H1d_A2_C2pphh_small(H1, T2, 1.0, temp2);
     C2["pqrs"] += alpha * temp2["pqrs"];
     for (const auto block : {"avca", "avac", "vaaa", "aaca"}) {
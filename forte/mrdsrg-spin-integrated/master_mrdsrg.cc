@@ -12,6 +12,7 @@
 #include "integrals/active_space_integrals.h"
 
 #include "helpers/printing.h"
+#include "helpers/tensor_rotation.h"
 #include "helpers/timer.h"
 
 #include "master_mrdsrg.h"
@@ -25,12 +26,14 @@ MASTER_DSRG::MASTER_DSRG(std::shared_ptr<RDMs> rdms, std::shared_ptr<SCFInfo> sc
                          std::shared_ptr<ForteIntegrals> ints,
                          std::shared_ptr<MOSpaceInfo> mo_space_info)
     : DynamicCorrelationSolver(rdms, scf_info, options, ints, mo_space_info),
-      BTF_(new BlockedTensorFactory()), tensor_type_(ambit::CoreTensor) {
+      BTF_(new BlockedTensorFactory()), tensor_type_(ambit::CoreTensor),
+      temp_pool_(tensor_type_) {
     startup();
 }
 
 MASTER_DSRG::~MASTER_DSRG() {
     dsrg_time_.print_comm_time();
+    temp_pool_.print_summary("DSRG Temporary Tensors");
 
     if (warnings_.size() != 0) {
         print_h2("DSRG Warnings");
@@ -708,77 +711,54 @@ void MASTER_DSRG::rotate_ints_semi_to_origin(const std::string& name, BlockedTen
                                              BlockedTensor& H2) {
 
     print_h2("Rotate DSRG Transformed " + name + " back to Original Basis");
-    ambit::Tensor temp;
     ambit::Tensor Ua = Uactv_.block("aa");
     ambit::Tensor Ub = Uactv_.block("AA");
+    const double* ua = Ua.data().data();
+    const double* ub = Ub.data().data();
+    TensorRotation rotation(Ua.dim(0));
 
     local_timer timer;
     outfile->Printf("\n    %-40s ... ", "Rotating 1-body term to original basis");
-    temp = H1.block("aa").clone(tensor_type_);
-    H1.block("aa")("pq") = Ua("pu") * temp("uv") * Ua("qv");
-
-    temp = H1.block("AA").clone(tensor_type_);
-    H1.block("AA")("PQ") = Ub("PU") * temp("UV") * Ub("QV");
+    rotation.rotate(H1.block("aa").data().data(), {ua, ua}, false);
+    rotation.rotate(H1.block("AA").data().data(), {ub, ub}, false);
     outfile->Printf("Done. Timing %8.3f s", timer.get());
 
     local_timer timer2;
     outfile->Printf("\n    %-40s ... ", "Rotating 2-body term to original basis");
-    temp = H2.block("aaaa").clone(tensor_type_);
-    H2.block("aaaa")("pqrs") = Ua("pa") * Ua("qb") * temp("abcd") * Ua("rc") * Ua("sd");
-
-    temp = H2.block("aAaA").clone(tensor_type_);
-    H2.block("aAaA")("pQrS") = Ua("pa") * Ub("QB") * temp("aBcD") * Ua("rc") * Ub("SD");
-
-    temp = H2.block("AAAA").clone(tensor_type_);
-    H2.block("AAAA")("PQRS") = Ub("PA") * Ub("QB") * temp("ABCD") * Ub("RC") * Ub("SD");
+    rotation.rotate(H2.block("aaaa").data().data(), {ua, ua, ua, ua}, false);
+    rotation.rotate(H2.block("aAaA").data().data(), {ua, ub, ua, ub}, false);
+    rotation.rotate(H2.block("AAAA").data().data(), {ub, ub, ub, ub}, false);
     outfile->Printf("Done. Timing %8.3f s", timer2.get());
 }
 
 void MASTER_DSRG::rotate_ints_semi_to_origin(const std::string& name, BlockedTensor& H1,
                                              BlockedTensor& H2, BlockedTensor& H3) {
     print_h2("Rotate DSRG Transformed " + name + " back to Original Basis");
-    ambit::Tensor temp;
     ambit::Tensor Ua = Uactv_.block("aa");
     ambit::Tensor Ub = Uactv_.block("AA");
+    const double* ua = Ua.data().data();
+    const double* ub = Ub.data().data();
+    TensorRotation rotation(Ua.dim(0));
 
     local_timer timer;
     outfile->Printf("\n    %-40s ... ", "Rotating 1-body term to original basis");
-    temp = H1.block("aa").clone(tensor_type_);
-    H1.block("aa")("pq") = Ua("pu") * temp("uv") * Ua("qv");
-
-    temp = H1.block("AA").clone(tensor_type_);
-    H1.block("AA")("PQ") = Ub("PU") * temp("UV") * Ub("QV");
+    rotation.rotate(H1.block("aa").data().data(), {ua, ua}, false);
+    rotation.rotate(H1.block("AA").data().data(), {ub, ub}, false);
     outfile->Printf("Done. Timing %8.3f s", timer.get());
 
     local_timer timer2;
     outfile->Printf("\n    %-40s ... ", "Rotating 2-body term to original basis");
-    temp = H2.block("aaaa").clone(tensor_type_);
-    H2.block("aaaa")("pqrs") = Ua("pa") * Ua("qb") * temp("abcd") * Ua("rc") * Ua("sd");
-
-    temp = H2.block("aAaA").clone(tensor_type_);
-    H2.block("aAaA")("pQrS") = Ua("pa") * Ub("QB") * temp("aBcD") * Ua("rc") * Ub("SD");
-
-    temp = H2.block("AAAA").clone(tensor_type_);
-    H2.block("AAAA")("PQRS") = Ub("PA") * Ub("QB") * temp("ABCD") * Ub("RC") * Ub("SD");
+    rotation.rotate(H2.block("aaaa").data().data(), {ua, ua, ua, ua}, false);
+    rotation.rotate(H2.block("aAaA").data().data(), {ua, ub, ua, ub}, false);
+    rotation.rotate(H2.block("AAAA").data().data(), {ub, ub, ub, ub}, false);
     outfile->Printf("Done. Timing %8.3f s", timer2.get());
 
     local_timer timer3;
     outfile->Printf("\n    %-40s ... ", "Rotating 3-body term to original basis");
-    temp = H3.block("aaaaaa").clone(tensor_type_);
-    H3.block("aaaaaa")("pqrstu") =
-        Ua("pa") * Ua("qb") * Ua("rc") * temp("abcijk") * Ua("si") * Ua("tj") * Ua("uk");
-
-    temp = H3.block("aaAaaA").clone(tensor_type_);
-    H3.block("aaAaaA")("pqrstu") =
-        Ua("pa") * Ua("qb") * Ub("rc") * temp("abcijk") * Ua("si") * Ua("tj") * Ub("uk");
-
-    temp = H3.block("aAAaAA").clone(tensor_type_);
-    H3.block("aAAaAA")("pqrstu") =
-        Ua("pa") * Ub("qb") * Ub("rc") * temp("abcijk") * Ua("si") * Ub("tj") * Ub("uk");
-
-    temp = H3.block("AAAAAA").clone(tensor_type_);
-    H3.block("AAAAAA")("pqrstu") =
-        Ub("pa") * Ub("qb") * Ub("rc") * temp("abcijk") * Ub("si") * Ub("tj") * Ub("uk");
+    rotation.rotate(H3.block("aaaaaa").data().data(), {ua, ua, ua, ua, ua, ua}, false);
+    rotation.rotate(H3.block("aaAaaA").data().data(), {ua, ua, ub, ua, ua, ub}, false);
+    rotation.rotate(H3.block("aAAaAA").data().data(), {ua, ub, ub, ua, ub, ub}, false);
+    rotation.rotate(H3.block("AAAAAA").data().data(), {ub, ub, ub, ub, ub, ub}, false);
 
     outfile->Printf("Done. Timing %8.3f s", timer3.get());
 }
@@ -852,20 +832,20 @@ void MASTER_DSRG::H1_T1_C0(BlockedTensor& H1, BlockedTensor& T1, const double& a
 
 void MASTER_DSRG::H1_T2_C0(BlockedTensor& H1, BlockedTensor& T2, const double& alpha, double& C0) {
     local_timer timer;
-    BlockedTensor temp;
+    PooledTensor temp;
     double E = 0.0;
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaa"});
+    temp = temp_pool_.get("temp", {"aaaa"});
     temp["uvxy"] += H1["ex"] * T2["uvey"];
     temp["uvxy"] -= H1["vm"] * T2["umxy"];
     E += 0.5 * temp["uvxy"] * Lambda2_["xyuv"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAA"});
+    temp = temp_pool_.get("temp", {"AAAA"});
     temp["UVXY"] += H1["EX"] * T2["UVEY"];
     temp["UVXY"] -= H1["VM"] * T2["UMXY"];
     E += 0.5 * temp["UVXY"] * Lambda2_["XYUV"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAaA"});
+    temp = temp_pool_.get("temp", {"aAaA"});
     temp["uVxY"] += H1["ex"] * T2["uVeY"];
     temp["uVxY"] += H1["EY"] * T2["uVxE"];
     temp["uVxY"] -= H1["VM"] * T2["uMxY"];
@@ -883,20 +863,20 @@ void MASTER_DSRG::H1_T2_C0(BlockedTensor& H1, BlockedTensor& T2, const double& a
 
 void MASTER_DSRG::H2_T1_C0(BlockedTensor& H2, BlockedTensor& T1, const double& alpha, double& C0) {
     local_timer timer;
-    BlockedTensor temp;
+    PooledTensor temp;
     double E = 0.0;
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaa"});
+    temp = temp_pool_.get("temp", {"aaaa"});
     temp["uvxy"] += H2["evxy"] * T1["ue"];
     temp["uvxy"] -= H2["uvmy"] * T1["mx"];
     E += 0.5 * temp["uvxy"] * Lambda2_["xyuv"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAA"});
+    temp = temp_pool_.get("temp", {"AAAA"});
     temp["UVXY"] += H2["EVXY"] * T1["UE"];
     temp["UVXY"] -= H2["UVMY"] * T1["MX"];
     E += 0.5 * temp["UVXY"] * Lambda2_["XYUV"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAaA"});
+    temp = temp_pool_.get("temp", {"aAaA"});
     temp["uVxY"] += H2["eVxY"] * T1["ue"];
     temp["uVxY"] += H2["uExY"] * T1["VE"];
     temp["uVxY"] -= H2["uVmY"] * T1["mx"];
@@ -920,7 +900,7 @@ void MASTER_DSRG::H2_T2_C0(BlockedTensor& H2, BlockedTensor& T2, const double& a
     E += 0.25 * H2["efmn"] * T2["mnef"];
     E += 0.25 * H2["EFMN"] * T2["MNEF"];
 
-    auto temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aa"}));
+    auto temp = temp_pool_.get("temp", spin_cases({"aa"}));
     temp["vu"] += 0.5 * H2["efmu"] * T2["mvef"];
     temp["vu"] += H2["fEuM"] * T2["vMfE"];
     temp["VU"] += 0.5 * H2["EFMU"] * T2["MVEF"];
@@ -936,7 +916,7 @@ void MASTER_DSRG::H2_T2_C0(BlockedTensor& H2, BlockedTensor& T2, const double& a
     E += temp["vu"] * Eta1_["uv"];
     E += temp["VU"] * Eta1_["UV"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aaaa"}));
+    temp = temp_pool_.get("temp", spin_cases({"aaaa"}));
     temp["yvxu"] += H2["efxu"] * T2["yvef"];
     temp["yVxU"] += H2["eFxU"] * T2["yVeF"];
     temp["YVXU"] += H2["EFXU"] * T2["YVEF"];
@@ -978,7 +958,7 @@ void MASTER_DSRG::H2_T2_C0(BlockedTensor& H2, BlockedTensor& T2, const double& a
     E += temp["YVXU"] * Gamma1_["XY"] * Eta1_["UV"];
 
     // <[Hbar2, T2]> C_4 (C_2)^2 HH -- combined with PH
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aaaa"}));
+    temp = temp_pool_.get("temp", spin_cases({"aaaa"}));
     temp["uvxy"] += 0.125 * H2["uvmn"] * T2["mnxy"];
     temp["uvxy"] += 0.25 * Gamma1_["wz"] * H2["uvmw"] * T2["mzxy"];
     temp["uVxY"] += H2["uVmN"] * T2["mNxY"];
@@ -1037,17 +1017,17 @@ void MASTER_DSRG::H2_T2_C0(BlockedTensor& H2, BlockedTensor& T2, const double& a
 
     // <[Hbar2, T2]> C_6 C_2
     if (do_cu3_) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaaaa"});
+        temp = temp_pool_.get("temp", {"aaaaaa"});
         temp["uvwxyz"] += H2["uviz"] * T2["iwxy"];
         temp["uvwxyz"] += H2["waxy"] * T2["uvaz"];
         E += 0.25 * temp.block("aaaaaa")("uvwxyz") * L3aaa_("xyzuvw");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAAAA"});
+        temp = temp_pool_.get("temp", {"AAAAAA"});
         temp["UVWXYZ"] += H2["UVIZ"] * T2["IWXY"];
         temp["UVWXYZ"] += H2["WAXY"] * T2["UVAZ"];
         E += 0.25 * temp.block("AAAAAA")("UVWXYZ") * L3bbb_("XYZUVW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaAaaA"});
+        temp = temp_pool_.get("temp", {"aaAaaA"});
         temp["uvWxyZ"] -= H2["uviy"] * T2["iWxZ"];
         temp["uvWxyZ"] -= H2["uWiZ"] * T2["ivxy"];
         temp["uvWxyZ"] += 2.0 * H2["uWyI"] * T2["vIxZ"];
@@ -1057,7 +1037,7 @@ void MASTER_DSRG::H2_T2_C0(BlockedTensor& H2, BlockedTensor& T2, const double& a
         temp["uvWxyZ"] -= 2.0 * H2["vAxZ"] * T2["uWyA"];
         E += 0.5 * temp.block("aaAaaA")("uvWxyZ") * L3aab_("xyZuvW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAAaAA"});
+        temp = temp_pool_.get("temp", {"aAAaAA"});
         temp["uVWxYZ"] -= H2["VWIZ"] * T2["uIxY"];
         temp["uVWxYZ"] -= H2["uVxI"] * T2["IWYZ"];
         temp["uVWxYZ"] += 2.0 * H2["uViZ"] * T2["iWxY"];
@@ -1295,7 +1275,7 @@ void MASTER_DSRG::H2_T1_C1(BlockedTensor& H2, BlockedTensor& T1, const double& a
 void MASTER_DSRG::H2_T2_C1(BlockedTensor& H2, BlockedTensor& T2, const double& alpha,
                            BlockedTensor& C1) {
     local_timer timer;
-    BlockedTensor temp;
+    PooledTensor temp;
 
     /// max intermediate: a * a * p * p
 
@@ -1312,7 +1292,7 @@ void MASTER_DSRG::H2_T2_C1(BlockedTensor& H2, BlockedTensor& T2, const double& a
 
     C1["ir"] += 0.5 * alpha * T2["ijux"] * Gamma1_["xy"] * Gamma1_["uv"] * H2["vyrj"];
     C1["IR"] += 0.5 * alpha * T2["IJUX"] * Gamma1_["XY"] * Gamma1_["UV"] * H2["VYRJ"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHaA"});
+    temp = temp_pool_.get("temp", {"hHaA"});
     temp["iJvY"] = T2["iJuX"] * Gamma1_["XY"] * Gamma1_["uv"];
     C1["ir"] += alpha * temp["iJvY"] * H2["vYrJ"];
     C1["IR"] += alpha * temp["jIvY"] * H2["vYjR"];
@@ -1344,7 +1324,7 @@ void MASTER_DSRG::H2_T2_C1(BlockedTensor& H2, BlockedTensor& T2, const double& a
 
     C1["pa"] -= 0.5 * alpha * T2["vyab"] * Eta1_["uv"] * Eta1_["xy"] * H2["pbux"];
     C1["PA"] -= 0.5 * alpha * T2["VYAB"] * Eta1_["UV"] * Eta1_["XY"] * H2["PBUX"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aApP"});
+    temp = temp_pool_.get("temp", {"aApP"});
     temp["uXaB"] = T2["vYaB"] * Eta1_["uv"] * Eta1_["XY"];
     C1["pa"] -= alpha * H2["pBuX"] * temp["uXaB"];
     C1["PA"] -= alpha * H2["bPuX"] * temp["uXbA"];
@@ -1366,14 +1346,14 @@ void MASTER_DSRG::H2_T2_C1(BlockedTensor& H2, BlockedTensor& T2, const double& a
     // [Hbar2, T2] C_4 C_2 2:2 -> C1
     C1["ir"] += 0.25 * alpha * T2["ijxy"] * Lambda2_["xyuv"] * H2["uvrj"];
     C1["IR"] += 0.25 * alpha * T2["IJXY"] * Lambda2_["XYUV"] * H2["UVRJ"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHaA"});
+    temp = temp_pool_.get("temp", {"hHaA"});
     temp["iJuV"] = T2["iJxY"] * Lambda2_["xYuV"];
     C1["ir"] += alpha * H2["uVrJ"] * temp["iJuV"];
     C1["IR"] += alpha * H2["uVjR"] * temp["jIuV"];
 
     C1["pa"] -= 0.25 * alpha * Lambda2_["xyuv"] * T2["uvab"] * H2["pbxy"];
     C1["PA"] -= 0.25 * alpha * Lambda2_["XYUV"] * T2["UVAB"] * H2["PBXY"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aApP"});
+    temp = temp_pool_.get("temp", {"aApP"});
     temp["xYaB"] = T2["uVaB"] * Lambda2_["xYuV"];
     C1["pa"] -= alpha * H2["pBxY"] * temp["xYaB"];
     C1["PA"] -= alpha * H2["bPxY"] * temp["xYbA"];
@@ -1383,67 +1363,67 @@ void MASTER_DSRG::H2_T2_C1(BlockedTensor& H2, BlockedTensor& T2, const double& a
     C1["pa"] += alpha * Lambda2_["xYvU"] * T2["vIaY"] * H2["pUxI"];
     C1["PA"] += alpha * Lambda2_["yXuV"] * T2["iVyA"] * H2["uPiX"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hapa"});
+    temp = temp_pool_.get("temp", {"hapa"});
     temp["ixau"] += Lambda2_["xyuv"] * T2["ivay"];
     temp["ixau"] += Lambda2_["xYuV"] * T2["iVaY"];
     C1["ir"] += alpha * temp["ixau"] * H2["aurx"];
     C1["pa"] -= alpha * H2["puix"] * temp["ixau"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hApA"});
+    temp = temp_pool_.get("temp", {"hApA"});
     temp["iXaU"] += Lambda2_["XYUV"] * T2["iVaY"];
     temp["iXaU"] += Lambda2_["yXvU"] * T2["ivay"];
     C1["ir"] += alpha * temp["iXaU"] * H2["aUrX"];
     C1["pa"] -= alpha * H2["pUiX"] * temp["iXaU"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aHaP"});
+    temp = temp_pool_.get("temp", {"aHaP"});
     temp["xIuA"] += Lambda2_["xyuv"] * T2["vIyA"];
     temp["xIuA"] += Lambda2_["xYuV"] * T2["VIYA"];
     C1["IR"] += alpha * temp["xIuA"] * H2["uAxR"];
     C1["PA"] -= alpha * H2["uPxI"] * temp["xIuA"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"HAPA"});
+    temp = temp_pool_.get("temp", {"HAPA"});
     temp["IXAU"] += Lambda2_["XYUV"] * T2["IVAY"];
     temp["IXAU"] += Lambda2_["yXvU"] * T2["vIyA"];
     C1["IR"] += alpha * temp["IXAU"] * H2["AURX"];
     C1["PA"] -= alpha * H2["PUIX"] * temp["IXAU"];
 
     // [Hbar2, T2] C_4 C_2 1:3 -> C1
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"pa"});
+    temp = temp_pool_.get("temp", {"pa"});
     temp["au"] += 0.5 * Lambda2_["xyuv"] * H2["avxy"];
     temp["au"] += Lambda2_["xYuV"] * H2["aVxY"];
     C1["jb"] += alpha * temp["au"] * T2["ujab"];
     C1["JB"] += alpha * temp["au"] * T2["uJaB"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"PA"});
+    temp = temp_pool_.get("temp", {"PA"});
     temp["AU"] += 0.5 * Lambda2_["XYUV"] * H2["AVXY"];
     temp["AU"] += Lambda2_["xYvU"] * H2["vAxY"];
     C1["jb"] += alpha * temp["AU"] * T2["jUbA"];
     C1["JB"] += alpha * temp["AU"] * T2["UJAB"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"ah"});
+    temp = temp_pool_.get("temp", {"ah"});
     temp["xi"] += 0.5 * Lambda2_["xyuv"] * H2["uviy"];
     temp["xi"] += Lambda2_["xYuV"] * H2["uViY"];
     C1["jb"] -= alpha * temp["xi"] * T2["ijxb"];
     C1["JB"] -= alpha * temp["xi"] * T2["iJxB"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AH"});
+    temp = temp_pool_.get("temp", {"AH"});
     temp["XI"] += 0.5 * Lambda2_["XYUV"] * H2["UVIY"];
     temp["XI"] += Lambda2_["yXvU"] * H2["vUyI"];
     C1["jb"] -= alpha * temp["XI"] * T2["jIbX"];
     C1["JB"] -= alpha * temp["XI"] * T2["IJXB"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"av"});
+    temp = temp_pool_.get("temp", {"av"});
     temp["xe"] += 0.5 * T2["uvey"] * Lambda2_["xyuv"];
     temp["xe"] += T2["uVeY"] * Lambda2_["xYuV"];
     C1["qs"] += alpha * temp["xe"] * H2["eqxs"];
     C1["QS"] += alpha * temp["xe"] * H2["eQxS"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AV"});
+    temp = temp_pool_.get("temp", {"AV"});
     temp["XE"] += 0.5 * T2["UVEY"] * Lambda2_["XYUV"];
     temp["XE"] += T2["uVyE"] * Lambda2_["yXuV"];
     C1["qs"] += alpha * temp["XE"] * H2["qEsX"];
     C1["QS"] += alpha * temp["XE"] * H2["EQXS"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"ca"});
+    temp = temp_pool_.get("temp", {"ca"});
     temp["mu"] += 0.5 * T2["mvxy"] * Lambda2_["xyuv"];
     temp["mu"] += T2["mVxY"] * Lambda2_["xYuV"];
     C1["qs"] -= alpha * temp["mu"] * H2["uqms"];
     C1["QS"] -= alpha * temp["mu"] * H2["uQmS"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"CA"});
+    temp = temp_pool_.get("temp", {"CA"});
     temp["MU"] += 0.5 * T2["MVXY"] * Lambda2_["XYUV"];
     temp["MU"] += T2["vMxY"] * Lambda2_["xYvU"];
     C1["qs"] -= alpha * temp["MU"] * H2["qUsM"];
@@ -1549,9 +1529,9 @@ void MASTER_DSRG::H2_T2_C2(BlockedTensor& H2, BlockedTensor& T2, const double& a
     std::vector<std::string> blocks;
     std::set_intersection(temp_blocks.begin(), temp_blocks.end(), C2_blocks.begin(),
                           C2_blocks.end(), std::back_inserter(blocks));
-    BlockedTensor temp;
+    PooledTensor temp;
     if (blocks.size() != 0) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", blocks);
+        temp = temp_pool_.get("temp", blocks);
         temp["qjsb"] += alpha * H2["aqms"] * T2["mjab"];
         temp["qjsb"] += alpha * H2["qAsM"] * T2["jMbA"];
         temp["qjsb"] += alpha * Gamma1_["xy"] * T2["yjab"] * H2["aqxs"];
@@ -1580,7 +1560,7 @@ void MASTER_DSRG::H2_T2_C2(BlockedTensor& H2, BlockedTensor& T2, const double& a
     std::set_intersection(temp_blocks.begin(), temp_blocks.end(), C2_blocks.begin(),
                           C2_blocks.end(), std::back_inserter(blocks));
     if (blocks.size() != 0) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", blocks);
+        temp = temp_pool_.get("temp", blocks);
         temp["QJSB"] += alpha * H2["AQMS"] * T2["MJAB"];
         temp["QJSB"] += alpha * H2["aQmS"] * T2["mJaB"];
         temp["QJSB"] += alpha * Gamma1_["XY"] * T2["YJAB"] * H2["AQXS"];
@@ -1627,11 +1607,11 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
 
     /// Potentially be as large as p * p * h * g * g * g
 
-    BlockedTensor temp;
+    PooledTensor temp;
 
     // aaa and bbb
     if (active_only) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaaaa"});
+        temp = temp_pool_.get("temp", {"aaaaaa"});
         temp["rsjabq"] -= alpha * H2["rsqi"] * T2["ijab"];
         temp["ijspqb"] += alpha * H2["aspq"] * T2["ijba"];
         C3["xyzuvw"] += temp["xyzuvw"];
@@ -1644,7 +1624,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
         C3["zxyuwv"] -= temp["xyzuvw"];
         C3["xzyuwv"] += temp["xyzuvw"];
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAAAA"});
+        temp = temp_pool_.get("temp", {"AAAAAA"});
         temp["RSJABQ"] -= alpha * H2["RSQI"] * T2["IJAB"];
         temp["IJSPQB"] += alpha * H2["ASPQ"] * T2["IJBA"];
         C3["XYZUVW"] += temp["XYZUVW"];
@@ -1657,7 +1637,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
         C3["ZXYUWV"] -= temp["XYZUVW"];
         C3["XZYUWV"] += temp["XYZUVW"];
     } else {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"gghppg"});
+        temp = temp_pool_.get("temp", {"gghppg"});
         temp["rsjabq"] -= H2["rsqi"] * T2["ijab"];
         C3["rsjabq"] += alpha * temp["rsjabq"];
         C3["rjsabq"] -= alpha * temp["rsjabq"];
@@ -1669,7 +1649,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
         C3["rjsqab"] -= alpha * temp["rsjabq"];
         C3["jrsqab"] += alpha * temp["rsjabq"];
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hhgggp"});
+        temp = temp_pool_.get("temp", {"hhgggp"});
         temp["ijspqb"] += H2["aspq"] * T2["ijba"];
         C3["ijspqb"] += alpha * temp["ijspqb"];
         C3["isjpqb"] -= alpha * temp["ijspqb"];
@@ -1681,7 +1661,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
         C3["isjbpq"] -= alpha * temp["ijspqb"];
         C3["sijbpq"] += alpha * temp["ijspqb"];
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"GGHPPG"});
+        temp = temp_pool_.get("temp", {"GGHPPG"});
         temp["RSJABQ"] -= H2["RSQI"] * T2["IJAB"];
         C3["RSJABQ"] += alpha * temp["RSJABQ"];
         C3["RJSABQ"] -= alpha * temp["RSJABQ"];
@@ -1693,7 +1673,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
         C3["RJSQAB"] -= alpha * temp["RSJABQ"];
         C3["JRSQAB"] += alpha * temp["RSJABQ"];
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"HHGGGP"});
+        temp = temp_pool_.get("temp", {"HHGGGP"});
         temp["IJSPQB"] += H2["ASPQ"] * T2["IJBA"];
         C3["IJSPQB"] += alpha * temp["IJSPQB"];
         C3["ISJPQB"] -= alpha * temp["IJSPQB"];
@@ -1714,9 +1694,9 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
     C3["rsJqaB"] -= alpha * H2["rsqi"] * T2["iJaB"];
 
     if (active_only) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAaaAa"});
+        temp = temp_pool_.get("temp", {"aAaaAa"});
     } else {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"gGhpPg"});
+        temp = temp_pool_.get("temp", {"gGhpPg"});
     }
     temp["rSjaBq"] += H2["rSqI"] * T2["jIaB"];
     C3["rjSaqB"] += alpha * temp["rSjaBq"];
@@ -1734,7 +1714,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
     if (active_only) {
         temp.zero();
     } else {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHggGp"});
+        temp = temp_pool_.get("temp", {"hHggGp"});
     }
     temp["iJspQb"] -= H2["sApQ"] * T2["iJbA"];
     C3["isJpbQ"] += alpha * temp["iJspQb"];
@@ -1744,9 +1724,9 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
 
     // abb hole contraction
     if (active_only) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAAaAA"});
+        temp = temp_pool_.get("temp", {"aAAaAA"});
     } else {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"gGHpPG"});
+        temp = temp_pool_.get("temp", {"gGHpPG"});
     }
     temp["rSJaBQ"] += H2["rSiQ"] * T2["iJaB"];
     C3["rSJaBQ"] += alpha * temp["rSJaBQ"];
@@ -1764,7 +1744,7 @@ void MASTER_DSRG::H2_T2_C3(BlockedTensor& H2, BlockedTensor& T2, const double& a
     if (active_only) {
         temp.zero();
     } else {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHGgGP"});
+        temp = temp_pool_.get("temp", {"hHGgGP"});
     }
     temp["iJSpQB"] -= H2["aSpQ"] * T2["iJaB"];
     C3["iJSpQB"] += alpha * temp["iJSpQB"];
@@ -6,6 +6,7 @@
 #include "base_classes/dynamic_correlation_solver.h"
 
 #include "helpers/blockedtensorfactory.h"
+#include "helpers/tensor_pool.h"
 #include "mrdsrg-helper/dsrg_source.h"
 #include "mrdsrg-helper/dsrg_time.h"
 #include "mrdsrg-helper/dsrg_tensors.h"
@@ -218,6 +219,8 @@ class MASTER_DSRG : public DynamicCorrelationSolver {
     std::shared_ptr<BlockedTensorFactory> BTF_;
     /// Tensor type for Ambit
     ambit::TensorType tensor_type_;
+    /// Pool of the temporary tensors used in the commutators
+    TensorPool temp_pool_;
 
     /// Alpha core label
     std::string acore_label_;
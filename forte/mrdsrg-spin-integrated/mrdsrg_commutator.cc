@@ -63,20 +63,20 @@ void MRDSRG::H1_G1_C0(BlockedTensor& H1, BlockedTensor& G1, const double& alpha,
 void MRDSRG::H1_G2_C0(BlockedTensor& H1, BlockedTensor& G2, const double& alpha, double& C0) {
     local_timer timer;
 
-    BlockedTensor temp;
+    PooledTensor temp;
     double E = 0.0;
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaa"});
+    temp = temp_pool_.get("temp", {"aaaa"});
     temp["xyuv"] += H1["qu"] * G2["xyqv"];
     temp["xyuv"] -= H1["xp"] * G2["pyuv"];
     E += 0.5 * temp["xyuv"] * Lambda2_["uvxy"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAA"});
+    temp = temp_pool_.get("temp", {"AAAA"});
     temp["XYUV"] += H1["QU"] * G2["XYQV"];
     temp["XYUV"] -= H1["XP"] * G2["PYUV"];
     E += 0.5 * temp["XYUV"] * Lambda2_["UVXY"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAaA"});
+    temp = temp_pool_.get("temp", {"aAaA"});
     temp["xYuV"] += H1["qu"] * G2["xYqV"];
     temp["xYuV"] += H1["QV"] * G2["xYuQ"];
     temp["xYuV"] -= H1["xp"] * G2["pYuV"];
@@ -91,7 +91,7 @@ void MRDSRG::H1_G2_C0(BlockedTensor& H1, BlockedTensor& G2, const double& alpha,
 void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alpha,
                          BlockedTensor& C1) {
     local_timer timer;
-    BlockedTensor temp;
+    PooledTensor temp;
 
     // [Hbar2, T2] (C_2)^3 -> C1 particle contractions
     C1["ir"] += 0.5 * alpha * B["gar"] * B["gbm"] * T2["imab"];
@@ -112,7 +112,7 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["ir"] -= 0.5 * alpha * T2["ijux"] * Gamma1_["xy"] * Gamma1_["uv"] * B["gvj"] * B["gyr"];
     C1["IR"] += 0.5 * alpha * T2["IJUX"] * Gamma1_["XY"] * Gamma1_["UV"] * B["gVR"] * B["gYJ"];
     C1["IR"] -= 0.5 * alpha * T2["IJUX"] * Gamma1_["XY"] * Gamma1_["UV"] * B["gVJ"] * B["gYR"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHaA"});
+    temp = temp_pool_.get("temp", {"hHaA"});
     temp["iJvY"] = T2["iJuX"] * Gamma1_["XY"] * Gamma1_["uv"];
     C1["ir"] += alpha * temp["iJvY"] * B["gvr"] * B["gYJ"];
     C1["IR"] += alpha * temp["jIvY"] * B["gvj"] * B["gYR"];
@@ -154,7 +154,7 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["pa"] += 0.5 * alpha * T2["vyab"] * Eta1_["uv"] * Eta1_["xy"] * B["gpx"] * B["gbu"];
     C1["PA"] -= 0.5 * alpha * T2["VYAB"] * Eta1_["UV"] * Eta1_["XY"] * B["gPU"] * B["gBX"];
     C1["PA"] += 0.5 * alpha * T2["VYAB"] * Eta1_["UV"] * Eta1_["XY"] * B["gPX"] * B["gBU"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aApP"});
+    temp = temp_pool_.get("temp", {"aApP"});
     temp["uXaB"] = T2["vYaB"] * Eta1_["uv"] * Eta1_["XY"];
     C1["pa"] -= alpha * B["gpu"] * B["gBX"] * temp["uXaB"];
     C1["PA"] -= alpha * B["gbu"] * B["gPX"] * temp["uXbA"];
@@ -182,7 +182,7 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["ir"] -= 0.25 * alpha * T2["ijxy"] * Lambda2_["xyuv"] * B["guj"] * B["gvr"];
     C1["IR"] += 0.25 * alpha * T2["IJXY"] * Lambda2_["XYUV"] * B["gUR"] * B["gVJ"];
     C1["IR"] -= 0.25 * alpha * T2["IJXY"] * Lambda2_["XYUV"] * B["gUJ"] * B["gVR"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hHaA"});
+    temp = temp_pool_.get("temp", {"hHaA"});
     temp["iJuV"] = T2["iJxY"] * Lambda2_["xYuV"];
     C1["ir"] += alpha * B["gur"] * B["gVJ"] * temp["iJuV"];
     C1["IR"] += alpha * B["guj"] * B["gVR"] * temp["jIuV"];
@@ -191,7 +191,7 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["pa"] += 0.25 * alpha * Lambda2_["xyuv"] * T2["uvab"] * B["gpy"] * B["gbx"];
     C1["PA"] -= 0.25 * alpha * Lambda2_["XYUV"] * T2["UVAB"] * B["gPX"] * B["gBY"];
     C1["PA"] += 0.25 * alpha * Lambda2_["XYUV"] * T2["UVAB"] * B["gPY"] * B["gBX"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aApP"});
+    temp = temp_pool_.get("temp", {"aApP"});
     temp["xYaB"] = T2["uVaB"] * Lambda2_["xYuV"];
     C1["pa"] -= alpha * B["gpx"] * B["gBY"] * temp["xYaB"];
     C1["PA"] -= alpha * B["gbx"] * B["gPY"] * temp["xYbA"];
@@ -201,24 +201,24 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["pa"] += alpha * Lambda2_["xYvU"] * T2["vIaY"] * B["gpx"] * B["gUI"];
     C1["PA"] += alpha * Lambda2_["yXuV"] * T2["iVyA"] * B["gui"] * B["gPX"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hapa"});
+    temp = temp_pool_.get("temp", {"hapa"});
     temp["ixau"] += Lambda2_["xyuv"] * T2["ivay"];
     temp["ixau"] += Lambda2_["xYuV"] * T2["iVaY"];
     C1["ir"] += alpha * temp["ixau"] * B["gar"] * B["gux"];
     C1["ir"] -= alpha * temp["ixau"] * B["gax"] * B["gur"];
     C1["pa"] -= alpha * B["gpi"] * B["gux"] * temp["ixau"];
     C1["pa"] += alpha * B["gpx"] * B["gui"] * temp["ixau"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"hApA"});
+    temp = temp_pool_.get("temp", {"hApA"});
     temp["iXaU"] += Lambda2_["XYUV"] * T2["iVaY"];
     temp["iXaU"] += Lambda2_["yXvU"] * T2["ivay"];
     C1["ir"] += alpha * temp["iXaU"] * B["gar"] * B["gUX"];
     C1["pa"] -= alpha * B["gpi"] * B["gUX"] * temp["iXaU"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aHaP"});
+    temp = temp_pool_.get("temp", {"aHaP"});
     temp["xIuA"] += Lambda2_["xyuv"] * T2["vIyA"];
     temp["xIuA"] += Lambda2_["xYuV"] * T2["VIYA"];
     C1["IR"] += alpha * temp["xIuA"] * B["gux"] * B["gAR"];
     C1["PA"] -= alpha * B["gux"] * B["gPI"] * temp["xIuA"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"HAPA"});
+    temp = temp_pool_.get("temp", {"HAPA"});
     temp["IXAU"] += Lambda2_["XYUV"] * T2["IVAY"];
     temp["IXAU"] += Lambda2_["yXvU"] * T2["vIyA"];
     C1["IR"] += alpha * temp["IXAU"] * B["gAR"] * B["gUX"];
@@ -227,52 +227,52 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     C1["PA"] += alpha * B["gPX"] * B["gUI"] * temp["IXAU"];
 
     // [Hbar2, T2] C_4 C_2 1:3 -> C1
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"pa"});
+    temp = temp_pool_.get("temp", {"pa"});
     temp["au"] += 0.5 * Lambda2_["xyuv"] * B["gax"] * B["gvy"];
     temp["au"] -= 0.5 * Lambda2_["xyuv"] * B["gay"] * B["gvx"];
     temp["au"] += Lambda2_["xYuV"] * B["gax"] * B["gVY"];
     C1["jb"] += alpha * temp["au"] * T2["ujab"];
     C1["JB"] += alpha * temp["au"] * T2["uJaB"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"PA"});
+    temp = temp_pool_.get("temp", {"PA"});
     temp["AU"] += 0.5 * Lambda2_["XYUV"] * B["gAX"] * B["gVY"];
     temp["AU"] -= 0.5 * Lambda2_["XYUV"] * B["gAY"] * B["gVX"];
     temp["AU"] += Lambda2_["xYvU"] * B["gvx"] * B["gAY"];
     C1["jb"] += alpha * temp["AU"] * T2["jUbA"];
     C1["JB"] += alpha * temp["AU"] * T2["UJAB"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"ah"});
+    temp = temp_pool_.get("temp", {"ah"});
     temp["xi"] += 0.5 * Lambda2_["xyuv"] * B["gui"] * B["gvy"];
     temp["xi"] -= 0.5 * Lambda2_["xyuv"] * B["guy"] * B["gvi"];
     temp["xi"] += Lambda2_["xYuV"] * B["gui"] * B["gVY"];
     C1["jb"] -= alpha * temp["xi"] * T2["ijxb"];
     C1["JB"] -= alpha * temp["xi"] * T2["iJxB"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AH"});
+    temp = temp_pool_.get("temp", {"AH"});
     temp["XI"] += 0.5 * Lambda2_["XYUV"] * B["gUI"] * B["gVY"];
     temp["XI"] -= 0.5 * Lambda2_["XYUV"] * B["gUY"] * B["gVI"];
     temp["XI"] += Lambda2_["yXvU"] * B["gvy"] * B["gUI"];
     C1["jb"] -= alpha * temp["XI"] * T2["jIbX"];
     C1["JB"] -= alpha * temp["XI"] * T2["IJXB"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"av"});
+    temp = temp_pool_.get("temp", {"av"});
     temp["xe"] += 0.5 * T2["uvey"] * Lambda2_["xyuv"];
     temp["xe"] += T2["uVeY"] * Lambda2_["xYuV"];
     C1["qs"] += alpha * temp["xe"] * B["gex"] * B["gqs"];
     C1["qs"] -= alpha * temp["xe"] * B["ges"] * B["gqx"];
     C1["QS"] += alpha * temp["xe"] * B["gex"] * B["gQS"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AV"});
+    temp = temp_pool_.get("temp", {"AV"});
     temp["XE"] += 0.5 * T2["UVEY"] * Lambda2_["XYUV"];
     temp["XE"] += T2["uVyE"] * Lambda2_["yXuV"];
     C1["qs"] += alpha * temp["XE"] * B["gqs"] * B["gEX"];
     C1["QS"] += alpha * temp["XE"] * B["gEX"] * B["gQS"];
     C1["QS"] -= alpha * temp["XE"] * B["gES"] * B["gQX"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"ca"});
+    temp = temp_pool_.get("temp", {"ca"});
     temp["mu"] += 0.5 * T2["mvxy"] * Lambda2_["xyuv"];
     temp["mu"] += T2["mVxY"] * Lambda2_["xYuV"];
     C1["qs"] -= alpha * temp["mu"] * B["gum"] * B["gqs"];
     C1["qs"] += alpha * temp["mu"] * B["gus"] * B["gqm"];
     C1["QS"] -= alpha * temp["mu"] * B["gum"] * B["gQS"];
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"CA"});
+    temp = temp_pool_.get("temp", {"CA"});
     temp["MU"] += 0.5 * T2["MVXY"] * Lambda2_["XYUV"];
     temp["MU"] += T2["vMxY"] * Lambda2_["xYvU"];
     C1["qs"] -= alpha * temp["MU"] * B["gqs"] * B["gUM"];
@@ -287,24 +287,24 @@ void MRDSRG::H2_T2_C1_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
 
 void MRDSRG::H2_T1_C0_DF(BlockedTensor& B, BlockedTensor& T1, const double& alpha, double& C0) {
     local_timer timer;
-    BlockedTensor temp;
+    PooledTensor temp;
     double E = 0.0;
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaa"});
+    temp = temp_pool_.get("temp", {"aaaa"});
     temp["uvxy"] += B["gex"] * B["gvy"] * T1["ue"];
     temp["uvxy"] -= B["gey"] * B["gvx"] * T1["ue"];
     temp["uvxy"] -= B["gum"] * B["gvy"] * T1["mx"];
     temp["uvxy"] += B["guy"] * B["gvm"] * T1["mx"];
     E += 0.5 * temp["uvxy"] * Lambda2_["xyuv"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAA"});
+    temp = temp_pool_.get("temp", {"AAAA"});
     temp["UVXY"] += B["gEX"] * B["gVY"] * T1["UE"];
     temp["UVXY"] -= B["gEY"] * B["gVX"] * T1["UE"];
     temp["UVXY"] -= B["gUM"] * B["gVY"] * T1["MX"];
     temp["UVXY"] += B["gUY"] * B["gVM"] * T1["MX"];
     E += 0.5 * temp["UVXY"] * Lambda2_["XYUV"];
 
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAaA"});
+    temp = temp_pool_.get("temp", {"aAaA"});
     temp["uVxY"] += B["gex"] * B["gVY"] * T1["ue"];
     temp["uVxY"] += B["gux"] * B["gEY"] * T1["VE"];
     temp["uVxY"] -= B["gum"] * B["gVY"] * T1["mx"];
@@ -393,7 +393,7 @@ void MRDSRG::H2_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     E += 0.25 * B["gEM"] * B["gFN"] * T2["MNEF"];
     E -= 0.25 * B["gEN"] * B["gFM"] * T2["MNEF"];
 
-    BlockedTensor temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aa"}));
+    auto temp = temp_pool_.get("temp", spin_cases({"aa"}));
     temp["vu"] += 0.5 * B["gem"] * B["gfu"] * T2["mvef"];
     temp["vu"] -= 0.5 * B["geu"] * B["gfm"] * T2["mvef"];
     temp["vu"] += B["gfu"] * B["gEM"] * T2["vMfE"];
@@ -413,7 +413,7 @@ void MRDSRG::H2_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     E += temp["vu"] * Eta1_["uv"];
     E += temp["VU"] * Eta1_["UV"];
 
-    temp = BTF_->build(tensor_type_, "temp", spin_cases({"aaaa"}));
+    temp = temp_pool_.get("temp", spin_cases({"aaaa"}));
     temp["yvxu"] += B["gex"] * B["gfu"] * T2["yvef"];
     temp["yvxu"] -= B["geu"] * B["gfx"] * T2["yvef"];
     temp["yVxU"] += B["gex"] * B["gFU"] * T2["yVeF"];
@@ -465,7 +465,7 @@ void MRDSRG::H2_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     E += temp["YVXU"] * Gamma1_["XY"] * Eta1_["UV"];
 
     // <[Hbar2, T2]> C_4 (C_2)^2 HH -- combined with PH
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aaaa"}));
+    temp = temp_pool_.get("temp", spin_cases({"aaaa"}));
     temp["uvxy"] += 0.125 * B["gum"] * B["gvn"] * T2["mnxy"];
     temp["uvxy"] -= 0.125 * B["gun"] * B["gvm"] * T2["mnxy"];
     temp["uvxy"] += 0.25 * Gamma1_["wz"] * B["gum"] * B["gvw"] * T2["mzxy"];
@@ -544,21 +544,21 @@ void MRDSRG::H2_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
 
     // <[Hbar2, T2]> C_6 C_2
     if (do_cu3_) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaaaa"});
+        temp = temp_pool_.get("temp", {"aaaaaa"});
         temp["uvwxyz"] += B["gui"] * B["gvz"] * T2["iwxy"]; //  aaaaaa from hole
         temp["uvwxyz"] -= B["guz"] * B["gvi"] * T2["iwxy"]; //  aaaaaa from hole
         temp["uvwxyz"] += B["gwx"] * B["gay"] * T2["uvaz"]; //  aaaaaa from particle
         temp["uvwxyz"] -= B["gwy"] * B["gax"] * T2["uvaz"]; //  aaaaaa from particle
         E += 0.25 * temp.block("aaaaaa")("uvwxyz") * L3aaa_("xyzuvw");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAAAA"});
+        temp = temp_pool_.get("temp", {"AAAAAA"});
         temp["UVWXYZ"] += B["gUI"] * B["gVZ"] * T2["IWXY"]; //  AAAAAA from hole
         temp["UVWXYZ"] -= B["gUZ"] * B["gVI"] * T2["IWXY"]; //  AAAAAA from hole
         temp["UVWXYZ"] += B["gWX"] * B["gAY"] * T2["UVAZ"]; //  AAAAAA from particle
         temp["UVWXYZ"] -= B["gWY"] * B["gAX"] * T2["UVAZ"]; //  AAAAAA from particle
         E += 0.25 * temp.block("AAAAAA")("UVWXYZ") * L3bbb_("XYZUVW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaAaaA"});
+        temp = temp_pool_.get("temp", {"aaAaaA"});
         temp["uvWxyZ"] -= B["gui"] * B["gvy"] * T2["iWxZ"];       //  aaAaaA from hole
         temp["uvWxyZ"] += B["guy"] * B["gvi"] * T2["iWxZ"];       //  aaAaaA from hole
         temp["uvWxyZ"] -= B["gui"] * B["gWZ"] * T2["ivxy"];       //  aaAaaA from hole
@@ -570,7 +570,7 @@ void MRDSRG::H2_T2_C0_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
         temp["uvWxyZ"] -= 2.0 * B["gvx"] * B["gAZ"] * T2["uWyA"]; //  aaAaaA from particle
         E += 0.5 * temp.block("aaAaaA")("uvWxyZ") * L3aab_("xyZuvW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAAaAA"});
+        temp = temp_pool_.get("temp", {"aAAaAA"});
         temp["uVWxYZ"] -= B["gVI"] * B["gWZ"] * T2["uIxY"];       //  aAAaAA from hole
         temp["uVWxYZ"] += B["gVZ"] * B["gWI"] * T2["uIxY"];       //  aAAaAA from hole
         temp["uVWxYZ"] -= B["gux"] * B["gVI"] * T2["IWYZ"];       //  aAAaAA from hole
@@ -632,7 +632,7 @@ void MRDSRG::H2_T2_C2_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     // hole-particle contractions
     forte::timer hp("H2_T2_C2 hp");
     forte::timer tempBuild("temp build");
-    BlockedTensor temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"ghgp"});
+    auto temp = temp_pool_.get("temp", {"ghgp"});
     tempBuild.stop();
     temp["qjsb"] += alpha * B["gam"] * B["gqs"] * T2["mjab"];
     temp["qjsb"] -= alpha * B["gas"] * B["gqm"] * T2["mjab"];
@@ -651,7 +651,7 @@ void MRDSRG::H2_T2_C2_DF(BlockedTensor& B, BlockedTensor& T2, const double& alph
     resorting.stop();
 
     forte::timer tempBuild2("temp build");
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"GHGP"});
+    temp = temp_pool_.get("temp", {"GHGP"});
     tempBuild2.stop();
     temp["QJSB"] += alpha * B["gAM"] * B["gQS"] * T2["MJAB"];
     temp["QJSB"] -= alpha * B["gAS"] * B["gQM"] * T2["MJAB"];
@@ -718,7 +718,7 @@ void MRDSRG::H2_G2_C0(BlockedTensor& H2, BlockedTensor& G2, const double& alpha,
     E -= 0.25 * G2["EFMN"] * H2["MNEF"];
 
     // one gamma
-    BlockedTensor temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aa"}));
+    auto temp = temp_pool_.get("temp", spin_cases({"aa"}));
     temp["vu"] += 0.5 * H2["efmu"] * G2["mvef"];
     temp["vu"] += H2["fEuM"] * G2["vMfE"];
     temp["vu"] -= 0.5 * G2["efmu"] * H2["mvef"];
@@ -746,7 +746,7 @@ void MRDSRG::H2_G2_C0(BlockedTensor& H2, BlockedTensor& G2, const double& alpha,
     E += temp["VU"] * Eta1_["UV"];
 
     // two gamma
-    temp = ambit::BlockedTensor::build(tensor_type_, "temp", spin_cases({"aaaa"}));
+    temp = temp_pool_.get("temp", spin_cases({"aaaa"}));
     temp["yvxu"] += H2["efxu"] * G2["yvef"];
     temp["yVxU"] += H2["eFxU"] * G2["yVeF"];
     temp["YVXU"] += H2["EFXU"] * G2["YVEF"];
@@ -898,17 +898,17 @@ void MRDSRG::H2_G2_C0(BlockedTensor& H2, BlockedTensor& G2, const double& alpha,
 
     // <[Hbar2, T2]> C_6 C_2
     if (do_cu3_) {
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaaaaa"});
+        temp = temp_pool_.get("temp", {"aaaaaa"});
         temp["xyzuvw"] += H2["yzpu"] * G2["pxvw"];
         temp["xyzuvw"] -= H2["zpuv"] * G2["xywp"];
         E += 0.25 * temp.block("aaaaaa")("uvwxyz") * L3aaa_("xyzuvw");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"AAAAAA"});
+        temp = temp_pool_.get("temp", {"AAAAAA"});
         temp["XYZUVW"] += H2["YZPU"] * G2["PXVW"];
         temp["XYZUVW"] -= H2["ZPUV"] * G2["XYWP"];
         E += 0.25 * temp.block("AAAAAA")("UVWXYZ") * L3bbb_("XYZUVW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aaAaaA"});
+        temp = temp_pool_.get("temp", {"aaAaaA"});
         temp["xyZuvW"] += 2.0 * H2["yZuP"] * G2["xPvW"];
         temp["xyZuvW"] += H2["xypu"] * G2["pZvW"];
         temp["xyZuvW"] += H2["yZpW"] * G2["pxuv"];
@@ -918,7 +918,7 @@ void MRDSRG::H2_G2_C0(BlockedTensor& H2, BlockedTensor& G2, const double& alpha,
         temp["xyZuvW"] -= H2["ypuv"] * G2["xZpW"];
         E += 0.5 * temp.block("aaAaaA")("uvWxyZ") * L3aab_("xyZuvW");
 
-        temp = ambit::BlockedTensor::build(tensor_type_, "temp", {"aAAaAA"});
+        temp = temp_pool_.get("temp", {"aAAaAA"});
         temp["xYZuVW"] += 2.0 * H2["xZpV"] * G2["pYuW"];
         temp["xYZuVW"] += H2["YZPV"] * G2["xPuW"];
         temp["xYZuVW"] += H2["xZuP"] * G2["PYVW"];
@@ -28,6 +28,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <string>
 #include <sstream>
@@ -1242,10 +1243,10 @@ double THREE_DSRG_MRPT2::E_VT2_2() {
         outfile->Printf("\n    %-40s ...", "Computing <[V, T2]> (C_2)^4 ccvv");
     }
 
-    // TODO: Make this smarter and automatically switch to right algorithm for size
-    // Small size -> use core algorithm
-    // Large size -> use fly_ambit
-    if (ccvv_algorithm == "CORE") {
+    if (ccvv_algorithm == "FUSED") {
+        if (my_proc == 0)
+            Eccvv = E_VT2_2_fused();
+    } else if (ccvv_algorithm == "CORE") {
         if (my_proc == 0)
             Eccvv = E_VT2_2_core();
     } else if (ccvv_algorithm == "FLY_LOOP") {
@@ -1286,7 +1287,7 @@ double THREE_DSRG_MRPT2::E_VT2_2() {
 #endif
     } else {
         outfile->Printf("\n Specify a correct algorithm string");
-        throw psi::PSIEXCEPTION("Specify either CORE FLY_LOOP FLY_AMBIT BATCH_CORE "
+        throw psi::PSIEXCEPTION("Specify either FUSED CORE FLY_LOOP FLY_AMBIT BATCH_CORE "
                                 "BATCH_VIRTUAL BATCH_CORE_MPI BATCH_VIRTUAL_MPI or "
                                 "other algorihm");
     }
@@ -2028,7 +2029,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_core() {
     outfile->Printf("\n\n====Blocking information==========\n");
     size_t int_mem_int = (nthree_ * ncore_ * nvirtual_) * sizeof(double);
     size_t memory_input = psi::Process::environment.get_memory() * 0.75;
-    size_t num_block = int_mem_int / memory_input < 1 ? 1 : int_mem_int / memory_input;
+    // the memory is shared by all the blocks that the reader keeps alive at once
+    size_t live_mem = ccvv_live_blocks(Qpq) * int_mem_int;
+    size_t num_block = std::max<size_t>(1, (live_mem + memory_input - 1) / memory_input);
 
     if (foptions_->get_int("CCVV_BATCH_NUMBER") != -1) {
         num_block = foptions_->get_int("CCVV_BATCH_NUMBER");
@@ -2074,8 +2077,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_core() {
 
     // Step 2:  Loop over memory allowed blocks of m and n
     // Get batch sizes and create vectors of mblock length
+    std::vector<std::vector<size_t>> batches(num_block);
     for (size_t m_blocks = 0; m_blocks < num_block; m_blocks++) {
-        std::vector<size_t> m_batch;
+        std::vector<size_t>& m_batch = batches[m_blocks];
         // If core_ goes into num_block equally, all blocks are equal
         if (ncore_ % num_block == 0) {
             // Fill the mbatch from block_begin to block_end
@@ -2095,12 +2099,12 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_core() {
             std::copy(core_mos_.begin() + (m_blocks)*block_size,
                       core_mos_.begin() + (m_blocks)*block_size + gimp_block_size, m_batch.begin());
         }
+    }
 
-        ambit::Tensor B = ints_->three_integral_block(aux_mos_, m_batch, virt_mos_);
-        ambit::Tensor BmQe =
-            ambit::Tensor::build(tensor_type_, "BmQE", {m_batch.size(), nthree_, nvirtual_});
-        BmQe("mQe") = B("Qme");
-        B.reset();
+    auto B_blocks = ccvv_block_reader(batches, virt_mos_);
+    for (size_t m_blocks = 0; m_blocks < num_block; m_blocks++) {
+        const std::vector<size_t>& m_batch = batches[m_blocks];
+        ambit::Tensor BmQe = B_blocks.next();
 
         if (debug_print) {
             outfile->Printf("\n  BmQe norm: %8.8f", BmQe.norm(2.0));
@@ -2117,32 +2121,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_core() {
         }
 
         for (size_t n_blocks = 0; n_blocks <= m_blocks; n_blocks++) {
-            std::vector<size_t> n_batch;
-            // If core_ goes into num_block equally, all blocks are equal
-            if (ncore_ % num_block == 0) {
-                // Fill the mbatch from block_begin to block_end
-                // This is done so I can pass a block to IntegralsAPI to read a chunk
-                n_batch.resize(block_size);
-                std::copy(core_mos_.begin() + n_blocks * block_size,
-                          core_mos_.begin() + ((n_blocks + 1) * block_size), n_batch.begin());
-            } else {
-                // If last_block is longer, block_size + remainder
-                size_t gimp_block_size =
-                    n_blocks == (num_block - 1) ? block_size + ncore_ % num_block : block_size;
-                n_batch.resize(gimp_block_size);
-                std::copy(core_mos_.begin() + (n_blocks)*block_size,
-                          core_mos_.begin() + (n_blocks * block_size) + gimp_block_size,
-                          n_batch.begin());
-            }
-            ambit::Tensor BnQf =
-                ambit::Tensor::build(tensor_type_, "BnQf", {n_batch.size(), nthree_, nvirtual_});
-            if (n_blocks == m_blocks) {
-                BnQf.copy(BmQe);
-            } else {
-                ambit::Tensor B = ints_->three_integral_block(aux_mos_, n_batch, virt_mos_);
-                BnQf("mQe") = B("Qme");
-                B.reset();
-            }
+            const std::vector<size_t>& n_batch = batches[n_blocks];
+            // the diagonal block shares the integrals of the m block (they are only read)
+            ambit::Tensor BnQf = n_blocks == m_blocks ? BmQe : B_blocks.next();
             if (debug_print) {
                 outfile->Printf("\n  BnQf norm: %8.8f", BnQf.norm(2.0));
                 outfile->Printf("\n  m_block: %d", m_blocks);
@@ -2360,6 +2341,162 @@ double THREE_DSRG_MRPT2::E_VT2_2_AO_Slow() {
 
     return (0.25 * Ealpha + 0.25 * Ebeta + Emixed);
 }
+
+size_t THREE_DSRG_MRPT2::ccvv_live_blocks(ThreeIntsBlockOrder order) const {
+    // the blocks of the two batches in use
+    size_t nblocks = 2;
+    // the block being read in the background
+    if (foptions_->get_bool("CCVV_BATCH_PREFETCH"))
+        nblocks += 1;
+    // the block read in the order Qia before it is copied to iQa
+    if (order == Qpq)
+        nblocks += 1;
+    return nblocks;
+}
+
+AsyncPrefetcher<ambit::Tensor>
+THREE_DSRG_MRPT2::ccvv_block_reader(const std::vector<std::vector<size_t>>& batches,
+                                    const std::vector<size_t>& mos, ThreeIntsBlockOrder order) {
+    std::vector<size_t> sequence;
+    for (size_t I = 0; I < batches.size(); ++I) {
+        for (size_t J = 0; J <= I; ++J) {
+            sequence.push_back(J == 0 ? I : J - 1);
+        }
+    }
+    // the reads of DISKDF integrals are not thread safe, so all the blocks are read by fetch
+    auto fetch = [this, &batches, &mos, sequence, order](size_t k) {
+        const auto& batch = batches[sequence[k]];
+        if (order == pqQ)
+            return ints_->three_integral_block(aux_mos_, batch, mos, pqQ);
+        ambit::Tensor B = ints_->three_integral_block(aux_mos_, batch, mos);
+        ambit::Tensor BiQa =
+            ambit::Tensor::build(tensor_type_, "BiQa", {batch.size(), nthree_, mos.size()});
+        BiQa("iQa") = B("Qia");
+        return BiQa;
+    };
+    return AsyncPrefetcher<ambit::Tensor>(sequence.size(), fetch,
+                                          foptions_->get_bool("CCVV_BATCH_PREFETCH"));
+}
+
+double THREE_DSRG_MRPT2::E_VT2_2_fused() {
+    /**
+     * Compute <[V, T2]> (C_2)^4 ccvv term without storing (me|nf)
+     *
+     * For each pair of core orbitals m >= n and each pair of virtual tiles E <= F form
+     *   X(ef) = (me|nf) = B(me|Q) * B(nf|Q) and Y(fe) = (mf|ne) = B(mf|Q) * B(ne|Q)
+     * with two GEMMs and reduce them into the energy right away. Adding the terms of (m,n) and
+     * (n,m) and of (e,f) and (f,e) gives
+     *   E(mn,ef) = (X - Y)^2 * [R(Daa) + R(Dbb)]
+     *            + X^2 * [R(Dab(mn,ef)) + R(Dab(nm,fe))] + Y^2 * [R(Dab(mn,fe)) + R(Dab(nm,ef))]
+     * where R(D) = [1 - e^(-2 * s * D^2)] / D (1 / D if CCVV_SOURCE = ZERO). Pairs with m = n or
+     * E = F are counted twice by this formula and are weighted by 1/2 (see ccvv_tile_energy).
+     *
+     * The tiles fit in the L2 cache (see ccvv_tile_size). The core orbitals are read in batches
+     * and up to three batches are kept in memory at once (see ccvv_live_blocks).
+     */
+    if (ncore_ == 0 or nvirtual_ == 0)
+        return 0.0;
+    const size_t nQ = nthree_;
+    const size_t nv = nvirtual_;
+
+    // a null source gives the unregularized denominators
+    DSRG_SOURCE* source =
+        foptions_->get_str("CCVV_SOURCE") == "ZERO" ? nullptr : dsrg_source_.get();
+
+    // with the same alpha and beta Fock matrices all the denominators are equal
+    bool same_fock = true;
+    std::vector<double> Fva(nv), Fvb(nv);
+    for (size_t e = 0; e < nv; ++e) {
+        Fva[e] = Fa_[virt_mos_[e]];
+        Fvb[e] = Fb_[virt_mos_[e]];
+        same_fock = same_fock and Fva[e] == Fvb[e];
+    }
+    for (size_t m : core_mos_)
+        same_fock = same_fock and Fa_[m] == Fb_[m];
+
+    // batches of core orbitals such that all the blocks kept alive by the reader fit in memory
+    size_t memory = psi::Process::environment.get_memory() * 0.75;
+    size_t batch_size = std::clamp<size_t>(
+        memory / (ccvv_live_blocks(pqQ) * nQ * nv * sizeof(double)), 1, ncore_);
+    if (foptions_->get_int("CCVV_BATCH_NUMBER") > 0) {
+        size_t num_batch = std::min<size_t>(foptions_->get_int("CCVV_BATCH_NUMBER"), ncore_);
+        batch_size = (ncore_ + num_batch - 1) / num_batch;
+    }
+    std::vector<std::vector<size_t>> batches;
+    for (size_t first = 0; first < ncore_; first += batch_size) {
+        size_t last = std::min(first + batch_size, ncore_);
+        batches.emplace_back(core_mos_.begin() + first, core_mos_.begin() + last);
+    }
+
+    // virtual tiles [tiles[t], tiles[t + 1]) and the pairs of tiles (E, F) with E <= F
+    const size_t tile_size = ccvv_tile_size(nv);
+    std::vector<size_t> tiles;
+    for (size_t e = 0; e < nv; e += tile_size)
+        tiles.push_back(e);
+    tiles.push_back(nv);
+    std::vector<std::pair<size_t, size_t>> tile_pairs;
+    for (size_t E = 0; E + 1 < tiles.size(); ++E) {
+        for (size_t F = E; F + 1 < tiles.size(); ++F)
+            tile_pairs.emplace_back(E, F);
+    }
+    const size_t ntile_pairs = tile_pairs.size();
+
+    std::vector<std::vector<double>> Xvec(num_threads_, std::vector<double>(tile_size * tile_size));
+    std::vector<std::vector<double>> Yvec(num_threads_, std::vector<double>(tile_size * tile_size));
+
+    double Eccvv = 0.0;
+    auto B_blocks = ccvv_block_reader(batches, virt_mos_, pqQ);
+    for (size_t I = 0; I < batches.size(); ++I) {
+        ambit::Tensor Bm = B_blocks.next();
+        for (size_t J = 0; J <= I; ++J) {
+            ambit::Tensor Bn = J == I ? Bm : B_blocks.next();
+            double* Bm_ptr = Bm.data().data();
+            double* Bn_ptr = Bn.data().data();
+
+            // pairs of core orbitals (m, n) with m >= n
+            std::vector<std::pair<size_t, size_t>> mn_pairs;
+            for (size_t m = 0; m < batches[I].size(); ++m) {
+                for (size_t n = 0; n < (J == I ? m + 1 : batches[J].size()); ++n)
+                    mn_pairs.emplace_back(m, n);
+            }
+            const size_t ntasks = mn_pairs.size() * ntile_pairs;
+
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic) reduction(+ : Eccvv)
+            for (size_t task = 0; task < ntasks; ++task) {
+                int thread = omp_get_thread_num();
+                double* X = Xvec[thread].data();
+                double* Y = Yvec[thread].data();
+
+                const size_t m = mn_pairs[task / ntile_pairs].first;
+                const size_t n = mn_pairs[task / ntile_pairs].second;
+                const size_t E = tile_pairs[task % ntile_pairs].first;
+                const size_t F = tile_pairs[task % ntile_pairs].second;
+                const size_t e0 = tiles[E], ne = tiles[E + 1] - e0;
+                const size_t f0 = tiles[F], nf = tiles[F + 1] - f0;
+
+                psi::C_DGEMM('N', 'T', ne, nf, nQ, 1.0, Bm_ptr + (m * nv + e0) * nQ, nQ,
+                             Bn_ptr + (n * nv + f0) * nQ, nQ, 0.0, X, nf);
+                // for a diagonal pair of tiles Y(fe) = X(fe)
+                if (E == F) {
+                    Y = X;
+                } else {
+                    psi::C_DGEMM('N', 'T', nf, ne, nQ, 1.0, Bm_ptr + (m * nv + f0) * nQ, nQ,
+                                 Bn_ptr + (n * nv + e0) * nQ, nQ, 0.0, Y, ne);
+                }
+
+                const size_t mo_m = batches[I][m];
+                const size_t mo_n = batches[J][n];
+                const double Etile = ccvv_tile_energy(
+                    X, Y, e0, ne, f0, nf, Fa_[mo_m], Fb_[mo_m], Fa_[mo_n], Fb_[mo_n], Fva.data(),
+                    same_fock ? nullptr : Fvb.data(), source);
+                const double weight = (mo_m == mo_n ? 0.5 : 1.0) * (E == F ? 0.5 : 1.0);
+                Eccvv += weight * Etile;
+            }
+        }
+    }
+    return Eccvv;
+}
+
 double THREE_DSRG_MRPT2::E_VT2_2_batch_virtual() {
     bool debug_print = foptions_->get_bool("DSRG_MRPT2_DEBUG");
     double Ealpha = 0.0;
@@ -2381,7 +2518,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_virtual() {
     outfile->Printf("\n\n====Blocking information==========\n");
     size_t int_mem_int = (nthree_ * ncore_ * nvirtual_) * sizeof(double);
     size_t memory_input = psi::Process::environment.get_memory() * 0.75;
-    size_t num_block = int_mem_int / memory_input < 1 ? 1 : int_mem_int / memory_input;
+    // the memory is shared by all the blocks that the reader keeps alive at once
+    size_t live_mem = ccvv_live_blocks(Qpq) * int_mem_int;
+    size_t num_block = std::max<size_t>(1, (live_mem + memory_input - 1) / memory_input);
 
     if (foptions_->get_int("CCVV_BATCH_NUMBER") != -1) {
         num_block = foptions_->get_int("CCVV_BATCH_NUMBER");
@@ -2427,8 +2566,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_virtual() {
 
     // Step 2:  Loop over memory allowed blocks of m and n
     // Get batch sizes and create vectors of mblock length
+    std::vector<std::vector<size_t>> batches(num_block);
     for (size_t e_blocks = 0; e_blocks < num_block; e_blocks++) {
-        std::vector<size_t> e_batch;
+        std::vector<size_t>& e_batch = batches[e_blocks];
         // If core_ goes into num_block equally, all blocks are equal
         if (nvirtual_ % num_block == 0) {
             // Fill the mbatch from block_begin to block_end
@@ -2448,12 +2588,12 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_virtual() {
             std::copy(virt_mos_.begin() + (e_blocks)*block_size,
                       virt_mos_.begin() + (e_blocks)*block_size + gimp_block_size, e_batch.begin());
         }
+    }
 
-        ambit::Tensor B = ints_->three_integral_block(aux_mos_, e_batch, core_mos_);
-        ambit::Tensor BeQm =
-            ambit::Tensor::build(tensor_type_, "BmQE", {e_batch.size(), nthree_, ncore_});
-        BeQm("eQm") = B("Qem");
-        B.reset();
+    auto B_blocks = ccvv_block_reader(batches, core_mos_);
+    for (size_t e_blocks = 0; e_blocks < num_block; e_blocks++) {
+        const std::vector<size_t>& e_batch = batches[e_blocks];
+        ambit::Tensor BeQm = B_blocks.next();
 
         if (debug_print) {
             outfile->Printf("\n  BeQm norm: %8.8f", BeQm.norm(2.0));
@@ -2470,33 +2610,9 @@ double THREE_DSRG_MRPT2::E_VT2_2_batch_virtual() {
         }
 
         for (size_t f_blocks = 0; f_blocks <= e_blocks; f_blocks++) {
-            std::vector<size_t> f_batch;
-            // If core_ goes into num_block equally, all blocks are equal
-            if (nvirtual_ % num_block == 0) {
-                // Fill the mbatch from block_begin to block_end
-                // This is done so I can pass a block to IntegralsAPI to read a
-                // chunk
-                f_batch.resize(block_size);
-                std::copy(virt_mos_.begin() + f_blocks * block_size,
-                          virt_mos_.begin() + ((f_blocks + 1) * block_size), f_batch.begin());
-            } else {
-                // If last_block is longer, block_size + remainder
-                size_t gimp_block_size =
-                    f_blocks == (num_block - 1) ? block_size + nvirtual_ % num_block : block_size;
-                f_batch.resize(gimp_block_size);
-                std::copy(virt_mos_.begin() + (f_blocks)*block_size,
-                          virt_mos_.begin() + (f_blocks * block_size) + gimp_block_size,
-                          f_batch.begin());
-            }
-            ambit::Tensor BfQn =
-                ambit::Tensor::build(tensor_type_, "BnQf", {f_batch.size(), nthree_, ncore_});
-            if (f_blocks == e_blocks) {
-                BfQn.copy(BeQm);
-            } else {
-                ambit::Tensor B = ints_->three_integral_block(aux_mos_, f_batch, core_mos_);
-                BfQn("eQm") = B("Qem");
-                B.reset();
-            }
+            const std::vector<size_t>& f_batch = batches[f_blocks];
+            // the diagonal block shares the integrals of the e block (they are only read)
+            ambit::Tensor BfQn = f_blocks == e_blocks ? BeQm : B_blocks.next();
             if (debug_print) {
                 outfile->Printf("\n  BfQn norm: %8.8f", BfQn.norm(2.0));
                 outfile->Printf("\n  f_block: %d", f_blocks);
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "helpers/threading.h"
 #include "master_mrdsrg.h"
 
 namespace forte {
@@ -200,6 +201,18 @@ class THREE_DSRG_MRPT2 : public MASTER_DSRG {
     double E_VT2_2_batch_core();
     /// batch_core Reads only E*F (where M and N are size of virtual batches)
     double E_VT2_2_batch_virtual();
+    /// fused -> Forms (me|nf) in cache-sized tiles and reduces them into the energy right away
+    double E_VT2_2_fused();
+    /// Return a reader of the blocks B(iQa) (order = Qpq) or B(iaQ) (order = pqQ) used by the
+    /// batched algorithms, where i runs over a batch of orbitals and a over mos. The blocks are
+    /// returned in the order in which they are used (for each batch I, batch I and then the
+    /// batches J < I) and the next block is read in the background (option CCVV_BATCH_PREFETCH)
+    AsyncPrefetcher<ambit::Tensor> ccvv_block_reader(const std::vector<std::vector<size_t>>& batches,
+                                                     const std::vector<size_t>& mos,
+                                                     ThreeIntsBlockOrder order = Qpq);
+    /// Return the largest number of blocks of ccvv_block_reader (with a given order) that are in
+    /// memory at once, used to size the batches
+    size_t ccvv_live_blocks(ThreeIntsBlockOrder order) const;
     /// Core MPI parallel algorithms (MPI -> distriubuted B)
     /// ga->distrubuted B with Global Arrays API
     /// rep->Broadcast B (debug version)
@@ -295,6 +295,13 @@ def register_active_space_solver_options(options):
 
     options.add_double("S_TOLERANCE", 0.25, "The maximum deviation from the spin quantum number S tolerated.")
 
+    options.add_bool(
+        "CONCURRENT_STATES",
+        False,
+        "Solve the states of different symmetry concurrently, splitting the threads in proportion to the number "
+        "of determinants of each state (FCI and GENCI only)",
+    )
+
     options.add_bool("DUMP_ACTIVE_WFN", False, "Save CI wave function of ActiveSpaceSolver to disk")
 
     options.add_bool("READ_ACTIVE_WFN_GUESS", False, "Read CI wave function of ActiveSpaceSolver from disk")
@@ -313,6 +320,26 @@ def register_active_space_solver_options(options):
 def register_pt2_options(options):
     options.set_group("PT2")
     options.add_double("PT2_MAX_MEM", 1.0, "Maximum size of the determinant hash (GB)")
+    options.add_str(
+        "PT2_ALGORITHM",
+        "DETERMINISTIC",
+        ["DETERMINISTIC", "SEMISTOCHASTIC"],
+        "The algorithm used to compute the full EN-PT2 correction",
+    )
+    options.add_int(
+        "PT2_DETERMINISTIC_SIZE",
+        1000,
+        "The number of reference determinants with the largest coefficients treated deterministically in the "
+        "semistochastic PT2 algorithm",
+    )
+    options.add_int(
+        "PT2_STOCHASTIC_SAMPLES", 1000, "The number of reference determinants sampled in each stochastic PT2 batch"
+    )
+    options.add_double(
+        "PT2_STOCHASTIC_ERROR", 1.0e-5, "The target standard error (Eh) of the semistochastic PT2 correction"
+    )
+    options.add_int("PT2_STOCHASTIC_MAX_BATCHES", 1000, "The maximum number of stochastic PT2 batches")
+    options.add_int("PT2_STOCHASTIC_SEED", 0, "The seed of the random number generator of the stochastic PT2 batches")
 
 
 def register_pci_options(options):
@@ -428,6 +455,17 @@ def register_fci_options(options):
     options.add_bool("PRINT_NO", False, "Print the NO from the rdm of FCI")
     options.add_bool("CI_SPIN_ADAPT", False, "Spin-adapt the CI wavefunction?")
     options.add_bool("CI_SPIN_ADAPT_FULL_PRECONDITIONER", False, "Use full preconditioner for spin-adapted CI?")
+    options.add_bool(
+        "CI_STRING_LISTS_CACHE",
+        False,
+        "Save the FCI/GenCI string lists to a file and read them back when a solver is created for the"
+        " same active space (e.g., in CASSCF iterations or geometry scans)",
+    )
+    options.add_str(
+        "CI_STRING_LISTS_CACHE_DIR",
+        "",
+        "The directory where the string lists are cached. If empty, the psi4 scratch directory is used",
+    )
 
 
 def register_sci_options(options):
@@ -558,7 +596,14 @@ def register_aci_options(options):
 
     options.add_int("ACTIVE_GUESS_SIZE", 1000, "Number of determinants for CI guess")
 
-    options.add_str("DIAG_ALGORITHM", "SPARSE", ["DYNAMIC", "FULL", "SPARSE"], "The diagonalization method")
+    options.add_str(
+        "DIAG_ALGORITHM",
+        "SPARSE",
+        ["DYNAMIC", "FULL", "SPARSE", "SPARSE_STREAMING"],
+        "The diagonalization method. SPARSE_STREAMING stores the coupling lists in compressed form"
+        " and keeps at most SIGMA_VECTOR_MAX_MEMORY doubles in memory, spilling the rest to disk"
+        " (SIGMA_VECTOR_MAX_MEMORY must be positive)",
+    )
 
     options.add_bool("FORCE_DIAG_METHOD", False, "Force the diagonalization procedure?")
 
@@ -631,7 +676,8 @@ def register_tdci_options(options):
             "RK4_SELECT_LIST",
             "ALL",
         ],
-        "Type of propagator",
+        "Type of propagator. RK4 and LANCZOS apply the Hamiltonian through sigma builds (see DIAG_ALGORITHM)"
+        " and do not store the Hamiltonian matrix",
     )
 
     options.add_int("TDCI_NSTEP", 20, "Number of time-steps")
@@ -700,6 +746,18 @@ def register_integral_options(options):
 
     options.add_bool("PRINT_INTS", False, "Print the one- and two-electron integrals?")
 
+    options.add_bool(
+        "INT_CACHE",
+        False,
+        "Save the two-electron integrals (CONVENTIONAL, DF, and CHOLESKY) to a file and read them back in later"
+        " computations with the same basis, geometry, and orbitals, skipping the integral transformation",
+    )
+    options.add_str(
+        "INT_CACHE_DIR",
+        "",
+        "The directory where the integrals are cached. If empty, the psi4 scratch directory is used",
+    )
+
 
 def register_dsrg_options(options):
     options.set_group("DSRG")
@@ -843,8 +901,9 @@ def register_dsrg_options(options):
 
     options.add_str(
         "CCVV_ALGORITHM",
-        "FLY_AMBIT",
+        "FUSED",
         [
+            "FUSED",
             "CORE",
             "FLY_AMBIT",
             "FLY_LOOP",
@@ -857,13 +916,21 @@ def register_dsrg_options(options):
             "BATCH_CORE_REP",
             "BATCH_VIRTUAL_REP",
         ],
-        "Algorithm to compute the CCVV term in DSRG-MRPT2 (only in three-dsrg-mrpt2 code)",
+        "Algorithm to compute the CCVV term in DSRG-MRPT2 (only in three-dsrg-mrpt2 code). FUSED forms the"
+        " integrals in cache-sized tiles and picks the batch and tile sizes automatically",
     )
 
     options.add_bool("AO_DSRG_MRPT2", False, "Do AO-DSRG-MRPT2 if true (not available)")
 
     options.add_int("CCVV_BATCH_NUMBER", -1, "Batches for CCVV_ALGORITHM")
 
+    options.add_bool(
+        "CCVV_BATCH_PREFETCH",
+        True,
+        "Read the next batch of three-index integrals in a background thread while the current batch is"
+        " contracted (CCVV_ALGORITHM = FUSED, BATCH_CORE, or BATCH_VIRTUAL)",
+    )
+
     options.add_bool("DSRG_MRPT2_DEBUG", False, "Excssive printing for three-dsrg-mrpt2")
 
     options.add_str(
@@ -913,7 +980,8 @@ def register_dsrg_options(options):
         "DSRG_3RDM_ALGORITHM",
         "EXPLICIT",
         ["EXPLICIT", "DIRECT"],
-        "Algorithm to compute 3-RDM contributions in fully contracted [H2, T2]",
+        "Algorithm to compute 3-RDM contributions in fully contracted [H2, T2]. DIRECT never forms the 3-RDM"
+        " (available for the FCI and DETCI active space solvers)",
     )
 
     options.add_bool("DSRG_RDM_MS_AVG", False, "Form Ms-averaged density if true")
@@ -1063,7 +1131,27 @@ def register_casscf_options(options):
     )
 
     options.add_str(
-        "ORB_ROTATION_ALGORITHM", "DIAGONAL", ["DIAGONAL", "AUGMENTED_HESSIAN"], "Orbital rotation algorithm"
+        "CASSCF_TEI_BUILDER",
+        "AUTO",
+        ["AUTO", "JK"],
+        "How to build the integrals (pu|xy). AUTO contracts the three-index integrals in batches for DF, DISKDF,"
+        " and CD integrals and uses JK otherwise. JK builds one Coulomb matrix per pair of active orbitals",
+    )
+
+    options.add_str(
+        "ORB_ROTATION_ALGORITHM",
+        "DIAGONAL",
+        ["DIAGONAL", "AUGMENTED_HESSIAN"],
+        "Orbital optimizer of MCSCF_TWO_STEP. DIAGONAL uses L-BFGS with a diagonal Hessian. AUGMENTED_HESSIAN"
+        " uses a trust-region augmented Hessian method with exact orbital Hessian-vector products at fixed CI"
+        " coefficients (the CI-orbital coupling is not included)",
+    )
+
+    options.add_bool(
+        "CASSCF_TEST_HESS_VEC",
+        False,
+        "Compare the exact orbital Hessian-vector product with a finite difference of the orbital gradient"
+        " at the initial orbitals (stored in MCSCF HESSIAN-VECTOR ERROR)",
     )
 
     options.add_bool("CASSCF_DO_DIIS", True, "Use DIIS in CASSCF orbital optimization")
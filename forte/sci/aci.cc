@@ -38,6 +38,7 @@
 #include "base_classes/scf_info.h"
 #include "helpers/printing.h"
 #include "helpers/helpers.h"
+#include "helpers/threading.h"
 #include "ci_rdm/ci_rdms.h"
 #include "sparse_ci/ci_reference.h"
 
@@ -258,7 +259,7 @@ void AdaptiveCI::find_q_space() {
     // Add P_space determinants
     PQ_space_.swap(P_space_);
 
-    std::sort(F_space.begin(), F_space.end(), pairComp);
+    parallel_sort(F_space.begin(), F_space.end(), pairComp);
 
     local_timer screen;
     double ept2 = 0.0 - remainder;
@@ -299,16 +299,16 @@ class AdaptiveCI : public SelectedCIMethod {
                                            std::vector<std::pair<double, Determinant>>& F_space);
 
     /// (DEFAULT)  Builds excited determinants for a bin, uses all threads, hash-based
-    det_hash<double> get_bin_F_space(int bin, int nbin, double E0,
-                                     std::shared_ptr<psi::Matrix> evecs,
-                                     DeterminantHashVec& P_space);
+    det_accumulator<double> get_bin_F_space(int bin, int nbin, double E0,
+                                            std::shared_ptr<psi::Matrix> evecs,
+                                            DeterminantHashVec& P_space);
 
     /// Builds core excited determinants for a bin, uses all threads, hash-based
     det_hash<double> get_bin_F_space_core(int bin, int nbin, double E0,
                                           std::shared_ptr<psi::Matrix> evecs,
                                           DeterminantHashVec& P_space);
-    /// Builds excited determinants in batch using sorting of vectors
-    std::pair<std::vector<std::vector<std::pair<Determinant, double>>>, std::vector<size_t>>
+    /// Builds excited determinants in batch and returns them as a vector with their couplings
+    std::vector<std::pair<Determinant, double>>
     get_bin_F_space_vecsort(int bin, int nbin, std::shared_ptr<psi::Matrix> evecs,
                             DeterminantHashVec& P_space);
 
@@ -28,6 +28,7 @@
  */
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libmints/matrix.h"
@@ -53,6 +54,15 @@ bool pair_compd(const std::pair<Determinant, double> E1, const std::pair<Determi
     return E1.first < E2.first;
 }
 
+/// Estimate the memory (in MB) used by a det_accumulator<double> to store num_entries
+/// determinants. Each entry of a FlatHashMap holds the determinant, the value and the hash, plus
+/// about two 64-bit slots of the table. During the merge an entry can be stored both in the maps
+/// of the threads and in the partitions, so the peak memory is twice that of the entries
+double accumulator_memory_estimate(size_t num_entries) {
+    const double entry_bytes = sizeof(std::pair<Determinant, double>) + 3 * sizeof(std::uint64_t);
+    return 2.0 * static_cast<double>(num_entries) * entry_bytes * 1.0e-6;
+}
+
 void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr<psi::Vector> evals,
                                              DeterminantHashVec& P_space,
                                              std::vector<std::pair<double, Determinant>>& F_space) {
@@ -60,17 +70,18 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
     size_t max_P = P_space.size();
     const det_hashvec& P_dets = P_space.wfn_hash();
 
-    det_hash<double> V_hash;
+    // Each thread screens its own P determinants into partitioned buffers that are merged in
+    // parallel after screening
+    const size_t nthreads = omp_get_max_threads();
+    det_accumulator<double> V_hash(nthreads);
 // Loop over reference determinants
-#pragma omp parallel
+#pragma omp parallel num_threads(nthreads)
     {
         size_t num_thread = omp_get_num_threads();
         size_t tid = omp_get_thread_num();
         const auto [start_idx, end_idx] = thread_range(max_P, num_thread, tid);
 
-        det_hash<double> V_hash_t;
         for (size_t P = start_idx; P < end_idx; ++P) {
-            local_timer single;
             const Determinant& det(P_dets[P]);
             double Cp = evecs->get(P, ref_root_);
 
@@ -96,7 +107,7 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                             new_det = det;
                             new_det.set_alfa_bit(ii, false);
                             new_det.set_alfa_bit(aa, true);
-                            V_hash_t[new_det] += HIJ;
+                            V_hash.add(tid, new_det, HIJ);
                         }
                     }
                 }
@@ -112,7 +123,7 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                             new_det = det;
                             new_det.set_beta_bit(ii, false);
                             new_det.set_beta_bit(aa, true);
-                            V_hash_t[new_det] += HIJ;
+                            V_hash.add(tid, new_det, HIJ);
                         }
                     }
                 }
@@ -132,7 +143,7 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                                 if (std::abs(HIJ) >= screen_thresh_) {
                                     new_det = det;
                                     HIJ *= new_det.double_excitation_aa(ii, jj, aa, bb);
-                                    V_hash_t[new_det] += HIJ;
+                                    V_hash.add(tid, new_det, HIJ);
                                 }
                             }
                         }
@@ -154,7 +165,7 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                                 if (std::abs(HIJ) >= screen_thresh_) {
                                     new_det = det;
                                     HIJ *= new_det.double_excitation_ab(ii, jj, aa, bb);
-                                    V_hash_t[new_det] += HIJ;
+                                    V_hash.add(tid, new_det, HIJ);
                                 }
                             }
                         }
@@ -176,7 +187,7 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                                 if (std::abs(HIJ) >= screen_thresh_) {
                                     new_det = det;
                                     HIJ *= new_det.double_excitation_bb(ii, jj, aa, bb);
-                                    V_hash_t[new_det] += HIJ;
+                                    V_hash.add(tid, new_det, HIJ);
                                 }
                             }
                         }
@@ -184,19 +195,12 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
                 }
             }
         }
-        if (tid == 0)
-            outfile->Printf("\n  Time spent forming F space: %20.6f", build.get());
-        local_timer merge_t;
-#pragma omp critical
-        {
-            for (auto& pair : V_hash_t) {
-                const Determinant& det = pair.first;
-                V_hash[det] += pair.second;
-            }
-        }
-        if (tid == 0)
-            outfile->Printf("\n  Time spent merging thread F spaces: %20.6f", merge_t.get());
     } // Close threads
+    outfile->Printf("\n  Time spent forming F space: %20.6f", build.get());
+
+    local_timer merge_t;
+    V_hash.merge();
+    outfile->Printf("\n  Time spent merging thread F spaces: %20.6f", merge_t.get());
 
     // Remove P space
     const det_hashvec& pdets = P_space.wfn_hash();
@@ -209,22 +213,12 @@ void AdaptiveCI::get_excited_determinants_sr(SharedMatrix evecs, std::shared_ptr
     outfile->Printf("\n  Size of F space: %zu", F_space.size());
 
     local_timer convert;
-
-#pragma omp parallel
-    {
-        size_t num_thread = omp_get_num_threads();
-        size_t tid = omp_get_thread_num();
-        size_t N = 0;
-        for (const auto& I : V_hash) {
-            if (N % num_thread == tid) {
-                double delta = as_ints_->energy(I.first) - evals->get(ref_root_);
-                double V = I.second;
-                double criteria = 0.5 * (delta - sqrt(delta * delta + V * V * 4.0));
-                F_space[N] = std::make_pair(std::fabs(criteria), I.first);
-            }
-            N++;
-        }
-    }
+    const double E0 = evals->get(ref_root_);
+    V_hash.for_each([&](size_t N, const Determinant& det, double V) {
+        double delta = as_ints_->energy(det) - E0;
+        double criteria = 0.5 * (delta - sqrt(delta * delta + V * V * 4.0));
+        F_space[N] = std::make_pair(std::fabs(criteria), det);
+    });
 
     outfile->Printf("\n  Time spent building sorting list: %1.6f", convert.get());
 }
@@ -235,9 +229,12 @@ void AdaptiveCI::get_excited_determinants_avg(
     size_t max_P = P_space.size();
     const det_hashvec& P_dets = P_space.wfn_hash();
 
-    det_hash<std::vector<double>> V_hash;
+    // Each thread screens its own P determinants into partitioned buffers that are merged in
+    // parallel after screening
+    const size_t nthreads = omp_get_max_threads();
+    det_accumulator<std::vector<double>, ElementwiseAddAssign> V_hash(nthreads);
 // Loop over reference determinants
-#pragma omp parallel
+#pragma omp parallel num_threads(nthreads)
     {
         size_t num_thread = omp_get_num_threads();
         size_t tid = omp_get_thread_num();
@@ -246,8 +243,6 @@ void AdaptiveCI::get_excited_determinants_avg(
         if (omp_get_thread_num() == 0 and !quiet_mode_) {
             outfile->Printf("\n  Using %d thread(s).", num_thread);
         }
-        // This will store the excited determinant info for each thread
-        std::vector<std::pair<Determinant, std::vector<double>>> thread_ex_dets;
 
         for (size_t P = start_idx; P < end_idx; ++P) {
             const Determinant& det(P_dets[P]);
@@ -284,7 +279,7 @@ void AdaptiveCI::get_excited_determinants_avg(
                                 }
                                 // thread_ex_dets[i * noalpha + a] =
                                 // std::make_pair(new_det,coupling);
-                                thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                V_hash.add(tid, new_det, std::move(coupling));
                             }
                         }
                     }
@@ -310,7 +305,7 @@ void AdaptiveCI::get_excited_determinants_avg(
                                 }
                                 // thread_ex_dets[i * nobeta + a] =
                                 // std::make_pair(new_det,coupling);
-                                thread_ex_dets.emplace_back(new_det, coupling);
+                                V_hash.add(tid, new_det, std::move(coupling));
                             }
                         }
                     }
@@ -344,7 +339,7 @@ void AdaptiveCI::get_excited_determinants_avg(
                                         // noalpha*noalpha*nvalpha +
                                         // j*nvalpha*noalpha +  a*nvalpha + b ]
                                         // = std::make_pair(new_det,coupling);
-                                        thread_ex_dets.emplace_back(new_det, coupling);
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -379,7 +374,7 @@ void AdaptiveCI::get_excited_determinants_avg(
                                         // thread_ex_dets[i * nobeta * nvalpha
                                         // *nvbeta + j * bvalpha * nvbeta + a *
                                         // nvalpha]
-                                        thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -411,7 +406,7 @@ void AdaptiveCI::get_excited_determinants_avg(
                                         for (int n = 0; n < nroot; ++n) {
                                             coupling[n] += HIJ * evecs->get(P, n);
                                         }
-                                        thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -420,49 +415,25 @@ void AdaptiveCI::get_excited_determinants_avg(
                 }
             }
         }
-
-#pragma omp critical
-        {
-            for (size_t I = 0, maxI = thread_ex_dets.size(); I < maxI; ++I) {
-                std::vector<double>& coupling = thread_ex_dets[I].second;
-                Determinant& det = thread_ex_dets[I].first;
-                if (V_hash.count(det) != 0) {
-                    for (int n = 0; n < nroot; ++n) {
-                        V_hash[det][n] += coupling[n];
-                    }
-                } else {
-                    V_hash[det] = coupling;
-                }
-            }
-        }
     } // Close threads
 
+    V_hash.merge();
+
     F_space.resize(V_hash.size());
     outfile->Printf("\n  Size of F space: %zu", F_space.size());
 
     local_timer convert;
 
-#pragma omp parallel
-    {
-        size_t tid = omp_get_thread_num();
-        size_t ntd = omp_get_num_threads();
-        size_t N = 0;
-        for (const auto& detpair : V_hash) {
-            if (N % ntd == tid) {
-                double EI = as_ints_->energy(detpair.first);
-                std::vector<double> criteria(nroot, 0.0);
-                for (int n = 0; n < nroot; ++n) {
-                    double V = detpair.second[n];
-                    double delta = EI - evals->get(n);
-                    double criterion = 0.5 * (delta - sqrt(delta * delta + V * V * 4.0));
-                    criteria[n] = std::fabs(criterion);
-                }
-                double value = average_q_values(criteria);
-                F_space[N] = std::make_pair(value, detpair.first);
-            }
-            N++;
+    V_hash.for_each([&](size_t N, const Determinant& det, const std::vector<double>& V) {
+        double EI = as_ints_->energy(det);
+        std::vector<double> criteria(nroot, 0.0);
+        for (int n = 0; n < nroot; ++n) {
+            double delta = EI - evals->get(n);
+            double criterion = 0.5 * (delta - sqrt(delta * delta + V[n] * V[n] * 4.0));
+            criteria[n] = std::fabs(criterion);
         }
-    }
+        F_space[N] = std::make_pair(average_q_values(criteria), det);
+    });
     outfile->Printf("\n  Time spent building sorting list: %1.6f", convert.get());
 }
 
@@ -472,9 +443,12 @@ void AdaptiveCI::get_excited_determinants_core(
     size_t max_P = P_space.size();
     const det_hashvec& P_dets = P_space.wfn_hash();
     int nroot = 1;
-    det_hash<std::vector<double>> V_hash;
+    // Each thread screens its own P determinants into partitioned buffers that are merged in
+    // parallel after screening
+    const size_t nthreads = omp_get_max_threads();
+    det_accumulator<std::vector<double>, ElementwiseAddAssign> V_hash(nthreads);
 // Loop over reference determinants
-#pragma omp parallel
+#pragma omp parallel num_threads(nthreads)
     {
         size_t num_thread = static_cast<size_t>(omp_get_num_threads());
         size_t tid = omp_get_thread_num();
@@ -483,9 +457,6 @@ void AdaptiveCI::get_excited_determinants_core(
         if (omp_get_thread_num() == 0 and !quiet_mode_) {
             outfile->Printf("\n  Using %d threads.", num_thread);
         }
-        // This will store the excited determinant info for each thread
-        std::vector<std::pair<Determinant, std::vector<double>>>
-            thread_ex_dets; //( noalpha * nvalpha  );
 
         for (size_t P = start_idx; P < end_idx; ++P) {
             const Determinant& det(P_dets[P]);
@@ -523,7 +494,7 @@ void AdaptiveCI::get_excited_determinants_core(
                                 }
                                 // thread_ex_dets[i * noalpha + a] =
                                 // std::make_pair(new_det,coupling);
-                                thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                V_hash.add(tid, new_det, std::move(coupling));
                             }
                         }
                     }
@@ -549,7 +520,7 @@ void AdaptiveCI::get_excited_determinants_core(
                                 }
                                 // thread_ex_dets[i * nobeta + a] =
                                 // std::make_pair(new_det,coupling);
-                                thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                V_hash.add(tid, new_det, std::move(coupling));
                             }
                         }
                     }
@@ -584,7 +555,7 @@ void AdaptiveCI::get_excited_determinants_core(
                                         // noalpha*noalpha*nvalpha +
                                         // j*nvalpha*noalpha +  a*nvalpha + b ]
                                         // = std::make_pair(new_det,coupling);
-                                        thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -620,7 +591,7 @@ void AdaptiveCI::get_excited_determinants_core(
                                         // thread_ex_dets[i * nobeta * nvalpha
                                         // *nvbeta + j * bvalpha * nvbeta + a *
                                         // nvalpha]
-                                        thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -654,7 +625,7 @@ void AdaptiveCI::get_excited_determinants_core(
                                         for (int n = 0; n < nroot; ++n) {
                                             coupling[n] += HIJ * evecs->get(P, n);
                                         }
-                                        thread_ex_dets.push_back(std::make_pair(new_det, coupling));
+                                        V_hash.add(tid, new_det, std::move(coupling));
                                     }
                                 }
                             }
@@ -663,51 +634,25 @@ void AdaptiveCI::get_excited_determinants_core(
                 }
             }
         }
-#pragma omp critical
-        {
-            for (size_t I = 0, maxI = thread_ex_dets.size(); I < maxI; ++I) {
-                std::vector<double>& coupling = thread_ex_dets[I].second;
-                Determinant& det = thread_ex_dets[I].first;
-                if (V_hash.count(det) != 0) {
-                    for (int n = 0; n < nroot; ++n) {
-                        V_hash[det][n] += coupling[n];
-                    }
-                } else {
-                    V_hash[det] = coupling;
-                }
-            }
-        }
     } // Close threads
 
+    V_hash.merge();
+
     F_space.resize(V_hash.size());
     outfile->Printf("\n  Size of F space: %zu", F_space.size());
 
     local_timer convert;
 
-#pragma omp parallel
-    {
-        size_t tid = omp_get_thread_num();
-        size_t ntd = omp_get_num_threads();
-
-        size_t N = 0;
-        for (const auto& detpair : V_hash) {
-            if (N % ntd == tid) {
-                double EI = as_ints_->energy(detpair.first);
-                std::vector<double> criteria(nroot, 0.0);
-                for (int n = 0; n < nroot; ++n) {
-                    double V = detpair.second[n];
-                    double delta = EI - evals->get(n);
-                    double criterion = 0.5 * (delta - sqrt(delta * delta + V * V * 4.0));
-                    criteria[n] = std::fabs(criterion);
-                }
-                double value = average_q_values(criteria);
-
-                F_space[N] = std::make_pair(value, detpair.first);
-            }
-            N++;
+    V_hash.for_each([&](size_t N, const Determinant& det, const std::vector<double>& V) {
+        double EI = as_ints_->energy(det);
+        std::vector<double> criteria(nroot, 0.0);
+        for (int n = 0; n < nroot; ++n) {
+            double delta = EI - evals->get(n);
+            double criterion = 0.5 * (delta - sqrt(delta * delta + V[n] * V[n] * 4.0));
+            criteria[n] = std::fabs(criterion);
         }
-    }
-
+        F_space[N] = std::make_pair(average_q_values(criteria), det);
+    });
     outfile->Printf("\n  Time spent building sorting list: %1.6f", convert.get());
 }
 
@@ -735,8 +680,7 @@ double AdaptiveCI::get_excited_determinants_batch_vecsort(
     size_t nvir2 = (nmo - nalpha_) * (nmo - nalpha_);
     size_t guess_size = n_dets * nocc2 * nvir2;
 
-    double guess_mem =
-        guess_size * (4.0 + double(Determinant::nbits)) * 1.25e-7 * 1.4; // Est of map size in MB
+    double guess_mem = accumulator_memory_estimate(guess_size);
     int nruns = static_cast<int>(std::ceil(guess_mem / max_mem));
 
     double total_excluded = 0.0;
@@ -754,79 +698,31 @@ double AdaptiveCI::get_excited_determinants_batch_vecsort(
         outfile->Printf("\n                Bin %d", bin);
         local_timer sp;
         // 1. Build the full bin-subset // all threading in here
-        auto A_b_t = get_bin_F_space_vecsort(bin, nbin, evecs, P_space);
+        auto master = get_bin_F_space_vecsort(bin, nbin, evecs, P_space);
         outfile->Printf("\n    Build F                %10.6f ", sp.get());
 
-        // 2. Put the dets/vals in a sortable list (F_tmp)
+        // 2. Compute the criteria
         local_timer bint;
-#pragma omp parallel
-        {
-            int tid = omp_get_thread_num();
-            auto& A_b = A_b_t.first[tid];
-            //                        size_t idx = 0;
-            double E0 = evals->get(0);
-            //            outfile->Printf("\n td %d, Ab: %zu, abt: %zu", tid
-            //            ,A_b.size(), A_b_t.second[tid]);
-            for (size_t I = 0, max_I = A_b_t.second[tid]; I < max_I; I++) {
-                auto& pair = A_b[I];
-                double& V = pair.second;
-                if (V != 0.0) {
-                    auto& det = pair.first;
-                    double delta = as_ints_->energy(det) - E0;
-                    V = std::fabs(0.5 * (delta - sqrt(delta * delta + V * V * 4.0)));
-                }
-            }
+        const double E0 = evals->get(0);
+        const size_t total_size = master.size();
+        const auto max_I = static_cast<std::int64_t>(total_size);
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (std::int64_t I = 0; I < max_I; ++I) {
+            auto& [det, V] = master[I];
+            double delta = as_ints_->energy(det) - E0;
+            V = std::fabs(0.5 * (delta - sqrt(delta * delta + V * V * 4.0)));
         }
         outfile->Printf("\n    Build criteria vector  %10.6f", bint.get());
 
         // 3. Sort the list
-        //  local_timer sortt;
-        //  #pragma omp parallel
-        //  {
-        //      int tid = omp_get_thread_num();
-        //      std::sort(A_b_t.first[tid].begin(), A_b_t.first[tid].begin() +
-        //      A_b_t.second[tid],
-        //                [](const std::pair<Determinant, double>& a,
-        //                   const std::pair<Determinant, double>& b) -> bool {
-        //                    return a.second < b.second;
-        //                });
-        //  }
-        //  outfile->Printf("\n    Sort vector            %10.6f", sortt.get());
+        local_timer sortt;
+        parallel_sort(master.begin(), master.end(), pair_comp2);
+        outfile->Printf("\n    Sort vector            %10.6f", sortt.get());
 
         // 4. Screen subspaces
-        // Can it be done without recombining/resorting?
         local_timer screener;
-        // single-thread algorithm
         double b_sigma = sigma_ * (aci_scale / nbin);
         double excluded = 0.0;
-        size_t total_size = 0;
-
-        for (size_t& s : A_b_t.second) {
-            total_size += s;
-        }
-
-        // Test threaded det generation
-        std::vector<std::pair<Determinant, double>> master;
-        master.reserve(total_size);
-#pragma omp parallel
-        {
-            int tid = omp_get_thread_num();
-
-            auto& A_b = A_b_t.first[tid];
-
-#pragma omp critical
-            {
-                //        outfile->Printf("\n Ab(%d) size = %zu", tid, A_b.size());
-                for (size_t I = 0, max_I = A_b_t.second[tid]; I < max_I; ++I) {
-                    master.push_back(A_b[I]);
-                }
-            }
-        }
-        std::sort(
-            master.begin(), master.end(),
-            [](const std::pair<Determinant, double>& a,
-               const std::pair<Determinant, double>& b) -> bool { return a.second < b.second; });
-
         for (auto& pair : master) {
             const double& en = pair.second;
             const auto& det = pair.first;
@@ -862,8 +758,7 @@ AdaptiveCI::get_excited_determinants_batch(SharedMatrix evecs, std::shared_ptr<p
     size_t nvir2 = (nmo - nalpha_) * (nmo - nalpha_);
     size_t guess_size = n_dets * nocc2 * nvir2;
     // outfile->Printf("\n  guess_size: %zu o: %zu, v: %zu", guess_size, nocc2, nvir2);
-    double guess_mem =
-        guess_size * (4.0 + double(Determinant::nbits)) * 1.25e-7 * 1.4; // Est of map size in MB
+    double guess_mem = accumulator_memory_estimate(guess_size);
     int nruns = static_cast<int>(std::ceil(guess_mem / max_mem));
 
     double total_excluded = 0.0;
@@ -885,7 +780,7 @@ AdaptiveCI::get_excited_determinants_batch(SharedMatrix evecs, std::shared_ptr<p
         //        total_excluded += prescreen_F(bin,nbin,evals->get(0), evecs,P_space);
 
         // 1. Build the full bin-subset // all threading in here
-        det_hash<double> A_b = get_bin_F_space(bin, nbin, evals->get(0), evecs, P_space);
+        auto A_b = get_bin_F_space(bin, nbin, evals->get(0), evecs, P_space);
         outfile->Printf("\n    Build F                %10.6f ", sp.get());
 
         // 2. Put the dets/vals in a sortable list (F_tmp)
@@ -894,31 +789,19 @@ AdaptiveCI::get_excited_determinants_batch(SharedMatrix evecs, std::shared_ptr<p
         // get sizes
         size_t subspace_size = A_b.size();
         std::vector<std::pair<double, Determinant>> F_tmp(subspace_size);
-#pragma omp parallel
-        {
-            int ntd = omp_get_num_threads();
-            int tid = omp_get_thread_num();
-            size_t idx = 0;
-            double E0 = evals->get(0);
-            for (auto& pair : A_b) {
-                if ((idx % ntd) == tid) {
-                    auto& det = pair.first;
-                    double& V = pair.second;
-                    double delta = as_ints_->energy(det) - E0;
-
-                    F_tmp[idx] = std::make_pair(
-                        std::fabs(0.5 * (delta - sqrt(delta * delta + V * V * 4.0))), det);
-                }
-                idx++;
-            }
-        }
+        const double E0 = evals->get(0);
+        A_b.for_each([&](size_t idx, const Determinant& det, double V) {
+            double delta = as_ints_->energy(det) - E0;
+            F_tmp[idx] =
+                std::make_pair(std::fabs(0.5 * (delta - sqrt(delta * delta + V * V * 4.0))), det);
+        });
         A_b.clear();
 
         outfile->Printf("\n    Build criteria vector  %10.6f", bint.get());
 
         // 3. Sort the list
         local_timer sortt;
-        std::sort(F_tmp.begin(), F_tmp.end(), pair_comp);
+        parallel_sort(F_tmp.begin(), F_tmp.end(), pair_comp);
         outfile->Printf("\n    Sort vector            %10.6f", sortt.get());
 
         // 4. Screen subspaces
@@ -945,31 +828,25 @@ AdaptiveCI::get_excited_determinants_batch(SharedMatrix evecs, std::shared_ptr<p
     return total_excluded;
 }
 
-det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, SharedMatrix evecs,
-                                             DeterminantHashVec& P_space) {
-
-    det_hash<double> bin_f_space;
+det_accumulator<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/,
+                                                    SharedMatrix evecs,
+                                                    DeterminantHashVec& P_space) {
     local_timer build;
 
     const size_t n_dets = P_space.size();
     const det_hashvec& dets = P_space.wfn_hash();
     std::vector<int> act_mo = mo_space_info_->dimension("ACTIVE").blocks();
 
-    std::vector<det_hash<double>> A_b_t;
-    double value = 0.0;
+    // Each thread screens its own P determinants into partitioned buffers that are merged in
+    // parallel after screening
+    const size_t nthreads = omp_get_max_threads();
+    det_accumulator<double> A_b(nthreads);
 
-#pragma omp parallel reduction(+ : value)
+#pragma omp parallel num_threads(nthreads)
     {
         size_t n_threads = static_cast<size_t>(omp_get_num_threads());
         size_t thread_id = static_cast<size_t>(omp_get_thread_num());
 
-#pragma omp critical
-        {
-            A_b_t.resize(n_threads);
-            // E_b_t.resize(n_threads);
-        }
-
-        det_hash<double>& A_b = A_b_t[thread_id];
         size_t bin_size = n_dets / n_threads;
         bin_size += (thread_id < (n_dets % n_threads)) ? 1 : 0;
         size_t start_idx = (thread_id < (n_dets % n_threads))
@@ -1011,7 +888,7 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
                         if ((hash_val % nbin) == bin) {
                             double HIJ = as_ints_->slater_rules_single_alpha(det, ii, aa) * c_I;
                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                A_b[new_det] += HIJ;
+                                A_b.add(thread_id, new_det, HIJ);
                                 //} else if (std::fabs(HIJ) >= 1e-12) {
                                 //    E_b[new_det] += HIJ;
                             }
@@ -1031,7 +908,7 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
                         if ((hash_val % nbin) == bin) {
                             double HIJ = as_ints_->slater_rules_single_beta(det, ii, aa) * c_I;
                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                A_b[new_det] += HIJ;
+                                A_b.add(thread_id, new_det, HIJ);
                                 //} else if (std::fabs(HIJ) >= 1e-12) {
                                 //    E_b[new_det] += HIJ;
                             }
@@ -1076,8 +953,8 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_aa(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                A_b[new_det] +=
-                                                    (HIJ * det.slater_sign_aaaa(ii, jj, aa, bb));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * det.slater_sign_aaaa(ii, jj, aa, bb));
                                                 //} else if (std::fabs(HIJ) >= 1e-12) {
                                                 //    E_b[new_det] += HIJ *
                                                 //    det.slater_sign_aaaa(ii, jj, aa,
@@ -1120,8 +997,8 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_bb(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                A_b[new_det] +=
-                                                    (HIJ * det.slater_sign_bbbb(ii, jj, aa, bb));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * det.slater_sign_bbbb(ii, jj, aa, bb));
                                                 //} else if (std::fabs(HIJ) >= 1e-12) {
                                                 //    E_b[new_det] += HIJ *
                                                 //    det.slater_sign_bbbb(ii, jj, aa,
@@ -1160,9 +1037,9 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_ab(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                A_b[new_det] +=
-                                                    (HIJ * new_det.slater_sign_aa(ii, aa) *
-                                                     new_det.slater_sign_bb(jj, bb));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * new_det.slater_sign_aa(ii, aa) *
+                                                            new_det.slater_sign_bb(jj, bb));
                                                 //} else if (std::fabs(HIJ) >= 1e-12) {
                                                 //    E_b[new_det] += HIJ *
                                                 //    new_det.slater_sign_aa(ii, aa) *
@@ -1182,76 +1059,38 @@ det_hash<double> AdaptiveCI::get_bin_F_space(int bin, int nbin, double /*E0*/, S
             }
         } // end loop over reference
 
-        // outfile->Printf("\n  Added %zu dets", A_b.size());
-
-        // Remove duplicates
-        for (det_hashvec::iterator it = dets.begin(), endit = dets.end(); it != endit; ++it) {
-            A_b_t[thread_id].erase(*it);
-        }
         if (thread_id == 0)
             outfile->Printf("\n  Build: %1.6f", build.get());
-
-        local_timer merge;
-#pragma omp critical
-        {
-            for (auto& pair : A_b_t[thread_id]) {
-                bin_f_space[pair.first] += pair.second;
-            }
-        }
-        // #pragma omp critical
-        //         {
-        //             for (auto& pair : E_b_t[thread_id]) {
-        //                 bin_E_space[pair.first] += pair.second;
-        //             }
-        //         }
-
-#pragma omp barrier
-        if (thread_id == 0)
-            outfile->Printf("\n  Merge: %1.6f", merge.get());
-
-        // size_t idx = 0;
-        // for( auto& pair : bin_E_space ){
-        //    if( (idx % n_threads) == thread_id ){
-        //        auto& det = pair.first;
-        //        double& V = pair.second;
-
-        //        double delta = as_ints_->energy(det) - E0;
-
-        //        value += std::fabs(0.5 * (delta - sqrt(delta * delta + V * V * 4.0)));
-        //    }
-        //    idx++;
-        //}
     } // close threads
 
-    //    outfile->Printf("\n  Correlation ignored: %1.12f", value);
-    return bin_f_space;
+    local_timer merge;
+    A_b.merge();
+
+    // Remove the P space determinants
+    for (det_hashvec::iterator it = dets.begin(), endit = dets.end(); it != endit; ++it) {
+        A_b.erase(*it);
+    }
+    outfile->Printf("\n  Merge: %1.6f", merge.get());
+    return A_b;
 }
 
-std::pair<std::vector<std::vector<std::pair<Determinant, double>>>, std::vector<size_t>>
+std::vector<std::pair<Determinant, double>>
 AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                                     DeterminantHashVec& P_space) {
-    det_hash<double> bin_f_space;
     local_timer build;
     const size_t n_dets = P_space.size();
     const det_hashvec& dets = P_space.wfn_hash();
-    int nmo = as_ints_->nmo();
     std::vector<int> act_mo = mo_space_info_->dimension("ACTIVE").blocks();
 
-    std::vector<std::vector<std::pair<Determinant, double>>> vec_A_b_t;
-    std::vector<size_t> dets_t;
-#pragma omp parallel
+    // Each thread screens its own P determinants into partitioned buffers that are merged in
+    // parallel after screening
+    const size_t nthreads = omp_get_max_threads();
+    det_accumulator<double> A_b(nthreads);
+#pragma omp parallel num_threads(nthreads)
     {
         size_t n_threads = static_cast<size_t>(omp_get_num_threads());
         size_t thread_id = static_cast<size_t>(omp_get_thread_num());
 
-#pragma omp critical
-        {
-            vec_A_b_t.resize(n_threads);
-            dets_t.resize(n_threads);
-        }
-
-        std::vector<std::pair<Determinant, double>>& vec_A_b = vec_A_b_t[thread_id];
-
         size_t bin_size = n_dets / n_threads;
         bin_size += (thread_id < (n_dets % n_threads)) ? 1 : 0;
         size_t start_idx = (thread_id < (n_dets % n_threads))
@@ -1260,22 +1099,6 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                                      (thread_id - (n_dets % n_threads)) * bin_size;
         size_t end_idx = start_idx + bin_size;
 
-        // Loop over P space determinants
-        // size_t guess_a = nalpha_ * (no_ - nalpha_);
-        // size_t guess_b = nbeta_ * (no_ - nbeta_);
-        // size_t guess_aa = nalpha_ * (nalpha_ - 1) * (no_ - nalpha_) * (no_ -
-        // nalpha_ - 1) / 4; size_t guess_bb = nbeta_ * (nbeta_ - 1) * (no_ - nbeta_)
-        // * (no_ - nbeta_ - 1) / 4; size_t guess_ab = guess_a * guess_b;
-
-        // size_t guess = (n_dets / nbin) * (guess_a + guess_b + guess_aa + guess_bb +
-        // guess_ab);
-
-        size_t nocc2 = nalpha_ * nalpha_;
-        size_t nvir2 = (nmo - nalpha_) * (nmo - nalpha_);
-        size_t guess = (n_dets / nbin) * nocc2 * nvir2;
-        // outfile->Printf("\n Guessing %zu dets in bin %d", guess, bin);
-        vec_A_b.reserve(guess);
-        //        A_b.reserve(guess);
         for (size_t I = start_idx; I < end_idx; ++I) {
             double c_I = evecs->get(I, 0);
             const Determinant& det = dets[I];
@@ -1300,7 +1123,7 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                         if ((hash_val % nbin) == bin) {
                             double HIJ = as_ints_->slater_rules_single_alpha(det, ii, aa) * c_I;
                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                vec_A_b.push_back(std::make_pair(new_det, HIJ));
+                                A_b.add(thread_id, new_det, HIJ);
                             }
                         }
                         new_det.set_alfa_bit(aa, false);
@@ -1318,7 +1141,7 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                         if ((hash_val % nbin) == bin) {
                             double HIJ = as_ints_->slater_rules_single_beta(det, ii, aa) * c_I;
                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                vec_A_b.push_back(std::make_pair(new_det, HIJ));
+                                A_b.add(thread_id, new_det, HIJ);
                             }
                         }
                         new_det.set_beta_bit(aa, false);
@@ -1361,9 +1184,8 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_aa(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                vec_A_b.push_back(std::make_pair(
-                                                    new_det,
-                                                    (HIJ * det.slater_sign_aaaa(ii, jj, aa, bb))));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * det.slater_sign_aaaa(ii, jj, aa, bb));
                                             }
                                         }
                                         new_det.set_alfa_bit(bb, false);
@@ -1402,9 +1224,8 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_bb(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                vec_A_b.push_back(std::make_pair(
-                                                    new_det,
-                                                    (HIJ * det.slater_sign_bbbb(ii, jj, aa, bb))));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * det.slater_sign_bbbb(ii, jj, aa, bb));
                                             }
                                         }
                                         new_det.set_beta_bit(bb, false);
@@ -1440,9 +1261,9 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
                                         if ((hash_val % nbin) == bin) {
                                             double HIJ = as_ints_->tei_ab(ii, jj, aa, bb) * c_I;
                                             if ((std::fabs(HIJ) >= screen_thresh_)) {
-                                                vec_A_b.push_back(std::make_pair(
-                                                    new_det, (HIJ * new_det.slater_sign_aa(ii, aa) *
-                                                              new_det.slater_sign_bb(jj, bb))));
+                                                A_b.add(thread_id, new_det,
+                                                        HIJ * new_det.slater_sign_aa(ii, aa) *
+                                                            new_det.slater_sign_bb(jj, bb));
                                             }
                                         }
                                         new_det.set_beta_bit(bb, false);
@@ -1458,151 +1279,22 @@ AdaptiveCI::get_bin_F_space_vecsort(int bin, int nbin, SharedMatrix evecs,
             }
         } // end loop over reference
 
-        size_t num_new_dets = vec_A_b.size();
-
-        //        outfile->Printf("\n  Added %zu dets", A_b.size());
-        //        if( thread_id == 0 ){
-        //          outfile->Printf("\n  Time spent forming vec_A_b: %1.6f",
-        //          build.get()); outfile->Printf("\n  Generated %zu determinants out of
-        //          %zu guessed", num_new_dets, guess);
-        //      }
-
-        // Sort the determinant contributions
-        local_timer F_sort;
-        //        std::sort(vec_A_b.begin(), vec_A_b.begin() + num_new_dets);
-
-        std::sort(
-            vec_A_b.begin(), vec_A_b.begin() + num_new_dets,
-            [](const std::pair<Determinant, double>& a,
-               const std::pair<Determinant, double>& b) -> bool { return a.first < b.first; });
-        // if( thread_id == 0 ){
-        //    outfile->Printf("\n  Time spent sorting vec_A_b: %1.6f", F_sort.get());
-        //}
-        //        for (size_t i = 0; i < num_new_dets; i++){
-        //            auto& p = vec_A_b[i];
-        //            outfile->Printf("\n%s %20.12f",p.first.str().c_str(),p.second);
-        //          }
-
-        // Combine identical contributions by looping over all elements
-        local_timer Combine;
-        Determinant d = vec_A_b[0].first;
-        double sum = 0.0;
-        size_t pos = 0;
-        for (size_t I = 0; I < num_new_dets; I++) {
-            const Determinant& dI = vec_A_b[I].first;
-            const double val = vec_A_b[I].second;
-            if (dI == d) {
-                sum += val;
-            } else {
-                vec_A_b[pos] = std::make_pair(d, sum);
-                sum = val;
-                pos += 1;
-                d = dI;
-            }
-        }
-        vec_A_b[pos] = std::make_pair(d, sum);
-        pos += (pos == 0) ? 0 : 1;
-
-        //   #pragma omp critical
-        //   outfile->Printf("\n  Time spent combining unique elements of vec_A_b:
-        //   %1.6f",
-        //                   Combine.get());
-
-        // store the number of unique determinants
-        dets_t[thread_id] = pos;
-
         if (thread_id == 0)
             outfile->Printf("\n  Build: %1.6f", build.get());
-
-        local_timer merge;
-
-        std::vector<Determinant> sorted_dets(dets.size());
-        for (const Determinant& det : dets) {
-            sorted_dets.push_back(det);
-        }
-        std::sort(sorted_dets.begin(), sorted_dets.end());
-
-        // Remove duplicates and merge
-        //  #pragma omp critical
-        //  {
-
-        size_t ref_size = sorted_dets.size();
-        size_t ref_pos = 0;
-        size_t det_size = pos;
-        size_t det_pos = 0;
-
-        Determinant ref_head = sorted_dets[0];
-        Determinant det_head = vec_A_b[0].first;
-        // run through the vectors
-        while ((ref_pos < ref_size) and (det_pos < det_size)) {
-            det_head = vec_A_b[det_pos].first;
-            ref_head = sorted_dets[ref_pos];
-            if (det_head < ref_head) {
-                //                    bin_f_space[det_head] += vec_A_b[det_pos].second;
-                det_pos += 1;
-            } else if (ref_head < det_head) {
-                ref_pos += 1;
-            } else {
-                // found a match
-                vec_A_b[det_pos].second = 0.0;
-                det_pos += 1;
-                ref_pos += 1;
-            }
-        }
-
-        //            for (size_t I = det_pos; I < det_size; I++) {
-        //                bin_f_space[vec_A_b[I].first] += vec_A_b[I].second;
-        //            }
-        //     }
-
-        if (thread_id == 0)
-            outfile->Printf("\n  Merge: %1.6f", merge.get());
     } // close threads
 
-    // Account for duplicates between threads by adding
-    // to thread 0, and zeroing other threads
-    local_timer merget;
-    int ntd = vec_A_b_t.size();
-    if (ntd > 1) {
-        // auto& vec_ref = vec_A_b_t[0];
-        // for( int td = 1; td < ntd; ++td ){
-        for (int td1 = 0; td1 < ntd; ++td1) {
-            auto& vec_ref = vec_A_b_t[td1];
-            for (int td2 = td1 + 1; td2 < ntd; ++td2) {
-
-                auto& vec_td = vec_A_b_t[td2];
-
-                size_t ref_size = vec_ref.size();
-                size_t ref_pos = 0;
-                size_t td_size = vec_td.size();
-                size_t td_pos = 0;
-
-                Determinant ref_head = vec_ref[0].first;
-                Determinant td_head = vec_td[0].first;
-                // run through the vectors
-                while ((ref_pos < ref_size) and (td_pos < td_size)) {
-                    ref_head = vec_ref[ref_pos].first;
-                    td_head = vec_td[td_pos].first;
-                    if (ref_head < td_head) {
-                        ref_pos += 1;
-                    } else if (td_head < ref_head) {
-                        td_pos += 1;
-                    } else {
-                        // found a match
-                        double& V = vec_td[td_pos].second;
-
-                        vec_ref[ref_pos].second += V;
-                        // vec_td[ref_pos].second = 0;
-                        V = 0.0;
-                        td_pos += 1;
-                        ref_pos += 1;
-                    }
-                }
-            }
-        }
+    local_timer merge;
+    A_b.merge();
+
+    // Remove the P space determinants
+    for (det_hashvec::iterator it = dets.begin(), endit = dets.end(); it != endit; ++it) {
+        A_b.erase(*it);
     }
-    outfile->Printf("\n  Inter-thread merge: %1.6f", merget.get());
-    return std::make_pair(vec_A_b_t, dets_t);
+
+    std::vector<std::pair<Determinant, double>> vec_A_b(A_b.size());
+    A_b.for_each([&](size_t n, const Determinant& det, double V) { vec_A_b[n] = {det, V}; });
+    outfile->Printf("\n  Merge: %1.6f", merge.get());
+    return vec_A_b;
 }
 
 /*
@@ -17,6 +17,7 @@
 #include "helpers/printing.h"
 #include "helpers/string_algorithms.h"
 #include "sparse_ci/ci_reference.h"
+#include "sparse_ci/complementary_overlap.h"
 #include "detci.h"
 
 using namespace psi;
@@ -78,6 +79,7 @@ double DETCI::compute_energy() {
 
     // build determinants
     build_determinant_space();
+    complementary_overlap_.reset();
 
     // diagonalize Hamiltonian
     diagonalize_hamiltonian();
@@ -313,6 +315,26 @@ void DETCI::print_ci_wfn() {
     }
 }
 
+std::vector<double> DETCI::compute_complementary_H2caa_overlap(const std::vector<size_t>& roots,
+                                                               ambit::Tensor Tbra,
+                                                               ambit::Tensor Tket) {
+    timer t("DETCI complementary overlap");
+    // the couplings are built once for the determinant space and reused by later calls
+    if (complementary_overlap_ == nullptr) {
+        complementary_overlap_ = std::make_shared<ComplementaryOverlap>(
+            nactv_, p_space_.determinants(), psi::Process::environment.get_memory() / 4);
+    }
+    const size_t ndets = p_space_.size();
+    std::vector<std::vector<double>> evecs;
+    for (size_t root : roots) {
+        auto& evec = evecs.emplace_back(ndets);
+        for (size_t I = 0; I < ndets; ++I) {
+            evec[I] = evecs_->get(I, root);
+        }
+    }
+    return complementary_overlap_->compute(evecs, Tbra.dim(0), Tbra.data(), Tket.data());
+}
+
 void DETCI::dump_wave_function(const std::string& filename) {
     timer t_dump("Dump DETCI WFN");
     std::ofstream file(filename);
@@ -41,6 +41,8 @@
 #include "sparse_ci/sigma_vector.h"
 
 namespace forte {
+class ComplementaryOverlap;
+
 class DETCI : public ActiveSpaceMethod {
   public:
     /**
@@ -98,6 +100,12 @@ class DETCI : public ActiveSpaceMethod {
     /// Return the number of determinants
     size_t space_size() override { return p_space_.size(); }
 
+    /// Compute the overlap of two wave functions acted by complementary operators (see
+    /// ActiveSpaceMethod) without forming the 3-RDM
+    std::vector<double> compute_complementary_H2caa_overlap(const std::vector<size_t>& roots,
+                                                            ambit::Tensor Tbra,
+                                                            ambit::Tensor Tket) override;
+
     /// Return the eigen vector in ambit Tensor format
     std::vector<ambit::Tensor> eigenvectors() override;
 
@@ -125,6 +133,8 @@ class DETCI : public ActiveSpaceMethod {
     DeterminantHashVec p_space_;
     /// Build determinant space
     void build_determinant_space();
+    /// The couplings used to compute the complementary overlaps (built on the first call)
+    std::shared_ptr<ComplementaryOverlap> complementary_overlap_;
 
     /// State label
     std::string state_label_;
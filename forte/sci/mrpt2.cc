@@ -27,7 +27,12 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
 
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libmints/vector.h"
@@ -58,6 +63,19 @@ MRPT2::MRPT2(std::shared_ptr<ForteOptions> options, std::shared_ptr<ActiveSpaceI
     //    print_method_banner(
     //        {"Deterministic MR-PT2", "Jeff Schriber"});
     mo_symmetry_ = mo_space_info_->symmetry("ACTIVE");
+
+    pt2_algorithm_ = options_->get_str("PT2_ALGORITHM");
+    deterministic_size_ = std::max(options_->get_int("PT2_DETERMINISTIC_SIZE"), 0);
+    stochastic_samples_ = std::max(options_->get_int("PT2_STOCHASTIC_SAMPLES"), 0);
+    stochastic_error_ = options_->get_double("PT2_STOCHASTIC_ERROR");
+    stochastic_max_batches_ = std::max(options_->get_int("PT2_STOCHASTIC_MAX_BATCHES"), 0);
+    stochastic_seed_ = options_->get_int("PT2_STOCHASTIC_SEED");
+    if (pt2_algorithm_ == "SEMISTOCHASTIC") {
+        if (stochastic_samples_ < 2)
+            throw std::runtime_error("MRPT2: PT2_STOCHASTIC_SAMPLES must be at least 2.");
+        if (stochastic_max_batches_ < 2)
+            throw std::runtime_error("MRPT2: PT2_STOCHASTIC_MAX_BATCHES must be at least 2.");
+    }
 }
 
 MRPT2::~MRPT2() {}
@@ -69,8 +87,18 @@ std::vector<double> MRPT2::compute_energy() {
     std::vector<double> pt2_en;
 
     local_timer en;
+    if (pt2_algorithm_ == "SEMISTOCHASTIC") {
+        for (int n = 0; n < nroot_; ++n) {
+            pt2_en.push_back(compute_pt2_energy_semistochastic(n));
+        }
+    } else {
+        std::vector<int> roots(nroot_);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::vector<size_t> ref_dets(reference_.size());
+        std::iota(ref_dets.begin(), ref_dets.end(), 0);
+        pt2_en = compute_pt2_energy(roots, ref_dets);
+    }
     for (int n = 0; n < nroot_; ++n) {
-        pt2_en.push_back(compute_pt2_energy(n));
         outfile->Printf("\n  Root %d PT2 energy:  %1.12f", n, pt2_en[n]);
     }
     //  double scalar = as_ints_->scalar_energy() + molecule_->nuclear_repulsion_energy();
@@ -81,18 +109,21 @@ std::vector<double> MRPT2::compute_energy() {
     return pt2_en;
 }
 
-double MRPT2::compute_pt2_energy(int root) {
-    double energy = 0.0;
-    const size_t n_dets = reference_.size();
+std::vector<double> MRPT2::compute_pt2_energy(const std::vector<int>& roots,
+                                              const std::vector<size_t>& ref_dets) {
+    const size_t nr = roots.size();
+    std::vector<double> energy(nr, 0.0);
+    const size_t n_dets = ref_dets.size();
     int nmo = as_ints_->nmo();
     double max_mem = options_->get_double("PT2_MAX_MEM");
 
-    size_t guess_size = n_dets * nmo * nmo;
+    // each excited determinant stores one numerator per root
+    size_t guess_size = n_dets * nmo * nmo * nr;
     double nbyte = (1073741824 * max_mem) / (sizeof(double));
 
     int nbin = static_cast<int>(std::ceil(guess_size / (nbyte)));
 
-#pragma omp parallel reduction(+ : energy)
+#pragma omp parallel
     {
         int tid = omp_get_thread_num();
         int ntds = omp_get_num_threads();
@@ -113,178 +144,329 @@ double MRPT2::compute_pt2_energy(int root) {
                             : (nbin % ntds) * (batch_size + 1) + (tid - (nbin % ntds)) * batch_size;
         int end_idx = start_idx + batch_size;
 
+        std::vector<double> thread_energy(nr, 0.0);
         for (int bin = start_idx; bin < end_idx; ++bin) {
-            energy += energy_kernel(bin, nbin, root);
+            std::vector<double> bin_energy = energy_kernel(bin, nbin, roots, ref_dets);
+            for (size_t r = 0; r < nr; ++r) {
+                thread_energy[r] += bin_energy[r];
+            }
+        }
+#pragma omp critical
+        {
+            for (size_t r = 0; r < nr; ++r) {
+                energy[r] += thread_energy[r];
+            }
         }
     }
     return energy;
 }
 
-double MRPT2::energy_kernel(int bin, int nbin, int root) {
-    size_t nact = mo_space_info_->size("ACTIVE");
-    double E_0 = evals_->get(root);
-    double energy = 0.0;
-    const size_t n_dets = reference_.size();
+std::vector<double> MRPT2::energy_kernel(int bin, int nbin, const std::vector<int>& roots,
+                                         const std::vector<size_t>& ref_dets) {
+    const size_t nr = roots.size();
+    std::vector<double> E_0(nr);
+    for (size_t r = 0; r < nr; ++r) {
+        E_0[r] = evals_->get(roots[r]);
+    }
+    std::vector<double> energy(nr, 0.0);
     const det_hashvec& dets = reference_.wfn_hash();
-    det_hash<double> A_I;
+
+    // Maps each excited determinant to its numerators A[J * nr + r] = sum_I H_JI c_I^r
+    det_hash<size_t> ext_index;
+    std::vector<double> A;
+
+    // Check if the determinant goes in this bin
+    auto in_bin = [&](const Determinant& new_det) {
+        return (Determinant::Hash()(new_det) % nbin) == static_cast<size_t>(bin);
+    };
+
+    std::vector<double> c_I(nr);
+    for (size_t I : ref_dets) {
+        for (size_t r = 0; r < nr; ++r) {
+            c_I[r] = evecs_->get(I, roots[r]);
+        }
+        for_each_external(dets[I], in_bin, [&](const Determinant& new_det, double H_JI) {
+            auto [it, inserted] = ext_index.try_emplace(new_det, ext_index.size());
+            if (inserted) {
+                A.resize(A.size() + nr, 0.0);
+            }
+            double* A_J = &A[it->second * nr];
+            for (size_t r = 0; r < nr; ++r) {
+                A_J[r] += H_JI * c_I[r];
+            }
+        });
+    }
+
+    for (const auto& [det, J] : ext_index) {
+        double H_JJ = as_ints_->energy(det);
+        const double* A_J = &A[J * nr];
+        for (size_t r = 0; r < nr; ++r) {
+            energy[r] += (A_J[r] * A_J[r]) / (E_0[r] - H_JJ);
+        }
+    }
+    return energy;
+}
+
+// The semistochastic algorithm follows Sharma, Holmes, Jeanmairet, Alavi, and Umrigar,
+// J. Chem. Theory Comput. 13, 1595 (2017). The reference is split into a deterministic part (P),
+// which contains the determinants with the largest coefficients, and a stochastic part (Q).
+// The PT2 correction is written as E2 = E2[P] + (E2[P+Q] - E2[P]), where E2[P] is computed
+// exactly and the difference is estimated from batches of reference determinants sampled with
+// replacement with probability p_I = |c_I| / sum_J |c_J|. For a batch of N samples in which I is
+// drawn w_I times, the difference is estimated without bias as
+//
+//   e = 1 / (N (N - 1)) sum_a [2 S_P(a) S_Q(a) + S_Q(a)^2 - Q2(a)] / (E_0 - H_aa)
+//
+// with S_X(a) = sum_{I in X} w_I H_aI c_I / p_I and Q2(a) = sum_{I in Q} w_I (H_aI c_I / p_I)^2.
+// The estimate of each batch depends only on the seed and the batch index, so the result does not
+// depend on the number of threads.
+
+double MRPT2::compute_pt2_energy_semistochastic(int root) {
+    // Batches are run in rounds, after which the error is checked
+    constexpr size_t batches_per_round = 16;
+
+    const size_t n_dets = reference_.size();
+
+    // Sort the reference determinants by the magnitude of their coefficient
+    std::vector<size_t> ref_dets(n_dets);
+    std::iota(ref_dets.begin(), ref_dets.end(), 0);
+    std::stable_sort(ref_dets.begin(), ref_dets.end(), [&](size_t I, size_t J) {
+        return std::fabs(evecs_->get(I, root)) > std::fabs(evecs_->get(J, root));
+    });
+    ref_dets.resize(std::min(deterministic_size_, n_dets));
+
+    outfile->Printf("\n\n  Semistochastic PT2 for root %d", root);
+    outfile->Printf("\n  Deterministic reference determinants:  %zu", ref_dets.size());
+
+    local_timer det_timer;
+    double e_det = compute_pt2_energy({root}, ref_dets)[0];
+    outfile->Printf("\n  Deterministic PT2 energy:  %1.12f (%1.3f s)", e_det, det_timer.get());
+
+    // When the deterministic space spans the reference the result is exact
+    if (ref_dets.size() == n_dets) {
+        return e_det;
+    }
+
+    std::vector<bool> deterministic(n_dets, false);
+    for (size_t I : ref_dets) {
+        deterministic[I] = true;
+    }
+    std::vector<double> cumulative_weight(n_dets);
+    double sum = 0.0;
     for (size_t I = 0; I < n_dets; ++I) {
+        sum += std::fabs(evecs_->get(I, root));
+        cumulative_weight[I] = sum;
+    }
+
+    outfile->Printf("\n  Samples per batch:  %zu", stochastic_samples_);
+    outfile->Printf("\n  Target error:       %.3e Eh", stochastic_error_);
+    outfile->Printf("\n\n    Batches     Stochastic PT2    Std. error     Time (s)");
+    outfile->Printf("\n  ---------------------------------------------------------");
+
+    local_timer st_timer;
+    std::vector<double> e_batch;
+    double mean = 0.0;
+    double error = 0.0;
+    while (e_batch.size() < stochastic_max_batches_) {
+        size_t first = e_batch.size();
+        size_t last = std::min(first + batches_per_round, stochastic_max_batches_);
+        e_batch.resize(last);
+
+#pragma omp parallel for schedule(dynamic)
+        for (size_t b = first; b < last; ++b) {
+            e_batch[b] = stochastic_batch(root, b, cumulative_weight, deterministic);
+        }
+
+        const double nb = static_cast<double>(e_batch.size());
+        mean = std::accumulate(e_batch.begin(), e_batch.end(), 0.0) / nb;
+        double var = 0.0;
+        for (double e : e_batch) {
+            var += (e - mean) * (e - mean);
+        }
+        error = e_batch.size() > 1 ? std::sqrt(var / (nb * (nb - 1.0))) : 0.0;
+
+        outfile->Printf("\n    %7zu  %17.12f  %12.3e  %11.3f", e_batch.size(), mean, error,
+                        st_timer.get());
+        if (e_batch.size() > 1 and error < stochastic_error_) {
+            break;
+        }
+    }
+    outfile->Printf("\n  ---------------------------------------------------------");
+    if (error >= stochastic_error_) {
+        outfile->Printf("\n  Warning: the stochastic PT2 error did not reach the target value.");
+    }
+    outfile->Printf("\n  Semistochastic PT2 energy:  %1.12f +/- %.3e Eh", e_det + mean, error);
+
+    return e_det + mean;
+}
+
+double MRPT2::stochastic_batch(int root, size_t batch, const std::vector<double>& cumulative_weight,
+                               const std::vector<bool>& deterministic) {
+    const size_t n_dets = cumulative_weight.size();
+    const double total_weight = cumulative_weight.back();
+    const double N = static_cast<double>(stochastic_samples_);
+    double E_0 = evals_->get(root);
+
+    // Sample the reference determinants with a generator seeded only by the seed and the batch
+    std::seed_seq seq{static_cast<uint64_t>(stochastic_seed_), static_cast<uint64_t>(batch)};
+    std::mt19937_64 gen(seq);
+    std::vector<size_t> samples(stochastic_samples_);
+    for (auto& I : samples) {
+        // a uniform number in [0, total_weight) from the 53 high bits of the generator
+        double u = std::ldexp(static_cast<double>(gen() >> 11), -53) * total_weight;
+        I = std::upper_bound(cumulative_weight.begin(), cumulative_weight.end(), u) -
+            cumulative_weight.begin();
+        I = std::min(I, n_dets - 1);
+    }
+    // Process the Q determinants first. The P determinants only contribute to the determinants
+    // connected to Q, so they do not add new elements to the hash
+    std::sort(samples.begin(), samples.end(), [&](size_t I, size_t J) {
+        return deterministic[I] != deterministic[J] ? deterministic[J] : I < J;
+    });
+
+    const det_hashvec& dets = reference_.wfn_hash();
+    // For each external determinant stores S_P, S_Q, and Q2
+    det_hash<std::array<double, 3>> S;
+    auto accept_all = [](const Determinant&) { return true; };
+    for (size_t s = 0; s < samples.size();) {
+        const size_t I = samples[s];
+        size_t w = 0;
+        for (; s < samples.size() and samples[s] == I; ++s) {
+            ++w;
+        }
         double c_I = evecs_->get(I, root);
-        const Determinant& det = dets[I];
-        std::vector<int> aocc = det.get_alfa_occ(nact);
-        std::vector<int> bocc = det.get_beta_occ(nact);
-        std::vector<int> avir = det.get_alfa_vir(nact);
-        std::vector<int> bvir = det.get_beta_vir(nact);
-
-        int noalpha = aocc.size();
-        int nobeta = bocc.size();
-        int nvalpha = avir.size();
-        int nvbeta = bvir.size();
-        Determinant new_det(det);
-
-        // Generate alpha excitations
-        for (int i = 0; i < noalpha; ++i) {
-            int ii = aocc[i];
-            for (int a = 0; a < nvalpha; ++a) {
-                int aa = avir[a];
-                if ((mo_symmetry_[ii] ^ mo_symmetry_[aa]) == 0) {
-                    new_det = det;
-                    new_det.set_alfa_bit(ii, false);
-                    new_det.set_alfa_bit(aa, true);
-                    if (reference_.has_det(new_det))
-                        continue;
-
-                    // Check if the determinant goes in this bin
-                    size_t hash_val = Determinant::Hash()(new_det);
-                    if ((hash_val % nbin) == bin) {
-                        double coupling =
-                            as_ints_->slater_rules_single_alpha(new_det, ii, aa) * c_I;
-                        if (A_I.find(new_det) != A_I.end()) {
-                            coupling += A_I[new_det];
-                        }
-                        A_I[new_det] = coupling;
-                    }
+        double c_I_p = c_I * total_weight / std::fabs(c_I);
+        if (deterministic[I]) {
+            for_each_external(dets[I], accept_all, [&](const Determinant& new_det, double H_JI) {
+                auto it = S.find(new_det);
+                if (it != S.end()) {
+                    it->second[0] += w * H_JI * c_I_p;
                 }
+            });
+        } else {
+            for_each_external(dets[I], accept_all, [&](const Determinant& new_det, double H_JI) {
+                auto& S_a = S[new_det];
+                double V = H_JI * c_I_p;
+                S_a[1] += w * V;
+                S_a[2] += w * V * V;
+            });
+        }
+    }
+
+    double energy = 0.0;
+    for (const auto& [det, S_a] : S) {
+        double num = 2.0 * S_a[0] * S_a[1] + S_a[1] * S_a[1] - S_a[2];
+        energy += num / (E_0 - as_ints_->energy(det));
+    }
+    return energy / (N * (N - 1.0));
+}
+
+template <class Accept, class Add>
+void MRPT2::for_each_external(const Determinant& det, Accept accept, Add add) const {
+    size_t nact = mo_space_info_->size("ACTIVE");
+    std::vector<int> aocc = det.get_alfa_occ(nact);
+    std::vector<int> bocc = det.get_beta_occ(nact);
+    std::vector<int> avir = det.get_alfa_vir(nact);
+    std::vector<int> bvir = det.get_beta_vir(nact);
+
+    int noalpha = aocc.size();
+    int nobeta = bocc.size();
+    int nvalpha = avir.size();
+    int nvbeta = bvir.size();
+    Determinant new_det(det);
+
+    // Generate alpha excitations
+    for (int i = 0; i < noalpha; ++i) {
+        int ii = aocc[i];
+        for (int a = 0; a < nvalpha; ++a) {
+            int aa = avir[a];
+            if ((mo_symmetry_[ii] ^ mo_symmetry_[aa]) == 0) {
+                new_det = det;
+                new_det.set_alfa_bit(ii, false);
+                new_det.set_alfa_bit(aa, true);
+                if (reference_.has_det(new_det) or not accept(new_det))
+                    continue;
+                add(new_det, as_ints_->slater_rules_single_alpha(new_det, ii, aa));
             }
         }
-        // Generate beta excitations
-        for (int i = 0; i < nobeta; ++i) {
-            int ii = bocc[i];
-            for (int a = 0; a < nvbeta; ++a) {
-                int aa = bvir[a];
-                if ((mo_symmetry_[ii] ^ mo_symmetry_[aa]) == 0) {
-                    new_det = det;
-                    new_det.set_beta_bit(ii, false);
-                    new_det.set_beta_bit(aa, true);
-                    if (reference_.has_det(new_det))
-                        continue;
-                    // Check if the determinant goes in this bin
-                    size_t hash_val = Determinant::Hash()(new_det);
-                    if ((hash_val % nbin) == bin) {
-                        double coupling = as_ints_->slater_rules_single_beta(new_det, ii, aa) * c_I;
-                        if (A_I.find(new_det) != A_I.end()) {
-                            coupling += A_I[new_det];
-                        }
-                        A_I[new_det] = coupling;
-                    }
-                }
+    }
+    // Generate beta excitations
+    for (int i = 0; i < nobeta; ++i) {
+        int ii = bocc[i];
+        for (int a = 0; a < nvbeta; ++a) {
+            int aa = bvir[a];
+            if ((mo_symmetry_[ii] ^ mo_symmetry_[aa]) == 0) {
+                new_det = det;
+                new_det.set_beta_bit(ii, false);
+                new_det.set_beta_bit(aa, true);
+                if (reference_.has_det(new_det) or not accept(new_det))
+                    continue;
+                add(new_det, as_ints_->slater_rules_single_beta(new_det, ii, aa));
             }
         }
-        // Generate ab excitations
-        for (int i = 0; i < noalpha; ++i) {
-            int ii = aocc[i];
-            for (int j = 0; j < nobeta; ++j) {
-                int jj = bocc[j];
-                for (int a = 0; a < nvalpha; ++a) {
-                    int aa = avir[a];
-                    for (int b = 0; b < nvbeta; ++b) {
-                        int bb = bvir[b];
-                        if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
-                             mo_symmetry_[bb]) == 0) {
-                            new_det = det;
-                            double sign = new_det.double_excitation_ab(ii, jj, aa, bb);
-                            if (reference_.has_det(new_det))
-                                continue;
-
-                            // Check if the determinant goes in this bin
-                            size_t hash_val = Determinant::Hash()(new_det);
-                            if ((hash_val % nbin) == bin) {
-
-                                double coupling = sign * c_I * as_ints_->tei_ab(ii, jj, aa, bb);
-                                if (A_I.find(new_det) != A_I.end()) {
-                                    coupling += A_I[new_det];
-                                }
-                                A_I[new_det] = coupling;
-                            }
-                        }
+    }
+    // Generate ab excitations
+    for (int i = 0; i < noalpha; ++i) {
+        int ii = aocc[i];
+        for (int j = 0; j < nobeta; ++j) {
+            int jj = bocc[j];
+            for (int a = 0; a < nvalpha; ++a) {
+                int aa = avir[a];
+                for (int b = 0; b < nvbeta; ++b) {
+                    int bb = bvir[b];
+                    if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
+                         mo_symmetry_[bb]) == 0) {
+                        new_det = det;
+                        double sign = new_det.double_excitation_ab(ii, jj, aa, bb);
+                        if (reference_.has_det(new_det) or not accept(new_det))
+                            continue;
+                        add(new_det, sign * as_ints_->tei_ab(ii, jj, aa, bb));
                     }
                 }
             }
         }
-        // Generate aa excitations
-        for (int i = 0; i < noalpha; ++i) {
-            int ii = aocc[i];
-            for (int j = i + 1; j < noalpha; ++j) {
-                int jj = aocc[j];
-                for (int a = 0; a < nvalpha; ++a) {
-                    int aa = avir[a];
-                    for (int b = a + 1; b < nvalpha; ++b) {
-                        int bb = avir[b];
-                        if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
-                             mo_symmetry_[bb]) == 0) {
-                            new_det = det;
-                            double sign = new_det.double_excitation_aa(ii, jj, aa, bb);
-                            if (reference_.has_det(new_det))
-                                continue;
-
-                            // Check if the determinant goes in this bin
-                            size_t hash_val = Determinant::Hash()(new_det);
-                            if ((hash_val % nbin) == bin) {
-                                double coupling = sign * c_I * as_ints_->tei_aa(ii, jj, aa, bb);
-                                if (A_I.find(new_det) != A_I.end()) {
-                                    coupling += A_I[new_det];
-                                }
-                                A_I[new_det] = coupling;
-                            }
-                        }
+    }
+    // Generate aa excitations
+    for (int i = 0; i < noalpha; ++i) {
+        int ii = aocc[i];
+        for (int j = i + 1; j < noalpha; ++j) {
+            int jj = aocc[j];
+            for (int a = 0; a < nvalpha; ++a) {
+                int aa = avir[a];
+                for (int b = a + 1; b < nvalpha; ++b) {
+                    int bb = avir[b];
+                    if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
+                         mo_symmetry_[bb]) == 0) {
+                        new_det = det;
+                        double sign = new_det.double_excitation_aa(ii, jj, aa, bb);
+                        if (reference_.has_det(new_det) or not accept(new_det))
+                            continue;
+                        add(new_det, sign * as_ints_->tei_aa(ii, jj, aa, bb));
                     }
                 }
             }
         }
-        // Generate bb excitations
-        for (int i = 0; i < nobeta; ++i) {
-            int ii = bocc[i];
-            for (int j = i + 1; j < nobeta; ++j) {
-                int jj = bocc[j];
-                for (int a = 0; a < nvbeta; ++a) {
-                    int aa = bvir[a];
-                    for (int b = a + 1; b < nvbeta; ++b) {
-                        int bb = bvir[b];
-                        if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
-                             mo_symmetry_[bb]) == 0) {
-                            new_det = det;
-                            double sign = new_det.double_excitation_bb(ii, jj, aa, bb);
-                            if (reference_.has_det(new_det))
-                                continue;
-
-                            // Check if the determinant goes in this bin
-                            size_t hash_val = Determinant::Hash()(new_det);
-                            if ((hash_val % nbin) == bin) {
-                                double coupling = sign * c_I * as_ints_->tei_bb(ii, jj, aa, bb);
-                                if (A_I.find(new_det) != A_I.end()) {
-                                    coupling += A_I[new_det];
-                                }
-                                A_I[new_det] = coupling;
-                            }
-                        }
+    }
+    // Generate bb excitations
+    for (int i = 0; i < nobeta; ++i) {
+        int ii = bocc[i];
+        for (int j = i + 1; j < nobeta; ++j) {
+            int jj = bocc[j];
+            for (int a = 0; a < nvbeta; ++a) {
+                int aa = bvir[a];
+                for (int b = a + 1; b < nvbeta; ++b) {
+                    int bb = bvir[b];
+                    if ((mo_symmetry_[ii] ^ mo_symmetry_[jj] ^ mo_symmetry_[aa] ^
+                         mo_symmetry_[bb]) == 0) {
+                        new_det = det;
+                        double sign = new_det.double_excitation_bb(ii, jj, aa, bb);
+                        if (reference_.has_det(new_det) or not accept(new_det))
+                            continue;
+                        add(new_det, sign * as_ints_->tei_bb(ii, jj, aa, bb));
                     }
                 }
             }
         }
     }
-
-    for (auto& det : A_I) {
-        energy += (det.second * det.second) / (E_0 - as_ints_->energy(det.first));
-    }
-    return energy;
 }
 } // namespace forte
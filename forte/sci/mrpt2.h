@@ -71,10 +71,38 @@ class MRPT2 {
     // Number of reference roots
     int nroot_;
 
-    // Computes the total energy correction for a given root
-    double compute_pt2_energy(int root);
-    // Computes the energy contribution from a subset of excited
-    // determinants
-    double energy_kernel(int bin, int nbin, int root);
+    // The PT2 algorithm (DETERMINISTIC or SEMISTOCHASTIC)
+    std::string pt2_algorithm_;
+    // Number of reference determinants treated deterministically in the semistochastic algorithm
+    size_t deterministic_size_;
+    // Number of reference determinants sampled in each stochastic batch
+    size_t stochastic_samples_;
+    // Target standard error of the semistochastic energy
+    double stochastic_error_;
+    // Maximum number of stochastic batches
+    size_t stochastic_max_batches_;
+    // Seed of the random number generator
+    int stochastic_seed_;
+
+    // Computes the energy correction of a list of roots from the determinants connected to a
+    // subset of the reference determinants (given by their index in reference_)
+    std::vector<double> compute_pt2_energy(const std::vector<int>& roots,
+                                           const std::vector<size_t>& ref_dets);
+    // Computes the energy contribution of a list of roots from a subset of excited
+    // determinants. The excited determinants are generated once for all roots
+    std::vector<double> energy_kernel(int bin, int nbin, const std::vector<int>& roots,
+                                      const std::vector<size_t>& ref_dets);
+
+    // Computes the energy correction for a given root with the semistochastic algorithm
+    double compute_pt2_energy_semistochastic(int root);
+    // Computes the stochastic estimate of the energy correction not included in the
+    // deterministic part from one batch of sampled reference determinants
+    double stochastic_batch(int root, size_t batch, const std::vector<double>& cumulative_weight,
+                            const std::vector<bool>& deterministic);
+
+    // Calls add(new_det, H_{new_det,det}) for all the singles and doubles of det that are not in
+    // the reference and for which accept(new_det) is true
+    template <class Accept, class Add>
+    void for_each_external(const Determinant& det, Accept accept, Add add) const;
 };
 } // namespace forte
@@ -44,12 +44,6 @@
 
 using namespace psi;
 
-/* CHEEV prototype */
-extern "C" {
-extern void zheev(char* jobz, char* uplo, int* n, std::complex<double>* a, int* lda, double* w,
-                  std::complex<double>* work, int* lwork, double* rwork, int* info);
-}
-
 namespace forte {
 
 TDCI::TDCI(std::shared_ptr<ActiveSpaceMethod> active_space_method,
@@ -73,7 +67,8 @@ double TDCI::compute_energy() {
     std::string propagate_type = options_->get_str("TDCI_PROPAGATOR");
 
     if ((propagate_type == "EXACT_SELECT") or (propagate_type == "RK4_SELECT") or
-        (propagate_type == "RK4_LIST") or (propagate_type == "RK4_SELECT_LIST")) {
+        (propagate_type == "RK4_LIST") or (propagate_type == "RK4_SELECT_LIST") or
+        (propagate_type == "RK4") or (propagate_type == "LANCZOS")) {
 
         build_full_H = false;
     }
@@ -107,10 +102,11 @@ double TDCI::compute_energy() {
     size_t nann = ann_dets_.size();
     outfile->Printf("\n  Number of cationic determinants: %zu", ann_dets_.size());
 
-    // 3. Build the full n-1 Hamiltonian if not screening
-    std::vector<std::string> det_str(nann);
-    SharedMatrix full_aH = std::make_shared<psi::Matrix>("aH", nann, nann);
+    // 3. Build the full n-1 Hamiltonian if not screening (left null otherwise)
+    SharedMatrix full_aH;
     if (build_full_H) {
+        std::vector<std::string> det_str(nann);
+        full_aH = std::make_shared<psi::Matrix>("aH", nann, nann);
         for (size_t I = 0; I < nann; ++I) {
             Determinant detI = ann_dets_.get_det(I);
             det_str[I] = str(detI, nact).c_str();
@@ -151,6 +147,15 @@ double TDCI::compute_energy() {
     norm = 1.0 / norm;
     core_coeffs->scale(norm);
 
+    // The matrix-free propagators apply H through sigma builds
+    std::shared_ptr<SigmaVector> sigma_vector;
+    if ((propagate_type == "RK4") or (propagate_type == "LANCZOS") or (propagate_type == "ALL")) {
+        auto sigma_vector_type = string_to_sigma_vector_type(options_->get_str("DIAG_ALGORITHM"));
+        sigma_vector = make_sigma_vector(ann_dets_, as_ints_,
+                                         options_->get_int("SIGMA_VECTOR_MAX_MEMORY"),
+                                         sigma_vector_type);
+    }
+
     outfile->Printf("\n  Using %s propagator", propagate_type.c_str());
     // 5. Propagate
     if (propagate_type == "EXACT") {
@@ -164,11 +169,11 @@ double TDCI::compute_energy() {
     } else if (propagate_type == "QUADRATIC") {
         propagate_taylor2(core_coeffs, full_aH);
     } else if (propagate_type == "RK4") {
-        propagate_RK4(core_coeffs, full_aH);
+        propagate_RK4(core_coeffs, sigma_vector);
     } else if (propagate_type == "RK4_LIST") {
         propagate_list(core_coeffs);
     } else if (propagate_type == "LANCZOS") {
-        propagate_lanczos(core_coeffs, full_aH);
+        propagate_lanczos(core_coeffs, sigma_vector);
     } else if (propagate_type == "EXACT_SELECT" or propagate_type == "RK4_SELECT" or
                propagate_type == "RK4_SELECT_LIST") {
         compute_tdci_select(core_coeffs);
@@ -177,9 +182,9 @@ double TDCI::compute_energy() {
         propagate_cn(core_coeffs, full_aH);
         propagate_taylor1(core_coeffs, full_aH);
         propagate_taylor2(core_coeffs, full_aH);
-        propagate_RK4(core_coeffs, full_aH);
+        propagate_RK4(core_coeffs, sigma_vector);
         propagate_QCN(core_coeffs, full_aH);
-        propagate_lanczos(core_coeffs, full_aH);
+        propagate_lanczos(core_coeffs, sigma_vector);
     }
 
     if (options_->get_bool("TDCI_TEST_OCC")) {
@@ -612,7 +617,8 @@ void TDCI::propagate_taylor2(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
     outfile->Printf("\n  Time spent propagating (quadratic): %1.6f", t2.get());
 }
 
-void TDCI::propagate_RK4(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
+void TDCI::propagate_RK4(std::shared_ptr<psi::Vector> C0,
+                         std::shared_ptr<SigmaVector> sigma_vector) {
 
     outfile->Printf("\n  Propogating with 4th order Runge-Kutta algorithm");
 
@@ -627,125 +633,47 @@ void TDCI::propagate_RK4(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
 
     std::vector<int> orbs = options_->get_int_list("TDCI_OCC_ORB");
     occupations_.resize(orbs.size());
-    // Copy initial state into iteratively updated vectors
-    auto ct_r = std::make_shared<Vector>("ct_R", ndet);
-    auto ct_i = std::make_shared<Vector>("ct_I", ndet);
 
-    ct_r->copy(C0->clone());
-    ct_i->zero();
+    // Copy initial state into the iteratively updated vector
+    std::vector<std::complex<double>> ct(ndet);
+    for (size_t I = 0; I < ndet; ++I) {
+        ct[I] = C0->get(I);
+    }
 
-    for (int n = 1; n <= nstep; ++n) {
+    // k_n = -i dt H c_n, where c_1 = ct, c_2 = ct + k_1 / 2, c_3 = ct + k_2 / 2, c_4 = ct + k_3
+    // ct(t + dt) = ct + (k_1 + 2 k_2 + 2 k_3 + k_4) / 6
+    const std::complex<double> idt(0.0, -dt);
+    const std::vector<double> c_next{0.5, 0.5, 1.0};
+    const std::vector<double> c_sum{1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
 
-        // k1
-        auto k1r = std::make_shared<Vector>("k1r", ndet);
-        auto k1i = std::make_shared<Vector>("k1i", ndet);
-
-        k1r->gemv(false, 1.0, *H, *ct_i, 0.0);
-        k1i->gemv(false, -1.0, *H, *ct_r, 0.0);
-
-        k1r->scale(dt);
-        k1i->scale(dt);
-
-        // k2
-        auto intr = std::make_shared<Vector>("intr", ndet);
-        auto inti = std::make_shared<Vector>("inti", ndet);
-
-        intr->copy(ct_r->clone());
-        inti->copy(ct_i->clone());
-
-        k1r->scale(0.5);
-        k1i->scale(0.5);
-        intr->add(*k1r);
-        inti->add(*k1i);
-        k1r->scale(2.0);
-        k1i->scale(2.0);
-
-        auto k2r = std::make_shared<Vector>("k2r", ndet);
-        auto k2i = std::make_shared<Vector>("k2i", ndet);
-
-        k2r->gemv(false, 1.0, *H, *inti, 0.0);
-        k2i->gemv(false, -1.0, *H, *intr, 0.0);
-        k2r->scale(dt);
-        k2i->scale(dt);
-
-        // k3
-        intr->copy(ct_r->clone());
-        inti->copy(ct_i->clone());
-
-        k2r->scale(0.5);
-        k2i->scale(0.5);
-        intr->add(*k2r);
-        inti->add(*k2i);
-        k2r->scale(2.0);
-        k2i->scale(2.0);
-
-        auto k3r = std::make_shared<Vector>("k3r", ndet);
-        auto k3i = std::make_shared<Vector>("k3i", ndet);
-
-        k3r->gemv(false, 1.0, *H, *inti, 0.0);
-        k3i->gemv(false, -1.0, *H, *intr, 0.0);
-        k3r->scale(dt);
-        k3i->scale(dt);
-
-        // k4
-        intr->copy(ct_r->clone());
-        inti->copy(ct_i->clone());
-
-        intr->add(*k3r);
-        inti->add(*k3i);
-
-        auto k4r = std::make_shared<Vector>("k4r", ndet);
-        auto k4i = std::make_shared<Vector>("k4i", ndet);
-
-        k4r->gemv(false, 1.0, *H, *inti, 0.0);
-        k4i->gemv(false, -1.0, *H, *intr, 0.0);
-        k4r->scale(dt);
-        k4i->scale(dt);
-
-        // Compile all intermediates
-
-        k1r->scale(1.0 / 6.0);
-        k2r->scale(1.0 / 3.0);
-        k3r->scale(1.0 / 3.0);
-        k4r->scale(1.0 / 6.0);
-        k1r->add(*k2r);
-        k1r->add(*k3r);
-        k1r->add(*k4r);
-        ct_r->add(*k1r);
-
-        k1i->scale(1.0 / 6.0);
-        k2i->scale(1.0 / 3.0);
-        k3i->scale(1.0 / 3.0);
-        k4i->scale(1.0 / 6.0);
-        k1i->add(*k2i);
-        k1i->add(*k3i);
-        k1i->add(*k4i);
-        ct_i->add(*k1i);
+    std::vector<std::complex<double>> c_int(ndet);
+    std::vector<std::complex<double>> c_new(ndet);
+    std::vector<std::complex<double>> Hc(ndet);
+    for (int n = 1; n <= nstep; ++n) {
+        c_int = ct;
+        c_new = ct;
+        for (int k = 0; k < 4; ++k) {
+            apply_hamiltonian(*sigma_vector, Hc, c_int);
+            const std::complex<double> f_sum = c_sum[k] * idt;
+            const std::complex<double> f_next = k < 3 ? c_next[k] * idt : 0.0;
+#pragma omp parallel for
+            for (size_t I = 0; I < ndet; ++I) {
+                c_new[I] += f_sum * Hc[I];
+                c_int[I] = ct[I] + f_next * Hc[I];
+            }
+        }
+        ct.swap(c_new);
 
         double norm = 0.0;
         for (size_t I = 0; I < ndet; ++I) {
-            double re = ct_r->get(I);
-            double im = ct_i->get(I);
-            norm += (re * re) + (im * im);
+            norm += std::norm(ct[I]);
         }
-        norm = std::sqrt(norm);
-        ct_r->scale(1.0 / norm);
-        ct_i->scale(1.0 / norm);
-
-        if (std::fabs((time / conv) - round(time / conv)) <= 1e-8) {
-            outfile->Printf("\n t = %1.3f as", time / conv);
-            if (options_->get_bool("TDCI_PRINT_WFN")) {
-                std::stringstream ss;
-                ss << std::fixed << std::setprecision(3) << time / conv;
-                save_vector(ct_r, "RK4_" + ss.str() + "_r.txt");
-                save_vector(ct_i, "RK4_" + ss.str() + "_i.txt");
-            }
-            std::vector<double> occ = compute_occupation(ct_r, ct_i, orbs);
-            for (size_t i = 0; i < orbs.size(); ++i) {
-                occupations_[i].push_back(occ[i]);
-            }
+        norm = 1.0 / std::sqrt(norm);
+        for (size_t I = 0; I < ndet; ++I) {
+            ct[I] *= norm;
         }
 
+        record_step(ct, "RK4", time, orbs);
         time += dt;
     }
     for (size_t i = 0; i < orbs.size(); ++i) {
@@ -862,7 +790,8 @@ void TDCI::propagate_QCN(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
     }
 }
 
-void TDCI::propagate_lanczos(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
+void TDCI::propagate_lanczos(std::shared_ptr<psi::Vector> C0,
+                             std::shared_ptr<SigmaVector> sigma_vector) {
 
     std::vector<int> orbs = options_->get_int_list("TDCI_OCC_ORB");
 
@@ -876,181 +805,108 @@ void TDCI::propagate_lanczos(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
     dt *= conv;
     double time = dt;
 
-    // Copy initial state into iteratively updated vectors
-    auto ct_r = std::make_shared<Vector>("ct_R", ndet);
-    auto ct_i = std::make_shared<Vector>("ct_I", ndet);
-
-    ct_r->copy(C0->clone());
-    ct_i->zero();
+    // Copy initial state into the iteratively updated vector
+    std::vector<std::complex<double>> ct(ndet);
+    for (size_t I = 0; I < ndet; ++I) {
+        ct[I] = C0->get(I);
+    }
 
     int krylov_dim = options_->get_int("TDCI_KRYLOV_DIM");
 
     occupations_.resize(orbs.size());
-    SharedMatrix Kn_r = std::make_shared<psi::Matrix>("knr", ndet, krylov_dim);
-    SharedMatrix Kn_i = std::make_shared<psi::Matrix>("kni", ndet, krylov_dim);
+    std::vector<std::vector<std::complex<double>>> Kn(
+        krylov_dim, std::vector<std::complex<double>>(ndet));
+    std::vector<std::complex<double>> wk(ndet);
     for (int N = 0; N < nstep; ++N) {
 
-        // 1. Form the Krylov subspace vectors and subspace hamiltonian simultaneously
-        // std::vector<std::pair<std::shared_ptr<psi::Vector>,std::shared_ptr<psi::Vector>>>
-        // Kn(krylov_dim);
-        Kn_r->zero();
-        Kn_i->zero();
+        // 1. Form the Krylov subspace vectors and the (real, tridiagonal) subspace Hamiltonian
+        double ct_norm = 0.0;
+        for (size_t I = 0; I < ndet; ++I) {
+            ct_norm += std::norm(ct[I]);
+        }
+        ct_norm = std::sqrt(ct_norm);
+        for (size_t I = 0; I < ndet; ++I) {
+            Kn[0][I] = ct[I] / ct_norm;
+        }
 
-        // Form the first vector
-        std::vector<std::complex<double>> Hs(krylov_dim * krylov_dim);
-        Kn_r->set_column(0, 0, ct_r);
-        Kn_i->set_column(0, 0, ct_i);
+        auto Hs = std::make_shared<psi::Matrix>("Hs", krylov_dim, krylov_dim);
+        int dim = krylov_dim;
         for (int k = 0; k < krylov_dim; ++k) {
+            apply_hamiltonian(*sigma_vector, wk, Kn[k]);
 
-            // Need to get last diagonal
-            auto wk_r = std::make_shared<Vector>("r", ndet);
-            auto wk_i = std::make_shared<Vector>("i", ndet);
-            wk_r->zero();
-            wk_i->zero();
-
-            auto qk_r = std::make_shared<Vector>("r", ndet);
-            auto qk_i = std::make_shared<Vector>("i", ndet);
-            qk_r->zero();
-            qk_i->zero();
-
-            qk_r->add(*Kn_r->get_column(0, k));
-            qk_i->add(*Kn_i->get_column(0, k));
-
-            wk_r->gemv(false, 1.0, *H, *qk_r, 0.0);
-            wk_i->gemv(false, 1.0, *H, *qk_i, 0.0);
-            // Modified Gram-Schmidt
+            // Full reorthogonalization (modified Gram-Schmidt) against the previous vectors
             for (int i = 0; i <= k; ++i) {
-                auto qi_r = std::make_shared<Vector>("r", ndet);
-                auto qi_i = std::make_shared<Vector>("i", ndet);
-                qi_r->zero();
-                qi_i->zero();
-                qi_r->add(*Kn_r->get_column(0, i));
-                qi_i->add(*Kn_i->get_column(0, i));
-
-                double hik_r = qi_r->vector_dot(*wk_r) + qi_i->vector_dot(*wk_i);
-                double hik_i = qi_i->vector_dot(*wk_r) - qi_r->vector_dot(*wk_i);
-
-                Hs[krylov_dim * i + k] = {0.0, 0.0};
-                Hs[krylov_dim * k + i] = {hik_r, hik_i};
-
-                wk_r->axpy(-1.0 * hik_r, *qi_r);
-                wk_r->axpy(1.0 * hik_i, *qi_i);
-                wk_i->axpy(-1.0 * hik_r, *qi_i);
-                wk_i->axpy(-1.0 * hik_i, *qi_r);
+                std::complex<double> hik = 0.0;
+                for (size_t I = 0; I < ndet; ++I) {
+                    hik += std::conj(Kn[i][I]) * wk[I];
+                }
+                if (i == k) {
+                    Hs->set(k, k, hik.real());
+                }
+                for (size_t I = 0; I < ndet; ++I) {
+                    wk[I] -= hik * Kn[i][I];
+                }
             }
+            if (k == krylov_dim - 1)
+                break;
 
-            double norm = 0.0;
+            double beta = 0.0;
             for (size_t I = 0; I < ndet; ++I) {
-                double re = wk_r->get(I);
-                double im = wk_i->get(I);
-                norm += re * re + im * im;
+                beta += std::norm(wk[I]);
             }
-            norm = sqrt(norm);
-            wk_r->scale(1.0 / norm);
-            wk_i->scale(1.0 / norm);
-
-            if (k < (krylov_dim - 1)) {
-                Hs[krylov_dim * (k + 1) + k] = {norm, 0.0};
-                Kn_r->set_column(0, k + 1, wk_r);
-                Kn_i->set_column(0, k + 1, wk_i);
+            beta = std::sqrt(beta);
+            // Stop if the Krylov subspace is invariant under H
+            if (beta < 1.0e-12) {
+                dim = k + 1;
+                break;
             }
-        }
-
-        // Diagonalize matrix in Krylov subspace
-        int n = krylov_dim, lda = krylov_dim, info, lwork;
-        /* Local arrays */
-        /* rwork dimension should be at least max(1,3*n-2) */
-        // double w[n], rwork[3 * n - 2];
-        std::vector<double> w(n);
-        std::vector<double> rwork(3 * n - 2);
-        lwork = 2 * n - 1;
-        std::vector<std::complex<double>> work(lwork);
-
-        char jobz = 'V';
-        char uplo = 'L';
-        zheev(&jobz, &uplo, &n, Hs.data(), &lda, w.data(), work.data(), &lwork, rwork.data(),
-              &info);
-        // Evecs are stored in Hs, let's unpack it and the energy
-
-        SharedMatrix evecs_r = std::make_shared<psi::Matrix>("er", n, n);
-        SharedMatrix evecs_i = std::make_shared<psi::Matrix>("ei", n, n);
-        auto evals = std::make_shared<Vector>("evals", n);
-        for (int i = 0; i < krylov_dim; ++i) {
-            evals->set(i, w[i]);
-            for (int j = 0; j < krylov_dim; ++j) {
-                evecs_r->set(i, j, Hs[krylov_dim * i + j].real());
-                evecs_i->set(i, j, Hs[krylov_dim * i + j].imag());
+            Hs->set(k + 1, k, beta);
+            Hs->set(k, k + 1, beta);
+            for (size_t I = 0; I < ndet; ++I) {
+                Kn[k + 1][I] = wk[I] / beta;
             }
         }
 
-        // Do the propagation
-        auto ct_int_r = std::make_shared<Vector>("ct_R", krylov_dim);
-        auto ct_int_i = std::make_shared<Vector>("ct_I", krylov_dim);
-
-        auto kd_r = std::make_shared<Vector>("ct_R", krylov_dim);
-        auto kd_i = std::make_shared<Vector>("ct_I", krylov_dim);
-        for (int i = 0; i < krylov_dim; ++i) {
-            kd_r->set(i, Kn_r->get_column(0, i)->vector_dot(*ct_r));
-            kd_r->add(i, Kn_i->get_column(0, i)->vector_dot(*ct_i));
-
-            kd_i->set(i, Kn_r->get_column(0, i)->vector_dot(*ct_i));
-            kd_i->add(i, -1.0 * Kn_i->get_column(0, i)->vector_dot(*ct_r));
+        // 2. Diagonalize the Hamiltonian in the Krylov subspace
+        auto Hs_dim = std::make_shared<psi::Matrix>("Hs", dim, dim);
+        for (int i = 0; i < dim; ++i) {
+            for (int j = 0; j < dim; ++j) {
+                Hs_dim->set(i, j, Hs->get(i, j));
+            }
         }
-
-        ct_int_r->gemv(true, 1.0, *evecs_r, *kd_r, 0.0);
-        ct_int_r->gemv(true, 1.0, *evecs_i, *kd_i, 1.0);
-
-        ct_int_i->gemv(true, 1.0, *evecs_r, *kd_i, 0.0);
-        ct_int_i->gemv(true, -1.0, *evecs_i, *kd_r, 1.0);
-
-        for (int I = 0; I < krylov_dim; ++I) {
-            double rval = ct_int_r->get(I);
-            double ival = ct_int_i->get(I);
-            double eval = evals->get(I);
-            ct_int_r->set(I, rval * std::cos(eval * dt) + ival * std::sin(eval * dt));
-            ct_int_i->set(I, ival * std::cos(eval * dt) - rval * std::sin(eval * dt));
+        auto evecs = std::make_shared<psi::Matrix>("evecs", dim, dim);
+        auto evals = std::make_shared<Vector>("evals", dim);
+        Hs_dim->diagonalize(evecs, evals);
+
+        // 3. Propagate: ct(t + dt) = Kn U exp(-i e dt) U^T e_1 (up to normalization)
+        std::vector<std::complex<double>> kd(dim, 0.0);
+        for (int j = 0; j < dim; ++j) {
+            const std::complex<double> phase =
+                std::exp(std::complex<double>(0.0, -evals->get(j) * dt)) * evecs->get(0, j);
+            for (int i = 0; i < dim; ++i) {
+                kd[i] += evecs->get(i, j) * phase;
+            }
         }
 
-        kd_r->gemv(false, 1.0, *evecs_r, *ct_int_r, 0.0);
-        kd_r->gemv(false, -1.0, *evecs_i, *ct_int_i, 1.0);
-
-        kd_i->gemv(false, 1.0, *evecs_r, *ct_int_i, 0.0);
-        kd_i->gemv(false, 1.0, *evecs_i, *ct_int_r, 1.0);
-
-        ct_r->zero();
-        ct_i->zero();
-
-        for (size_t i = 0; i < ndet; ++i) {
-            ct_r->set(i, Kn_r->get_row(0, i)->vector_dot(*kd_r));
-            ct_r->add(i, -1.0 * Kn_i->get_row(0, i)->vector_dot(*kd_i));
-
-            ct_i->set(i, Kn_r->get_row(0, i)->vector_dot(*kd_i));
-            ct_i->add(i, Kn_i->get_row(0, i)->vector_dot(*kd_r));
+#pragma omp parallel for
+        for (size_t I = 0; I < ndet; ++I) {
+            std::complex<double> value = 0.0;
+            for (int i = 0; i < dim; ++i) {
+                value += Kn[i][I] * kd[i];
+            }
+            ct[I] = value;
         }
 
         double norm = 0.0;
         for (size_t I = 0; I < ndet; ++I) {
-            double re = ct_r->get(I);
-            double im = ct_i->get(I);
-            norm += (re * re) + (im * im);
+            norm += std::norm(ct[I]);
         }
-        //  outfile->Printf("\n  norm: %1.6f", norm);
-        ct_r->scale(1.0 / sqrt(norm));
-        ct_i->scale(1.0 / sqrt(norm));
-
-        if (std::abs((time / conv) - round((time / conv))) <= 1e-8) {
-            outfile->Printf("\n  t = %1.3f as", time / conv);
-            if (options_->get_bool("TDCI_PRINT_WFN")) {
-                std::stringstream ss;
-                ss << std::fixed << std::setprecision(3) << time / conv;
-                save_vector(ct_r, "lanczos_" + ss.str() + "_r.txt");
-                save_vector(ct_i, "lanczos_" + ss.str() + "_i.txt");
-            }
-            std::vector<double> occ = compute_occupation(ct_r, ct_i, orbs);
-            for (size_t i = 0; i < orbs.size(); ++i) {
-                occupations_[i].push_back(occ[i]);
-            }
+        norm = 1.0 / std::sqrt(norm);
+        for (size_t I = 0; I < ndet; ++I) {
+            ct[I] *= norm;
         }
+
+        record_step(ct, "lanczos", time, orbs);
         time += dt;
     }
     for (size_t i = 0; i < orbs.size(); ++i) {
@@ -1060,6 +916,38 @@ void TDCI::propagate_lanczos(std::shared_ptr<psi::Vector> C0, SharedMatrix H) {
     outfile->Printf("\n  Time spent propagating (Lanzcos): %1.6f", total.get());
 }
 
+void TDCI::apply_hamiltonian(SigmaVector& sigma_vector, std::vector<std::complex<double>>& sigma,
+                             std::vector<std::complex<double>>& c) {
+    // H is real, so the real and imaginary parts are treated as a block of two vectors
+    std::span<double> sigma_block(reinterpret_cast<double*>(sigma.data()), 2 * sigma.size());
+    std::span<double> c_block(reinterpret_cast<double*>(c.data()), 2 * c.size());
+    sigma_vector.compute_sigma_block(sigma_block, c_block, 2);
+}
+
+void TDCI::record_step(const std::vector<std::complex<double>>& C, const std::string& label,
+                       double time, std::vector<int>& orbs) {
+    double conv = 1.0 / 24.18884326505;
+    if (std::fabs((time / conv) - round(time / conv)) > 1e-8)
+        return;
+    outfile->Printf("\n  t = %1.3f as", time / conv);
+    if (options_->get_bool("TDCI_PRINT_WFN")) {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3) << time / conv;
+        std::vector<double> C_r(C.size());
+        std::vector<double> C_i(C.size());
+        for (size_t I = 0; I < C.size(); ++I) {
+            C_r[I] = C[I].real();
+            C_i[I] = C[I].imag();
+        }
+        save_vector(C_r, label + "_" + ss.str() + "_r.txt");
+        save_vector(C_i, label + "_" + ss.str() + "_i.txt");
+    }
+    std::vector<double> occ = compute_occupation(C, orbs);
+    for (size_t i = 0; i < orbs.size(); ++i) {
+        occupations_[i].push_back(occ[i]);
+    }
+}
+
 void TDCI::save_matrix(SharedMatrix mat, std::string name) {
 
     size_t dim = mat->nrow();
@@ -1176,6 +1064,22 @@ std::vector<double> TDCI::compute_occupation(std::shared_ptr<psi::Vector> Cr,
     return occ_vec;
 }
 
+std::vector<double> TDCI::compute_occupation(const std::vector<std::complex<double>>& C,
+                                             std::vector<int>& orbs) {
+    std::vector<double> occ_vec(orbs.size(), 0.0);
+    for (size_t i = 0; i < orbs.size(); ++i) {
+        double occ = 0.0;
+        int orb = orbs[i];
+        for (size_t I = 0, maxI = C.size(); I < maxI; ++I) {
+            if (ann_dets_.get_det(I).get_alfa_bit(orb) == true) {
+                occ += std::norm(C[I]);
+            }
+        }
+        occ_vec[i] = occ;
+    }
+    return occ_vec;
+}
+
 void TDCI::compute_tdci_select(std::shared_ptr<psi::Vector> C0) {
 
     Timer t1;
@@ -2022,15 +1926,15 @@ void TDCI::complex_sigma_build(std::vector<double>& sigma_r, std::vector<double>
         size_t start_a_idx = 0;
         for (size_t K = start_a_idx, max_K = end_a_idx; K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::pair<size_t, short>>& c_dets = a_list[K];
+                const auto c_dets = a_list[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     const size_t J = detJ.first;
                     const size_t p = std::abs(detJ.second) - 1;
                     double sign_p = detJ.second > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         const size_t q = std::abs(detI.second) - 1;
                         if (p != q) {
                             const size_t I = detI.first;
@@ -2055,15 +1959,15 @@ void TDCI::complex_sigma_build(std::vector<double>& sigma_r, std::vector<double>
         for (size_t K = start_b_idx, max_K = end_b_idx; K < max_K; ++K) {
             // aa singles
             if ((K % num_thread) == tid) {
-                const std::vector<std::pair<size_t, short>>& c_dets = b_list[K];
+                const auto c_dets = b_list[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     const size_t J = detJ.first;
                     const size_t p = std::abs(detJ.second) - 1;
                     double sign_p = detJ.second > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         const size_t q = std::abs(detI.second) - 1;
                         if (p != q) {
                             const size_t I = detI.first;
@@ -2093,16 +1997,16 @@ void TDCI::complex_sigma_build(std::vector<double>& sigma_r, std::vector<double>
         //      size_t end_aa_idx = start_aa_idx + bin_aa_size;
         for (size_t K = 0, max_K = aa_size; K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = aa_list[K];
+                const auto c_dets = aa_list[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s) and (p != s) and (q != r)) {
@@ -2123,16 +2027,16 @@ void TDCI::complex_sigma_build(std::vector<double>& sigma_r, std::vector<double>
         // BB doubles
         for (size_t K = 0, max_K = bb_list.size(); K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = bb_list[K];
+                const auto c_dets = bb_list[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s) and (p != s) and (q != r)) {
@@ -2151,16 +2055,16 @@ void TDCI::complex_sigma_build(std::vector<double>& sigma_r, std::vector<double>
         }
         for (size_t K = 0, max_K = ab_list.size(); K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = ab_list[K];
+                const auto c_dets = ab_list[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s)) {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <complex>
 #include <fstream>
 #include <iomanip>
 
@@ -43,6 +44,7 @@
 #include "sparse_ci/sparse_ci_solver.h"
 #include "sparse_ci/determinant.h"
 #include "sparse_ci/determinant_hashvector.h"
+#include "sparse_ci/sigma_vector.h"
 #include "orbital-helpers/iao_builder.h"
 #include "orbital-helpers/localize.h"
 
@@ -116,9 +118,20 @@ class TDCI {
     void propagate_cn(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
     void propagate_taylor1(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
     void propagate_taylor2(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
-    void propagate_RK4(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
     void propagate_QCN(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
-    void propagate_lanczos(std::shared_ptr<psi::Vector> C0, std::shared_ptr<psi::Matrix> H);
+
+    // Matrix-free propagators. H is applied through sigma builds on complex vectors stored as
+    // interleaved (real, imaginary) pairs
+    void propagate_RK4(std::shared_ptr<psi::Vector> C0, std::shared_ptr<SigmaVector> sigma_vector);
+    void propagate_lanczos(std::shared_ptr<psi::Vector> C0,
+                           std::shared_ptr<SigmaVector> sigma_vector);
+
+    // Compute sigma = H c
+    void apply_hamiltonian(SigmaVector& sigma_vector, std::vector<std::complex<double>>& sigma,
+                           std::vector<std::complex<double>>& c);
+    // Save the wave function and the occupations if time is an integer number of attoseconds
+    void record_step(const std::vector<std::complex<double>>& C, const std::string& label,
+                     double time, std::vector<int>& orbs);
 
     void compute_tdci_select(std::shared_ptr<psi::Vector> C0);
 
@@ -140,6 +153,8 @@ class TDCI {
                                            std::shared_ptr<psi::Vector> Ci, std::vector<int>& orb);
     std::vector<double> compute_occupation(DeterminantHashVec& dets, std::vector<double>& Cr,
                                            std::vector<double>& Ci, std::vector<int>& orb);
+    std::vector<double> compute_occupation(const std::vector<std::complex<double>>& C,
+                                           std::vector<int>& orb);
 
     void get_PQ_space(DeterminantHashVec& P_space, std::vector<double>& P_coeffs_r,
                       std::vector<double>& P_coeffs_i, DeterminantHashVec& PQ_space,
@@ -205,6 +205,9 @@ template <size_t N> class BitArray {
     /// get a word in position pos
     word_t get_word(size_t pos) const { return words_[pos]; }
 
+    /// get a pointer to the words (used by the batched kernels in bitwise_kernels.h)
+    const word_t* data() const { return words_.data(); }
+
     /// set a word in position pos
     void set_word(size_t pos, word_t word) { words_[pos] = word; }
 
@@ -519,16 +522,16 @@ template <size_t N> class BitArray {
         if constexpr (N == 64) {
             return ui64_sign(words_[0], n);
         } else {
+            // count the bits before n with a fixed number of masked words. This avoids
+            // data-dependent branches and lets the compiler unroll and vectorize the loop
+            const size_t word_n = whichword(n);
+            const word_t mask_n = maskbit(n) - 1;
             size_t count = 0;
-            // count all the preceeding bits only if we are looking past the first word
-            if (static_cast<size_t>(n) >= bits_per_word) {
-                size_t last_full_word = whichword(n);
-                for (size_t k = 0; k < last_full_word; ++k) {
-                    count += ui64_bit_count(words_[k]);
-                }
+            for (size_t k = 0; k < nwords_; ++k) {
+                const word_t mask = k < word_n ? ~word_t(0) : (k == word_n ? mask_n : word_t(0));
+                count += ui64_bit_count(words_[k] & mask);
             }
-            return (count % 2 == 0) ? ui64_sign(getword(n), whichbit(n))
-                                    : -ui64_sign(getword(n), whichbit(n));
+            return (count % 2 == 0) ? 1.0 : -1.0;
         }
     }
 
@@ -635,6 +638,25 @@ template <size_t N> class BitArray {
         }
     };
 
+    /// Returns a well-mixed 64-bit hash value for a BitArray object.
+    /// Every bit of the result depends on all the words of the array, so the low bits can be used
+    /// directly to index a power-of-two table and the high bits as a tag (see FlatHashMap)
+    struct MixHash {
+        std::size_t operator()(const BitArray<N>& d) const {
+            if constexpr (N == 64) {
+                return ui64_hash_mix(d.words_[0]);
+            } else if constexpr (N == 128) {
+                return ui64_hash_mix(d.words_[0] ^ ui64_hash_mix(d.words_[1] + nwords_));
+            } else {
+                std::uint64_t h = nwords_;
+                for (auto& w : d.words_) {
+                    h = ui64_hash_mix(h ^ w);
+                }
+                return h;
+            }
+        }
+    };
+
   protected:
     // ==> Private Functions <==
 
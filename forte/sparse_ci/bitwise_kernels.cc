@@ -0,0 +1,228 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER,
+ * AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FORTE_BIT_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define FORTE_BIT_KERNELS_X86 0
+#endif
+
+#include "bitwise_kernels.h"
+
+// The kernels in this file are compiled for several instruction sets using the target attribute
+// and the best one supported by the CPU is selected at runtime, so the library does not need to be
+// compiled with -march flags. The portable scalar version is always available.
+
+namespace forte {
+
+namespace {
+
+void bit_counts_scalar(const uint64_t* ref, const uint64_t* words, size_t nwords, size_t n,
+                       int* counts) {
+    for (size_t i = 0; i < n; ++i, words += nwords) {
+        int c = 0;
+        for (size_t k = 0; k < nwords; ++k) {
+            c += std::popcount(ref[k] ^ words[k]);
+        }
+        counts[i] = c;
+    }
+}
+
+#if FORTE_BIT_KERNELS_X86
+
+__attribute__((target("popcnt"))) void bit_counts_popcnt(const uint64_t* ref,
+                                                         const uint64_t* words, size_t nwords,
+                                                         size_t n, int* counts) {
+    for (size_t i = 0; i < n; ++i, words += nwords) {
+        int c = 0;
+        for (size_t k = 0; k < nwords; ++k) {
+            c += __builtin_popcountll(ref[k] ^ words[k]);
+        }
+        counts[i] = c;
+    }
+}
+
+/// Count the bits of each 64-bit lane using the nibble lookup table algorithm of W. Mula
+__attribute__((target("avx2"))) inline __m256i popcount_epi64_avx2(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                            1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, low_mask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i cnt =
+        _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2,popcnt"))) void bit_counts_avx2(const uint64_t* ref,
+                                                            const uint64_t* words, size_t nwords,
+                                                            size_t n, int* counts) {
+    constexpr size_t width = 4;
+    // the reference must tile a register
+    if (width % nwords != 0) {
+        bit_counts_popcnt(ref, words, nwords, n, counts);
+        return;
+    }
+    alignas(32) uint64_t tile[width];
+    alignas(32) uint64_t lane_counts[width];
+    for (size_t k = 0; k < width; ++k) {
+        tile[k] = ref[k % nwords];
+    }
+    const __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(tile));
+    const size_t per_chunk = width / nwords;
+    const size_t nchunks = n / per_chunk;
+    for (size_t c = 0; c < nchunks; ++c, words += width) {
+        const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+        const __m256i x = _mm256_xor_si256(r, w);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_counts), popcount_epi64_avx2(x));
+        for (size_t i = 0, k = 0; i < per_chunk; ++i) {
+            int sum = 0;
+            for (size_t j = 0; j < nwords; ++j, ++k) {
+                sum += static_cast<int>(lane_counts[k]);
+            }
+            counts[c * per_chunk + i] = sum;
+        }
+    }
+    const size_t done = nchunks * per_chunk;
+    bit_counts_popcnt(ref, words, nwords, n - done, counts + done);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt"))) void
+bit_counts_avx512(const uint64_t* ref, const uint64_t* words, size_t nwords, size_t n,
+                  int* counts) {
+    constexpr size_t width = 8;
+    // the reference must tile a register
+    if (width % nwords != 0) {
+        bit_counts_popcnt(ref, words, nwords, n, counts);
+        return;
+    }
+    alignas(64) uint64_t tile[width];
+    alignas(64) uint64_t lane_counts[width];
+    for (size_t k = 0; k < width; ++k) {
+        tile[k] = ref[k % nwords];
+    }
+    const __m512i r = _mm512_load_si512(tile);
+    const size_t per_chunk = width / nwords;
+    const size_t nchunks = n / per_chunk;
+    for (size_t c = 0; c < nchunks; ++c, words += width) {
+        const __m512i w = _mm512_loadu_si512(words);
+        const __m512i x = _mm512_xor_si512(r, w);
+        _mm512_store_si512(lane_counts, _mm512_popcnt_epi64(x));
+        for (size_t i = 0, k = 0; i < per_chunk; ++i) {
+            int sum = 0;
+            for (size_t j = 0; j < nwords; ++j, ++k) {
+                sum += static_cast<int>(lane_counts[k]);
+            }
+            counts[c * per_chunk + i] = sum;
+        }
+    }
+    const size_t done = nchunks * per_chunk;
+    bit_counts_popcnt(ref, words, nwords, n - done, counts + done);
+}
+
+#endif
+
+BitKernelISA detect_best_isa() {
+#if FORTE_BIT_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512vpopcntdq"))
+        return BitKernelISA::AVX512;
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("popcnt"))
+        return BitKernelISA::AVX2;
+    if (__builtin_cpu_supports("popcnt"))
+        return BitKernelISA::Popcnt;
+#endif
+    return BitKernelISA::Scalar;
+}
+
+std::atomic<BitKernelISA>& active_isa() {
+    static std::atomic<BitKernelISA> isa(bit_kernel_best_isa());
+    return isa;
+}
+
+void bit_counts(const uint64_t* ref, const uint64_t* words, size_t nwords, size_t n,
+                int* counts) {
+    switch (active_isa().load(std::memory_order_relaxed)) {
+#if FORTE_BIT_KERNELS_X86
+    case BitKernelISA::AVX512:
+        bit_counts_avx512(ref, words, nwords, n, counts);
+        return;
+    case BitKernelISA::AVX2:
+        bit_counts_avx2(ref, words, nwords, n, counts);
+        return;
+    case BitKernelISA::Popcnt:
+        bit_counts_popcnt(ref, words, nwords, n, counts);
+        return;
+#endif
+    default:
+        bit_counts_scalar(ref, words, nwords, n, counts);
+    }
+}
+
+} // namespace
+
+BitKernelISA bit_kernel_best_isa() {
+    static const BitKernelISA best = detect_best_isa();
+    return best;
+}
+
+BitKernelISA bit_kernel_isa() { return active_isa().load(); }
+
+void set_bit_kernel_isa(BitKernelISA isa) {
+    if (static_cast<int>(isa) > static_cast<int>(bit_kernel_best_isa())) {
+        throw std::runtime_error("set_bit_kernel_isa: the instruction set " +
+                                 bit_kernel_isa_name(isa) + " is not supported by this CPU");
+    }
+    active_isa().store(isa);
+}
+
+std::string bit_kernel_isa_name(BitKernelISA isa) {
+    switch (isa) {
+    case BitKernelISA::Popcnt:
+        return "POPCNT";
+    case BitKernelISA::AVX2:
+        return "AVX2";
+    case BitKernelISA::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+void xor_bit_counts(const uint64_t* ref, const uint64_t* words, size_t nwords, size_t n,
+                    int* counts) {
+    bit_counts(ref, words, nwords, n, counts);
+}
+
+} // namespace forte
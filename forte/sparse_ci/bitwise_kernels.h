@@ -0,0 +1,79 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER,
+ * AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitarray.hpp"
+
+namespace forte {
+
+/// The instruction sets that can be used by the batched bit kernels
+enum class BitKernelISA { Scalar, Popcnt, AVX2, AVX512 };
+
+/// @return the instruction set currently used by the batched bit kernels. By default this is the
+///         best instruction set supported by the CPU
+BitKernelISA bit_kernel_isa();
+
+/// @return the best instruction set supported by the CPU
+BitKernelISA bit_kernel_best_isa();
+
+/// @brief Select the instruction set used by the batched bit kernels (useful for testing and
+///        benchmarking). Throws if the CPU does not support it
+void set_bit_kernel_isa(BitKernelISA isa);
+
+/// @return the name of an instruction set
+std::string bit_kernel_isa_name(BitKernelISA isa);
+
+/// @brief Compute count(ref ^ a[i]) for an array of n bit arrays of nwords words each
+/// @param ref the nwords words of the reference
+/// @param words the n * nwords words of the bit arrays stored contiguously
+/// @param nwords the number of words in each bit array
+/// @param n the number of bit arrays
+/// @param counts an array of size n where the counts are stored
+void xor_bit_counts(const uint64_t* ref, const uint64_t* words, size_t nwords, size_t n,
+                    int* counts);
+
+/// @brief Compute count(ref ^ v[i]) for all the elements of a vector of BitArray objects (or
+///        determinants). For two determinants or strings this is twice their excitation level.
+template <typename BitArrayT>
+void xor_bit_counts(const BitArrayT& ref, const std::vector<BitArrayT>& v,
+                    std::vector<int>& counts) {
+    static_assert(sizeof(BitArrayT) == BitArrayT::nwords_ * sizeof(uint64_t),
+                  "The bit arrays must be stored contiguously");
+    counts.resize(v.size());
+    if (v.empty())
+        return;
+    xor_bit_counts(ref.data(), v.data()->data(), BitArrayT::nwords_, v.size(), counts.data());
+}
+
+} // namespace forte
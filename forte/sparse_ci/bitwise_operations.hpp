@@ -42,6 +42,18 @@ inline void hash_combine_uint64(uint64_t& seed, size_t value) {
     seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+/// @brief Mix the bits of a uint64_t integer (the finalizer of MurmurHash3)
+/// @param x the uint64_t integer to mix
+/// @return a value in which every bit depends on all the bits of x
+inline uint64_t ui64_hash_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
 /// @brief Count the number of bit set to 1 in a uint64_t
 /// @param x the uint64_t integer to test
 /// @return the number of bits that are set to 1
@@ -0,0 +1,228 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER,
+ * AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "forte-def.h"
+#include "sparse_ci/complementary_overlap.h"
+
+namespace forte {
+
+namespace {
+/// @return true if orbital p with spin 0 (alpha) or 1 (beta) is occupied in d
+bool occupied(const Determinant& d, size_t p, int spin) {
+    return spin == 0 ? d.get_alfa_bit(p) : d.get_beta_bit(p);
+}
+} // namespace
+
+ComplementaryOverlap::ComplementaryOverlap(size_t nactv, std::vector<Determinant> dets,
+                                           size_t max_memory)
+    : nactv_(nactv), dets_(std::move(dets)) {
+    // count the couplings z^+_τ v_τ u_σ |I>: after removing u_σ there are n_τ choices of v and
+    // nactv - n_τ + 1 choices of z, where n_τ is the number of τ electrons left
+    double ncouplings = 0.0;
+    for (const auto& d : dets_) {
+        size_t nocc[2] = {0, 0};
+        for (size_t u = 0; u < nactv_; ++u) {
+            nocc[0] += d.get_alfa_bit(u);
+            nocc[1] += d.get_beta_bit(u);
+        }
+        for (int sigma = 0; sigma < 2; ++sigma) {
+            for (int tau = 0; tau < 2; ++tau) {
+                const double nv = static_cast<double>(nocc[tau]) - (sigma == tau ? 1.0 : 0.0);
+                ncouplings += nocc[sigma] * nv * (nactv_ - nv + 1.0);
+            }
+        }
+    }
+    // memory used by build_batch for each coupling: the unsorted and sorted couplings, the index
+    // of J, and (at most) one entry of the hash map of J and of the offsets
+    const double coupling_bytes = 2 * sizeof(Coupling) + 2 * sizeof(size_t) +
+                                  sizeof(std::pair<Determinant, size_t>) +
+                                  3 * sizeof(std::uint64_t);
+    const double memory = ncouplings * coupling_bytes;
+    if (max_memory > 0 and memory > static_cast<double>(max_memory)) {
+        nbatch_ = static_cast<size_t>(std::ceil(memory / static_cast<double>(max_memory)));
+    }
+}
+
+void ComplementaryOverlap::build_batch(size_t b, Batch& batch) const {
+    det_flat_hash<size_t> J_index;
+    std::vector<size_t> J_of_coupling;
+    std::vector<Coupling> unsorted;
+    Determinant::MixHash hasher;
+
+    auto add = [&](const Determinant& J, size_t I, size_t u, size_t v, size_t z, double sign) {
+        const std::uint64_t hash = hasher(J);
+        // the top bits of the hash select the batch, the low bits are left to the hash map
+        if (nbatch_ > 1 and (((hash >> 32) * nbatch_) >> 32) != b)
+            return;
+        auto [it, inserted] = J_index.try_emplace_hashed(J, hash, J_index.size());
+        J_of_coupling.push_back(it->second);
+        unsorted.push_back({I, static_cast<uint16_t>(u), static_cast<uint16_t>(v),
+                            static_cast<uint16_t>(z), static_cast<int16_t>(sign > 0.0 ? 1 : -1)});
+    };
+
+    for (size_t I = 0, ndets = dets_.size(); I < ndets; ++I) {
+        for (int sigma = 0; sigma < 2; ++sigma) {
+            for (size_t u = 0; u < nactv_; ++u) {
+                if (not occupied(dets_[I], u, sigma))
+                    continue;
+                Determinant Du(dets_[I]);
+                const double sign_u = sigma == 0 ? Du.destroy_alfa_bit(u) : Du.destroy_beta_bit(u);
+                for (int tau = 0; tau < 2; ++tau) {
+                    for (size_t v = 0; v < nactv_; ++v) {
+                        if (not occupied(Du, v, tau))
+                            continue;
+                        Determinant Dv(Du);
+                        const double sign_v =
+                            tau == 0 ? Dv.destroy_alfa_bit(v) : Dv.destroy_beta_bit(v);
+                        for (size_t z = 0; z < nactv_; ++z) {
+                            if (occupied(Dv, z, tau))
+                                continue;
+                            Determinant J(Dv);
+                            const double sign_z =
+                                tau == 0 ? J.create_alfa_bit(z) : J.create_beta_bit(z);
+                            add(J, I, u, v, z, sign_u * sign_v * sign_z);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // group the couplings by J
+    auto& offsets = batch.offsets;
+    offsets.assign(J_index.size() + 1, 0);
+    for (size_t J : J_of_coupling)
+        offsets[J + 1] += 1;
+    for (size_t J = 0; J < J_index.size(); ++J)
+        offsets[J + 1] += offsets[J];
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    batch.couplings.resize(unsorted.size());
+    for (size_t k = 0, size = unsorted.size(); k < size; ++k)
+        batch.couplings[next[J_of_coupling[k]]++] = unsorted[k];
+}
+
+void ComplementaryOverlap::contract_batch(const Batch& batch,
+                                          const std::vector<std::vector<double>>& evecs,
+                                          size_t np, const std::vector<double>& braT,
+                                          const std::vector<double>& ketT,
+                                          std::vector<double>& out) const {
+    const size_t nJ = batch.offsets.size() - 1;
+    const auto& offsets = batch.offsets;
+    const auto& couplings = batch.couplings;
+    const int nthreads = omp_get_max_threads();
+    std::vector<std::vector<double>> pbra(nthreads, std::vector<double>(np));
+    std::vector<std::vector<double>> pket(nthreads, std::vector<double>(np));
+
+    for (size_t n = 0, nroots = evecs.size(); n < nroots; ++n) {
+        const auto& C = evecs[n];
+        double overlap = 0.0;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 64) reduction(+ : overlap)
+        for (size_t J = 0; J < nJ; ++J) {
+            const int thread = omp_get_thread_num();
+            double* pb = pbra[thread].data();
+            double* pk = pket[thread].data();
+            std::fill(pb, pb + np, 0.0);
+            std::fill(pk, pk + np, 0.0);
+            // <J| h_{pσ}(B) |Ψ> and <J| h_{pσ}(K) |Ψ> for all p
+            for (size_t k = offsets[J]; k < offsets[J + 1]; ++k) {
+                const auto& c = couplings[k];
+                const double cI = c.sign * C[c.I];
+                const double* b = &braT[((c.z * nactv_ + c.u) * nactv_ + c.v) * np];
+                const double* t = &ketT[((c.u * nactv_ + c.v) * nactv_ + c.z) * np];
+                for (size_t p = 0; p < np; ++p) {
+                    pb[p] += cI * b[p];
+                    pk[p] += cI * t[p];
+                }
+            }
+            for (size_t p = 0; p < np; ++p)
+                overlap += pb[p] * pk[p];
+        }
+        out[n] += overlap;
+    }
+}
+
+std::vector<double> ComplementaryOverlap::compute(const std::vector<std::vector<double>>& evecs,
+                                                  size_t np, const std::vector<double>& bra,
+                                                  const std::vector<double>& ket) {
+    const size_t nactv = nactv_;
+    const size_t nactv3 = nactv * nactv * nactv;
+    if (bra.size() != np * nactv3 or ket.size() != np * nactv3)
+        throw std::runtime_error("ComplementaryOverlap: invalid size of the tensors");
+    for (const auto& evec : evecs) {
+        if (evec.size() != dets_.size())
+            throw std::runtime_error("ComplementaryOverlap: invalid size of the vectors");
+    }
+
+    std::vector<double> out(evecs.size(), 0.0);
+    if (np == 0 or dets_.empty())
+        return out;
+
+    // store the tensors as B(z,u,v,p) and K(u,v,z,p) so that the loops over p are contiguous
+    std::vector<double> braT(bra.size()), ketT(ket.size());
+    for (size_t p = 0; p < np; ++p) {
+        for (size_t zuv = 0; zuv < nactv3; ++zuv)
+            braT[zuv * np + p] = bra[p * nactv3 + zuv];
+    }
+    for (size_t uv = 0; uv < nactv * nactv; ++uv) {
+        for (size_t p = 0; p < np; ++p) {
+            for (size_t z = 0; z < nactv; ++z)
+                ketT[(uv * nactv + z) * np + p] = ket[(uv * np + p) * nactv + z];
+        }
+    }
+
+    if (nbatch_ == 1) {
+        if (not cached_) {
+            build_batch(0, cached_batch_);
+            cached_ = true;
+        }
+        contract_batch(cached_batch_, evecs, np, braT, ketT, out);
+        return out;
+    }
+    for (size_t b = 0; b < nbatch_; ++b) {
+        Batch batch;
+        build_batch(b, batch);
+        contract_batch(batch, evecs, np, braT, ketT, out);
+    }
+    return out;
+}
+
+std::vector<double> complementary_H2caa_overlap(size_t nactv, const std::vector<Determinant>& dets,
+                                                const std::vector<std::vector<double>>& evecs,
+                                                size_t np, const std::vector<double>& bra,
+                                                const std::vector<double>& ket) {
+    ComplementaryOverlap overlap(nactv, dets, std::numeric_limits<size_t>::max());
+    return overlap.compute(evecs, np, bra, ket);
+}
+
+} // namespace forte
@@ -0,0 +1,117 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER,
+ * AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "sparse_ci/determinant.h"
+
+namespace forte {
+
+/// @brief Compute the overlaps of wave functions acted on by complementary operators
+///
+///   O = sum_{p,σ} <Ψ| h^+_{pσ}(B) h_{pσ}(K) |Ψ>,  h_{pσ}(T) = sum_{uvz} T_{p,z,u,v} sum_τ z^+_τ v_τ u_σ
+///
+/// where p runs over np non-active orbitals and u, v, z over the nactv active orbitals. This gives
+/// the 3-RDM contribution of the fully contracted product of two 2-body operators without forming
+/// the 3-RDM, since sum_{pzuvw} B_{pwxy} K_{uvpz} Γ^{xyz}_{uwv} can be written as O plus 2-RDM
+/// terms. The couplings <J| z^+_τ v_τ u_σ |I> between the N- and (N-1)-electron determinants are
+/// grouped by J and the overlap is accumulated for each J in parallel.
+///
+/// The (N-1)-electron determinants are split into batches (by hash) so that the couplings of a
+/// batch fit in a given amount of memory. When a single batch is needed its couplings are built
+/// once and reused by all the calls to compute(), otherwise each batch is built and released in
+/// turn. An object should be kept for as long as the determinant space does not change.
+class ComplementaryOverlap {
+  public:
+    /// @param nactv the number of active orbitals
+    /// @param dets the determinants spanning the wave functions
+    /// @param max_memory the maximum number of bytes used to store the couplings of a batch
+    ComplementaryOverlap(size_t nactv, std::vector<Determinant> dets, size_t max_memory);
+
+    /// @return the number of batches of (N-1)-electron determinants
+    size_t num_batches() const { return nbatch_; }
+
+    /// @param evecs the coefficients of the wave functions (one vector of size dets.size() per
+    ///        root)
+    /// @param np the number of non-active orbitals
+    /// @param bra the tensor B stored in the order (p, z, u, v)
+    /// @param ket the tensor K stored in the order (u, v, p, z)
+    /// @return the overlap O for each wave function
+    std::vector<double> compute(const std::vector<std::vector<double>>& evecs, size_t np,
+                                const std::vector<double>& bra, const std::vector<double>& ket);
+
+  private:
+    /// A coupling <J| z^+_τ v_τ u_σ |I> = sign between an N-electron determinant I and an
+    /// (N-1)-electron determinant J
+    struct Coupling {
+        size_t I;
+        uint16_t u;
+        uint16_t v;
+        uint16_t z;
+        int16_t sign;
+    };
+
+    /// The couplings of a batch grouped by J (CSR format: the couplings of J are in
+    /// couplings[offsets[J], offsets[J + 1]))
+    struct Batch {
+        std::vector<size_t> offsets;
+        std::vector<Coupling> couplings;
+    };
+
+    /// Build the couplings of the (N-1)-electron determinants that belong to batch b
+    void build_batch(size_t b, Batch& batch) const;
+
+    /// Add the contribution of a batch to the overlaps
+    void contract_batch(const Batch& batch, const std::vector<std::vector<double>>& evecs,
+                        size_t np, const std::vector<double>& braT,
+                        const std::vector<double>& ketT, std::vector<double>& out) const;
+
+    /// The number of active orbitals
+    size_t nactv_;
+    /// The N-electron determinants
+    std::vector<Determinant> dets_;
+    /// The number of batches
+    size_t nbatch_ = 1;
+    /// The couplings, stored only when a single batch is needed
+    Batch cached_batch_;
+    /// Are the couplings stored in cached_batch_?
+    bool cached_ = false;
+};
+
+/// Compute the overlaps of wave functions acted on by complementary operators (see
+/// ComplementaryOverlap). This function builds the couplings in a single batch
+std::vector<double> complementary_H2caa_overlap(size_t nactv, const std::vector<Determinant>& dets,
+                                                const std::vector<std::vector<double>>& evecs,
+                                                size_t np, const std::vector<double>& bra,
+                                                const std::vector<double>& ket);
+
+} // namespace forte
@@ -0,0 +1,246 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "sparse_ci/compressed_substitution_lists.h"
+
+namespace forte {
+
+namespace {
+/// Append an unsigned integer to a buffer as a variable-length integer (LEB128)
+inline void write_varint(std::vector<uint8_t>& buffer, uint64_t x) {
+    while (x >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(x));
+}
+
+/// Read a variable-length integer (LEB128) and advance the pointer
+inline uint64_t read_varint(const uint8_t*& ptr) {
+    uint64_t x = 0;
+    int shift = 0;
+    while (*ptr & 0x80) {
+        x |= static_cast<uint64_t>(*ptr & 0x7F) << shift;
+        shift += 7;
+        ++ptr;
+    }
+    x |= static_cast<uint64_t>(*ptr) << shift;
+    ++ptr;
+    return x;
+}
+
+/// Map a signed integer to an unsigned one so that small magnitudes give small values
+inline uint64_t zigzag_encode(int64_t x) {
+    return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t x) {
+    return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+}
+} // namespace
+
+CompressedSubstitutionLists::CompressedSubstitutionLists(size_t memory_budget,
+                                                         std::string scratch_file,
+                                                         size_t block_size)
+    : memory_budget_(memory_budget), scratch_file_(std::move(scratch_file)),
+      block_size_(block_size) {
+    if (block_size_ >= std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error(
+            "CompressedSubstitutionLists: the block size must be smaller than 4 GB");
+    }
+    blocks_.emplace_back();
+}
+
+CompressedSubstitutionLists::~CompressedSubstitutionLists() {
+    if (file_) {
+        std::fclose(file_);
+    }
+    if (mapped_data_) {
+        munmap(mapped_data_, disk_bytes_);
+    }
+    if (disk_bytes_ > 0) {
+        std::remove(scratch_file_.c_str());
+    }
+}
+
+void CompressedSubstitutionLists::add_lists(
+    const std::vector<std::vector<std::pair<size_t, short>>>& lists) {
+    if (nlabels_ == 2) {
+        throw std::runtime_error("CompressedSubstitutionLists: cannot mix 1- and 2-body lists");
+    }
+    nlabels_ = 1;
+    for (const auto& list : lists) {
+        if (list.empty()) {
+            continue;
+        }
+        begin_list(list.size());
+        for (const auto& [det, p] : list) {
+            add_entry(det, p, 0);
+        }
+        seal_block(false);
+    }
+}
+
+void CompressedSubstitutionLists::add_lists(
+    const std::vector<std::vector<std::tuple<size_t, short, short>>>& lists) {
+    if (nlabels_ == 1) {
+        throw std::runtime_error("CompressedSubstitutionLists: cannot mix 1- and 2-body lists");
+    }
+    nlabels_ = 2;
+    for (const auto& list : lists) {
+        if (list.empty()) {
+            continue;
+        }
+        begin_list(list.size());
+        for (const auto& [det, p, q] : list) {
+            add_entry(det, p, q);
+        }
+        seal_block(false);
+    }
+}
+
+void CompressedSubstitutionLists::begin_list(size_t nentries) {
+    if (finalized_) {
+        throw std::runtime_error("CompressedSubstitutionLists: cannot add lists after finalize()");
+    }
+    write_varint(blocks_.back().data, nentries);
+    last_det_ = 0;
+    num_lists_ += 1;
+    num_entries_ += nentries;
+}
+
+void CompressedSubstitutionLists::add_entry(size_t det, short p, short q) {
+    auto& data = blocks_.back().data;
+    write_varint(data, zigzag_encode(static_cast<int64_t>(det) - static_cast<int64_t>(last_det_)));
+    write_varint(data, zigzag_encode(p));
+    if (nlabels_ == 2) {
+        write_varint(data, zigzag_encode(q));
+    }
+    last_det_ = det;
+}
+
+void CompressedSubstitutionLists::seal_block(bool force) {
+    auto& block = blocks_.back();
+    // close the current list
+    if (block.data.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("CompressedSubstitutionLists: a block exceeds 4 GB");
+    }
+    if (block.offsets.back() != block.data.size()) {
+        block.offsets.push_back(static_cast<uint32_t>(block.data.size()));
+    }
+    if (block.data.size() < block_size_ and not force) {
+        return;
+    }
+    block.nbytes = block.data.size();
+    if (memory_bytes_ + block.nbytes > memory_budget_) {
+        // spill this block to the scratch file
+        if (file_ == nullptr) {
+            file_ = std::fopen(scratch_file_.c_str(), "wb");
+            if (file_ == nullptr) {
+                throw std::runtime_error("CompressedSubstitutionLists: cannot open the file " +
+                                         scratch_file_ + " (" + std::strerror(errno) + ")");
+            }
+        }
+        if (std::fwrite(block.data.data(), 1, block.nbytes, file_) != block.nbytes) {
+            throw std::runtime_error("CompressedSubstitutionLists: cannot write to the file " +
+                                     scratch_file_);
+        }
+        block.file_offset = disk_bytes_;
+        block.on_disk = true;
+        disk_bytes_ += block.nbytes;
+        std::vector<uint8_t>().swap(block.data);
+    } else {
+        block.data.shrink_to_fit();
+        memory_bytes_ += block.nbytes;
+    }
+    block.offsets.shrink_to_fit();
+    if (not force) {
+        blocks_.emplace_back();
+    }
+}
+
+void CompressedSubstitutionLists::finalize() {
+    if (finalized_) {
+        return;
+    }
+    seal_block(true);
+    if (blocks_.back().offsets.size() == 1) {
+        blocks_.pop_back();
+    }
+    finalized_ = true;
+    if (file_ == nullptr) {
+        return;
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+
+    int fd = open(scratch_file_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("CompressedSubstitutionLists: cannot open the file " +
+                                 scratch_file_ + " (" + std::strerror(errno) + ")");
+    }
+    void* ptr = mmap(nullptr, disk_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        throw std::runtime_error("CompressedSubstitutionLists: cannot map the file " +
+                                 scratch_file_ + " (" + std::strerror(errno) + ")");
+    }
+    // the blocks are read in order at every sigma build
+    madvise(ptr, disk_bytes_, MADV_SEQUENTIAL);
+    mapped_data_ = static_cast<uint8_t*>(ptr);
+}
+
+const uint8_t* CompressedSubstitutionLists::block_data(size_t block) const {
+    const auto& b = blocks_[block];
+    return b.on_disk ? mapped_data_ + b.file_offset : b.data.data();
+}
+
+void CompressedSubstitutionLists::get_list(size_t block, size_t k,
+                                           std::vector<SubstitutionListEntry>& entries) const {
+    const uint8_t* ptr = block_data(block) + blocks_[block].offsets[k];
+    const size_t nentries = read_varint(ptr);
+    entries.resize(nentries);
+    int64_t det = 0;
+    for (auto& entry : entries) {
+        det += zigzag_decode(read_varint(ptr));
+        entry.det = static_cast<size_t>(det);
+        entry.p = static_cast<short>(zigzag_decode(read_varint(ptr)));
+        entry.q = nlabels_ == 2 ? static_cast<short>(zigzag_decode(read_varint(ptr))) : 0;
+    }
+}
+
+} // namespace forte
@@ -0,0 +1,160 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace forte {
+
+/// An entry of a substitution list: the index of a determinant and the signed orbital label (p)
+/// and second orbital label (q) stored in DeterminantSubstitutionLists. For 1-body lists q = 0
+struct SubstitutionListEntry {
+    size_t det;
+    short p;
+    short q;
+};
+
+/**
+ * @brief The CompressedSubstitutionLists class
+ * Stores the 1- or 2-body substitution lists built by DeterminantSubstitutionLists in a compressed
+ * form and with a bound on the memory used.
+ *
+ * Each list is stored as the number of entries followed by the entries. The determinant indices
+ * are delta encoded and all the integers are written as variable-length integers (LEB128), so a
+ * typical entry takes 3-4 bytes instead of 16. The lists are grouped in blocks of about block_size
+ * bytes and addressed within a block with 32-bit offsets.
+ *
+ * Blocks are kept in memory until memory_budget is exhausted. The remaining blocks are written to
+ * a scratch file that is memory mapped once all the lists have been added, so these blocks are
+ * streamed from disk every time the lists are read.
+ */
+class CompressedSubstitutionLists {
+  public:
+    /// @param memory_budget the maximum number of bytes of compressed data stored in memory
+    /// @param scratch_file the name of the scratch file used for the blocks that do not fit in
+    ///        memory. The file is created only if needed and deleted by the destructor
+    /// @param block_size the target size of a block (in bytes)
+    CompressedSubstitutionLists(size_t memory_budget, std::string scratch_file,
+                                size_t block_size = 64 * 1024 * 1024);
+    ~CompressedSubstitutionLists();
+
+    CompressedSubstitutionLists(const CompressedSubstitutionLists&) = delete;
+    CompressedSubstitutionLists& operator=(const CompressedSubstitutionLists&) = delete;
+
+    /// Append 1-body lists. Empty lists are skipped
+    void add_lists(const std::vector<std::vector<std::pair<size_t, short>>>& lists);
+    /// Append 2-body lists. Empty lists are skipped
+    void add_lists(const std::vector<std::vector<std::tuple<size_t, short, short>>>& lists);
+
+    /// Close the last block and map the scratch file. Must be called before reading the lists
+    void finalize();
+
+    /// @return the number of blocks
+    size_t num_blocks() const { return blocks_.size(); }
+    /// @return the number of lists stored in a block
+    size_t num_lists(size_t block) const { return blocks_[block].offsets.size() - 1; }
+    /// @return the total number of lists
+    size_t num_lists() const { return num_lists_; }
+    /// @return the total number of entries
+    size_t num_entries() const { return num_entries_; }
+    /// @return the number of bytes of compressed data stored in memory
+    size_t memory_bytes() const { return memory_bytes_; }
+    /// @return the number of bytes of compressed data stored on disk
+    size_t disk_bytes() const { return disk_bytes_; }
+
+    /// Decode a list
+    /// @param block the block index
+    /// @param k the index of the list within the block
+    /// @param entries the decoded list
+    void get_list(size_t block, size_t k, std::vector<SubstitutionListEntry>& entries) const;
+
+    /// Call f(entries) for the lists assigned to a thread. The lists are assigned round-robin
+    /// according to their global index (list K goes to thread K % num_threads)
+    template <typename F> void for_each_list(size_t num_threads, size_t tid, F&& f) const {
+        std::vector<SubstitutionListEntry> entries;
+        size_t K = 0;
+        for (size_t block = 0, nblocks = blocks_.size(); block < nblocks; ++block) {
+            for (size_t k = 0, nlists = num_lists(block); k < nlists; ++k, ++K) {
+                if (K % num_threads == tid) {
+                    get_list(block, k, entries);
+                    f(entries);
+                }
+            }
+        }
+    }
+
+  private:
+    struct Block {
+        /// The offset of each list in the block data (one extra element marks the end)
+        std::vector<uint32_t> offsets = {0};
+        /// The compressed data (empty if the block is stored on disk)
+        std::vector<uint8_t> data;
+        /// The offset of the block in the scratch file
+        size_t file_offset = 0;
+        /// The size of the compressed data
+        size_t nbytes = 0;
+        bool on_disk = false;
+    };
+
+    /// Start a new list in the current block
+    void begin_list(size_t nentries);
+    /// Append an entry to the current list
+    void add_entry(size_t det, short p, short q);
+    /// Close the current block, if it is full or if force is true
+    void seal_block(bool force);
+    /// @return a pointer to the compressed data of a block
+    const uint8_t* block_data(size_t block) const;
+
+    /// The number of orbital labels per entry (0 = not set, 1 or 2)
+    int nlabels_ = 0;
+    size_t memory_budget_;
+    std::string scratch_file_;
+    size_t block_size_;
+
+    std::vector<Block> blocks_;
+    /// The determinant index of the last entry added (used for delta encoding)
+    size_t last_det_ = 0;
+    size_t num_lists_ = 0;
+    size_t num_entries_ = 0;
+    size_t memory_bytes_ = 0;
+    size_t disk_bytes_ = 0;
+
+    /// The scratch file (used while building the lists)
+    std::FILE* file_ = nullptr;
+    /// The mapped scratch file
+    uint8_t* mapped_data_ = nullptr;
+    bool finalized_ = false;
+};
+
+} // namespace forte
@@ -31,6 +31,9 @@
 
 #include <unordered_map>
 
+#include "helpers/flat_hash_map.h"
+#include "helpers/partitioned_accumulator.h"
+
 #include "determinant.hpp"
 #include "configuration.hpp"
 
@@ -47,4 +50,11 @@ using det_vec = std::vector<Determinant>;
 template <typename T = double>
 using det_hash = std::unordered_map<Determinant, T, Determinant::Hash>;
 using det_hash_it = std::unordered_map<Determinant, double, Determinant::Hash>::iterator;
+/// An open-addressing map of determinants with contiguous storage (see FlatHashMap)
+template <typename T = double>
+using det_flat_hash = FlatHashMap<Determinant, T, Determinant::MixHash>;
+/// Lock-free accumulation of determinant contributions from several threads
+/// (see PartitionedAccumulator)
+template <typename T = double, typename Reduce = AddAssign>
+using det_accumulator = PartitionedAccumulator<Determinant, T, Determinant::MixHash, Reduce>;
 } // namespace forte
@@ -54,6 +54,38 @@ DeterminantSubstitutionLists::DeterminantSubstitutionLists(const std::vector<int
 
 void DeterminantSubstitutionLists::set_quiet_mode(bool mode) { quiet_ = mode; }
 
+void DeterminantSubstitutionLists::set_list_sinks(std::function<void(OneBodyLists&)> op_sink,
+                                                  std::function<void(TwoBodyLists&)> tp_sink) {
+    op_sink_ = std::move(op_sink);
+    tp_sink_ = std::move(tp_sink);
+}
+
+void DeterminantSubstitutionLists::store_lists(OneBodyLists& lists,
+                                               SubstitutionList<1>& target) {
+    if (op_sink_) {
+        op_sink_(lists);
+        return;
+    }
+    for (auto& vec : lists) {
+        if (!vec.empty()) {
+            target.push_back(vec);
+        }
+    }
+}
+
+void DeterminantSubstitutionLists::store_lists(TwoBodyLists& lists,
+                                               SubstitutionList<2>& target) {
+    if (tp_sink_) {
+        tp_sink_(lists);
+        return;
+    }
+    for (auto& vec : lists) {
+        if (!vec.empty()) {
+            target.push_back(vec);
+        }
+    }
+}
+
 void DeterminantSubstitutionLists::build_strings(const DeterminantHashVec& wfn) {
     beta_strings_.clear();
     alpha_strings_.clear();
@@ -176,10 +208,6 @@ void DeterminantSubstitutionLists::lists_1a(const DeterminantHashVec& wfn) {
         }
 
         for (const auto& vec : tmp) {
-            // TODO: if (vec.size() > 1) { ??
-            if (!vec.empty()) {
-                a_list_.push_back(vec);
-            }
             auto s = vec.size();
             if (vec_size.find(s) == vec_size.end()) {
                 vec_size[s] = 1;
@@ -187,6 +215,7 @@ void DeterminantSubstitutionLists::lists_1a(const DeterminantHashVec& wfn) {
                 vec_size[s] += 1;
             }
         }
+        store_lists(tmp, a_list_);
     }
 
     if (!quiet_) {
@@ -230,12 +259,7 @@ void DeterminantSubstitutionLists::lists_1b(const DeterminantHashVec& wfn) {
             }
         }
 
-        for (auto& vec : tmp) {
-            // TODO: if (vec.size() > 1) { ??
-            if (!vec.empty()) {
-                b_list_.push_back(vec);
-            }
-        }
+        store_lists(tmp, b_list_);
     }
 
     if (!quiet_) {
@@ -295,10 +319,7 @@ void DeterminantSubstitutionLists::lists_2aa(const DeterminantHashVec& wfn) {
             }
         }
 
-        for (auto& vec : tmp) {
-            if (!vec.empty()) {
-                aa_list_.push_back(vec);
-            }
+        for (const auto& vec : tmp) {
             auto s = vec.size();
             if (vec_size.find(s) == vec_size.end()) {
                 vec_size[s] = 1;
@@ -306,6 +327,7 @@ void DeterminantSubstitutionLists::lists_2aa(const DeterminantHashVec& wfn) {
                 vec_size[s] += 1;
             }
         }
+        store_lists(tmp, aa_list_);
     }
 
     if (!quiet_) {
@@ -356,10 +378,7 @@ void DeterminantSubstitutionLists::lists_2ab(const DeterminantHashVec& wfn) {
             }
         }
 
-        for (auto& vec : tmp) {
-            if (!vec.empty()) {
-                ab_list_.push_back(vec);
-            }
+        for (const auto& vec : tmp) {
             auto s = vec.size();
             if (vec_size.find(s) == vec_size.end()) {
                 vec_size[s] = 1;
@@ -367,6 +386,7 @@ void DeterminantSubstitutionLists::lists_2ab(const DeterminantHashVec& wfn) {
                 vec_size[s] += 1;
             }
         }
+        store_lists(tmp, ab_list_);
     }
 
     if (!quiet_) {
@@ -423,11 +443,7 @@ void DeterminantSubstitutionLists::lists_2bb(const DeterminantHashVec& wfn) {
             }
         }
 
-        for (auto& vec : tmp) {
-            if (!vec.empty()) {
-                bb_list_.push_back(vec);
-            }
-        }
+        store_lists(tmp, bb_list_);
     }
 
     if (!quiet_) {
@@ -438,12 +454,17 @@ void DeterminantSubstitutionLists::lists_2bb(const DeterminantHashVec& wfn) {
 void DeterminantSubstitutionLists::clear_op_s_lists() {
     a_list_.clear();
     b_list_.clear();
+    a_list_.shrink_to_fit();
+    b_list_.shrink_to_fit();
 }
 
 void DeterminantSubstitutionLists::clear_tp_s_lists() {
     aa_list_.clear();
     bb_list_.clear();
     ab_list_.clear();
+    aa_list_.shrink_to_fit();
+    bb_list_.shrink_to_fit();
+    ab_list_.shrink_to_fit();
 }
 
 void DeterminantSubstitutionLists::clear_3p_s_lists() {
@@ -451,6 +472,10 @@ void DeterminantSubstitutionLists::clear_3p_s_lists() {
     aab_list_.clear();
     abb_list_.clear();
     bbb_list_.clear();
+    aaa_list_.shrink_to_fit();
+    aab_list_.shrink_to_fit();
+    abb_list_.shrink_to_fit();
+    bbb_list_.shrink_to_fit();
 }
 
 void DeterminantSubstitutionLists::three_s_lists(const DeterminantHashVec& wfn) {
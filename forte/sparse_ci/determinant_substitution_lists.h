@@ -28,10 +28,13 @@
 
 #pragma once
 
+#include <functional>
+
 #include "integrals/active_space_integrals.h"
 #include "sparse_ci/determinant_hashvector.h"
 #include "sparse_ci/determinant.h"
 #include "sparse_ci/sorted_string_list.h"
+#include "sparse_ci/substitution_list.h"
 
 namespace forte {
 
@@ -50,6 +53,15 @@ class DeterminantSubstitutionLists {
     /// Set print level
     void set_quiet_mode(bool mode);
 
+    using OneBodyLists = std::vector<std::vector<std::pair<size_t, short>>>;
+    using TwoBodyLists = std::vector<std::vector<std::tuple<size_t, short, short>>>;
+
+    /// Pass the 1- and 2-body lists to these functions as they are built, one group of
+    /// determinants at a time, instead of storing them in a_list_, b_list_, aa_list_, ab_list_,
+    /// and bb_list_. Passing empty functions restores the default behavior
+    void set_list_sinks(std::function<void(OneBodyLists&)> op_sink,
+                        std::function<void(TwoBodyLists&)> tp_sink);
+
     /// Build the coupling lists for one-particle operators
     void op_s_lists(const DeterminantHashVec& wfn);
 
@@ -91,23 +103,32 @@ class DeterminantSubstitutionLists {
 
     void build_strings(const DeterminantHashVec& wfn);
 
-    std::vector<std::vector<std::pair<size_t, short>>> a_list_;
-    std::vector<std::vector<std::pair<size_t, short>>> b_list_;
+    /// The lists are stored in CSR form (see SubstitutionList)
+    SubstitutionList<1> a_list_;
+    SubstitutionList<1> b_list_;
 
-    std::vector<std::vector<std::tuple<size_t, short, short>>> aa_list_;
-    std::vector<std::vector<std::tuple<size_t, short, short>>> bb_list_;
-    std::vector<std::vector<std::tuple<size_t, short, short>>> ab_list_;
+    SubstitutionList<2> aa_list_;
+    SubstitutionList<2> bb_list_;
+    SubstitutionList<2> ab_list_;
 
     /// Three particle lists
-    std::vector<std::vector<std::tuple<size_t, short, short, short>>> aaa_list_;
-    std::vector<std::vector<std::tuple<size_t, short, short, short>>> aab_list_;
-    std::vector<std::vector<std::tuple<size_t, short, short, short>>> abb_list_;
-    std::vector<std::vector<std::tuple<size_t, short, short, short>>> bbb_list_;
+    SubstitutionList<3> aaa_list_;
+    SubstitutionList<3> aab_list_;
+    SubstitutionList<3> abb_list_;
+    SubstitutionList<3> bbb_list_;
 
   protected:
     /// Initialize important variables on construction
     void startup();
 
+    /// Pass a group of lists to the sink or append the non-empty ones to target
+    void store_lists(OneBodyLists& lists, SubstitutionList<1>& target);
+    void store_lists(TwoBodyLists& lists, SubstitutionList<2>& target);
+
+    /// Functions that receive the lists as they are built (see set_list_sinks)
+    std::function<void(OneBodyLists&)> op_sink_;
+    std::function<void(TwoBodyLists&)> tp_sink_;
+
     std::vector<std::vector<size_t>> beta_strings_;
     std::vector<std::vector<size_t>> alpha_strings_;
     std::vector<std::vector<std::pair<int, size_t>>> alpha_a_strings_;
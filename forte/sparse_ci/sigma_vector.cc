@@ -26,6 +26,8 @@
  * @END LICENSE
  */
 
+#include "psi4/libmints/vector.h"
+
 #include "helpers/string_algorithms.h"
 #include "integrals/active_space_integrals.h"
 #include "sigma_vector_dynamic.h"
@@ -34,12 +36,28 @@
 
 namespace forte {
 
+void SigmaVector::compute_sigma_block(std::span<double> sigma, std::span<double> b, size_t nvec) {
+    auto b_n = std::make_shared<psi::Vector>("b", size_);
+    auto sigma_n = std::make_shared<psi::Vector>("sigma", size_);
+    for (size_t n = 0; n < nvec; ++n) {
+        for (size_t I = 0; I < size_; ++I) {
+            b_n->set(I, b[I * nvec + n]);
+        }
+        compute_sigma(sigma_n, b_n);
+        for (size_t I = 0; I < size_; ++I) {
+            sigma[I * nvec + n] = sigma_n->get(I);
+        }
+    }
+}
+
 SigmaVectorType string_to_sigma_vector_type(std::string type) {
     //    to_upper_string(type);
     if (type == "FULL") {
         return SigmaVectorType::Full;
     } else if (type == "SPARSE") {
         return SigmaVectorType::SparseList;
+    } else if (type == "SPARSE_STREAMING") {
+        return SigmaVectorType::SparseListStreaming;
     } else if (type == "DYNAMIC") {
         return SigmaVectorType::Dynamic;
     }
@@ -55,6 +73,13 @@ std::shared_ptr<SigmaVector> make_sigma_vector(DeterminantHashVec& space,
         sigma_vector = std::make_shared<SigmaVectorDynamic>(space, fci_ints, max_memory);
     } else if (sigma_type == SigmaVectorType::SparseList) {
         sigma_vector = std::make_shared<SigmaVectorSparseList>(space, fci_ints);
+    } else if (sigma_type == SigmaVectorType::SparseListStreaming) {
+        // a zero budget would silently select the uncompressed lists
+        if (max_memory == 0) {
+            throw std::runtime_error("make_sigma_vector: the SPARSE_STREAMING algorithm requires a "
+                                     "positive value of SIGMA_VECTOR_MAX_MEMORY");
+        }
+        sigma_vector = std::make_shared<SigmaVectorSparseList>(space, fci_ints, max_memory);
     } else if (sigma_type == SigmaVectorType::Full) {
         sigma_vector = std::make_shared<SigmaVectorFull>(space, fci_ints);
     }
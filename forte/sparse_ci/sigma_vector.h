@@ -29,6 +29,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 
 #include "sparse_ci/determinant_hashvector.h"
@@ -39,7 +40,7 @@ class Vector;
 
 namespace forte {
 
-enum class SigmaVectorType { Dynamic, SparseList, Full };
+enum class SigmaVectorType { Dynamic, SparseList, SparseListStreaming, Full };
 
 class ActiveSpaceIntegrals;
 class DeterminantSubstitutionLists;
@@ -67,6 +68,10 @@ class SigmaVector {
 
     virtual void compute_sigma(std::shared_ptr<psi::Vector> sigma,
                                std::shared_ptr<psi::Vector> b) = 0;
+    /// Compute the sigma vectors of a block of nvec vectors. The vectors are interleaved, that is,
+    /// the element I of vector n is stored in b[I * nvec + n] and sigma[I * nvec + n].
+    /// The default implementation calls compute_sigma once for each vector
+    virtual void compute_sigma_block(std::span<double> sigma, std::span<double> b, size_t nvec);
     virtual void get_diagonal(psi::Vector& diag) = 0;
     virtual void
     add_bad_roots(std::vector<std::vector<std::pair<size_t, double>>>& /*bad_states*/) {}
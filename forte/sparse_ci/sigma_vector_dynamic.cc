@@ -27,6 +27,7 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <cmath>
 #include <thread>
 #include <future>
@@ -38,6 +39,7 @@
 #include "helpers/timer.h"
 #include "sigma_vector_dynamic.h"
 #include "integrals/active_space_integrals.h"
+#include "sparse_ci/bitwise_kernels.h"
 #include "sparse_ci/determinant_functions.hpp"
 
 #ifdef _OPENMP
@@ -73,6 +75,32 @@ double sabab_time = 0.0;
 
 void print_SigmaVectorDynamic_stats();
 
+namespace {
+/// Add the contribution of a pair of determinants coupled by H_IJ = H_JI to all the vectors of
+/// an interleaved block: sigma_I += H_IJ b_J and sigma_J += H_IJ b_I
+inline void add_symmetric_coupling(double H_IJ, size_t posI, size_t posJ, const double* b,
+                                   double* sigma, size_t nvec) {
+    const double* b_I = b + posI * nvec;
+    const double* b_J = b + posJ * nvec;
+    double* sigma_I = sigma + posI * nvec;
+    double* sigma_J = sigma + posJ * nvec;
+    for (size_t n = 0; n < nvec; ++n) {
+        sigma_I[n] += H_IJ * b_J[n];
+        sigma_J[n] += H_IJ * b_I[n];
+    }
+}
+
+/// Add the contribution sigma_I += H_IJ b_J to all the vectors of an interleaved block
+inline void add_coupling(double H_IJ, size_t posI, size_t posJ, const double* b, double* sigma,
+                         size_t nvec) {
+    const double* b_J = b + posJ * nvec;
+    double* sigma_I = sigma + posI * nvec;
+    for (size_t n = 0; n < nvec; ++n) {
+        sigma_I[n] += H_IJ * b_J[n];
+    }
+}
+} // namespace
+
 SigmaVectorDynamic::SigmaVectorDynamic(const DeterminantHashVec& space,
                                        std::shared_ptr<ActiveSpaceIntegrals> fci_ints,
                                        size_t max_memory)
@@ -114,6 +142,8 @@ SigmaVectorDynamic::SigmaVectorDynamic(const DeterminantHashVec& space,
         first_abab_onthefly_group_.push_back(t);
     }
     H_IJ_list_.resize(total_space_);
+    xor_counts_thread_.assign(num_threads_,
+                              std::vector<int>(a_sorted_string_list_.sorted_half_dets().size()));
     outfile->Printf("\n\n  SigmaVectorDynamic:");
     outfile->Printf("\n  Maximum memory   : %zu double", total_space_);
     outfile->Printf("\n  Number of threads: %d\n", num_threads_);
@@ -123,7 +153,17 @@ SigmaVectorDynamic::~SigmaVectorDynamic() { print_SigmaVectorDynamic_stats(); }
 
 void SigmaVectorDynamic::compute_sigma(std::shared_ptr<psi::Vector> sigma,
                                        std::shared_ptr<psi::Vector> b) {
-    sigma->zero();
+    compute_sigma_block(std::span(sigma->pointer(), size_), std::span(b->pointer(), size_), 1);
+}
+
+void SigmaVectorDynamic::compute_sigma_block(std::span<double> sigma, std::span<double> b,
+                                             size_t nvec) {
+    nvec_ = nvec;
+    if (temp_b_.size() < size_ * nvec_) {
+        temp_sigma_.resize(size_ * nvec_);
+        temp_b_.resize(size_ * nvec_);
+    }
+    std::fill(sigma.begin(), sigma.end(), 0.0);
 
     compute_sigma_scalar(sigma, b);
     {
@@ -205,26 +245,23 @@ void SigmaVectorDynamic::get_diagonal(psi::Vector& diag) {
     }
 }
 
-void SigmaVectorDynamic::compute_sigma_scalar(std::shared_ptr<psi::Vector> sigma,
-                                              std::shared_ptr<psi::Vector> b) {
+void SigmaVectorDynamic::compute_sigma_scalar(std::span<double> sigma, std::span<double> b) {
     timer energy_timer("scalar");
 
-    double* sigma_p = sigma->pointer();
-    double* b_p = b->pointer();
     // loop over all determinants
     for (size_t I = 0; I < size_; ++I) {
-        double b_I = b_p[I];
-        sigma_p[I] += diag_[I] * b_I;
+        for (size_t n = 0; n < nvec_; ++n) {
+            sigma[I * nvec_ + n] += diag_[I] * b[I * nvec_ + n];
+        }
     }
 }
 
-void SigmaVectorDynamic::compute_sigma_aa(std::shared_ptr<psi::Vector> sigma,
-                                          std::shared_ptr<psi::Vector> b) {
+void SigmaVectorDynamic::compute_sigma_aa(std::span<double> sigma, std::span<double> b) {
     timer energy_timer("sigma_aa");
     std::fill(temp_sigma_.begin(), temp_sigma_.end(), 0.0);
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = b_sorted_string_list_.add(I);
-        temp_b_[I] = b->get(addI);
+        std::copy_n(&b[addI * nvec_], nvec_, &temp_b_[I * nvec_]);
     }
     // launch asynchronous tasks
     std::vector<std::future<void>> tasks;
@@ -244,10 +281,11 @@ void SigmaVectorDynamic::compute_sigma_aa(std::shared_ptr<psi::Vector> sigma,
         task.get();
     }
     // Add sigma using the determinant address used in the DeterminantHashVector object
-    double* sigma_p = sigma->pointer();
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = b_sorted_string_list_.add(I);
-        sigma_p[addI] += temp_sigma_[I];
+        for (size_t n = 0; n < nvec_; ++n) {
+            sigma[addI * nvec_ + n] += temp_sigma_[I * nvec_ + n];
+        }
     }
 }
 
@@ -285,8 +323,7 @@ void SigmaVectorDynamic::sigma_aa_dynamic_task(size_t task_id, size_t num_tasks)
     size_t end_el = H_IJ_aa_list_thread_end_[task_id];
     for (size_t el = begin_el; el < end_el; ++el) {
         std::tie(H_IJ, posI, posJ) = H_IJ_list_[el];
-        temp_sigma_[posI] += H_IJ * temp_b_[posJ];
-        temp_sigma_[posJ] += H_IJ * temp_b_[posI];
+        add_symmetric_coupling(H_IJ, posI, posJ, temp_b_.data(), temp_sigma_.data(), nvec_);
     }
 
     // compute contributions on-the-fly
@@ -297,13 +334,12 @@ void SigmaVectorDynamic::sigma_aa_dynamic_task(size_t task_id, size_t num_tasks)
     }
 }
 
-void SigmaVectorDynamic::compute_sigma_bb(std::shared_ptr<psi::Vector> sigma,
-                                          std::shared_ptr<psi::Vector> b) {
+void SigmaVectorDynamic::compute_sigma_bb(std::span<double> sigma, std::span<double> b) {
     timer energy_timer("sigma_bb");
     std::fill(temp_sigma_.begin(), temp_sigma_.end(), 0.0);
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = a_sorted_string_list_.add(I);
-        temp_b_[I] = b->get(addI);
+        std::copy_n(&b[addI * nvec_], nvec_, &temp_b_[I * nvec_]);
     }
     // launch asynchronous tasks
     std::vector<std::future<void>> tasks;
@@ -323,10 +359,11 @@ void SigmaVectorDynamic::compute_sigma_bb(std::shared_ptr<psi::Vector> sigma,
         task.get();
     }
     // Add sigma using the determinant address used in the DeterminantHashVector object
-    double* sigma_p = sigma->pointer();
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = a_sorted_string_list_.add(I);
-        sigma_p[addI] += temp_sigma_[I];
+        for (size_t n = 0; n < nvec_; ++n) {
+            sigma[addI * nvec_ + n] += temp_sigma_[I * nvec_ + n];
+        }
     }
 }
 
@@ -363,8 +400,7 @@ void SigmaVectorDynamic::sigma_bb_dynamic_task(size_t task_id, size_t num_tasks)
     size_t end_el = H_IJ_bb_list_thread_end_[task_id];
     for (size_t el = begin_el; el < end_el; ++el) {
         std::tie(H_IJ, posI, posJ) = H_IJ_list_[el];
-        temp_sigma_[posI] += H_IJ * temp_b_[posJ];
-        temp_sigma_[posJ] += H_IJ * temp_b_[posI];
+        add_symmetric_coupling(H_IJ, posI, posJ, temp_b_.data(), temp_sigma_.data(), nvec_);
     }
 
     // compute contributions on-the-fly
@@ -375,13 +411,12 @@ void SigmaVectorDynamic::sigma_bb_dynamic_task(size_t task_id, size_t num_tasks)
     }
 }
 
-void SigmaVectorDynamic::compute_sigma_abab(std::shared_ptr<psi::Vector> sigma,
-                                            std::shared_ptr<psi::Vector> b) {
+void SigmaVectorDynamic::compute_sigma_abab(std::span<double> sigma, std::span<double> b) {
     timer energy_timer("sigma_abab");
     std::fill(temp_sigma_.begin(), temp_sigma_.end(), 0.0);
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = a_sorted_string_list_.add(I);
-        temp_b_[I] = b->get(addI);
+        std::copy_n(&b[addI * nvec_], nvec_, &temp_b_[I * nvec_]);
     }
     // launch asynchronous tasks
     std::vector<std::future<void>> tasks;
@@ -402,10 +437,11 @@ void SigmaVectorDynamic::compute_sigma_abab(std::shared_ptr<psi::Vector> sigma,
         task.get();
     }
     // Add sigma using the determinant address used in the DeterminantHashVector object
-    double* sigma_p = sigma->pointer();
     for (size_t I = 0; I < size_; ++I) {
         size_t addI = a_sorted_string_list_.add(I);
-        sigma_p[addI] += temp_sigma_[I];
+        for (size_t n = 0; n < nvec_; ++n) {
+            sigma[addI * nvec_ + n] += temp_sigma_[I * nvec_ + n];
+        }
     }
 }
 
@@ -422,7 +458,7 @@ void SigmaVectorDynamic::sigma_abab_store_task(size_t task_id, size_t num_tasks)
                 first_abab_onthefly_group_[task_id] = group + num_tasks;
             }
         } else {
-            compute_abab_coupling(detIa, temp_b_);
+            compute_abab_coupling(detIa, temp_b_, task_id);
         }
     }
 }
@@ -435,7 +471,7 @@ void SigmaVectorDynamic::sigma_abab_dynamic_task(size_t task_id, size_t num_task
     size_t end_el = H_IJ_abab_list_thread_end_[task_id];
     for (size_t el = begin_el; el < end_el; ++el) {
         std::tie(H_IJ, posI, posJ) = H_IJ_list_[el];
-        temp_sigma_[posI] += H_IJ * temp_b_[posJ];
+        add_coupling(H_IJ, posI, posJ, temp_b_.data(), temp_sigma_.data(), nvec_);
     }
 
     // compute contributions on-the-fly
@@ -444,7 +480,7 @@ void SigmaVectorDynamic::sigma_abab_dynamic_task(size_t task_id, size_t num_task
     size_t first_group = first_abab_onthefly_group_[task_id];
     for (size_t group = first_group; group < num_half_dets; group += num_tasks) {
         const auto& detIa = sorted_half_dets[group];
-        compute_abab_coupling(detIa, temp_b_);
+        compute_abab_coupling(detIa, temp_b_, task_id);
     }
 }
 
@@ -462,10 +498,8 @@ bool SigmaVectorDynamic::compute_aa_coupling_and_store(const String& Ib,
     String IJa;
     size_t first_I = range_I.first;
     size_t last_I = range_I.second;
-    double sigma_I = 0.0;
     size_t num_elements = 0;
     for (size_t posI = first_I; posI < last_I; ++posI) {
-        sigma_I = 0.0;
         Ia = sorted_dets[posI].get_alfa_bits();
         for (size_t posJ = posI + 1; posJ < last_I; ++posJ) {
             Ja = sorted_dets[posJ].get_alfa_bits();
@@ -477,8 +511,7 @@ bool SigmaVectorDynamic::compute_aa_coupling_and_store(const String& Ib,
             int ndiff = IJa.count();
             if (ndiff == 2) {
                 double H_IJ = slater_rules_single_alpha(Ib, Ia, Ja, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
                 // Add this to the Hamiltonian
                 if (end + num_elements < limit) {
                     if (std::fabs(H_IJ) > H_threshold_) {
@@ -493,8 +526,7 @@ bool SigmaVectorDynamic::compute_aa_coupling_and_store(const String& Ib,
 #endif
             } else if (ndiff == 4) {
                 double H_IJ = slater_rules_double_alpha_alpha(Ia, Ja, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
                 // Add this to the Hamiltonian
                 if (end + num_elements < limit) {
                     if (std::fabs(H_IJ) > H_threshold_) {
@@ -509,7 +541,6 @@ bool SigmaVectorDynamic::compute_aa_coupling_and_store(const String& Ib,
 #endif
             }
         }
-        temp_sigma_[posI] += sigma_I;
     }
     if (stored) {
         H_IJ_aa_list_thread_end_[task_id] += num_elements;
@@ -525,9 +556,7 @@ void SigmaVectorDynamic::compute_aa_coupling(const String& Ib, const std::vector
     String IJa;
     size_t first_I = range_I.first;
     size_t last_I = range_I.second;
-    double sigma_I = 0.0;
     for (size_t posI = first_I; posI < last_I; ++posI) {
-        sigma_I = 0.0;
         Ia = sorted_dets[posI].get_alfa_bits();
         for (size_t posJ = posI + 1; posJ < last_I; ++posJ) {
             Ja = sorted_dets[posJ].get_alfa_bits();
@@ -539,21 +568,18 @@ void SigmaVectorDynamic::compute_aa_coupling(const String& Ib, const std::vector
             int ndiff = IJa.count();
             if (ndiff == 2) {
                 double H_IJ = slater_rules_single_alpha(Ib, Ia, Ja, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
 #if SIGMA_VEC_DEBUG
                 count_aa++;
 #endif
             } else if (ndiff == 4) {
                 double H_IJ = slater_rules_double_alpha_alpha(Ia, Ja, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
 #if SIGMA_VEC_DEBUG
                 count_aaaa++;
 #endif
             }
         }
-        temp_sigma_[posI] += sigma_I;
     }
 }
 
@@ -571,10 +597,8 @@ bool SigmaVectorDynamic::compute_bb_coupling_and_store(const String& Ia,
     String IJb;
     size_t first_I = range_I.first;
     size_t last_I = range_I.second;
-    double sigma_I = 0.0;
     size_t num_elements = 0;
     for (size_t posI = first_I; posI < last_I; ++posI) {
-        sigma_I = 0.0;
         Ib = sorted_dets[posI].get_beta_bits();
         for (size_t posJ = posI + 1; posJ < last_I; ++posJ) {
             Jb = sorted_dets[posJ].get_beta_bits();
@@ -586,8 +610,7 @@ bool SigmaVectorDynamic::compute_bb_coupling_and_store(const String& Ia,
             int ndiff = IJb.count();
             if (ndiff == 2) {
                 double H_IJ = slater_rules_single_beta(Ia, Ib, Jb, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
                 // Add this to the Hamiltonian
                 if (end + num_elements < limit) {
                     if (std::fabs(H_IJ) > H_threshold_) {
@@ -602,8 +625,7 @@ bool SigmaVectorDynamic::compute_bb_coupling_and_store(const String& Ia,
 #endif
             } else if (ndiff == 4) {
                 double H_IJ = slater_rules_double_beta_beta(Ib, Jb, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
                 // Add this to the Hamiltonian
                 if (end + num_elements < limit) {
                     if (std::fabs(H_IJ) > H_threshold_) {
@@ -618,7 +640,6 @@ bool SigmaVectorDynamic::compute_bb_coupling_and_store(const String& Ia,
 #endif
             }
         }
-        temp_sigma_[posI] += sigma_I;
     }
     if (stored) {
         H_IJ_bb_list_thread_end_[task_id] += num_elements;
@@ -634,9 +655,7 @@ void SigmaVectorDynamic::compute_bb_coupling(const String& Ia, const std::vector
     String IJb;
     size_t first_I = range_I.first;
     size_t last_I = range_I.second;
-    double sigma_I = 0.0;
     for (size_t posI = first_I; posI < last_I; ++posI) {
-        sigma_I = 0.0;
         Ib = sorted_dets[posI].get_beta_bits();
         for (size_t posJ = posI + 1; posJ < last_I; ++posJ) {
             Jb = sorted_dets[posJ].get_beta_bits();
@@ -648,21 +667,18 @@ void SigmaVectorDynamic::compute_bb_coupling(const String& Ia, const std::vector
             int ndiff = IJb.count();
             if (ndiff == 2) {
                 double H_IJ = slater_rules_single_beta(Ia, Ib, Jb, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
 #if SIGMA_VEC_DEBUG
                 count_bb++;
 #endif
             } else if (ndiff == 4) {
                 double H_IJ = slater_rules_double_beta_beta(Ib, Jb, fci_ints_);
-                sigma_I += H_IJ * b[posJ];
-                temp_sigma_[posJ] += H_IJ * b[posI];
+                add_symmetric_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
 #if SIGMA_VEC_DEBUG
                 count_bbbb++;
 #endif
             }
         }
-        temp_sigma_[posI] += sigma_I;
     }
 }
 
@@ -679,8 +695,12 @@ bool SigmaVectorDynamic::compute_abab_coupling_and_store(const String& detIa,
     String Jb;
 
     size_t group_num_elements = 0;
-    for (const auto& detJa : sorted_half_dets) {
-        if (detIa.fast_a_xor_b_count(detJa) == 2) {
+    // find all the alpha strings that differ from detIa by a single excitation
+    auto& xor_counts = xor_counts_thread_[task_id];
+    xor_bit_counts(detIa, sorted_half_dets, xor_counts);
+    for (size_t J = 0, maxJ = sorted_half_dets.size(); J < maxJ; ++J) {
+        if (xor_counts[J] == 2) {
+            const auto& detJa = sorted_half_dets[J];
             int i, a;
             for (size_t p = 0; p < nmo_; ++p) {
                 const bool la_p = detIa.get_bit(p);
@@ -697,10 +717,7 @@ bool SigmaVectorDynamic::compute_abab_coupling_and_store(const String& detIa,
             size_t last_I = range_I.second;
             size_t first_J = range_J.first;
             size_t last_J = range_J.second;
-            double sigma_I = 0.0;
-            //    size_t num_elements = 0;
             for (size_t posI = first_I; posI < last_I; ++posI) {
-                sigma_I = 0.0;
                 sorted_dets[posI].copy_beta_bits(Ib);
                 for (size_t posJ = first_J; posJ < last_J; ++posJ) {
                     sorted_dets[posJ].copy_beta_bits(Jb);
@@ -711,7 +728,7 @@ bool SigmaVectorDynamic::compute_abab_coupling_and_store(const String& detIa,
                     if (Ib.fast_a_xor_b_count(Jb) == 2) {
                         double H_IJ =
                             sign_ia * slater_rules_double_alpha_beta_pre(i, a, Ib, Jb, fci_ints_);
-                        sigma_I += H_IJ * b[posJ];
+                        add_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
                         // Add this to the Hamiltonian
                         if (end + group_num_elements < limit) {
                             if (std::fabs(H_IJ) > H_threshold_) {
@@ -726,7 +743,6 @@ bool SigmaVectorDynamic::compute_abab_coupling_and_store(const String& detIa,
 #endif
                     }
                 }
-                temp_sigma_[posI] += sigma_I;
             }
         }
     }
@@ -736,15 +752,20 @@ bool SigmaVectorDynamic::compute_abab_coupling_and_store(const String& detIa,
     return stored;
 }
 
-void SigmaVectorDynamic::compute_abab_coupling(const String& detIa, const std::vector<double>& b) {
+void SigmaVectorDynamic::compute_abab_coupling(const String& detIa, const std::vector<double>& b,
+                                               size_t task_id) {
     const auto& sorted_half_dets = a_sorted_string_list_.sorted_half_dets();
     const auto& sorted_dets = a_sorted_string_list_.sorted_dets();
     const auto& range_I = a_sorted_string_list_.range(detIa);
     String Ib;
     String Jb;
     String IJb;
-    for (const auto& detJa : sorted_half_dets) {
-        if (detIa.fast_a_xor_b_count(detJa) == 2) {
+    // find all the alpha strings that differ from detIa by a single excitation
+    auto& xor_counts = xor_counts_thread_[task_id];
+    xor_bit_counts(detIa, sorted_half_dets, xor_counts);
+    for (size_t J = 0, maxJ = sorted_half_dets.size(); J < maxJ; ++J) {
+        if (xor_counts[J] == 2) {
+            const auto& detJa = sorted_half_dets[J];
             int i, a;
             for (size_t p = 0; p < nmo_; ++p) {
                 const bool la_p = detIa.get_bit(p);
@@ -760,9 +781,7 @@ void SigmaVectorDynamic::compute_abab_coupling(const String& detIa, const std::v
             size_t last_I = range_I.second;
             size_t first_J = range_J.first;
             size_t last_J = range_J.second;
-            double sigma_I = 0.0;
             for (size_t posI = first_I; posI < last_I; ++posI) {
-                sigma_I = 0.0;
                 sorted_dets[posI].copy_beta_bits(Ib);
                 for (size_t posJ = first_J; posJ < last_J; ++posJ) {
                     sorted_dets[posJ].copy_beta_bits(Jb);
@@ -774,14 +793,14 @@ void SigmaVectorDynamic::compute_abab_coupling(const String& detIa, const std::v
                         IJb = Ib ^ Jb;
                         uint64_t j = IJb.find_and_clear_first_one();
                         uint64_t bb = IJb.find_first_one();
-                        const double H_IJ = Ib.slater_sign(j, bb) * fci_ints_->tei_ab(i, j, a, bb);
-                        sigma_I += H_IJ * b[posJ];
+                        const double H_IJ =
+                            sign_ia * Ib.slater_sign(j, bb) * fci_ints_->tei_ab(i, j, a, bb);
+                        add_coupling(H_IJ, posI, posJ, b.data(), temp_sigma_.data(), nvec_);
 #if SIGMA_VEC_DEBUG
                         count_abab++;
 #endif
                     }
                 }
-                temp_sigma_[posI] += sign_ia * sigma_I;
             }
         }
     }
@@ -50,6 +50,7 @@ class SigmaVectorDynamic : public SigmaVector {
                        std::shared_ptr<ActiveSpaceIntegrals> fci_ints, size_t max_memory);
     ~SigmaVectorDynamic();
     void compute_sigma(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b) override;
+    void compute_sigma_block(std::span<double> sigma, std::span<double> b, size_t nvec) override;
     void get_diagonal(psi::Vector& diag) override;
     void add_bad_roots(std::vector<std::vector<std::pair<size_t, double>>>& bad_states) override;
     double compute_spin(const std::vector<double>& c) override;
@@ -66,9 +67,11 @@ class SigmaVectorDynamic : public SigmaVector {
     /// Number of sigma builds
     int num_builds_ = 0;
     double H_threshold_ = 1.0e-14;
-    /// A temporary sigma vector of size N_det
+    /// The number of vectors in the block being processed
+    size_t nvec_ = 1;
+    /// A temporary b vector of size N_det x nvec_ (interleaved)
     std::vector<double> temp_b_;
-    /// A temporary sigma vector of size N_det
+    /// A temporary sigma vector of size N_det x nvec_ (interleaved)
     std::vector<double> temp_sigma_;
     SortedStringList a_sorted_string_list_;
     SortedStringList b_sorted_string_list_;
@@ -90,15 +93,19 @@ class SigmaVectorDynamic : public SigmaVector {
     std::vector<size_t> first_bb_onthefly_group_;
     std::vector<size_t> first_abab_onthefly_group_;
 
+    /// Scratch of each task used by the alpha-beta couplings to store the excitation level of the
+    /// alpha strings, sized once by the constructor
+    std::vector<std::vector<int>> xor_counts_thread_;
+
     void print_thread_stats();
     /// Scalar contribution to sigma
-    void compute_sigma_scalar(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b);
+    void compute_sigma_scalar(std::span<double> sigma, std::span<double> b);
     /// Alpha-alpha single and double excitation contributions to sigma
-    void compute_sigma_aa(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b);
+    void compute_sigma_aa(std::span<double> sigma, std::span<double> b);
     /// Beta-beta single and double excitation contributions to sigma
-    void compute_sigma_bb(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b);
+    void compute_sigma_bb(std::span<double> sigma, std::span<double> b);
     /// Alpha-beta double excitation contributions to sigma
-    void compute_sigma_abab(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b);
+    void compute_sigma_abab(std::span<double> sigma, std::span<double> b);
 
     /// Task to compute sigma_aa. Computes sigma and stores part of the Hamiltonian
     void sigma_aa_store_task(size_t task_id, size_t num_tasks);
@@ -124,6 +131,7 @@ class SigmaVectorDynamic : public SigmaVector {
 
     void compute_aa_coupling(const String& detIb, const std::vector<double>& b);
     void compute_bb_coupling(const String& detIa, const std::vector<double>& b);
-    void compute_abab_coupling(const String& detIa, const std::vector<double>& b);
+    void compute_abab_coupling(const String& detIa, const std::vector<double>& b,
+                               size_t task_id);
 };
 } // namespace forte
@@ -26,15 +26,21 @@
  * @END LICENSE
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
+#include <unistd.h>
+
 #include "psi4/psi4-dec.h"
 #include "psi4/libpsi4util/PsiOutStream.h"
 #include "psi4/libmints/vector.h"
+#include "psi4/libpsio/psio.hpp"
 
 #include "helpers/timer.h"
 #include "sigma_vector_sparse_list.h"
 #include "sparse_ci/determinant_substitution_lists.h"
+#include "sparse_ci/substitution_list_kernels.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -48,15 +54,39 @@ using namespace psi;
 
 namespace forte {
 
+namespace {
+/// Add the contribution of a pair of determinants coupled by H_IJ = H_JI to all the vectors of
+/// an interleaved block: sigma_I += H_IJ b_J and sigma_J += H_IJ b_I
+inline void add_symmetric_coupling(double HIJ, size_t I, size_t J, const double* b, double* sigma,
+                                   size_t nvec) {
+    const double* b_I = b + I * nvec;
+    const double* b_J = b + J * nvec;
+    double* sigma_I = sigma + I * nvec;
+    double* sigma_J = sigma + J * nvec;
+    for (size_t n = 0; n < nvec; ++n) {
+        sigma_I[n] += HIJ * b_J[n];
+        sigma_J[n] += HIJ * b_I[n];
+    }
+}
+} // namespace
+
 SigmaVectorSparseList::SigmaVectorSparseList(const DeterminantHashVec& space,
-                                             std::shared_ptr<ActiveSpaceIntegrals> fci_ints)
-    : SigmaVector(space, fci_ints, SigmaVectorType::SparseList, "SigmaVectorSparseList") {
+                                             std::shared_ptr<ActiveSpaceIntegrals> fci_ints,
+                                             size_t max_memory)
+    : SigmaVector(space, fci_ints,
+                  max_memory > 0 ? SigmaVectorType::SparseListStreaming
+                                 : SigmaVectorType::SparseList,
+                  "SigmaVectorSparseList") {
 
     op_ = std::make_shared<DeterminantSubstitutionLists>(fci_ints_->active_mo_symmetry());
     /// Build the coupling lists for 1- and 2-particle operators
     op_->build_strings(space_);
-    op_->op_s_lists(space_);
-    op_->tp_s_lists(space_);
+    if (max_memory > 0) {
+        build_compressed_lists(max_memory);
+    } else {
+        op_->op_s_lists(space_);
+        op_->tp_s_lists(space_);
+    }
     //    op_->set_quiet_mode(quiet_mode_);
 
     const det_hashvec& detmap = space_.wfn_hash();
@@ -66,6 +96,52 @@ SigmaVectorSparseList::SigmaVectorSparseList(const DeterminantHashVec& space,
     }
 }
 
+void SigmaVectorSparseList::build_compressed_lists(size_t max_memory) {
+    timer t("Compressed sub. lists");
+
+    // each object gets a unique prefix for its scratch files
+    static std::atomic<size_t> instance_count = 0;
+    const std::string prefix = psi::PSIOManager::shared_object()->get_default_path() + "forte." +
+                               std::to_string(getpid()) + ".sigma_lists." +
+                               std::to_string(instance_count++) + ".";
+
+    // the lists are built one type at a time. Each type uses what is left of the budget
+    size_t budget = max_memory * sizeof(double);
+    auto build = [&](std::unique_ptr<CompressedSubstitutionLists>& lists, const std::string& label,
+                     bool two_body, auto build_fn) {
+        lists = std::make_unique<CompressedSubstitutionLists>(budget, prefix + label);
+        auto* lists_ptr = lists.get();
+        if (two_body) {
+            op_->set_list_sinks({}, [lists_ptr](auto& l) { lists_ptr->add_lists(l); });
+        } else {
+            op_->set_list_sinks([lists_ptr](auto& l) { lists_ptr->add_lists(l); }, {});
+        }
+        build_fn();
+        lists->finalize();
+        budget -= std::min(budget, lists->memory_bytes());
+    };
+    build(a_lists_, "a", false, [&]() { op_->lists_1a(space_); });
+    build(b_lists_, "b", false, [&]() { op_->lists_1b(space_); });
+    build(aa_lists_, "aa", true, [&]() { op_->lists_2aa(space_); });
+    build(ab_lists_, "ab", true, [&]() { op_->lists_2ab(space_); });
+    build(bb_lists_, "bb", true, [&]() { op_->lists_2bb(space_); });
+    op_->set_list_sinks({}, {});
+
+    size_t memory_bytes = 0;
+    size_t disk_bytes = 0;
+    size_t num_entries = 0;
+    for (const auto* lists :
+         {a_lists_.get(), b_lists_.get(), aa_lists_.get(), ab_lists_.get(), bb_lists_.get()}) {
+        memory_bytes += lists->memory_bytes();
+        disk_bytes += lists->disk_bytes();
+        num_entries += lists->num_entries();
+    }
+    outfile->Printf("\n\n  SigmaVectorSparseList (compressed lists):");
+    outfile->Printf("\n  Number of entries: %zu", num_entries);
+    outfile->Printf("\n  Memory           : %.2f MB", memory_bytes / (1024. * 1024.));
+    outfile->Printf("\n  Disk             : %.2f MB\n", disk_bytes / (1024. * 1024.));
+}
+
 void SigmaVectorSparseList::add_bad_roots(
     std::vector<std::vector<std::pair<size_t, double>>>& roots) {
     bad_states_.clear();
@@ -82,28 +158,33 @@ void SigmaVectorSparseList::get_diagonal(psi::Vector& diag) {
 
 void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
                                           std::shared_ptr<psi::Vector> b) {
+    compute_sigma_block(std::span(sigma->pointer(), size_), std::span(b->pointer(), size_), 1);
+}
+
+void SigmaVectorSparseList::compute_sigma_block(std::span<double> sigma, std::span<double> b,
+                                                size_t nvec) {
     timer timer_sigma("Build sigma");
 
-    auto a_list_ = op_->a_list_;
-    auto b_list_ = op_->b_list_;
-    auto aa_list_ = op_->aa_list_;
-    auto ab_list_ = op_->ab_list_;
-    auto bb_list_ = op_->bb_list_;
+    const auto& a_list_ = op_->a_list_;
+    const auto& b_list_ = op_->b_list_;
+    const auto& aa_list_ = op_->aa_list_;
+    const auto& ab_list_ = op_->ab_list_;
+    const auto& bb_list_ = op_->bb_list_;
 
-    sigma->zero();
+    std::fill(sigma.begin(), sigma.end(), 0.0);
 
-    double* sigma_p = sigma->pointer();
-    double* b_p = b->pointer();
+    double* sigma_p = sigma.data();
+    double* b_p = b.data();
 
-    // Compute the overlap with each root
+    // Project the bad roots out of each vector
     int nbad = bad_states_.size();
     std::vector<double> overlap(nbad);
-    if (nbad != 0) {
+    for (size_t v = 0; v < nvec; ++v) {
         for (int n = 0; n < nbad; ++n) {
             std::vector<std::pair<size_t, double>>& bad_state = bad_states_[n];
             double dprd = 0.0;
             for (size_t det = 0, ndet = bad_state.size(); det < ndet; ++det) {
-                dprd += bad_state[det].second * b_p[bad_state[det].first];
+                dprd += bad_state[det].second * b_p[bad_state[det].first * nvec + v];
             }
             overlap[n] = dprd;
         }
@@ -113,7 +194,7 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
 
 #pragma omp parallel for
             for (size_t det = 0; det < ndet; ++det) {
-                b_p[bad_state[det].first] -= bad_state[det].second * overlap[n];
+                b_p[bad_state[det].first * nvec + v] -= bad_state[det].second * overlap[n];
             }
         }
     }
@@ -126,7 +207,7 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         size_t tid = omp_get_thread_num();
 
         // Each thread gets local copy of sigma
-        std::vector<double> sigma_t(size_);
+        std::vector<double> sigma_t(size_ * nvec);
 
         size_t bin_size = size_ / num_thread;
         bin_size += (tid < (size_ % num_thread)) ? 1 : 0;
@@ -138,7 +219,9 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
 
 #pragma omp critical
         for (size_t J = start_idx; J < end_idx; ++J) {
-            sigma_p[J] += diag_[J] * b_p[J]; // Make DDOT
+            for (size_t v = 0; v < nvec; ++v) {
+                sigma_p[J * nvec + v] += diag_[J] * b_p[J * nvec + v];
+            }
         }
 
         // a singles
@@ -146,27 +229,14 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         size_t start_a_idx = 0;
         for (size_t K = start_a_idx, max_K = end_a_idx; K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::pair<size_t, short>>& c_dets = a_list_[K];
-                size_t max_det = c_dets.size();
-                for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
-                    const size_t J = detJ.first;
-                    const size_t p = std::abs(detJ.second) - 1;
-                    double sign_p = detJ.second > 0.0 ? 1.0 : -1.0;
-                    for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
-                        const size_t q = std::abs(detI.second) - 1;
-                        if (p != q) {
-                            const size_t I = detI.first;
-                            double sign_q = detI.second > 0.0 ? 1.0 : -1.0;
-                            const double HIJ =
-                                fci_ints_->slater_rules_single_alpha_abs(dets[J], p, q) * sign_p *
-                                sign_q;
-                            sigma_t[I] += HIJ * b_p[J];
-                            sigma_t[J] += HIJ * b_p[I];
-                        }
-                    }
-                }
+                for_each_single_coupling(
+                    a_list_[K],
+                    [&](size_t J, int p, int q) {
+                        return fci_ints_->slater_rules_single_alpha_abs(dets[J], p, q);
+                    },
+                    [&](double HIJ, size_t I, size_t J) {
+                        add_symmetric_coupling(HIJ, I, J, b_p, sigma_t.data(), nvec);
+                    });
             }
         }
 
@@ -176,27 +246,14 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         for (size_t K = start_b_idx, max_K = end_b_idx; K < max_K; ++K) {
             // aa singles
             if ((K % num_thread) == tid) {
-                const std::vector<std::pair<size_t, short>>& c_dets = b_list_[K];
-                size_t max_det = c_dets.size();
-                for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
-                    const size_t J = detJ.first;
-                    const size_t p = std::abs(detJ.second) - 1;
-                    double sign_p = detJ.second > 0.0 ? 1.0 : -1.0;
-                    for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
-                        const size_t q = std::abs(detI.second) - 1;
-                        if (p != q) {
-                            const size_t I = detI.first;
-                            double sign_q = detI.second > 0.0 ? 1.0 : -1.0;
-                            const double HIJ =
-                                fci_ints_->slater_rules_single_beta_abs(dets[J], p, q) * sign_p *
-                                sign_q;
-                            sigma_t[I] += HIJ * b_p[J];
-                            sigma_t[J] += HIJ * b_p[I];
-                        }
-                    }
-                }
+                for_each_single_coupling(
+                    b_list_[K],
+                    [&](size_t J, int p, int q) {
+                        return fci_ints_->slater_rules_single_beta_abs(dets[J], p, q);
+                    },
+                    [&](double HIJ, size_t I, size_t J) {
+                        add_symmetric_coupling(HIJ, I, J, b_p, sigma_t.data(), nvec);
+                    });
             }
         }
 
@@ -211,24 +268,23 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         //      size_t end_aa_idx = start_aa_idx + bin_aa_size;
         for (size_t K = 0, max_K = aa_size; K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = aa_list_[K];
+                const auto c_dets = aa_list_[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s) and (p != s) and (q != r)) {
                             size_t I = std::get<0>(detI);
                             double sign_q = std::get<1>(detI) > 0.0 ? 1.0 : -1.0;
                             double HIJ = sign_p * sign_q * fci_ints_->tei_aa(p, q, r, s);
-                            sigma_t[I] += HIJ * b_p[J];
-                            sigma_t[J] += HIJ * b_p[I];
+                            add_symmetric_coupling(HIJ, I, J, b_p, sigma_t.data(), nvec);
                         }
                     }
                 }
@@ -238,24 +294,23 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         // BB doubles
         for (size_t K = 0, max_K = bb_list_.size(); K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = bb_list_[K];
+                const auto c_dets = bb_list_[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto& detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s) and (p != s) and (q != r)) {
                             size_t I = std::get<0>(detI);
                             double sign_q = std::get<1>(detI) > 0.0 ? 1.0 : -1.0;
                             double HIJ = sign_p * sign_q * fci_ints_->tei_bb(p, q, r, s);
-                            sigma_t[I] += HIJ * b_p[J];
-                            sigma_t[J] += HIJ * b_p[I];
+                            add_symmetric_coupling(HIJ, I, J, b_p, sigma_t.data(), nvec);
                         }
                     }
                 }
@@ -263,41 +318,104 @@ void SigmaVectorSparseList::compute_sigma(std::shared_ptr<psi::Vector> sigma,
         }
         for (size_t K = 0, max_K = ab_list_.size(); K < max_K; ++K) {
             if ((K % num_thread) == tid) {
-                const std::vector<std::tuple<size_t, short, short>>& c_dets = ab_list_[K];
+                const auto c_dets = ab_list_[K];
                 size_t max_det = c_dets.size();
                 for (size_t det = 0; det < max_det; ++det) {
-                    auto detJ = c_dets[det];
+                    const auto detJ = c_dets[det];
                     size_t J = std::get<0>(detJ);
                     short p = std::abs(std::get<1>(detJ)) - 1;
                     short q = std::get<2>(detJ);
                     double sign_p = std::get<1>(detJ) > 0.0 ? 1.0 : -1.0;
                     for (size_t det2 = det + 1; det2 < max_det; ++det2) {
-                        auto& detI = c_dets[det2];
+                        const auto detI = c_dets[det2];
                         short r = std::abs(std::get<1>(detI)) - 1;
                         short s = std::get<2>(detI);
                         if ((p != r) and (q != s)) {
                             size_t I = std::get<0>(detI);
                             double sign_q = std::get<1>(detI) > 0.0 ? 1.0 : -1.0;
                             double HIJ = sign_p * sign_q * fci_ints_->tei_ab(p, q, r, s);
-                            sigma_t[I] += HIJ * b_p[J];
-                            sigma_t[J] += HIJ * b_p[I];
+                            add_symmetric_coupling(HIJ, I, J, b_p, sigma_t.data(), nvec);
                         }
                     }
                 }
             }
         }
 
+        // the compressed lists (the lists above are empty in this case)
+        if (streaming()) {
+            add_compressed_couplings(b_p, sigma_t.data(), nvec, num_thread, tid);
+        }
+
 #pragma omp critical
-        for (size_t I = 0; I < size_; ++I) {
+        for (size_t I = 0, max_I = size_ * nvec; I < max_I; ++I) {
             // #pragma omp atomic update
             sigma_p[I] += sigma_t[I];
         }
     }
 }
 
-double SigmaVectorSparseList::compute_spin(const std::vector<double>& c) {
-    auto ab_list_ = op_->ab_list_;
+void SigmaVectorSparseList::add_compressed_couplings(const double* b, double* sigma, size_t nvec,
+                                                     size_t num_thread, size_t tid) const {
+    const auto& dets = space_.wfn_hash();
+
+    // a singles
+    a_lists_->for_each_list(num_thread, tid, [&](const auto& c_dets) {
+        for_each_single_coupling(
+            c_dets,
+            [&](size_t J, int p, int q) {
+                return fci_ints_->slater_rules_single_alpha_abs(dets[J], p, q);
+            },
+            [&](double HIJ, size_t I, size_t J) {
+                add_symmetric_coupling(HIJ, I, J, b, sigma, nvec);
+            });
+    });
+
+    // b singles
+    b_lists_->for_each_list(num_thread, tid, [&](const auto& c_dets) {
+        for_each_single_coupling(
+            c_dets,
+            [&](size_t J, int p, int q) {
+                return fci_ints_->slater_rules_single_beta_abs(dets[J], p, q);
+            },
+            [&](double HIJ, size_t I, size_t J) {
+                add_symmetric_coupling(HIJ, I, J, b, sigma, nvec);
+            });
+    });
+
+    // doubles. For same-spin lists the four orbital indices must be distinct
+    auto add_doubles = [&](const CompressedSubstitutionLists& lists, bool same_spin,
+                           auto tei) {
+        lists.for_each_list(num_thread, tid, [&](const auto& c_dets) {
+            for (size_t det = 0, max_det = c_dets.size(); det < max_det; ++det) {
+                const size_t J = c_dets[det].det;
+                const short p = std::abs(c_dets[det].p) - 1;
+                const short q = c_dets[det].q;
+                const double sign_p = c_dets[det].p > 0 ? 1.0 : -1.0;
+                for (size_t det2 = det + 1; det2 < max_det; ++det2) {
+                    const short r = std::abs(c_dets[det2].p) - 1;
+                    const short s = c_dets[det2].q;
+                    if ((p != r) and (q != s) and (not same_spin or ((p != s) and (q != r)))) {
+                        const size_t I = c_dets[det2].det;
+                        const double sign_q = c_dets[det2].p > 0 ? 1.0 : -1.0;
+                        const double HIJ = sign_p * sign_q * tei(p, q, r, s);
+                        add_symmetric_coupling(HIJ, I, J, b, sigma, nvec);
+                    }
+                }
+            }
+        });
+    };
+    add_doubles(*aa_lists_, true, [&](size_t p, size_t q, size_t r, size_t s) {
+        return fci_ints_->tei_aa(p, q, r, s);
+    });
+    add_doubles(*bb_lists_, true, [&](size_t p, size_t q, size_t r, size_t s) {
+        return fci_ints_->tei_bb(p, q, r, s);
+    });
+    add_doubles(*ab_lists_, false, [&](size_t p, size_t q, size_t r, size_t s) {
+        return fci_ints_->tei_ab(p, q, r, s);
+    });
+}
 
+double SigmaVectorSparseList::compute_spin(const std::vector<double>& c) {
     double S2 = 0.0;
     const det_hashvec& wfn_map = space_.wfn_hash();
 
@@ -316,17 +434,15 @@ double SigmaVectorSparseList::compute_spin(const std::vector<double>& c) {
     // Loop directly through all determinants with
     // spin-coupled electrons, i.e:
     // |PhiI> = a+(qa) a+(pb) a-(qb) a-(pa) |PhiJ>
-
-    for (size_t K = 0, max_K = ab_list_.size(); K < max_K; ++K) {
-        const std::vector<std::tuple<size_t, short, short>>& c_dets = ab_list_[K];
-        for (auto& detI : c_dets) {
+    auto add_list = [&](const auto& c_dets) {
+        for (const auto& detI : c_dets) {
             const size_t I = std::get<0>(detI);
             double sign_pq = std::get<1>(detI) > 0.0 ? 1.0 : -1.0;
             short p = std::fabs(std::get<1>(detI)) - 1;
             short q = std::get<2>(detI);
             if (p == q)
                 continue;
-            for (auto& detJ : c_dets) {
+            for (const auto& detJ : c_dets) {
                 const size_t J = std::get<0>(detJ);
                 if (I == J)
                     continue;
@@ -339,6 +455,21 @@ double SigmaVectorSparseList::compute_spin(const std::vector<double>& c) {
                 }
             }
         }
+    };
+
+    if (streaming()) {
+        std::vector<std::tuple<size_t, short, short>> c_dets;
+        ab_lists_->for_each_list(1, 0, [&](const auto& entries) {
+            c_dets.clear();
+            for (const auto& entry : entries) {
+                c_dets.emplace_back(entry.det, entry.p, entry.q);
+            }
+            add_list(c_dets);
+        });
+    } else {
+        for (const auto& c_dets : op_->ab_list_) {
+            add_list(c_dets);
+        }
     }
     return S2;
 }
@@ -358,22 +489,28 @@ void SigmaVectorSparseList::add_generalized_sigma_1(const std::vector<double>& h
         throw std::runtime_error("Incorrect dimension for determinants space.");
     }
 
-    // compute sigma 1
+    // compute sigma 1. With compressed lists, the uncompressed list is built temporarily
     if (spin == "a") {
+        if (streaming())
+            op_->lists_1a(space_);
         add_generalized_sigma1_impl(h1, b, factor, sigma, op_->a_list_);
     } else if (spin == "b") {
+        if (streaming())
+            op_->lists_1b(space_);
         add_generalized_sigma1_impl(h1, b, factor, sigma, op_->b_list_);
     } else {
         std::stringstream ss;
         ss << "Invalid spin label: " << spin << "! Expect a or b";
         throw std::runtime_error(ss.str());
     }
+    if (streaming())
+        op_->clear_op_s_lists();
 }
 
 void SigmaVectorSparseList::add_generalized_sigma1_impl(
     const std::vector<double>& h1, std::shared_ptr<psi::Vector> b, double factor,
     std::vector<double>& sigma,
-    const std::vector<std::vector<std::pair<size_t, short>>>& sub_lists) {
+    const SubstitutionList<1>& sub_lists) {
     auto nactv = fci_ints_->nmo();
     auto b_ptr = b->pointer();
 
@@ -437,22 +574,30 @@ void SigmaVectorSparseList::add_generalized_sigma_2(const std::vector<double>& h
         throw std::runtime_error("Incorrect dimension for determinants space.");
     }
 
-    // compute sigma 2
+    // compute sigma 2. With compressed lists, the uncompressed list is built temporarily
     if (spin == "aa") {
         if (!is_h2hs_antisymmetric(h2))
             throw std::runtime_error("h2 is not antisymmetric!");
+        if (streaming())
+            op_->lists_2aa(space_);
         add_generalized_sigma2_impl(h2, b, factor, sigma, op_->aa_list_);
     } else if (spin == "ab") {
+        if (streaming())
+            op_->lists_2ab(space_);
         add_generalized_sigma2_impl(h2, b, factor, sigma, op_->ab_list_);
     } else if (spin == "bb") {
         if (!is_h2hs_antisymmetric(h2))
             throw std::runtime_error("h2 is not antisymmetric!");
+        if (streaming())
+            op_->lists_2bb(space_);
         add_generalized_sigma2_impl(h2, b, factor, sigma, op_->bb_list_);
     } else {
         std::stringstream ss;
         ss << "Invalid spin label: " << spin << "! Expect aa, ab, or bb";
         throw std::runtime_error(ss.str());
     }
+    if (streaming())
+        op_->clear_tp_s_lists();
 }
 
 bool SigmaVectorSparseList::is_h2hs_antisymmetric(const std::vector<double>& h2) {
@@ -498,7 +643,7 @@ bool SigmaVectorSparseList::is_h2hs_antisymmetric(const std::vector<double>& h2)
 void SigmaVectorSparseList::add_generalized_sigma2_impl(
     const std::vector<double>& h2, std::shared_ptr<psi::Vector> b, double factor,
     std::vector<double>& sigma,
-    const std::vector<std::vector<std::tuple<size_t, short, short>>>& sub_lists) {
+    const SubstitutionList<2>& sub_lists) {
     auto b_ptr = b->pointer();
     auto na = fci_ints_->nmo();
     auto na2 = na * na;
@@ -766,7 +911,7 @@ bool SigmaVectorSparseList::is_h3ls_antisymmetric(const std::vector<double>& h3,
 void SigmaVectorSparseList::add_generalized_sigma3_impl(
     const std::vector<double>& h3, std::shared_ptr<psi::Vector> b, double factor,
     std::vector<double>& sigma,
-    const std::vector<std::vector<std::tuple<size_t, short, short, short>>>& sub_lists) {
+    const SubstitutionList<3>& sub_lists) {
     auto b_ptr = b->pointer();
     auto na = fci_ints_->nmo();
     auto na2 = na * na;
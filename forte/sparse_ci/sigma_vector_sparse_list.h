@@ -29,6 +29,8 @@
 #pragma once
 
 #include "sigma_vector.h"
+#include "sparse_ci/compressed_substitution_lists.h"
+#include "sparse_ci/substitution_list.h"
 
 namespace psi {
 class Vector;
@@ -39,13 +41,22 @@ namespace forte {
 /**
  * @brief The SigmaVectorSparseList class
  * Computes the sigma vector from a creation list sparse Hamiltonian.
+ *
+ * If a memory budget is passed to the constructor, the 1- and 2-body coupling lists are stored
+ * in compressed form (see CompressedSubstitutionLists). The lists that exceed the budget are
+ * written to a scratch file and streamed from disk at each sigma build.
  */
 class SigmaVectorSparseList : public SigmaVector {
   public:
+    /// @param space the determinant space
+    /// @param fci_ints the active space integrals
+    /// @param max_memory the maximum number of doubles used to store the coupling lists. If zero,
+    ///        the lists are stored uncompressed in memory
     SigmaVectorSparseList(const DeterminantHashVec& space,
-                          std::shared_ptr<ActiveSpaceIntegrals> fci_ints);
+                          std::shared_ptr<ActiveSpaceIntegrals> fci_ints, size_t max_memory = 0);
 
     void compute_sigma(std::shared_ptr<psi::Vector> sigma, std::shared_ptr<psi::Vector> b) override;
+    void compute_sigma_block(std::span<double> sigma, std::span<double> b, size_t nvec) override;
     void get_diagonal(psi::Vector& diag) override;
     void add_bad_roots(std::vector<std::vector<std::pair<size_t, double>>>& bad_states_) override;
     double compute_spin(const std::vector<double>& c) override;
@@ -80,6 +91,21 @@ class SigmaVectorSparseList : public SigmaVector {
     bool use_disk_ = false;
     /// Substitutions lists
     std::shared_ptr<DeterminantSubstitutionLists> op_;
+    /// Compressed substitution lists (used if a memory budget is given)
+    std::unique_ptr<CompressedSubstitutionLists> a_lists_;
+    std::unique_ptr<CompressedSubstitutionLists> b_lists_;
+    std::unique_ptr<CompressedSubstitutionLists> aa_lists_;
+    std::unique_ptr<CompressedSubstitutionLists> ab_lists_;
+    std::unique_ptr<CompressedSubstitutionLists> bb_lists_;
+
+    /// @return true if the compressed lists are used
+    bool streaming() const { return a_lists_ != nullptr; }
+    /// Build the compressed lists, with a budget of max_memory doubles
+    void build_compressed_lists(size_t max_memory);
+    /// Add the off-diagonal couplings from the compressed lists assigned to thread tid to an
+    /// interleaved block of sigma vectors
+    void add_compressed_couplings(const double* b, double* sigma, size_t nvec, size_t num_thread,
+                                  size_t tid) const;
 
     /// Compute the contribution to sigma due to 1-body operator
     /// sigma_{I} <- factor * sum_{pq} h_{pq} sum_{J} b_{J} <I|p^+ q|J>
@@ -87,7 +113,7 @@ class SigmaVectorSparseList : public SigmaVector {
     void add_generalized_sigma1_impl(
         const std::vector<double>& h1, std::shared_ptr<psi::Vector> b, double factor,
         std::vector<double>& sigma,
-        const std::vector<std::vector<std::pair<size_t, short>>>& sub_lists);
+        const SubstitutionList<1>& sub_lists);
     /// Compute the contribution to sigma due to 2-body operator
     /// sigma_{I} <- (1/4) * factor * sum_{pqrs} h_{pqrs} sum_{J} b_{J} <I|p^+ q^+ s r|J>
     /// sigma_{I} <- factor * sum_{pqrs} h_{pQrS} sum_{J} b_{J} <I|p^+ Q^+ S r|J>
@@ -96,7 +122,7 @@ class SigmaVectorSparseList : public SigmaVector {
     void add_generalized_sigma2_impl(
         const std::vector<double>& h2, std::shared_ptr<psi::Vector> b, double factor,
         std::vector<double>& sigma,
-        const std::vector<std::vector<std::tuple<size_t, short, short>>>& sub_lists);
+        const SubstitutionList<2>& sub_lists);
     /// Compute the contribution to sigma due to 3-body operator
     /// sigma_{I} <- (1/36) * factor * sum_{pqrstu} h_{pqrstu} sum_{J} b_{J} <I|p^+ q^+ r^+ u t s|J>
     /// sigma_{I} <- (1/4) * factor * sum_{pqRstU} h_{pqRstU} sum_{J} b_{J} <I|p^+ q^+ R^+ U t s|J>
@@ -105,7 +131,7 @@ class SigmaVectorSparseList : public SigmaVector {
     void add_generalized_sigma3_impl(
         const std::vector<double>& h3, std::shared_ptr<psi::Vector> b, double factor,
         std::vector<double>& sigma,
-        const std::vector<std::vector<std::tuple<size_t, short, short, short>>>& sub_lists);
+        const SubstitutionList<3>& sub_lists);
 
     /// Test if h2aa or h2bb is antisymmetric
     bool is_h2hs_antisymmetric(const std::vector<double>& h2);
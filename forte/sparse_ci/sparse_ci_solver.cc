@@ -533,29 +533,45 @@ bool SparseCISolver::davidson_liu_solver(const DeterminantHashVec& space,
     }
 
     // Setup the sigma builder
-    auto sigma_builder = [this, &b_basis, &b, &sigma, &sigma_basis,
-                          &sigma_vector](std::span<double> b_span, std::span<double> sigma_span) {
-        // copy the b vector
-        size_t basis_size = b_span.size();
-        for (size_t I = 0; I < basis_size; ++I) {
-            b_basis->set(I, b_span[I]);
-        }
-        if (spin_adapt_) {
-            // Compute sigma in the CSF basis and convert it to the determinant basis
-            spin_adapter_->csf_C_to_det_C(b_basis, b);
-            sigma_vector->compute_sigma(sigma, b);
-            spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
-        } else {
-            // Compute sigma in the determinant basis
-            sigma_vector->compute_sigma(sigma_basis, b_basis);
+    // The block of b and sigma vectors in the determinant basis. The vectors are interleaved, as
+    // required by SigmaVector::compute_sigma_block
+    std::vector<double> b_block;
+    std::vector<double> sigma_block;
+    auto block_sigma_builder = [this, &b_basis, &b, &sigma, &sigma_basis, &sigma_vector, &b_block,
+                                &sigma_block, fci_size](std::span<double> b_span,
+                                                        std::span<double> sigma_span, size_t nvec) {
+        size_t basis_size = b_span.size() / nvec;
+        b_block.resize(fci_size * nvec);
+        sigma_block.resize(fci_size * nvec);
+        // copy the b vectors, optionally converting them to the determinant basis
+        for (size_t n = 0; n < nvec; ++n) {
+            for (size_t I = 0; I < basis_size; ++I) {
+                b_basis->set(I, b_span[n * basis_size + I]);
+            }
+            if (spin_adapt_) {
+                spin_adapter_->csf_C_to_det_C(b_basis, b);
+            }
+            for (size_t I = 0; I < fci_size; ++I) {
+                b_block[I * nvec + n] = b->get(I);
+            }
         }
-        for (size_t I = 0; I < basis_size; ++I) {
-            sigma_span[I] = sigma_basis->get(I);
+        sigma_vector->compute_sigma_block(sigma_block, b_block, nvec);
+        // copy the sigma vectors, optionally converting them to the CSF basis
+        for (size_t n = 0; n < nvec; ++n) {
+            for (size_t I = 0; I < fci_size; ++I) {
+                sigma->set(I, sigma_block[I * nvec + n]);
+            }
+            if (spin_adapt_) {
+                spin_adapter_->det_C_to_csf_C(sigma, sigma_basis);
+            }
+            for (size_t I = 0; I < basis_size; ++I) {
+                sigma_span[n * basis_size + I] = sigma_basis->get(I);
+            }
         }
     };
 
     // Run the Davidson-Liu solver
-    dl_solver_->add_sigma_builder(sigma_builder);
+    dl_solver_->add_block_sigma_builder(block_sigma_builder);
     auto converged = dl_solver_->solve();
     if (not converged) {
         throw std::runtime_error(
@@ -114,7 +114,9 @@ StateVector SparseExp::apply_operator_cached(const SparseOperator& sop, const St
             const double c = std::get<1>(absc_c_det);
             const Determinant& d = std::get<2>(absc_c_det);
 
-            auto search = couplings_.find(d);
+            // hash d once and reuse the value for the lookup and the insertion
+            const auto hash = couplings_.hash_key(d);
+            auto search = couplings_.find_hashed(d, hash);
 
             if (search == couplings_.end()) {
                 local_timer t_couplings;
@@ -134,12 +136,12 @@ StateVector SparseExp::apply_operator_cached(const SparseOperator& sop, const St
                         d_couplings.push_back(std::make_tuple(n, d_new, value));
                     }
                 }
-                couplings_[d] = d_couplings;
+                search = couplings_.try_emplace_hashed(d, hash, std::move(d_couplings)).first;
                 timings_["couplings"] += t_couplings.get();
             }
             local_timer t_sum;
             // apply the operator
-            const auto& d_couplings = couplings_[d];
+            const auto& d_couplings = search->second;
             for (const auto& op_d_f : d_couplings) {
                 const double value =
                     op_list[std::get<0>(op_d_f)].coefficient() * std::get<2>(op_d_f) * c;
@@ -159,7 +161,8 @@ StateVector SparseExp::apply_operator_cached(const SparseOperator& sop, const St
                 const double c = std::get<1>(absc_c_det);
                 const Determinant& d = std::get<2>(absc_c_det);
 
-                auto search = couplings_dexc_.find(d);
+                const auto hash = couplings_dexc_.hash_key(d);
+                auto search = couplings_dexc_.find_hashed(d, hash);
 
                 if (search == couplings_dexc_.end()) {
                     local_timer t_couplings;
@@ -179,12 +182,13 @@ StateVector SparseExp::apply_operator_cached(const SparseOperator& sop, const St
                             d_couplings.push_back(std::make_tuple(n, d_new, value));
                         }
                     }
-                    couplings_dexc_[d] = d_couplings;
+                    search =
+                        couplings_dexc_.try_emplace_hashed(d, hash, std::move(d_couplings)).first;
                     timings_["couplings"] += t_couplings.get();
                 }
                 local_timer t_sum;
                 // apply the operator
-                const auto& d_couplings = couplings_dexc_[d];
+                const auto& d_couplings = search->second;
                 for (const auto& op_d_f : d_couplings) {
                     const double value =
                         op_list[std::get<0>(op_d_f)].coefficient() * std::get<2>(op_d_f) * c;
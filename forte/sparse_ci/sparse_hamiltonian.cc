@@ -26,15 +26,33 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include <cmath>
 
+#include "forte-def.h"
 #include "sparse_ci/sparse_hamiltonian.h"
 
 namespace forte {
 
+namespace {
+/// The number of determinants of the input state processed together by a thread. This is fixed so
+/// that the order of the floating point operations does not depend on the number of threads
+constexpr size_t sigma_block_size = 256;
+} // namespace
+
 SparseHamiltonian::SparseHamiltonian(std::shared_ptr<ActiveSpaceIntegrals> as_ints)
     : as_ints_(as_ints) {}
 
+void SparseHamiltonian::set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
+int SparseHamiltonian::num_threads() const {
+    // If we are running DiskDF then we need to revert to a single thread loop
+    if (as_ints_->get_integral_type() == DiskDF) {
+        return 1;
+    }
+    return num_threads_ > 0 ? num_threads_ : omp_get_max_threads();
+}
+
 StateVector SparseHamiltonian::compute(const StateVector& state, double screen_thresh) {
     // store a list of determinants that we have never encountered before
     std::vector<Determinant> new_dets;
@@ -62,19 +80,22 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
     size_t nmo = as_ints_->nmo();
     auto symm = as_ints_->active_mo_symmetry();
 
-    Determinant new_det;
-
     // contribution to the diagonal elements
     double E_0 = as_ints_->nuclear_repulsion_energy() + as_ints_->scalar_energy();
 
-    for (const auto& det : new_dets) {
-        std::vector<std::pair<size_t, double>> det_couplings;
+    // generate the couplings of each new determinant in parallel. The determinants are assigned
+    // an index in sigma_hash_ afterwards, following the order of new_dets
+    const size_t ndets = new_dets.size();
+    std::vector<std::vector<std::pair<Determinant, double>>> new_det_couplings(ndets);
 
-        size_t det_sigma_idx = sigma_hash_.add(det);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+    for (size_t n = 0; n < ndets; n++) {
+        const Determinant& det = new_dets[n];
+        auto& det_couplings = new_det_couplings[n];
+        Determinant new_det;
 
         // diagonal couplings
-        // couplings_.emplace_back(det_idx, det_sigma_idx, E_0 + as_ints_->slater_rules(det, det));
-        det_couplings.emplace_back(det_sigma_idx, E_0 + as_ints_->slater_rules(det, det));
+        det_couplings.emplace_back(det, E_0 + as_ints_->slater_rules(det, det));
 
         std::vector<int> aocc = det.get_alfa_occ(nmo);
         std::vector<int> bocc = det.get_beta_occ(nmo);
@@ -95,8 +116,7 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
                         new_det = det;
                         new_det.set_alfa_bit(i, false);
                         new_det.set_alfa_bit(a, true);
-                        size_t new_det_sigma_idx = sigma_hash_.add(new_det);
-                        det_couplings.emplace_back(new_det_sigma_idx, DHIJ);
+                        det_couplings.emplace_back(new_det, DHIJ);
                     }
                 }
             }
@@ -110,8 +130,7 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
                         new_det = det;
                         new_det.set_beta_bit(i, false);
                         new_det.set_beta_bit(a, true);
-                        size_t new_det_sigma_idx = sigma_hash_.add(new_det);
-                        det_couplings.emplace_back(new_det_sigma_idx, DHIJ);
+                        det_couplings.emplace_back(new_det, DHIJ);
                     }
                 }
             }
@@ -130,8 +149,7 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
                             if (std::abs(DHIJ) >= screen_thresh) {
                                 new_det = det;
                                 DHIJ *= new_det.double_excitation_aa(i, j, a, b);
-                                size_t new_det_sigma_idx = sigma_hash_.add(new_det);
-                                det_couplings.emplace_back(new_det_sigma_idx, DHIJ);
+                                det_couplings.emplace_back(new_det, DHIJ);
                             }
                         }
                     }
@@ -148,8 +166,7 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
                             if (std::abs(DHIJ) >= screen_thresh) {
                                 new_det = det;
                                 DHIJ *= new_det.double_excitation_ab(i, j, a, b);
-                                size_t new_det_sigma_idx = sigma_hash_.add(new_det);
-                                det_couplings.emplace_back(new_det_sigma_idx, DHIJ);
+                                det_couplings.emplace_back(new_det, DHIJ);
                             }
                         }
                     }
@@ -170,8 +187,7 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
                             if (std::abs(DHIJ) >= screen_thresh) {
                                 new_det = det;
                                 DHIJ *= new_det.double_excitation_bb(i, j, a, b);
-                                size_t new_det_sigma_idx = sigma_hash_.add(new_det);
-                                det_couplings.emplace_back(new_det_sigma_idx, DHIJ);
+                                det_couplings.emplace_back(new_det, DHIJ);
                             }
                         }
                     }
@@ -182,7 +198,15 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
         sort(begin(det_couplings), end(det_couplings), [](auto const& a, auto const& b) {
             return std::fabs(a.second) > std::fabs(b.second);
         });
-        couplings_[det] = det_couplings;
+    }
+
+    for (size_t n = 0; n < ndets; n++) {
+        std::vector<std::pair<size_t, double>> det_couplings;
+        det_couplings.reserve(new_det_couplings[n].size());
+        for (const auto& [new_det, HIJ] : new_det_couplings[n]) {
+            det_couplings.emplace_back(sigma_hash_.add(new_det), HIJ);
+        }
+        couplings_[new_dets[n]] = std::move(det_couplings);
     }
     timings_["coupling_time"] += t.get();
     timings_["time"] += t.get();
@@ -191,28 +215,46 @@ void SparseHamiltonian::compute_new_couplings(const std::vector<Determinant>& ne
 StateVector SparseHamiltonian::compute_sigma(const StateVector& state, double screen_thresh) {
     local_timer t;
 
-    std::vector<double> sigma_c(sigma_hash_.size(), 0.0);
+    // each block of determinants collects its contributions to sigma, which are then added in the
+    // order of the blocks. This gives the same result for any number of threads
+    const size_t ndets = state.size();
+    const size_t nblocks = (ndets + sigma_block_size - 1) / sigma_block_size;
+    std::vector<std::vector<std::pair<size_t, double>>> block_sigma(nblocks);
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads())
+    for (size_t b = 0; b < nblocks; b++) {
+        auto& contributions = block_sigma[b];
+        const auto begin = state.begin() + b * sigma_block_size;
+        const auto end = state.begin() + std::min(ndets, (b + 1) * sigma_block_size);
+        for (auto it = begin; it != end; ++it) {
+            const auto& det = it->first;
+            const double c = it->second;
+            for (const auto& new_det_HIJ : couplings_.find(det)->second) {
+                const size_t new_det_idx = new_det_HIJ.first;
+                const double h = new_det_HIJ.second;
+                // since the couplings are sorted in decreasing magnitude
+                // once an element falls below the threshold we can just
+                // terminate the loop
+                if (std::fabs(c * h) > screen_thresh) {
+                    contributions.emplace_back(new_det_idx, c * h);
+                } else {
+                    break;
+                }
+            }
+        }
+    }
 
     // compute the sigma vector
-    for (const auto& det_c : state) {
-        const auto& det = det_c.first;
-        const double c = det_c.second;
-        for (const auto& new_det_HIJ : couplings_[det]) {
-            const size_t new_det_idx = new_det_HIJ.first;
-            const double h = new_det_HIJ.second;
-            // since the couplings are sorted in decreasing magnitude
-            // once an element falls below the threshold we can just
-            // terminate the loop
-            if (std::fabs(c * h) > screen_thresh) {
-                sigma_c[new_det_idx] += c * h;
-            } else {
-                break;
-            }
+    std::vector<double> sigma_c(sigma_hash_.size(), 0.0);
+    for (const auto& contributions : block_sigma) {
+        for (const auto& [new_det_idx, value] : contributions) {
+            sigma_c[new_det_idx] += value;
         }
     }
 
     // copy data to a StateVector object
     StateVector sigma;
+    sigma.map().reserve(sigma_hash_.size());
     for (size_t n = 0, maxn = sigma_hash_.size(); n < maxn; n++) {
         sigma[sigma_hash_.get_det(n)] = sigma_c[n];
     }
@@ -225,120 +267,124 @@ StateVector SparseHamiltonian::compute_sigma(const StateVector& state, double sc
 StateVector SparseHamiltonian::compute_on_the_fly(const StateVector& state, double screen_thresh) {
     local_timer t;
 
-    // initialize a state object
-    StateVector sigma;
-
     size_t nmo = as_ints_->nmo();
 
     auto symm = as_ints_->active_mo_symmetry();
 
-    Determinant new_det;
+    // apply H to the determinants [begin, end) of state
+    auto apply_to_block = [&](size_t begin, size_t end, StateVector& sigma) {
+        Determinant new_det;
+        for (auto it = state.begin() + begin, it_end = state.begin() + end; it != it_end; ++it) {
+            const Determinant& det = it->first;
+            const double c = it->second;
 
-    for (const auto& det_c : state) {
-        const Determinant& det = det_c.first;
-        const double c = det_c.second;
+            std::vector<int> aocc = det.get_alfa_occ(nmo);
+            std::vector<int> bocc = det.get_beta_occ(nmo);
+            std::vector<int> avir = det.get_alfa_vir(nmo);
+            std::vector<int> bvir = det.get_beta_vir(nmo);
 
-        std::vector<int> aocc = det.get_alfa_occ(nmo);
-        std::vector<int> bocc = det.get_beta_occ(nmo);
-        std::vector<int> avir = det.get_alfa_vir(nmo);
-        std::vector<int> bvir = det.get_beta_vir(nmo);
-
-        size_t noalpha = aocc.size();
-        size_t nobeta = bocc.size();
-        size_t nvalpha = avir.size();
-        size_t nvbeta = bvir.size();
+            size_t noalpha = aocc.size();
+            size_t nobeta = bocc.size();
+            size_t nvalpha = avir.size();
+            size_t nvbeta = bvir.size();
 
-        double E_0 = as_ints_->nuclear_repulsion_energy() + as_ints_->scalar_energy();
+            double E_0 = as_ints_->nuclear_repulsion_energy() + as_ints_->scalar_energy();
 
-        sigma[det] += (E_0 + as_ints_->slater_rules(det, det)) * c;
-        // aa singles
-        for (size_t i : aocc) {
-            for (size_t a : avir) {
-                if ((symm[i] ^ symm[a]) == 0) {
-                    double DHIJ = as_ints_->slater_rules_single_alpha(det, i, a);
-                    if (std::abs(DHIJ * c) >= screen_thresh) {
-                        new_det = det;
-                        new_det.set_alfa_bit(i, false);
-                        new_det.set_alfa_bit(a, true);
-                        sigma[new_det] += DHIJ * c;
+            sigma[det] += (E_0 + as_ints_->slater_rules(det, det)) * c;
+            // aa singles
+            for (size_t i : aocc) {
+                for (size_t a : avir) {
+                    if ((symm[i] ^ symm[a]) == 0) {
+                        double DHIJ = as_ints_->slater_rules_single_alpha(det, i, a);
+                        if (std::abs(DHIJ * c) >= screen_thresh) {
+                            new_det = det;
+                            new_det.set_alfa_bit(i, false);
+                            new_det.set_alfa_bit(a, true);
+                            sigma[new_det] += DHIJ * c;
+                        }
                     }
                 }
             }
-        }
-        // bb singles
-        for (size_t i : bocc) {
-            for (size_t a : bvir) {
-                if ((symm[i] ^ symm[a]) == 0) {
-                    double DHIJ = as_ints_->slater_rules_single_beta(det, i, a);
-                    if (std::abs(DHIJ * c) >= screen_thresh) {
-                        new_det = det;
-                        new_det.set_beta_bit(i, false);
-                        new_det.set_beta_bit(a, true);
-                        sigma[new_det] += DHIJ * c;
+            // bb singles
+            for (size_t i : bocc) {
+                for (size_t a : bvir) {
+                    if ((symm[i] ^ symm[a]) == 0) {
+                        double DHIJ = as_ints_->slater_rules_single_beta(det, i, a);
+                        if (std::abs(DHIJ * c) >= screen_thresh) {
+                            new_det = det;
+                            new_det.set_beta_bit(i, false);
+                            new_det.set_beta_bit(a, true);
+                            sigma[new_det] += DHIJ * c;
+                        }
                     }
                 }
             }
-        }
-        // Generate aa excitations
-        for (size_t ii = 0; ii < noalpha; ++ii) {
-            size_t i = aocc[ii];
-            for (size_t jj = ii + 1; jj < noalpha; ++jj) {
-                size_t j = aocc[jj];
-                for (size_t aa = 0; aa < nvalpha; ++aa) {
-                    size_t a = avir[aa];
-                    for (size_t bb = aa + 1; bb < nvalpha; ++bb) {
-                        size_t b = avir[bb];
-                        if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
-                            double DHIJ = as_ints_->tei_aa(i, j, a, b);
-                            if (std::abs(DHIJ * c) >= screen_thresh) {
-                                new_det = det;
-                                DHIJ *= new_det.double_excitation_aa(i, j, a, b);
-                                sigma[new_det] += DHIJ * c;
+            // Generate aa excitations
+            for (size_t ii = 0; ii < noalpha; ++ii) {
+                size_t i = aocc[ii];
+                for (size_t jj = ii + 1; jj < noalpha; ++jj) {
+                    size_t j = aocc[jj];
+                    for (size_t aa = 0; aa < nvalpha; ++aa) {
+                        size_t a = avir[aa];
+                        for (size_t bb = aa + 1; bb < nvalpha; ++bb) {
+                            size_t b = avir[bb];
+                            if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
+                                double DHIJ = as_ints_->tei_aa(i, j, a, b);
+                                if (std::abs(DHIJ * c) >= screen_thresh) {
+                                    new_det = det;
+                                    DHIJ *= new_det.double_excitation_aa(i, j, a, b);
+                                    sigma[new_det] += DHIJ * c;
+                                }
                             }
                         }
                     }
                 }
             }
-        }
-        // Generate ab excitations
-        for (size_t i : aocc) {
-            for (size_t j : bocc) {
-                for (size_t a : avir) {
-                    for (size_t b : bvir) {
-                        if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
-                            double DHIJ = as_ints_->tei_ab(i, j, a, b);
-                            if (std::abs(DHIJ * c) >= screen_thresh) {
-                                new_det = det;
-                                DHIJ *= new_det.double_excitation_ab(i, j, a, b);
-                                sigma[new_det] += DHIJ * c;
+            // Generate ab excitations
+            for (size_t i : aocc) {
+                for (size_t j : bocc) {
+                    for (size_t a : avir) {
+                        for (size_t b : bvir) {
+                            if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
+                                double DHIJ = as_ints_->tei_ab(i, j, a, b);
+                                if (std::abs(DHIJ * c) >= screen_thresh) {
+                                    new_det = det;
+                                    DHIJ *= new_det.double_excitation_ab(i, j, a, b);
+                                    sigma[new_det] += DHIJ * c;
+                                }
                             }
                         }
                     }
                 }
             }
-        }
-        // Generate bb excitations
-        for (size_t ii = 0; ii < nobeta; ++ii) {
-            size_t i = bocc[ii];
-            for (size_t jj = ii + 1; jj < nobeta; ++jj) {
-                size_t j = bocc[jj];
-                for (size_t aa = 0; aa < nvbeta; ++aa) {
-                    size_t a = bvir[aa];
-                    for (size_t bb = aa + 1; bb < nvbeta; ++bb) {
-                        size_t b = bvir[bb];
-                        if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
-                            double DHIJ = as_ints_->tei_bb(i, j, a, b);
-                            if (std::abs(DHIJ * c) >= screen_thresh) {
-                                new_det = det;
-                                DHIJ *= new_det.double_excitation_bb(i, j, a, b);
-                                sigma[new_det] += DHIJ * c;
+            // Generate bb excitations
+            for (size_t ii = 0; ii < nobeta; ++ii) {
+                size_t i = bocc[ii];
+                for (size_t jj = ii + 1; jj < nobeta; ++jj) {
+                    size_t j = bocc[jj];
+                    for (size_t aa = 0; aa < nvbeta; ++aa) {
+                        size_t a = bvir[aa];
+                        for (size_t bb = aa + 1; bb < nvbeta; ++bb) {
+                            size_t b = bvir[bb];
+                            if ((symm[i] ^ symm[j] ^ symm[a] ^ symm[b]) == 0) {
+                                double DHIJ = as_ints_->tei_bb(i, j, a, b);
+                                if (std::abs(DHIJ * c) >= screen_thresh) {
+                                    new_det = det;
+                                    DHIJ *= new_det.double_excitation_bb(i, j, a, b);
+                                    sigma[new_det] += DHIJ * c;
+                                }
                             }
                         }
                     }
                 }
             }
         }
-    }
+    };
+
+    // compute sigma block by block
+    StateVector sigma =
+        parallel_accumulate(state.size(), apply_to_block, num_threads(), sigma_block_size);
+
     timings_["total"] += t.get();
     timings_["on_the_fly"] += t.get();
     return sigma;
@@ -67,7 +67,13 @@ class SparseHamiltonian {
     /// @return timings for this class
     std::map<std::string, double> timings() const;
 
+    /// @brief Set the number of threads used to apply H
+    /// @param num_threads the number of threads (0 = use all the available threads)
+    void set_num_threads(int num_threads);
+
   private:
+    /// @return the number of threads used to apply H
+    int num_threads() const;
     /// Compute couplings for new determinants
     void compute_new_couplings(const std::vector<Determinant>& new_dets, double screen_thresh);
     /// Compute sigma using the couplings
@@ -84,6 +90,8 @@ class SparseHamiltonian {
     // std::vector<std::tuple<size_t, size_t, double>> couplings_;
     /// A map that stores timing information
     std::map<std::string, double> timings_;
+    /// The number of threads used to apply H (0 = use all the available threads)
+    int num_threads_ = 0;
 };
 
 } // namespace forte
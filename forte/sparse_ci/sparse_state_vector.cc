@@ -37,9 +37,16 @@
 
 #include "sparse_ci/sparse_state_vector.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#endif
+
 namespace forte {
 
-StateVector::StateVector(const det_hash<double>& state_vec) : state_vec_(state_vec) {}
+StateVector::StateVector(const det_hash<double>& state_vec)
+    : state_vec_(state_vec.begin(), state_vec.end()) {}
 
 bool StateVector::operator==(const StateVector& lhs) const {
     // double zero = 1.0e-14;
@@ -87,7 +94,8 @@ StateVector apply_operator_safe(SparseOperator& sop, const StateVector& state) {
     return new_state;
 }
 
-StateVector apply_operator(SparseOperator& sop, const StateVector& state, double screen_thresh) {
+StateVector apply_operator(SparseOperator& sop, const StateVector& state, double screen_thresh,
+                           int num_threads) {
     // make a copy of the state
     std::vector<std::tuple<double, double, Determinant>> state_sorted(state.size());
     size_t k = 0;
@@ -100,65 +108,110 @@ StateVector apply_operator(SparseOperator& sop, const StateVector& state, double
     std::sort(state_sorted.rbegin(), state_sorted.rend());
 
     const auto& op_list = sop.op_list();
+    const bool antihermitian = sop.is_antihermitian();
 
-    StateVector new_terms;
-
-    Determinant d;
-    double c;
-    double absc;
+    // apply the operator to the determinants [begin, end) of state_sorted. Since state_sorted is
+    // sorted in decreasing order of |c|, each block is also sorted and we can stop the loop over
+    // the determinants as soon as |t * c| falls below the threshold
+    auto apply_to_block = [&](size_t begin, size_t end, StateVector& new_terms) {
+        for (const SQOperator& sqop : op_list) {
+            if (sqop.coefficient() == 0.0)
+                continue;
+            apply_sqop_to_sorted_state(sqop, false, state_sorted, begin, end, screen_thresh,
+                                       [&](const Determinant& d, double value) {
+                                           new_terms[d] += value;
+                                       });
+        }
 
-    // loop over all the operators
-    for (const SQOperator& sqop : op_list) {
-        if (sqop.coefficient() == 0.0)
-            continue;
-        // create a mask for screening determinants according to the creation operators
-        // this mask looks only at creation operators that are not preceeded by annihilation
-        // operators
-        const Determinant ucre = sqop.cre() - sqop.ann();
-        // loop over all determinants
-        for (const auto& absc_c_det : state_sorted) {
-            std::tie(absc, c, d) = absc_c_det;
-            // screen according to the product tau * c
-            if (std::fabs(sqop.coefficient() * c) > screen_thresh) {
-                // check if this operator can be applied
-                if (d.fast_a_and_b_equal_b(sqop.ann()) and d.fast_a_and_b_eq_zero(ucre)) {
-                    double value =
-                        apply_op_safe(d, sqop.cre(), sqop.ann()) * sqop.coefficient() * c;
-                    new_terms[d] += value;
-                }
-            } else {
-                break;
+        if (antihermitian) {
+            for (const SQOperator& sqop : op_list) {
+                if (sqop.coefficient() == 0.0)
+                    continue;
+                apply_sqop_to_sorted_state(sqop, true, state_sorted, begin, end, screen_thresh,
+                                           [&](const Determinant& d, double value) {
+                                               new_terms[d] -= value;
+                                           });
             }
         }
+    };
+
+    return parallel_accumulate(state_sorted.size(), apply_to_block, num_threads);
+}
+
+namespace {
+/// The number of shards used to sum the blocks in parallel_accumulate. It is independent of the
+/// number of threads, so that the order of the result is too
+constexpr size_t parallel_accumulate_num_shards = 64;
+} // namespace
+
+StateVector parallel_accumulate(size_t n,
+                                const std::function<void(size_t, size_t, StateVector&)>& f,
+                                int num_threads, size_t block_size) {
+    if (num_threads <= 0) {
+        num_threads = omp_get_max_threads();
     }
+    block_size = std::max(block_size, size_t(1));
+    const size_t nblocks = (n + block_size - 1) / block_size;
 
-    if (sop.is_antihermitian()) {
-        // loop over all the operators
-        for (const SQOperator& sqop : op_list) {
-            if (sqop.coefficient() == 0.0)
-                continue;
-            // create a mask for screening determinants according to the creation operators
-            // this mask looks only at creation operators that are not preceeded by annihilation
-            // operators
-            const Determinant ucre = sqop.ann() - sqop.cre();
-            // loop over all determinants
-            for (const auto& absc_c_det : state_sorted) {
-                std::tie(absc, c, d) = absc_c_det;
-                // screen according to the product tau * c
-                if (std::fabs(sqop.coefficient() * c) > screen_thresh) {
-                    // check if this operator can be applied
-                    if (d.fast_a_and_b_equal_b(sqop.cre()) and d.fast_a_and_b_eq_zero(ucre)) {
-                        double value =
-                            apply_op_safe(d, sqop.ann(), sqop.cre()) * sqop.coefficient() * c;
-                        new_terms[d] -= value;
-                    }
-                } else {
-                    break;
-                }
+    // a single block requires no reduction
+    if (nblocks <= 1) {
+        StateVector result;
+        if (n > 0) {
+            f(0, n, result);
+        }
+        return result;
+    }
+
+    // compute the contribution of each block and scatter it into one bucket per shard. Each shard
+    // owns the determinants whose hash (upper bits) modulo the number of shards is equal to the
+    // shard index
+    struct Term {
+        Determinant d;
+        uint64_t hash;
+        double c;
+    };
+    const size_t nshards = parallel_accumulate_num_shards;
+    std::vector<std::vector<std::vector<Term>>> buckets(nblocks);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+    for (size_t b = 0; b < nblocks; b++) {
+        StateVector block_result;
+        f(b * block_size, std::min(n, (b + 1) * block_size), block_result);
+        const auto& map = block_result.map();
+        auto& block_buckets = buckets[b];
+        block_buckets.resize(nshards);
+        for (const auto& [d, c] : map) {
+            const auto hash = map.hash_key(d);
+            block_buckets[(hash >> 32) % nshards].push_back({d, hash, c});
+        }
+    }
+
+    // sum the buckets of each shard in block order. The shards are disjoint and are summed
+    // concurrently
+    std::vector<StateVector> shards(nshards);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+    for (size_t s = 0; s < nshards; s++) {
+        auto& shard = shards[s].map();
+        for (auto& block_buckets : buckets) {
+            for (const auto& [d, hash, c] : block_buckets[s]) {
+                shard.try_emplace_hashed(d, hash, 0.0).first->second += c;
             }
+            std::vector<Term>().swap(block_buckets[s]);
+        }
+    }
+
+    // the shards are disjoint, so we only need to concatenate them
+    size_t nresult = 0;
+    for (const auto& shard : shards) {
+        nresult += shard.size();
+    }
+    StateVector result;
+    result.map().reserve(nresult);
+    for (const auto& shard : shards) {
+        for (const auto& [d, c] : shard) {
+            result.map().try_emplace(d, c);
         }
     }
-    return new_terms;
+    return result;
 }
 
 std::vector<double> get_projection(SparseOperator& sop, const StateVector& ref,
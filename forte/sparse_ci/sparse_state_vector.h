@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <unordered_map>
 
@@ -46,9 +47,9 @@ class StateVector {
     StateVector(const det_hash<double>& state_vec);
 
     /// @return the map that holds the determinants
-    det_hash<double>& map() { return state_vec_; }
+    det_flat_hash<double>& map() { return state_vec_; }
     /// @return the map that holds the determinants
-    const det_hash<double>& map() const { return state_vec_; }
+    const det_flat_hash<double>& map() const { return state_vec_; }
     /// @return true if the two states are identical
     bool operator==(const StateVector& lhs) const;
 
@@ -78,7 +79,7 @@ class StateVector {
 
   private:
     /// Holds an unordered map Determinant -> double
-    det_hash<double> state_vec_;
+    det_flat_hash<double> state_vec_;
 };
 
 // Functions to apply operators, gop |state>
@@ -96,7 +97,25 @@ double overlap(StateVector& left_state, StateVector& right_state);
 /// safe implementation of apply operator
 StateVector apply_operator_safe(SparseOperator& sop, const StateVector& state);
 /// fast implementation of apply operator based on sorting
+/// @param num_threads the number of threads used (0 = use all the available threads)
 StateVector apply_operator(SparseOperator& sop, const StateVector& state0,
-                           double screen_thresh = 1.0e-12);
+                           double screen_thresh = 1.0e-12, int num_threads = 0);
+
+/// @brief Build a StateVector from contributions computed in parallel
+///
+/// The items [0, n) are split into blocks of block_size items. Each block is processed by a single
+/// thread that adds its contributions to a private StateVector and scatters them into a fixed
+/// number of shards according to the hash of the determinants. Each shard then sums its part of
+/// the blocks in order. Since neither the blocks nor the shards depend on the number of threads,
+/// the result (including the order of its elements) is the same for any number of threads.
+///
+/// @param n the number of items
+/// @param f a function f(begin, end, result) that adds the contributions of the items
+///          [begin, end) to result
+/// @param num_threads the number of threads used (0 = use all the available threads)
+/// @param block_size the number of items in a block
+StateVector parallel_accumulate(size_t n,
+                                const std::function<void(size_t, size_t, StateVector&)>& f,
+                                int num_threads = 0, size_t block_size = 256);
 
 } // namespace forte
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <cmath>
+#include <tuple>
 #include <vector>
 
 #include "sparse_ci/determinant.h"
@@ -116,4 +118,31 @@ class SQOperator {
     Determinant ann_;
 };
 
+/**
+ * @brief Apply an operator (or its adjoint) to the determinants [begin, end) of a state stored as
+ * tuples (|c|, c, det) sorted in decreasing order of |c|.
+ *
+ * For each determinant that is not annihilated by the operator this calls f(new_det, value), with
+ * value = sign * t * c. The loop stops at the first determinant with |t * c| <= screen_thresh.
+ */
+template <class F>
+void apply_sqop_to_sorted_state(const SQOperator& sqop, bool adjoint,
+                                const std::vector<std::tuple<double, double, Determinant>>& state,
+                                size_t begin, size_t end, double screen_thresh, F&& f) {
+    const Determinant& cre = adjoint ? sqop.ann() : sqop.cre();
+    const Determinant& ann = adjoint ? sqop.cre() : sqop.ann();
+    // this mask looks only at creation operators that are not preceeded by annihilation operators
+    const Determinant ucre = cre - ann;
+    for (size_t I = begin; I < end; ++I) {
+        const auto& [absc, c, d] = state[I];
+        if (std::fabs(sqop.coefficient() * c) <= screen_thresh)
+            break;
+        if (d.fast_a_and_b_equal_b(ann) and d.fast_a_and_b_eq_zero(ucre)) {
+            Determinant new_d(d);
+            const double value = apply_op_safe(new_d, cre, ann) * sqop.coefficient() * c;
+            f(new_d, value);
+        }
+    }
+}
+
 } // namespace forte
@@ -0,0 +1,176 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace forte {
+
+/**
+ * @brief The SubstitutionList class
+ * Stores the groups of determinants built by DeterminantSubstitutionLists in compressed sparse
+ * row (CSR) form.
+ *
+ * An entry of a group is the index of a determinant and NLabels signed orbital labels. The entries
+ * of all the groups are packed one after the other in two arrays, one with the determinant indices
+ * and one with the labels, and group K spans the entries [offsets[K], offsets[K + 1]). This avoids
+ * one allocation per group and the padding of std::pair<size_t, short> (16 bytes instead of 10).
+ *
+ * An entry is returned by value as a std::pair<size_t, short> (NLabels = 1) or a
+ * std::tuple<size_t, short, ...> (NLabels > 1), so it can be unpacked with structured bindings
+ * exactly like the elements of a std::vector<std::vector<std::pair<size_t, short>>>.
+ */
+template <size_t NLabels> class SubstitutionList {
+  public:
+    using labels_type = std::array<short, NLabels>;
+    using value_type = std::conditional_t<
+        NLabels == 1, std::pair<size_t, short>,
+        std::conditional_t<NLabels == 2, std::tuple<size_t, short, short>,
+                           std::tuple<size_t, short, short, short>>>;
+
+    static_assert(NLabels >= 1 and NLabels <= 3, "SubstitutionList supports 1 to 3 labels");
+
+    /// A read-only view of a group of entries
+    class Group {
+      public:
+        class iterator {
+          public:
+            iterator(const Group* group, size_t n) : group_(group), n_(n) {}
+            value_type operator*() const { return (*group_)[n_]; }
+            iterator& operator++() {
+                ++n_;
+                return *this;
+            }
+            bool operator==(const iterator& other) const { return n_ == other.n_; }
+            bool operator!=(const iterator& other) const { return n_ != other.n_; }
+
+          private:
+            const Group* group_;
+            size_t n_;
+        };
+
+        Group(const size_t* dets, const labels_type* labels, size_t size)
+            : dets_(dets), labels_(labels), size_(size) {}
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        value_type operator[](size_t n) const {
+            const auto& l = labels_[n];
+            if constexpr (NLabels == 1) {
+                return {dets_[n], l[0]};
+            } else if constexpr (NLabels == 2) {
+                return {dets_[n], l[0], l[1]};
+            } else {
+                return {dets_[n], l[0], l[1], l[2]};
+            }
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, size_); }
+
+      private:
+        const size_t* dets_;
+        const labels_type* labels_;
+        size_t size_;
+    };
+
+    class iterator {
+      public:
+        iterator(const SubstitutionList* list, size_t K) : list_(list), K_(K) {}
+        Group operator*() const { return (*list_)[K_]; }
+        iterator& operator++() {
+            ++K_;
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return K_ == other.K_; }
+        bool operator!=(const iterator& other) const { return K_ != other.K_; }
+
+      private:
+        const SubstitutionList* list_;
+        size_t K_;
+    };
+
+    /// @return the number of groups
+    size_t size() const { return offsets_.size() - 1; }
+    bool empty() const { return size() == 0; }
+    /// @return the total number of entries
+    size_t num_entries() const { return dets_.size(); }
+
+    /// @return a view of group K
+    Group operator[](size_t K) const {
+        return Group(dets_.data() + offsets_[K], labels_.data() + offsets_[K],
+                     offsets_[K + 1] - offsets_[K]);
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+
+    /// Append a group
+    void push_back(const std::vector<value_type>& group) {
+        for (const auto& entry : group) {
+            std::apply(
+                [&](size_t det, auto... labels) {
+                    dets_.push_back(det);
+                    labels_.push_back(labels_type{static_cast<short>(labels)...});
+                },
+                entry);
+        }
+        offsets_.push_back(dets_.size());
+    }
+
+    /// Remove all the groups
+    void clear() {
+        offsets_.assign(1, 0);
+        dets_.clear();
+        labels_.clear();
+    }
+
+    /// Release the unused memory
+    void shrink_to_fit() {
+        offsets_.shrink_to_fit();
+        dets_.shrink_to_fit();
+        labels_.shrink_to_fit();
+    }
+
+  private:
+    /// The first entry of each group (one extra element marks the end)
+    std::vector<size_t> offsets_ = {0};
+    /// The determinant index of each entry
+    std::vector<size_t> dets_;
+    /// The orbital labels of each entry
+    std::vector<labels_type> labels_;
+};
+
+} // namespace forte
@@ -0,0 +1,108 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Forte: an open-source plugin to Psi4 (https://github.com/psi4/psi4)
+ * that implements a variety of quantum chemistry methods for strongly
+ * correlated electrons.
+ *
+ * Copyright (c) 2012-2024 by its authors (see COPYING, COPYING.LESSER, AUTHORS).
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ *
+ * @END LICENSE
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
+#include "sparse_ci/compressed_substitution_lists.h"
+
+// Kernels over the 1-body substitution lists of DeterminantSubstitutionLists that are shared by
+// the selected CI codes (SigmaVectorSparseList, CI_RDMS) and by forte_benchmarks. They only depend
+// on the lists, so the coefficients and the matrix elements are passed in as callables.
+
+namespace forte {
+
+namespace detail {
+/// @return the determinant index and the signed orbital label of a 1-body entry
+inline std::pair<size_t, short> single_entry(const std::pair<size_t, short>& entry) {
+    return entry;
+}
+inline std::pair<size_t, short> single_entry(const SubstitutionListEntry& entry) {
+    return {entry.det, entry.p};
+}
+} // namespace detail
+
+/**
+ * @brief Visit the pairs of determinants coupled by a single substitution within a group of a
+ * 1-body list (a SubstitutionList<1>::Group or a list decoded by CompressedSubstitutionLists).
+ *
+ * For each pair of entries (J, p) and (I, q), with I after J in the group and p != q, this calls
+ * f(HIJ, I, J) with HIJ = hij(J, p, q) * sign_p * sign_q, where hij(J, p, q) is the matrix element
+ * of the single substitution p -> q of determinant J without its sign.
+ */
+template <class Group, class HIJ, class F>
+void for_each_single_coupling(const Group& group, HIJ&& hij, F&& f) {
+    for (size_t det = 0, max_det = group.size(); det < max_det; ++det) {
+        const auto [J, _p] = detail::single_entry(group[det]);
+        const int p = std::abs(_p) - 1;
+        const double sign_p = _p > 0 ? 1.0 : -1.0;
+        for (size_t det2 = det + 1; det2 < max_det; ++det2) {
+            const auto [I, _q] = detail::single_entry(group[det2]);
+            const int q = std::abs(_q) - 1;
+            if (p != q) {
+                const double sign_q = _q > 0 ? 1.0 : -1.0;
+                f(hij(J, p, q) * sign_p * sign_q, I, J);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Add the off-diagonal part of a 1-RDM (or transition 1-RDM) from a 1-body list.
+ *
+ * For each pair of determinants I and J coupled by the substitution p -> q this adds
+ * c1(I) c2(J) sign to rdm[p * norb + q] and c1(J) c2(I) sign to rdm[q * norb + p].
+ * The loop over the groups is an orphaned omp for, so when called from a parallel region the
+ * groups are split among the threads and each thread must pass its own rdm.
+ */
+template <class List, class C1, class C2>
+void add_1rdm_single_list(const List& list, size_t norb, C1&& c1, C2&& c2, double* rdm) {
+#pragma omp for schedule(dynamic)
+    for (size_t K = 0; K < list.size(); ++K) {
+        const auto group = list[K];
+        for (size_t a = 0, max_det = group.size(); a < max_det; ++a) {
+            const auto [I, _p] = detail::single_entry(group[a]);
+            const size_t p = std::abs(_p) - 1;
+            const bool sign_p = _p < 0;
+            const double cI1 = c1(I);
+            const double cI2 = c2(I);
+            for (size_t b = a + 1; b < max_det; ++b) {
+                const auto [J, _q] = detail::single_entry(group[b]);
+                const size_t q = std::abs(_q) - 1;
+                const double sign = ((_q < 0) == sign_p) ? 1.0 : -1.0;
+                rdm[p * norb + q] += cI1 * c2(J) * sign;
+                rdm[q * norb + p] += c1(J) * cI2 * sign;
+            }
+        }
+    }
+}
+
+} // namespace forte
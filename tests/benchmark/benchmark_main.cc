@@ -0,0 +1,30 @@
+#include <cstring>
+#include <vector>
+
+#include "hayai/hayai.hpp"
+#include "hayai/hayai_main.hpp"
+
+// The driver of forte_benchmarks. It accepts the hayai options (run with --help to list them).
+// Unless an output is selected with -o/--output, the results are printed to the console and also
+// written to forte_benchmarks.json, which can be compared across builds to track regressions.
+
+int main(int argc, char* argv[]) {
+    std::vector<char*> args(argv, argv + argc);
+    bool has_output = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") or !std::strcmp(argv[i], "--output"))
+            has_output = true;
+    }
+    // hayai modifies the output arguments in place, so they must be writable
+    char output[] = "-o";
+    char console[] = "console";
+    char json[] = "json:forte_benchmarks.json";
+    if (not has_output)
+        args.insert(args.end(), {output, console, output, json});
+
+    hayai::MainRunner runner;
+    int result = runner.ParseArgs(static_cast<int>(args.size()), args.data());
+    if (result)
+        return result;
+    return runner.Run();
+}
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <random>
+
+#include "hayai/hayai.hpp"
+
+#include "forte/sparse_ci/bitwise_kernels.h"
+#include "forte/sparse_ci/determinant.h"
+
+using namespace forte;
+
+// Time the two operations that dominate the selected CI codes on a fixed set of determinants with
+// 128 and 256 bits: the enumeration of the determinants coupled to a given one (excitation level
+// at most two) and the evaluation of the matrix elements between coupled determinants.
+// The coupling enumeration is timed with the inline scalar code (fast_a_xor_b_count) and with the
+// batched kernels for each instruction set. Instruction sets not supported by the CPU fall back
+// to the best supported one. The matrix elements use synthetic integrals.
+
+namespace {
+/// Return a cached set of determinants at most quadruply excited from a reference determinant
+/// with nmo / 4 electrons of each spin
+template <size_t N> const std::vector<DeterminantImpl<N>>& determinant_set() {
+    static std::vector<DeterminantImpl<N>> dets;
+    if (dets.empty()) {
+        constexpr int nmo = static_cast<int>(N / 2);
+        constexpr int nel = nmo / 4;
+        std::mt19937_64 gen(N);
+        std::uniform_int_distribution<int> occ_dist(0, nel - 1);
+        std::uniform_int_distribution<int> vir_dist(nel, nmo - 1);
+        std::uniform_int_distribution<int> rank_dist(0, 2);
+        DeterminantImpl<N> ref;
+        for (int i = 0; i < nel; ++i) {
+            ref.set_alfa_bit(i, true);
+            ref.set_beta_bit(i, true);
+        }
+        dets.resize(20000, ref);
+        for (auto& d : dets) {
+            // move up to two electrons of each spin from the occupied to the virtual orbitals
+            for (int k = rank_dist(gen); k > 0; --k) {
+                d.set_alfa_bit(occ_dist(gen), false);
+                d.set_alfa_bit(vir_dist(gen), true);
+            }
+            for (int k = rank_dist(gen); k > 0; --k) {
+                d.set_beta_bit(occ_dist(gen), false);
+                d.set_beta_bit(vir_dist(gen), true);
+            }
+            // restore the number of electrons if the moves collided
+            for (int i = 0; d.count_alfa() < nel; ++i)
+                d.set_alfa_bit(i, true);
+            for (int i = 0; d.count_beta() < nel; ++i)
+                d.set_beta_bit(i, true);
+        }
+    }
+    return dets;
+}
+
+/// Synthetic one-electron integrals
+inline double h1(int p, int q) { return 1.0 / (1.0 + p + q); }
+
+/// Synthetic two-electron integrals <pq|rs>
+inline double v2(int p, int q, int r, int s) { return 1.0 / (1.0 + p + 2 * q + 3 * r + 4 * s); }
+
+/// Slater rules for two determinants with the same number of electrons (off-diagonal terms)
+template <size_t N>
+double matrix_element(const DeterminantImpl<N>& I, const DeterminantImpl<N>& J) {
+    if (I.fast_a_xor_b_count(J) > 4)
+        return 0.0;
+    const auto Ia = I.get_alfa_bits();
+    const auto Ib = I.get_beta_bits();
+    const auto Xa = Ia ^ J.get_alfa_bits();
+    const auto Xb = Ib ^ J.get_beta_bits();
+    const int na = Xa.count();
+    const int nb = Xb.count();
+    auto holes_a = Ia & Xa;
+    auto holes_b = Ib & Xb;
+    auto parts_a = Xa ^ holes_a;
+    auto parts_b = Xb ^ holes_b;
+    if (na + nb == 2) {
+        const bool alfa = na == 2;
+        const int i = alfa ? holes_a.find_first_one() : holes_b.find_first_one();
+        const int a = alfa ? parts_a.find_first_one() : parts_b.find_first_one();
+        const double sign = alfa ? I.slater_sign_aa(i, a) : I.slater_sign_bb(i, a);
+        double h = h1(i, a);
+        // sum over the orbitals occupied in both determinants
+        auto same = alfa ? Ia : Ib;
+        auto other = alfa ? Ib : Ia;
+        same.set_bit(i, false);
+        for (int k = same.count(); k > 0; --k) {
+            const int p = same.find_and_clear_first_one();
+            h += v2(i, p, a, p) - v2(i, p, p, a);
+        }
+        for (int k = other.count(); k > 0; --k) {
+            const int p = other.find_and_clear_first_one();
+            h += v2(i, p, a, p);
+        }
+        return sign * h;
+    }
+    if (na == 2) {
+        const int i = holes_a.find_first_one();
+        const int a = parts_a.find_first_one();
+        const int j = holes_b.find_first_one();
+        const int b = parts_b.find_first_one();
+        return I.slater_sign_aa(i, a) * I.slater_sign_bb(j, b) * v2(i, j, a, b);
+    }
+    const bool alfa = na == 4;
+    auto& holes = alfa ? holes_a : holes_b;
+    auto& parts = alfa ? parts_a : parts_b;
+    const int i = holes.find_and_clear_first_one();
+    const int j = holes.find_first_one();
+    const int a = parts.find_and_clear_first_one();
+    const int b = parts.find_first_one();
+    DeterminantImpl<N> D(I);
+    const double sign =
+        alfa ? D.double_excitation_aa(i, j, a, b) : D.double_excitation_bb(i, j, a, b);
+    return sign * (v2(i, j, a, b) - v2(i, j, b, a));
+}
+
+/// The number of determinants for which the couplings are enumerated
+constexpr size_t num_bra = 128;
+
+template <size_t N, BitKernelISA ISA> class CouplingFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        dets_ = &determinant_set<N>();
+        default_isa_ = bit_kernel_isa();
+        set_bit_kernel_isa(std::min(ISA, bit_kernel_best_isa()));
+    }
+    virtual void TearDown() { set_bit_kernel_isa(default_isa_); }
+
+  protected:
+    const std::vector<DeterminantImpl<N>>* dets_ = nullptr;
+    BitKernelISA default_isa_;
+    std::vector<int> counts_;
+    size_t num_couplings_ = 0;
+};
+
+template <size_t N> class MatrixElementFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        const auto& dets = determinant_set<N>();
+        for (size_t I = 0; I < num_bra; ++I) {
+            for (size_t J = 0; J < dets.size(); ++J) {
+                if (J != I and dets[I] != dets[J] and dets[I].fast_a_xor_b_count(dets[J]) <= 4)
+                    pairs_.emplace_back(&dets[I], &dets[J]);
+            }
+        }
+    }
+    virtual void TearDown() { pairs_.clear(); }
+
+  protected:
+    std::vector<std::pair<const DeterminantImpl<N>*, const DeterminantImpl<N>*>> pairs_;
+    double sum_ = 0.0;
+};
+} // namespace
+
+#define COUPLING_BENCHMARKS(N)                                                                     \
+    using couplings_##N = CouplingFixture<N, BitKernelISA::Scalar>;                                \
+    using couplings_##N##_popcnt = CouplingFixture<N, BitKernelISA::Popcnt>;                       \
+    using couplings_##N##_avx2 = CouplingFixture<N, BitKernelISA::AVX2>;                           \
+    using couplings_##N##_avx512 = CouplingFixture<N, BitKernelISA::AVX512>;                       \
+    BENCHMARK_F(couplings_##N, inline_scalar, 5, 1) {                                              \
+        for (size_t I = 0; I < num_bra; ++I) {                                                     \
+            for (const auto& d : *dets_) {                                                         \
+                num_couplings_ += (*dets_)[I].fast_a_xor_b_count(d) <= 4;                          \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(couplings_##N, batched_scalar, 5, 1) {                                             \
+        for (size_t I = 0; I < num_bra; ++I) {                                                     \
+            xor_bit_counts((*dets_)[I], *dets_, counts_);                                          \
+            num_couplings_ += std::count_if(counts_.begin(), counts_.end(),                        \
+                                            [](int c) { return c <= 4; });                         \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(couplings_##N##_popcnt, batched, 5, 1) {                                           \
+        for (size_t I = 0; I < num_bra; ++I) {                                                     \
+            xor_bit_counts((*dets_)[I], *dets_, counts_);                                          \
+            num_couplings_ += std::count_if(counts_.begin(), counts_.end(),                        \
+                                            [](int c) { return c <= 4; });                         \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(couplings_##N##_avx2, batched, 5, 1) {                                             \
+        for (size_t I = 0; I < num_bra; ++I) {                                                     \
+            xor_bit_counts((*dets_)[I], *dets_, counts_);                                          \
+            num_couplings_ += std::count_if(counts_.begin(), counts_.end(),                        \
+                                            [](int c) { return c <= 4; });                         \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(couplings_##N##_avx512, batched, 5, 1) {                                           \
+        for (size_t I = 0; I < num_bra; ++I) {                                                     \
+            xor_bit_counts((*dets_)[I], *dets_, counts_);                                          \
+            num_couplings_ += std::count_if(counts_.begin(), counts_.end(),                        \
+                                            [](int c) { return c <= 4; });                         \
+        }                                                                                          \
+    }                                                                                              \
+    using matrix_elements_##N = MatrixElementFixture<N>;                                           \
+    BENCHMARK_F(matrix_elements_##N, slater_rules, 5, 1) {                                         \
+        for (const auto& [I, J] : pairs_) {                                                        \
+            sum_ += matrix_element(*I, *J);                                                        \
+        }                                                                                          \
+    }
+
+COUPLING_BENCHMARKS(128)
+COUPLING_BENCHMARKS(256)
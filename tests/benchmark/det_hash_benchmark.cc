@@ -0,0 +1,80 @@
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include "hayai/hayai.hpp"
+
+#include "forte/sparse_ci/determinant.h"
+
+using namespace forte;
+
+// Compare std::unordered_map (det_hash) and FlatHashMap (det_flat_hash) for the operations that
+// dominate StateVector and SparseExp: insertion, lookup of existing keys, and iteration.
+// The determinants and the filled maps are built in SetUp, so they are not timed.
+// Note that the 10^8 benchmarks require several GB of memory.
+
+namespace {
+/// Return a cached vector of n random determinants
+const std::vector<Determinant>& random_determinants(std::size_t n) {
+    static std::map<std::size_t, std::vector<Determinant>> cache;
+    auto& dets = cache[n];
+    if (dets.size() != n) {
+        std::mt19937_64 gen(n);
+        dets.resize(n);
+        for (auto& d : dets) {
+            for (std::size_t w = 0; w < Determinant::nwords_; ++w) {
+                d.set_word(w, gen());
+            }
+        }
+    }
+    return dets;
+}
+
+template <class Map, std::size_t N, bool Fill> class DetHashFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        dets_ = &random_determinants(N);
+        if constexpr (Fill) {
+            for (const auto& d : *dets_) {
+                map_[d] = 1.0;
+            }
+        }
+    }
+    virtual void TearDown() { Map().swap(map_); }
+
+  protected:
+    const std::vector<Determinant>* dets_ = nullptr;
+    Map map_;
+    double sum_ = 0.0;
+};
+} // namespace
+
+#define DET_HASH_BENCHMARKS(map_name, Map, N)                                                      \
+    using map_name##_##N##_insert = DetHashFixture<Map, N, false>;                                 \
+    using map_name##_##N = DetHashFixture<Map, N, true>;                                           \
+    BENCHMARK_F(map_name##_##N##_insert, insert, 1, 1) {                                           \
+        for (const auto& d : *dets_) {                                                             \
+            map_[d] += 1.0;                                                                        \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(map_name##_##N, lookup, 1, 1) {                                                    \
+        for (const auto& d : *dets_) {                                                             \
+            if (auto it = map_.find(d); it != map_.end()) {                                        \
+                sum_ += it->second;                                                                \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+    BENCHMARK_F(map_name##_##N, iterate, 1, 1) {                                                   \
+        for (const auto& [d, c] : map_) {                                                          \
+            sum_ += c * d.count();                                                                 \
+        }                                                                                          \
+    }
+
+DET_HASH_BENCHMARKS(unordered_map, det_hash<double>, 100000)
+DET_HASH_BENCHMARKS(flat_hash_map, det_flat_hash<double>, 100000)
+DET_HASH_BENCHMARKS(unordered_map, det_hash<double>, 1000000)
+DET_HASH_BENCHMARKS(flat_hash_map, det_flat_hash<double>, 1000000)
+DET_HASH_BENCHMARKS(unordered_map, det_hash<double>, 10000000)
+DET_HASH_BENCHMARKS(flat_hash_map, det_flat_hash<double>, 10000000)
+DET_HASH_BENCHMARKS(unordered_map, det_hash<double>, 100000000)
+DET_HASH_BENCHMARKS(flat_hash_map, det_flat_hash<double>, 100000000)
@@ -1,40 +1,11 @@
 #include <iostream>
-#include <fstream> // std::filebuf
 
 #include "hayai/hayai.hpp"
-#include "hayai/hayai_main.hpp"
 
 #include "forte/sparse_ci/determinant.h"
 
 using namespace forte;
 
-
-int main(int argc, char* argv[]) {
-    std::filebuf fb;
-    fb.open("bench.json", std::ios::out);
-    std::ostream json(&fb);
-
-    // Set up the main runner.
-    hayai::MainRunner runner;
-
-    // Parse the arguments.
-    int result = runner.ParseArgs(argc, argv);
-    if (result)
-        return result;
-
-    //    hayai::ConsoleOutputter consoleOutputter;
-    //    hayai::JsonOutputter JSONOutputter(json);
-
-    //    hayai::Benchmarker::AddOutputter(consoleOutputter);
-    //    hayai::Benchmarker::AddOutputter(JSONOutputter);
-    //    hayai::Benchmarker::RunAllTests();
-
-    // Execute based on the selected mode.
-    return runner.Run();
-    fb.close();
-    return 0;
-}
-
 Determinant make_det_from_string(std::string s_a, std::string s_b) {
     Determinant d;
     if (s_a.size() == s_b.size()) {
@@ -0,0 +1,142 @@
+#include <utility>
+#include <vector>
+
+#include "hayai/hayai.hpp"
+
+#include "forte/mrdsrg-helper/dsrg_source.h"
+
+#include "synthetic_system.h"
+
+using namespace forte;
+
+// Time the kernels of the DF-DSRG-MRPT2 CCVV energy on synthetic three-index integrals, with the
+// standard DSRG source:
+// - ccvv_fused: the default CCVV algorithm of THREE_DSRG_MRPT2 (E_VT2_2_fused). For each pair of
+//   core orbitals m >= n and each pair of virtual tiles E <= F (of size ccvv_tile_size) it forms
+//   the tiles (me|nf) and (mf|ne) and reduces them with ccvv_tile_energy.
+// - ccvv: SA_MRPT2::E_V_T2_CCVV. For each pair of core orbitals (i,j) it forms (ia|jb) and calls
+//   ccvv_pair_energy.
+// The product code forms the integrals with DGEMM. This target does not link BLAS, so here the
+// contractions over Q are written with explicit loops and only the timings of the reductions are
+// representative of the product code.
+
+namespace {
+template <size_t NCore, size_t NVirt, size_t NAux> class CCVVFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        ints_ = make_synthetic_integrals(NCore + NVirt, NAux, false);
+        for (size_t i = 0; i < NCore; ++i) {
+            for (size_t j = i; j < NCore; ++j)
+                ij_pairs_.emplace_back(i, j);
+        }
+        Jab_.assign(NVirt * NVirt, 0.0);
+    }
+    virtual void TearDown() { ij_pairs_.clear(); }
+
+  protected:
+    /// Compute the CCVV energy (with the DSRG source) from the synthetic integrals
+    void compute_energy() {
+        const size_t nmo = NCore + NVirt;
+        const auto& B = ints_.B;
+        const auto& eps = ints_.epsilon;
+        for (const auto& [i, j] : ij_pairs_) {
+            for (size_t a = 0; a < NVirt; ++a) {
+                const double* Bia = &B[(i * nmo + NCore + a) * NAux];
+                for (size_t b = 0; b < NVirt; ++b) {
+                    const double* Bjb = &B[(j * nmo + NCore + b) * NAux];
+                    double value = 0.0;
+                    for (size_t Q = 0; Q < NAux; ++Q)
+                        value += Bia[Q] * Bjb[Q];
+                    Jab_[a * NVirt + b] = value;
+                }
+            }
+            const double e_ij = ccvv_pair_energy(Jab_.data(), NVirt, eps[i] + eps[j],
+                                                 &eps[NCore], &source_);
+            energy_ += (i == j ? 1.0 : 2.0) * e_ij;
+        }
+    }
+
+    SyntheticIntegrals ints_;
+    STD_SOURCE source_{0.5, 12.0};
+    std::vector<std::pair<size_t, size_t>> ij_pairs_;
+    std::vector<double> Jab_;
+    double energy_ = 0.0;
+};
+} // namespace
+
+namespace {
+template <size_t NCore, size_t NVirt, size_t NAux> class FusedCCVVFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        ints_ = make_synthetic_integrals(NCore + NVirt, NAux, false);
+        const size_t tile_size = ccvv_tile_size(NVirt);
+        for (size_t e = 0; e < NVirt; e += tile_size)
+            tiles_.push_back(e);
+        tiles_.push_back(NVirt);
+        X_.assign(tile_size * tile_size, 0.0);
+        Y_.assign(tile_size * tile_size, 0.0);
+    }
+    virtual void TearDown() { tiles_.clear(); }
+
+  protected:
+    /// Form the tile T(ef) = (me|nf) for the virtual orbitals e in [e0, e0 + ne) and f in
+    /// [f0, f0 + nf)
+    void form_tile(size_t m, size_t n, size_t e0, size_t ne, size_t f0, size_t nf, double* T) {
+        const size_t nmo = NCore + NVirt;
+        const auto& B = ints_.B;
+        for (size_t e = 0; e < ne; ++e) {
+            const double* Bme = &B[(m * nmo + NCore + e0 + e) * NAux];
+            for (size_t f = 0; f < nf; ++f) {
+                const double* Bnf = &B[(n * nmo + NCore + f0 + f) * NAux];
+                double value = 0.0;
+                for (size_t Q = 0; Q < NAux; ++Q)
+                    value += Bme[Q] * Bnf[Q];
+                T[e * nf + f] = value;
+            }
+        }
+    }
+
+    /// Compute the CCVV energy (with the DSRG source) with the fused algorithm
+    void compute_energy() {
+        const auto& eps = ints_.epsilon;
+        const double* eps_v = &eps[NCore];
+        const size_t ntiles = tiles_.size() - 1;
+        for (size_t m = 0; m < NCore; ++m) {
+            for (size_t n = 0; n <= m; ++n) {
+                for (size_t E = 0; E < ntiles; ++E) {
+                    for (size_t F = E; F < ntiles; ++F) {
+                        const size_t e0 = tiles_[E], ne = tiles_[E + 1] - e0;
+                        const size_t f0 = tiles_[F], nf = tiles_[F + 1] - f0;
+                        form_tile(m, n, e0, ne, f0, nf, X_.data());
+                        const double* Y = X_.data();
+                        if (E != F) {
+                            form_tile(m, n, f0, nf, e0, ne, Y_.data());
+                            Y = Y_.data();
+                        }
+                        const double e_tile =
+                            ccvv_tile_energy(X_.data(), Y, e0, ne, f0, nf, eps[m], eps[m], eps[n],
+                                             eps[n], eps_v, nullptr, &source_);
+                        energy_ += (m == n ? 0.5 : 1.0) * (E == F ? 0.5 : 1.0) * e_tile;
+                    }
+                }
+            }
+        }
+    }
+
+    SyntheticIntegrals ints_;
+    STD_SOURCE source_{0.5, 12.0};
+    std::vector<size_t> tiles_;
+    std::vector<double> X_;
+    std::vector<double> Y_;
+    double energy_ = 0.0;
+};
+} // namespace
+
+#define CCVV_BENCHMARK(NCore, NVirt, NAux)                                                         \
+    using ccvv_##NCore##_##NVirt##_##NAux = CCVVFixture<NCore, NVirt, NAux>;                       \
+    BENCHMARK_F(ccvv_##NCore##_##NVirt##_##NAux, energy, 5, 1) { compute_energy(); }               \
+    using ccvv_fused_##NCore##_##NVirt##_##NAux = FusedCCVVFixture<NCore, NVirt, NAux>;            \
+    BENCHMARK_F(ccvv_fused_##NCore##_##NVirt##_##NAux, energy, 5, 1) { compute_energy(); }
+
+CCVV_BENCHMARK(10, 100, 300)
+CCVV_BENCHMARK(16, 128, 384)
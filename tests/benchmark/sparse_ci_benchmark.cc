@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "hayai/hayai.hpp"
+
+#include "forte/sparse_ci/compressed_substitution_lists.h"
+#include "forte/sparse_ci/determinant.h"
+#include "forte/sparse_ci/sq_operator.h"
+#include "forte/sparse_ci/substitution_list.h"
+#include "forte/sparse_ci/substitution_list_kernels.h"
+
+#include "synthetic_system.h"
+
+using namespace forte;
+
+// Time the kernels of the selected CI codes on a synthetic system (24 orbitals, 6 electrons of
+// each spin, 100000 determinants at most doubly excited in each spin). The benchmarks call the
+// kernels used by the product code, with the synthetic integrals and coefficients in place of
+// ActiveSpaceIntegrals and the CI vectors:
+// - for_each_single_coupling, the single-excitation part of SigmaVectorSparseList, with the
+//   substitution lists stored in memory (SubstitutionList) and compressed
+//   (CompressedSubstitutionLists)
+// - add_1rdm_single_list, the off-diagonal part of CI_RDMS::compute_1rdm_op
+// - apply_sqop_to_sorted_state, the inner loop of apply_operator, for a sparse operator (singles
+//   and alpha-beta doubles) applied to a state of 500 determinants
+// The benchmarks run on one thread. The system and the lists are built once and are not timed.
+
+namespace {
+constexpr int nmo = 24;
+constexpr int nel = 6;
+constexpr size_t ndets = 100000;
+
+/// The synthetic system shared by all the benchmarks in this file
+struct SparseSystem {
+    SyntheticIntegrals ints = make_synthetic_integrals(nmo, 2 * nmo);
+    std::vector<Determinant> dets = make_synthetic_determinants(nmo, nel, ndets);
+    std::vector<double> c = make_synthetic_coefficients(dets.size());
+    SubstitutionList<1> a_list;
+    SubstitutionList<1> b_list;
+    std::unique_ptr<CompressedSubstitutionLists> a_compressed;
+    std::unique_ptr<CompressedSubstitutionLists> b_compressed;
+
+    SparseSystem() {
+        for (bool alfa : {true, false}) {
+            const auto lists = make_single_substitution_lists(dets, nmo, alfa);
+            auto& list = alfa ? a_list : b_list;
+            for (const auto& group : lists)
+                list.push_back(group);
+            auto& compressed = alfa ? a_compressed : b_compressed;
+            // the lists fit in memory, so no scratch file is written
+            compressed = std::make_unique<CompressedSubstitutionLists>(size_t(1) << 34,
+                                                                       "forte_benchmark.lists");
+            compressed->add_lists(lists);
+            compressed->finalize();
+        }
+    }
+};
+
+const SparseSystem& sparse_system() {
+    static SparseSystem system;
+    return system;
+}
+
+class SparseFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        system_ = &sparse_system();
+        sigma_.assign(system_->dets.size(), 0.0);
+    }
+    virtual void TearDown() { sigma_.clear(); }
+
+  protected:
+    const SparseSystem* system_ = nullptr;
+    std::vector<double> sigma_;
+    std::vector<double> rdm_a_;
+    std::vector<double> rdm_b_;
+};
+
+class OperatorFixture : public hayai::Fixture {
+  public:
+    virtual void SetUp() {
+        const auto& system = sparse_system();
+        // the 500 determinants with the largest coefficients, sorted as in apply_operator
+        for (size_t I = 0; I < 500; ++I)
+            state_.emplace_back(std::fabs(system.c[I]), system.c[I], system.dets[I]);
+        std::sort(state_.rbegin(), state_.rend());
+        // singles from the occupied to all the virtual orbitals and alpha-beta doubles to the
+        // lowest 12 virtual orbitals (the operators are brought to the canonical order by
+        // SQOperator)
+        const double t = 0.01;
+        for (int i = 0; i < nel; ++i) {
+            for (int a = nel; a < nmo; ++a) {
+                ops_.emplace_back(op_tuple_t{{true, true, a}, {false, true, i}}, t, true);
+                ops_.emplace_back(op_tuple_t{{true, false, a}, {false, false, i}}, t, true);
+                for (int j = 0; j < nel and a < nel + 12; ++j) {
+                    for (int b = nel; b < nel + 12; ++b) {
+                        ops_.emplace_back(op_tuple_t{{true, true, a},
+                                                     {true, false, b},
+                                                     {false, false, j},
+                                                     {false, true, i}},
+                                          t / (1.0 + a + b - i - j), true);
+                    }
+                }
+            }
+        }
+    }
+    virtual void TearDown() {
+        state_.clear();
+        ops_.clear();
+        det_hash<double>().swap(new_terms_);
+    }
+
+  protected:
+    std::vector<std::tuple<double, double, Determinant>> state_;
+    std::vector<SQOperator> ops_;
+    det_hash<double> new_terms_;
+};
+
+/// Add the single excitations coupled by a group of a list to sigma
+template <class Group>
+void add_singles(const SparseSystem& system, const Group& group, bool alfa,
+                 std::vector<double>& sigma) {
+    for_each_single_coupling(
+        group,
+        [&](size_t J, int p, int q) {
+            return single_excitation_element(system.ints, system.dets[J], p, q, alfa);
+        },
+        [&](double HIJ, size_t I, size_t J) {
+            sigma[I] += HIJ * system.c[J];
+            sigma[J] += HIJ * system.c[I];
+        });
+}
+} // namespace
+
+BENCHMARK_F(SparseFixture, sigma_singles_lists, 5, 1) {
+    for (const auto& group : system_->a_list)
+        add_singles(*system_, group, true, sigma_);
+    for (const auto& group : system_->b_list)
+        add_singles(*system_, group, false, sigma_);
+}
+
+BENCHMARK_F(SparseFixture, sigma_singles_compressed, 5, 1) {
+    for (bool alfa : {true, false}) {
+        const auto& lists = alfa ? *system_->a_compressed : *system_->b_compressed;
+        lists.for_each_list(
+            1, 0, [&](const auto& c_dets) { add_singles(*system_, c_dets, alfa, sigma_); });
+    }
+}
+
+BENCHMARK_F(SparseFixture, rdm1_lists, 5, 1) {
+    rdm_a_.assign(nmo * nmo, 0.0);
+    rdm_b_.assign(nmo * nmo, 0.0);
+    auto c = [&](size_t I) { return system_->c[I]; };
+    add_1rdm_single_list(system_->a_list, nmo, c, c, rdm_a_.data());
+    add_1rdm_single_list(system_->b_list, nmo, c, c, rdm_b_.data());
+}
+
+BENCHMARK_F(OperatorFixture, apply_operator, 5, 1) {
+    const double screen_thresh = 1.0e-12;
+    for (const auto& sqop : ops_) {
+        apply_sqop_to_sorted_state(sqop, false, state_, 0, state_.size(), screen_thresh,
+                                   [&](const Determinant& d, double value) {
+                                       new_terms_[d] += value;
+                                   });
+    }
+}
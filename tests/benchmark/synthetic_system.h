@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "forte/sparse_ci/determinant.h"
+
+// A synthetic model system used by the benchmarks, so they do not need Psi4 or an input file.
+// The integrals have the structure of an FCIDUMP file (one-electron integrals h_pq with eightfold
+// symmetric two-electron integrals (pq|rs) in chemist notation), but they are built from a
+// density-fitting-like factorization (pq|rs) = sum_Q B^Q_pq B^Q_rs, so the three-index integrals
+// needed by the DF kernels are also available. The orbitals are ordered by energy and the
+// couplings decay with |p - q|, which mimics localized orbitals.
+
+namespace forte {
+
+struct SyntheticIntegrals {
+    size_t nmo = 0;
+    size_t naux = 0;
+    double scalar_energy = 0.0;
+    /// orbital energies, in ascending order
+    std::vector<double> epsilon;
+    /// one-electron integrals h_pq (nmo x nmo)
+    std::vector<double> h1;
+    /// three-index integrals B^Q_pq stored as [p][q][Q]
+    std::vector<double> B;
+    /// two-electron integrals (pq|rs) stored as [p][q][r][s] (empty if not requested)
+    std::vector<double> eri;
+
+    double h(size_t p, size_t q) const { return h1[p * nmo + q]; }
+    double v(size_t p, size_t q, size_t r, size_t s) const {
+        return eri[((p * nmo + q) * nmo + r) * nmo + s];
+    }
+};
+
+/// Build the synthetic integrals for nmo orbitals and naux auxiliary functions. The two-electron
+/// integrals take nmo^4 doubles and are built only if build_eri is true
+inline SyntheticIntegrals make_synthetic_integrals(size_t nmo, size_t naux, bool build_eri = true,
+                                                   uint64_t seed = 0) {
+    SyntheticIntegrals ints;
+    ints.nmo = nmo;
+    ints.naux = naux;
+    ints.scalar_energy = 10.0;
+
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    ints.epsilon.resize(nmo);
+    for (size_t p = 0; p < nmo; ++p)
+        ints.epsilon[p] = -2.0 + 4.0 * static_cast<double>(p) / static_cast<double>(nmo);
+
+    ints.h1.assign(nmo * nmo, 0.0);
+    for (size_t p = 0; p < nmo; ++p) {
+        ints.h1[p * nmo + p] = ints.epsilon[p];
+        for (size_t q = 0; q < p; ++q) {
+            const double value = 0.05 * dist(gen) * std::exp(-0.5 * static_cast<double>(p - q));
+            ints.h1[p * nmo + q] = ints.h1[q * nmo + p] = value;
+        }
+    }
+
+    ints.B.assign(nmo * nmo * naux, 0.0);
+    for (size_t p = 0; p < nmo; ++p) {
+        for (size_t q = 0; q <= p; ++q) {
+            const double decay = 0.3 * std::exp(-0.5 * static_cast<double>(p - q));
+            for (size_t Q = 0; Q < naux; ++Q) {
+                const double value = decay * dist(gen);
+                ints.B[(p * nmo + q) * naux + Q] = ints.B[(q * nmo + p) * naux + Q] = value;
+            }
+        }
+    }
+
+    if (not build_eri)
+        return ints;
+    const size_t npair = nmo * nmo;
+    ints.eri.assign(npair * npair, 0.0);
+    for (size_t pq = 0; pq < npair; ++pq) {
+        for (size_t rs = 0; rs <= pq; ++rs) {
+            double value = 0.0;
+            for (size_t Q = 0; Q < naux; ++Q)
+                value += ints.B[pq * naux + Q] * ints.B[rs * naux + Q];
+            ints.eri[pq * npair + rs] = ints.eri[rs * npair + pq] = value;
+        }
+    }
+    return ints;
+}
+
+/// Return ndets determinants with nel electrons of each spin in nmo orbitals, at most doubly
+/// excited in each spin from the aufbau determinant. The first determinant is the aufbau one and
+/// there are no duplicates
+inline std::vector<Determinant> make_synthetic_determinants(int nmo, int nel, size_t ndets,
+                                                            uint64_t seed = 0) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<int> occ_dist(0, nel - 1);
+    std::uniform_int_distribution<int> vir_dist(nel, nmo - 1);
+    std::uniform_int_distribution<int> rank_dist(0, 2);
+
+    Determinant ref;
+    for (int i = 0; i < nel; ++i) {
+        ref.set_alfa_bit(i, true);
+        ref.set_beta_bit(i, true);
+    }
+    std::vector<Determinant> dets{ref};
+    det_hash<size_t> index{{ref, 0}};
+    for (size_t attempt = 0; dets.size() < ndets and attempt < 100 * ndets; ++attempt) {
+        Determinant d(ref);
+        for (int k = rank_dist(gen); k > 0; --k) {
+            d.set_alfa_bit(occ_dist(gen), false);
+            d.set_alfa_bit(vir_dist(gen), true);
+        }
+        for (int k = rank_dist(gen); k > 0; --k) {
+            d.set_beta_bit(occ_dist(gen), false);
+            d.set_beta_bit(vir_dist(gen), true);
+        }
+        if (d.count_alfa() != nel or d.count_beta() != nel)
+            continue;
+        if (index.emplace(d, dets.size()).second)
+            dets.push_back(d);
+    }
+    return dets;
+}
+
+/// Return a normalized vector with a dominant first element
+inline std::vector<double> make_synthetic_coefficients(size_t n, uint64_t seed = 0) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> c(n);
+    double norm = 0.0;
+    for (size_t I = 0; I < n; ++I) {
+        c[I] = (I == 0 ? 10.0 : dist(gen)) / (1.0 + 0.01 * static_cast<double>(I));
+        norm += c[I] * c[I];
+    }
+    for (auto& x : c)
+        x /= std::sqrt(norm);
+    return c;
+}
+
+/// Build the alpha (or beta) single substitution lists of a set of determinants in the format of
+/// DeterminantSubstitutionLists: the determinants with one electron removed are grouped, and each
+/// group stores the pairs (I, +/-(p + 1)) where p is the removed orbital and the sign is the sign
+/// of a_p |I>. Groups with only one determinant are dropped
+inline std::vector<std::vector<std::pair<size_t, short>>>
+make_single_substitution_lists(const std::vector<Determinant>& dets, int nmo, bool alfa) {
+    std::vector<std::vector<std::pair<size_t, short>>> lists;
+    det_hash<size_t> index;
+    for (size_t I = 0, ndets = dets.size(); I < ndets; ++I) {
+        const auto& detI = dets[I];
+        const auto occ = alfa ? detI.get_alfa_occ(nmo) : detI.get_beta_occ(nmo);
+        for (int p : occ) {
+            Determinant detJ(detI);
+            double sign;
+            if (alfa) {
+                detJ.set_alfa_bit(p, false);
+                sign = detI.slater_sign_a(p);
+            } else {
+                detJ.set_beta_bit(p, false);
+                sign = detI.slater_sign_b(p);
+            }
+            const auto [it, inserted] = index.emplace(detJ, lists.size());
+            if (inserted)
+                lists.emplace_back();
+            lists[it->second].emplace_back(I, sign > 0.0 ? (p + 1) : (-p - 1));
+        }
+    }
+    std::erase_if(lists, [](const auto& list) { return list.size() < 2; });
+    return lists;
+}
+
+/// The matrix element <J| a+_q a_p |I> for an alpha (or beta) single excitation of I, without
+/// the sign of the excitation
+inline double single_excitation_element(const SyntheticIntegrals& ints, const Determinant& I,
+                                        int p, int q, bool alfa) {
+    const int nmo = static_cast<int>(ints.nmo);
+    double value = ints.h(p, q);
+    for (int r : I.get_alfa_occ(nmo)) {
+        value += ints.v(p, q, r, r);
+        if (alfa)
+            value -= ints.v(p, r, r, q);
+    }
+    for (int r : I.get_beta_occ(nmo)) {
+        value += ints.v(p, q, r, r);
+        if (not alfa)
+            value -= ints.v(p, r, r, q);
+    }
+    return value;
+}
+
+} // namespace forte
@@ -0,0 +1,78 @@
+#include <random>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/sparse_ci/bitwise_kernels.h"
+#include "forte/sparse_ci/determinant.h"
+
+using namespace forte;
+
+namespace {
+std::vector<BitKernelISA> supported_isas() {
+    std::vector<BitKernelISA> isas;
+    for (auto isa : {BitKernelISA::Scalar, BitKernelISA::Popcnt, BitKernelISA::AVX2,
+                     BitKernelISA::AVX512}) {
+        if (static_cast<int>(isa) <= static_cast<int>(bit_kernel_best_isa()))
+            isas.push_back(isa);
+    }
+    return isas;
+}
+} // namespace
+
+// Test the batched counts for all the instruction sets supported by this CPU
+TEST_CASE("Batched bit counts [BitKernels]", "[BitKernels]") {
+    std::mt19937_64 gen(7);
+    const auto default_isa = bit_kernel_isa();
+    for (size_t nwords = 1; nwords <= 9; ++nwords) {
+        // use a number of arrays that is not a multiple of the vector width to test the tails
+        const size_t n = 1003;
+        std::vector<uint64_t> ref(nwords), words(n * nwords);
+        for (auto& w : ref)
+            w = gen();
+        for (auto& w : words)
+            w = gen();
+        std::vector<int> xor_ref(n);
+        for (size_t i = 0; i < n; ++i) {
+            xor_ref[i] = 0;
+            for (size_t k = 0; k < nwords; ++k) {
+                xor_ref[i] += ui64_bit_count(ref[k] ^ words[i * nwords + k]);
+            }
+        }
+        for (auto isa : supported_isas()) {
+            set_bit_kernel_isa(isa);
+            std::vector<int> counts(n);
+            xor_bit_counts(ref.data(), words.data(), nwords, n, counts.data());
+            REQUIRE(counts == xor_ref);
+        }
+    }
+    set_bit_kernel_isa(default_isa);
+}
+
+// Test the excitation levels of a vector of determinants
+TEST_CASE("Excitation level of determinants [BitKernels]", "[BitKernels]") {
+    std::mt19937_64 gen(11);
+    std::vector<Determinant> dets(257);
+    for (auto& d : dets) {
+        for (size_t w = 0; w < Determinant::nwords_; ++w) {
+            d.set_word(w, gen());
+        }
+    }
+    std::vector<int> counts;
+    xor_bit_counts(dets[0], dets, counts);
+    REQUIRE(counts.size() == dets.size());
+    for (size_t i = 0; i < dets.size(); ++i) {
+        REQUIRE(counts[i] == dets[0].fast_a_xor_b_count(dets[i]));
+    }
+}
+
+// Test the branch-free sign against the reference implementation
+TEST_CASE("Slater sign [BitKernels]", "[BitKernels]") {
+    std::mt19937_64 gen(3);
+    DeterminantImpl<256> d;
+    for (size_t w = 0; w < DeterminantImpl<256>::nwords_; ++w) {
+        d.set_word(w, gen());
+    }
+    for (int n = 0; n < 256; ++n) {
+        REQUIRE(d.slater_sign(n) == d.slater_sign_safe(n));
+    }
+}
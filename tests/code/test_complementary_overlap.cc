@@ -0,0 +1,231 @@
+#include <bit>
+#include <cmath>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/sparse_ci/complementary_overlap.h"
+
+using namespace forte;
+
+namespace {
+/// Apply z^+_τ v_τ u_σ to a determinant, return the sign (zero if the result vanishes)
+double apply(Determinant& d, size_t u, int sigma, size_t v, size_t z, int tau) {
+    double sign = sigma == 0 ? d.destroy_alfa_bit(u) : d.destroy_beta_bit(u);
+    sign *= tau == 0 ? d.destroy_alfa_bit(v) : d.destroy_beta_bit(v);
+    sign *= tau == 0 ? d.create_alfa_bit(z) : d.create_beta_bit(z);
+    return sign;
+}
+
+/// Apply a string of second-quantized operators (orbital, spin, creation) from right to left to
+/// a determinant, return the sign (zero if the result vanishes)
+double apply_string(Determinant& d, const std::vector<std::tuple<size_t, int, bool>>& ops) {
+    double sign = 1.0;
+    for (auto it = ops.rbegin(); it != ops.rend() and sign != 0.0; ++it) {
+        const auto& [p, spin, create] = *it;
+        if (create) {
+            sign *= spin == 0 ? d.create_alfa_bit(p) : d.create_beta_bit(p);
+        } else {
+            sign *= spin == 0 ? d.destroy_alfa_bit(p) : d.destroy_beta_bit(p);
+        }
+    }
+    return sign;
+}
+
+/// @return all the determinants of nactv orbitals with na alpha and nb beta electrons
+std::vector<Determinant> make_dets(size_t nactv, int na, int nb) {
+    std::vector<Determinant> dets;
+    for (size_t a = 0; a < (size_t(1) << nactv); ++a) {
+        for (size_t b = 0; b < (size_t(1) << nactv); ++b) {
+            if (std::popcount(a) != na or std::popcount(b) != nb)
+                continue;
+            Determinant d;
+            for (size_t p = 0; p < nactv; ++p) {
+                d.set_alfa_bit(p, (a >> p) & 1);
+                d.set_beta_bit(p, (b >> p) & 1);
+            }
+            dets.push_back(d);
+        }
+    }
+    return dets;
+}
+} // namespace
+
+// Test the overlap against the explicit application of the operators h_{pσ} to the wave function
+TEST_CASE("Complementary overlap [ComplementaryOverlap]", "[ComplementaryOverlap]") {
+    const size_t nactv = 4;
+    const size_t np = 3;
+    const size_t nactv3 = nactv * nactv * nactv;
+
+    // all the determinants with two alpha and two beta electrons
+    const auto dets = make_dets(nactv, 2, 2);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<std::vector<double>> evecs(2, std::vector<double>(dets.size()));
+    for (auto& evec : evecs)
+        for (auto& c : evec)
+            c = dist(gen);
+    std::vector<double> bra(np * nactv3), ket(np * nactv3);
+    for (auto& x : bra)
+        x = dist(gen);
+    for (auto& x : ket)
+        x = dist(gen);
+
+    const auto overlaps = complementary_H2caa_overlap(nactv, dets, evecs, np, bra, ket);
+    REQUIRE(overlaps.size() == evecs.size());
+
+    for (size_t n = 0; n < evecs.size(); ++n) {
+        double ref = 0.0;
+        for (size_t p = 0; p < np; ++p) {
+            for (int sigma = 0; sigma < 2; ++sigma) {
+                // h_{pσ}(B) |Ψ> and h_{pσ}(K) |Ψ>
+                std::map<Determinant, double> hbra, hket;
+                for (size_t I = 0; I < dets.size(); ++I) {
+                    for (size_t u = 0; u < nactv; ++u) {
+                        for (size_t v = 0; v < nactv; ++v) {
+                            for (size_t z = 0; z < nactv; ++z) {
+                                for (int tau = 0; tau < 2; ++tau) {
+                                    Determinant J(dets[I]);
+                                    const double sign = apply(J, u, sigma, v, z, tau);
+                                    if (sign == 0.0)
+                                        continue;
+                                    const double c = sign * evecs[n][I];
+                                    hbra[J] += c * bra[p * nactv3 + (z * nactv + u) * nactv + v];
+                                    hket[J] += c * ket[((u * nactv + v) * np + p) * nactv + z];
+                                }
+                            }
+                        }
+                    }
+                }
+                for (const auto& [J, c] : hbra)
+                    ref += c * hket[J];
+            }
+        }
+        REQUIRE(std::fabs(overlaps[n] - ref) < 1.0e-10);
+    }
+
+    // no non-active orbitals
+    REQUIRE(complementary_H2caa_overlap(nactv, dets, evecs, 0, {}, {}) ==
+            std::vector<double>(2, 0.0));
+    REQUIRE_THROWS(complementary_H2caa_overlap(nactv, dets, evecs, np, bra, {}));
+}
+
+// Test the overlap against the contraction with the explicit spin-free 2- and 3-RDMs
+//   sum B_{pwxy} K_{uvpz} Γ^{xyz}_{uwv} = O - sum B_{pzxy} K_{uvpz} Γ^{xy}_{uv}
+// and check that splitting the couplings in batches and reusing them gives the same result
+TEST_CASE("Complementary overlap vs 3-RDM [ComplementaryOverlap]", "[ComplementaryOverlap]") {
+    const size_t nactv = 4;
+    const size_t np = 2;
+    const size_t n2 = nactv * nactv;
+    const size_t nactv3 = n2 * nactv;
+    const auto dets = make_dets(nactv, 2, 1);
+    const size_t ndets = dets.size();
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<std::vector<double>> evecs(1, std::vector<double>(ndets));
+    for (auto& c : evecs[0])
+        c = dist(gen);
+    std::vector<double> bra(np * nactv3), ket(np * nactv3);
+    for (auto& x : bra)
+        x = dist(gen);
+    for (auto& x : ket)
+        x = dist(gen);
+    const auto& C = evecs[0];
+
+    std::map<Determinant, size_t> index;
+    for (size_t I = 0; I < ndets; ++I)
+        index[dets[I]] = I;
+    auto expectation = [&](const std::vector<std::tuple<size_t, int, bool>>& ops) {
+        double value = 0.0;
+        for (size_t I = 0; I < ndets; ++I) {
+            Determinant J(dets[I]);
+            const double sign = apply_string(J, ops);
+            if (sign == 0.0)
+                continue;
+            if (auto it = index.find(J); it != index.end())
+                value += sign * C[it->second] * C[I];
+        }
+        return value;
+    };
+
+    // spin-free RDMs: G2[x,y,u,v] = <x^+ y^+ v u> and G3[x,y,z,u,w,v] = <x^+ y^+ z^+ v w u>
+    std::vector<double> G2(n2 * n2, 0.0), G3(nactv3 * nactv3, 0.0);
+    for (size_t xy = 0; xy < n2; ++xy) {
+        for (size_t uv = 0; uv < n2; ++uv) {
+            const size_t x = xy / nactv, y = xy % nactv, u = uv / nactv, v = uv % nactv;
+            for (int s1 = 0; s1 < 2; ++s1) {
+                for (int s2 = 0; s2 < 2; ++s2) {
+                    G2[xy * n2 + uv] += expectation(
+                        {{x, s1, true}, {y, s2, true}, {v, s2, false}, {u, s1, false}});
+                }
+            }
+        }
+    }
+    for (size_t xyz = 0; xyz < nactv3; ++xyz) {
+        for (size_t uwv = 0; uwv < nactv3; ++uwv) {
+            const size_t x = xyz / n2, y = (xyz / nactv) % nactv, z = xyz % nactv;
+            const size_t u = uwv / n2, w = (uwv / nactv) % nactv, v = uwv % nactv;
+            for (int s1 = 0; s1 < 2; ++s1) {
+                for (int s2 = 0; s2 < 2; ++s2) {
+                    for (int s3 = 0; s3 < 2; ++s3) {
+                        G3[xyz * nactv3 + uwv] +=
+                            expectation({{x, s1, true},
+                                         {y, s2, true},
+                                         {z, s3, true},
+                                         {v, s3, false},
+                                         {w, s2, false},
+                                         {u, s1, false}});
+                    }
+                }
+            }
+        }
+    }
+
+    // B(p,w,x,y) and K(u,v,p,z)
+    auto B = [&](size_t p, size_t w, size_t x, size_t y) {
+        return bra[p * nactv3 + (w * nactv + x) * nactv + y];
+    };
+    auto K = [&](size_t u, size_t v, size_t p, size_t z) {
+        return ket[((u * nactv + v) * np + p) * nactv + z];
+    };
+    double E3 = 0.0, E2 = 0.0;
+    for (size_t p = 0; p < np; ++p) {
+        for (size_t x = 0; x < nactv; ++x) {
+            for (size_t y = 0; y < nactv; ++y) {
+                for (size_t u = 0; u < nactv; ++u) {
+                    for (size_t v = 0; v < nactv; ++v) {
+                        for (size_t z = 0; z < nactv; ++z) {
+                            E2 += B(p, z, x, y) * K(u, v, p, z) *
+                                  G2[(x * nactv + y) * n2 + u * nactv + v];
+                            for (size_t w = 0; w < nactv; ++w) {
+                                E3 += B(p, w, x, y) * K(u, v, p, z) *
+                                      G3[((x * nactv + y) * nactv + z) * nactv3 +
+                                         (u * nactv + w) * nactv + v];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const auto overlap = complementary_H2caa_overlap(nactv, dets, evecs, np, bra, ket);
+    REQUIRE(std::fabs(overlap[0] - E2 - E3) < 1.0e-10);
+
+    // split the couplings in batches
+    ComplementaryOverlap batched(nactv, dets, 4096);
+    REQUIRE(batched.num_batches() > 1);
+    REQUIRE(std::fabs(batched.compute(evecs, np, bra, ket)[0] - overlap[0]) < 1.0e-10);
+
+    // build the couplings once and reuse them
+    ComplementaryOverlap cached(nactv, dets, 0);
+    REQUIRE(cached.num_batches() == 1);
+    for (int n = 0; n < 2; ++n) {
+        REQUIRE(std::fabs(cached.compute(evecs, np, bra, ket)[0] - overlap[0]) < 1.0e-10);
+    }
+}
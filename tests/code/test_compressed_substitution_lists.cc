@@ -0,0 +1,142 @@
+#include <filesystem>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/sparse_ci/compressed_substitution_lists.h"
+
+using namespace forte;
+
+namespace {
+using list1_t = std::vector<std::vector<std::pair<size_t, short>>>;
+using list2_t = std::vector<std::vector<std::tuple<size_t, short, short>>>;
+
+/// Return random 1- and 2-body lists with unsorted determinant indices and signed labels. Every
+/// fifth list is empty
+std::pair<list1_t, list2_t> make_lists(size_t nlists) {
+    std::mt19937_64 gen(3);
+    std::uniform_int_distribution<size_t> size_dist(0, 40);
+    std::uniform_int_distribution<size_t> det_dist(0, 5000000);
+    std::uniform_int_distribution<short> label_dist(-300, 300);
+    list1_t lists1(nlists);
+    list2_t lists2(nlists);
+    for (size_t K = 0; K < nlists; ++K) {
+        if (K % 5 == 0)
+            continue;
+        for (size_t n = 0, size = size_dist(gen); n < size; ++n) {
+            const size_t det = det_dist(gen);
+            const short p = label_dist(gen);
+            lists1[K].emplace_back(det, p);
+            lists2[K].emplace_back(det, p, label_dist(gen));
+        }
+    }
+    return {lists1, lists2};
+}
+
+/// Check that the compressed lists match the original ones (without the empty lists)
+template <typename Lists>
+void check_lists(const CompressedSubstitutionLists& compressed, const Lists& lists) {
+    Lists nonempty;
+    size_t num_entries = 0;
+    for (const auto& list : lists) {
+        if (not list.empty())
+            nonempty.push_back(list);
+        num_entries += list.size();
+    }
+    REQUIRE(compressed.num_lists() == nonempty.size());
+    REQUIRE(compressed.num_entries() == num_entries);
+
+    // read the lists one by one
+    std::vector<SubstitutionListEntry> entries;
+    size_t K = 0;
+    for (size_t block = 0; block < compressed.num_blocks(); ++block) {
+        for (size_t k = 0; k < compressed.num_lists(block); ++k, ++K) {
+            compressed.get_list(block, k, entries);
+            REQUIRE(entries.size() == nonempty[K].size());
+            for (size_t n = 0; n < entries.size(); ++n) {
+                REQUIRE(entries[n].det == std::get<0>(nonempty[K][n]));
+                REQUIRE(entries[n].p == std::get<1>(nonempty[K][n]));
+                if constexpr (std::tuple_size_v<typename Lists::value_type::value_type> == 3) {
+                    REQUIRE(entries[n].q == std::get<2>(nonempty[K][n]));
+                } else {
+                    REQUIRE(entries[n].q == 0);
+                }
+            }
+        }
+    }
+    REQUIRE(K == nonempty.size());
+
+    // the lists split among threads cover all the lists once, in order
+    const size_t num_threads = 3;
+    size_t num_visited = 0;
+    for (size_t tid = 0; tid < num_threads; ++tid) {
+        size_t J = tid;
+        compressed.for_each_list(num_threads, tid, [&](const auto& list) {
+            REQUIRE(list.size() == nonempty[J].size());
+            if (not list.empty())
+                REQUIRE(list.back().det == std::get<0>(nonempty[J].back()));
+            J += num_threads;
+            num_visited += 1;
+        });
+    }
+    REQUIRE(num_visited == nonempty.size());
+}
+} // namespace
+
+// Test that lists stored in memory are decoded unchanged
+TEST_CASE("Compressed lists in memory [CompressedSubstitutionLists]",
+          "[CompressedSubstitutionLists]") {
+    const auto [lists1, lists2] = make_lists(1000);
+    const auto scratch = (std::filesystem::temp_directory_path() / "forte_test.lists").string();
+
+    CompressedSubstitutionLists compressed1(size_t(1) << 30, scratch + "1");
+    compressed1.add_lists(lists1);
+    compressed1.finalize();
+    REQUIRE(compressed1.num_blocks() == 1);
+    REQUIRE(compressed1.disk_bytes() == 0);
+    REQUIRE(not std::filesystem::exists(scratch + "1"));
+    check_lists(compressed1, lists1);
+
+    CompressedSubstitutionLists compressed2(size_t(1) << 30, scratch + "2");
+    compressed2.add_lists(lists2);
+    compressed2.finalize();
+    REQUIRE(compressed2.disk_bytes() == 0);
+    check_lists(compressed2, lists2);
+
+    // 1- and 2-body lists cannot be mixed
+    REQUIRE_THROWS(compressed1.add_lists(lists2));
+}
+
+// Test that lists spilled to the scratch file are decoded unchanged and that the file is removed
+TEST_CASE("Compressed lists spilled to disk [CompressedSubstitutionLists]",
+          "[CompressedSubstitutionLists]") {
+    const auto [lists1, lists2] = make_lists(1000);
+    const auto scratch = (std::filesystem::temp_directory_path() / "forte_test.lists").string();
+    // small blocks, with room in memory for about a third of them
+    const size_t block_size = 4096;
+    {
+        CompressedSubstitutionLists compressed1(16 * 1024, scratch + "1", block_size);
+        compressed1.add_lists(lists1);
+        compressed1.finalize();
+        REQUIRE(compressed1.num_blocks() > 4);
+        REQUIRE(compressed1.memory_bytes() > 0);
+        REQUIRE(compressed1.memory_bytes() <= 16 * 1024);
+        REQUIRE(compressed1.disk_bytes() > compressed1.memory_bytes());
+        REQUIRE(std::filesystem::exists(scratch + "1"));
+        check_lists(compressed1, lists1);
+
+        // everything on disk
+        CompressedSubstitutionLists compressed2(0, scratch + "2", block_size);
+        compressed2.add_lists(lists2);
+        compressed2.finalize();
+        REQUIRE(compressed2.memory_bytes() == 0);
+        check_lists(compressed2, lists2);
+
+        REQUIRE_THROWS(compressed2.add_lists(lists2));
+    }
+    REQUIRE(not std::filesystem::exists(scratch + "1"));
+    REQUIRE(not std::filesystem::exists(scratch + "2"));
+}
@@ -0,0 +1,85 @@
+#include <random>
+#include <unordered_map>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/sparse_ci/determinant.h"
+
+using namespace forte;
+
+namespace {
+std::vector<Determinant> random_determinants(size_t n, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<Determinant> dets(n);
+    for (auto& d : dets) {
+        for (size_t w = 0; w < Determinant::nwords_; ++w) {
+            d.set_word(w, gen());
+        }
+    }
+    return dets;
+}
+} // namespace
+
+// Test insertion, lookup, and iteration against std::unordered_map
+TEST_CASE("Insert and find [FlatHashMap]", "[FlatHashMap]") {
+    auto dets = random_determinants(10000, 17);
+    det_flat_hash<double> map;
+    det_hash<double> ref;
+    for (size_t i = 0; i < dets.size(); ++i) {
+        map[dets[i]] += static_cast<double>(i);
+        ref[dets[i]] += static_cast<double>(i);
+    }
+    REQUIRE(map.size() == ref.size());
+    REQUIRE(map.load_factor() <= 0.75);
+    for (const auto& [d, c] : ref) {
+        auto it = map.find(d);
+        REQUIRE(it != map.end());
+        REQUIRE(it->second == c);
+        REQUIRE(map.find_hashed(d, map.hash_key(d)) == it);
+    }
+    size_t count = 0;
+    for (const auto& [d, c] : map) {
+        REQUIRE(ref.at(d) == c);
+        count++;
+    }
+    REQUIRE(count == ref.size());
+
+    auto others = random_determinants(1000, 23);
+    for (const auto& d : others) {
+        REQUIRE(map.count(d) == ref.count(d));
+    }
+
+    auto inserted = map.try_emplace(dets[0], -1.0);
+    REQUIRE(not inserted.second);
+    REQUIRE(inserted.first->second == ref[dets[0]]);
+}
+
+// Test that erasing entries keeps the table consistent
+TEST_CASE("Erase [FlatHashMap]", "[FlatHashMap]") {
+    auto dets = random_determinants(5000, 31);
+    det_flat_hash<double> map;
+    det_hash<double> ref;
+    for (size_t i = 0; i < dets.size(); ++i) {
+        map[dets[i]] = static_cast<double>(i);
+        ref[dets[i]] = static_cast<double>(i);
+    }
+    for (size_t i = 0; i < dets.size(); i += 3) {
+        REQUIRE(map.erase(dets[i]) == 1);
+        ref.erase(dets[i]);
+        REQUIRE(map.erase(dets[i]) == 0);
+    }
+    REQUIRE(map.size() == ref.size());
+    for (size_t i = 0; i < dets.size(); ++i) {
+        REQUIRE(map.count(dets[i]) == ref.count(dets[i]));
+    }
+    for (const auto& [d, c] : ref) {
+        REQUIRE(map.at(d) == c);
+    }
+
+    map.clear();
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find(dets[1]) == map.end());
+    map[dets[1]] = 1.0;
+    REQUIRE(map.size() == 1);
+    REQUIRE(map.at(dets[1]) == 1.0);
+}
@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/integrals/integral_cache.h"
+
+using namespace forte;
+
+// Test that integrals written to a file are read back unchanged
+TEST_CASE("Write and read integrals [IntegralCache]", "[IntegralCache]") {
+    std::vector<double> tei(1000);
+    for (size_t i = 0; i < tei.size(); ++i)
+        tei[i] = 1.0 / (1.0 + i);
+    const std::vector<double> empty;
+
+    // use a signature that is not a multiple of eight bytes to test the alignment of the arrays
+    const std::string signature = "int_type=0 nmopi=5,2,";
+    const auto directory = std::filesystem::temp_directory_path().string();
+    const auto filename = integral_cache_filename(directory, signature);
+    REQUIRE(filename != integral_cache_filename(directory, signature + " "));
+
+    {
+        IntegralCacheWriter writer(filename, signature);
+        writer.write_size(42);
+        writer.write_array(tei.data(), tei.size());
+        writer.write_array(empty.data(), 0);
+        writer.commit();
+    }
+
+    {
+        IntegralCacheReader reader(filename, signature);
+        REQUIRE(reader.valid());
+        REQUIRE(reader.read_size() == 42);
+        const double* mapped = reader.map_array(tei.size());
+        REQUIRE(reinterpret_cast<uintptr_t>(mapped) % alignof(double) == 0);
+        REQUIRE(std::vector<double>(mapped, mapped + tei.size()) == tei);
+        REQUIRE_THROWS(reader.map_array(1));
+    }
+
+    {
+        IntegralCacheReader reader(filename, signature);
+        REQUIRE(reader.read_size() == 42);
+        std::vector<double> tei2(tei.size());
+        reader.read_array(tei2.data(), tei2.size());
+        REQUIRE(tei2 == tei);
+        reader.read_array(nullptr, 0);
+        REQUIRE(reader.at_end());
+        // reading past the end of the file throws
+        REQUIRE_THROWS(reader.read_size());
+    }
+
+    // a file written for different integrals is not valid
+    IntegralCacheReader other(filename, "int_type=0 nmopi=5,3,");
+    REQUIRE(not other.valid());
+
+    // a writer that is not committed leaves the file unchanged
+    {
+        IntegralCacheWriter writer(filename, "int_type=1");
+        writer.write_size(1);
+    }
+    REQUIRE(IntegralCacheReader(filename, signature).valid());
+
+    std::remove(filename.c_str());
+    IntegralCacheReader missing(filename, signature);
+    REQUIRE(not missing.valid());
+}
+
+// Test that the hash can be computed in pieces
+TEST_CASE("FNV-1a hash [IntegralCache]", "[IntegralCache]") {
+    const std::string s = "forte integrals";
+    const uint64_t h = fnv1a_hash(s.data(), s.size());
+    REQUIRE(fnv1a_hash(s.data() + 6, s.size() - 6, fnv1a_hash(s.data(), 6)) == h);
+    REQUIRE(fnv1a_hash(s.data(), s.size() - 1) != h);
+    REQUIRE(fnv1a_hash(nullptr, 0) == 14695981039346656037ULL);
+}
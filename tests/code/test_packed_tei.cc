@@ -0,0 +1,99 @@
+#include <random>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/integrals/packed_tei.h"
+
+using namespace forte;
+
+namespace {
+constexpr size_t nmo = 6;
+
+size_t index(size_t p, size_t q, size_t r, size_t s) {
+    return ((p * nmo + q) * nmo + r) * nmo + s;
+}
+
+/// Return random integrals <pq|rs> = (pr|qs) = sum_Q B^Q_pr B^Q_qs with B^Q_pr = B^Q_rp, which
+/// have the symmetries of real orbitals
+std::vector<double> make_real_symmetric_integrals() {
+    constexpr size_t naux = 10;
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> B(naux * nmo * nmo);
+    for (size_t Q = 0; Q < naux; ++Q) {
+        for (size_t p = 0; p < nmo; ++p) {
+            for (size_t r = 0; r <= p; ++r)
+                B[(Q * nmo + p) * nmo + r] = B[(Q * nmo + r) * nmo + p] = dist(gen);
+        }
+    }
+    std::vector<double> v(nmo * nmo * nmo * nmo, 0.0);
+    for (size_t p = 0; p < nmo; ++p) {
+        for (size_t q = 0; q < nmo; ++q) {
+            for (size_t r = 0; r < nmo; ++r) {
+                for (size_t s = 0; s < nmo; ++s) {
+                    for (size_t Q = 0; Q < naux; ++Q)
+                        v[index(p, q, r, s)] +=
+                            B[(Q * nmo + p) * nmo + r] * B[(Q * nmo + q) * nmo + s];
+                }
+            }
+        }
+    }
+    return v;
+}
+} // namespace
+
+// Test that the packed integrals give back the dense ones for all the indices
+TEST_CASE("Packed two-electron integrals [PackedTEI]", "[PackedTEI]") {
+    const auto v_ab = make_real_symmetric_integrals();
+    std::vector<double> v_aa(v_ab.size());
+    for (size_t p = 0; p < nmo; ++p) {
+        for (size_t q = 0; q < nmo; ++q) {
+            for (size_t r = 0; r < nmo; ++r) {
+                for (size_t s = 0; s < nmo; ++s)
+                    v_aa[index(p, q, r, s)] = v_ab[index(p, q, r, s)] - v_ab[index(p, q, s, r)];
+            }
+        }
+    }
+    REQUIRE(has_real_orbital_symmetry(v_ab, nmo));
+    REQUIRE(is_antisymmetrized_hermitian(v_aa, nmo));
+
+    const PackedTEILayout layout(nmo);
+    const auto packed_aa = layout.pack_aa(v_aa);
+    const auto packed_ab = layout.pack_ab(v_ab);
+    REQUIRE(packed_aa.size() == layout.aa_size());
+    REQUIRE(packed_ab.size() == layout.ab_size());
+
+    for (size_t p = 0; p < nmo; ++p) {
+        for (size_t q = 0; q < nmo; ++q) {
+            for (size_t r = 0; r < nmo; ++r) {
+                for (size_t s = 0; s < nmo; ++s) {
+                    REQUIRE(layout.ab(packed_ab, p, q, r, s) == v_ab[index(p, q, r, s)]);
+                    REQUIRE(layout.aa(packed_aa, p, q, r, s) == v_aa[index(p, q, r, s)]);
+                }
+            }
+        }
+    }
+}
+
+// Test that integrals without the full symmetry of real orbitals are not packed
+TEST_CASE("Symmetry checks of the packed integrals [PackedTEI]", "[PackedTEI]") {
+    auto v = make_real_symmetric_integrals();
+    REQUIRE(has_real_orbital_symmetry(v, nmo));
+
+    // integrals with <pq|rs> = <rq|ps> = <ps|rq> but <pq|rs> != <qp|sr>
+    for (size_t p = 0; p < nmo; ++p) {
+        for (size_t q = 0; q < nmo; ++q) {
+            for (size_t r = 0; r < nmo; ++r) {
+                for (size_t s = 0; s < nmo; ++s)
+                    v[index(p, q, r, s)] += (p + r) * (q + s) * (p + r + 1);
+            }
+        }
+    }
+    REQUIRE(v[index(0, 1, 2, 3)] == v[index(2, 1, 0, 3)]);
+    REQUIRE(v[index(0, 1, 2, 3)] == v[index(0, 3, 2, 1)]);
+    REQUIRE(not has_real_orbital_symmetry(v, nmo));
+
+    std::vector<double> w(v.size(), 1.0);
+    REQUIRE(not is_antisymmetrized_hermitian(w, nmo));
+}
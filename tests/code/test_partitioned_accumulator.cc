@@ -0,0 +1,96 @@
+#include <random>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/helpers/threading.h"
+#include "forte/sparse_ci/determinant.h"
+
+using namespace forte;
+
+// Test that the partitioned accumulation reproduces a serial accumulation in a det_hash
+TEST_CASE("Accumulate determinants [PartitionedAccumulator]", "[PartitionedAccumulator]") {
+    std::mt19937_64 gen(5);
+    std::vector<Determinant> dets(500);
+    for (auto& d : dets) {
+        for (size_t w = 0; w < Determinant::nwords_; ++w) {
+            d.set_word(w, gen());
+        }
+    }
+    for (size_t nthreads : {1, 3, 4}) {
+        det_accumulator<double> acc(nthreads);
+        det_hash<double> ref;
+        // simulate several threads adding the same determinants many times
+        for (size_t n = 0; n < 20000; ++n) {
+            const auto& d = dets[gen() % dets.size()];
+            const double value = 1.0 / (1.0 + n % 7);
+            acc.add(n % nthreads, d, value);
+            ref[d] += value;
+        }
+        // repeated determinants are combined within each thread
+        REQUIRE(acc.num_buffered() <= nthreads * dets.size());
+        acc.merge();
+        REQUIRE(acc.num_buffered() == 0);
+        REQUIRE(acc.size() == ref.size());
+        REQUIRE(acc.erase(dets[0]) == ref.erase(dets[0]));
+
+        std::vector<std::pair<Determinant, double>> flat(acc.size());
+        acc.for_each([&](size_t n, const Determinant& d, double v) { flat[n] = {d, v}; });
+        REQUIRE(flat.size() == ref.size());
+        for (const auto& [d, v] : flat) {
+            REQUIRE(std::fabs(ref.at(d) - v) < 1.0e-10);
+        }
+    }
+}
+
+// Test the accumulation of vectors combined element by element
+TEST_CASE("Accumulate vectors [PartitionedAccumulator]", "[PartitionedAccumulator]") {
+    std::mt19937_64 gen(7);
+    std::vector<Determinant> dets(100);
+    for (auto& d : dets) {
+        for (size_t w = 0; w < Determinant::nwords_; ++w) {
+            d.set_word(w, gen());
+        }
+    }
+    const size_t nroot = 3;
+    const size_t nthreads = 4;
+    det_accumulator<std::vector<double>, ElementwiseAddAssign> acc(nthreads);
+    det_hash<std::vector<double>> ref;
+    for (size_t n = 0; n < 5000; ++n) {
+        const auto& d = dets[gen() % dets.size()];
+        std::vector<double> value(nroot);
+        for (size_t r = 0; r < nroot; ++r) {
+            value[r] = 1.0 / (1.0 + (n + r) % 5);
+        }
+        acc.add(n % nthreads, d, value);
+        auto& ref_value = ref.try_emplace(d, nroot, 0.0).first->second;
+        for (size_t r = 0; r < nroot; ++r) {
+            ref_value[r] += value[r];
+        }
+    }
+    REQUIRE(acc.num_buffered() <= nthreads * dets.size());
+    acc.merge();
+    REQUIRE(acc.size() == ref.size());
+    acc.for_each([&](size_t, const Determinant& d, const std::vector<double>& v) {
+        const auto& ref_value = ref.at(d);
+        for (size_t r = 0; r < nroot; ++r) {
+            REQUIRE(std::fabs(ref_value[r] - v[r]) < 1.0e-10);
+        }
+    });
+}
+
+// Test the parallel sort against std::sort
+TEST_CASE("Parallel sort [PartitionedAccumulator]", "[PartitionedAccumulator]") {
+    std::mt19937_64 gen(9);
+    for (size_t n : {0, 10, 5000, 100000}) {
+        std::vector<double> v(n);
+        for (auto& x : v)
+            x = static_cast<double>(gen() % 1000);
+        auto ref = v;
+        std::sort(ref.begin(), ref.end());
+        for (size_t nthreads : {1, 2, 3, 8}) {
+            auto w = v;
+            parallel_sort(w.begin(), w.end(), std::less<double>(), nthreads);
+            REQUIRE(w == ref);
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <filesystem>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/fci/string_lists_io.h"
+
+using namespace forte;
+
+// Test that string lists written to a file are read back unchanged
+TEST_CASE("Write and read string lists [StringListsIO]", "[StringListsIO]") {
+    VOList vo;
+    vo[{0, 1, 0}].emplace_back(1.0, 0, 3);
+    vo[{0, 1, 0}].emplace_back(-1.0, 2, 1);
+    vo[{2, 1, 1}].emplace_back(-1.0, 4, 5);
+    VOListMap vo_map;
+    vo_map[{0, 1}][{2, 3}].emplace_back(-1.0, 7, 8);
+    vo_map[{1, 1}][{0, 0}];
+    OOListMap oo_map;
+    oo_map[2][{1, 0}] = {3, 1, 4};
+    H1List h1;
+    h1[{1, 10, 0}].emplace_back(-1, 3, 123456789012);
+    H3List h3;
+    h3[{0, 0, 1}].emplace_back(1, 1, 2, 3, 9);
+    h3[{0, 0, 1}].emplace_back(-1, 4, 5, 6, 0);
+
+    const std::string signature = "test na=2 nb=2";
+    const auto directory = std::filesystem::temp_directory_path().string();
+    const auto filename = string_lists_filename(directory, signature);
+    REQUIRE(filename != string_lists_filename(directory, signature + " "));
+
+    StringListsWriter writer(signature);
+    writer.write(vo);
+    writer.write(vo_map);
+    writer.write(oo_map);
+    writer.write(h1);
+    writer.write(h3);
+    writer.save(filename);
+
+    {
+        StringListsReader reader(filename, signature);
+        REQUIRE(reader.valid());
+        VOList vo2;
+        VOListMap vo_map2;
+        OOListMap oo_map2;
+        H1List h12;
+        H3List h32;
+        reader.read(vo2);
+        reader.read(vo_map2);
+        reader.read(oo_map2);
+        reader.read(h12);
+        reader.read(h32);
+        REQUIRE(reader.at_end());
+
+        REQUIRE(vo2.size() == vo.size());
+        for (const auto& [key, list] : vo) {
+            const auto& list2 = vo2.at(key);
+            REQUIRE(list2.size() == list.size());
+            for (size_t n = 0; n < list.size(); ++n) {
+                REQUIRE(list2[n].sign == list[n].sign);
+                REQUIRE(list2[n].I == list[n].I);
+                REQUIRE(list2[n].J == list[n].J);
+            }
+        }
+        REQUIRE(vo_map2.size() == 2);
+        REQUIRE(vo_map2.at({1, 1}).at({0, 0}).empty());
+        REQUIRE(vo_map2.at({0, 1}).at({2, 3})[0].J == 8);
+        REQUIRE(oo_map2 == oo_map);
+        REQUIRE(h12.at({1, 10, 0})[0].sign == -1);
+        REQUIRE(h12.at({1, 10, 0})[0].J == 123456789012);
+        const auto& s = h32.at({0, 0, 1})[1];
+        REQUIRE((s.sign == -1 and s.p == 4 and s.q == 5 and s.r == 6 and s.J == 0));
+
+        // reading past the end of the file throws
+        H1List extra;
+        REQUIRE_THROWS(reader.read(extra));
+    }
+
+    // a file written for a different active space is not valid
+    StringListsReader other(filename, "test na=1 nb=2");
+    REQUIRE(not other.valid());
+
+    std::remove(filename.c_str());
+    StringListsReader missing(filename, signature);
+    REQUIRE(not missing.valid());
+}
+
+// Test the round trip of the lists cached by FCIStringLists and GenCIStringLists
+TEST_CASE("Write and read a set of string lists [StringListsIO]", "[StringListsIO]") {
+    VOList alfa_vo, beta_vo;
+    alfa_vo[{0, 1, 0}].emplace_back(1.0, 0, 3);
+    beta_vo[{1, 0, 1}].emplace_back(-1.0, 2, 1);
+    OOList alfa_oo, beta_oo;
+    alfa_oo[{1, 2, 0}].emplace_back(-1.0, 5, 6);
+    VVOOList alfa_vvoo, beta_vvoo;
+    beta_vvoo[{0, 1, 2, 3, 1}].emplace_back(1.0, 7, 9);
+    H1List alfa_1h, beta_1h;
+    alfa_1h[{0, 4, 1}].emplace_back(1, 2, 11);
+    H2List alfa_2h, beta_2h;
+    beta_2h[{1, 3, 0}].emplace_back(-1, 0, 4, 12);
+    H3List alfa_3h, beta_3h;
+    alfa_3h[{0, 0, 1}].emplace_back(1, 1, 2, 3, 9);
+
+    const std::string signature = "FCIStringLists na=3 nb=3";
+    const auto filename =
+        string_lists_filename(std::filesystem::temp_directory_path().string(), signature);
+    write_string_lists(filename, signature, alfa_vo, beta_vo, alfa_oo, beta_oo, alfa_vvoo,
+                       beta_vvoo, alfa_1h, beta_1h, alfa_2h, beta_2h, alfa_3h, beta_3h);
+
+    VOList alfa_vo2, beta_vo2;
+    OOList alfa_oo2, beta_oo2;
+    VVOOList alfa_vvoo2, beta_vvoo2;
+    H1List alfa_1h2, beta_1h2;
+    H2List alfa_2h2, beta_2h2;
+    H3List alfa_3h2, beta_3h2;
+    REQUIRE(read_string_lists(filename, signature, alfa_vo2, beta_vo2, alfa_oo2, beta_oo2,
+                              alfa_vvoo2, beta_vvoo2, alfa_1h2, beta_1h2, alfa_2h2, beta_2h2,
+                              alfa_3h2, beta_3h2));
+    REQUIRE(alfa_vo2.at({0, 1, 0})[0].J == 3);
+    REQUIRE(beta_vo2.at({1, 0, 1})[0].sign == -1.0);
+    REQUIRE(beta_oo2.empty());
+    REQUIRE(alfa_oo2.at({1, 2, 0})[0].I == 5);
+    REQUIRE(alfa_vvoo2.empty());
+    REQUIRE(beta_vvoo2.at({0, 1, 2, 3, 1})[0].J == 9);
+    REQUIRE(alfa_1h2.at({0, 4, 1})[0].J == 11);
+    REQUIRE(beta_1h2.empty());
+    const auto& s2 = beta_2h2.at({1, 3, 0})[0];
+    REQUIRE((s2.sign == -1 and s2.p == 0 and s2.q == 4 and s2.J == 12));
+    REQUIRE(alfa_3h2.at({0, 0, 1})[0].r == 3);
+    REQUIRE(beta_3h2.empty());
+
+    // reading fewer lists than were written leaves data at the end of the file
+    REQUIRE_THROWS(read_string_lists(filename, signature, alfa_vo2, beta_vo2));
+    // a different active space is not read
+    REQUIRE(not read_string_lists(filename, "FCIStringLists na=3 nb=2", alfa_vo2));
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,93 @@
+#include <tuple>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/sparse_ci/substitution_list.h"
+#include "forte/sparse_ci/substitution_list_kernels.h"
+
+using namespace forte;
+
+// Test that the groups are stored and read back unchanged
+TEST_CASE("One-body lists [SubstitutionList]", "[SubstitutionList]") {
+    std::vector<std::vector<std::pair<size_t, short>>> groups{
+        {{0, 1}, {3, -2}, {7, 5}}, {{2, -1}}, {{1, 3}, {4, 4}}};
+    SubstitutionList<1> list;
+    REQUIRE(list.empty());
+    for (const auto& group : groups)
+        list.push_back(group);
+    REQUIRE(list.size() == 3);
+    REQUIRE(list.num_entries() == 6);
+    for (size_t K = 0; K < groups.size(); ++K) {
+        const auto group = list[K];
+        REQUIRE(group.size() == groups[K].size());
+        for (size_t n = 0; n < group.size(); ++n) {
+            const auto [I, p] = group[n];
+            REQUIRE(I == groups[K][n].first);
+            REQUIRE(p == groups[K][n].second);
+        }
+    }
+
+    // range-based iteration visits the same entries
+    size_t K = 0;
+    for (const auto& group : list) {
+        std::vector<std::pair<size_t, short>> entries;
+        for (const auto& entry : group)
+            entries.push_back(entry);
+        REQUIRE(entries == groups[K]);
+        ++K;
+    }
+    REQUIRE(K == groups.size());
+
+    list.clear();
+    REQUIRE(list.empty());
+    REQUIRE(list.num_entries() == 0);
+}
+
+TEST_CASE("Three-body lists [SubstitutionList]", "[SubstitutionList]") {
+    std::vector<std::tuple<size_t, short, short, short>> group{{5, -1, 2, 3}, {9, 4, 0, 1}};
+    SubstitutionList<3> list;
+    list.push_back(group);
+    list.push_back({});
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[1].empty());
+    REQUIRE(list[0][1] == group[1]);
+    const auto [I, p, q, r] = list[0][0];
+    REQUIRE(I == 5);
+    REQUIRE(p == -1);
+    REQUIRE(q == 2);
+    REQUIRE(r == 3);
+}
+
+// Test that the kernels visit the same couplings for both kinds of lists and apply the signs of
+// the substitutions
+TEST_CASE("Single substitution kernels [SubstitutionList]", "[SubstitutionList]") {
+    SubstitutionList<1> list;
+    list.push_back({{0, 1}, {3, -2}, {7, 5}});
+    std::vector<SubstitutionListEntry> entries{{0, 1, 0}, {3, -2, 0}, {7, 5, 0}};
+
+    auto hij = [](size_t J, int p, int q) { return 100.0 * J + 10.0 * p + q; };
+    const std::vector<std::tuple<double, size_t, size_t>> ref{
+        {-1.0, 3, 0}, {4.0, 7, 0}, {-314.0, 7, 3}};
+    std::vector<std::tuple<double, size_t, size_t>> couplings;
+    auto record = [&](double HIJ, size_t I, size_t J) { couplings.emplace_back(HIJ, I, J); };
+    for_each_single_coupling(list[0], hij, record);
+    REQUIRE(couplings == ref);
+    couplings.clear();
+    for_each_single_coupling(entries, hij, record);
+    REQUIRE(couplings == ref);
+
+    const size_t norb = 6;
+    std::vector<double> rdm(norb * norb, 0.0);
+    add_1rdm_single_list(
+        list, norb, [](size_t I) { return I + 1.0; }, [](size_t I) { return I + 10.0; },
+        rdm.data());
+    std::vector<double> rdm_ref(norb * norb, 0.0);
+    rdm_ref[0 * norb + 1] = -13.0;
+    rdm_ref[1 * norb + 0] = -40.0;
+    rdm_ref[0 * norb + 4] = 17.0;
+    rdm_ref[4 * norb + 0] = 80.0;
+    rdm_ref[1 * norb + 4] = -68.0;
+    rdm_ref[4 * norb + 1] = -104.0;
+    REQUIRE(rdm == rdm_ref);
+}
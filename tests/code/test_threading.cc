@@ -0,0 +1,103 @@
+#include <numeric>
+
+#include "catch_amalgamated.hpp"
+
+#include "forte/helpers/threading.h"
+
+using namespace forte;
+
+// Test that every item is assigned once and that the loads are balanced
+TEST_CASE("Balanced partition [Threading]", "[Threading]") {
+    std::vector<size_t> weights{100, 1, 7, 50, 50, 3, 0, 25, 25, 40, 10, 9};
+    const size_t total = std::accumulate(weights.begin(), weights.end(), size_t(0));
+    for (size_t nthreads : {1, 2, 3, 5, 16}) {
+        auto partition = balanced_partition(weights, nthreads);
+        REQUIRE(partition.size() == nthreads);
+        std::vector<int> count(weights.size(), 0);
+        size_t max_load = 0;
+        for (const auto& items : partition) {
+            size_t load = 0;
+            for (auto i : items) {
+                count[i] += 1;
+                load += weights[i];
+            }
+            max_load = std::max(max_load, load);
+        }
+        REQUIRE(std::all_of(count.begin(), count.end(), [](int c) { return c == 1; }));
+        // the greedy schedule is within 4/3 of the optimal load
+        const size_t lower_bound = std::max(weights[0], (total + nthreads - 1) / nthreads);
+        REQUIRE(3 * max_load <= 4 * lower_bound);
+    }
+    REQUIRE_THROWS(balanced_partition(weights, 0));
+}
+
+// Test that the units are split in proportion to the weights
+TEST_CASE("Proportional split [Threading]", "[Threading]") {
+    std::vector<size_t> weights{600, 300, 100, 0};
+    for (size_t total : {4, 5, 10, 14, 64}) {
+        auto split = proportional_split(weights, total);
+        REQUIRE(split.size() == weights.size());
+        REQUIRE(std::accumulate(split.begin(), split.end(), size_t(0)) == total);
+        REQUIRE(std::all_of(split.begin(), split.end(), [](size_t s) { return s >= 1; }));
+        REQUIRE(std::is_sorted(split.rbegin(), split.rend()));
+    }
+    REQUIRE(proportional_split(weights, 14) == std::vector<size_t>{7, 4, 2, 1});
+    REQUIRE(proportional_split({0, 0}, 5) == std::vector<size_t>{3, 2});
+    REQUIRE(proportional_split({}, 3).empty());
+    REQUIRE_THROWS(proportional_split(weights, 3));
+}
+
+// Test that the prefetcher returns the items in order and fetches them one at a time
+TEST_CASE("Async prefetcher [Threading]", "[Threading]") {
+    for (bool async : {true, false}) {
+        std::vector<size_t> calls;
+        AsyncPrefetcher<std::vector<double>> prefetcher(
+            5, [&](size_t i) {
+                calls.push_back(i);
+                return std::vector<double>(i + 1, 0.5 * i);
+            },
+            async);
+        for (size_t i = 0; i < 5; ++i) {
+            REQUIRE(not prefetcher.done());
+            auto item = prefetcher.next();
+            REQUIRE(item == std::vector<double>(i + 1, 0.5 * i));
+        }
+        REQUIRE(prefetcher.done());
+        REQUIRE(calls == std::vector<size_t>{0, 1, 2, 3, 4});
+        REQUIRE_THROWS(prefetcher.next());
+    }
+
+    // an exception thrown while fetching an item is rethrown when the item is requested
+    AsyncPrefetcher<int> failing(3, [](size_t i) {
+        if (i == 1)
+            throw std::runtime_error("read error");
+        return static_cast<int>(i);
+    });
+    REQUIRE(failing.next() == 0);
+    REQUIRE_THROWS_AS(failing.next(), std::runtime_error);
+
+    // nothing is fetched if there are no items
+    AsyncPrefetcher<int> empty(0, [](size_t) -> int { throw std::runtime_error("no items"); });
+    REQUIRE(empty.done());
+}
+
+// Test that the contributions of all the threads are added to the arrays
+TEST_CASE("Accumulate in parallel [Threading]", "[Threading]") {
+    for (size_t nthreads : {1, 2, 4}) {
+        std::vector<double> a(100, 1.0);
+        std::vector<double> b(7, 0.0);
+        accumulate_in_parallel(
+            {&a, &b},
+            [&](const std::vector<double*>& out) {
+#pragma omp for schedule(dynamic)
+                for (int i = 0; i < 1000; ++i) {
+                    out[0][i % 100] += 1.0;
+                    out[1][i % 7] += 0.5;
+                }
+            },
+            nthreads);
+        REQUIRE(std::all_of(a.begin(), a.end(), [](double x) { return x == 11.0; }));
+        REQUIRE(std::accumulate(b.begin(), b.end(), 0.0) == 500.0);
+        REQUIRE(b[6] == 71.0);
+    }
+}
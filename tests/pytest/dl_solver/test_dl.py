@@ -9,7 +9,7 @@ import pytest
 # - passing different number of guesses
 # - passing different number of project out vectors
 
-def solve_dl(size, nroot):
+def solve_dl(size, nroot, block=False):
     """Test the Davidson-Liu solver with a matrix of size x size"""
     # create a numpy array of size x size
     matrix = np.zeros((size, size))
@@ -30,7 +30,10 @@ def solve_dl(size, nroot):
     solver.add_h_diag(h_diag)
     guesses = [[(i,1.0)] for i in range(nroot)]
     solver.add_guesses(guesses)
-    solver.add_test_sigma_builder(matrix.tolist())
+    if block:
+        solver.add_test_block_sigma_builder(matrix.tolist())
+    else:
+        solver.add_test_sigma_builder(matrix.tolist())
     solver.solve()
 
     # compare the computed eigenvalues with the exact ones
@@ -89,6 +92,12 @@ def test_dl_4():
         for nroot in range(1,size + 1):
             solve_dl(size, nroot)
 
+def test_dl_block():
+    """Test the Davidson-Liu solver with a block sigma builder"""
+    for nroot in range(1,11):
+        solve_dl(10, nroot, block=True)
+        solve_dl(100, nroot, block=True)
+
 def test_dl_no_guess():
     """Test the Davidson-Liu solver with no guesses. Random guesses will be generated"""
     size = 4
@@ -186,6 +195,7 @@ if __name__ == '__main__':
     test_dl_2()
     test_dl_3()
     test_dl_4()
+    test_dl_block()
     test_dl_no_guess()
     test_project_out()
     test_dl_restart_1()
@@ -0,0 +1,13 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+
+def test_tensor_rotation():
+    import forte
+
+    # the checks are done in C++ and a failure raises an exception
+    forte.test_tensor_rotation()
+
+
+if __name__ == "__main__":
+    test_tensor_rotation()
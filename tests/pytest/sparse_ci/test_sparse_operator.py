@@ -380,5 +380,32 @@ def test_sparse_operator():
     assert sopd.str() == ref.str()
 
 
+def test_apply_operator_threads():
+    import itertools
+    import forte
+    from forte import det
+
+    # a state with enough determinants to be split into several blocks
+    dets = [det("".join(occ)) for occ in itertools.product("02+-", repeat=5)]
+    ref = forte.StateVector({d: 1.0 / (1.0 + i) for i, d in enumerate(dets)})
+
+    sop = forte.SparseOperator(antihermitian=True)
+    sop.add_term_from_str('[1a+ 0a-]', 0.1)
+    sop.add_term_from_str('[3b+ 2b-]', 0.2)
+    sop.add_term_from_str('[4a+ 1b+ 0b- 2a-]', 0.3)
+    sop.add_term_from_str('[3a+ 4b+ 1b- 0a-]', 0.4)
+
+    wfn_serial = forte.apply_operator(sop, ref, num_threads=1)
+    # the result, including the order of the determinants, must be identical for any number of
+    # threads
+    for num_threads in [2, 3, 4]:
+        wfn = forte.apply_operator(sop, ref, num_threads=num_threads)
+        assert len(wfn) == len(wfn_serial)
+        for d, c in wfn_serial.items():
+            assert wfn[d] == c
+        assert [d for d, _ in wfn.items()] == [d for d, _ in wfn_serial.items()]
+
+
 if __name__ == "__main__":
     test_sparse_operator()
+    test_apply_operator_threads()